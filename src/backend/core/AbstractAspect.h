@@ -50,6 +50,7 @@ enum class AspectType : quint64 {
 		Image = 0x0210030,
 		ReferenceLine = 0x0210040,
 		InfoElement = 0x0210080,
+		DensityPlot = 0x0210100,
 		WorksheetElementContainer = 0x0220000,
 			AbstractPlot = 0x0221000,
 				CartesianPlot = 0x0221001,
@@ -149,6 +150,8 @@ public:
 			return QStringLiteral("ReferenceLine");
 		case AspectType::InfoElement:
 			return QStringLiteral("InfoElement");
+		case AspectType::DensityPlot:
+			return QStringLiteral("DensityPlot");
 		case AspectType::WorksheetElementContainer:
 			return QStringLiteral("WorksheetElementContainer");
 		case AspectType::AbstractPlot:
@@ -350,6 +350,37 @@ bool AbstractColumn::isMasked(const Interval<int>& i) const {
 	return d->m_masking.isSet(i);
 }
 
+/**
+ * \brief Return the first masked row not before \c row
+ *
+ * If \c other is given, the first row masked in this or in the other column is returned.
+ * Returns std::numeric_limits<int>::max() if no such row exists.
+ * Together with nextUnmaskedRow() this allows to iterate over the runs of unmasked rows
+ * without checking every single row.
+ */
+int AbstractColumn::nextMaskedRow(int row, const AbstractColumn* other) const {
+	const int next = d->m_masking.nextSet(row);
+	return other ? qMin(next, other->d->m_masking.nextSet(row)) : next;
+}
+
+/**
+ * \brief Return the first row not before \c row that is not masked
+ *
+ * If \c other is given, the first row masked neither in this nor in the other column is returned.
+ * Returns std::numeric_limits<int>::max() if all rows up to this value are masked.
+ */
+int AbstractColumn::nextUnmaskedRow(int row, const AbstractColumn* other) const {
+	int next = d->m_masking.nextUnset(row);
+	if (other) {
+		int otherNext = other->d->m_masking.nextUnset(next);
+		while (otherNext != next) {
+			next = d->m_masking.nextUnset(otherNext);
+			otherNext = other->d->m_masking.nextUnset(next);
+		}
+	}
+	return next;
+}
+
 /**
  * \brief Return all intervals of masked rows
  */
@@ -556,6 +587,42 @@ double AbstractColumn::valueAt(int /*row*/) const {
 	return NAN;
 }
 
+/**
+ * \brief Read the numerical values of the rows \c first .. \c first + \c count - 1 into \c values
+ *
+ * Batch version of valueAt() avoiding the per-row calls and the checks of the column mode in loops over the data.
+ * Numeric values are read as doubles and date-time values as milliseconds since epoch.
+ * Rows without a numerical value (invalid values, text and rows not present in the column) are read as NAN.
+ * If \c valid is given, \c valid[i] is set to \c true if the row \c first + i has a numerical value and is not masked.
+ */
+void AbstractColumn::valuesAt(int first, int count, double* values, bool* valid) const {
+	const auto mode = columnMode();
+	for (int i = 0; i < count; ++i) {
+		const int row = first + i;
+		double value = NAN;
+		if (row < rowCount() && isValid(row)) {
+			switch (mode) {
+			case ColumnMode::Double:
+			case ColumnMode::Integer:
+			case ColumnMode::BigInt:
+				value = valueAt(row);
+				break;
+			case ColumnMode::DateTime:
+			case ColumnMode::Month:
+			case ColumnMode::Day:
+				value = dateTimeAt(row).toMSecsSinceEpoch();
+				break;
+			case ColumnMode::Text:
+				break;
+			}
+		}
+
+		values[i] = value;
+		if (valid)
+			valid[i] = !std::isnan(value) && !isMasked(row);
+	}
+}
+
 /**
  * \brief Set the content of row 'row'
  *
@@ -83,6 +83,8 @@ public:
 		// add new values with next bit set (0x10)
 	};
 
+	// the quantiles (median, quartiles, percentiles, iqr, trimean) and the deviations are estimated by a quantile sketch
+	// for large columns, the mode and the entropy are only available in the exact statistics, see Column::statistics()
 	struct ColumnStatistics {
 		int size{0};
 		double minimum{NAN};
@@ -153,6 +155,8 @@ public:
 
 	bool isMasked(int row) const;
 	bool isMasked(const Interval<int>& i) const;
+	int nextMaskedRow(int row, const AbstractColumn* other = nullptr) const;
+	int nextUnmaskedRow(int row, const AbstractColumn* other = nullptr) const;
 	QVector< Interval<int> > maskedIntervals() const;
 	void clearMasks();
 	void setMasked(const Interval<int>& i, bool mask = true);
@@ -175,6 +179,7 @@ public:
 	virtual void setDateTimeAt(int row, const QDateTime& new_value);
 	virtual void replaceDateTimes(int first, const QVector<QDateTime>& new_values);
 	virtual double valueAt(int row) const;
+	virtual void valuesAt(int first, int count, double* values, bool* valid = nullptr) const;
 	virtual void setValueAt(int row, double new_value);
 	virtual void replaceValues(int first, const QVector<double>& new_values);
 	virtual int integerAt(int row) const;
@@ -0,0 +1,548 @@
+/*
+    File                 : BinaryProjectFile.cpp
+    Project              : LabPlot
+    Description          : binary project file with the column data stored as raw blobs
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/core/BinaryProjectFile.h"
+#include "backend/lib/macros.h"
+
+#include <KLocalizedString>
+
+#include <QFileInfo>
+
+#include <cstring>
+#include <limits>
+
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+namespace {
+const char magic[8] = {'L', 'a', 'b', 'P', 'l', 'o', 't', 'B'};
+const quint32 formatVersion = 1;
+
+// blobs smaller than this are not compressed
+const qint64 minCompressionSize = 4096;
+
+struct FileHeader {
+	char magic[8];
+	quint32 version;
+	quint32 blobCount;
+	quint64 tableOffset;
+	qint32 xmlBlob;
+	quint32 reserved;
+	quint64 unusedSize;	// size of the blobs not referenced anymore after incremental saves
+	char padding[24];
+};
+
+static_assert(sizeof(FileHeader) == 64, "unexpected size of the file header");
+static_assert(sizeof(BinaryProjectBlob) == 32, "unexpected size of the blob table entry");
+}
+
+BinaryProjectWriter::BinaryProjectWriter(QIODevice* device) : m_device(device) {
+}
+
+/*!
+ * writes the (preliminary) header, the device has to be open for writing and to be seekable.
+ */
+bool BinaryProjectWriter::begin() {
+	if (!m_device || m_device->isSequential())
+		return false;
+
+	FileHeader header;
+	memset(&header, 0, sizeof(header));
+	m_pos = 0;
+	m_ok = true;
+	m_blobs.clear();
+	m_used.clear();
+	m_base = nullptr;
+	m_references.clear();
+	return write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+/*!
+ * prepares appending new blobs to the binary project file read by \c base. The device has to be this file opened
+ * for reading and writing. The blobs of \c base keep their indices and are referenced with \c copyBlob()
+ * without writing them again.
+ */
+bool BinaryProjectWriter::beginAppend(const BinaryProjectReader& base) {
+	if (!m_device || m_device->isSequential())
+		return false;
+
+	m_base = &base;
+	m_blobs = base.blobs();
+	m_used = QVector<bool>(m_blobs.size(), false);
+	m_pos = m_device->size();
+	m_ok = true;
+	m_references.clear();
+	return m_device->seek(m_pos);
+}
+
+/*!
+ * writes the \c size bytes in \c data as a new blob and returns its index or -1 on errors.
+ */
+int BinaryProjectWriter::addBlob(const char* data, qint64 size) {
+	if (!align())
+		return -1;
+
+	BinaryProjectBlob blob;
+	blob.offset = m_pos;
+	blob.size = size;
+	blob.storedSize = size;
+
+#ifdef HAVE_LZ4
+	if (size >= minCompressionSize && size <= LZ4_MAX_INPUT_SIZE) {
+		QByteArray compressed(LZ4_compressBound((int)size), Qt::Uninitialized);
+		const int compressedSize = LZ4_compress_default(data, compressed.data(), (int)size, compressed.size());
+		// only keep the compressed data if it's notably smaller, uncompressed data is read without decompressing it
+		if (compressedSize > 0 && compressedSize < 0.9 * size) {
+			blob.compression = BinaryProjectBlob::Compression::LZ4;
+			blob.storedSize = compressedSize;
+			if (!write(compressed.constData(), compressedSize))
+				return -1;
+			m_blobs << blob;
+			m_used << true;
+			return m_blobs.size() - 1;
+		}
+	}
+#endif
+
+	if (!write(data, size))
+		return -1;
+	m_blobs << blob;
+	m_used << true;
+	return m_blobs.size() - 1;
+}
+
+int BinaryProjectWriter::addBlob(const QByteArray& data) {
+	return addBlob(data.constData(), data.size());
+}
+
+/*!
+ * copies the blob \c index of \c reader as it is stored (without decompressing it) into a new blob
+ * and returns its index or -1 on errors. If the blobs are appended to the file of \c reader,
+ * the blob is only referenced again.
+ */
+int BinaryProjectWriter::copyBlob(BinaryProjectReader& reader, int index) {
+	if (&reader == m_base) {
+		if (index < 0 || index >= m_used.size())
+			return -1;
+		m_used[index] = true;
+		return index;
+	}
+
+	BinaryProjectBlob blob;
+	QByteArray stored;
+	if (!reader.readStoredBlob(index, blob, stored) || !align())
+		return -1;
+
+	blob.offset = m_pos;
+	if (!write(stored.constData(), stored.size()))
+		return -1;
+	m_blobs << blob;
+	m_used << true;
+	return m_blobs.size() - 1;
+}
+
+/*!
+ * remembers that the blob \c index was written for \c object (a column).
+ */
+void BinaryProjectWriter::addReference(const void* object, int index) {
+	m_references[object] = index;
+}
+
+const QHash<const void*, int>& BinaryProjectWriter::references() const {
+	return m_references;
+}
+
+/*!
+ * writes \c xml as the last blob, the blob table and the final header.
+ */
+bool BinaryProjectWriter::finish(const QByteArray& xml) {
+	const int xmlBlob = addBlob(xml);
+	if (xmlBlob < 0 || !align())
+		return false;
+
+	FileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, magic, sizeof(magic));
+	header.version = formatVersion;
+	header.blobCount = m_blobs.size();
+	header.tableOffset = m_pos;
+	header.xmlBlob = xmlBlob;
+	header.unusedSize = m_pos - sizeof(header);
+	for (int i = 0; i < m_blobs.size(); ++i) {
+		if (m_used.at(i))
+			header.unusedSize -= m_blobs.at(i).storedSize;
+	}
+
+	if (!write(reinterpret_cast<const char*>(m_blobs.constData()), m_blobs.size() * (qint64)sizeof(BinaryProjectBlob)))
+		return false;
+
+	// the header is written at last, the file is still valid if writing the new blobs fails
+	if (!m_device->seek(0))
+		return false;
+	return write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+/*!
+ * encodes the texts with a dictionary of the distinct values:
+ * number of rows, number of distinct values, dictionary index of every row (-1 for null strings),
+ * offsets of the UTF-8 encoded distinct values and the UTF-8 data.
+ */
+QByteArray BinaryProjectWriter::encodeTexts(const QVector<QString>& texts) {
+	QHash<QString, int> indices;
+	QVector<QString> dictionary;
+	QVector<int> codes(texts.size());
+	for (int i = 0; i < texts.size(); ++i) {
+		const QString& text = texts.at(i);
+		if (text.isNull()) {
+			codes[i] = -1;
+			continue;
+		}
+		auto it = indices.constFind(text);
+		if (it == indices.constEnd()) {
+			it = indices.insert(text, dictionary.size());
+			dictionary << text;
+		}
+		codes[i] = it.value();
+	}
+
+	return encodeTexts(dictionary, codes);
+}
+
+/*!
+ * encodes the texts given by the distinct values \c dictionary and the dictionary index \c codes of every row.
+ */
+QByteArray BinaryProjectWriter::encodeTexts(const QVector<QString>& dictionary, const QVector<int>& codes) {
+	QVector<qint32> offsets{0};
+	QByteArray utf8;
+	for (const auto& text : dictionary) {
+		utf8 += text.toUtf8();
+		offsets << utf8.size();
+	}
+
+	const qint32 rows = codes.size();
+	const qint32 values = dictionary.size();
+	QByteArray data;
+	data.reserve((int)(2 + codes.size() + offsets.size()) * (int)sizeof(qint32) + utf8.size());
+	data.append(reinterpret_cast<const char*>(&rows), sizeof(qint32));
+	data.append(reinterpret_cast<const char*>(&values), sizeof(qint32));
+	data.append(reinterpret_cast<const char*>(codes.constData()), codes.size() * (int)sizeof(qint32));
+	data.append(reinterpret_cast<const char*>(offsets.constData()), offsets.size() * (int)sizeof(qint32));
+	data.append(utf8);
+
+	return data;
+}
+
+bool BinaryProjectWriter::write(const char* data, qint64 size) {
+	if (!m_ok)
+		return false;
+	if (m_device->write(data, size) != size) {
+		m_ok = false;
+		return false;
+	}
+	m_pos += size;
+	return true;
+}
+
+bool BinaryProjectWriter::align() {
+	static const char zeros[alignment] = {};
+	const qint64 padding = (alignment - m_pos % alignment) % alignment;
+	return write(zeros, padding);
+}
+
+//##############################################################################
+
+BinaryProjectReader::~BinaryProjectReader() {
+	if (m_map)
+		m_file.unmap(m_map);
+}
+
+/*!
+ * opens the file \c fileName and reads the header and the blob table.
+ */
+bool BinaryProjectReader::open(const QString& fileName) {
+	m_file.setFileName(fileName);
+	if (!m_file.open(QIODevice::ReadOnly)) {
+		m_error = i18n("Sorry. Could not open file for reading.");
+		return false;
+	}
+
+	FileHeader header;
+	if (m_file.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header)
+		|| memcmp(header.magic, magic, sizeof(magic)) != 0) {
+		m_error = i18n("The file is not a binary LabPlot project.");
+		return false;
+	}
+	if (header.version > formatVersion) {
+		m_error = i18n("The project was saved with a newer version of LabPlot and can't be opened.");
+		return false;
+	}
+
+	const qint64 fileSize = m_file.size();
+	const qint64 tableSize = header.blobCount * (qint64)sizeof(BinaryProjectBlob);
+	if (header.tableOffset > (quint64)fileSize || (quint64)tableSize > (quint64)fileSize - header.tableOffset
+		|| header.xmlBlob < 0 || (quint32)header.xmlBlob >= header.blobCount) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+
+	m_blobs.resize(header.blobCount);
+	if (!m_file.seek(header.tableOffset)
+		|| m_file.read(reinterpret_cast<char*>(m_blobs.data()), tableSize) != tableSize) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+	// the ranges are checked without overflows, uncompressed blobs are stored with their size
+	// and the sizes of the compressed blobs are limited by LZ4
+	const quint64 maxLZ4Size = std::numeric_limits<int>::max();
+	for (const auto& blob : m_blobs) {
+		const bool validSize = (blob.compression == BinaryProjectBlob::Compression::None && blob.storedSize == blob.size)
+			|| (blob.compression == BinaryProjectBlob::Compression::LZ4 && blob.storedSize <= maxLZ4Size && blob.size <= maxLZ4Size);
+		if (blob.offset > (quint64)fileSize || blob.storedSize > (quint64)fileSize - blob.offset || !validSize) {
+			m_error = i18n("The project file is corrupted.");
+			return false;
+		}
+	}
+	m_xmlBlob = header.xmlBlob;
+	m_unusedSize = header.unusedSize;
+	m_fileSize = fileSize;
+	m_lastModified = QFileInfo(m_file).lastModified();
+
+	// the blobs are copied (or decompressed) from the mapped file, they are read with QFile if the mapping fails
+	m_map = m_file.map(0, fileSize);
+	DEBUG(Q_FUNC_INFO << ", blobs: " << m_blobs.size() << ", mapped: " << (m_map != nullptr))
+
+	return true;
+}
+
+QString BinaryProjectReader::fileName() const {
+	return m_file.fileName();
+}
+
+QString BinaryProjectReader::errorString() const {
+	return m_error;
+}
+
+/*!
+ * returns \c true if the file was modified by someone else after it was opened.
+ */
+bool BinaryProjectReader::isModified() const {
+	const QFileInfo info(m_file.fileName());
+	return info.size() != m_fileSize || info.lastModified() != m_lastModified;
+}
+
+/*!
+ * returns the size of the data in the file that is not used anymore after incremental saves.
+ */
+qint64 BinaryProjectReader::unusedSize() const {
+	return m_unusedSize;
+}
+
+const QVector<BinaryProjectBlob>& BinaryProjectReader::blobs() const {
+	return m_blobs;
+}
+
+/*!
+ * if \c lazy is \c true, the columns read their data from the file on the first access
+ * and not while the project is loaded.
+ */
+void BinaryProjectReader::setLazyLoading(bool lazy) {
+	m_lazyLoading = lazy;
+}
+
+bool BinaryProjectReader::lazyLoading() const {
+	return m_lazyLoading;
+}
+
+/*!
+ * returns the aspect tree of the project as XML.
+ */
+QByteArray BinaryProjectReader::xml() {
+	QByteArray data;
+	if (!readBlob(m_xmlBlob, data))
+		return QByteArray();
+	return data;
+}
+
+/*!
+ * returns the size of the (uncompressed) data of the blob \c index or -1 if there is no such blob.
+ */
+qint64 BinaryProjectReader::blobSize(int index) const {
+	if (index < 0 || index >= m_blobs.size())
+		return -1;
+	return m_blobs.at(index).size;
+}
+
+/*!
+ * reads the data of the blob \c index into \c data, \c size has to be the size of the blob.
+ * The data is always copied into \c data: uncompressed blobs are copied from the mapped file or read
+ * directly into \c data, compressed blobs are decompressed into it without an intermediate copy if the file is mapped.
+ */
+bool BinaryProjectReader::readBlob(int index, char* data, qint64 size) {
+	QMutexLocker locker(&m_mutex);
+	if (blobSize(index) != size) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+
+	const auto& blob = m_blobs.at(index);
+	QByteArray buffer;
+	const char* stored;
+	if (m_map)
+		stored = reinterpret_cast<const char*>(m_map) + blob.offset;
+	else if (blob.compression == BinaryProjectBlob::Compression::None) {
+		// read directly into the destination
+		if (!m_file.seek(blob.offset) || m_file.read(data, size) != size) {
+			m_error = i18n("The project file is corrupted.");
+			return false;
+		}
+		return true;
+	} else {
+		if (!m_file.seek(blob.offset)) {
+			m_error = i18n("The project file is corrupted.");
+			return false;
+		}
+		buffer = m_file.read(blob.storedSize);
+		if ((quint64)buffer.size() != blob.storedSize) {
+			m_error = i18n("The project file is corrupted.");
+			return false;
+		}
+		stored = buffer.constData();
+	}
+
+	switch (blob.compression) {
+	case BinaryProjectBlob::Compression::None:
+		memcpy(data, stored, size);
+		return true;
+	case BinaryProjectBlob::Compression::LZ4:
+#ifdef HAVE_LZ4
+		if (LZ4_decompress_safe(stored, data, (int)blob.storedSize, (int)size) == size)
+			return true;
+		m_error = i18n("The project file is corrupted.");
+#else
+		m_error = i18n("The project file is compressed with LZ4. Your installation of LabPlot lacks the support for it.");
+#endif
+		return false;
+	}
+
+	m_error = i18n("The project file is corrupted.");
+	return false;
+}
+
+bool BinaryProjectReader::readBlob(int index, QByteArray& data) {
+	const qint64 size = blobSize(index);
+	if (size < 0 || size > std::numeric_limits<int>::max()) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+
+	data.resize((int)size);
+	return readBlob(index, data.data(), size);
+}
+
+/*!
+ * reads the data of the blob \c index as it is stored in the file (possibly compressed) into \c stored
+ * and its table entry into \c blob.
+ */
+bool BinaryProjectReader::readStoredBlob(int index, BinaryProjectBlob& blob, QByteArray& stored) {
+	QMutexLocker locker(&m_mutex);
+	if (index < 0 || index >= m_blobs.size() || m_blobs.at(index).storedSize > (quint64)std::numeric_limits<int>::max()) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+
+	blob = m_blobs.at(index);
+	if (m_map) {
+		stored = QByteArray(reinterpret_cast<const char*>(m_map) + blob.offset, (int)blob.storedSize);
+		return true;
+	}
+
+	if (!m_file.seek(blob.offset)) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+	stored = m_file.read(blob.storedSize);
+	if ((quint64)stored.size() != blob.storedSize) {
+		m_error = i18n("The project file is corrupted.");
+		return false;
+	}
+	return true;
+}
+
+/*!
+ * returns \c true if the file \c fileName starts with the magic of the binary project file.
+ */
+bool BinaryProjectReader::isBinaryProject(const QString& fileName) {
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	char data[sizeof(magic)];
+	return file.read(data, sizeof(data)) == sizeof(data) && memcmp(data, magic, sizeof(magic)) == 0;
+}
+
+/*!
+ * decodes the texts encoded with \c BinaryProjectWriter::encodeTexts(),
+ * rows with the same text share the data of the string.
+ */
+bool BinaryProjectReader::decodeTexts(const QByteArray& data, QVector<QString>& texts) {
+	QVector<QString> dictionary;
+	QVector<int> codes;
+	if (!decodeTexts(data, dictionary, codes))
+		return false;
+
+	texts.resize(codes.size());
+	for (int i = 0; i < codes.size(); ++i) {
+		const int code = codes.at(i);
+		texts[i] = (code < 0) ? QString() : dictionary.at(code);
+	}
+
+	return true;
+}
+
+/*!
+ * decodes the texts encoded with \c BinaryProjectWriter::encodeTexts() into the distinct values \c dictionary
+ * and the dictionary index \c codes of every row (-1 for null strings).
+ */
+bool BinaryProjectReader::decodeTexts(const QByteArray& data, QVector<QString>& dictionary, QVector<int>& codes) {
+	const int headerSize = 2 * (int)sizeof(qint32);
+	if (data.size() < headerSize)
+		return false;
+
+	qint32 rows, values;
+	memcpy(&rows, data.constData(), sizeof(qint32));
+	memcpy(&values, data.constData() + sizeof(qint32), sizeof(qint32));
+	if (rows < 0 || values < 0 || headerSize + ((qint64)rows + values + 1) * (qint64)sizeof(qint32) > data.size())
+		return false;
+
+	codes.resize(rows);
+	QVector<qint32> offsets(values + 1);
+	memcpy(codes.data(), data.constData() + headerSize, rows * sizeof(qint32));
+	memcpy(offsets.data(), data.constData() + headerSize + rows * sizeof(qint32), (values + 1) * sizeof(qint32));
+	const int utf8Start = headerSize + (rows + values + 1) * (int)sizeof(qint32);
+
+	// all offsets have to be inside of the UTF-8 data and increasing
+	if (offsets.at(0) < 0 || offsets.at(values) > data.size() - utf8Start)
+		return false;
+	for (int i = 0; i < values; ++i) {
+		if (offsets.at(i) > offsets.at(i + 1))
+			return false;
+	}
+
+	dictionary.resize(values);
+	for (int i = 0; i < values; ++i)
+		dictionary[i] = QString::fromUtf8(data.constData() + utf8Start + offsets.at(i), offsets.at(i + 1) - offsets.at(i));
+
+	for (const int code : codes) {
+		if (code < -1 || code >= values)
+			return false;
+	}
+
+	return true;
+}
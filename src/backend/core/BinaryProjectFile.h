@@ -0,0 +1,121 @@
+/*
+    File                 : BinaryProjectFile.h
+    Project              : LabPlot
+    Description          : binary project file with the column data stored as raw blobs
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef BINARYPROJECTFILE_H
+#define BINARYPROJECTFILE_H
+
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
+class QIODevice;
+class BinaryProjectReader;
+
+//! Entry of the blob table of a binary project file
+struct BinaryProjectBlob {
+	enum class Compression : quint32 {None, LZ4};
+
+	quint64 offset{0};	// position in the file
+	quint64 storedSize{0};	// size in the file (compressed)
+	quint64 size{0};	// size of the (uncompressed) data
+	Compression compression{Compression::None};
+	quint32 reserved{0};
+};
+
+//! Writes a binary project file
+/**
+ * Layout of the binary project file:
+ * - header: magic "LabPlotB", format version, number of blobs, offset of the blob table and index of the XML blob
+ * - blobs: the aspect tree as XML and the data of the columns, every blob starts at a multiple of \c alignment bytes
+ *   and is compressed with LZ4 (if available) when this reduces its size
+ * - blob table: offset, stored size, size and compression of every blob
+ *
+ * When saving incrementally, the new blobs and the new blob table are appended to the existing file and
+ * the header is updated at last. The blobs of the old file remain valid and can be referenced again,
+ * the size of the blobs that are not referenced anymore is stored in the header to decide when to compact the file.
+ *
+ * The data is stored in the byte order of the machine like the base64 encoded column data in the XML project files.
+ */
+class BinaryProjectWriter {
+public:
+	static const int alignment = 64;
+
+	explicit BinaryProjectWriter(QIODevice*);
+
+	bool begin();
+	bool beginAppend(const BinaryProjectReader&);
+	int addBlob(const char* data, qint64 size);
+	int addBlob(const QByteArray&);
+	int copyBlob(BinaryProjectReader&, int index);
+	bool finish(const QByteArray& xml);
+
+	void addReference(const void* object, int index);
+	const QHash<const void*, int>& references() const;
+
+	static QByteArray encodeTexts(const QVector<QString>&);
+	static QByteArray encodeTexts(const QVector<QString>& dictionary, const QVector<int>& codes);
+
+private:
+	bool write(const char* data, qint64 size);
+	bool align();
+
+	QIODevice* m_device;
+	qint64 m_pos{0};
+	bool m_ok{true};
+	QVector<BinaryProjectBlob> m_blobs;
+	QVector<bool> m_used;	// blob is referenced in the saved project
+	const BinaryProjectReader* m_base{nullptr};	// file the blobs are appended to
+	QHash<const void*, int> m_references;
+};
+
+//! Reads a binary project file, the file is mapped into memory if possible
+/**
+ * The blobs can be read from different threads. The reader is shared by the lazily loaded columns
+ * that read their data from it on the first access.
+ */
+class BinaryProjectReader {
+public:
+	~BinaryProjectReader();
+
+	bool open(const QString& fileName);
+	QString fileName() const;
+	QString errorString() const;
+	bool isModified() const;
+	qint64 unusedSize() const;
+	const QVector<BinaryProjectBlob>& blobs() const;
+
+	void setLazyLoading(bool);
+	bool lazyLoading() const;
+
+	QByteArray xml();
+	qint64 blobSize(int index) const;
+	bool readBlob(int index, char* data, qint64 size);
+	bool readBlob(int index, QByteArray&);
+	bool readStoredBlob(int index, BinaryProjectBlob&, QByteArray& stored);
+
+	static bool isBinaryProject(const QString& fileName);
+	static bool decodeTexts(const QByteArray&, QVector<QString>&);
+	static bool decodeTexts(const QByteArray&, QVector<QString>& dictionary, QVector<int>& codes);
+
+private:
+	QFile m_file;
+	uchar* m_map{nullptr};
+	QVector<BinaryProjectBlob> m_blobs;
+	int m_xmlBlob{-1};
+	qint64 m_unusedSize{0};
+	qint64 m_fileSize{0};
+	QDateTime m_lastModified;
+	bool m_lazyLoading{false};
+	QString m_error;
+	QMutex m_mutex;
+};
+
+#endif
@@ -11,12 +11,16 @@
     SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "backend/core/Project.h"
+#include "backend/core/BinaryProjectFile.h"
+#include "backend/core/column/Column.h"
 #include "backend/lib/commandtemplates.h"
+#include "backend/lib/UndoMemory.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/worksheet/Worksheet.h"
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 #include "backend/worksheet/plots/cartesian/BoxPlot.h"
+#include "backend/worksheet/plots/cartesian/DensityPlot.h"
 #include "backend/worksheet/plots/cartesian/Histogram.h"
 #include "backend/worksheet/plots/cartesian/XYEquationCurve.h"
 #include "backend/worksheet/plots/cartesian/XYFitCurve.h"
@@ -35,6 +39,7 @@
 
 #include <QDateTime>
 #include <QFile>
+#include <QFileInfo>
 #include <QMenu>
 #include <QMimeData>
 #include <QThreadPool>
@@ -46,6 +51,7 @@
 #include <KFilterDev>
 #include <KLocalizedString>
 #include <KMessageBox>
+#include <KSharedConfig>
 
 namespace {
 	// xmlVersion of this labplot version
@@ -134,12 +140,54 @@ public:
 	QString author;
 	bool saveCalculations{true};
 	QUndoStack undo_stack;
+	BinaryProjectWriter* binaryWriter{nullptr};	// writer of the column data while saving a binary project file
+	std::shared_ptr<BinaryProjectReader> binaryReader;	// binary project file the project was loaded from or saved to
+	QHash<const void*, int> savedBlobs;	// blobs of the columns in the binary project file saved last
+	int undoLimitIndex{0};	// the commands below this index were released and can't be undone anymore
+	qint64 undoMemoryBudget{1024 * 1024 * 1024LL};	// maximal size of the data held by the undo commands in bytes, 0 for unlimited
+
+	void limitUndoMemory();
 };
 
 int Project::Private::m_versionNumber = 0;
 QString Project::Private::versionString = "";
 int Project::Private::mXmlVersion = 0;
 
+/*!
+ * releases the data of the oldest undo commands if the commands hold more data than the undo memory budget.
+ * The last executed command is always kept. Since QUndoStack doesn't allow to remove single commands,
+ * the released commands remain on the stack. Undoing them is blocked in the main window (see \c Project::canUndo())
+ * and in the undo history (see \c Project::undoLimitIndex()). The released commands refuse to undo and redo
+ * the data, the data is not changed if they are undone nevertheless.
+ */
+void Project::Private::limitUndoMemory() {
+	const int index = undo_stack.index();
+	if (undo_stack.count() == 0)
+		undoLimitIndex = 0;
+
+	if (index < undoLimitIndex || undoMemoryBudget <= 0)
+		return;
+
+	// sum up the memory of the commands starting with the newest one
+	int limit = undoLimitIndex;
+	qint64 size = 0;
+	for (int i = undo_stack.count() - 1; i >= undoLimitIndex; --i) {
+		size += UndoMemory::memorySize(undo_stack.command(i));
+		if (size > undoMemoryBudget) {
+			limit = i + 1;
+			break;
+		}
+	}
+	limit = qMin(limit, qMax(index - 1, 0));
+	if (limit <= undoLimitIndex)
+		return;
+
+	DEBUG(Q_FUNC_INFO << ", undo history uses " << size << " bytes, releasing commands " << undoLimitIndex << " to " << limit - 1)
+	for (int i = undoLimitIndex; i < limit; ++i)
+		UndoMemory::releaseMemory(undo_stack.command(i));
+	undoLimitIndex = limit;
+}
+
 Project::Project() : Folder(i18n("Project"), AspectType::Project), d(new Private(this)) {
 	//load default values for name, comment and author from config
 	KConfig config;
@@ -166,8 +214,13 @@ Project::Project() : Folder(i18n("Project"), AspectType::Project), d(new Private
 	setIsLoading(false);
 	d->changed = false;
 
+	//memory of the undo history
+	const KConfigGroup& settings = KSharedConfig::openConfig()->group("Settings_General");
+	d->undoMemoryBudget = settings.readEntry("UndoMemoryBudget", 1024) * 1024 * 1024LL;
+
 	connect(this, &Project::aspectDescriptionChanged,this, &Project::descriptionChanged);
 	connect(this, &Project::aspectAdded,this, &Project::aspectAddedSlot);
+	connect(&d->undo_stack, &QUndoStack::indexChanged, this, [=]() { d->limitUndoMemory(); });
 }
 
 Project::~Project() {
@@ -209,6 +262,42 @@ QUndoStack* Project::undoStack() const {
 	return &d->undo_stack;
 }
 
+/*!
+ * returns \c true if the last executed command can be undone,
+ * \c false if there is no command to undo or its data was released because of the undo memory budget.
+ */
+bool Project::canUndo() const {
+	return d->undo_stack.canUndo() && d->undo_stack.index() > d->undoLimitIndex;
+}
+
+/*!
+ * returns the index of the undo stack below which the commands were released because of the undo memory budget.
+ * The project can't be brought back into the states before this index.
+ */
+int Project::undoLimitIndex() const {
+	return d->undoLimitIndex;
+}
+
+/*!
+ * sets the maximal size of the data held by the undo commands of the project in bytes (0 for unlimited).
+ * When the budget is exceeded, the oldest commands can't be undone anymore.
+ * The default is read from the general settings.
+ */
+void Project::setUndoMemoryBudget(qint64 bytes) {
+	d->undoMemoryBudget = bytes;
+	d->limitUndoMemory();
+}
+
+/*!
+ * returns the size of the data held by the undo commands of the project in bytes
+ */
+qint64 Project::undoMemorySize() const {
+	qint64 size = 0;
+	for (int i = 0; i < d->undo_stack.count(); ++i)
+		size += UndoMemory::memorySize(d->undo_stack.command(i));
+	return size;
+}
+
 QMenu* Project::createContextMenu() {
 	QMenu* menu = AbstractAspect::createContextMenu();
 
@@ -298,6 +387,9 @@ void Project::descriptionChanged(const AbstractAspect* aspect) {
 
 		const auto& boxPlots = children<BoxPlot>(ChildIndexFlag::Recursive);
 		updateColumnDependencies(boxPlots, column);
+
+		const auto& densityPlots = children<DensityPlot>(ChildIndexFlag::Recursive);
+		updateColumnDependencies(densityPlots, column);
 	}
 
 	d->changed = true;
@@ -341,6 +433,10 @@ void Project::aspectAddedSlot(const AbstractAspect* aspect) {
 	const auto& boxPlots = children<BoxPlot>(ChildIndexFlag::Recursive);
 	for (auto column : columns)
 		updateColumnDependencies(boxPlots, column);
+
+	const auto& densityPlots = children<DensityPlot>(ChildIndexFlag::Recursive);
+	for (auto column : columns)
+		updateColumnDependencies(densityPlots, column);
 }
 
 //TODO: move this update*() functions into the classes, Project shouldn't be aware of the details
@@ -441,6 +537,29 @@ void Project::updateColumnDependencies(const QVector<BoxPlot*>& boxPlots, const
 	}
 }
 
+void Project::updateColumnDependencies(const QVector<DensityPlot*>& densityPlots, const AbstractColumn* column) const {
+	const QString& columnPath = column->path();
+	for (auto* densityPlot : densityPlots) {
+		if (densityPlot->xColumnPath() == columnPath) {
+			densityPlot->setUndoAware(false);
+			densityPlot->setXColumn(column);
+			densityPlot->setUndoAware(true);
+		}
+
+		if (densityPlot->yColumnPath() == columnPath) {
+			densityPlot->setUndoAware(false);
+			densityPlot->setYColumn(column);
+			densityPlot->setUndoAware(true);
+		}
+
+		if (densityPlot->valuesColumnPath() == columnPath) {
+			densityPlot->setUndoAware(false);
+			densityPlot->setValuesColumn(column);
+			densityPlot->setUndoAware(true);
+		}
+	}
+}
+
 void Project::navigateTo(const QString& path) {
 	Q_EMIT requestNavigateTo(path);
 }
@@ -449,11 +568,19 @@ bool Project::isLabPlotProject(const QString& fileName) {
 	return fileName.endsWith(QStringLiteral(".lml"), Qt::CaseInsensitive)
 			|| fileName.endsWith(QStringLiteral(".lml.gz"), Qt::CaseInsensitive)
 			|| fileName.endsWith(QStringLiteral(".lml.bz2"), Qt::CaseInsensitive)
-			|| fileName.endsWith(QStringLiteral(".lml.xz"), Qt::CaseInsensitive);
+			|| fileName.endsWith(QStringLiteral(".lml.xz"), Qt::CaseInsensitive)
+			|| isBinaryProject(fileName);
+}
+
+/*!
+ * returns \c true if \c fileName is a binary project file (XML of the aspect tree and raw column data).
+ */
+bool Project::isBinaryProject(const QString& fileName) {
+	return fileName.endsWith(QStringLiteral(".lmlb"), Qt::CaseInsensitive);
 }
 
 QString Project::supportedExtensions() {
-	static const QString extensions = "*.lml *.lml.gz *.lml.bz2 *.lml.xz *.LML *.LML.GZ *.LML.BZ2 *.LML.XZ";
+	static const QString extensions = "*.lml *.lml.gz *.lml.bz2 *.lml.xz *.lmlb *.LML *.LML.GZ *.LML.BZ2 *.LML.XZ *.LMLB";
 	return extensions;
 }
 
@@ -511,6 +638,111 @@ void Project::save(const QPixmap& thumbnail, QXmlStreamWriter* writer) const {
 	save(writer);
 }
 
+/*!
+ * saves the project as binary project file into \c device, which has to be seekable (e.g. a file).
+ * The aspect tree is saved as XML, the data of the columns is saved as raw binary blobs
+ * that are read without parsing and decoding when loading the project.
+ */
+bool Project::saveBinary(const QPixmap& thumbnail, QIODevice* device) const {
+	BinaryProjectWriter binaryWriter(device);
+	return binaryWriter.begin() && saveBinary(thumbnail, binaryWriter);
+}
+
+/*!
+ * saves the project into the binary project file it was loaded from or saved to before (see \c attachBinaryFile()).
+ * Only the data of the columns changed since then and the aspect tree as XML are appended to the file,
+ * the blobs of the unchanged columns are referenced again.
+ *
+ * Returns \c false without changing the file if this is not possible, e.g. if the file was modified by someone else,
+ * or if more than half of the file is not used anymore. The project has to be saved completely with \c saveBinary() then,
+ * which also compacts the file.
+ */
+bool Project::saveBinaryIncremental(const QPixmap& thumbnail) {
+	const auto binaryReader = d->binaryReader;
+	if (!binaryReader || binaryReader->fileName() != d->fileName || binaryReader->isModified())
+		return false;
+
+	QFile file(d->fileName);
+	const qint64 size = file.size();
+	if (binaryReader->unusedSize() * 2 > size) {
+		DEBUG(Q_FUNC_INFO << ", compaction required, unused size: " << binaryReader->unusedSize() << " of " << size)
+		return false;
+	}
+
+	if (!file.open(QIODevice::ReadWrite))
+		return false;
+
+	BinaryProjectWriter binaryWriter(&file);
+	if (!binaryWriter.beginAppend(*binaryReader) || !saveBinary(thumbnail, binaryWriter)) {
+		// the appended blobs are not referenced by the old header, remove them again
+		file.resize(size);
+		return false;
+	}
+	file.close();
+	DEBUG(Q_FUNC_INFO << ", appended " << QFileInfo(d->fileName).size() - size << " bytes")
+
+	return attachBinaryFile(d->fileName);
+}
+
+/*!
+ * lets the columns refer to their data in the binary project file \c fileName that was just written with
+ * \c saveBinary() or \c saveBinaryIncremental(). Unchanged columns are not written again when saving
+ * incrementally into this file and their data can be unloaded and read from the file again.
+ */
+bool Project::attachBinaryFile(const QString& fileName) {
+	auto binaryReader = std::make_shared<BinaryProjectReader>();
+	if (!binaryReader->open(fileName)) {
+		d->binaryReader.reset();
+		d->savedBlobs.clear();
+		return false;
+	}
+
+	const auto& columns = children<Column>(ChildIndexFlag::Recursive | ChildIndexFlag::IncludeHidden);
+	for (auto* column : columns) {
+		const auto it = d->savedBlobs.constFind(column);
+		if (it != d->savedBlobs.constEnd())
+			column->attachToFile(binaryReader, it.value());
+	}
+	d->savedBlobs.clear();
+	d->binaryReader = binaryReader;
+
+	return true;
+}
+
+/*!
+ * reads the data of all columns that is not loaded yet and releases the binary project file.
+ */
+void Project::detachBinaryFile() {
+	const auto& columns = children<Column>(ChildIndexFlag::Recursive | ChildIndexFlag::IncludeHidden);
+	for (auto* column : columns)
+		column->detachFromFile();
+	d->binaryReader.reset();
+}
+
+bool Project::saveBinary(const QPixmap& thumbnail, BinaryProjectWriter& binaryWriter) const {
+	QByteArray xml;
+	QBuffer buffer(&xml);
+	buffer.open(QIODevice::WriteOnly);
+	QXmlStreamWriter writer(&buffer);
+	d->binaryWriter = &binaryWriter;
+	save(thumbnail, &writer);
+	d->binaryWriter = nullptr;
+
+	if (!binaryWriter.finish(xml))
+		return false;
+
+	// the columns refer to these blobs after the file was attached
+	d->savedBlobs = binaryWriter.references();
+	return true;
+}
+
+/*!
+ * returns the writer of the column data while the project is saved with \c saveBinary(), \c nullptr otherwise.
+ */
+BinaryProjectWriter* Project::binaryWriter() const {
+	return d->binaryWriter;
+}
+
 /**
  * \brief Save as XML
  */
@@ -533,6 +765,30 @@ void Project::save(QXmlStreamWriter* writer) const {
 
 bool Project::load(const QString& filename, bool preview) {
 	DEBUG(Q_FUNC_INFO << ", LOADING file " << STDSTRING(filename))
+	if (BinaryProjectReader::isBinaryProject(filename)) {
+		auto binaryReader = std::make_shared<BinaryProjectReader>();
+		if (!binaryReader->open(filename)) {
+			KMessageBox::error(nullptr, binaryReader->errorString(), i18n("Error opening project"));
+			return false;
+		}
+
+		// the column data is read from the blobs referenced in the XML,
+		// with lazy loading the columns keep the reader and read their data on the first access
+		const KConfigGroup group = KSharedConfig::openConfig()->group(QLatin1String("Settings_General"));
+		binaryReader->setLazyLoading(group.readEntry(QLatin1String("LazyLoading"), true));
+		Column::setLoadedDataBudget(group.readEntry(QLatin1String("LazyLoadingMemoryBudget"), 0) * 1024 * 1024LL);
+
+		XmlStreamReader reader(binaryReader->xml());
+		reader.setBinaryReader(binaryReader);
+		if (!loadXml(&reader, filename, preview))
+			return false;
+
+		// the file is used for incremental saves
+		if (!preview)
+			d->binaryReader = binaryReader;
+		return true;
+	}
+
 	QIODevice* file;
 	if (filename.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive)) {
 		DEBUG(Q_FUNC_INFO << ", filename ends with .lml")
@@ -586,23 +842,32 @@ bool Project::load(const QString& filename, bool preview) {
 
 	//parse XML
 	XmlStreamReader reader(file);
+	rc = loadXml(&reader, filename, preview);
+	file->close();
+	delete file;
+
+	return rc;
+}
+
+/*!
+ * loads the project from \c reader and reports the errors and warnings.
+ */
+bool Project::loadXml(XmlStreamReader* reader, const QString& filename, bool preview) {
 	setIsLoading(true);
-	rc = this->load(&reader, preview);
+	bool rc = this->load(reader, preview);
 	setIsLoading(false);
 	if (rc == false) {
 		RESET_CURSOR;
-		QString msg = reader.errorString();
+		QString msg = reader->errorString();
 		if (msg.isEmpty())
 			msg = i18n("Unknown error when opening the project %1.", filename);
 		KMessageBox::error(nullptr, msg, i18n("Error when opening the project"));
-		file->close();
-		delete file;
 		return false;
 	}
 
-	if (reader.hasWarnings()) {
+	if (reader->hasWarnings()) {
 		qWarning("The following problems occurred when loading the project file:");
-		const QStringList& warnings = reader.warningStrings();
+		const QStringList& warnings = reader->warningStrings();
 		for (const auto& str : warnings)
 			qWarning() << qUtf8Printable(str);
 
@@ -610,25 +875,19 @@ bool Project::load(const QString& filename, bool preview) {
 // 		KMessageBox::error(this, msg, i18n("Project loading partly failed"));
 	}
 
-	if (reader.hasMissingCASWarnings()) {
+	if (reader->hasMissingCASWarnings()) {
 		RESET_CURSOR;
 
 		const QString& msg = i18n("The project has content written with %1. "
 						"Your installation of LabPlot lacks the support for it.\n\n "
 						"You won't be able to see this part of the project. "
 						"If you modify and save the project, the CAS content will be lost.\n\n"
-						"Do you want to continue?", reader.missingCASWarning());
+						"Do you want to continue?", reader->missingCASWarning());
 		auto rc = KMessageBox::warningYesNo(nullptr, msg, i18n("Missing Support for CAS"));
-		if (rc == KMessageBox::ButtonCode::No) {
-			file->close();
-			delete file;
+		if (rc == KMessageBox::ButtonCode::No)
 			return false;
-		}
 	}
 
-	file->close();
-	delete file;
-
 	return true;
 }
 
@@ -915,6 +1174,20 @@ void Project::restorePointers(AbstractAspect* aspect, bool preview) {
 		boxPlot->setDataColumns(dataColumns);
 	}
 
+	//density plots
+	QVector<DensityPlot*> densityPlots;
+	if (hasChildren)
+		densityPlots = aspect->children<DensityPlot>(ChildIndexFlag::Recursive);
+	else if (aspect->type() == AspectType::DensityPlot)
+		densityPlots << static_cast<DensityPlot*>(aspect);
+
+	for (auto* densityPlot : densityPlots) {
+		if (!densityPlot) continue;
+		RESTORE_COLUMN_POINTER(densityPlot, xColumn, XColumn);
+		RESTORE_COLUMN_POINTER(densityPlot, yColumn, YColumn);
+		RESTORE_COLUMN_POINTER(densityPlot, valuesColumn, ValuesColumn);
+	}
+
 	//data picker curves
 #ifndef SDK
 	QVector<DatapickerCurve*> dataPickerCurves;
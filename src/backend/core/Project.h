@@ -16,7 +16,9 @@
 #include "backend/lib/macros.h"
 
 class AbstractColumn;
+class BinaryProjectWriter;
 class BoxPlot;
+class DensityPlot;
 class Histogram;
 class XYCurve;
 class QMimeData;
@@ -43,6 +45,10 @@ public:
 		return this;
 	}
 	QUndoStack* undoStack() const override;
+	qint64 undoMemorySize() const;
+	bool canUndo() const;
+	int undoLimitIndex() const;
+	void setUndoMemoryBudget(qint64 bytes);
 	QString path() const override {
 		return name();
 	}
@@ -64,12 +70,18 @@ public:
 	bool aspectAddedSignalSuppressed() const;
 
 	void save(const QPixmap&, QXmlStreamWriter*) const;
+	bool saveBinary(const QPixmap&, QIODevice*) const;
+	bool saveBinaryIncremental(const QPixmap&);
+	bool attachBinaryFile(const QString& fileName);
+	void detachBinaryFile();
+	BinaryProjectWriter* binaryWriter() const;
 	bool load(XmlStreamReader*, bool preview) override;
 	bool load(const QString&, bool preview = false);
 	static void restorePointers(AbstractAspect*, bool preview = false);
 	static void retransformElements(AbstractAspect*);
 
 	static bool isLabPlotProject(const QString& fileName);
+	static bool isBinaryProject(const QString& fileName);
 	static QString supportedExtensions();
 	QVector<quintptr> droppedAspects(const QMimeData*);
 	static QString version();
@@ -99,7 +111,10 @@ private:
 	void updateColumnDependencies(const QVector<XYCurve*>&, const AbstractColumn*) const;
 	void updateColumnDependencies(const QVector<Histogram*>&, const AbstractColumn*) const;
 	void updateColumnDependencies(const QVector<BoxPlot*>& boxPlots, const AbstractColumn* column) const;
+	void updateColumnDependencies(const QVector<DensityPlot*>&, const AbstractColumn*) const;
 	bool readProjectAttributes(XmlStreamReader*);
+	bool loadXml(XmlStreamReader*, const QString& fileName, bool preview);
+	bool saveBinary(const QPixmap&, BinaryProjectWriter&) const;
 	void save(QXmlStreamWriter*) const override;
 };
 
@@ -15,7 +15,9 @@
 #include "backend/core/column/ColumnStringIO.h"
 #include "backend/core/column/columncommands.h"
 #include "backend/core/AbstractSimpleFilter.h"
+#include "backend/core/BinaryProjectFile.h"
 #include "backend/core/Project.h"
+#include "backend/lib/parallel.h"
 #include "backend/lib/trace.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/core/datatypes/String2DateTimeFilter.h"
@@ -33,17 +35,17 @@
 #include <QClipboard>
 #include <QFont>
 #include <QFontMetrics>
+#include <QHash>
 #include <QIcon>
 #include <QMenu>
 #include <QMimeData>
 #include <QThreadPool>
 
 #include <array>
-#include <unordered_map>
+#include <cstring>
 
 extern "C" {
 #include <gsl/gsl_math.h>
-#include <gsl/gsl_statistics.h>
 }
 
 /**
@@ -89,7 +91,9 @@ Column::Column(const QString& name, const QVector<QString> &data)
 }
 
 Column::Column(const QString& name, const QVector<QDateTime>& data, ColumnMode mode)
-	: AbstractColumn(name, AspectType::Column), d(new ColumnPrivate(this, mode, new QVector<QDateTime>(data))) {
+	: AbstractColumn(name, AspectType::Column), d(new ColumnPrivate(this, mode, new QVector<qint64>(ColumnPrivate::toMSecs(data)))) {
+	if (!data.isEmpty())
+		d->setTimeSpec(data.constFirst());
 	init();
 }
 
@@ -104,6 +108,7 @@ void Column::init() {
 	d->outputFilter()->setHidden(true);
 	addChildFast(d->inputFilter());
 	addChildFast(d->outputFilter());
+	connect(this, &AbstractColumn::maskingChanged, this, [=]{d->invalidateCachedValues();});
 }
 
 Column::~Column() {
@@ -122,7 +127,6 @@ QMenu* Column::createContextMenu() {
 
 		m_usedInActionGroup = new QActionGroup(this);
 		connect(m_usedInActionGroup, &QActionGroup::triggered, this, &Column::navigateTo);
-		connect(this, &AbstractColumn::maskingChanged, this, [=]{d->invalidate();});
 	}
 
 	QMenu* menu = AbstractAspect::createContextMenu();
@@ -415,7 +419,7 @@ bool Column::copy(const AbstractColumn* source, int source_start, int dest_start
 }
 
 void Column::invalidateProperties() {
-	d->available.setUnavailable();
+	d->invalidate();
 }
 
 /**
@@ -427,7 +431,12 @@ void Column::handleRowInsertion(int before, int count) {
 	if (!m_suppressDataChangedSignal)
 		Q_EMIT dataChanged(this);
 
-	invalidateProperties();
+	// rows inserted after the accumulated rows don't change their statistics,
+	// the min/max index was already updated for the shifted rows
+	const int statisticsRows = d->available.statisticsRows;
+	d->available.setUnavailable();
+	if (before >= statisticsRows)
+		d->available.statisticsRows = statisticsRows;
 }
 
 /**
@@ -439,7 +448,7 @@ void Column::handleRowRemoval(int first, int count) {
 	if (!m_suppressDataChangedSignal)
 		Q_EMIT dataChanged(this);
 
-	invalidateProperties();
+	d->available.setUnavailable();
 }
 
 /**
@@ -585,6 +594,46 @@ void Column::addValueLabel(const QString& value, const QString& label) {
 	d->addValueLabel(value, label);
 }
 
+/*!
+ * returns \c true if the texts are stored as the index of every row in the sorted dictionary of the distinct values.
+ * Sorting and searching use the indices and compare every distinct value only once.
+ */
+bool Column::isDictionaryEncoded() const {
+	return d->isDictionaryEncoded();
+}
+
+/*!
+ * stores the texts of the column dictionary encoded. For \c lowCardinalityOnly = true (used on import),
+ * the texts are only encoded if every distinct value is repeated ten times on average.
+ * Returns \c true if the texts are dictionary encoded.
+ *
+ * The texts are expanded again when they are accessed with data() or when values not in the dictionary are set.
+ */
+bool Column::encodeDictionary(bool lowCardinalityOnly) {
+	return d->encodeDictionary(lowCardinalityOnly ? ColumnPrivate::maxDictionarySize(rowCount()) : -1);
+}
+
+void Column::decodeDictionary() {
+	d->decodeDictionary();
+}
+
+/*!
+ * returns the sorted distinct values of the dictionary encoded texts, \sa dictionaryCodes().
+ * The column has to be pinned with a \c DataPin as long as the reference is used.
+ */
+const QVector<QString>& Column::dictionary() const {
+	return d->dictionary();
+}
+
+/*!
+ * returns the index in dictionary() of the text in every row (-1 for null strings) of the dictionary encoded texts.
+ * The order of the indices is the order of the texts.
+ * The column has to be pinned with a \c DataPin as long as the reference is used.
+ */
+const QVector<int>& Column::dictionaryCodes() const {
+	return d->dictionaryCodes();
+}
+
 /**
  * \brief Set the content of row 'row'
  *
@@ -592,7 +641,6 @@ void Column::addValueLabel(const QString& value, const QString& label) {
  */
 void Column::setDateAt(int row, QDate new_value) {
 	setDateTimeAt(row, QDateTime(new_value, timeAt(row)));
-	invalidateProperties();
 }
 
 /**
@@ -602,7 +650,6 @@ void Column::setDateAt(int row, QDate new_value) {
  */
 void Column::setTimeAt(int row, QTime new_value) {
 	setDateTimeAt(row, QDateTime(dateAt(row), new_value));
-	invalidateProperties();
 }
 
 /**
@@ -615,7 +662,6 @@ void Column::setDateTimeAt(int row, const QDateTime& new_value) {
 		d->setValueAt(row, new_value);
 	else
 		exec(new ColumnSetCmd<QDateTime>(d, row, dateTimeAt(row), new_value));
-	invalidateProperties();
 }
 
 void Column::setDateTimes(const QVector<QDateTime>& dateTimes) {
@@ -630,9 +676,27 @@ void Column::setDateTimes(const QVector<QDateTime>& dateTimes) {
 void Column::replaceDateTimes(int first, const QVector<QDateTime>& new_values) {
 	if (isLoading())
 		d->replaceDateTimes(first, new_values);
-	else
-		exec(new ColumnReplaceCmd<QDateTime>(d, first, new_values));
-	invalidateProperties();
+	else {
+		if (!new_values.isEmpty())
+			d->setTimeSpec(new_values.constFirst());
+		exec(new ColumnReplaceCmd<qint64>(d, first, ColumnPrivate::toMSecs(new_values)));
+	}
+}
+
+/*!
+ * returns the milliseconds since epoch of \c dateTime as stored in DateTime, Month and Day columns,
+ * \sa invalidDateTime() for invalid values.
+ */
+qint64 Column::dateTimeToMSecs(const QDateTime& dateTime) {
+	return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : invalidDateTime();
+}
+
+/*!
+ * sets the time spec used to convert the stored milliseconds since epoch to QDateTime,
+ * e.g. Qt::LocalTime after the values were written directly into data().
+ */
+void Column::setTimeSpec(Qt::TimeSpec spec) {
+	d->setTimeSpec(spec);
 }
 
 void Column::addValueLabel(const QDateTime& value, const QString& label) {
@@ -654,7 +718,6 @@ void Column::setValueAt(int row, const double new_value) {
 		d->setValueAt(row, new_value);
 	else
 		exec(new ColumnSetCmd<double>(d, row, valueAt(row), new_value));
-	invalidateProperties();
 }
 
 /**
@@ -667,7 +730,6 @@ void Column::replaceValues(int first, const QVector<double>& new_values) {
 		d->replaceValues(first, new_values);
 	else
 		exec(new ColumnReplaceCmd<double>(d, first, new_values));
-	invalidateProperties();
 }
 
 void Column::addValueLabel(double value, const QString& label) {
@@ -690,7 +752,6 @@ void Column::setIntegerAt(int row, const int new_value) {
 		d->setValueAt(row, new_value);
 	else
 		exec(new ColumnSetCmd<int>(d, row, integerAt(row), new_value));
-	invalidateProperties();
 }
 
 /**
@@ -703,7 +764,6 @@ void Column::replaceInteger(int first, const QVector<int>& new_values) {
 		d->replaceInteger(first, new_values);
 	else
 		exec(new ColumnReplaceCmd<int>(d, first, new_values));
-	invalidateProperties();
 }
 
 void Column::addValueLabel(int value, const QString& label) {
@@ -725,7 +785,6 @@ void Column::setBigIntAt(int row, const qint64 new_value) {
 		d->setValueAt(row, new_value);
 	else
 		exec(new ColumnSetCmd<qint64>(d, row, bigIntAt(row), new_value));
-	invalidateProperties();
 }
 
 /**
@@ -738,7 +797,6 @@ void Column::replaceBigInt(int first, const QVector<qint64>& new_values) {
 		d->replaceBigInt(first, new_values);
 	else
 		exec(new ColumnReplaceCmd<qint64>(d, first, new_values));
-	invalidateProperties();
 }
 
 void Column::addValueLabel(qint64 value, const QString& label) {
@@ -758,214 +816,308 @@ AbstractColumn::Properties Column::properties() const {
 	return d->properties;
 }
 
-const Column::ColumnStatistics& Column::statistics() const {
-	if (!d->available.statistics)
-		calculateStatistics();
+// minimal number of rows accumulated in one task when calculating the statistics in parallel
+static const int statisticsChunkSize = 1 << 20;
 
-	return d->statistics;
+/*!
+ * adds the valid (not NAN and not masked) values of the rows \c first .. \c last - 1 of \c data to \c accumulator.
+ * The values are passed in small blocks, the data is not copied.
+ */
+template<typename T>
+static void addValidValues(const Column* column, const QVector<T>* data, int first, int last, StatisticsAccumulator& accumulator) {
+	const int blockSize = 1024;
+	double block[blockSize];
+	int size = 0;
+	// iterate over the runs of unmasked rows
+	for (int row = column->nextUnmaskedRow(first); row < last; row = column->nextUnmaskedRow(row)) {
+		const int end = qMin(column->nextMaskedRow(row), last);
+		for (; row < end; ++row) {
+			const double val = data->at(row);
+			if (std::isnan(val))
+				continue;
+
+			block[size++] = val;
+			if (size == blockSize) {
+				accumulator.add(block, size);
+				size = 0;
+			}
+		}
+	}
+	accumulator.add(block, size);
 }
 
-void Column::calculateStatistics() const {
-	if ( (columnMode() != ColumnMode::Double) && (columnMode() != ColumnMode::Integer)
-			&& (columnMode() != ColumnMode::BigInt) )
+template<typename T>
+static void accumulateValidValues(const Column* column, const QVector<T>* data, int first, StatisticsAccumulator& accumulator) {
+	const int rows = data->size() - first;
+	const int chunks = qMin(QThreadPool::globalInstance()->maxThreadCount(), rows / statisticsChunkSize);
+	if (chunks < 2) {
+		addValidValues(column, data, first, data->size(), accumulator);
 		return;
+	}
 
-	PERFTRACE("calculate column statistics");
-
-	d->statistics = ColumnStatistics();
-	ColumnStatistics& statistics = d->statistics;
-
-	//######  location measures  #######
-	int rowValuesSize = 0;
-	double val;
-	double columnSum = 0.0;
-	double columnProduct = 1.0;
-	double columnSumNeg = 0.0;
-	double columnSumSquare = 0.0;
-	statistics.minimum = qInf();
-	statistics.maximum = -qInf();
-	std::unordered_map<double, int> frequencyOfValues;
-	QVector<double> rowData;
-
-	if (columnMode() == ColumnMode::Double) {
-		auto* rowValues = reinterpret_cast<QVector<double>*>(data());
-		rowValuesSize = rowValues->size();
-		rowData.reserve(rowValuesSize);
-
-		for (int row = 0; row < rowValuesSize; ++row) {
-			val = rowValues->value(row);
-			if (std::isnan(val) || isMasked(row))
-				continue;
+	// large data is accumulated in parallel chunks which are merged afterwards
+	const int chunkSize = rows / chunks + 1;
+	QVector<StatisticsAccumulator> accumulators(chunks);
+	runChunked(rows, chunkSize, [&](int start, int count) {
+		addValidValues(column, data, first + start, first + start + count, accumulators[start / chunkSize]);
+	});
+	for (const auto& partial : accumulators)
+		accumulator.merge(partial);
+}
 
-			if (val < statistics.minimum)
-				statistics.minimum = val;
-			if (val > statistics.maximum)
-				statistics.maximum = val;
-			columnSum += val;
-			columnSumNeg += (1.0 / val);
-			columnSumSquare += val*val;
-			columnProduct *= val;
-			if (frequencyOfValues.find(val) != frequencyOfValues.end())
-				frequencyOfValues.operator [](val)++;
-			else
-				frequencyOfValues.insert(std::make_pair(val, 1));
-			rowData.push_back(val);
-		}
-	} else if (columnMode() == ColumnMode::Integer) {
-		//TODO: code duplication because of the reinterpret_cast...
-		auto* rowValues = reinterpret_cast<QVector<int>*>(data());
-		rowValuesSize = rowValues->size();
-		rowData.reserve(rowValuesSize);
-		for (int row = 0; row < rowValuesSize; ++row) {
-			val = rowValues->value(row);
-			if (std::isnan(val) || isMasked(row))
-				continue;
+/*!
+ * adds the valid values of the rows \c first .. end of the column to \c accumulator
+ */
+static void accumulateValidValues(const Column* column, int first, StatisticsAccumulator& accumulator) {
+	const Column::DataPin pin(column);
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Double:
+		accumulateValidValues(column, static_cast<const QVector<double>*>(column->constData()), first, accumulator);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		accumulateValidValues(column, static_cast<const QVector<int>*>(column->constData()), first, accumulator);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		accumulateValidValues(column, static_cast<const QVector<qint64>*>(column->constData()), first, accumulator);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+}
 
-			if (val < statistics.minimum)
-				statistics.minimum = val;
-			if (val > statistics.maximum)
-				statistics.maximum = val;
-			columnSum += val;
-			columnSumNeg += (1.0 / val);
-			columnSumSquare += val*val;
-			columnProduct *= val;
-			if (frequencyOfValues.find(val) != frequencyOfValues.end())
-				frequencyOfValues.operator [](val)++;
-			else
-				frequencyOfValues.insert(std::make_pair(val, 1));
-			rowData.push_back(val);
+/*!
+ * appends the valid (not NAN and not masked) values of \c data to \c values
+ */
+template<typename T>
+static void appendValidValues(const Column* column, const QVector<T>* data, QVector<double>& values) {
+	values.reserve(data->size());
+	// iterate over the runs of unmasked rows
+	for (int row = column->nextUnmaskedRow(0); row < data->size(); row = column->nextUnmaskedRow(row)) {
+		const int end = qMin(column->nextMaskedRow(row), data->size());
+		for (; row < end; ++row) {
+			const double val = data->at(row);
+			if (!std::isnan(val))
+				values.push_back(val);
 		}
-	} else if (columnMode() == ColumnMode::BigInt) {
-		//TODO: code duplication because of the reinterpret_cast...
-		auto* rowValues = reinterpret_cast<QVector<qint64>*>(data());
-		rowValuesSize = rowValues->size();
-		rowData.reserve(rowValuesSize);
-		for (int row = 0; row < rowValuesSize; ++row) {
-			val = rowValues->value(row);
-			if (std::isnan(val) || isMasked(row))
-				continue;
+	}
+}
 
-			if (val < statistics.minimum)
-				statistics.minimum = val;
-			if (val > statistics.maximum)
-				statistics.maximum = val;
-			columnSum += val;
-			columnSumNeg += (1.0 / val);
-			columnSumSquare += val*val;
-			columnProduct *= val;
-			if (frequencyOfValues.find(val) != frequencyOfValues.end())
-				frequencyOfValues.operator [](val)++;
-			else
-				frequencyOfValues.insert(std::make_pair(val, 1));
-			rowData.push_back(val);
-		}
+static QVector<double> validValues(const Column* column) {
+	const Column::DataPin pin(column);
+	QVector<double> values;
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Double:
+		appendValidValues(column, static_cast<const QVector<double>*>(column->constData()), values);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		appendValidValues(column, static_cast<const QVector<int>*>(column->constData()), values);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		appendValidValues(column, static_cast<const QVector<qint64>*>(column->constData()), values);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
 	}
 
-	const int notNanCount = rowData.size();
+	return values;
+}
 
-	if (notNanCount == 0) {
-		d->available.statistics = true;
-		d->available.min = true;
-		d->available.max = true;
-		return;
+/*!
+ * calculates the quantiles for the ascending probabilities \c p of the unsorted values in \c data by selection
+ * (interpolated like in gsl_stats_quantile_from_sorted_data()). The values in \c data are reordered.
+ */
+static void selectQuantiles(double* data, int n, const double* p, double* quantiles, int count) {
+	int begin = 0;
+	for (int i = 0; i < count; ++i) {
+		const double index = p[i] * (n - 1);
+		const int lhs = (int)index;
+		const double delta = index - lhs;
+
+		// all values before 'begin' are not larger than the values after it
+		std::nth_element(data + begin, data + lhs, data + n);
+		begin = lhs;
+
+		if (lhs == n - 1 || delta == 0.)
+			quantiles[i] = data[lhs];
+		else
+			quantiles[i] = (1 - delta) * data[lhs] + delta * *std::min_element(data + lhs + 1, data + n);
 	}
+}
 
-	if (rowData.size() < rowValuesSize)
-		rowData.squeeze();
+// probabilities of the quantiles shown in the statistics
+static const std::array<double, 9> quantileProbabilities{{0.01, 0.05, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99}};
 
-	statistics.size = notNanCount;
-	statistics.arithmeticMean = columnSum / notNanCount;
-	statistics.geometricMean = pow(columnProduct, 1.0 / notNanCount);
-	statistics.harmonicMean = notNanCount / columnSumNeg;
-	statistics.contraharmonicMean = columnSumSquare / columnSum;
+static void setQuantiles(AbstractColumn::ColumnStatistics& statistics, const std::array<double, 9>& quantiles) {
+	statistics.percentile_1 = quantiles[0];
+	statistics.percentile_5 = quantiles[1];
+	statistics.percentile_10 = quantiles[2];
+	statistics.firstQuartile = quantiles[3];
+	statistics.median = quantiles[4];
+	statistics.thirdQuartile = quantiles[5];
+	statistics.percentile_90 = quantiles[6];
+	statistics.percentile_95 = quantiles[7];
+	statistics.percentile_99 = quantiles[8];
+	statistics.iqr = statistics.thirdQuartile - statistics.firstQuartile;
+	statistics.trimean = (statistics.firstQuartile + 2*statistics.median + statistics.thirdQuartile) / 4;
+}
 
-	//calculate the mode, the most frequent value in the data set
-	int maxFreq = 0;
-	double mode = NAN;
-	for (const auto& it : frequencyOfValues) {
-		if (it.second > maxFreq) {
-			maxFreq = it.second;
-			mode = it.first;
-		}
-	}
-	//check how many times the max frequency occurs in the data set.
-	//if more than once, we have a multi-modal distribution and don't show any mode
+/*!
+ * sets the quantiles and the deviations estimated from the sketch of \c accumulator
+ */
+static void setEstimatedQuantiles(AbstractColumn::ColumnStatistics& statistics, const StatisticsAccumulator& accumulator) {
+	std::array<double, 9> quantiles;
+	for (size_t i = 0; i < quantiles.size(); ++i)
+		quantiles[i] = accumulator.quantile(quantileProbabilities[i]);
+	setQuantiles(statistics, quantiles);
+
+	statistics.meanDeviation = accumulator.meanDeviation(statistics.arithmeticMean);
+	statistics.meanDeviationAroundMedian = accumulator.meanDeviation(statistics.median);
+	statistics.medianDeviation = accumulator.medianDeviation(statistics.median);
+}
+
+static void setModeAndEntropy(AbstractColumn::ColumnStatistics& statistics, const QHash<double, qint64>& frequencies, qint64 n) {
+	qint64 maxFreq = 0;
 	int maxFreqOccurance = 0;
-	for (const auto& it : frequencyOfValues) {
-		if (it.second == maxFreq)
+	double mode = NAN;
+	double entropy = 0.0;
+	for (auto it = frequencies.constBegin(); it != frequencies.constEnd(); ++it) {
+		const qint64 freq = it.value();
+		if (freq > maxFreq) {
+			maxFreq = freq;
+			maxFreqOccurance = 1;
+			mode = it.key();
+		} else if (freq == maxFreq)
 			++maxFreqOccurance;
 
-		if (maxFreqOccurance > 1) {
-			mode = NAN;
-			break;
-		}
+		const double frequencyNorm = static_cast<double>(freq) / n;
+		entropy += (frequencyNorm * log2(frequencyNorm));
 	}
-	statistics.mode = mode;
-
-	//sort the data to calculate the percentiles
-	std::sort(rowData.begin(), rowData.end());
-	statistics.firstQuartile = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.25);
-	statistics.median = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.50);
-	statistics.thirdQuartile = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.75);
-	statistics.percentile_1 = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.01);
-	statistics.percentile_5 = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.05);
-	statistics.percentile_10 = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.1);
-	statistics.percentile_90 = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.9);
-	statistics.percentile_95 = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.95);
-	statistics.percentile_99 = gsl_stats_quantile_from_sorted_data(rowData.data(), 1, notNanCount, 0.99);
-	statistics.iqr = statistics.thirdQuartile - statistics.firstQuartile;
-	statistics.trimean = (statistics.firstQuartile + 2*statistics.median + statistics.thirdQuartile) / 4;
 
-	//######  dispersion and shape measures  #######
-	statistics.variance = 0;
-	statistics.meanDeviation = 0.0;
-	statistics.meanDeviationAroundMedian = 0.0;
-	double centralMoment_r3 = 0.0;
-	double centralMoment_r4 = 0.0;
-	QVector<double> absoluteMedianList;
-	absoluteMedianList.reserve(notNanCount);
-	absoluteMedianList.resize(notNanCount);
-
-	for (int row = 0; row < notNanCount; ++row) {
-		val = rowData.value(row);
-		statistics.variance += gsl_pow_2(val - statistics.arithmeticMean);
-		statistics.meanDeviation += fabs(val - statistics.arithmeticMean);
-
-		absoluteMedianList[row] = fabs(val - statistics.median);
-		statistics.meanDeviationAroundMedian += absoluteMedianList[row];
-
-		centralMoment_r3 += gsl_pow_3(val - statistics.arithmeticMean);
-		centralMoment_r4 += gsl_pow_4(val - statistics.arithmeticMean);
+	//if the max frequency occurs more than once, we have a multi-modal distribution and don't show any mode
+	statistics.mode = (maxFreqOccurance == 1) ? mode : NAN;
+	statistics.entropy = -entropy;
+}
+
+static void setMoments(AbstractColumn::ColumnStatistics& statistics, const StatisticsAccumulator& accumulator) {
+	statistics.size = (int)accumulator.count();
+	statistics.minimum = accumulator.minimum();
+	statistics.maximum = accumulator.maximum();
+	statistics.arithmeticMean = accumulator.mean();
+	statistics.geometricMean = accumulator.geometricMean();
+	statistics.harmonicMean = accumulator.harmonicMean();
+	statistics.contraharmonicMean = accumulator.contraharmonicMean();
+	statistics.variance = accumulator.variance();
+	statistics.standardDeviation = sqrt(statistics.variance);
+	statistics.skewness = accumulator.centralMoment(3) / gsl_pow_3(statistics.standardDeviation);
+	statistics.kurtosis = (accumulator.centralMoment(4) / gsl_pow_4(statistics.standardDeviation)) - 3.0;
+}
+
+/*!
+ * returns the statistics of the column.
+ * The moments and the means are accumulated in a single pass over the data, the quantiles and the deviations
+ * are estimated from a quantile sketch (exact for small columns). The statistics of rows appended to the column
+ * (see \c setChanged(int)) are updated incrementally.
+ * For \c exact = true, the quantiles and deviations are exact and the mode and the entropy are calculated too.
+ */
+const Column::ColumnStatistics& Column::statistics(bool exact) const {
+	if (!d->available.statistics || (exact && !d->available.exactStatistics))
+		calculateStatistics(exact);
+
+	return d->statistics;
+}
+
+void Column::calculateStatistics(bool exact) const {
+	if ( (columnMode() != ColumnMode::Double) && (columnMode() != ColumnMode::Integer)
+			&& (columnMode() != ColumnMode::BigInt) )
+		return;
+
+	// only rows were appended since the last calculation
+	if (!exact && d->available.statisticsRows > 0 && d->available.statisticsRows <= rowCount()) {
+		updateStatistics();
+		return;
 	}
 
-	//normalize
-	statistics.variance = (notNanCount != 1) ? statistics.variance / (notNanCount - 1) : NAN;
-	statistics.meanDeviationAroundMedian = statistics.meanDeviationAroundMedian / notNanCount;
-	statistics.meanDeviation = statistics.meanDeviation / notNanCount;
+	PERFTRACE("calculate column statistics");
 
-	//standard variation
-	statistics.standardDeviation = sqrt(statistics.variance);
+	d->statistics = ColumnStatistics();
+	ColumnStatistics& statistics = d->statistics;
 
-	//"median absolute deviation" - the median of the absolute deviations from the data's median.
-	std::sort(absoluteMedianList.begin(), absoluteMedianList.end());
-	statistics.medianDeviation = gsl_stats_quantile_from_sorted_data(absoluteMedianList.data(), 1, notNanCount, 0.50);
+	//######  moments and means  #######
+	auto& accumulator = d->statisticsAccumulator;
+	accumulator.clear();
+	accumulateValidValues(this, 0, accumulator);
+	d->available.statisticsRows = rowCount();
+
+	d->available.statistics = true;
+	d->available.exactStatistics = exact;
+	d->available.min = true;
+	d->available.max = true;
 
-	//skewness and kurtosis
-	centralMoment_r3 = centralMoment_r3 / notNanCount;
-	centralMoment_r4 = centralMoment_r4 / notNanCount;
-	statistics.skewness = centralMoment_r3 / gsl_pow_3(statistics.standardDeviation);
-	statistics.kurtosis = (centralMoment_r4 / gsl_pow_4(statistics.standardDeviation)) - 3.0;
+	setMoments(statistics, accumulator);
+	if (accumulator.count() == 0)
+		return;
 
-	//entropy
-	double entropy = 0.0;
-	for (const auto& v : frequencyOfValues) {
-		const double frequencyNorm = static_cast<double>(v.second) / notNanCount;
-		entropy += (frequencyNorm * log2(frequencyNorm));
+	if (!exact) {
+		setEstimatedQuantiles(statistics, accumulator);
+		return;
 	}
 
-	statistics.entropy = -entropy;
+	// the exact statistics are determined in a copy of the valid values
+	QVector<double> values = validValues(this);
+	const int n = values.size();
+
+	//######  mode and entropy  #######
+	QHash<double, qint64> frequencies;
+	for (double value : values)
+		++frequencies[value];
+	setModeAndEntropy(statistics, frequencies, n);
+
+	//######  quantiles  #######
+	std::array<double, 9> quantiles;
+	selectQuantiles(values.data(), n, quantileProbabilities.data(), quantiles.data(), (int)quantiles.size());
+	setQuantiles(statistics, quantiles);
+
+	//######  deviations  #######
+	double meanDeviation = 0.0;
+	double meanDeviationAroundMedian = 0.0;
+	for (auto& val : values) {
+		meanDeviation += fabs(val - statistics.arithmeticMean);
+		val = fabs(val - statistics.median);
+		meanDeviationAroundMedian += val;
+	}
+	statistics.meanDeviation = meanDeviation / n;
+	statistics.meanDeviationAroundMedian = meanDeviationAroundMedian / n;
+
+	//"median absolute deviation" - the median of the absolute deviations from the data's median.
+	const double p = 0.5;
+	selectQuantiles(values.data(), n, &p, &statistics.medianDeviation, 1);
+}
+
+/*!
+ * adds the values of the rows appended since the last calculation to the accumulated statistics.
+ * The quantiles and the deviations are estimated from the sketch of the accumulator.
+ */
+void Column::updateStatistics() const {
+	PERFTRACE("update column statistics");
+
+	auto& accumulator = d->statisticsAccumulator;
+	accumulateValidValues(this, d->available.statisticsRows, accumulator);
+	d->available.statisticsRows = rowCount();
+
+	d->statistics = ColumnStatistics();
+	ColumnStatistics& statistics = d->statistics;
+	setMoments(statistics, accumulator);
+	if (accumulator.count() > 0)
+		setEstimatedQuantiles(statistics, accumulator);
 
 	d->available.statistics = true;
+	d->available.exactStatistics = false;
 	d->available.min = true;
 	d->available.max = true;
 }
@@ -976,6 +1128,25 @@ void* Column::data() const {
 	return d->data();
 }
 
+/*!
+ * returns the data pointer for reading only, a column lazily loaded from a project file stays attached to the file.
+ * The column has to be pinned with a \c DataPin as long as the pointer is used.
+ */
+const void* Column::constData() const {
+	return d->constData();
+}
+
+/*!
+ * pins \c column: its data is loaded and not unloaded again because of the memory budget until the pin is destroyed.
+ */
+Column::DataPin::DataPin(const Column* column) : m_column(column->d) {
+	m_column->pinData();
+}
+
+Column::DataPin::~DataPin() {
+	m_column->unpinData();
+}
+
 /*!
  * return \c true if the column has numeric values, \c false otherwise.
  */
@@ -1099,6 +1270,26 @@ double Column::valueAt(int row) const {
 	return d->valueAt(row);
 }
 
+/**
+ * \brief Read the numerical values of the rows \c first .. \c first + \c count - 1 into \c values
+ *
+ * Reads directly from the data container of the column,
+ * masked rows are marked as invalid run-wise.
+ * \sa AbstractColumn::valuesAt()
+ */
+void Column::valuesAt(int first, int count, double* values, bool* valid) const {
+	d->valuesAt(first, count, values, valid);
+
+	if (valid) {
+		const int end = first + count;
+		for (int row = nextMaskedRow(first); row < end; row = nextMaskedRow(row)) {
+			const int unmasked = qMin(nextUnmaskedRow(row), end);
+			std::fill(valid + (row - first), valid + (unmasked - first), false);
+			row = unmasked;
+		}
+	}
+}
+
 /**
  * \brief Return the int value in row 'row'
  */
@@ -1119,10 +1310,25 @@ qint64 Column::bigIntAt(int row) const {
  * This is used e.g. in \c XYFitCurvePrivate::recalculate()
  */
 void Column::setChanged() {
+	// invalidate first, the receivers of dataChanged() already need the new properties and extrema
+	invalidateProperties();
+
 	if (!m_suppressDataChangedSignal)
 		Q_EMIT dataChanged(this);
+}
 
-	invalidateProperties();
+/*!
+ * same as \c setChanged() if only the rows starting at \c firstChangedRow were changed,
+ * e.g. after appending new rows. The statistics and the min/max index of the unchanged rows are kept and only updated with the changed rows.
+ */
+void Column::setChanged(int firstChangedRow) {
+	const int statisticsRows = d->available.statisticsRows;
+	d->invalidate(firstChangedRow, rowCount() - 1);
+	if (firstChangedRow >= statisticsRows)
+		d->available.statisticsRows = statisticsRows;
+
+	if (!m_suppressDataChangedSignal)
+		Q_EMIT dataChanged(this);
 }
 
 bool Column::hasValueLabels() const {
@@ -1323,27 +1529,39 @@ void Column::save(QXmlStreamWriter* writer) const {
 	}
 
 	//data
+	auto* binaryWriter = project() ? project()->binaryWriter() : nullptr;
+	if (binaryWriter) {
+		XmlWriteBlob(writer, binaryWriter);
+		writer->writeEndElement(); // "column"
+		return;
+	}
+
+	const DataPin pin(this);
 	int i;
 	switch (columnMode()) {
 	case ColumnMode::Double: {
-			const char* data = reinterpret_cast<const char*>(static_cast< QVector<double>* >(d->data())->constData());
+			const char* data = reinterpret_cast<const char*>(static_cast<const QVector<double>*>(d->constData())->constData());
 			size_t size = d->rowCount() * sizeof(double);
 			writer->writeCharacters(QByteArray::fromRawData(data, (int)size).toBase64());
 			break;
 		}
 	case ColumnMode::Integer: {
-			const char* data = reinterpret_cast<const char*>(static_cast< QVector<int>* >(d->data())->constData());
+			const char* data = reinterpret_cast<const char*>(static_cast<const QVector<int>*>(d->constData())->constData());
 			size_t size = d->rowCount() * sizeof(int);
 			writer->writeCharacters(QByteArray::fromRawData(data, (int)size).toBase64());
 			break;
 		}
 	case ColumnMode::BigInt: {
-			const char* data = reinterpret_cast<const char*>(static_cast< QVector<qint64>* >(d->data())->constData());
+			const char* data = reinterpret_cast<const char*>(static_cast<const QVector<qint64>*>(d->constData())->constData());
 			size_t size = d->rowCount() * sizeof(qint64);
 			writer->writeCharacters(QByteArray::fromRawData(data, (int)size).toBase64());
 			break;
 		}
 	case ColumnMode::Text:
+		if (isDictionaryEncoded()) {
+			XmlWriteDictionary(writer);
+			break;
+		}
 		for (i = 0; i < rowCount(); ++i) {
 			writer->writeStartElement("row");
 			writer->writeAttribute("index", QString::number(i));
@@ -1405,11 +1623,13 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 	KLocalizedString attributeWarning = ki18n("Attribute '%1' missing or empty, default value is used");
 	QXmlStreamAttributes attribs = reader->attributes();
 
+	// the rows of columns in binary project files are allocated when the data blob is read
 	QString str = attribs.value("rows").toString();
+	const int rows = str.toInt();
 	if (str.isEmpty())
 		reader->raiseWarning(attributeWarning.subs("rows").toString());
-	else
-		d->resizeTo(str.toInt());
+	else if (!reader->binaryReader())
+		d->resizeTo(rows);
 
 	str = attribs.value("designation").toString();
 	if (str.isEmpty())
@@ -1431,7 +1651,7 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 
 	QVector<QDateTime> dateTimeVector;
 	QVector<QString> textVector;
-
+	bool blob = false;
 
 	// read child elements
 	while (!reader->atEnd()) {
@@ -1511,6 +1731,12 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 					addValueLabel(QDateTime::fromMSecsSinceEpoch(attribs.value("value").toLongLong()), label);
 					break;
 				}
+			} else if (reader->name() == "blob") {
+				ret_val = XmlReadBlob(reader, preview, rows);
+				blob = true;
+			} else if (reader->name() == "dictionary") {
+				ret_val = XmlReadDictionary(reader, preview);
+				blob = true;
 			} else if (reader->name() == "row") {
 				// Assumption: the next elements are all rows
 				switch(columnMode()) {
@@ -1549,6 +1775,9 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 		}
 	}
 
+	if (blob)
+		return !reader->error();
+
 	switch(columnMode()) {
 	case AbstractColumn::ColumnMode::Double:
 	case AbstractColumn::ColumnMode::BigInt:
@@ -1572,6 +1801,38 @@ void Column::finalizeLoad() {
 	d->finalizeLoad();
 }
 
+/*!
+ * returns \c false if the column was loaded lazily from a binary project file
+ * and its data was not accessed yet (or was unloaded again), \c true otherwise.
+ */
+bool Column::isDataLoaded() const {
+	return d->isDataLoaded();
+}
+
+/*!
+ * lets the column refer to its unchanged data in the blob \c blob of the binary project file read by \c reader,
+ * called after the project was saved to this file.
+ */
+void Column::attachToFile(const std::shared_ptr<BinaryProjectReader>& reader, int blob) {
+	d->attachToFile(reader, blob);
+}
+
+/*!
+ * reads the data of a lazily loaded column and releases the binary project file it was loaded from.
+ */
+void Column::detachFromFile() {
+	d->detachFromFile();
+}
+
+/*!
+ * sets the approximate amount of memory in bytes that the data of the columns loaded from binary project files
+ * may use, the data of the columns loaded first is unloaded again when the budget is exceeded and read
+ * from the file again on the next access. 0 means no limit.
+ */
+void Column::setLoadedDataBudget(qint64 bytes) {
+	ColumnPrivate::setLoadedDataBudget(bytes);
+}
+
 /**
  * \brief Read XML input filter element
  */
@@ -1656,6 +1917,100 @@ bool Column::XmlReadFormula(XmlStreamReader* reader) {
 // }
 
 
+/**
+ * \brief Write the data of the column as blob of the binary project file, the XML only references the blob
+ */
+void Column::XmlWriteBlob(QXmlStreamWriter* writer, BinaryProjectWriter* binaryWriter) const {
+	const int index = d->writeBlob(binaryWriter);
+	binaryWriter->addReference(this, index);
+
+	writer->writeStartElement("blob");
+	writer->writeAttribute("index", QString::number(index));
+	writer->writeEndElement();
+}
+
+/**
+ * \brief Read the data of the column from the blob of the binary project file referenced in the XML blob element
+ *
+ * With lazy loading the data is read on the first access.
+ */
+bool Column::XmlReadBlob(XmlStreamReader* reader, bool preview, int rows) {
+	Q_ASSERT(reader->isStartElement() == true && reader->name() == "blob");
+
+	bool ok;
+	const int index = reader->readAttributeInt("index", &ok);
+	const auto& binaryReader = reader->binaryReader();
+	if (!ok || !binaryReader || binaryReader->blobSize(index) < 0) {
+		reader->raiseError(i18n("invalid or missing data blob"));
+		return false;
+	}
+	if (preview)
+		return true;
+
+	if (!d->readBlob(binaryReader, index, rows)) {
+		reader->raiseError(binaryReader->errorString().isEmpty() ? i18n("invalid data blob") : binaryReader->errorString());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Write the dictionary encoded texts: the distinct values once and the base64 encoded dictionary index of every row
+ */
+void Column::XmlWriteDictionary(QXmlStreamWriter* writer) const {
+	const DataPin pin(this);
+	writer->writeStartElement("dictionary");
+	for (const auto& value : dictionary())
+		writer->writeTextElement("value", value);
+
+	const auto& codes = dictionaryCodes();
+	writer->writeStartElement("codes");
+	const char* data = reinterpret_cast<const char*>(codes.constData());
+	writer->writeCharacters(QByteArray::fromRawData(data, codes.size() * (int)sizeof(int)).toBase64());
+	writer->writeEndElement(); // "codes"
+	writer->writeEndElement(); // "dictionary"
+}
+
+/**
+ * \brief Read the dictionary encoded texts written with XmlWriteDictionary()
+ */
+bool Column::XmlReadDictionary(XmlStreamReader* reader, bool preview) {
+	Q_ASSERT(reader->isStartElement() == true && reader->name() == "dictionary");
+
+	QVector<QString> values;
+	QVector<int> codes;
+	while (!reader->atEnd()) {
+		reader->readNext();
+		if (reader->isEndElement() && reader->name() == "dictionary")
+			break;
+		if (!reader->isStartElement())
+			continue;
+
+		if (reader->name() == "value")
+			values << reader->readElementText();
+		else if (reader->name() == "codes") {
+			const QByteArray data = QByteArray::fromBase64(reader->readElementText().toLatin1());
+			codes.resize(data.size() / (int)sizeof(int));
+			memcpy(codes.data(), data.constData(), codes.size() * sizeof(int));
+		} else {
+			reader->raiseWarning(i18n("unknown element '%1'", reader->name().toString()));
+			if (!reader->skipToEndElement()) return false;
+		}
+	}
+
+	for (const int code : codes) {
+		if (code < -1 || code >= values.size()) {
+			reader->raiseError(i18n("invalid dictionary index"));
+			return false;
+		}
+	}
+
+	if (!preview)
+		d->setDictionary(values, codes);
+	return true;
+}
+
 /**
  * \brief Read XML row element
  */
@@ -1746,6 +2101,17 @@ QString Column::columnModeString() const {
 void Column::resizeTo(int rows) {
 	d->resizeTo(rows);
 }
+
+/**
+ * \brief Drop the values of the first \c count rows and move the remaining values to the front
+ *
+ * The last \c count rows are reset and the number of rows is not changed.
+ * Used to keep the last N values of live data, the change is not undoable.
+ * All rows are moved, the costs are linear in the number of rows and should be paid once per read of new data.
+ */
+void Column::shiftRows(int count) {
+	d->shiftRows(count);
+}
 /**
  * \brief Return the data vector size
  */
@@ -1890,62 +2256,16 @@ double Column::minimum(int startIndex, int endIndex) const {
 		// skipping values is only in Properties::No needed, because
 		// when there are invalid values the property must be Properties::No
 		switch (mode) {
-		case ColumnMode::Double: {
-			auto* vec = static_cast<QVector<double>*>(data());
-			for (int row = startIndex; row < endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-
-				const double val = vec->at(row);
-				if (std::isnan(val))
-					continue;
-
-				if (val < min)
-					min = val;
-			}
-			break;
-		}
-		case ColumnMode::Integer: {
-			auto* vec = static_cast<QVector<int>*>(data());
-			for (int row = startIndex; row < endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-
-				const int val = vec->at(row);
-
-				if (val < min)
-					min = val;
-			}
-			break;
-		}
-		case ColumnMode::BigInt: {
-			auto* vec = static_cast<QVector<qint64>*>(data());
-			for (int row = startIndex; row < endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-
-				const qint64 val = vec->at(row);
-
-				if (val < min)
-					min = val;
-			}
-			break;
-		}
-		case ColumnMode::Text:
-			break;
+		case ColumnMode::Double:
+		case ColumnMode::Integer:
+		case ColumnMode::BigInt:
 		case ColumnMode::DateTime: {
-			auto* vec = static_cast<QVector<QDateTime>*>(data());
-			for (int row = startIndex; row < endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-
-				const qint64 val = vec->at(row).toMSecsSinceEpoch();
-
-				if (val < min)
-					min = val;
-			}
+			// the extrema of complete blocks of rows are taken from the min/max index
+			double max = -qInf();
+			d->minMax(startIndex, endIndex, min, max);
 			break;
 		}
+		case ColumnMode::Text:
 		case ColumnMode::Day:
 		case ColumnMode::Month:
 			break;
@@ -2042,58 +2362,16 @@ double Column::maximum(int startIndex, int endIndex) const {
 	Properties property = properties();
 	if (property == Properties::No || property == Properties::NonMonotonic) {
 		switch (mode) {
-		case ColumnMode::Double: {
-			auto* vec = static_cast<QVector<double>*>(data());
-			for (int row = startIndex; row < endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-				const double val = vec->at(row);
-				if (std::isnan(val))
-					continue;
-
-				if (val > max)
-					max = val;
-			}
-			break;
-		}
-		case ColumnMode::Integer: {
-			auto* vec = static_cast<QVector<int>*>(data());
-			for (int row = startIndex; row < endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-				const int val = vec->at(row);
-
-				if (val > max)
-					max = val;
-			}
-			break;
-		}
-		case ColumnMode::BigInt: {
-			auto* vec = static_cast<QVector<qint64>*>(data());
-			for (int row = startIndex; row < endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-				const qint64 val = vec->at(row);
-
-				if (val > max)
-					max = val;
-			}
-			break;
-		}
-		case ColumnMode::Text:
-			break;
+		case ColumnMode::Double:
+		case ColumnMode::Integer:
+		case ColumnMode::BigInt:
 		case ColumnMode::DateTime: {
-			auto* vec = static_cast<QVector<QDateTime>*>(data());
-			for (int row = startIndex; row < endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
-					continue;
-				const qint64 val = vec->at(row).toMSecsSinceEpoch();
-
-				if (val > max)
-					max = val;
-			}
+			// the extrema of complete blocks of rows are taken from the min/max index
+			double min = qInf();
+			d->minMax(startIndex, endIndex, min, max);
 			break;
 		}
+		case ColumnMode::Text:
 		case ColumnMode::Day:
 		case ColumnMode::Month:
 			break;
@@ -15,7 +15,12 @@
 
 #include "backend/core/AbstractColumn.h"
 
+#include <limits>
+#include <memory>
+
 class AbstractSimpleFilter;
+class BinaryProjectReader;
+class BinaryProjectWriter;
 class CartesianPlot;
 class ColumnStringIO;
 class QAction;
@@ -66,6 +71,7 @@ public:
 
 	bool isReadOnly() const override;
 	void resizeTo(int);
+	void shiftRows(int count);
 	int rowCount() const override;
 	int availableRowCount(int max = -1) const override;
 	int width() const;
@@ -119,8 +125,21 @@ public:
 	void setFormula(int, const QString&) override;
 	void clearFormulas() override;
 
-	const AbstractColumn::ColumnStatistics& statistics() const;
+	const AbstractColumn::ColumnStatistics& statistics(bool exact = false) const;
 	void* data() const;
+	const void* constData() const;
+	// keeps the data of a column lazily loaded from a project file in memory while it's accessed
+	// via constData(), dictionary() or dictionaryCodes() or from a thread other than the main thread
+	class DataPin {
+	public:
+		explicit DataPin(const Column*);
+		~DataPin();
+		DataPin(const DataPin&) = delete;
+		DataPin& operator=(const DataPin&) = delete;
+
+	private:
+		const ColumnPrivate* m_column;
+	};
 	bool hasValues() const;
 	bool hasValueLabels() const;
 	void removeValueLabel(const QString&);
@@ -136,6 +155,12 @@ public:
 	void replaceTexts(int, const QVector<QString>&) override;
 	void addValueLabel(const QString&, const QString&);
 	const QMap<QString, QString>& textValueLabels();
+	// Text columns with few distinct values can store the index of every row in a dictionary of the distinct values
+	bool isDictionaryEncoded() const;
+	bool encodeDictionary(bool lowCardinalityOnly = false);
+	void decodeDictionary();
+	const QVector<QString>& dictionary() const;
+	const QVector<int>& dictionaryCodes() const;
 
 	QDate dateAt(int) const override;
 	void setDateAt(int, QDate) override;
@@ -147,8 +172,13 @@ public:
 	void replaceDateTimes(int, const QVector<QDateTime>&) override;
 	void addValueLabel(const QDateTime&, const QString&);
 	const QMap<QDateTime, QString>& dateTimeValueLabels();
+	// DateTime, Month and Day columns store the milliseconds since epoch, data() is a QVector<qint64>
+	static qint64 invalidDateTime() { return std::numeric_limits<qint64>::min(); }
+	static qint64 dateTimeToMSecs(const QDateTime&);
+	void setTimeSpec(Qt::TimeSpec);
 
 	double valueAt(int) const override;
+	void valuesAt(int first, int count, double* values, bool* valid = nullptr) const override;
 	void setValues(const QVector<double>&);
 	void setValueAt(int, double) override;
 	void replaceValues(int, const QVector<double>&) override;
@@ -181,6 +211,7 @@ public:
 	bool indicesMinMax(double v1, double v2, int& start, int& end) const override;
 
 	void setChanged();
+	void setChanged(int firstChangedRow);
 	void setSuppressDataChangedSignal(const bool);
 
 	void addUsedInPlots(QVector<CartesianPlot*>&);
@@ -188,6 +219,10 @@ public:
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*, bool preview) override;
 	void finalizeLoad();
+	bool isDataLoaded() const;
+	void attachToFile(const std::shared_ptr<BinaryProjectReader>&, int blob);
+	void detachFromFile();
+	static void setLoadedDataBudget(qint64 bytes);
 
 public Q_SLOTS:
 	void pasteData();
@@ -198,11 +233,16 @@ private:
 	bool XmlReadOutputFilter(XmlStreamReader*);
 	bool XmlReadFormula(XmlStreamReader*);
 	bool XmlReadRow(XmlStreamReader*);
+	bool XmlReadBlob(XmlStreamReader*, bool preview, int rows);
+	void XmlWriteBlob(QXmlStreamWriter*, BinaryProjectWriter*) const;
+	bool XmlReadDictionary(XmlStreamReader*, bool preview);
+	void XmlWriteDictionary(QXmlStreamWriter*) const;
 
 	void handleRowInsertion(int before, int count) override;
 	void handleRowRemoval(int first, int count) override;
 
-	void calculateStatistics() const;
+	void calculateStatistics(bool exact) const;
+	void updateStatistics() const;
 
 	bool m_suppressDataChangedSignal{false};
 	QAction* m_copyDataAction{nullptr};
@@ -14,10 +14,31 @@
 #include "ColumnStringIO.h"
 #include "Column.h"
 #include "backend/lib/trace.h"
+#include "backend/core/BinaryProjectFile.h"
 #include "backend/core/datatypes/filter.h"
 #include "backend/gsl/ExpressionParser.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <QCoreApplication>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace {
+// guards the loading and unloading of the data of lazily loaded columns and the decoding of dictionary encoded texts
+QMutex lazyDataMutex;
+// columns with data loaded from a project file that can be unloaded again, in the order of loading
+QList<ColumnPrivate*> loadedColumns;
+qint64 loadedDataSize{0};
+qint64 loadedDataBudget{0};	// 0: unlimited
+bool unloadScheduled{false};
+}
+
 ColumnPrivate::ColumnPrivate(Column* owner, AbstractColumn::ColumnMode mode) :
 	m_columnMode(mode), m_owner(owner) {
 	Q_ASSERT(owner != nullptr);
@@ -37,13 +58,13 @@ ColumnPrivate::ColumnPrivate(Column* owner, AbstractColumn::ColumnMode mode) :
 		m_data = new QVector<QString>();
 		break;
 	case AbstractColumn::ColumnMode::DateTime:
-		m_data = new QVector<QDateTime>();
+		m_data = new QVector<qint64>();
 		break;
 	case AbstractColumn::ColumnMode::Month:
-		m_data = new QVector<QDateTime>();
+		m_data = new QVector<qint64>();
 		break;
 	case AbstractColumn::ColumnMode::Day:
-		m_data = new QVector<QDateTime>();
+		m_data = new QVector<qint64>();
 		break;
 	}
 
@@ -107,6 +128,7 @@ void ColumnPrivate::init() {
 }
 
 ColumnPrivate::~ColumnPrivate() {
+	dropFile();
 	if (!m_data) return;
 
 	switch (m_columnMode) {
@@ -125,7 +147,7 @@ ColumnPrivate::~ColumnPrivate() {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		delete static_cast<QVector<QDateTime>*>(m_data);
+		delete static_cast<QVector<qint64>*>(m_data);
 		break;
 	}
 }
@@ -147,6 +169,9 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 //		<< " -> " << ENUM_TO_STRING(AbstractColumn, ColumnMode, mode))
 	if (mode == m_columnMode) return;
 
+	detachFromFile();
+	decodeDictionary();
+	minMaxIndex.clear();
 	void* old_data = m_data;
 	// remark: the deletion of the old data will be done in the dtor of a command
 
@@ -187,19 +212,19 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = new Double2DateTimeFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<double>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			filter = new Double2MonthFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<double>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Day:
 			filter = new Double2DayOfWeekFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<double>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
 
@@ -233,19 +258,19 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = new Integer2DateTimeFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<int>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			filter = new Integer2MonthFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<int>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Day:
 			filter = new Integer2DayOfWeekFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<int>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
 
@@ -279,19 +304,19 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = new BigInt2DateTimeFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<qint64>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			filter = new BigInt2MonthFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<qint64>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Day:
 			filter = new BigInt2DayOfWeekFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast< QVector<qint64>* >(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
 
@@ -326,19 +351,19 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = new String2DateTimeFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast<QVector<QString>*>(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			filter = new String2MonthFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast<QVector<QString>*>(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		case AbstractColumn::ColumnMode::Day:
 			filter = new String2DayOfWeekFilter();
 			filter_is_temporary = true;
 			temp_col = new Column("temp_col", *(static_cast<QVector<QString>*>(old_data)));
-			m_data = new QVector<QDateTime>();
+			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
 
@@ -357,7 +382,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 		case AbstractColumn::ColumnMode::Text:
 			filter = outputFilter();
 			filter_is_temporary = false;
-			temp_col = new Column("temp_col", *(static_cast< QVector<QDateTime>* >(old_data)), m_columnMode);
+			temp_col = dateTimeColumn(old_data);
 			m_data = new QStringList();
 			break;
 		case AbstractColumn::ColumnMode::Double:
@@ -368,7 +393,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			else
 				filter = new DateTime2DoubleFilter();
 			filter_is_temporary = true;
-			temp_col = new Column("temp_col", *(static_cast< QVector<QDateTime>* >(old_data)), m_columnMode);
+			temp_col = dateTimeColumn(old_data);
 			m_data = new QVector<double>();
 			break;
 		case AbstractColumn::ColumnMode::Integer:
@@ -379,7 +404,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			else
 				filter = new DateTime2IntegerFilter();
 			filter_is_temporary = true;
-			temp_col = new Column("temp_col", *(static_cast< QVector<QDateTime>* >(old_data)), m_columnMode);
+			temp_col = dateTimeColumn(old_data);
 			m_data = new QVector<int>();
 			break;
 		case AbstractColumn::ColumnMode::BigInt:
@@ -390,7 +415,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			else
 				filter = new DateTime2BigIntFilter();
 			filter_is_temporary = true;
-			temp_col = new Column("temp_col", *(static_cast< QVector<QDateTime>* >(old_data)), m_columnMode);
+			temp_col = dateTimeColumn(old_data);
 			m_data = new QVector<qint64>();
 			break;
 		} // switch(mode)
@@ -477,6 +502,15 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 	Q_EMIT m_owner->modeChanged(m_owner);
 }
 
+//! creates a temporary column of the current date and time mode with the values \c data, used for the conversion to other modes
+Column* ColumnPrivate::dateTimeColumn(void* data) const {
+	auto* column = new Column(QStringLiteral("temp_col"), m_columnMode);
+	*static_cast<QVector<qint64>*>(column->d->m_data) = *static_cast<QVector<qint64>*>(data);
+	column->d->m_timeSpec = m_timeSpec;
+	column->d->m_utcOffset = m_utcOffset;
+	return column;
+}
+
 /**
  * \brief Replace all mode related members
  *
@@ -509,8 +543,11 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void* data,
 		break;
 	}
 
+	dropFile();
+	clearDictionary();
 	m_columnMode = mode;
 	m_data = data;
+	minMaxIndex.clear();
 
 	//in_filter->setName("InputFilter");
 	//out_filter->setName("OutputFilter");
@@ -551,6 +588,8 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void* data,
  */
 void ColumnPrivate::replaceData(void* data) {
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
+	dropFile();
+	clearDictionary();
 	m_data = data;
 	invalidate();
 	if (!m_owner->m_suppressDataChangedSignal)
@@ -566,12 +605,15 @@ void ColumnPrivate::replaceData(void* data) {
  */
 bool ColumnPrivate::copy(const AbstractColumn* other) {
 	if (other->columnMode() != columnMode()) return false;
+	detachFromFile();
+	decodeDictionary();
 // 	DEBUG(Q_FUNC_INFO << ", mode = " << ENUM_TO_STRING(AbstractColumn, ColumnMode, columnMode()));
 	int num_rows = other->rowCount();
 // 	DEBUG(Q_FUNC_INFO << ", rows " << num_rows);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	resizeTo(num_rows);
+	minMaxIndex.clear();
 
 	// copy the data
 	switch (m_columnMode) {
@@ -602,9 +644,13 @@ bool ColumnPrivate::copy(const AbstractColumn* other) {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day: {
-		auto* vec = static_cast<QVector<QDateTime>*>(m_data);
-		for (int i = 0; i < num_rows; ++i)
-			vec->replace(i, other->dateTimeAt(i));
+		qint64* ptr = static_cast<QVector<qint64>*>(m_data)->data();
+		for (int i = 0; i < num_rows; ++i) {
+			const QDateTime& dateTime = other->dateTimeAt(i);
+			if (i == 0)
+				setTimeSpec(dateTime);
+			ptr[i] = Column::dateTimeToMSecs(dateTime);
+		}
 		break;
 	}
 	}
@@ -629,9 +675,12 @@ bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int des
 	if (source->columnMode() != m_columnMode) return false;
 	if (num_rows == 0) return true;
 
+	detachFromFile();
+	decodeDictionary();
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (dest_start + num_rows > rowCount())
 		resizeTo(dest_start + num_rows);
+	minMaxIndex.invalidate(dest_start, dest_start + num_rows - 1);
 
 	// copy the data
 	switch (m_columnMode) {
@@ -659,11 +708,17 @@ bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int des
 		break;
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::Day:
-		for (int i = 0; i < num_rows; i++)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(dest_start+i, source->dateTimeAt(source_start + i));
+	case AbstractColumn::ColumnMode::Day: {
+		qint64* ptr = static_cast<QVector<qint64>*>(m_data)->data();
+		for (int i = 0; i < num_rows; i++) {
+			const QDateTime& dateTime = source->dateTimeAt(source_start + i);
+			if (i == 0)
+				setTimeSpec(dateTime);
+			ptr[dest_start+i] = Column::dateTimeToMSecs(dateTime);
+		}
 		break;
 	}
+	}
 
 	if (!m_owner->m_suppressDataChangedSignal)
 		Q_EMIT m_owner->dataChanged(m_owner);
@@ -679,10 +734,13 @@ bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int des
  */
 bool ColumnPrivate::copy(const ColumnPrivate* other) {
 	if (other->columnMode() != m_columnMode) return false;
+	detachFromFile();
+	decodeDictionary();
 	int num_rows = other->rowCount();
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	resizeTo(num_rows);
+	minMaxIndex.clear();
 
 	// copy the data
 	switch (m_columnMode) {
@@ -711,8 +769,10 @@ bool ColumnPrivate::copy(const ColumnPrivate* other) {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		for (int i = 0; i < num_rows; ++i)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(i, other->dateTimeAt(i));
+		const DataPin pin(other);
+		std::copy_n(static_cast<QVector<qint64>*>(other->m_data)->constData(), num_rows, static_cast<QVector<qint64>*>(m_data)->data());
+		m_timeSpec = other->m_timeSpec;
+		m_utcOffset = other->m_utcOffset;
 		break;
 	}
 
@@ -736,9 +796,12 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
 	if (source->columnMode() != m_columnMode) return false;
 	if (num_rows == 0) return true;
 
+	detachFromFile();
+	decodeDictionary();
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (dest_start + num_rows > rowCount())
 		resizeTo(dest_start + num_rows);
+	minMaxIndex.invalidate(dest_start, dest_start + num_rows - 1);
 
 	// copy the data
 	switch (m_columnMode) {
@@ -767,8 +830,11 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		for (int i = 0; i  <num_rows; ++i)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(dest_start+i, source->dateTimeAt(source_start + i));
+		const DataPin pin(source);
+		std::copy_n(static_cast<QVector<qint64>*>(source->m_data)->constData() + source_start, num_rows,
+				static_cast<QVector<qint64>*>(m_data)->data() + dest_start);
+		m_timeSpec = source->m_timeSpec;
+		m_utcOffset = source->m_utcOffset;
 		break;
 	}
 
@@ -786,6 +852,9 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
  * This returns the size of the column container
  */
 int ColumnPrivate::rowCount() const {
+	if (m_lazy.load(std::memory_order_acquire))
+		return m_lazyRowCount;
+
 	switch (m_columnMode) {
 	case AbstractColumn::ColumnMode::Double:
 		return static_cast<QVector<double>*>(m_data)->size();
@@ -796,8 +865,10 @@ int ColumnPrivate::rowCount() const {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		return static_cast<QVector<QDateTime>*>(m_data)->size();
+		return static_cast<QVector<qint64>*>(m_data)->size();
 	case AbstractColumn::ColumnMode::Text:
+		if (m_dictionaryEncoded)
+			return m_codes.size();
 		return static_cast<QVector<QString>*>(m_data)->size();
 	}
 
@@ -840,8 +911,11 @@ void ColumnPrivate::resizeTo(int new_size) {
 	if (new_size == old_size)
 		return;
 
+	detachFromFile();
+
 // 	DEBUG("ColumnPrivate::resizeTo() " << old_size << " -> " << new_size);
 	const int new_rows = new_size - old_size;
+	minMaxIndex.invalidate(qMin(old_size, new_size), qMax(old_size, new_size) - 1);
 
 	switch (m_columnMode) {
 	case AbstractColumn::ColumnMode::Double: {
@@ -869,6 +943,12 @@ void ColumnPrivate::resizeTo(int new_size) {
 		break;
 	}
 	case AbstractColumn::ColumnMode::Text: {
+		if (m_dictionaryEncoded) {
+			m_codes.resize(new_size);
+			if (new_rows > 0)
+				std::fill(m_codes.begin() + old_size, m_codes.end(), -1);
+			break;
+		}
 		auto* data = static_cast<QVector<QString>*>(m_data);
 		if (new_rows > 0)
 			data->insert(data->end(), new_rows, QString());
@@ -879,9 +959,9 @@ void ColumnPrivate::resizeTo(int new_size) {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day: {
-		auto* data = static_cast<QVector<QDateTime>*>(m_data);
+		auto* data = static_cast<QVector<qint64>*>(m_data);
 		if (new_rows > 0)
-			data->insert(data->end(), new_rows, QDateTime());
+			data->insert(data->end(), new_rows, Column::invalidDateTime());
 		else
 			data->remove(old_size - 1 + new_rows, -new_rows);
 		break;
@@ -898,6 +978,8 @@ void ColumnPrivate::insertRows(int before, int count) {
 	m_formulas.insertRows(before, count);
 
 	if (before <= rowCount()) {
+		detachFromFile();
+		minMaxIndex.invalidate(before, rowCount() + count - 1);
 		switch (m_columnMode) {
 		case AbstractColumn::ColumnMode::Double:
 			static_cast<QVector<double>*>(m_data)->insert(before, count, NAN);
@@ -911,10 +993,13 @@ void ColumnPrivate::insertRows(int before, int count) {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			for (int i = 0; i < count; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->insert(before, QDateTime());
+			static_cast<QVector<qint64>*>(m_data)->insert(before, count, Column::invalidDateTime());
 			break;
 		case AbstractColumn::ColumnMode::Text:
+			if (m_dictionaryEncoded) {
+				m_codes.insert(before, count, -1);
+				break;
+			}
 			for (int i = 0; i < count; ++i)
 				static_cast<QVector<QString>*>(m_data)->insert(before, QString());
 			break;
@@ -931,9 +1016,11 @@ void ColumnPrivate::removeRows(int first, int count) {
 	m_formulas.removeRows(first, count);
 
 	if (first < rowCount()) {
+		detachFromFile();
 		int corrected_count = count;
 		if (first + count > rowCount())
 			corrected_count = rowCount() - first;
+		minMaxIndex.invalidate(first, rowCount() - 1);
 
 		switch (m_columnMode) {
 		case AbstractColumn::ColumnMode::Double:
@@ -948,10 +1035,13 @@ void ColumnPrivate::removeRows(int first, int count) {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			for (int i = 0; i < corrected_count; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->removeAt(first);
+			static_cast<QVector<qint64>*>(m_data)->remove(first, corrected_count);
 			break;
 		case AbstractColumn::ColumnMode::Text:
+			if (m_dictionaryEncoded) {
+				m_codes.remove(first, corrected_count);
+				break;
+			}
 			for (int i = 0; i < corrected_count; ++i)
 				static_cast<QVector<QString>*>(m_data)->removeAt(first);
 			break;
@@ -959,6 +1049,46 @@ void ColumnPrivate::removeRows(int first, int count) {
 	}
 }
 
+template<typename T>
+static void shiftVector(QVector<T>* vector, int count, const T& empty = T()) {
+	count = qMin(count, vector->size());
+	std::move(vector->begin() + count, vector->end(), vector->begin());
+	std::fill(vector->end() - count, vector->end(), empty);
+}
+
+/**
+ * \brief Drop the first 'count' rows and reset the last 'count' rows, the row count is not changed
+ *
+ * All values are moved only once, independent of 'count'.
+ */
+void ColumnPrivate::shiftRows(int count) {
+	if (count <= 0) return;
+
+	detachFromFile();
+	decodeDictionary();
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		shiftVector(static_cast<QVector<double>*>(m_data), count);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		shiftVector(static_cast<QVector<int>*>(m_data), count);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		shiftVector(static_cast<QVector<qint64>*>(m_data), count);
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		shiftVector(static_cast<QVector<qint64>*>(m_data), count, Column::invalidDateTime());
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		shiftVector(static_cast<QVector<QString>*>(m_data), count);
+		break;
+	}
+
+	invalidate();
+}
+
 //! Return the column name
 QString ColumnPrivate::name() const {
 	return m_owner->name();
@@ -996,8 +1126,26 @@ void ColumnPrivate::setWidth(int value) {
 
 /**
  * \brief Return the data pointer
+ *
+ * The data can be modified via the pointer, the column is detached from the project file
+ * so that the modified data is neither unloaded nor replaced by the blob when the project is saved.
  */
 void* ColumnPrivate::data() const {
+	const_cast<ColumnPrivate*>(this)->detachFromFile();
+	decodeDictionary();
+	return m_data;
+}
+
+/**
+ * \brief Return the data pointer for reading only
+ *
+ * Lazily loaded data is read but the column stays attached to the project file.
+ * The column has to be pinned as long as the pointer is used, see \c DataPin.
+ */
+const void* ColumnPrivate::constData() const {
+	Q_ASSERT(m_pins.load() > 0);
+	loadData();
+	decodeDictionary();
 	return m_data;
 }
 
@@ -1169,6 +1317,474 @@ void ColumnPrivate::finalizeLoad() {
 	}
 }
 
+//##############################################################################
+//########################  dictionary encoded texts  ##########################
+//##############################################################################
+/*!
+ * returns the maximal number of distinct values for which texts in \c rows rows are dictionary encoded automatically
+ * (on import and when loading binary projects): every value is repeated ten times on average.
+ */
+int ColumnPrivate::maxDictionarySize(int rows) {
+	return qMin(rows / 10, 65536);
+}
+
+bool ColumnPrivate::isDictionaryEncoded() const {
+	loadData();
+	return m_dictionaryEncoded;
+}
+
+/*!
+ * stores the texts of the column as the index of every row in the sorted dictionary of the distinct values.
+ * Returns \c false if the column has more than \c maxSize distinct values (\c maxSize < 0: no limit).
+ * The texts are not changed, the encoding is not part of the undo history.
+ */
+bool ColumnPrivate::encodeDictionary(int maxSize) {
+	if (m_columnMode != AbstractColumn::ColumnMode::Text)
+		return false;
+	if (m_dictionaryEncoded)
+		return true;
+
+	PERFTRACE(m_owner->name() + QLatin1String(Q_FUNC_INFO));
+	loadData();
+	auto* texts = static_cast<QVector<QString>*>(m_data);
+	QHash<QString, int> indices;
+	QVector<QString> dictionary;
+	QVector<int> codes(texts->size());
+	for (int i = 0; i < texts->size(); ++i) {
+		const QString& text = texts->at(i);
+		if (text.isNull()) {	// null and empty strings are different, see AbstractColumn::isValid()
+			codes[i] = -1;
+			continue;
+		}
+		auto it = indices.constFind(text);
+		if (it == indices.constEnd()) {
+			if (maxSize >= 0 && dictionary.size() == maxSize)
+				return false;
+			it = indices.insert(text, dictionary.size());
+			dictionary << text;
+		}
+		codes[i] = it.value();
+	}
+
+	setDictionary(dictionary, codes);
+	return true;
+}
+
+/*!
+ * expands the dictionary encoded texts, called before the texts are accessed directly or modified.
+ * Rows with the same text share the data of the string.
+ * The texts can be decoded in any thread. The dictionary is freed in the thread of the column only
+ * if no reader pins the column, otherwise it's freed on the next modification.
+ */
+void ColumnPrivate::decodeDictionary() const {
+	if (!m_dictionaryEncoded.load(std::memory_order_acquire))
+		return;
+
+	QMutexLocker locker(&lazyDataMutex);
+	if (!m_dictionaryEncoded.load(std::memory_order_acquire))
+		return; // decoded by another thread in the meantime
+
+	PERFTRACE(m_owner->name() + QLatin1String(Q_FUNC_INFO));
+	auto* texts = static_cast<QVector<QString>*>(m_data);
+	const int rows = m_codes.size();
+	texts->resize(rows);
+	for (int i = 0; i < rows; ++i) {
+		const int code = m_codes.at(i);
+		(*texts)[i] = (code < 0) ? QString() : m_dictionary.at(code);
+	}
+	m_dictionaryEncoded.store(false, std::memory_order_release);
+
+	if (QThread::currentThread() == m_owner->thread() && m_pins.load() == 0) {
+		auto* self = const_cast<ColumnPrivate*>(this);
+		self->m_dictionary = QVector<QString>();
+		self->m_codes = QVector<int>();
+	}
+}
+
+void ColumnPrivate::clearDictionary() {
+	m_dictionaryEncoded = false;
+	m_dictionary = QVector<QString>();
+	m_codes = QVector<int>();
+}
+
+/*!
+ * sets the dictionary encoded texts without notifying about the change, the codes have to be valid indices in \c dictionary or -1.
+ * The dictionary is sorted so that the order of the codes is the order of the texts.
+ */
+void ColumnPrivate::setDictionary(const QVector<QString>& dictionary, QVector<int> codes) {
+	*static_cast<QVector<QString>*>(m_data) = QVector<QString>();
+
+	const int size = dictionary.size();
+	QVector<int> order(size);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&dictionary](int a, int b) { return dictionary.at(a) < dictionary.at(b); });
+
+	// equal values (only possible in a dictionary read from a file) get the same code
+	QVector<int> newCode(size);
+	m_dictionary.clear();
+	m_dictionary.reserve(size);
+	for (int i = 0; i < size; ++i) {
+		const QString& text = dictionary.at(order.at(i));
+		if (m_dictionary.isEmpty() || m_dictionary.constLast() != text)
+			m_dictionary << text;
+		newCode[order.at(i)] = m_dictionary.size() - 1;
+	}
+
+	for (auto& code : codes) {
+		if (code >= 0)
+			code = newCode.at(code);
+	}
+	m_codes = codes;
+	m_dictionaryEncoded = true;
+}
+
+/*!
+ * returns the sorted distinct values of the dictionary encoded texts.
+ */
+const QVector<QString>& ColumnPrivate::dictionary() const {
+	Q_ASSERT(m_pins.load() > 0);
+	loadData();
+	return m_dictionary;
+}
+
+/*!
+ * returns the index of the text of every row in \c dictionary() (-1 for null strings) of the dictionary encoded texts.
+ */
+const QVector<int>& ColumnPrivate::dictionaryCodes() const {
+	Q_ASSERT(m_pins.load() > 0);
+	loadData();
+	return m_codes;
+}
+
+/*!
+ * determines the \c code of \c text in the dictionary, returns \c false if \c text is not in the dictionary.
+ */
+bool ColumnPrivate::dictionaryCode(const QString& text, int& code) const {
+	if (text.isNull()) {
+		code = -1;
+		return true;
+	}
+
+	const auto it = std::lower_bound(m_dictionary.constBegin(), m_dictionary.constEnd(), text);
+	if (it == m_dictionary.constEnd() || *it != text)
+		return false;
+	code = it - m_dictionary.constBegin();
+	return true;
+}
+
+//##############################################################################
+//########################  binary project files  #############################
+//##############################################################################
+/*!
+ * writes the data of the column as blob with \c writer and returns the index of the blob.
+ * The numeric data is written as it is, date and time values as milliseconds since the epoch
+ * and texts with a dictionary of the distinct values.
+ * The unchanged data of columns loaded from a binary project file is copied from the file without reading it.
+ */
+int ColumnPrivate::writeBlob(BinaryProjectWriter* writer) const {
+	if (m_blobReader) {
+		const int index = writer->copyBlob(*m_blobReader, m_blob);
+		if (index >= 0)
+			return index;
+	}
+
+	const DataPin pin(this);
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double: {
+		const auto* data = static_cast<QVector<double>*>(m_data);
+		return writer->addBlob(reinterpret_cast<const char*>(data->constData()), data->size() * (qint64)sizeof(double));
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		const auto* data = static_cast<QVector<int>*>(m_data);
+		return writer->addBlob(reinterpret_cast<const char*>(data->constData()), data->size() * (qint64)sizeof(int));
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		const auto* data = static_cast<QVector<qint64>*>(m_data);
+		return writer->addBlob(reinterpret_cast<const char*>(data->constData()), data->size() * (qint64)sizeof(qint64));
+	}
+	case AbstractColumn::ColumnMode::Text:
+		if (m_dictionaryEncoded)
+			return writer->addBlob(BinaryProjectWriter::encodeTexts(m_dictionary, m_codes));
+		return writer->addBlob(BinaryProjectWriter::encodeTexts(*static_cast<QVector<QString>*>(m_data)));
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day: {
+		const auto* data = static_cast<QVector<qint64>*>(m_data);
+		return writer->addBlob(reinterpret_cast<const char*>(data->constData()), data->size() * (qint64)sizeof(qint64));
+	}
+	}
+
+	return -1;
+}
+
+/*!
+ * reads the \c rows rows of the column from the blob \c index of \c reader. If lazy loading is enabled in \c reader,
+ * only the row count is set and the data is read on the first access as long as it is not modified.
+ */
+bool ColumnPrivate::readBlob(const std::shared_ptr<BinaryProjectReader>& reader, int index, int rows) {
+	// the date and time values of projects are read as UTC like the values of XML projects
+	m_timeSpec = Qt::UTC;
+	m_utcOffset = 0;
+	if (!reader->lazyLoading()) {
+		invalidate();
+		if (!readBlobData(reader.get(), index, rows))
+			return false;
+		attachToFile(reader, index);
+		return true;
+	}
+
+	// check the size now, a corrupted file can't be reported anymore on the first access
+	qint64 valueSize = 0;
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		valueSize = sizeof(double);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		valueSize = sizeof(int);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		valueSize = sizeof(qint64);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		break;
+	}
+	if (rows < 0 || (valueSize > 0 && reader->blobSize(index) != rows * valueSize))
+		return false;
+
+	dropFile();
+	m_lazyRowCount = rows;
+	available.setUnavailable();
+	minMaxIndex.clear();
+	m_lazy.store(true, std::memory_order_release);
+	attachToFile(reader, index);
+
+	return true;
+}
+
+/*!
+ * reads the blob \c index into the data container (with \c rows rows afterwards) without notifying about the change.
+ */
+bool ColumnPrivate::readBlobData(BinaryProjectReader* reader, int index, int rows) {
+	const qint64 size = reader->blobSize(index);
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double: {
+		auto* data = static_cast<QVector<double>*>(m_data);
+		data->fill(NAN, rows);
+		return size == rows * (qint64)sizeof(double) && reader->readBlob(index, reinterpret_cast<char*>(data->data()), size);
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		auto* data = static_cast<QVector<int>*>(m_data);
+		data->fill(0, rows);
+		return size == rows * (qint64)sizeof(int) && reader->readBlob(index, reinterpret_cast<char*>(data->data()), size);
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		auto* data = static_cast<QVector<qint64>*>(m_data);
+		data->fill(0, rows);
+		return size == rows * (qint64)sizeof(qint64) && reader->readBlob(index, reinterpret_cast<char*>(data->data()), size);
+	}
+	case AbstractColumn::ColumnMode::Text: {
+		// texts with few distinct values are kept dictionary encoded
+		clearDictionary();
+		auto* data = static_cast<QVector<QString>*>(m_data);
+		QByteArray blob;
+		QVector<QString> dictionary;
+		QVector<int> codes;
+		if (!reader->readBlob(index, blob) || !BinaryProjectReader::decodeTexts(blob, dictionary, codes) || codes.size() != rows) {
+			data->resize(rows);
+			return false;
+		}
+		if (dictionary.size() <= maxDictionarySize(rows))
+			setDictionary(dictionary, codes);
+		else {
+			data->resize(rows);
+			for (int i = 0; i < rows; ++i)
+				(*data)[i] = (codes.at(i) < 0) ? QString() : dictionary.at(codes.at(i));
+		}
+		return true;
+	}
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day: {
+		auto* data = static_cast<QVector<qint64>*>(m_data);
+		data->fill(Column::invalidDateTime(), rows);
+		return size == rows * (qint64)sizeof(qint64) && reader->readBlob(index, reinterpret_cast<char*>(data->data()), size);
+	}
+	}
+
+	return false;
+}
+
+/*!
+ * returns \c false if the data of the lazily loaded column was not read from the project file yet.
+ */
+bool ColumnPrivate::isDataLoaded() const {
+	return !m_lazy.load(std::memory_order_acquire);
+}
+
+/*!
+ * reads the data of the lazily loaded column from the project file, called on the first access to the data.
+ * The data can be read from any thread.
+ */
+void ColumnPrivate::loadLazyData() const {
+	QMutexLocker locker(&lazyDataMutex);
+	if (!m_lazy.load(std::memory_order_acquire))
+		return; // read by another thread in the meantime
+
+	PERFTRACE(m_owner->name() + QLatin1String(Q_FUNC_INFO));
+	auto* self = const_cast<ColumnPrivate*>(this);
+	if (!self->readBlobData(m_blobReader.get(), m_blob, m_lazyRowCount))
+		WARN(Q_FUNC_INFO << ", failed to read the data of column " << STDSTRING(m_owner->name()) << ": " << STDSTRING(m_blobReader->errorString()))
+	m_lazy.store(false, std::memory_order_release);
+
+	// the data is unchanged and can be unloaded again if the memory budget is exceeded
+	loadedColumns << self;
+	loadedDataSize += m_blobReader->blobSize(m_blob);
+	if (loadedDataBudget > 0 && loadedDataSize > loadedDataBudget)
+		scheduleUnload();
+}
+
+/*!
+ * frees the (unchanged) data of the column, it's read from the project file again on the next access.
+ * The statistics and the min/max index remain valid.
+ * Returns \c false and keeps the data if the column is pinned by a reader in another thread.
+ * Requires \c lazyDataMutex to be locked.
+ */
+bool ColumnPrivate::unloadData() {
+	// a reader pins the column before it checks m_lazy and the data is freed only after m_lazy is set:
+	// either the reader sees m_lazy set and waits for lazyDataMutex or the pin is seen here
+	m_lazyRowCount = rowCount();
+	m_lazy.store(true);
+	if (m_pins.load() > 0) {
+		m_lazy.store(false);
+		return false;
+	}
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		*static_cast<QVector<double>*>(m_data) = QVector<double>();
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		*static_cast<QVector<int>*>(m_data) = QVector<int>();
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		*static_cast<QVector<qint64>*>(m_data) = QVector<qint64>();
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		*static_cast<QVector<QString>*>(m_data) = QVector<QString>();
+		clearDictionary();
+		break;
+	}
+	return true;
+}
+
+/*!
+ * lets the column refer to the blob \c index of \c reader that contains its (unchanged) data.
+ * The blob is used when the project is saved again and to read the data of a column not loaded yet
+ * (or unloaded because of the memory budget).
+ */
+void ColumnPrivate::attachToFile(const std::shared_ptr<BinaryProjectReader>& reader, int index) {
+	QMutexLocker locker(&lazyDataMutex);
+	if (loadedColumns.removeOne(this))
+		loadedDataSize -= m_blobReader->blobSize(m_blob);
+	m_blobReader = reader;
+	m_blob = index;
+
+	if (!m_lazy.load(std::memory_order_acquire)) {
+		loadedColumns << this;
+		loadedDataSize += m_blobReader->blobSize(m_blob);
+		if (loadedDataBudget > 0 && loadedDataSize > loadedDataBudget)
+			scheduleUnload();
+	}
+}
+
+/*!
+ * reads the data of the lazily loaded column and releases the project file,
+ * called before the data is modified.
+ */
+void ColumnPrivate::detachFromFile() {
+	QMutexLocker locker(&lazyDataMutex);
+	if (!m_blobReader)
+		return;
+
+	if (m_lazy.load(std::memory_order_acquire)) {
+		PERFTRACE(m_owner->name() + QLatin1String(Q_FUNC_INFO));
+		if (!readBlobData(m_blobReader.get(), m_blob, m_lazyRowCount))
+			WARN(Q_FUNC_INFO << ", failed to read the data of column " << STDSTRING(m_owner->name()) << ": " << STDSTRING(m_blobReader->errorString()))
+	}
+	releaseFile();
+}
+
+/*!
+ * releases the project file without reading the data, called when the data is replaced completely.
+ */
+void ColumnPrivate::dropFile() {
+	QMutexLocker locker(&lazyDataMutex);
+	if (m_blobReader)
+		releaseFile();
+}
+
+/*!
+ * removes the column from the loaded columns and resets the reference to the blob. Requires \c lazyDataMutex to be locked.
+ */
+void ColumnPrivate::releaseFile() {
+	if (loadedColumns.removeOne(this))
+		loadedDataSize -= m_blobReader->blobSize(m_blob);
+	m_blobReader.reset();
+	m_blob = -1;
+	m_lazy.store(false, std::memory_order_release);
+}
+
+void ColumnPrivate::setLoadedDataBudget(qint64 bytes) {
+	QMutexLocker locker(&lazyDataMutex);
+	loadedDataBudget = bytes;
+	if (loadedDataBudget > 0 && loadedDataSize > loadedDataBudget)
+		scheduleUnload();
+}
+
+/*!
+ * unloads the columns in the event loop of the main thread and not while the data is in use. Requires \c lazyDataMutex to be locked.
+ */
+void ColumnPrivate::scheduleUnload() {
+	if (unloadScheduled || !QCoreApplication::instance())
+		return;
+
+	unloadScheduled = true;
+	QTimer::singleShot(0, QCoreApplication::instance(), &ColumnPrivate::unloadColumns);
+}
+
+/*!
+ * unloads the columns loaded first until the memory budget is kept.
+ */
+void ColumnPrivate::unloadColumns() {
+	QMutexLocker locker(&lazyDataMutex);
+	unloadScheduled = false;
+
+	// the column loaded last is kept, it's most likely still in use.
+	// columns pinned by a calculation in the background are skipped
+	int i = 0;
+	while (loadedDataBudget > 0 && loadedDataSize > loadedDataBudget && i < loadedColumns.size() - 1) {
+		auto* column = loadedColumns.at(i);
+		if (column->unloadData()) {
+			loadedColumns.removeAt(i);
+			loadedDataSize -= column->m_blobReader->blobSize(column->m_blob);
+		} else
+			++i;
+	}
+
+	// try again when the pinned columns are not in use anymore
+	if (loadedDataBudget > 0 && loadedDataSize > loadedDataBudget && loadedColumns.size() > 1) {
+		unloadScheduled = true;
+		QTimer::singleShot(1000, QCoreApplication::instance(), &ColumnPrivate::unloadColumns);
+	}
+	DEBUG(Q_FUNC_INFO << ", loaded columns: " << loadedColumns.size() << ", size: " << loadedDataSize)
+}
+
 /*!
  * \brief ColumnPrivate::connectFormulaColumn
  * This function is used to connect the columns to the needed slots for updating formulas
@@ -1234,8 +1850,10 @@ void ColumnPrivate::setFormulVariableColumn(Column* c) {
 void ColumnPrivate::updateFormula() {
 	DEBUG(Q_FUNC_INFO)
 	//determine variable names and the data vectors of the specified columns
-	QVector<QVector<double>*> xVectors;
+	QVector<const QVector<double>*> xVectors;
 	QVector<QVector<double>*> xNewVectors;
+	// the variable columns are read without detaching them from the project file, the pins keep their data loaded
+	std::vector<std::unique_ptr<Column::DataPin>> pins;
 	int maxRowCount = 0;
 
 	bool valid = true;
@@ -1255,8 +1873,10 @@ void ColumnPrivate::updateFormula() {
 
 			xNewVectors << xVector;
 			xVectors << xVector;
-		} else
-			xVectors << static_cast<QVector<double>* >(column->data());
+		} else {
+			pins.push_back(std::unique_ptr<Column::DataPin>(new Column::DataPin(column)));
+			xVectors << static_cast<const QVector<double>*>(column->constData());
+		}
 
 		if (column->rowCount() > maxRowCount)
 			maxRowCount = column->rowCount();
@@ -1401,7 +2021,10 @@ void ColumnPrivate::replaceValues(int first, const QVector<int>& new_values) {
 }
 
 void ColumnPrivate::replaceValues(int first, const QVector<qint64>& new_values) {
-	replaceBigInt(first, new_values);
+	if (m_columnMode == AbstractColumn::ColumnMode::BigInt)
+		replaceBigInt(first, new_values);
+	else
+		replaceMSecs(first, new_values);
 }
 
 void ColumnPrivate::replaceValues(int first, const QVector<QDateTime>& new_values) {
@@ -1421,6 +2044,12 @@ void ColumnPrivate::replaceValues(int first, const QVector<QString>& new_values)
 //@{
 ////////////////////////////////////////////////////////////////////////////////
 
+/*
+ * The single row accessors below only load the data of a lazily loaded column and don't pin it:
+ * the data is only unloaded in the event loop of the main thread, readers in other threads
+ * have to pin the column once for all rows they read, see DataPin.
+ */
+
 /**
  * \brief Return the content of row 'row'.
  *
@@ -1429,6 +2058,11 @@ void ColumnPrivate::replaceValues(int first, const QVector<QString>& new_values)
 QString ColumnPrivate::textAt(int row) const {
 	if (m_columnMode != AbstractColumn::ColumnMode::Text) return QString();
 	//DEBUG(Q_FUNC_INFO << ", row = " << row)
+	loadData();
+	if (m_dictionaryEncoded) {
+		const int code = m_codes.value(row, -1);
+		return (code < 0) ? QString() : m_dictionary.at(code);
+	}
 	return static_cast<QVector<QString>*>(m_data)->value(row);
 }
 
@@ -1468,7 +2102,8 @@ QDateTime ColumnPrivate::dateTimeAt(int row) const {
 		m_columnMode != AbstractColumn::ColumnMode::Month &&
 		m_columnMode != AbstractColumn::ColumnMode::Day)
 		return QDateTime();
-	return static_cast<QVector<QDateTime>*>(m_data)->value(row);
+	loadData();
+	return toDateTime(static_cast<QVector<qint64>*>(m_data)->value(row, Column::invalidDateTime()));
 }
 
 /**
@@ -1477,6 +2112,7 @@ QDateTime ColumnPrivate::dateTimeAt(int row) const {
  * For cases where the integer value is needed without any implicit conversions, \sa integerAt() has to be used.
  */
 double ColumnPrivate::valueAt(int index) const {
+	loadData();
 	if (m_columnMode == AbstractColumn::ColumnMode::Double)
 		return static_cast<QVector<double>*>(m_data)->value(index, NAN);
 	else if (m_columnMode == AbstractColumn::ColumnMode::Integer)
@@ -1487,11 +2123,71 @@ double ColumnPrivate::valueAt(int index) const {
 		 return NAN;
 }
 
+/**
+ * \brief Read the numerical values of the rows \c first .. \c first + \c count - 1 into \c values
+ *
+ * \c valid[i] is set to \c true if the row has a numerical value (masking is not considered here).
+ * \sa Column::valuesAt()
+ */
+void ColumnPrivate::valuesAt(int first, int count, double* values, bool* valid) const {
+	const DataPin pin(this);
+
+	// rows not present in the column are invalid
+	const int available = qBound(0, rowCount() - first, count);
+	std::fill(values + available, values + count, NAN);
+	if (valid)
+		std::fill(valid + available, valid + count, false);
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double: {
+		const double* data = static_cast<QVector<double>*>(m_data)->constData() + first;
+		std::copy(data, data + available, values);
+		if (valid) {
+			for (int i = 0; i < available; ++i)
+				valid[i] = !std::isnan(values[i]);
+		}
+		break;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		const int* data = static_cast<QVector<int>*>(m_data)->constData() + first;
+		std::copy(data, data + available, values);
+		if (valid)
+			std::fill(valid, valid + available, true);
+		break;
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		const qint64* data = static_cast<QVector<qint64>*>(m_data)->constData() + first;
+		std::copy(data, data + available, values);
+		if (valid)
+			std::fill(valid, valid + available, true);
+		break;
+	}
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day: {
+		const qint64* data = static_cast<QVector<qint64>*>(m_data)->constData() + first;
+		for (int i = 0; i < available; ++i) {
+			const bool isValid = (data[i] != Column::invalidDateTime());
+			values[i] = isValid ? data[i] : NAN;
+			if (valid)
+				valid[i] = isValid;
+		}
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text:
+		std::fill(values, values + available, NAN);
+		if (valid)
+			std::fill(valid, valid + available, false);
+		break;
+	}
+}
+
 /**
  * \brief Return the int value in row 'row'
  */
 int ColumnPrivate::integerAt(int row) const {
 	if (m_columnMode != AbstractColumn::ColumnMode::Integer) return 0;
+	loadData();
 	return static_cast<QVector<int>*>(m_data)->value(row, 0);
 }
 
@@ -1500,11 +2196,69 @@ int ColumnPrivate::integerAt(int row) const {
  */
 qint64 ColumnPrivate::bigIntAt(int row) const {
 	if (m_columnMode != AbstractColumn::ColumnMode::BigInt) return 0;
+	loadData();
 	return static_cast<QVector<qint64>*>(m_data)->value(row, 0);
 }
 
 void ColumnPrivate::invalidate() {
+	detachFromFile();
+	invalidateCachedValues();
+}
+
+/*!
+ * same as \c invalidate() if only the rows \c first .. \c last are changed,
+ * the extrema of the unchanged blocks of rows are kept.
+ */
+void ColumnPrivate::invalidate(int first, int last) {
+	detachFromFile();
 	available.setUnavailable();
+	minMaxIndex.invalidate(first, last);
+}
+
+/*!
+ * resets the cached statistics, properties and extrema without touching the data,
+ * e.g. if only the masking of rows was changed. A lazily loaded column stays attached to its file.
+ */
+void ColumnPrivate::invalidateCachedValues() {
+	available.setUnavailable();
+	minMaxIndex.clear();
+}
+
+/*!
+ * merges the extrema of the valid and unmasked values in the rows \c first .. \c last - 1 into \c min and \c max.
+ * The extrema of complete blocks of rows are taken from the min/max index.
+ * The data is pinned before the index is locked, so lazily loaded data is not loaded with the index locked.
+ */
+void ColumnPrivate::minMax(int first, int last, double& min, double& max) {
+	const DataPin pin(this);
+	minMaxIndex.minMax(first, last, rowCount(), [this](int scanFirst, int scanLast, double& scanMin, double& scanMax) {
+		scanMinMax(scanFirst, scanLast, scanMin, scanMax);
+	}, min, max);
+}
+
+void ColumnPrivate::scanMinMax(int first, int last, double& min, double& max) const {
+	const int chunkSize = 1024;
+	double values[chunkSize];
+
+	// iterate over the runs of unmasked rows
+	int row = m_owner->nextUnmaskedRow(first);
+	while (row < last) {
+		const int end = qMin(m_owner->nextMaskedRow(row), last);
+		for (int start = row; start < end; start += chunkSize) {
+			const int count = qMin(chunkSize, end - start);
+			valuesAt(start, count, values, nullptr);
+			for (int i = 0; i < count; ++i) {
+				const double value = values[i];	// invalid values are NAN and fail both comparisons
+				if (value < min)
+					min = value;
+				if (value > max)
+					max = value;
+			}
+		}
+		if (end >= last)
+			break;
+		row = m_owner->nextUnmaskedRow(end);
+	}
 }
 
 /**
@@ -1521,7 +2275,14 @@ void ColumnPrivate::setTextAt(int row, const QString& new_value) {
 	if (row >= rowCount())
 		resizeTo(row + 1);
 
-	static_cast<QVector<QString>*>(m_data)->replace(row, new_value);
+	// dictionary encoded texts are only expanded for new distinct values
+	int code;
+	if (m_dictionaryEncoded && dictionaryCode(new_value, code))
+		m_codes[row] = code;
+	else {
+		decodeDictionary();
+		static_cast<QVector<QString>*>(m_data)->replace(row, new_value);
+	}
 	if (!m_owner->m_suppressDataChangedSignal)
 		Q_EMIT m_owner->dataChanged(m_owner);
 }
@@ -1538,9 +2299,11 @@ void ColumnPrivate::replaceTexts(int first, const QVector<QString>& new_values)
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 
-	if (first < 0)
+	if (first < 0) {
+		clearDictionary();
 		*static_cast<QVector<QString>*>(m_data) = new_values;
-	else {
+	} else {
+		decodeDictionary();
 		const int num_rows = new_values.size();
 		resizeTo(first + num_rows);
 
@@ -1591,13 +2354,14 @@ void ColumnPrivate::setDateTimeAt(int row, const QDateTime& new_value) {
 		m_columnMode != AbstractColumn::ColumnMode::Day)
 		return;
 
-	invalidate();
+	invalidate(row, row);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (row >= rowCount())
 		resizeTo(row+1);
 
-	static_cast< QVector<QDateTime>* >(m_data)->replace(row, new_value);
+	setTimeSpec(new_value);
+	static_cast<QVector<qint64>*>(m_data)->replace(row, Column::dateTimeToMSecs(new_value));
 	if (!m_owner->m_suppressDataChangedSignal)
 		Q_EMIT m_owner->dataChanged(m_owner);
 }
@@ -1615,24 +2379,76 @@ void ColumnPrivate::replaceDateTimes(int first, const QVector<QDateTime>& new_va
 		m_columnMode != AbstractColumn::ColumnMode::Day)
 		return;
 
-	invalidate();
+	if (!new_values.isEmpty())
+		setTimeSpec(new_values.constFirst());
+	replaceMSecs(first, toMSecs(new_values));
+}
+
+/**
+ * \brief Replace a range of values with the milliseconds since epoch
+ * \param first first index which should be replaced. If first < 0, the complete vector
+ * will be replaced
+ * \param new_values
+ * Use this only when columnMode() is DateTime, Month or Day
+ */
+void ColumnPrivate::replaceMSecs(int first, const QVector<qint64>& new_values) {
+	if (m_columnMode != AbstractColumn::ColumnMode::DateTime &&
+		m_columnMode != AbstractColumn::ColumnMode::Month &&
+		m_columnMode != AbstractColumn::ColumnMode::Day)
+		return;
+
+	if (first < 0)
+		invalidate();
+	else
+		invalidate(first, first + new_values.size() - 1);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 
 	if (first < 0)
-		*static_cast< QVector<QDateTime>* >(m_data) = new_values;
+		*static_cast<QVector<qint64>*>(m_data) = new_values;
 	else {
 		const int num_rows = new_values.size();
 		resizeTo(first + num_rows);
 
-		for (int i = 0; i < num_rows; ++i)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(first+i, new_values.at(i));
+		std::copy(new_values.constBegin(), new_values.constEnd(), static_cast<QVector<qint64>*>(m_data)->begin() + first);
 	}
 
 	if (!m_owner->m_suppressDataChangedSignal)
 		Q_EMIT m_owner->dataChanged(m_owner);
 }
 
+/**
+ * \brief Set the time spec of the column to the one of \c dateTime
+ *
+ * The values are stored as milliseconds since epoch, the time spec of the column is used to
+ * convert them back to QDateTime. Time zones are replaced by their offset from UTC at \c dateTime.
+ */
+void ColumnPrivate::setTimeSpec(const QDateTime& dateTime) {
+	if (dateTime.isValid())
+		setTimeSpec(dateTime.timeSpec(), dateTime.offsetFromUtc());
+}
+
+void ColumnPrivate::setTimeSpec(Qt::TimeSpec spec, int utcOffset) {
+	m_timeSpec = (spec == Qt::TimeZone) ? Qt::OffsetFromUTC : spec;
+	m_utcOffset = (m_timeSpec == Qt::OffsetFromUTC) ? utcOffset : 0;
+}
+
+//! converts the milliseconds since epoch \c msecs to QDateTime using the time spec of the column
+QDateTime ColumnPrivate::toDateTime(qint64 msecs) const {
+	if (msecs == Column::invalidDateTime())
+		return QDateTime();
+	if (m_timeSpec == Qt::OffsetFromUTC)
+		return QDateTime::fromMSecsSinceEpoch(msecs, Qt::OffsetFromUTC, m_utcOffset);
+	return QDateTime::fromMSecsSinceEpoch(msecs, m_timeSpec);
+}
+
+QVector<qint64> ColumnPrivate::toMSecs(const QVector<QDateTime>& dateTimes) {
+	QVector<qint64> msecs(dateTimes.size());
+	for (int i = 0; i < dateTimes.size(); ++i)
+		msecs[i] = Column::dateTimeToMSecs(dateTimes.at(i));
+	return msecs;
+}
+
 /**
  * \brief Set the content of row 'row'
  *
@@ -1642,7 +2458,7 @@ void ColumnPrivate::setValueAt(int row, double new_value) {
 	//DEBUG(Q_FUNC_INFO);
 	if (m_columnMode != AbstractColumn::ColumnMode::Double) return;
 
-	invalidate();
+	invalidate(row, row);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (row >= rowCount())
@@ -1663,7 +2479,10 @@ void ColumnPrivate::replaceValues(int first, const QVector<double>& new_values)
 
 	if (m_columnMode != AbstractColumn::ColumnMode::Double) return;
 
-	invalidate();
+	if (first < 0)
+		invalidate();
+	else
+		invalidate(first, first + new_values.size() - 1);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (first < 0)
@@ -1756,7 +2575,7 @@ void ColumnPrivate::setIntegerAt(int row, int new_value) {
 	//DEBUG(Q_FUNC_INFO);
 	if (m_columnMode != AbstractColumn::ColumnMode::Integer) return;
 
-	invalidate();
+	invalidate(row, row);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (row >= rowCount())
@@ -1776,7 +2595,10 @@ void ColumnPrivate::replaceInteger(int first, const QVector<int>& new_values) {
 	//DEBUG(Q_FUNC_INFO);
 	if (m_columnMode != AbstractColumn::ColumnMode::Integer) return;
 
-	invalidate();
+	if (first < 0)
+		invalidate();
+	else
+		invalidate(first, first + new_values.size() - 1);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 
@@ -1804,7 +2626,7 @@ void ColumnPrivate::setBigIntAt(int row, qint64 new_value) {
 	//DEBUG(Q_FUNC_INFO);
 	if (m_columnMode != AbstractColumn::ColumnMode::BigInt) return;
 
-	invalidate();
+	invalidate(row, row);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 	if (row >= rowCount())
@@ -1824,7 +2646,10 @@ void ColumnPrivate::replaceBigInt(int first, const QVector<qint64>& new_values)
 	//DEBUG(Q_FUNC_INFO);
 	if (m_columnMode != AbstractColumn::ColumnMode::BigInt) return;
 
-	invalidate();
+	if (first < 0)
+		invalidate();
+	else
+		invalidate(first, first + new_values.size() - 1);
 
 	Q_EMIT m_owner->dataAboutToChange(m_owner);
 
@@ -1871,8 +2696,10 @@ void ColumnPrivate::updateProperties() {
 		prevValue = valueAt(0);
 	else if (m_columnMode == AbstractColumn::ColumnMode::DateTime ||
 			m_columnMode == AbstractColumn::ColumnMode::Month ||
-			m_columnMode == AbstractColumn::ColumnMode::Day)
-		prevValueDatetime = dateTimeAt(0).toMSecsSinceEpoch();
+			m_columnMode == AbstractColumn::ColumnMode::Day) {
+		const DataPin pin(this);
+		prevValueDatetime = static_cast<QVector<qint64>*>(m_data)->value(0);
+	}
 	else {
 		properties = AbstractColumn::Properties::No;
 		available.properties = true;
@@ -1983,7 +2810,7 @@ void ColumnPrivate::updateProperties() {
 				   m_columnMode == AbstractColumn::ColumnMode::Month ||
 				   m_columnMode == AbstractColumn::ColumnMode::Day) {
 
-			valueDateTime = dateTimeAt(row).toMSecsSinceEpoch();
+			valueDateTime = static_cast<QVector<qint64>*>(m_data)->at(row);
 
 			if (valueDateTime > prevValueDatetime) {
 				monotonic_decreasing = 0;
@@ -14,9 +14,16 @@
 #define COLUMNPRIVATE_H
 
 #include "backend/core/AbstractColumn.h"
+#include "backend/lib/BlockMinMaxIndex.h"
 #include "backend/lib/IntervalAttribute.h"
+#include "backend/lib/StatisticsAccumulator.h"
 #include "backend/core/column/Column.h"
 
+#include <atomic>
+#include <memory>
+
+class BinaryProjectReader;
+class BinaryProjectWriter;
 class Column;
 class ColumnSetGlobalFormulaCmd;
 
@@ -43,6 +50,7 @@ public:
 
 	void insertRows(int before, int count);
 	void removeRows(int first, int count);
+	void shiftRows(int count);
 	QString name() const;
 
 	AbstractColumn::PlotDesignation plotDesignation() const;
@@ -52,6 +60,7 @@ public:
 	void setWidth(int);
 
 	void* data() const;
+	const void* constData() const;
 	bool hasValueLabels() const;
 	void removeValueLabel(const QString&);
 	void clearValueLabels();
@@ -91,6 +100,14 @@ public:
 	void replaceTexts(int first, const QVector<QString>&);
 	void addValueLabel(const QString&, const QString&);
 	const QMap<QString, QString>& textValueLabels();
+	bool isDictionaryEncoded() const;
+	bool encodeDictionary(int maxSize = -1);
+	void decodeDictionary() const;
+	const QVector<QString>& dictionary() const;
+	const QVector<int>& dictionaryCodes() const;
+	bool dictionaryCode(const QString&, int& code) const;
+	void setDictionary(const QVector<QString>& dictionary, QVector<int> codes);
+	static int maxDictionarySize(int rows);
 
 	QDate dateAt(int row) const;
 	void setDateAt(int row, QDate);
@@ -101,10 +118,16 @@ public:
 	void setDateTimeAt(int row, const QDateTime&);
 	void replaceValues(int first, const QVector<QDateTime>&);
 	void replaceDateTimes(int first, const QVector<QDateTime>&);
+	void replaceMSecs(int first, const QVector<qint64>&);
+	void setTimeSpec(const QDateTime&);
+	void setTimeSpec(Qt::TimeSpec, int utcOffset = 0);
+	QDateTime toDateTime(qint64 msecs) const;
+	static QVector<qint64> toMSecs(const QVector<QDateTime>&);
 	void addValueLabel(const QDateTime&, const QString&);
 	const QMap<QDateTime, QString>& dateTimeValueLabels();
 
 	double valueAt(int row) const;
+	void valuesAt(int first, int count, double* values, bool* valid) const;
 	void setValueAt(int row, double new_value);
 	void replaceValues(int first, const QVector<double>&);
 	void addValueLabel(double, const QString&);
@@ -128,17 +151,52 @@ public:
 
 	void updateProperties();
 	void invalidate();
+	void invalidate(int first, int last);
+	void invalidateCachedValues();
+	void minMax(int first, int last, double& min, double& max);
 	void finalizeLoad();
 
+	int writeBlob(BinaryProjectWriter*) const;
+	bool readBlob(const std::shared_ptr<BinaryProjectReader>&, int index, int rows);
+	bool isDataLoaded() const;
+	void loadData() const { if (m_lazy.load(std::memory_order_acquire)) loadLazyData(); }
+	void attachToFile(const std::shared_ptr<BinaryProjectReader>&, int index);
+	void detachFromFile();
+	static void setLoadedDataBudget(qint64 bytes);
+
+	// the data and the dictionary of a pinned column are loaded and not freed until the column is unpinned
+	void pinData() const {
+		m_pins.fetch_add(1);
+		if (m_lazy.load())
+			loadLazyData();
+	}
+	void unpinData() const { m_pins.fetch_sub(1); }
+
+	// pins the column while its data is read, see Column::DataPin
+	class DataPin {
+	public:
+		explicit DataPin(const ColumnPrivate* column) : m_column(column) { m_column->pinData(); }
+		~DataPin() { m_column->unpinData(); }
+		DataPin(const DataPin&) = delete;
+		DataPin& operator=(const DataPin&) = delete;
+
+	private:
+		const ColumnPrivate* m_column;
+	};
+
 	struct CachedValuesAvailable {
 		void setUnavailable() {
 			statistics = false;
+			exactStatistics = false;
+			statisticsRows = 0;
 			min = false;
 			max = false;
 			hasValues = false;
 			properties = false;
 		}
 		bool statistics{false}; //is 'statistics' already available or needs to be (re-)calculated?
+		bool exactStatistics{false}; //are the exact quantiles, mode and entropy in 'statistics' available?
+		int statisticsRows{0}; //number of rows accumulated in 'statisticsAccumulator', rows appended later are added incrementally
 		// are minMax already calculated or needs to be (re-)calculated?
 		// It is separated from statistics, because these are important values
 		// which are quite often needed, but if the curve is monoton a faster algorithm is
@@ -151,12 +209,32 @@ public:
 
 	CachedValuesAvailable available;
 	AbstractColumn::ColumnStatistics statistics;
+	StatisticsAccumulator statisticsAccumulator;
+	BlockMinMaxIndex minMaxIndex;	// extrema of blocks of rows for the fast determination of range extrema
 	bool hasValues{false};
 	AbstractColumn::Properties properties{AbstractColumn::Properties::No}; // declares the properties of the curve (monotonic increasing/decreasing ...). Speed up algorithms
 
 private:
+	void scanMinMax(int first, int last, double& min, double& max) const;
+	Column* dateTimeColumn(void* data) const;
+	void clearDictionary();
+	bool readBlobData(BinaryProjectReader*, int index, int rows);
+	void loadLazyData() const;
+	bool unloadData();
+	void dropFile();
+	void releaseFile();
+	static void scheduleUnload();
+	static void unloadColumns();
+
 	AbstractColumn::ColumnMode m_columnMode;	// type of column data
-	void* m_data{nullptr};	//pointer to the data container (QVector<T>)
+	void* m_data{nullptr};	//pointer to the data container (QVector<T>, QVector<qint64> with the milliseconds since epoch for date and time values)
+	Qt::TimeSpec m_timeSpec{Qt::LocalTime};	// time spec of the date and time values
+	int m_utcOffset{0};	// offset from UTC in seconds for Qt::OffsetFromUTC
+	// dictionary encoded texts: m_data is empty, the sorted distinct values are in m_dictionary
+	// and m_codes contains the index in m_dictionary of every row (-1 for null strings)
+	mutable std::atomic<bool> m_dictionaryEncoded{false};
+	QVector<QString> m_dictionary;
+	QVector<int> m_codes;
 	void* m_labels{nullptr};	//pointer to the container for the value labels(QMap<T, QString>)
 	AbstractSimpleFilter* m_inputFilter{nullptr};	//input filter for string -> data type conversion
 	AbstractSimpleFilter* m_outputFilter{nullptr};	//output filter for data type -> string conversion
@@ -169,6 +247,14 @@ private:
 	Column* m_owner{nullptr};
 	QVector<QMetaObject::Connection> m_connectionsUpdateFormula;
 
+	// lazy loading from binary project files: as long as the data is not modified, the column can read it
+	// from the blob of the project file, m_data is empty and m_lazyRowCount rows are available while m_lazy is set
+	std::shared_ptr<BinaryProjectReader> m_blobReader;
+	int m_blob{-1};
+	int m_lazyRowCount{0};
+	mutable std::atomic<bool> m_lazy{false};
+	mutable std::atomic<int> m_pins{0};	// number of readers pinning the data, see DataPin
+
 	void initLabels();
 	void connectFormulaColumn(const AbstractColumn* column);
 
@@ -16,6 +16,52 @@
 #include "backend/lib/macros.h"
 #include <KLocalizedString>
 
+//! size of the data vector of a column in bytes
+static qint64 dataMemorySize(AbstractColumn::ColumnMode mode, const void* data) {
+	if (!data)
+		return 0;
+
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double:
+		return valuesMemorySize(*static_cast<const QVector<double>*>(data));
+	case AbstractColumn::ColumnMode::Integer:
+		return valuesMemorySize(*static_cast<const QVector<int>*>(data));
+	case AbstractColumn::ColumnMode::BigInt:
+		return valuesMemorySize(*static_cast<const QVector<qint64>*>(data));
+	case AbstractColumn::ColumnMode::Text:
+		return valuesMemorySize(*static_cast<const QVector<QString>*>(data));
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		return valuesMemorySize(*static_cast<const QVector<qint64>*>(data));
+	}
+
+	return 0;
+}
+
+//! deletes the data vector of a column
+static void deleteData(AbstractColumn::ColumnMode mode, void* data) {
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double:
+		delete static_cast<QVector<double>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		delete static_cast<QVector<int>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		delete static_cast<QVector<qint64>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		delete static_cast<QVector<QString>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		delete static_cast<QVector<qint64>*>(data);
+		break;
+	}
+}
+
 /** ***************************************************************************
  * \class ColumnSetModeCmd
  * \brief Set the column mode
@@ -106,7 +152,7 @@ ColumnSetModeCmd::~ColumnSetModeCmd() {
 			case AbstractColumn::ColumnMode::DateTime:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day:
-				delete static_cast<QVector<QDateTime>*>(m_new_data);
+				delete static_cast<QVector<qint64>*>(m_new_data);
 				break;
 			}
 	} else {
@@ -127,7 +173,7 @@ ColumnSetModeCmd::~ColumnSetModeCmd() {
 			case AbstractColumn::ColumnMode::DateTime:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day:
-				delete static_cast<QVector<QDateTime>*>(m_old_data);
+				delete static_cast<QVector<qint64>*>(m_old_data);
 				break;
 			}
 	}
@@ -137,6 +183,8 @@ ColumnSetModeCmd::~ColumnSetModeCmd() {
  * \brief Execute the command
  */
 void ColumnSetModeCmd::redo() {
+	if (m_released)
+		return;
 	if (!m_executed) {
 		// save old values
 		m_old_mode = m_col->columnMode();
@@ -163,12 +211,37 @@ void ColumnSetModeCmd::redo() {
  * \brief Undo the command
  */
 void ColumnSetModeCmd::undo() {
+	if (m_released)
+		return;
 	// reset to old values
 	m_col->replaceModeData(m_old_mode, m_old_data, m_old_in_filter, m_old_out_filter);
 
 	m_undone = true;
 }
 
+/**
+ * \brief Size of the data held by the command
+ */
+qint64 ColumnSetModeCmd::memorySize() const {
+	if (!m_executed || m_new_data == m_old_data)
+		return 0;
+	if (m_undone)
+		return dataMemorySize(m_mode, m_new_data);
+	return dataMemorySize(m_old_mode, m_old_data);
+}
+
+/**
+ * \brief Release the data of the old mode, the command is not undone anymore
+ */
+void ColumnSetModeCmd::releaseMemory() {
+	if (m_undone)
+		return;
+	if (m_new_data != m_old_data)
+		deleteData(m_old_mode, m_old_data);
+	m_old_data = m_new_data;
+	m_released = true;
+}
+
 /** ***************************************************************************
  * \class ColumnFullCopyCmd
  * \brief Copy a complete column
@@ -218,6 +291,8 @@ ColumnFullCopyCmd::~ColumnFullCopyCmd() {
  * \brief Execute the command
  */
 void ColumnFullCopyCmd::redo() {
+	if (m_released)
+		return;
 	if (m_backup == nullptr) {
 		m_backup_owner = new Column("temp", m_src->columnMode());
 		m_backup = new ColumnPrivate(m_backup_owner, m_src->columnMode());
@@ -235,12 +310,34 @@ void ColumnFullCopyCmd::redo() {
  * \brief Undo the command
  */
 void ColumnFullCopyCmd::undo() {
+	if (m_released)
+		return;
 	// swap data of orig. column and backup
 	void* data_temp = m_col->data();
 	m_col->replaceData(m_backup->data());
 	m_backup->replaceData(data_temp);
 }
 
+/**
+ * \brief Size of the data held by the command
+ */
+qint64 ColumnFullCopyCmd::memorySize() const {
+	if (!m_backup)
+		return 0;
+	return dataMemorySize(m_backup->columnMode(), m_backup->data());
+}
+
+/**
+ * \brief Release the backup, the command is not undone anymore
+ */
+void ColumnFullCopyCmd::releaseMemory() {
+	delete m_backup;
+	delete m_backup_owner;
+	m_backup = nullptr;
+	m_backup_owner = nullptr;
+	m_released = true;
+}
+
 /** ***************************************************************************
  * \class ColumnPartialCopyCmd
  * \brief Copy parts of a column
@@ -326,6 +423,8 @@ ColumnPartialCopyCmd::~ColumnPartialCopyCmd() {
  * \brief Execute the command
  */
 void ColumnPartialCopyCmd::redo() {
+	if (m_released)
+		return;
 	if (m_src_backup == nullptr) {
 		// copy the relevant rows of source and destination column into backup columns
 		m_src_backup_owner = new Column("temp", m_col->columnMode());
@@ -343,11 +442,40 @@ void ColumnPartialCopyCmd::redo() {
  * \brief Undo the command
  */
 void ColumnPartialCopyCmd::undo() {
+	if (m_released)
+		return;
 	m_col->copy(m_col_backup, 0, m_dest_start, m_num_rows);
 	m_col->resizeTo(m_old_row_count);
 	m_col->replaceData(m_col->data());
 }
 
+/**
+ * \brief Size of the data held by the command
+ */
+qint64 ColumnPartialCopyCmd::memorySize() const {
+	qint64 size = 0;
+	if (m_src_backup)
+		size += dataMemorySize(m_src_backup->columnMode(), m_src_backup->data());
+	if (m_col_backup)
+		size += dataMemorySize(m_col_backup->columnMode(), m_col_backup->data());
+	return size;
+}
+
+/**
+ * \brief Release the backups, the command is not undone anymore
+ */
+void ColumnPartialCopyCmd::releaseMemory() {
+	delete m_src_backup;
+	delete m_col_backup;
+	delete m_src_backup_owner;
+	delete m_col_backup_owner;
+	m_src_backup = nullptr;
+	m_col_backup = nullptr;
+	m_src_backup_owner = nullptr;
+	m_col_backup_owner = nullptr;
+	m_released = true;
+}
+
 /** ***************************************************************************
  * \class ColumnInsertRowsCmd
  * \brief Insert empty rows
@@ -438,6 +566,8 @@ ColumnRemoveRowsCmd::~ColumnRemoveRowsCmd() {
  * \brief Execute the command
  */
 void ColumnRemoveRowsCmd::redo() {
+	if (m_released)
+		return;
 	if (m_backup == nullptr) {
 		if (m_first >= m_col->rowCount())
 			m_data_row_count = 0;
@@ -459,12 +589,35 @@ void ColumnRemoveRowsCmd::redo() {
  * \brief Undo the command
  */
 void ColumnRemoveRowsCmd::undo() {
+	if (m_released)
+		return;
 	m_col->insertRows(m_first, m_count);
 	m_col->copy(m_backup, 0, m_first, m_data_row_count);
 	m_col->resizeTo(m_old_size);
 	m_col->replaceFormulas(m_formulas);
 }
 
+/**
+ * \brief Size of the data held by the command
+ */
+qint64 ColumnRemoveRowsCmd::memorySize() const {
+	if (!m_backup)
+		return 0;
+	return dataMemorySize(m_backup->columnMode(), m_backup->data());
+}
+
+/**
+ * \brief Release the removed rows, the command is not undone anymore
+ */
+void ColumnRemoveRowsCmd::releaseMemory() {
+	delete m_backup;
+	delete m_backup_owner;
+	m_backup = nullptr;
+	m_backup_owner = nullptr;
+	m_formulas = IntervalAttribute<QString>();
+	m_released = true;
+}
+
 /** ***************************************************************************
  * \class ColumnSetPlotDesignationCmd
  * \brief Sets a column's plot designation
@@ -518,6 +671,11 @@ void ColumnSetPlotDesignationCmd::undo() {
  * \brief The private column data to modify
  */
 
+/**
+ * \var ColumnClearCmd::m_mode
+ * \brief The mode of the cleared data
+ */
+
 /**
  * \var ColumnClearCmd::m_data
  * \brief Pointer to the old data pointer
@@ -537,7 +695,7 @@ void ColumnSetPlotDesignationCmd::undo() {
  * \brief Ctor
  */
 ColumnClearCmd::ColumnClearCmd(ColumnPrivate* col, QUndoCommand* parent)
-	: QUndoCommand(parent), m_col(col) {
+	: QUndoCommand(parent), m_col(col), m_mode(col->columnMode()) {
 	setText(i18n("%1: clear column", col->name()));
 }
 
@@ -563,7 +721,7 @@ ColumnClearCmd::~ColumnClearCmd() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			delete static_cast<QVector<QDateTime>*>(m_empty_data);
+			delete static_cast<QVector<qint64>*>(m_empty_data);
 			break;
 		}
 	} else {
@@ -584,7 +742,7 @@ ColumnClearCmd::~ColumnClearCmd() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			delete static_cast<QVector<QDateTime>*>(m_data);
+			delete static_cast<QVector<qint64>*>(m_data);
 			break;
 		}
 	}
@@ -594,6 +752,8 @@ ColumnClearCmd::~ColumnClearCmd() {
  * \brief Execute the command
  */
 void ColumnClearCmd::redo() {
+	if (m_released)
+		return;
 	if (!m_empty_data) {
 		const int rowCount = m_col->rowCount();
 		switch (m_col->columnMode()) {
@@ -621,9 +781,7 @@ void ColumnClearCmd::redo() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			m_empty_data = new QVector<QDateTime>();
-			for (int i = 0; i < rowCount; ++i)
-				static_cast< QVector<QDateTime>*>(m_empty_data)->append(QDateTime());
+			m_empty_data = new QVector<qint64>(rowCount, Column::invalidDateTime());
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			m_empty_data = new QVector<QString>();
@@ -641,10 +799,30 @@ void ColumnClearCmd::redo() {
  * \brief Undo the command
  */
 void ColumnClearCmd::undo() {
+	if (m_released)
+		return;
 	m_col->replaceData(m_data);
 	m_undone = true;
 }
 
+/**
+ * \brief Size of the data held by the command
+ */
+qint64 ColumnClearCmd::memorySize() const {
+	return dataMemorySize(m_mode, m_undone ? m_empty_data : m_data);
+}
+
+/**
+ * \brief Release the old data, the command is not undone anymore
+ */
+void ColumnClearCmd::releaseMemory() {
+	if (m_undone)
+		return;
+	deleteData(m_mode, m_data);
+	m_data = nullptr;
+	m_released = true;
+}
+
 
 /** ***************************************************************************
  * \class ColumSetGlobalFormulaCmd
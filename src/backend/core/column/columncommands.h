@@ -14,6 +14,8 @@
 #define COLUMNCOMMANDS_H
 
 #include "backend/lib/IntervalAttribute.h"
+#include "backend/lib/UndoMemory.h"
+#include "backend/lib/macros.h"
 #include "backend/core/column/Column.h"
 #include "backend/core/column/ColumnPrivate.h"
 
@@ -22,16 +24,22 @@
 #include <QUndoCommand>
 #include <QDateTime>
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
 class QStringList;
 class AbstractSimpleFilter;
 
-class ColumnSetModeCmd : public QUndoCommand {
+class ColumnSetModeCmd : public QUndoCommand, public UndoMemory {
 public:
 	explicit ColumnSetModeCmd(ColumnPrivate* col, AbstractColumn::ColumnMode mode, QUndoCommand* parent = nullptr);
 	~ColumnSetModeCmd() override;
 
 	void redo() override;
 	void undo() override;
+	qint64 memorySize() const override;
+	void releaseMemory() override;
 
 private:
 	ColumnPrivate* m_col;
@@ -45,30 +53,36 @@ private:
 	AbstractSimpleFilter* m_old_out_filter{nullptr};
 	bool m_undone{false};
 	bool m_executed{false};
+	bool m_released{false};
 };
 
-class ColumnFullCopyCmd : public QUndoCommand {
+class ColumnFullCopyCmd : public QUndoCommand, public UndoMemory {
 public:
 	explicit ColumnFullCopyCmd(ColumnPrivate* col, const AbstractColumn* src, QUndoCommand* parent = nullptr);
 	~ColumnFullCopyCmd() override;
 
 	void redo() override;
 	void undo() override;
+	qint64 memorySize() const override;
+	void releaseMemory() override;
 
 private:
 	ColumnPrivate* m_col;
 	const AbstractColumn* m_src;
 	ColumnPrivate* m_backup{nullptr};
 	Column* m_backup_owner{nullptr};
+	bool m_released{false};
 };
 
-class ColumnPartialCopyCmd : public QUndoCommand {
+class ColumnPartialCopyCmd : public QUndoCommand, public UndoMemory {
 public:
 	explicit ColumnPartialCopyCmd(ColumnPrivate* col, const AbstractColumn* src, int src_start, int dest_start, int num_rows, QUndoCommand* parent = nullptr);
 	~ColumnPartialCopyCmd() override;
 
 	void redo() override;
 	void undo() override;
+	qint64 memorySize() const override;
+	void releaseMemory() override;
 
 private:
 	ColumnPrivate* m_col;
@@ -81,6 +95,7 @@ private:
 	int m_dest_start;
 	int m_num_rows;
 	int m_old_row_count{0};
+	bool m_released{false};
 };
 
 class ColumnInsertRowsCmd : public QUndoCommand {
@@ -95,13 +110,15 @@ private:
 	int m_before, m_count;
 };
 
-class ColumnRemoveRowsCmd : public QUndoCommand {
+class ColumnRemoveRowsCmd : public QUndoCommand, public UndoMemory {
 public:
 	explicit ColumnRemoveRowsCmd(ColumnPrivate* col, int first, int count, QUndoCommand* parent = nullptr);
 	~ColumnRemoveRowsCmd() override;
 
 	void redo() override;
 	void undo() override;
+	qint64 memorySize() const override;
+	void releaseMemory() override;
 
 private:
 	ColumnPrivate* m_col;
@@ -111,6 +128,7 @@ private:
 	ColumnPrivate* m_backup{nullptr};
 	Column* m_backup_owner{nullptr};
 	IntervalAttribute<QString> m_formulas;
+	bool m_released{false};
 };
 
 class ColumnSetPlotDesignationCmd : public QUndoCommand {
@@ -126,20 +144,23 @@ private:
 	AbstractColumn::PlotDesignation m_old_pd{AbstractColumn::PlotDesignation::X};
 };
 
-class ColumnClearCmd : public QUndoCommand {
+class ColumnClearCmd : public QUndoCommand, public UndoMemory {
 public:
 	explicit ColumnClearCmd(ColumnPrivate* col, QUndoCommand* parent = nullptr);
 	~ColumnClearCmd() override;
 
 	void redo() override;
 	void undo() override;
+	qint64 memorySize() const override;
+	void releaseMemory() override;
 
 private:
 	ColumnPrivate* m_col;
+	AbstractColumn::ColumnMode m_mode;
 	void* m_data{nullptr};
 	void* m_empty_data{nullptr};
 	bool m_undone{false};
-
+	bool m_released{false};
 };
 
 class ColumnSetGlobalFormulaCmd : public QUndoCommand {
@@ -237,8 +258,65 @@ private:
 	int m_row_count{0};
 };
 
+//! Old values of replaced rows, only the blocks of rows containing changed values are stored
+/**
+ * Replacing a range of rows with mostly unchanged values (e.g. after sorting partially sorted data
+ * or recalculating a formula depending on a few changed rows) only keeps the changed blocks for undo.
+ */
+template<typename T>
+class ColumnChangedBlocks {
+public:
+	static const int blockSize = 4096;
+
+	void save(const QVector<T>& data, int first, const QVector<T>& new_values) {
+		clear();
+		m_rows = qBound(0, data.size() - first, new_values.size());
+		for (int start = 0; start < m_rows; start += blockSize) {
+			const int count = qMin(blockSize, m_rows - start);
+			if (!equal(data.constData() + first + start, new_values.constData() + start, count, std::is_arithmetic<T>())) {
+				m_starts << start;
+				m_blocks << data.mid(first + start, count);
+			}
+		}
+	}
+
+	//! old values of the replaced rows that existed before the replacement
+	QVector<T> restore(const QVector<T>& new_values) const {
+		QVector<T> values = new_values.mid(0, m_rows);
+		for (int i = 0; i < m_starts.size(); ++i)
+			std::copy(m_blocks.at(i).constBegin(), m_blocks.at(i).constEnd(), values.begin() + m_starts.at(i));
+		return values;
+	}
+
+	qint64 memorySize() const {
+		qint64 size = 0;
+		for (const auto& block : m_blocks)
+			size += valuesMemorySize(block);
+		return size;
+	}
+
+	void clear() {
+		m_rows = 0;
+		m_starts.clear();
+		m_blocks.clear();
+	}
+
+private:
+	// compare the bits of numeric values, NaN and -0 are restored exactly
+	static bool equal(const T* a, const T* b, int count, std::true_type) {
+		return std::memcmp(a, b, count * sizeof(T)) == 0;
+	}
+	static bool equal(const T* a, const T* b, int count, std::false_type) {
+		return std::equal(a, a + count, b);
+	}
+
+	int m_rows{0};
+	QVector<int> m_starts;
+	QVector<QVector<T>> m_blocks;
+};
+
 template<typename T>
-class ColumnReplaceCmd : public QUndoCommand {
+class ColumnReplaceCmd : public QUndoCommand, public UndoMemory {
 public:
 	/**
 	 * \var ColumnReplaceTextsCmd::m_col
@@ -257,7 +335,12 @@ public:
 
 	/**
 	 * \var ColumnReplaceTextsCmd::m_old_values
-	 * \brief The old values
+	 * \brief The old values when all values are replaced
+	 */
+
+	/**
+	 * \var ColumnReplaceTextsCmd::m_old_blocks
+	 * \brief The changed blocks of old values when a range of rows is replaced
 	 */
 
 	/**
@@ -277,19 +360,46 @@ public:
 			setText(i18n("%1: replace the values for rows %2 to %3", col->name(), first, first + new_values.count() - 1));
 	}
 
+	// the data of a released command was discarded, the undo history is reverted to the first command not released
 	void redo() override {
+		if (m_released) {
+			DEBUG(Q_FUNC_INFO << ", the data of the command was released, not redoing it")
+			return;
+		}
 		if (!m_copied) {
+			const auto* data = static_cast<QVector<T>*>(m_col->data());
 			if (m_first < 0)
-				m_old_values = *static_cast<QVector<T>*>(m_col->data());
+				m_old_values = *data;	// implicitly shared, the column gets the new values
 			else
-				m_old_values = static_cast<QVector<T>*>(m_col->data())->mid(m_first, m_new_values.count());
+				m_old_blocks.save(*data, m_first, m_new_values);
 			m_row_count = m_col->rowCount();
 			m_copied = true;
 		}
 		m_col->replaceValues(m_first, m_new_values);
 	}
 	void undo() override {
-		m_col->replaceValues(m_first, m_old_values);
+		if (m_released) {
+			DEBUG(Q_FUNC_INFO << ", the data of the command was released, not undoing it")
+			return;
+		}
+		if (m_first < 0)
+			m_col->replaceValues(m_first, m_old_values);
+		else
+			m_col->replaceValues(m_first, m_old_blocks.restore(m_new_values));
+	}
+
+	qint64 memorySize() const override {
+		// when all values are replaced, the new values are shared with the column
+		qint64 size = valuesMemorySize(m_old_values) + m_old_blocks.memorySize();
+		if (m_first >= 0)
+			size += valuesMemorySize(m_new_values);
+		return size;
+	}
+	void releaseMemory() override {
+		m_new_values = QVector<T>();
+		m_old_values = QVector<T>();
+		m_old_blocks.clear();
+		m_released = true;
 	}
 
 private:
@@ -297,7 +407,9 @@ private:
 	int m_first;
 	QVector<T> m_new_values;
 	QVector<T> m_old_values;
+	ColumnChangedBlocks<T> m_old_blocks;
 	bool m_copied{false};
+	bool m_released{false};
 	int m_row_count{0};
 };
 
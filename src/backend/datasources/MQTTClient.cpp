@@ -856,7 +856,7 @@ QString MQTTClient::statistics(const MQTTTopic* topic) const {
 				statistics += QLatin1String("Contraharmonic mean: ") + QString::number(col->statistics().contraharmonicMean) + "\n";
 				break;
 			case MQTTClient::WillStatisticsType::Entropy:
-				statistics += QLatin1String("Entropy: ") + QString::number(col->statistics().entropy) + "\n";
+				statistics += QLatin1String("Entropy: ") + QString::number(col->statistics(true).entropy) + "\n";
 				break;
 			case MQTTClient::WillStatisticsType::GeometricMean:
 				statistics += QLatin1String("Geometric mean: ") + QString::number(col->statistics().geometricMean) + "\n";
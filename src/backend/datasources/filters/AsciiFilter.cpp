@@ -27,13 +27,15 @@
 #include <KLocalizedString>
 #include <KFilterDev>
 #include <QDateTime>
-
-#if defined(Q_OS_LINUX) || defined(Q_OS_BSD4)
-#include <QProcess>
-#include <QStandardPaths>
-#endif
-
+#include <QFile>
 #include <QRegularExpression>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 /*!
 \class AsciiFilter
@@ -206,20 +208,20 @@ size_t AsciiFilter::lineNumber(const QString& fileName) {
 // 		return -1;
 
 	size_t lineCount = 0;
-#if defined(Q_OS_LINUX) || defined(Q_OS_BSD4)
-	//on linux and BSD use wc, if available, which is much faster than counting lines in the file
-	if (device.compressionType() == KCompressionDevice::None && !QStandardPaths::findExecutable(QLatin1String("wc")).isEmpty()) {
-		QProcess wc;
-		wc.start(QLatin1String("wc"), QStringList() << QLatin1String("-l") << fileName);
-		size_t lineCount = 0;
-		while (wc.waitForReadyRead()) {
-			QString line(wc.readLine());
-			// wc on macOS has leading spaces: use SkipEmptyParts
-			lineCount = line.split(' ', QString::SkipEmptyParts)[0].toInt();
-		}
-		return lineCount;
+	// uncompressed files are mapped into memory and the line breaks are counted directly
+	if (device.compressionType() == KCompressionDevice::None) {
+		QFile file(fileName);
+		if (file.open(QIODevice::ReadOnly) && file.size() > 0) {
+			const qint64 size = file.size();
+			const auto* data = reinterpret_cast<const char*>(file.map(0, size));
+			if (data) {
+				lineCount = std::count(data, data + size, '\n');
+				if (data[size - 1] != '\n')	// last line without line break
+					lineCount++;
+				return lineCount;
+			}
+		}
 	}
-#endif
 
 	while (!device.atEnd()) {
 		device.readLine();
@@ -419,6 +421,8 @@ int AsciiFilterPrivate::prepareDeviceToRead(QIODevice& device) {
 	if (!device.open(QIODevice::ReadOnly))
 		return -1;
 
+	m_dateTimeParser.setFormat(dateTimeFormat);
+
 	if (device.atEnd() && !device.isSequential()) // empty file
 		return 1;
 
@@ -667,7 +671,7 @@ void AsciiFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataS
 //	      << dataSource << ", mode = " << ENUM_TO_STRING(AbstractFileFilter, ImportMode, importMode));
 
 	//dirty hack: set readingFile and readingFileName in order to know in lineNumber(QIODevice)
-	//that we're reading from a file and to benefit from much faster wc on linux
+	//and in readDataFromDevice() that we're reading from a file that can be mapped into memory
 	//TODO: redesign the APIs and remove this later
 	readingFile = true;
 	readingFileName = fileName;
@@ -871,6 +875,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 	const int spreadsheetRowCountBeforeResize = spreadsheet->rowCount();
 
 	int currentRow = 0; // indexes the position in the vector(column)
+	int firstChangedRow = 0; // rows before were not changed (only appending new rows)
 	int linesToRead = 0;
 	int keepNValues = spreadsheet->keepNValues();
 
@@ -946,6 +951,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 			else
 				currentRow = spreadsheetRowCountBeforeResize;
 		}
+		firstChangedRow = currentRow;
 
 		// if we have fixed size, we do this only once in preparation, here we can use
 		// m_prepared and we need something to decide whether it has a fixed size or increasing
@@ -983,50 +989,11 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 			for (int col = 0; col < m_actualCols; ++col)
 				spreadsheet->child<Column>(col)->setSuppressDataChangedSignal(false);
 
-			for (int row = 0; row < linesToRead; ++row) {
-				for (int col = 0; col < m_actualCols; ++col) {
-					switch (columnModes[col]) {
-					case AbstractColumn::ColumnMode::Double: {
-						auto* vector = static_cast<QVector<double>* >(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					case AbstractColumn::ColumnMode::Integer: {
-						auto* vector = static_cast<QVector<int>* >(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					case AbstractColumn::ColumnMode::BigInt: {
-						auto* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					case AbstractColumn::ColumnMode::Text: {
-						auto* vector = static_cast<QVector<QString>*>(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					case AbstractColumn::ColumnMode::DateTime: {
-						auto* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					//TODO
-					case AbstractColumn::ColumnMode::Month:
-					case AbstractColumn::ColumnMode::Day:
-						break;
-					}
-				}
+			// drop the oldest values of all columns at once for the new lines
+			for (int col = 0; col < m_actualCols; ++col) {
+				auto* column = spreadsheet->child<Column>(col);
+				column->shiftRows(linesToRead);
+				m_dataContainer[col] = column->data();
 			}
 		}
 	}
@@ -1115,7 +1082,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 
 			//add current timestamp if required
 			if (createTimestampEnabled) {
-				static_cast<QVector<QDateTime>*>(m_dataContainer[offset])->operator[](currentRow) = QDateTime::currentDateTime();
+				static_cast<QVector<qint64>*>(m_dataContainer[offset])->operator[](currentRow) = QDateTime::currentMSecsSinceEpoch();
 				++offset;
 			}
 
@@ -1145,7 +1112,7 @@ qint64 AsciiFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSou
 			plot->setSuppressRetransform(true);
 
 		for (int n = 0; n < m_actualCols; ++n)
-			spreadsheet->column(n)->setChanged();
+			spreadsheet->column(n)->setChanged(firstChangedRow);
 
 		//retransform the dependent plots
 		for (auto* plot : plots) {
@@ -1192,7 +1159,6 @@ void AsciiFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSourc
 	DEBUG("locale = " << STDSTRING(QLocale::languageToString(numberFormat)));
 
 	// Read the data
-	int currentRow = 0;	// indexes the position in the vector(column)
 	if (lines == -1)
 		lines = m_actualRows;
 
@@ -1206,49 +1172,51 @@ void AsciiFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSourc
 	if (qMin(lines, m_actualRows) == 0 || m_actualCols == 0)
 		return;
 
-	QString line;
-	QString valueString;
-	//Don't put the definition QStringList lineStringList outside of the for-loop,
-	//the compiler doesn't seem to optimize the destructor of QList well enough in this case.
-
 	lines = qMin(lines, m_actualRows);
-	int progressIndex = 0;
-	const qreal progressInterval = 0.01*lines; //update on every 1% only
 
-	for (int i = 0; i < lines; ++i) {
-		line = device.readLine();
+	// uncompressed files are mapped into memory and read in parallel, other devices line by line
+	m_separatorBytes = m_separator.toUtf8();
+	m_commentBytes = commentCharacter.toUtf8();
+	int currentRow = readDataParallel(device, lines);
+	if (currentRow == -1)
+		currentRow = readDataSequential(device, lines);
 
-		// remove any newline
-		line.remove(QLatin1Char('\n'));
-		line.remove(QLatin1Char('\r'));
+	DEBUG(Q_FUNC_INFO <<", Read " << currentRow << " lines");
 
-		if (removeQuotesEnabled)
-			line.remove(QLatin1Char('"'));
+	//we might have skipped empty lines above. shrink the spreadsheet if the number of read lines (=currentRow)
+	//is smaller than the initial size of the spreadsheet (=m_actualRows).
+	//TODO: should also be relevant for Matrix
+	auto* s = dynamic_cast<Spreadsheet*>(dataSource);
+	if (s && currentRow != m_actualRows && importMode == AbstractFileFilter::ImportMode::Replace)
+		s->setRowCount(currentRow);
 
-		if (line.isEmpty() || (!commentCharacter.isEmpty() && line.startsWith(commentCharacter))) // skip empty or commented lines
-			continue;
+	Q_ASSERT(dataSource);
+	dataSource->finalizeImport(m_columnOffset, startColumn, startColumn + m_actualCols - 1, dateTimeFormat, importMode);
+}
 
-		QStringList lineStringList = line.split(m_separator, (QString::SplitBehavior)skipEmptyParts);
-// 		DEBUG("	Line bytes: " << line.size() << " line: " << STDSTRING(line));
+/*!
+ * reads \c lines lines from \c device line by line into the data containers.
+ * Returns the number of rows read.
+ */
+int AsciiFilterPrivate::readDataSequential(QIODevice& device, int lines) {
+	const int tokenCount = m_actualCols + startColumn - 1 - (int)createIndexEnabled; // number of fields needed per line
+	QByteArray line;
+	QByteArray buffer;
+	std::vector<Token> tokens;
+	tokens.reserve(tokenCount);
 
-		if (simplifyWhitespacesEnabled) {
-			for (int i = 0; i < lineStringList.size(); ++i)
-				lineStringList[i] = lineStringList[i].simplified();
-		}
+	int currentRow = 0;	// indexes the position in the vector(column)
+	int progressIndex = 0;
+	const qreal progressInterval = 0.01*lines; //update on every 1% only
 
-		// remove left white spaces
-		if (skipEmptyParts) {
-			for (int n = 0; n < lineStringList.size(); ++n) {
-				valueString = lineStringList.at(n);
-				if (!QString::compare(valueString, " ")) {
-					lineStringList.removeAt(n);
-					n--;
-				}
-			}
-		}
+	for (int i = 0; i < lines; ++i) {
+		line = device.readLine();
+
+		// skip empty or commented lines
+		if (!splitLine(line.constData(), line.constData() + line.size(), tokenCount, buffer, tokens))
+			continue;
 
 		//parse columns
-		DEBUG(Q_FUNC_INFO << ", actual cols = " << m_actualCols)
 		for (int n = 0; n < m_actualCols; ++n) {
 			// index column if required
 			if (n == 0 && createIndexEnabled) {
@@ -1259,8 +1227,11 @@ void AsciiFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSourc
 			//column counting starts with 1, subtract 1 as well as another 1 for the index column if required
 			int col = createIndexEnabled ? n + startColumn - 2: n + startColumn - 1;
 			QString valueString;
-			if (col < lineStringList.size())
-				valueString = lineStringList.at(col);
+			if (col < (int)tokens.size()) {
+				valueString = QString::fromUtf8(tokens.at(col).first, tokens.at(col).second - tokens.at(col).first);
+				if (simplifyWhitespacesEnabled)
+					valueString = valueString.simplified();
+			}
 
 			setValue(n, currentRow, valueString);
 		}
@@ -1276,19 +1247,437 @@ void AsciiFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSourc
 		}
 	}
 
-	DEBUG(Q_FUNC_INFO <<", Read " << currentRow << " lines");
+	return currentRow;
+}
 
-	//we might have skipped empty lines above. shrink the spreadsheet if the number of read lines (=currentRow)
-	//is smaller than the initial size of the spreadsheet (=m_actualRows).
-	//TODO: should also be relevant for Matrix
-	auto* s = dynamic_cast<Spreadsheet*>(dataSource);
-	if (s && currentRow != m_actualRows && importMode == AbstractFileFilter::ImportMode::Replace)
-		s->setRowCount(currentRow);
+/*!
+ * splits the line \c begin .. \c end into at most \c maxTokens fields separated by the separator and stores them in \c tokens.
+ * All line breaks and, if enabled, all quotes are removed from the line first. Lines containing such characters
+ * (apart from the line break at the end) are copied into \c buffer, the tokens are pointing into it in this case.
+ * This tokenizer is used when reading line by line and when reading in parallel, so that both give the same result.
+ * Returns \c false for empty or commented lines.
+ */
+bool AsciiFilterPrivate::splitLine(const char* begin, const char* end, int maxTokens, QByteArray& buffer, std::vector<Token>& tokens) const {
+	while (end > begin && (*(end - 1) == '\n' || *(end - 1) == '\r'))
+		--end;
+
+	if (memchr(begin, '\r', end - begin) || memchr(begin, '\n', end - begin) || (removeQuotesEnabled && memchr(begin, '"', end - begin))) {
+		buffer.resize(end - begin);
+		char* out = buffer.data();
+		for (const char* p = begin; p < end; ++p) {
+			if (*p != '\r' && *p != '\n' && !(removeQuotesEnabled && *p == '"'))
+				*out++ = *p;
+		}
+		buffer.resize(out - buffer.constData());
+		begin = buffer.constData();
+		end = begin + buffer.size();
+	}
 
-	Q_ASSERT(dataSource);
-	dataSource->finalizeImport(m_columnOffset, startColumn, startColumn + m_actualCols - 1, dateTimeFormat, importMode);
+	if (begin == end)
+		return false;
+	const int commentSize = m_commentBytes.size();
+	if (commentSize > 0 && end - begin >= commentSize && memcmp(begin, m_commentBytes.constData(), commentSize) == 0)
+		return false;
+
+	// split the line into the fields
+	tokens.clear();
+	const char* separator = m_separatorBytes.constData();
+	const int separatorSize = m_separatorBytes.size();
+	const char* p = begin;
+	while ((int)tokens.size() < maxTokens) {
+		const char* tokenEnd = end;
+		if (separatorSize == 1) {
+			const auto* sep = static_cast<const char*>(memchr(p, *separator, end - p));
+			if (sep)
+				tokenEnd = sep;
+		} else if (separatorSize > 1)
+			tokenEnd = std::search(p, end, separator, separator + separatorSize);
+
+		// white spaces left of the values are removed as empty parts if the whitespaces are not simplified
+		const bool empty = (tokenEnd == p || (!simplifyWhitespacesEnabled && tokenEnd - p == 1 && *p == ' '));
+		if (!skipEmptyParts || !empty)
+			tokens.push_back(std::make_pair(p, tokenEnd));
+		if (tokenEnd == end)
+			break;
+		p = tokenEnd + separatorSize;
+	}
+
+	return true;
+}
+
+// minimal number of bytes read in one task when reading a file in parallel
+static const qint64 readChunkSize = 1 << 22;
+
+// powers of ten that are exactly representable as double
+static const double exactPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static inline bool isBlank(char c) {
+	return c == ' ' || c == '\t';
+}
+
+/*!
+ * parses the number in the bytes \c begin .. \c end using \c decimalPoint as the decimal separator.
+ * Only plain numbers with up to 19 significant digits whose value can be calculated exactly
+ * (mantissa < 2^53, decimal exponent <= 22) are handled. Returns \c false for all other strings
+ * (group separators, inf, nan, ...) which have to be converted with QLocale.
+ */
+static bool parseDouble(const char* begin, const char* end, char decimalPoint, double& value) {
+	while (begin < end && isBlank(*begin))
+		++begin;
+	while (end > begin && isBlank(*(end - 1)))
+		--end;
+
+	const char* p = begin;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+		negative = (*p++ == '-');
+
+	quint64 mantissa = 0;
+	int digits = 0, significantDigits = 0, exponent = 0;
+	for (; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+		if (mantissa == 0 && *p == '0')
+			continue;
+		if (++significantDigits > 19)
+			return false;
+		mantissa = 10 * mantissa + (*p - '0');
+	}
+	if (p < end && *p == decimalPoint) {
+		for (++p; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+			--exponent;
+			if (mantissa == 0 && *p == '0')
+				continue;
+			if (++significantDigits > 19)
+				return false;
+			mantissa = 10 * mantissa + (*p - '0');
+		}
+	}
+	if (digits == 0)
+		return false;
+
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		++p;
+		bool negativeExponent = false;
+		if (p < end && (*p == '-' || *p == '+'))
+			negativeExponent = (*p++ == '-');
+		if (p == end)
+			return false;
+		int e = 0;
+		for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+			if (e < 10000)
+				e = 10 * e + (*p - '0');
+		}
+		exponent += negativeExponent ? -e : e;
+	}
+	if (p != end)
+		return false;
+
+	if (mantissa == 0)
+		value = 0.;
+	else if (mantissa > (quint64(1) << 53) || exponent < -22 || exponent > 22)
+		return false;
+	else if (exponent < 0)
+		value = mantissa / exactPowersOfTen[-exponent];
+	else
+		value = mantissa * exactPowersOfTen[exponent];
+
+	if (negative)
+		value = -value;
+	return true;
+}
+
+/*!
+ * parses the integer in the bytes \c begin .. \c end.
+ * Returns \c false if the string is not a plain integer in the range of qint64.
+ */
+static bool parseInteger(const char* begin, const char* end, qint64& value) {
+	while (begin < end && isBlank(*begin))
+		++begin;
+	while (end > begin && isBlank(*(end - 1)))
+		--end;
+
+	const char* p = begin;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+		negative = (*p++ == '-');
+	if (p == end || end - p > 18)	// longer numbers are left to QLocale
+		return false;
+
+	qint64 result = 0;
+	for (; p < end; ++p) {
+		if (*p < '0' || *p > '9')
+			return false;
+		result = 10 * result + (*p - '0');
+	}
+
+	value = negative ? -result : result;
+	return true;
+}
+
+/* task counting or reading the lines of a chunk of a file mapped into memory */
+class AsciiChunkTask : public QRunnable {
+public:
+	AsciiChunkTask(AsciiFilterPrivate* filter, AsciiFilterPrivate::Chunk& chunk, bool read, QSemaphore& done)
+		: m_filter(filter), m_chunk(chunk), m_read(read), m_done(done) {
+	}
+
+	void run() override {
+		if (m_read)
+			m_filter->readChunk(m_chunk);
+		else
+			m_filter->countChunk(m_chunk);
+		m_done.release();
+	}
+
+private:
+	AsciiFilterPrivate* m_filter;
+	AsciiFilterPrivate::Chunk& m_chunk;
+	bool m_read;
+	QSemaphore& m_done;
+};
+
+/*!
+ * returns the end of the line starting at \c begin (including the line break) and sets \c next to the begin of the next line
+ */
+static inline const char* lineEnd(const char* begin, const char* end, const char*& next) {
+	const auto* newline = static_cast<const char*>(memchr(begin, '\n', end - begin));
+	next = newline ? newline + 1 : end;
+	return next;
 }
 
+/*!
+ * counts the lines and the data lines in \c chunk.
+ */
+void AsciiFilterPrivate::countChunk(Chunk& chunk) const {
+	QByteArray buffer;
+	std::vector<Token> tokens;
+	chunk.lines = 0;
+	chunk.rows = 0;
+	const char* next;
+	for (const char* line = chunk.begin; line < chunk.end; line = next) {
+		const char* end = lineEnd(line, chunk.end, next);
+		++chunk.lines;
+		if (splitLine(line, end, 0, buffer, tokens))
+			++chunk.rows;
+	}
+}
+
+/*!
+ * reads at most \c chunk.maxLines lines of \c chunk into the data containers starting at the row \c chunk.firstRow.
+ * Sets \c chunk.rows to the number of rows read.
+ */
+void AsciiFilterPrivate::readChunk(Chunk& chunk) {
+	const int tokenCount = m_actualCols + startColumn - 1 - (int)createIndexEnabled; // number of fields needed per line
+	QByteArray buffer;
+	std::vector<Token> tokens;
+	tokens.reserve(tokenCount);
+
+	int row = chunk.firstRow;
+	int lineIndex = 0;
+	const char* next;
+	for (const char* line = chunk.begin; line < chunk.end && lineIndex < chunk.maxLines; line = next, ++lineIndex) {
+		const char* end = lineEnd(line, chunk.end, next);
+		if (!splitLine(line, end, tokenCount, buffer, tokens))
+			continue;
+
+		for (int n = 0; n < m_actualCols; ++n) {
+			// index column if required
+			if (n == 0 && createIndexEnabled) {
+				static_cast<int*>(m_columnData[0])[row] = chunk.firstLine + lineIndex + 1;
+				continue;
+			}
+
+			//column counting starts with 1, subtract 1 as well as another 1 for the index column if required
+			const int col = createIndexEnabled ? n + startColumn - 2 : n + startColumn - 1;
+			if (col < (int)tokens.size())
+				setValue(n, row, tokens.at(col).first, tokens.at(col).second);
+			else
+				setValue(n, row, nullptr, nullptr);
+		}
+		++row;
+	}
+
+	chunk.rows = row - chunk.firstRow;
+}
+
+/*!
+ * reads \c lines lines of the file the device \c device is reading from (starting at the current position of the device)
+ * into the data containers. The file is mapped into memory, split into newline aligned chunks and the chunks are parsed in parallel.
+ * Returns the number of rows read or -1 if the device cannot be read this way.
+ */
+int AsciiFilterPrivate::readDataParallel(QIODevice& device, int lines) {
+	const auto* filterDevice = dynamic_cast<KCompressionDevice*>(&device);
+	if (!readingFile || !filterDevice || filterDevice->compressionType() != KCompressionDevice::None || device.isSequential())
+		return -1;
+	// the timestamp column is only supported when reading line by line
+	if (createTimestampEnabled)
+		return -1;
+
+	QFile file(readingFileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return -1;
+	const qint64 offset = device.pos();
+	const qint64 size = file.size() - offset;
+	if (size <= 0)
+		return -1;
+	const auto* data = reinterpret_cast<const char*>(file.map(offset, size));
+	if (!data)
+		return -1;
+	PERFTRACE(Q_FUNC_INFO + QLatin1String(", bytes ") + QString::number(size));
+
+	// numbers are parsed without QLocale if the locale uses ASCII characters for the decimal point and the minus sign
+	const QChar decimalPoint = locale.decimalPoint();
+	m_decimalPoint = (decimalPoint.unicode() < 128 && locale.negativeSign() == QLatin1Char('-')) ? decimalPoint.toLatin1() : 0;
+
+	// raw pointers to the data of the containers, the containers must not be detached in the tasks
+	m_columnData.resize(m_actualCols);
+	for (int n = 0; n < m_actualCols; ++n) {
+		switch (columnModes.at(n)) {
+		case AbstractColumn::ColumnMode::Double:
+			m_columnData[n] = static_cast<QVector<double>*>(m_dataContainer[n])->data();
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			m_columnData[n] = static_cast<QVector<int>*>(m_dataContainer[n])->data();
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			m_columnData[n] = static_cast<QVector<qint64>*>(m_dataContainer[n])->data();
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+			m_columnData[n] = static_cast<QVector<qint64>*>(m_dataContainer[n])->data();
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			m_columnData[n] = static_cast<QVector<QString>*>(m_dataContainer[n])->data();
+			break;
+		case AbstractColumn::ColumnMode::Month:	// never happens
+		case AbstractColumn::ColumnMode::Day:
+			m_columnData[n] = nullptr;
+			break;
+		}
+	}
+
+	// split the data into newline aligned chunks
+	const char* const end = data + size;
+	const qint64 chunkCount = qMax((qint64)1, size / readChunkSize);
+	QVector<Chunk> chunks;
+	const char* begin = data;
+	for (qint64 i = 1; i <= chunkCount && begin < end; ++i) {
+		const char* chunkEnd = end;
+		if (i < chunkCount) {
+			const char* start = qMax(begin, data + i * (size / chunkCount));
+			const auto* newline = static_cast<const char*>(memchr(start, '\n', end - start));
+			chunkEnd = newline ? newline + 1 : end;
+		}
+		Chunk chunk;
+		chunk.begin = begin;
+		chunk.end = chunkEnd;
+		chunks << chunk;
+		begin = chunkEnd;
+	}
+
+	// the tasks write into the containers of the columns, no events are processed until all tasks are finished
+	// (the spreadsheet must not be painted, modified or deleted while its data is written in the other threads)
+	QThreadPool* pool = QThreadPool::globalInstance();
+	auto runChunks = [&](bool read) {
+		QSemaphore done;
+		for (auto& chunk : chunks)
+			pool->start(new AsciiChunkTask(this, chunk, read, done));
+		while (!done.tryAcquire(chunks.size(), 100)) {
+			if (read)
+				Q_EMIT q->completed(100 * done.available() / chunks.size());
+		}
+	};
+
+	// count the lines in each chunk to determine the rows the chunks are read into
+	runChunks(false);
+	int firstLine = 0, firstRow = 0;
+	for (int i = 0; i < chunks.size(); ++i) {
+		auto& chunk = chunks[i];
+		if (firstLine >= lines) {	// requested number of lines reached
+			chunks.resize(i);
+			break;
+		}
+		chunk.firstLine = firstLine;
+		chunk.firstRow = firstRow;
+		chunk.maxLines = lines - firstLine;
+		firstLine += chunk.lines;
+		firstRow += chunk.rows;
+	}
+
+	// read the chunks
+	runChunks(true);
+	int rows = 0;
+	for (const auto& chunk : chunks)
+		rows += chunk.rows;
+
+	m_columnData.clear();
+	file.unmap(const_cast<uchar*>(reinterpret_cast<const uchar*>(data)));
+
+	return rows;
+}
+
+/*!
+ * sets the value of the column \c col in the row \c row to the value given by the UTF-8 bytes \c begin .. \c end.
+ * Used when reading in parallel, the value is written directly into the data of the container.
+ */
+void AsciiFilterPrivate::setValue(int col, int row, const char* begin, const char* end) {
+	switch (columnModes.at(col)) {
+	case AbstractColumn::ColumnMode::Double: {
+		double value;
+		if (!m_decimalPoint || !parseDouble(begin, end, m_decimalPoint, value)) {
+			bool isNumber;
+			value = locale.toDouble(QString::fromUtf8(begin, end - begin), &isNumber);
+			if (!isNumber)
+				value = nanValue;
+		}
+		static_cast<double*>(m_columnData[col])[row] = value;
+		break;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		qint64 value;
+		if (!m_decimalPoint || !parseInteger(begin, end, value) || value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+			bool isNumber;
+			value = locale.toInt(QString::fromUtf8(begin, end - begin), &isNumber);
+			if (!isNumber)
+				value = 0;
+		}
+		static_cast<int*>(m_columnData[col])[row] = (int)value;
+		break;
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		qint64 value;
+		if (!m_decimalPoint || !parseInteger(begin, end, value)) {
+			bool isNumber;
+			value = locale.toLongLong(QString::fromUtf8(begin, end - begin), &isNumber);
+			if (!isNumber)
+				value = 0;
+		}
+		static_cast<qint64*>(m_columnData[col])[row] = value;
+		break;
+	}
+	case AbstractColumn::ColumnMode::DateTime: {
+		// the compiled format is used directly, QDateTime::fromString() only if the string doesn't match
+		qint64 value;
+		if (!m_dateTimeParser.parse(begin, end, value)) {
+			QString valueString = QString::fromUtf8(begin, end - begin);
+			if (simplifyWhitespacesEnabled)
+				valueString = valueString.simplified();
+			value = valueString.isEmpty() ? Column::invalidDateTime() : Column::dateTimeToMSecs(parseDateTime(valueString, dateTimeFormat));
+		}
+		static_cast<qint64*>(m_columnData[col])[row] = value;
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text: {
+		QString valueString = QString::fromUtf8(begin, end - begin);
+		if (simplifyWhitespacesEnabled)
+			valueString = valueString.simplified();
+		static_cast<QString*>(m_columnData[col])[row] = valueString;
+		break;
+	}
+	case AbstractColumn::ColumnMode::Month:	// never happens
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+}
 //#####################################################################
 //############################ Preview ################################
 //#####################################################################
@@ -1420,7 +1809,7 @@ QVector<QStringList> AsciiFilterPrivate::preview(const QString& fileName, int li
 	QVector<QStringList> dataStrings;
 
 	//dirty hack: set readingFile and readingFileName in order to know in lineNumber(QIODevice)
-	//that we're reading from a file and to benefit from much faster wc on linux
+	//that we're reading from a file that can be mapped into memory
 	//TODO: redesign the APIs and remove this later
 	readingFile = true;
 	readingFileName = fileName;
@@ -1578,8 +1967,10 @@ void AsciiFilterPrivate::setValue(int col, int row, const QString& valueString)
 			break;
 		}
 		case AbstractColumn::ColumnMode::DateTime: {
-			QDateTime valueDateTime = parseDateTime(valueString, dateTimeFormat);
-			static_cast<QVector<QDateTime>*>(m_dataContainer[col])->operator[](row) = valueDateTime.isValid() ? valueDateTime : QDateTime();
+			qint64 value;
+			if (!m_dateTimeParser.parse(valueString, value))
+				value = Column::dateTimeToMSecs(parseDateTime(valueString, dateTimeFormat));
+			static_cast<QVector<qint64>*>(m_dataContainer[col])->operator[](row) = value;
 			break;
 		}
 		case AbstractColumn::ColumnMode::Text: {
@@ -1603,7 +1994,7 @@ void AsciiFilterPrivate::setValue(int col, int row, const QString& valueString)
 			static_cast<QVector<qint64>*>(m_dataContainer[col])->operator[](row) = 0;
 			break;
 		case AbstractColumn::ColumnMode::DateTime:
-			static_cast<QVector<QDateTime>*>(m_dataContainer[col])->operator[](row) = QDateTime();
+			static_cast<QVector<qint64>*>(m_dataContainer[col])->operator[](row) = Column::invalidDateTime();
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			static_cast<QVector<QString>*>(m_dataContainer[col])->operator[](row).clear();
@@ -1617,6 +2008,7 @@ void AsciiFilterPrivate::setValue(int col, int row, const QString& valueString)
 
 void AsciiFilterPrivate::initDataContainers(Spreadsheet* spreadsheet) {
 	DEBUG("	Initializing the data containers ..");
+	m_dateTimeParser.setFormat(dateTimeFormat);
 	for (int n = 0; n < m_actualCols; ++n) {
 		// data() returns a void* which is a pointer to any data type (see ColumnPrivate.cpp)
 		spreadsheet->child<Column>(n)->setColumnMode(columnModes[n]);
@@ -1647,7 +2039,7 @@ void AsciiFilterPrivate::initDataContainers(Spreadsheet* spreadsheet) {
 			break;
 		}
 		case AbstractColumn::ColumnMode::DateTime: {
-			auto* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(n)->data());
+			auto* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(n)->data());
 			vector->resize(m_actualRows);
 			m_dataContainer[n] = static_cast<void *>(vector);
 			break;
@@ -2151,15 +2543,15 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 						break;
 					}
 					case AbstractColumn::ColumnMode::DateTime: {
-						QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(n)->data());
+						QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(n)->data());
 						m_dataContainer[n] = static_cast<void *>(vector);
 
 						//if the keepNValues got smaller then we move the last keepNValues count of data
 						//in the first keepNValues places
 						if (m_actualRows > spreadsheet->mqttClient()->keepNValues()) {
 							for (int i = 0; i < spreadsheet->mqttClient()->keepNValues(); i++) {
-								static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[] (i) =
-								    static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](m_actualRows - spreadsheet->mqttClient()->keepNValues() + i);
+								static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[] (i) =
+								    static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](m_actualRows - spreadsheet->mqttClient()->keepNValues() + i);
 							}
 						}
 
@@ -2169,11 +2561,11 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 							vector->reserve( spreadsheet->mqttClient()->keepNValues());
 							vector->resize( spreadsheet->mqttClient()->keepNValues());
 							for (int i = 1; i <= m_actualRows; i++) {
-								static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[] (spreadsheet->mqttClient()->keepNValues() - i) =
-								    static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](spreadsheet->mqttClient()->keepNValues() - i - rowDiff);
+								static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[] (spreadsheet->mqttClient()->keepNValues() - i) =
+								    static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](spreadsheet->mqttClient()->keepNValues() - i - rowDiff);
 							}
 							for (int i = 0; i < rowDiff; i++)
-								static_cast<QVector<QDateTime>*>(m_dataContainer[n])->operator[](i) = QDateTime();
+								static_cast<QVector<qint64>*>(m_dataContainer[n])->operator[](i) = Column::invalidDateTime();
 						}
 						break;
 					}
@@ -2197,6 +2589,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 	qDebug()<<"starting m_actual rows calculated: " << m_actualRows <<", new data size: "<<newData.size();
 
 	int currentRow = 0; // indexes the position in the vector(column)
+	int firstChangedRow = 0; // rows before were not changed (only appending new rows)
 	int linesToRead = 0;
 
 	if (m_prepared) {
@@ -2254,6 +2647,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 			// indexes the position in the vector(column)
 			currentRow = spreadsheetRowCountBeforeResize;
 		}
+		firstChangedRow = currentRow;
 
 		// if we have fixed size, we do this only once in preparation, here we can use
 		// m_prepared and we need something to decide whether it has a fixed size or increasing
@@ -2281,55 +2675,11 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 #ifdef PERFTRACE_LIVE_IMPORT
 			PERFTRACE("AsciiLiveDataImportPopping: ");
 #endif
-			for (int row = 0; row < linesToRead; ++row) {
-				for (int col = 0;  col < m_actualCols; ++col) {
-					switch (columnModes[col]) {
-					case AbstractColumn::ColumnMode::Double: {
-						QVector<double>* vector = static_cast<QVector<double>* >(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->reserve(m_actualRows);
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					case AbstractColumn::ColumnMode::Integer: {
-						QVector<int>* vector = static_cast<QVector<int>* >(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->reserve(m_actualRows);
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					case AbstractColumn::ColumnMode::BigInt: {
-						QVector<qint64>* vector = static_cast<QVector<qint64>* >(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->reserve(m_actualRows);
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					case AbstractColumn::ColumnMode::Text: {
-						QVector<QString>* vector = static_cast<QVector<QString>*>(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->reserve(m_actualRows);
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					case AbstractColumn::ColumnMode::DateTime: {
-						QVector<QDateTime>* vector = static_cast<QVector<QDateTime>* >(spreadsheet->child<Column>(col)->data());
-						vector->pop_front();
-						vector->reserve(m_actualRows);
-						vector->resize(m_actualRows);
-						m_dataContainer[col] = static_cast<void *>(vector);
-						break;
-					}
-					//TODO
-					case AbstractColumn::ColumnMode::Month:
-					case AbstractColumn::ColumnMode::Day:
-						break;
-					}
-				}
+			// drop the oldest values of all columns at once for the new lines
+			for (int col = 0; col < m_actualCols; ++col) {
+				auto* column = spreadsheet->child<Column>(col);
+				column->shiftRows(linesToRead);
+				m_dataContainer[col] = column->data();
 			}
 		}
 	}
@@ -2385,7 +2735,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 
 			//add current timestamp if required
 			if (createTimestampEnabled) {
-				static_cast<QVector<QDateTime>*>(m_dataContainer[offset])->operator[](currentRow) = QDateTime::currentDateTime();
+				static_cast<QVector<qint64>*>(m_dataContainer[offset])->operator[](currentRow) = QDateTime::currentMSecsSinceEpoch();
 				++offset;
 			}
 
@@ -2424,7 +2774,7 @@ void AsciiFilterPrivate::readMQTTTopic(const QString& message, AbstractDataSourc
 				}
 			}
 
-			column->setChanged();
+			column->setChanged(firstChangedRow);
 		}
 
 		//loop over all affected plots and retransform them
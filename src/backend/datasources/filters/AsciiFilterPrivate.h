@@ -12,6 +12,8 @@
 #ifndef ASCIIFILTERPRIVATE_H
 #define ASCIIFILTERPRIVATE_H
 
+#include "backend/lib/DateTimeParser.h"
+
 class KFilterDev;
 class AbstractDataSource;
 class AbstractColumn;
@@ -22,6 +24,20 @@ class MQTTTopic;
 class AsciiFilterPrivate {
 
 public:
+	// newline aligned part of a file mapped into memory, read in parallel to the other chunks
+	struct Chunk {
+		const char* begin{nullptr};
+		const char* end{nullptr};
+		int lines{0};		// number of lines in the chunk (including empty and commented lines)
+		int rows{0};		// number of data lines in the chunk
+		int firstLine{0};	// index of the first line of the chunk
+		int firstRow{0};	// row in the data containers to read the first data line into
+		int maxLines{0};	// maximal number of lines to read from the chunk
+	};
+
+	// field of a line given by its UTF-8 bytes
+	typedef std::pair<const char*, const char*> Token;
+
 	explicit AsciiFilterPrivate(AsciiFilter*);
 
 	int isPrepared();
@@ -48,6 +64,10 @@ public:
 	void initDataContainers(Spreadsheet*);
 	QString previewValue(const QString&, AbstractColumn::ColumnMode);
 	void setValue(int col, int row, const QString& value);
+	void setValue(int col, int row, const char* begin, const char* end);
+	bool splitLine(const char* begin, const char* end, int maxTokens, QByteArray& buffer, std::vector<Token>& tokens) const;
+	void countChunk(Chunk&) const;
+	void readChunk(Chunk&);
 	QStringList getLineString(QIODevice&);
 
 #ifdef HAVE_MQTT
@@ -89,12 +109,20 @@ public:
 private:
 	static const unsigned int m_dataTypeLines = 10;	// maximum lines to read for determining data types
 	QString m_separator;
+	QByteArray m_separatorBytes; // UTF-8 encoded separator and comment character used by splitLine()
+	QByteArray m_commentBytes;
 	int m_actualStartRow{1};
 	int m_actualRows{0};
 	int m_actualCols{0};
 	int m_prepared{false};
 	int m_columnOffset{0}; // indexes the "start column" in the datasource. Data will be imported starting from this column.
 	std::vector<void*> m_dataContainer; // pointers to the actual data containers
+	std::vector<void*> m_columnData; // pointers to the raw (detached) data of the containers when reading in parallel
+	char m_decimalPoint{'.'}; // decimal point used when parsing numbers without QLocale, 0 if QLocale is required
+	DateTimeParser m_dateTimeParser; // compiled dateTimeFormat
+
+	int readDataSequential(QIODevice&, int lines);
+	int readDataParallel(QIODevice&, int lines);
 
 	QDateTime parseDateTime(const QString& string, const QString& format);
 };
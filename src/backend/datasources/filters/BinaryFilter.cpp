@@ -15,10 +15,15 @@
 #include "backend/lib/XmlStreamReader.h"
 
 #include <QDataStream>
+#include <QFile>
+#include <QtEndian>
 #include <KLocalizedString>
 #include <KFilterDev>
 #include <array>
 #include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
 
 /*!
 \class BinaryFilter
@@ -84,13 +89,23 @@ int BinaryFilter::dataSize(BinaryFilter::DataType type) {
 }
 
 /*!
-  returns the number of rows (length of vectors) in the file \c fileName.
+  returns the number of rows (length of vectors) in the file \c fileName after the first \c skipStartBytes bytes.
 */
-size_t BinaryFilter::rowNumber(const QString& fileName, const size_t vectors, const BinaryFilter::DataType type) {
+size_t BinaryFilter::rowNumber(const QString& fileName, const size_t vectors, const BinaryFilter::DataType type, const size_t skipStartBytes) {
 	KFilterDev device(fileName);
 	if (!device.open(QIODevice::ReadOnly))
 		return 0;
 
+	// the size of uncompressed files is known, a started row is counted as row
+	const size_t rowSize = vectors * BinaryFilter::dataSize(type);
+	if (device.compressionType() == KCompressionDevice::None && rowSize > 0) {
+		const qint64 size = QFile(fileName).size() - (qint64)skipStartBytes;
+		return (size > 0) ? (size + rowSize - 1) / rowSize : 0;
+	}
+
+	if (skipStartBytes > 0 && !device.seek(skipStartBytes))
+		return 0;
+
 	size_t rows = 0;
 	while (!device.atEnd()) {
 		// one row
@@ -209,7 +224,11 @@ void BinaryFilterPrivate::readDataFromFile(const QString& fileName, AbstractData
 	DEBUG("readDataFromFile()");
 
 	KFilterDev device(fileName);
-	numRows = BinaryFilter::rowNumber(fileName, vectors, dataType);
+	numRows = BinaryFilter::rowNumber(fileName, vectors, dataType, skipStartBytes);
+
+	// uncompressed files are mapped into memory and read directly into the columns
+	if (device.compressionType() == KCompressionDevice::None && readDataFromMappedFile(fileName, dataSource, importMode))
+		return;
 
 	if (! device.open(QIODevice::ReadOnly)) {
 		DEBUG("	could not open file " << STDSTRING(fileName));
@@ -219,36 +238,18 @@ void BinaryFilterPrivate::readDataFromFile(const QString& fileName, AbstractData
 }
 
 /*!
- * returns 1 if the current read position in the device is at the end and 0 otherwise.
+ * determines the range of rows to read. Returns 1 if the selected range is not in the file and 0 otherwise.
  */
-int BinaryFilterPrivate::prepareStreamToRead(QDataStream& in) {
-	DEBUG("prepareStreamToRead()");
-
-	in.setByteOrder(byteOrder);
-
-	// catch case that skipStartBytes or startRow is bigger than file
-	if (skipStartBytes >= BinaryFilter::dataSize(dataType) * vectors * numRows || startRow > (int)numRows)
+int BinaryFilterPrivate::prepareRange() {
+	// catch case that skipStartBytes or startRow is bigger than file (numRows counts the rows after the skipped bytes)
+	if (numRows == 0 || startRow > (int)numRows)
 		return 1;
 
-	// skip bytes at start
-	for (size_t i = 0; i < skipStartBytes; ++i) {
-		qint8 tmp;
-		in >> tmp;
-	}
-
-	// skip until start row
-	for (size_t i = 0; i < (startRow-1) * vectors; ++i) {
-		for (int j = 0; j < BinaryFilter::dataSize(dataType); ++j) {
-			qint8 tmp;
-			in >> tmp;
-		}
-	}
-
 	// set range of rows
 	if (endRow == -1)
 		m_actualRows = (int)numRows - startRow + 1;
 	else if (endRow > (int)numRows - startRow + 1)
-		m_actualRows = (int)numRows;
+		m_actualRows = (int)numRows - startRow + 1;
 	else
 		m_actualRows = endRow - startRow + 1;
 	m_actualCols = (int)vectors;
@@ -261,6 +262,36 @@ int BinaryFilterPrivate::prepareStreamToRead(QDataStream& in) {
 	return 0;
 }
 
+/*!
+ * returns the position of the first value to read in the file
+ */
+qint64 BinaryFilterPrivate::startPosition() const {
+	return skipStartBytes + (qint64)(qMax(startRow, 1) - 1) * vectors * BinaryFilter::dataSize(dataType);
+}
+
+/*!
+ * returns 1 if the current read position in the device is at the end and 0 otherwise.
+ */
+int BinaryFilterPrivate::prepareStreamToRead(QDataStream& in) {
+	DEBUG("prepareStreamToRead()");
+
+	in.setByteOrder(byteOrder);
+
+	if (prepareRange())
+		return 1;
+
+	// skip bytes at start and until start row
+	qint64 skip = startPosition();
+	while (skip > 0) {
+		const int bytes = (int)qMin(skip, (qint64)std::numeric_limits<int>::max());
+		if (in.skipRawData(bytes) != bytes)
+			break;
+		skip -= bytes;
+	}
+
+	return 0;
+}
+
 /*!
     reads \c lines lines of the device \c device and return as string for preview.
 */
@@ -272,7 +303,7 @@ QVector<QStringList> BinaryFilterPrivate::preview(const QString& fileName, int l
 	if (! device.open(QIODevice::ReadOnly))
 		return dataStrings << (QStringList() << i18n("could not open device"));
 
-	numRows = BinaryFilter::rowNumber(fileName, vectors, dataType);
+	numRows = BinaryFilter::rowNumber(fileName, vectors, dataType, skipStartBytes);
 
 	QDataStream in(&device);
 	const int deviceError = prepareStreamToRead(in);
@@ -497,6 +528,171 @@ void BinaryFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSour
 	dataSource->finalizeImport(columnOffset, 1, m_actualCols, QString(), importMode);
 }
 
+namespace {
+//! unsigned integer type with the size of the data type used to swap the bytes of a value
+template<size_t size> struct SwapType;
+template<> struct SwapType<1> { typedef quint8 type; };
+template<> struct SwapType<2> { typedef quint16 type; };
+template<> struct SwapType<4> { typedef quint32 type; };
+template<> struct SwapType<8> { typedef quint64 type; };
+
+template<typename T, bool swap>
+inline double loadValue(const uchar* data) {
+	typename SwapType<sizeof(T)>::type bits;
+	memcpy(&bits, data, sizeof(T));
+	if (swap)
+		bits = qbswap(bits);
+	T value;
+	memcpy(&value, &bits, sizeof(T));
+	return value;
+}
+
+/*!
+ * copies the values of the rows \c first to \c last (excluded) of all vectors from the memory \c data to the \c columns.
+ * The byte order is swapped at compile time to allow the compiler to vectorize the strided loads.
+ */
+template<typename T, bool swap>
+void gatherValues(const uchar* data, size_t vectors, const std::vector<double*>& columns, int first, int last) {
+	const size_t rowSize = vectors * sizeof(T);
+
+	// contiguous values of a single vector
+	if (vectors == 1 && !swap && std::is_same<T, double>::value) {
+		memcpy(columns[0] + first, data + first * rowSize, (last - first) * sizeof(T));
+		return;
+	}
+
+	for (size_t n = 0; n < vectors; ++n) {
+		double* column = columns[n];
+		const uchar* value = data + first * rowSize + n * sizeof(T);
+		for (int i = first; i < last; ++i, value += rowSize)
+			column[i] = loadValue<T, swap>(value);
+	}
+}
+
+template<typename T>
+void readValues(const uchar* data, qint64 size, size_t vectors, bool swap, const std::vector<double*>& columns, int first, int last) {
+	// values of complete rows
+	const int completeRows = qMin((qint64)last, size / (qint64)(vectors * sizeof(T)));
+	if (first < completeRows) {
+		if (swap)
+			gatherValues<T, true>(data, vectors, columns, first, completeRows);
+		else
+			gatherValues<T, false>(data, vectors, columns, first, completeRows);
+	}
+
+	// values after the end of the file are set to zero like when reading them from the stream
+	for (int i = qMax(first, completeRows); i < last; ++i) {
+		for (size_t n = 0; n < vectors; ++n) {
+			const qint64 pos = (qint64)(i * vectors + n) * sizeof(T);
+			if (pos + (qint64)sizeof(T) <= size)
+				columns[n][i] = swap ? loadValue<T, true>(data + pos) : loadValue<T, false>(data + pos);
+			else
+				columns[n][i] = 0;
+		}
+	}
+}
+}
+
+/*!
+    reads the content of the uncompressed file \c fileName to the data source \c dataSource.
+    The selected rows of the file are mapped into memory and the values are copied directly into the columns.
+    Returns \c false if the file could not be mapped.
+*/
+bool BinaryFilterPrivate::readDataFromMappedFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
+	DEBUG(Q_FUNC_INFO);
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly))
+		return false;
+
+	if (prepareRange()) {
+		dataSource->clear();
+		DEBUG("device error");
+		return true;
+	}
+
+	// map only the selected rows
+	const qint64 position = startPosition();
+	const qint64 rowSize = vectors * BinaryFilter::dataSize(dataType);
+	const qint64 size = qMin(file.size() - position, m_actualRows * rowSize);
+	uchar* data = nullptr;
+	if (size > 0) {
+		data = file.map(position, size);
+		if (!data)
+			return false;
+	}
+
+	int startColumn = 0;
+	if (createIndexEnabled) {
+		m_actualCols++;
+		startColumn++;
+	}
+
+	std::vector<void*> dataContainer;
+	columnModes.resize(m_actualCols);
+	QStringList vectorNames;
+	if (createIndexEnabled) {
+		vectorNames.prepend(i18n("Index"));
+		columnModes[0] = AbstractColumn::ColumnMode::Integer;
+	}
+	const int columnOffset = dataSource->prepareImport(dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes);
+
+	if (createIndexEnabled) {
+		auto* index = static_cast<QVector<int>*>(dataContainer[0]);
+		for (int i = 0; i < m_actualRows; ++i)
+			index->operator[](i) = i + 1;
+	}
+
+	std::vector<double*> columns;
+	for (int n = startColumn; n < m_actualCols; ++n)
+		columns.push_back(static_cast<QVector<double>*>(dataContainer[n])->data());
+
+	// read blocks of rows of all vectors to access the mapped memory sequentially
+	const bool swap = (byteOrder == QDataStream::BigEndian) != (QSysInfo::ByteOrder == QSysInfo::BigEndian);
+	const int blockSize = 16384;
+	for (int first = 0; first < m_actualRows; first += blockSize) {
+		const int last = qMin(first + blockSize, m_actualRows);
+		switch (dataType) {
+		case BinaryFilter::DataType::INT8:
+			readValues<qint8>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::INT16:
+			readValues<qint16>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::INT32:
+			readValues<qint32>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::INT64:
+			readValues<qint64>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::UINT8:
+			readValues<quint8>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::UINT16:
+			readValues<quint16>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::UINT32:
+			readValues<quint32>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::UINT64:
+			readValues<quint64>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::REAL32:
+			readValues<float>(data, size, vectors, swap, columns, first, last);
+			break;
+		case BinaryFilter::DataType::REAL64:
+			readValues<double>(data, size, vectors, swap, columns, first, last);
+			break;
+		}
+		Q_EMIT q->completed(100 * last / m_actualRows);
+	}
+
+	if (data)
+		file.unmap(data);
+
+	dataSource->finalizeImport(columnOffset, 1, m_actualCols, QString(), importMode);
+	return true;
+}
+
 /*!
     writes the content of \c dataSource to the file \c fileName.
 */
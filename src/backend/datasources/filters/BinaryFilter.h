@@ -29,7 +29,7 @@ public:
 
 	static QStringList dataTypes();
 	static int dataSize(BinaryFilter::DataType);
-	static size_t rowNumber(const QString& fileName, const size_t vectors, const BinaryFilter::DataType);
+	static size_t rowNumber(const QString& fileName, const size_t vectors, const BinaryFilter::DataType, const size_t skipStartBytes = 0);
 	static QString fileInfoString(const QString&);
 
 	// read data from any device
@@ -20,11 +20,14 @@ class BinaryFilterPrivate {
 public:
 	explicit BinaryFilterPrivate(BinaryFilter*);
 
+	int prepareRange();
+	qint64 startPosition() const;
 	int prepareStreamToRead(QDataStream&);
 	void readDataFromDevice(QIODevice& device, AbstractDataSource* = nullptr,
 			AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr,
 			AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
+	bool readDataFromMappedFile(const QString& fileName, AbstractDataSource*, AbstractFileFilter::ImportMode);
 	void write(const QString& fileName, AbstractDataSource*);
 	QVector<QStringList> preview(const QString& fileName, int lines);
 
@@ -22,6 +22,11 @@
 #include <QMultiMap>
 #include <QFile>
 #include <QDebug>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+#include <cmath>
 
 /*! \class FITSFilter
  * \brief Manages the import/export of data from/to a FITS file.
@@ -416,19 +421,11 @@ QVector<QStringList> FITSFilterPrivate::readCHDU(const QString& fileName, Abstra
 
 		if (endRow != -1)
 			lines = endRow;
-        QVector<QVector<QString>*> stringDataPointers;
-		std::vector<void*> numericDataPointers;
-		QList<bool> columnNumericTypes;
-
-		int startCol = 0;
-		if (startColumn != 1)
-			startCol = startColumn;
-		int startRrow = 0;
-		if (startRow != 1)
-			startRrow = startRow;
-
-		columnNumericTypes.reserve(actualCols);
+		QVector<ColumnRead> columnReads;
+		columnReads.reserve(actualCols);
 		int datatype;
+		long repeat;
+		long width;
 		int c = 1;
 		if (startColumn != 1) {
 			if (startColumn != 0)
@@ -436,88 +433,55 @@ QVector<QStringList> FITSFilterPrivate::readCHDU(const QString& fileName, Abstra
 		}
 		QList<int> matrixNumericColumnIndices;
 		for (; c <= actualCols; ++c) {
-			fits_get_coltype(m_fitsFile, c, &datatype, nullptr, nullptr, &status);
+			fits_get_coltype(m_fitsFile, c, &datatype, &repeat, &width, &status);
 
+			ColumnRead read;
+			read.column = c;
+			read.width = qMax(repeat, width);
 			switch (datatype) {
 			case TSTRING:
-				columnNumericTypes.append(false);
+			case TLOGICAL:
+				read.mode = AbstractColumn::ColumnMode::Text;
 				break;
 			case TSHORT:
-				columnNumericTypes.append(true);
-				break;
 			case TLONG:
-				columnNumericTypes.append(true);
-				break;
 			case TFLOAT:
-				columnNumericTypes.append(true);
-				break;
 			case TDOUBLE:
-				columnNumericTypes.append(true);
-				break;
-			case TLOGICAL:
-				columnNumericTypes.append(false);
-				break;
 			case TBIT:
-				columnNumericTypes.append(true);
-				break;
 			case TBYTE:
-				columnNumericTypes.append(true);
-				break;
 			case TCOMPLEX:
-				columnNumericTypes.append(true);
+				read.mode = AbstractColumn::ColumnMode::Double;
 				break;
 			default:
-				columnNumericTypes.append(false);
+				read.mode = AbstractColumn::ColumnMode::Text;
 				break;
 			}
+			// the equivalent type takes the scaling (TSCALn, TZEROn) of integer columns into account
+			int equivalentType;
+			fits_get_eqcoltype(m_fitsFile, c, &equivalentType, nullptr, nullptr, &status);
+			read.type = bulkReadType(equivalentType, repeat);
+			if (read.type == TINT)
+				read.mode = AbstractColumn::ColumnMode::Integer;
+			else if (read.type == TLONGLONG)
+				read.mode = AbstractColumn::ColumnMode::BigInt;
+			else if (read.type == TDOUBLE)
+				read.mode = AbstractColumn::ColumnMode::Double;
+			columnReads << read;
+
 			if ((datatype != TSTRING) && (datatype != TLOGICAL))
 				matrixNumericColumnIndices.append(c);
 		}
 
 		if (noDataSource)
 			*okToMatrix = matrixNumericColumnIndices.isEmpty() ? false : true;
-		if (!noDataSource) {
+		else {
 			DEBUG("HAS DataSource");
-			auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
-			if (spreadsheet) {
-				numericDataPointers.reserve(actualCols - startCol);
-
-				stringDataPointers.reserve(actualCols - startCol);
-				spreadsheet->setUndoAware(false);
-				columnOffset = spreadsheet->resize(importMode, columnNames, actualCols - startCol);
-
-				if (importMode == AbstractFileFilter::ImportMode::Replace) {
-					spreadsheet->clear();
-					spreadsheet->setRowCount(lines - startRrow);
-				} else {
-					if (spreadsheet->rowCount() < (lines - startRrow))
-						spreadsheet->setRowCount(lines - startRrow);
-				}
-				DEBUG("Reading columns ...");
-				for (int n = 0; n < actualCols - startCol; ++n) {
-					if (columnNumericTypes.at(n)) {
-						spreadsheet->column(columnOffset+ n)->setColumnMode(AbstractColumn::ColumnMode::Double);
-						auto* datap = static_cast<QVector<double>* >(spreadsheet->column(columnOffset+n)->data());
-						numericDataPointers.push_back(datap);
-						if (importMode == AbstractFileFilter::ImportMode::Replace)
-							datap->clear();
-					} else {
-						spreadsheet->column(columnOffset+ n)->setColumnMode(AbstractColumn::ColumnMode::Text);
-                        auto* list = static_cast<QVector<QString>*>(spreadsheet->column(columnOffset+n)->data());
-						stringDataPointers.push_back(list);
-						if (importMode == AbstractFileFilter::ImportMode::Replace)
-							list->clear();
-					}
-				}
-				DEBUG("	... DONE");
-				stringDataPointers.squeeze();
-			} else {
-				numericDataPointers.reserve(matrixNumericColumnIndices.size());
-
-				columnOffset = dataSource->prepareImport(numericDataPointers, importMode, lines - startRrow, matrixNumericColumnIndices.size());
-			}
+			readTable(fileName, dataSource, importMode, lines, columnNames, columnReads, matrixNumericColumnIndices);
+			fits_close_file(m_fitsFile, &status);
+			return dataStrings;
 		}
 
+		// preview
 		int row = 1;
 		if (startRow != 1) {
 			if (startRow != 0)
@@ -529,63 +493,25 @@ QVector<QStringList> FITSFilterPrivate::readCHDU(const QString& fileName, Abstra
 			if (startColumn != 0)
 				coll = startColumn;
 		}
-		bool isMatrix = false;
-		if (dynamic_cast<Matrix*>(dataSource)) {
-			isMatrix = true;
-			coll = matrixNumericColumnIndices.first();
-			actualCols = matrixNumericColumnIndices.last();
-			if (importMode == AbstractFileFilter::ImportMode::Replace) {
-				for (auto* col : numericDataPointers)
-					static_cast<QVector<double>*>(col)->clear();
-			}
-		}
 
 		char array[FLEN_VALUE];
 		char* tmpArr[1] = {array};
 		for (; row <= lines; ++row) {
-			int numericixd = 0;
-			int stringidx = 0;
 			QStringList line;
 			line.reserve(actualCols-coll);
 			for (int col = coll; col <= actualCols; ++col) {
-				if (isMatrix) {
-					if (!matrixNumericColumnIndices.contains(col))
-						continue;
-				}
 				if (fits_read_col_str(m_fitsFile, col, row, 1, 1, nullptr, tmpArr, nullptr, &status))
 					printError(status);
-				if (!noDataSource) {
-					QString str = QString::fromLatin1(array);
-					if (str.isEmpty()) {
-						if (columnNumericTypes.at(col - 1))
-							static_cast<QVector<double>*>(numericDataPointers[numericixd++])->push_back(0);
-						else
-							stringDataPointers[stringidx++]->append(QLatin1String("NULL"));
-					} else {
-						if (columnNumericTypes.at(col - 1))
-							static_cast<QVector<double>*>(numericDataPointers[numericixd++])->push_back(str.toDouble());
-						else {
-							if (!stringDataPointers.isEmpty())
-								stringDataPointers[stringidx++]->operator<<(str.simplified());
-						}
-
-					}
-				} else {
-					QString tmpColstr = QString::fromLatin1(array);
-					tmpColstr = tmpColstr.simplified();
-					if (tmpColstr.isEmpty())
-						line << QLatin1String("NULL");
-					else
-						line << tmpColstr;
-				}
+				QString tmpColstr = QString::fromLatin1(array);
+				tmpColstr = tmpColstr.simplified();
+				if (tmpColstr.isEmpty())
+					line << QLatin1String("NULL");
+				else
+					line << tmpColstr;
 			}
-            if (noDataSource)
-                dataStrings << line;
+			dataStrings << line;
 		}
 
-		if (!noDataSource)
-			dataSource->finalizeImport(columnOffset, 1, actualCols, QString(), importMode);
-
 		fits_close_file(m_fitsFile, &status);
 		return dataStrings;
 	} else
@@ -603,6 +529,228 @@ QVector<QStringList> FITSFilterPrivate::readCHDU(const QString& fileName, Abstra
 	return dataStrings;
 }
 
+#ifdef HAVE_FITS
+//! reads a part of the columns of a table, every task uses its own file handle
+class FITSReadTask : public QRunnable {
+public:
+	FITSReadTask(const QString& fileName, const QVector<FITSFilterPrivate::ColumnRead>& reads, long firstRow, long rows)
+		: m_fileName(fileName), m_reads(reads), m_firstRow(firstRow), m_rows(rows) {
+	}
+
+	void run() override {
+		int status = 0;
+		fitsfile* file;
+		if (fits_open_file(&file, m_fileName.toLatin1(), READONLY, &status)) {
+			FITSFilterPrivate::printError(status);
+			return;
+		}
+		FITSFilterPrivate::readColumns(file, m_reads, m_firstRow, m_rows);
+		fits_close_file(file, &status);
+	}
+
+private:
+	QString m_fileName;
+	QVector<FITSFilterPrivate::ColumnRead> m_reads;
+	long m_firstRow;
+	long m_rows;
+};
+
+/*!
+ * \brief Returns the data type used to read the values of a column with the equivalent data type \a equivalentType in bulk
+ * or 0 if the values have to be read one by one as strings (logical, bit, complex and vector columns).
+ */
+int FITSFilterPrivate::bulkReadType(int equivalentType, long repeat) {
+	if (equivalentType == TSTRING)
+		return TSTRING;
+	if (repeat != 1)
+		return 0;
+
+	switch (equivalentType) {
+	case TBYTE:
+	case TSBYTE:
+	case TSHORT:
+	case TUSHORT:
+	case TINT:
+	case TLONG:
+		return TINT;
+	case TULONG:
+	case TLONGLONG:
+		return TLONGLONG;
+	case TFLOAT:
+	case TDOUBLE:
+		return TDOUBLE;
+	default:
+		return 0;
+	}
+}
+
+/*!
+ * \brief Reads \a rows rows starting at row \a firstRow of the columns \a reads of the table in \a file
+ * directly into the data of the columns.
+ *
+ * The numeric columns are read with typed reads, cfitsio converts the values and applies the scaling.
+ * The rows are read in batches of the size that fits into the buffers of cfitsio.
+ */
+bool FITSFilterPrivate::readColumns(fitsfile* file, const QVector<ColumnRead>& reads, long firstRow, long rows) {
+	int status = 0;
+	long batchRows = 0;
+	if (fits_get_rowsize(file, &batchRows, &status) || batchRows < 1) {
+		status = 0;
+		batchRows = 1000;
+	}
+
+	QByteArray strings;
+	std::vector<char*> stringPointers;
+	char nullString[] = "";
+	char value[FLEN_VALUE];
+	char* values[1] = {value};
+	for (long offset = 0; offset < rows; offset += batchRows) {
+		const long n = qMin(batchRows, rows - offset);
+		const long row = firstRow + offset;
+		for (const auto& read : reads) {
+			int anynul;
+			switch (read.type) {
+			case TDOUBLE: {
+				double nullValue = NAN;
+				fits_read_col(file, TDOUBLE, read.column, row, 1, n, &nullValue,
+						static_cast<QVector<double>*>(read.data)->data() + offset, &anynul, &status);
+				break;
+			}
+			case TINT: {
+				int nullValue = 0;
+				fits_read_col(file, TINT, read.column, row, 1, n, &nullValue,
+						static_cast<QVector<int>*>(read.data)->data() + offset, &anynul, &status);
+				break;
+			}
+			case TLONGLONG: {
+				LONGLONG nullValue = 0;
+				fits_read_col(file, TLONGLONG, read.column, row, 1, n, &nullValue,
+						reinterpret_cast<LONGLONG*>(static_cast<QVector<qint64>*>(read.data)->data() + offset), &anynul, &status);
+				break;
+			}
+			case TSTRING: {
+				strings.resize(n * (read.width + 1));
+				stringPointers.resize(n);
+				for (long i = 0; i < n; ++i)
+					stringPointers[i] = strings.data() + i * (read.width + 1);
+				if (fits_read_col_str(file, read.column, row, 1, n, nullString, stringPointers.data(), &anynul, &status))
+					break;
+				auto* texts = static_cast<QVector<QString>*>(read.data);
+				for (long i = 0; i < n; ++i) {
+					const QString str = QString::fromLatin1(stringPointers[i]);
+					(*texts)[offset + i] = str.isEmpty() ? QLatin1String("NULL") : str.simplified();
+				}
+				break;
+			}
+			default:	// read the values one by one as strings
+				for (long i = 0; i < n; ++i) {
+					if (fits_read_col_str(file, read.column, row + i, 1, 1, nullptr, values, nullptr, &status))
+						break;
+					const QString str = QString::fromLatin1(value);
+					if (read.mode == AbstractColumn::ColumnMode::Double)
+						(*static_cast<QVector<double>*>(read.data))[offset + i] = str.isEmpty() ? NAN : str.toDouble();
+					else
+						(*static_cast<QVector<QString>*>(read.data))[offset + i] = str.isEmpty() ? QLatin1String("NULL") : str.simplified();
+				}
+			}
+
+			if (status) {
+				printError(status);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*!
+ * \brief Imports the rows up to \a lines of the table in the current header data unit into the data source \a dataSource.
+ *
+ * The data source is prepared for all columns \a columnReads first (only the numeric columns \a matrixColumns for matrices),
+ * the columns are read in parallel afterwards if cfitsio was built reentrant.
+ */
+void FITSFilterPrivate::readTable(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode,
+		int lines, const QStringList& columnNames, QVector<ColumnRead>& columnReads, const QList<int>& matrixColumns) {
+	const long firstRow = qMax(startRow, 1);
+	const long rows = qMax(lines - firstRow + 1, 0L);
+	DEBUG(Q_FUNC_INFO << ", rows = " << rows << ", columns = " << columnReads.size());
+
+	int columnOffset = 0;
+	auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
+	if (spreadsheet) {
+		spreadsheet->setUndoAware(false);
+		columnOffset = spreadsheet->resize(importMode, columnNames, columnReads.size());
+
+		if (importMode == AbstractFileFilter::ImportMode::Replace) {
+			spreadsheet->clear();
+			spreadsheet->setRowCount((int)rows);
+		} else {
+			if (spreadsheet->rowCount() < rows)
+				spreadsheet->setRowCount((int)rows);
+		}
+
+		for (int n = 0; n < columnReads.size(); ++n) {
+			auto* column = spreadsheet->column(columnOffset + n);
+			column->setColumnMode(columnReads.at(n).mode);
+			columnReads[n].data = column->data();
+		}
+	} else {
+		// only the numeric columns are imported into a matrix
+		QVector<ColumnRead> matrixReads;
+		for (auto read : columnReads) {
+			if (!matrixColumns.contains(read.column))
+				continue;
+			read.mode = AbstractColumn::ColumnMode::Double;
+			if (read.type != 0)
+				read.type = TDOUBLE;
+			matrixReads << read;
+		}
+		columnReads = matrixReads;
+
+		std::vector<void*> dataContainer;
+		dataContainer.reserve(columnReads.size());
+		columnOffset = dataSource->prepareImport(dataContainer, importMode, rows, columnReads.size());
+		for (int n = 0; n < columnReads.size(); ++n)
+			columnReads[n].data = dataContainer[n];
+	}
+
+	// the values are written directly into the data containers
+	for (const auto& read : columnReads) {
+		switch (read.mode) {
+		case AbstractColumn::ColumnMode::Integer:
+			static_cast<QVector<int>*>(read.data)->resize(qMax(static_cast<QVector<int>*>(read.data)->size(), (int)rows));
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			static_cast<QVector<qint64>*>(read.data)->resize(qMax(static_cast<QVector<qint64>*>(read.data)->size(), (int)rows));
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			static_cast<QVector<QString>*>(read.data)->resize(qMax(static_cast<QVector<QString>*>(read.data)->size(), (int)rows));
+			break;
+		case AbstractColumn::ColumnMode::Double:
+		default:
+			static_cast<QVector<double>*>(read.data)->resize(qMax(static_cast<QVector<double>*>(read.data)->size(), (int)rows));
+		}
+	}
+
+	const int threads = qMin(QThread::idealThreadCount(), columnReads.size());
+	if (fits_is_reentrant() && threads > 1) {
+		// distribute the columns to the threads, every thread reads its columns in row batches
+		QVector<QVector<ColumnRead>> threadReads(threads);
+		for (int n = 0; n < columnReads.size(); ++n)
+			threadReads[n % threads] << columnReads.at(n);
+
+		QThreadPool pool;
+		for (const auto& reads : threadReads)
+			pool.start(new FITSReadTask(fileName, reads, firstRow, rows));
+		pool.waitForDone();
+	} else
+		readColumns(m_fitsFile, columnReads, firstRow, rows);
+
+	dataSource->finalizeImport(columnOffset, 1, columnReads.size(), QString(), importMode);
+}
+#endif
+
 /*!
  * \brief Export from data source \a dataSource to file \a fileName
  * \param fileName the name of the file to be exported to
@@ -1036,7 +1184,7 @@ QMultiMap<QString, QString> FITSFilterPrivate::extensionNames(const QString& fil
  * \brief Prints the error text corresponding to the status code \a status
  * \param status the status code of the error
  */
-void FITSFilterPrivate::printError(int status) const {
+void FITSFilterPrivate::printError(int status) {
 #ifdef HAVE_FITS
 	if (status) {
 		char errorText[FLEN_ERRMSG];
@@ -49,11 +49,27 @@ public:
 	bool commentsAsUnits{false};
 	int exportTo{0};
 private:
-	void printError(int status) const;
+	static void printError(int status);
 
 #ifdef HAVE_FITS
+	//! column of a table that is read directly into the data of a column of the data source
+	struct ColumnRead {
+		int column{1};	// number of the column in the table
+		int type{0};	// cfitsio data type of the bulk reads, 0 if the values are read one by one as strings
+		long width{0};	// maximal number of characters of a string value
+		AbstractColumn::ColumnMode mode{AbstractColumn::ColumnMode::Double};	// mode of the column of the data source
+		void* data{nullptr};	// data container of the column (QVector<T>)
+	};
+
+	void readTable(const QString& fileName, AbstractDataSource*, AbstractFileFilter::ImportMode, int lines,
+			const QStringList& columnNames, QVector<ColumnRead>&, const QList<int>& matrixColumns);
+	static int bulkReadType(int equivalentType, long repeat);
+	static bool readColumns(fitsfile*, const QVector<ColumnRead>&, long firstRow, long rows);
+
 	fitsfile* m_fitsFile{nullptr};
 #endif
+
+	friend class FITSReadTask;
 };
 
 #endif // FITSFILTERPRIVATE_H
@@ -23,31 +23,27 @@
 #include <QTreeWidgetItem>
 #include <QProcess>
 #include <QFile>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <functional>
 
 ///////////// macros ///////////////////////////////////////////////
 // type - data type
 #define HDF5_READ_1D(type) \
 	{ \
-	for (int i = startRow - 1; i < qMin(endRow, lines + startRow - 1); ++i) { \
-		if (dataContainer) \
-			static_cast<QVector<type>*>(dataContainer)->operator[](i-startRow+1) = data[i]; \
-		else	/* for preview */ \
-			dataString << QString::number(static_cast<type>(data[i])); \
-	} \
+	for (int i = 0; i < count; ++i) \
+		dataString << QString::number(static_cast<type>(data[i])); \
 	}
 
 // type - data type
 #define HDF5_READ_2D(type) \
 	{ \
-	for (int i = startRow - 1; i < qMin(endRow, lines + startRow - 1); ++i) { \
+	for (int i = 0; i < count; ++i) { \
 		QStringList line; \
-		line.reserve(endColumn - startColumn + 1); \
-		for (int j = startColumn - 1; j < endColumn; ++j) { \
-			if (dataPointer[0]) \
-				static_cast<QVector<type>*>(dataPointer[j-startColumn+1])->operator[](i-startRow+1) = data[i][j]; \
-			else \
-				line << QString::number(static_cast<type>(data[i][j])); \
-		} \
+		line.reserve(columns); \
+		for (int j = 0; j < columns; ++j) \
+			line << QString::number(static_cast<type>(data[i * columns + j])); \
 		dataStrings << line; \
 	} \
 	}
@@ -78,6 +74,14 @@ QVector<QStringList> HDF5Filter::readCurrentDataSet(const QString& fileName, Abs
 	return d->readCurrentDataSet(fileName, dataSource, ok, importMode, lines);
 }
 
+/*!
+  reads the data sets \c names from file \c fileName to the data sources \c dataSources.
+  The data sets are read in parallel if the HDF5 library is thread-safe.
+*/
+void HDF5Filter::readDataSets(const QString& fileName, const QStringList& names, const QVector<AbstractDataSource*>& dataSources, AbstractFileFilter::ImportMode mode) {
+	d->readDataSets(fileName, names, dataSources, mode);
+}
+
 /*!
   reads the content of the file \c fileName to the data source \c dataSource.
 */
@@ -148,6 +152,17 @@ int HDF5Filter::endColumn() const {
 	return d->endColumn;
 }
 
+/*!
+  sets the size of the chunk cache used for every data set in bytes
+*/
+void HDF5Filter::setChunkCacheSize(const size_t size) {
+	d->chunkCacheSize = size;
+}
+
+size_t HDF5Filter::chunkCacheSize() const {
+	return d->chunkCacheSize;
+}
+
 QString HDF5Filter::fileInfoString(const QString& fileName) {
 	DEBUG(Q_FUNC_INFO);
 	QString info;
@@ -379,6 +394,91 @@ void HDF5FilterPrivate::handleError(int err, const QString& function, const QStr
 #endif
 }
 
+/*!
+ * opens the data set \c name with a raw data chunk cache of \c chunkCacheSize bytes
+ */
+hid_t HDF5FilterPrivate::openDataSet(hid_t file, const QString& name) const {
+	hid_t dapl = H5Pcreate(H5P_DATASET_ACCESS);
+	handleError((int)dapl, "H5Pcreate");
+	// number of hash table slots, a prime number about 100 times larger than the number of chunks in the cache
+	const size_t slots = 12421;
+	herr_t status = H5Pset_chunk_cache(dapl, slots, chunkCacheSize, H5D_CHUNK_CACHE_W0_DEFAULT);
+	handleError(status, "H5Pset_chunk_cache");
+
+	hid_t dataset = H5Dopen2(file, qPrintable(name), dapl);
+	handleError((int)dataset, "H5Dopen2", name);
+	H5Pclose(dapl);
+
+	return dataset;
+}
+
+/*!
+ * returns the pointer to the data of the column data container \c container
+ */
+void* HDF5FilterPrivate::columnData(AbstractColumn::ColumnMode mode, void* container) {
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Integer:
+		return static_cast<QVector<int>*>(container)->data();
+	case AbstractColumn::ColumnMode::BigInt:
+		return static_cast<QVector<qint64>*>(container)->data();
+	case AbstractColumn::ColumnMode::Double:
+	default:
+		return static_cast<QVector<double>*>(container)->data();
+	}
+}
+
+/*!
+ * reads the selected rows of the selected columns of the data set \c dataset directly into the data of the columns.
+ * Every column is read with a hyperslab selection, the values are converted to the type of the columns by HDF5.
+ */
+bool HDF5FilterPrivate::readColumns(hid_t dataset, const ReadJob& job) {
+	hid_t memType;
+	switch (job.mode) {
+	case AbstractColumn::ColumnMode::Integer:
+		memType = H5Tcopy(H5T_NATIVE_INT);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		memType = H5Tcopy(H5T_NATIVE_LLONG);
+		break;
+	case AbstractColumn::ColumnMode::Double:
+	default:
+		memType = H5Tcopy(H5T_NATIVE_DOUBLE);
+	}
+	if (!job.memberName.isEmpty()) {	// read one member of the compound data set
+		hid_t compoundType = H5Tcreate(H5T_COMPOUND, H5Tget_size(memType));
+		handleError((int)compoundType, "H5Tcreate");
+		herr_t status = H5Tinsert(compoundType, job.memberName.constData(), 0, memType);
+		handleError(status, "H5Tinsert");
+		H5Tclose(memType);
+		memType = compoundType;
+	}
+
+	hid_t fileSpace = H5Dget_space(dataset);
+	handleError((int)fileSpace, "H5Dget_space");
+	hsize_t rows = job.rows;
+	hid_t memSpace = H5Screate_simple(1, &rows, nullptr);
+	handleError((int)memSpace, "H5Screate_simple");
+
+	bool ok = true;
+	for (size_t i = 0; i < job.columns.size(); ++i) {
+		// only the first value is used for rank 1
+		hsize_t offset[2] = {job.startRow, job.startColumn + i};
+		hsize_t count[2] = {job.rows, 1};
+		herr_t status = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+		handleError(status, "H5Sselect_hyperslab");
+		status = H5Dread(dataset, memType, memSpace, fileSpace, H5P_DEFAULT, job.columns.at(i));
+		handleError(status, "H5Dread", job.dataSetName);
+		if (status < 0)
+			ok = false;
+	}
+
+	H5Sclose(memSpace);
+	H5Sclose(fileSpace);
+	H5Tclose(memType);
+
+	return ok;
+}
+
 QString HDF5FilterPrivate::translateHDF5Order(H5T_order_t o) {
 	QString order;
 	switch (o) {
@@ -523,16 +623,58 @@ QStringList HDF5FilterPrivate::readHDF5Data1D(hid_t dataset, hid_t dtype, int ro
 	DEBUG("readHDF5Data1D() rows = " << rows << ", lines = " << lines);
 	QStringList dataString;
 
-	// we read all rows of data
-	T* data = new T[rows];
-
-	m_status = H5Dread(dataset, dtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
-	handleError(m_status, "H5Dread");
-	DEBUG(" startRow = " << startRow << ", endRow = " << endRow);
+	// only the selected rows are read
+	const int first = startRow - 1;
+	const int count = qMin(qMin(endRow, lines + startRow - 1), rows) - first;
+	DEBUG(" startRow = " << startRow << ", endRow = " << endRow << ", count = " << count);
 	DEBUG("	dataContainer = " << dataContainer);
+	if (count <= 0)
+		return dataString;
 
 	H5T_class_t dclass = H5Tget_class(dtype);
 	handleError((int)dclass, "H5Dget_class");
+	if (dataContainer) {
+		// read the rows directly into the column, HDF5 converts to the type of the column
+		ReadJob job;
+		job.dataSetName = currentDataSetName;
+		if (dclass == H5T_INTEGER) {
+			if (H5Tequal(dtype, H5T_STD_I64LE) || H5Tequal(dtype, H5T_STD_I64BE) || H5Tequal(dtype, H5T_NATIVE_LLONG)
+					|| H5Tequal(dtype, H5T_STD_U64LE) || H5Tequal(dtype, H5T_STD_U64BE) || H5Tequal(dtype, H5T_NATIVE_ULLONG))
+				job.mode = AbstractColumn::ColumnMode::BigInt;
+			else
+				job.mode = AbstractColumn::ColumnMode::Integer;
+		} else if (dclass == H5T_COMPOUND) {
+			char* name = H5Tget_member_name(dtype, 0);
+			job.memberName = name;
+			H5free_memory(name);
+		}
+		job.startRow = first;
+		job.rows = count;
+		job.columns.push_back(columnData(job.mode, dataContainer));
+
+		if (m_deferReading)
+			m_readJobs << job;
+		else
+			readColumns(dataset, job);
+
+		return dataString;
+	}
+
+	// preview
+	QVector<T> data(count);
+	hid_t fileSpace = H5Dget_space(dataset);
+	handleError((int)fileSpace, "H5Dget_space");
+	hsize_t offset = first;
+	hsize_t size = count;
+	m_status = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, &offset, nullptr, &size, nullptr);
+	handleError(m_status, "H5Sselect_hyperslab");
+	hid_t memSpace = H5Screate_simple(1, &size, nullptr);
+	handleError((int)memSpace, "H5Screate_simple");
+	m_status = H5Dread(dataset, dtype, memSpace, fileSpace, H5P_DEFAULT, data.data());
+	handleError(m_status, "H5Dread");
+	H5Sclose(memSpace);
+	H5Sclose(fileSpace);
+
 	if (dclass == H5T_INTEGER) {
 		if (H5Tequal(dtype, H5T_STD_I64LE) || H5Tequal(dtype, H5T_STD_I64BE) || H5Tequal(dtype, H5T_NATIVE_LLONG)
 				|| H5Tequal(dtype, H5T_STD_U64LE) || H5Tequal(dtype, H5T_STD_U64BE) || H5Tequal(dtype, H5T_NATIVE_ULLONG)) {
@@ -542,8 +684,6 @@ QStringList HDF5FilterPrivate::readHDF5Data1D(hid_t dataset, hid_t dtype, int ro
 	} else
 		HDF5_READ_1D(double);
 
-	delete[] data;
-
 	return dataString;
 }
 
@@ -667,17 +807,56 @@ QVector<QStringList> HDF5FilterPrivate::readHDF5Data2D(hid_t dataset, hid_t dtyp
 	if (rows == 0 || cols == 0)
 		return dataStrings;
 
-	// read all data
-	T** data = (T**) malloc(rows*sizeof(T*));
-	data[0] = (T*) malloc(cols*rows*sizeof(T));
-	for (int i = 1; i < rows; ++i)
-		data[i] = data[0] + i*cols;
-
-	m_status = H5Dread(dataset, dtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data[0][0]);
-	handleError(m_status,"H5Dread");
+	// only the selected rows and columns are read
+	const int first = startRow - 1;
+	const int count = qMin(qMin(endRow, lines + startRow - 1), rows) - first;
+	const int firstColumn = startColumn - 1;
+	const int columns = qMin(endColumn, cols) - firstColumn;
+	if (count <= 0 || columns <= 0)
+		return dataStrings;
 
 	H5T_class_t dclass = H5Tget_class(dtype);
 	handleError((int)dclass, "H5Dget_class");
+	if (dataPointer[0]) {
+		// read every column directly into the data of the column
+		ReadJob job;
+		job.dataSetName = currentDataSetName;
+		if (dclass == H5T_INTEGER) {
+			if (H5Tequal(dtype, H5T_STD_I64LE) || H5Tequal(dtype, H5T_STD_I64BE) || H5Tequal(dtype, H5T_NATIVE_LLONG)
+					|| H5Tequal(dtype, H5T_STD_U64LE) || H5Tequal(dtype, H5T_STD_U64BE) || H5Tequal(dtype, H5T_NATIVE_ULLONG))
+				job.mode = AbstractColumn::ColumnMode::BigInt;
+			else
+				job.mode = AbstractColumn::ColumnMode::Integer;
+		}
+		job.startRow = first;
+		job.rows = count;
+		job.startColumn = firstColumn;
+		for (int j = 0; j < columns; ++j)
+			job.columns.push_back(columnData(job.mode, dataPointer[j]));
+
+		if (m_deferReading)
+			m_readJobs << job;
+		else
+			readColumns(dataset, job);
+
+		return dataStrings;
+	}
+
+	// preview
+	QVector<T> data(count * columns);
+	hid_t fileSpace = H5Dget_space(dataset);
+	handleError((int)fileSpace, "H5Dget_space");
+	hsize_t offset[2] = {(hsize_t)first, (hsize_t)firstColumn};
+	hsize_t size[2] = {(hsize_t)count, (hsize_t)columns};
+	m_status = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset, nullptr, size, nullptr);
+	handleError(m_status, "H5Sselect_hyperslab");
+	hid_t memSpace = H5Screate_simple(2, size, nullptr);
+	handleError((int)memSpace, "H5Screate_simple");
+	m_status = H5Dread(dataset, dtype, memSpace, fileSpace, H5P_DEFAULT, data.data());
+	handleError(m_status, "H5Dread");
+	H5Sclose(memSpace);
+	H5Sclose(fileSpace);
+
 	if (dclass == H5T_INTEGER) {
 		if (H5Tequal(dtype, H5T_STD_I64LE) || H5Tequal(dtype, H5T_STD_I64BE) || H5Tequal(dtype, H5T_NATIVE_LLONG)
 				|| H5Tequal(dtype, H5T_STD_U64LE) || H5Tequal(dtype, H5T_STD_U64BE) || H5Tequal(dtype, H5T_NATIVE_ULLONG)) {
@@ -687,9 +866,6 @@ QVector<QStringList> HDF5FilterPrivate::readHDF5Data2D(hid_t dataset, hid_t dtyp
 	} else
 		HDF5_READ_2D(double);
 
-	free(data[0]);
-	free(data);
-
 	//QDEBUG(dataStrings);
 	return dataStrings;
 }
@@ -1477,8 +1653,7 @@ QVector<QStringList> HDF5FilterPrivate::readCurrentDataSet(const QString& fileNa
 #ifdef HAVE_HDF5
 	hid_t file = H5Fopen(qPrintable(fileName), H5F_ACC_RDONLY, H5P_DEFAULT);
 	handleError((int)file, "H5Fopen", fileName);
-	hid_t dataset = H5Dopen2(file, qPrintable(currentDataSetName), H5P_DEFAULT);
-	handleError((int)file, "H5Dopen2", currentDataSetName);
+	hid_t dataset = openDataSet(file, currentDataSetName);
 
 	// Get datatype and dataspace
 	hid_t dtype = H5Dget_type(dataset);
@@ -1948,7 +2123,10 @@ QVector<QStringList> HDF5FilterPrivate::readCurrentDataSet(const QString& fileNa
 		return dataStrings;
 
 	DEBUG(Q_FUNC_INFO << ", finalize : actual cols = " << actualCols)
-	dataSource->finalizeImport(columnOffset, 1, actualCols, QString(), mode);
+	if (m_deferReading)	// finalized after reading all data sets
+		m_finalizeImports << FinalizeImport{dataSource, columnOffset, actualCols, mode};
+	else
+		dataSource->finalizeImport(columnOffset, 1, actualCols, QString(), mode);
 #else
 	Q_UNUSED(fileName)
 	Q_UNUSED(dataSource)
@@ -1959,6 +2137,86 @@ QVector<QStringList> HDF5FilterPrivate::readCurrentDataSet(const QString& fileNa
 	return dataStrings;
 }
 
+#ifdef HAVE_HDF5
+//! reads the selected rows and columns of a data set, every task uses its own file handle
+class HDF5ReadTask : public QRunnable {
+public:
+	HDF5ReadTask(std::function<bool(hid_t)> read, QString fileName, QString dataSetName)
+		: m_read(std::move(read)), m_fileName(std::move(fileName)), m_dataSetName(std::move(dataSetName)) {
+	}
+
+	void run() override {
+		hid_t file = H5Fopen(qPrintable(m_fileName), H5F_ACC_RDONLY, H5P_DEFAULT);
+		HDF5FilterPrivate::handleError((int)file, "H5Fopen", m_fileName);
+		if (file < 0)
+			return;
+		if (!m_read(file))
+			DEBUG(Q_FUNC_INFO << ", WARNING: reading data set " << STDSTRING(m_dataSetName) << " failed")
+		H5Fclose(file);
+	}
+
+private:
+	std::function<bool(hid_t)> m_read;
+	QString m_fileName;
+	QString m_dataSetName;
+};
+#endif
+
+/*!
+    reads the data sets \c names of the file \c fileName to the data sources \c dataSources.
+    The data sources are prepared for every data set first, the data of the data sets is read
+    in parallel afterwards if the HDF5 library is thread-safe.
+*/
+void HDF5FilterPrivate::readDataSets(const QString& fileName, const QStringList& names, const QVector<AbstractDataSource*>& dataSources, AbstractFileFilter::ImportMode mode) {
+	DEBUG(Q_FUNC_INFO << ", data sets = " << names.size());
+#ifdef HAVE_HDF5
+	hbool_t threadSafe = false;
+#ifdef HAVE_AT_LEAST_HDF5_1_10_0
+	H5is_library_threadsafe(&threadSafe);
+#endif
+	bool ok = true;
+	if (!threadSafe || names.size() < 2) {
+		for (int i = 0; i < names.size(); ++i) {
+			currentDataSetName = names.at(i);
+			readCurrentDataSet(fileName, dataSources.at(i), ok, mode);
+		}
+		return;
+	}
+
+	// prepare the data sources and collect the columns to read
+	m_deferReading = true;
+	for (int i = 0; i < names.size(); ++i) {
+		currentDataSetName = names.at(i);
+		readCurrentDataSet(fileName, dataSources.at(i), ok, mode);
+	}
+	m_deferReading = false;
+
+	QThreadPool pool;
+	for (const auto& job : m_readJobs) {
+		auto read = [this, job](hid_t file) {
+			hid_t dataset = openDataSet(file, job.dataSetName);
+			if (dataset < 0)
+				return false;
+			bool ok = readColumns(dataset, job);
+			H5Dclose(dataset);
+			return ok;
+		};
+		pool.start(new HDF5ReadTask(read, fileName, job.dataSetName));
+	}
+	pool.waitForDone();
+	m_readJobs.clear();
+
+	for (const auto& finalize : m_finalizeImports)
+		finalize.dataSource->finalizeImport(finalize.columnOffset, 1, finalize.columns, QString(), finalize.mode);
+	m_finalizeImports.clear();
+#else
+	Q_UNUSED(fileName)
+	Q_UNUSED(names)
+	Q_UNUSED(dataSources)
+	Q_UNUSED(mode)
+#endif
+}
+
 /*!
     reads the content of the file \c fileName to the data source \c dataSource.
     Uses the settings defined in the data source.
@@ -29,6 +29,8 @@ public:
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace) override;
 	QVector<QStringList> readCurrentDataSet(const QString& fileName, AbstractDataSource*, bool& ok,
 						AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
+	void readDataSets(const QString& fileName, const QStringList& names, const QVector<AbstractDataSource*>&,
+						AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 	void write(const QString& fileName, AbstractDataSource*) override;
 
 	void loadFilterSettings(const QString&) override;
@@ -45,6 +47,8 @@ public:
 	int startColumn() const;
 	void setEndColumn(const int);
 	int endColumn() const;
+	void setChunkCacheSize(const size_t);
+	size_t chunkCacheSize() const;
 
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*) override;
@@ -15,6 +15,8 @@
 #include <hdf5.h>
 #endif
 
+#include <vector>
+
 class AbstractDataSource;
 
 class HDF5FilterPrivate {
@@ -30,6 +32,8 @@ public:
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 	QVector<QStringList> readCurrentDataSet(const QString& fileName, AbstractDataSource*, bool &ok,
 			AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
+	void readDataSets(const QString& fileName, const QStringList& names, const QVector<AbstractDataSource*>&,
+			AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 	void write(const QString& fileName, AbstractDataSource*);
 
 	const HDF5Filter* q;
@@ -39,16 +43,40 @@ public:
 	int endRow{-1};
 	int startColumn{1};
 	int endColumn{-1};
+	size_t chunkCacheSize{64*1024*1024};	// size of the raw data chunk cache of the data sets in bytes
 
 private:
 #ifdef HAVE_HDF5
 	int m_status;
+
+	//! selected rows and columns of a data set that are read directly into the data of the columns
+	struct ReadJob {
+		QString dataSetName;
+		QByteArray memberName;	// member of a compound data set
+		AbstractColumn::ColumnMode mode{AbstractColumn::ColumnMode::Double};	// mode of the columns
+		hsize_t startRow{0};
+		hsize_t rows{0};
+		hsize_t startColumn{0};
+		std::vector<void*> columns;	// data of the columns
+	};
+	struct FinalizeImport {
+		AbstractDataSource* dataSource;
+		int columnOffset;
+		int columns;
+		AbstractFileFilter::ImportMode mode;
+	};
+	bool m_deferReading{false};	// collect the read jobs to read several data sets in parallel
+	QVector<ReadJob> m_readJobs;
+	QVector<FinalizeImport> m_finalizeImports;
 #endif
 	const static int MAXNAMELENGTH = 1024;
 	const static int MAXSTRINGLENGTH = 1024*1024;
 	QList<unsigned long> m_multiLinkList;	// used to find hard links
 
 #ifdef HAVE_HDF5
+	hid_t openDataSet(hid_t file, const QString& name) const;
+	static bool readColumns(hid_t dataset, const ReadJob&);
+	static void* columnData(AbstractColumn::ColumnMode, void* container);
 	QString translateHDF5Order(H5T_order_t);
 	QString translateHDF5Type(hid_t);
 	QString translateHDF5Class(H5T_class_t);
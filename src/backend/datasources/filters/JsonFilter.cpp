@@ -12,6 +12,7 @@
 
 #include "backend/datasources/filters/JsonFilter.h"
 #include "backend/datasources/filters/JsonFilterPrivate.h"
+#include "backend/datasources/filters/JsonStreamReader.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/core/column/Column.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -27,6 +28,8 @@
 #include <KLocalizedString>
 #include <KFilterDev>
 
+#include <limits>
+
 /*!
 \class JsonFilter
 \brief Manages the import/export of data from/to a file formatted using JSON.
@@ -203,14 +206,23 @@ QString JsonFilter::fileInfoString(const QString& fileName) {
 	if (device.atEnd() && !device.isSequential())
 		return i18n("Empty file");
 
-	QJsonParseError err;
-	QJsonDocument doc = QJsonDocument::fromJson(device.readAll(), &err);
+	// validate the document or the JSON lines without loading them
+	JsonStreamReader reader(&device);
+	int values = 0;
+	while (!reader.atEnd()) {
+		if (!reader.skipValue())
+			break;
+		++values;
+	}
 
-	if (err.error != QJsonParseError::NoError || doc.isEmpty())
-		return i18n("Parse error: %1 at offset %2", err.errorString(), err.offset);
+	if (reader.hasError() || values == 0)
+		return i18n("Parse error at offset %1", reader.offset());
 
 	QString info;
-	info += i18n("Valid JSON document");
+	if (values == 1)
+		info += i18n("Valid JSON document");
+	else
+		info += i18np("Valid JSON lines document, %1 line", "Valid JSON lines document, %1 lines", values);
 
 	//TODO: get number of object, etc.
 	//if (prepareDocumentToRead(doc) != 0)
@@ -342,7 +354,7 @@ void JsonFilterPrivate::setEmptyValue(int column, int row) {
 			static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = 0;
 			break;
 		case AbstractColumn::ColumnMode::DateTime:
-			static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) = QDateTime();
+			static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = Column::invalidDateTime();
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			static_cast<QVector<QString>*>(m_dataContainer[column])->operator[](row) = QString();
@@ -376,8 +388,7 @@ void JsonFilterPrivate::setValueFromString(int column, int row, const QString& v
 		}
 		case AbstractColumn::ColumnMode::DateTime: {
 			const QDateTime valueDateTime = QDateTime::fromString(valueString, dateTimeFormat);
-			static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) =
-					valueDateTime.isValid() ? valueDateTime : QDateTime();
+			static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = Column::dateTimeToMSecs(valueDateTime);
 			break;
 		}
 		case AbstractColumn::ColumnMode::Text:
@@ -414,6 +425,125 @@ int JsonFilterPrivate::prepareDeviceToRead(QIODevice& device) {
 	return 0;
 }
 
+/*!
+	determines the keys of the members and the indices of the elements on the path to the selected value \c modelRows.
+	returns \c false if the path cannot be determined because the model is not available.
+*/
+bool JsonFilterPrivate::modelPath(QStringList& path) const {
+	path.clear();
+	if (modelRows.size() <= 1)
+		return true; //root element selected
+
+	if (!model)
+		return false;
+
+	QModelIndex index;
+	for (int i = 0; i < modelRows.size(); ++i) {
+		index = model->index(modelRows.at(i), 0, index);
+		if (!index.isValid())
+			return false;
+		if (i > 0) //the first index is the root element
+			path << static_cast<QJsonTreeItem*>(index.internalPointer())->key();
+	}
+
+	return true;
+}
+
+/*!
+	moves \c reader to the first row of the array at \c path or to the first line of JSON lines.
+	returns \c false if the selected value is neither an array nor JSON lines.
+*/
+bool JsonFilterPrivate::beginRows(JsonStreamReader& reader, const QStringList& path) {
+	if (!reader.moveTo(path))
+		return false;
+
+	m_jsonLines = false;
+	const char c = reader.peek();
+	if (c == '[') {
+		reader.beginArray();
+		//an array of values at the root is the first of several JSON lines
+		const char element = reader.peek();
+		if (!path.isEmpty() || element == '[' || element == '{' || element == ']')
+			return true;
+	} else if (c == '{' && path.isEmpty()) {
+		//a single object is read as document, several objects are JSON lines
+		if (!reader.skipValue() || reader.atEnd())
+			return false;
+	} else
+		return false;
+
+	m_jsonLines = true;
+	return reader.reset();
+}
+
+/*!
+	determines the rows to read of the selected array or of the JSON lines in \c device without loading the whole document.
+	The rows are counted up to the end row or up to \c lines rows only.
+	returns -1 if the data cannot be read as stream and the full document needs to be read,
+	1 if there are no valid rows to read and 0 otherwise. The device is open for reading if 0 is returned.
+*/
+int JsonFilterPrivate::prepareStreamToRead(QIODevice& device, int lines) {
+	PERFTRACE("Prepare the JSON stream to read");
+
+	QStringList path;
+	if (device.isOpen() || !modelPath(path) || !device.open(QIODevice::ReadOnly))
+		return -1;
+
+	JsonStreamReader reader(&device);
+	if (device.isSequential() || !beginRows(reader, path)) {
+		device.close();
+		return -1;
+	}
+
+	//count the rows in the selected range and determine the minimal number of columns
+	int countRows = 0;
+	int countCols = -1;
+	const int lastRow = (endRow == -1) ? std::numeric_limits<int>::max() : endRow;
+	int row = 0;
+	while (m_jsonLines ? !reader.atEnd() : reader.next()) {
+		++row;
+		if (row < startRow) {
+			if (!reader.skipValue())
+				break;
+			continue;
+		}
+		if (row > lastRow || (lines != -1 && countRows == lines))
+			break;
+
+		//the type of the rows is determined by the first row
+		const char c = reader.peek();
+		if (countRows == 0)
+			rowType = (c == '{') ? QJsonValue::Object : QJsonValue::Array;
+
+		int size = 0;
+		if (c != (rowType == QJsonValue::Object ? '{' : '[') || !reader.skipValue(&size) || size == 0) {
+			device.close();
+			return 1;
+		}
+		countCols = (countCols == -1 || countCols > size) ? size : countCols;
+		countRows++;
+	}
+
+	if (countRows == 0) {
+		device.close();
+		return 1;
+	}
+
+	if (endColumn == -1 || endColumn > countCols)
+		endColumn = countCols;
+
+	importObjectNames = false; //the rows of arrays and JSON lines don't have names
+	m_actualRows = countRows;
+	m_actualCols = endColumn - startColumn + 1 + createIndexEnabled;
+
+	DEBUG("JSON lines = " << m_jsonLines);
+	DEBUG("start/end column: = " << startColumn << ' ' << endColumn);
+	DEBUG("start/end rows = " << startRow << ' ' << endRow);
+	DEBUG("actual cols/rows = " << m_actualCols << ' ' << m_actualRows);
+
+	return 0;
+}
+
 /*!
 	determines the relevant part of the full JSON document to be read and its structure.
 	returns \c true if successful, \c false otherwise.
@@ -524,6 +654,17 @@ reads the content of device \c device to the data source \c dataSource. Uses the
 */
 void JsonFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
 	if (!m_prepared) {
+		//arrays of rows and JSON lines are read as stream without loading the whole document
+		const int streamError = prepareStreamToRead(device);
+		if (streamError == 0) {
+			importStream(device, dataSource, importMode, lines);
+			device.close();
+			return;
+		} else if (streamError == 1) {
+			DEBUG("No rows to read");
+			return;
+		}
+
 		const int deviceError = prepareDeviceToRead(device);
 		if (deviceError != 0) {
 			DEBUG("Device error = " << deviceError);
@@ -543,7 +684,6 @@ import the content of document \c m_preparedDoc to the data source \c dataSource
 void JsonFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
 	m_columnOffset = dataSource->prepareImport(m_dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes);
 	int rowOffset = startRow - 1;
-	int colOffset = (int)createIndexEnabled + (int)importObjectNames;
 	DEBUG("reading " << m_actualRows << " lines");
 	DEBUG("reading " << m_actualCols << " columns");
 
@@ -556,61 +696,15 @@ void JsonFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileF
 	const auto& objectIterator = object.begin();
 
 	for (int i = 0; i < m_actualRows; ++i) {
-		if (createIndexEnabled)
-			static_cast<QVector<int>*>(m_dataContainer[0])->operator[](i) = i + 1;
-
-		QJsonValue row;
 		switch (containerType) {
 		case JsonFilter::DataContainerType::Array:
-			row = *(arrayIterator + rowOffset + i);
+			importRow(i, *(arrayIterator + rowOffset + i));
 			break;
 		case JsonFilter::DataContainerType::Object:
-			if (importObjectNames) {
-				const QString& rowName = (objectIterator + rowOffset + i).key();
-				setValueFromString((int)createIndexEnabled, i, rowName);
-			}
-			row = *(objectIterator + rowOffset + i);
+			importRow(i, *(objectIterator + rowOffset + i), (objectIterator + rowOffset + i).key());
 			break;
 		}
 
-		for (int n = 0; n < m_actualCols - colOffset; ++n) {
-			QJsonValue value;
-			switch (rowType) {
-			case QJsonValue::Array:
-				value = *(row.toArray().begin() + n + startColumn -1);
-				break;
-			case QJsonValue::Object:
-				value = *(row.toObject().begin() + n + startColumn - 1);
-				break;
-			//TODO: implement other value types
-			case QJsonValue::Double:
-			case QJsonValue::String:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				break;
-			}
-
-			switch (value.type()) {
-			case QJsonValue::Double:
-				if (columnModes[colOffset + n] == AbstractColumn::ColumnMode::Double)
-					static_cast<QVector<double>*>(m_dataContainer[colOffset + n])->operator[](i) = value.toDouble();
-				else
-					setEmptyValue(colOffset + n, i + startRow - 1);
-				break;
-			case QJsonValue::String:
-				setValueFromString(colOffset + n, i, value.toString());
-				break;
-			case QJsonValue::Array:
-			case QJsonValue::Object:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				setEmptyValue(colOffset + n, i + startRow - 1);
-				break;
-			}
-		}
-
 		//ask to update the progress bar only if we have more than 1000 lines
 		//only in 1% steps
 		progressIndex++;
@@ -621,6 +715,109 @@ void JsonFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileF
 		}
 	}
 
+	finalizeImport(dataSource, importMode);
+}
+
+/*!
+import the rows prepared in prepareStreamToRead() from the device \c device to the data source \c dataSource.
+Only one row is read into memory at a time.
+*/
+void JsonFilterPrivate::importStream(QIODevice& device, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
+	PERFTRACE("Import the JSON stream");
+
+	QStringList path;
+	JsonStreamReader reader(&device);
+	if (!modelPath(path) || !reader.reset() || !beginRows(reader, path))
+		return;
+
+	auto nextRow = [&]() {
+		return m_jsonLines ? !reader.atEnd() : reader.next();
+	};
+
+	//skip the rows before the start row
+	for (int i = 1; i < startRow; ++i) {
+		if (!nextRow() || !reader.skipValue())
+			return;
+	}
+
+	//the column modes are determined by the first row
+	QJsonValue row;
+	if (!nextRow() || !reader.readValue(row) || parseColumnModes(row) != 0)
+		return;
+
+	m_columnOffset = dataSource->prepareImport(m_dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes);
+	DEBUG("reading " << m_actualRows << " lines");
+	DEBUG("reading " << m_actualCols << " columns");
+
+	int progressIndex = 0;
+	const float progressInterval = 0.01 * lines; //update on every 1% only
+
+	for (int i = 0; i < m_actualRows; ++i) {
+		if (i > 0 && (!nextRow() || !reader.readValue(row)))
+			break;
+		importRow(i, row);
+
+		progressIndex++;
+		if (m_actualRows > 1000 && progressIndex > progressInterval) {
+			Q_EMIT q->completed(100 * i/m_actualRows);
+			progressIndex = 0;
+			QApplication::processEvents(QEventLoop::AllEvents, 0);
+		}
+	}
+
+	finalizeImport(dataSource, importMode);
+}
+
+/*!
+imports the values of the JSON value \c row with the name \c rowName into the row \c i of the data containers.
+*/
+void JsonFilterPrivate::importRow(int i, const QJsonValue& row, const QString& rowName) {
+	if (createIndexEnabled)
+		static_cast<QVector<int>*>(m_dataContainer[0])->operator[](i) = i + 1;
+	if (importObjectNames)
+		setValueFromString((int)createIndexEnabled, i, rowName);
+
+	const int colOffset = (int)createIndexEnabled + (int)importObjectNames;
+	for (int n = 0; n < m_actualCols - colOffset; ++n) {
+		QJsonValue value;
+		switch (rowType) {
+		case QJsonValue::Array:
+			value = *(row.toArray().begin() + n + startColumn -1);
+			break;
+		case QJsonValue::Object:
+			value = *(row.toObject().begin() + n + startColumn - 1);
+			break;
+		//TODO: implement other value types
+		case QJsonValue::Double:
+		case QJsonValue::String:
+		case QJsonValue::Bool:
+		case QJsonValue::Null:
+		case QJsonValue::Undefined:
+			break;
+		}
+
+		switch (value.type()) {
+		case QJsonValue::Double:
+			if (columnModes[colOffset + n] == AbstractColumn::ColumnMode::Double)
+				static_cast<QVector<double>*>(m_dataContainer[colOffset + n])->operator[](i) = value.toDouble();
+			else
+				setEmptyValue(colOffset + n, i);
+			break;
+		case QJsonValue::String:
+			setValueFromString(colOffset + n, i, value.toString());
+			break;
+		case QJsonValue::Array:
+		case QJsonValue::Object:
+		case QJsonValue::Bool:
+		case QJsonValue::Null:
+		case QJsonValue::Undefined:
+			setEmptyValue(colOffset + n, i);
+			break;
+		}
+	}
+}
+
+void JsonFilterPrivate::finalizeImport(AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
 	//set the plot designation to 'X' for index and name columns, if available
 	Spreadsheet* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
 	if (spreadsheet) {
@@ -649,6 +846,15 @@ generates the preview for device \c device.
 */
 QVector<QStringList> JsonFilterPrivate::preview(QIODevice& device, int lines) {
 	if (!m_prepared) {
+		//arrays of rows and JSON lines are read as stream without loading the whole document
+		const int streamError = prepareStreamToRead(device, lines);
+		if (streamError == 0) {
+			const auto& dataStrings = previewStream(device, lines);
+			device.close();
+			return dataStrings;
+		} else if (streamError == 1)
+			return QVector<QStringList>();
+
 		const int deviceError = prepareDeviceToRead(device);
 		if (deviceError != 0) {
 			DEBUG("Device error = " << deviceError);
@@ -676,63 +882,95 @@ QVector<QStringList> JsonFilterPrivate::preview(int lines) {
 	const auto& objectIterator = object.begin();
 
 	for (int i = 0; i < qMin(lines, m_actualRows); ++i) {
-		QString rowName;
-		QJsonValue row;
 		switch (containerType) {
 			case JsonFilter::DataContainerType::Object:
-				rowName = (objectIterator + rowOffset + i).key();
-				row = *(objectIterator + rowOffset + i);
+				dataStrings << previewRow(i, *(objectIterator + rowOffset + i), (objectIterator + rowOffset + i).key());
 				break;
 			case JsonFilter::DataContainerType::Array:
-				row = *(arrayIterator + rowOffset + i);
+				dataStrings << previewRow(i, *(arrayIterator + rowOffset + i));
 				break;
 		}
+	}
+	return dataStrings;
+}
 
-		QStringList lineString;
-		if (createIndexEnabled)
-			lineString += QString::number(i + 1);
-		if (importObjectNames)
-			lineString += rowName;
+/*!
+generates the preview for the rows prepared in prepareStreamToRead() from the device \c device.
+*/
+QVector<QStringList> JsonFilterPrivate::previewStream(QIODevice& device, int lines) {
+	QVector<QStringList> dataStrings;
+	DEBUG("	Generating preview for " << qMin(lines, m_actualRows)  << " lines");
 
-		for (int n = startColumn - 1; n < endColumn; ++n) {
-			QJsonValue value;
-			switch (rowType) {
-			case QJsonValue::Object:
-				value = *(row.toObject().begin() + n);
-				break;
-			case QJsonValue::Array:
-				value = *(row.toArray().begin() + n);
-				break;
-			//TODO: implement other value types
-			case QJsonValue::Double:
-			case QJsonValue::String:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				break;
-			}
+	QStringList path;
+	JsonStreamReader reader(&device);
+	if (!modelPath(path) || !reader.reset() || !beginRows(reader, path))
+		return dataStrings;
 
-			switch (value.type()) {
-			case QJsonValue::Double:
-				lineString += QString::number(value.toDouble(), 'g', 16);
-				break;
-			case QJsonValue::String:
-				lineString += value.toString();
-				break;
-			case QJsonValue::Array:
-			case QJsonValue::Object:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				lineString += QString();
-				break;
-			}
-		}
-		dataStrings << lineString;
+	auto nextRow = [&]() {
+		return m_jsonLines ? !reader.atEnd() : reader.next();
+	};
+
+	for (int i = 1; i < startRow; ++i) {
+		if (!nextRow() || !reader.skipValue())
+			return dataStrings;
+	}
+
+	for (int i = 0; i < qMin(lines, m_actualRows); ++i) {
+		QJsonValue row;
+		if (!nextRow() || !reader.readValue(row))
+			break;
+		dataStrings << previewRow(i, row);
 	}
 	return dataStrings;
 }
 
+/*!
+returns the strings of the values of the JSON value \c row with the name \c rowName shown in the row \c i of the preview.
+*/
+QStringList JsonFilterPrivate::previewRow(int i, const QJsonValue& row, const QString& rowName) const {
+	QStringList lineString;
+	if (createIndexEnabled)
+		lineString += QString::number(i + 1);
+	if (importObjectNames)
+		lineString += rowName;
+
+	for (int n = startColumn - 1; n < endColumn; ++n) {
+		QJsonValue value;
+		switch (rowType) {
+		case QJsonValue::Object:
+			value = *(row.toObject().begin() + n);
+			break;
+		case QJsonValue::Array:
+			value = *(row.toArray().begin() + n);
+			break;
+		//TODO: implement other value types
+		case QJsonValue::Double:
+		case QJsonValue::String:
+		case QJsonValue::Bool:
+		case QJsonValue::Null:
+		case QJsonValue::Undefined:
+			break;
+		}
+
+		switch (value.type()) {
+		case QJsonValue::Double:
+			lineString += QString::number(value.toDouble(), 'g', 16);
+			break;
+		case QJsonValue::String:
+			lineString += value.toString();
+			break;
+		case QJsonValue::Array:
+		case QJsonValue::Object:
+		case QJsonValue::Bool:
+		case QJsonValue::Null:
+		case QJsonValue::Undefined:
+			lineString += QString();
+			break;
+		}
+	}
+	return lineString;
+}
+
 /*!
 writes the content of \c dataSource to the file \c fileName.
 */
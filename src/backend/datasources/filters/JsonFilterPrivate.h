@@ -17,6 +17,7 @@
 class QJsonDocument;
 class AbstractDataSource;
 class AbstractColumn;
+class JsonStreamReader;
 
 class JsonFilterPrivate {
 
@@ -29,17 +30,22 @@ public:
 	void setValueFromString(int column, int row, const QString& value);
 
 	int prepareDeviceToRead(QIODevice&);
+	int prepareStreamToRead(QIODevice&, int lines = -1);
 	void readDataFromDevice(QIODevice&, AbstractDataSource* = nullptr,
 			AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr,
 			AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 	void importData(AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace,
 	                int lines = -1);
+	void importStream(QIODevice&, AbstractDataSource*, AbstractFileFilter::ImportMode, int lines = -1);
+	void importRow(int i, const QJsonValue& row, const QString& rowName = QString());
 
 	void write(const QString& fileName, AbstractDataSource*);
 	QVector<QStringList> preview(const QString& fileName, int lines);
 	QVector<QStringList> preview(QIODevice& device, int lines);
 	QVector<QStringList> preview(int lines);
+	QVector<QStringList> previewStream(QIODevice&, int lines);
+	QStringList previewRow(int i, const QJsonValue& row, const QString& rowName = QString()) const;
 
 	const JsonFilter* q;
 	QJsonModel* model{nullptr};
@@ -69,8 +75,12 @@ private:
 	std::vector<void*> m_dataContainer; // pointers to the actual data containers (columns).
 	QJsonDocument m_doc; //original and full JSON document
 	QJsonDocument m_preparedDoc; // selected part of the full JSON document, the part that needs to be imported
+	bool m_jsonLines{false}; // every line of the device contains a row (JSON lines), only used when reading streams
 
 	bool prepareDocumentToRead();
+	bool modelPath(QStringList&) const;
+	bool beginRows(JsonStreamReader&, const QStringList& path);
+	void finalizeImport(AbstractDataSource*, AbstractFileFilter::ImportMode);
 };
 
 #endif
@@ -0,0 +1,421 @@
+/*
+    File                 : JsonStreamReader.cpp
+    Project              : LabPlot
+    Description          : pull parser reading JSON documents and JSON lines from a device
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "JsonStreamReader.h"
+
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QStringList>
+
+#include <cstring>
+
+namespace {
+const qint64 blockSize = 1024 * 1024;
+}
+
+JsonStreamReader::JsonStreamReader(QIODevice* device) : m_device(device) {
+}
+
+/*!
+ * starts reading from the beginning of the device again. Returns \c false if the device cannot be positioned.
+ */
+bool JsonStreamReader::reset() {
+	m_buffer.clear();
+	m_pos = 0;
+	m_offset = 0;
+	m_error = false;
+	m_first.clear();
+	return m_device->seek(0);
+}
+
+/*!
+ * returns \c true if only white space is left on the device or an error occurred
+ */
+bool JsonStreamReader::atEnd() {
+	return m_error || peek() == 0;
+}
+
+bool JsonStreamReader::hasError() const {
+	return m_error;
+}
+
+/*!
+ * returns the position of the next character in the device
+ */
+qint64 JsonStreamReader::offset() const {
+	return m_offset + m_pos;
+}
+
+/*!
+ * reads the next block of the device, returns \c false at the end of the device
+ */
+bool JsonStreamReader::fill() {
+	m_offset += m_buffer.size();
+	m_buffer = m_device->read(blockSize);
+	m_pos = 0;
+	return !m_buffer.isEmpty();
+}
+
+bool JsonStreamReader::setError() {
+	m_error = true;
+	return false;
+}
+
+/*!
+ * skips white space and returns the next character without consuming it, returns 0 at the end of the device
+ */
+char JsonStreamReader::peek() {
+	while (m_pos < m_buffer.size() || fill()) {
+		const char c = m_buffer.at(m_pos);
+		if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+			return c;
+		++m_pos;
+	}
+	return 0;
+}
+
+/*!
+ * enters the array at the current position, the elements are iterated with next()
+ */
+bool JsonStreamReader::beginArray() {
+	if (peek() != '[')
+		return setError();
+	++m_pos;
+	m_first << true;
+	return true;
+}
+
+/*!
+ * enters the object at the current position, the members are iterated with next() and readKey()
+ */
+bool JsonStreamReader::beginObject() {
+	if (peek() != '{')
+		return setError();
+	++m_pos;
+	m_first << true;
+	return true;
+}
+
+/*!
+ * returns \c true if another element or member follows in the current array or object.
+ * At the end of the array or object the closing bracket is consumed and \c false is returned.
+ */
+bool JsonStreamReader::next() {
+	if (m_error || m_first.isEmpty())
+		return false;
+
+	const char c = peek();
+	if (c == ']' || c == '}') {
+		++m_pos;
+		m_first.removeLast();
+		return false;
+	}
+	if (!m_first.last()) {
+		if (c != ',')
+			return setError();
+		++m_pos;
+	}
+	m_first.last() = false;
+	return true;
+}
+
+/*!
+ * reads the key of the next member of the current object
+ */
+bool JsonStreamReader::readKey(QString& key) {
+	if (peek() != '"' || !readString(&key))
+		return setError();
+	if (peek() != ':')
+		return setError();
+	++m_pos;
+	return true;
+}
+
+/*!
+ * reads the string at the current position to \c string or skips it if \c string is \c nullptr
+ */
+bool JsonStreamReader::readString(QString* string) {
+	++m_pos;	// opening quote
+	QByteArray utf8;
+	while (true) {
+		if (m_pos >= m_buffer.size() && !fill())
+			return setError();
+
+		// copy the characters up to the next quote or escape sequence
+		const char* data = m_buffer.constData();
+		const int size = m_buffer.size();
+		int end = m_pos;
+		while (end < size && data[end] != '"' && data[end] != '\\')
+			++end;
+		if (string)
+			utf8.append(data + m_pos, end - m_pos);
+		m_pos = end;
+		if (end == size)
+			continue;
+
+		if (data[m_pos++] == '"')
+			break;
+
+		// escape sequence
+		if (m_pos >= m_buffer.size() && !fill())
+			return setError();
+		const char c = m_buffer.at(m_pos++);
+		char unescaped = 0;
+		switch (c) {
+		case '"':
+		case '\\':
+		case '/':
+			unescaped = c;
+			break;
+		case 'b':
+			unescaped = '\b';
+			break;
+		case 'f':
+			unescaped = '\f';
+			break;
+		case 'n':
+			unescaped = '\n';
+			break;
+		case 'r':
+			unescaped = '\r';
+			break;
+		case 't':
+			unescaped = '\t';
+			break;
+		case 'u': {
+			char hex[5] = {0};
+			for (int i = 0; i < 4; ++i) {
+				if (m_pos >= m_buffer.size() && !fill())
+					return setError();
+				hex[i] = m_buffer.at(m_pos++);
+			}
+			bool ok;
+			const ushort code = QByteArray(hex).toUShort(&ok, 16);
+			if (!ok)
+				return setError();
+			// the surrogates of a pair are combined in the UTF-16 string
+			if (string) {
+				*string += QString::fromUtf8(utf8);
+				utf8.clear();
+				*string += QChar(code);
+			}
+			continue;
+		}
+		default:
+			return setError();
+		}
+		if (string)
+			utf8.append(unescaped);
+	}
+
+	if (string)
+		*string += QString::fromUtf8(utf8);
+	return true;
+}
+
+bool JsonStreamReader::readLiteral(const char* literal) {
+	const int length = (int)strlen(literal);
+	for (int i = 0; i < length; ++i) {
+		if (m_pos >= m_buffer.size() && !fill())
+			return setError();
+		if (m_buffer.at(m_pos++) != literal[i])
+			return setError();
+	}
+	return true;
+}
+
+/*!
+ * reads the number at the current position to \c value or skips it if \c value is \c nullptr
+ */
+bool JsonStreamReader::readNumber(double* value) {
+	char number[64];
+	int length = 0;
+	while (m_pos < m_buffer.size() || fill()) {
+		const char c = m_buffer.at(m_pos);
+		if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'))
+			break;
+		if (length == (int)sizeof(number) - 1)
+			return setError();
+		number[length++] = c;
+		++m_pos;
+	}
+	if (length == 0)
+		return setError();
+	number[length] = 0;
+
+	bool ok;
+	const double v = QByteArray::fromRawData(number, length).toDouble(&ok);
+	if (!ok)
+		return setError();
+	if (value)
+		*value = v;
+	return true;
+}
+
+/*!
+ * reads the value at the current position
+ */
+bool JsonStreamReader::readValue(QJsonValue& value) {
+	switch (peek()) {
+	case '[': {
+		QJsonArray array;
+		beginArray();
+		while (next()) {
+			QJsonValue element;
+			if (!readValue(element))
+				return false;
+			array.append(element);
+		}
+		value = array;
+		break;
+	}
+	case '{': {
+		QJsonObject object;
+		beginObject();
+		while (next()) {
+			QString key;
+			QJsonValue member;
+			if (!readKey(key) || !readValue(member))
+				return false;
+			object.insert(key, member);
+		}
+		value = object;
+		break;
+	}
+	case '"': {
+		QString string;
+		if (!readString(&string))
+			return false;
+		value = string;
+		break;
+	}
+	case 't':
+		if (!readLiteral("true"))
+			return false;
+		value = true;
+		break;
+	case 'f':
+		if (!readLiteral("false"))
+			return false;
+		value = false;
+		break;
+	case 'n':
+		if (!readLiteral("null"))
+			return false;
+		value = QJsonValue();
+		break;
+	case 0:
+		return setError();
+	default: {
+		double number;
+		if (!readNumber(&number))
+			return false;
+		value = number;
+	}
+	}
+
+	return !m_error;
+}
+
+/*!
+ * skips the value at the current position without creating it.
+ * The number of elements or members is returned in \c size for arrays and objects, 0 for other values.
+ */
+bool JsonStreamReader::skipValue(int* size) {
+	int count = 0;
+	switch (peek()) {
+	case '[':
+		beginArray();
+		while (next()) {
+			if (!skipValue())
+				return false;
+			++count;
+		}
+		break;
+	case '{':
+		beginObject();
+		while (next()) {
+			if (peek() != '"' || !readString(nullptr) || peek() != ':')
+				return setError();
+			++m_pos;
+			if (!skipValue())
+				return false;
+			++count;
+		}
+		break;
+	case '"':
+		if (!readString(nullptr))
+			return false;
+		break;
+	case 't':
+		if (!readLiteral("true"))
+			return false;
+		break;
+	case 'f':
+		if (!readLiteral("false"))
+			return false;
+		break;
+	case 'n':
+		if (!readLiteral("null"))
+			return false;
+		break;
+	case 0:
+		return setError();
+	default:
+		if (!readNumber(nullptr))
+			return false;
+	}
+
+	if (size)
+		*size = count;
+	return !m_error;
+}
+
+/*!
+ * moves to the value at \c path, the members of objects are selected with their keys
+ * and the elements of arrays with their indices. Returns \c false if the value doesn't exist.
+ */
+bool JsonStreamReader::moveTo(const QStringList& path) {
+	for (const auto& key : path) {
+		bool found = false;
+		const char c = peek();
+		if (c == '{') {
+			beginObject();
+			while (next()) {
+				QString name;
+				if (!readKey(name))
+					return false;
+				if (name == key) {
+					found = true;
+					break;
+				}
+				if (!skipValue())
+					return false;
+			}
+		} else if (c == '[') {
+			beginArray();
+			const int index = key.toInt();
+			for (int i = 0; next(); ++i) {
+				if (i == index) {
+					found = true;
+					break;
+				}
+				if (!skipValue())
+					return false;
+			}
+		}
+
+		if (!found)
+			return false;
+	}
+
+	return true;
+}
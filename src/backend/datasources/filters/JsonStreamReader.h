@@ -0,0 +1,62 @@
+/*
+    File                 : JsonStreamReader.h
+    Project              : LabPlot
+    Description          : pull parser reading JSON documents and JSON lines from a device
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef JSONSTREAMREADER_H
+#define JSONSTREAMREADER_H
+
+#include <QByteArray>
+#include <QVector>
+
+class QIODevice;
+class QJsonValue;
+class QString;
+class QStringList;
+
+//! Reads JSON values from a device without loading the whole document
+/**
+ * The device is read in blocks, only the values read with readValue() are created in memory.
+ * Arrays and objects can be entered with beginArray() and beginObject() to iterate over their
+ * elements and members with next(), values that are not needed are skipped with skipValue().
+ * Several values following each other (JSON lines) are read by calling readValue() or skipValue()
+ * until atEnd() returns \c true.
+ */
+class JsonStreamReader {
+public:
+	explicit JsonStreamReader(QIODevice*);
+
+	bool reset();
+	bool atEnd();
+	bool hasError() const;
+	qint64 offset() const;
+
+	char peek();
+	bool beginArray();
+	bool beginObject();
+	bool next();
+	bool readKey(QString&);
+	bool readValue(QJsonValue&);
+	bool skipValue(int* size = nullptr);
+	bool moveTo(const QStringList& path);
+
+private:
+	bool fill();
+	bool readString(QString*);
+	bool readLiteral(const char*);
+	bool readNumber(double*);
+	bool setError();
+
+	QIODevice* m_device;
+	QByteArray m_buffer;
+	int m_pos{0};
+	qint64 m_offset{0};	// position of the buffer in the device
+	bool m_error{false};
+	QVector<bool> m_first;	// no element was read yet in the entered arrays and objects
+};
+
+#endif
@@ -9,9 +9,12 @@
 */
 
 
+#include <QMutexLocker>
 #include <QRegularExpression>
+#include <QThreadPool>
 
 #include "backend/lib/macros.h"
+#include "backend/lib/parallel.h"
 #include "backend/gsl/ExpressionParser.h"
 
 #include <klocalizedstring.h>
@@ -27,6 +30,9 @@ extern "C" {
 
 ExpressionParser* ExpressionParser::m_instance{nullptr};
 
+// minimal number of rows evaluated in one task when evaluating in parallel
+static const int parallelChunkSize = 64 * PARSER_BLOCK_SIZE;
+
 ExpressionParser::ExpressionParser() {
 	init_table();
 	initFunctions();
@@ -1277,6 +1283,8 @@ void ExpressionParser::initConstants() {
 
 ExpressionParser::~ExpressionParser() {
 	delete_table();
+	for (auto* context : m_contexts)
+		free_context(context);
 }
 
 ExpressionParser* ExpressionParser::getInstance() {
@@ -1458,94 +1466,180 @@ QStringList ExpressionParser::getParameter(const QString& expr, const QStringLis
 	return parameters;
 }
 
-/*
- * Evaluate cartesian expression returning true on success and false if parsing fails
+/*!
+	returns a parser context with all functions and constants.
+	Contexts are reused since creating the symbol table is expensive compared to the evaluation of small data.
  */
-bool ExpressionParser::evaluateCartesian(const QString& expr, const QString& min, const QString& max,
-		int count, QVector<double>* xVector, QVector<double>* yVector,
+parser_context* ExpressionParser::acquireContext() {
+	{
+		QMutexLocker locker(&m_contextMutex);
+		if (!m_contexts.isEmpty())
+			return m_contexts.takeLast();
+	}
+	return create_context();
+}
+
+/*!
+	removes the parameters and variables from \c context and keeps it for reuse
+ */
+void ExpressionParser::releaseContext(parser_context* context) {
+	reset_context(context);
+	QMutexLocker locker(&m_contextMutex);
+	m_contexts << context;
+}
+
+/*!
+	returns \c true if \c expr calls one of the random functions (rand(), random(), drand(), randgaussian() etc.).
+	They share the state of the C library and of the GSL random number generator and are not thread-safe.
+ */
+bool ExpressionParser::usesRandomFunctions(const QString& expr) {
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
+	const QStringList& strings = expr.split(QRegularExpression(QStringLiteral("\\W+")), Qt::SkipEmptyParts);
+#else
+	const QStringList& strings = expr.split(QRegularExpression(QStringLiteral("\\W+")), QString::SkipEmptyParts);
+#endif
+	for (const auto& string : strings) {
+		if (string.startsWith(QLatin1String("rand")) || string == QLatin1String("drand"))
+			return true;
+	}
+	return false;
+}
+
+/*!
+	evaluates \c expr for \c count rows, the variable \c vars[i] takes its values from \c varData[i].
+	The parameters \c paramNames are set to \c paramValues.
+	The expression is compiled into byte code once and the byte code is evaluated for all rows.
+	Large data is split into chunks evaluated in parallel in the global thread pool.
+	Expressions calling random functions are evaluated in one thread and never concurrently,
+	since the random number generators are not thread-safe.
+	Expressions that can't be compiled (assignments) are parsed for every row.
+	A separate parser context is used, so this function can be called from different threads.
+	Returns \c false if parsing fails.
+ */
+bool ExpressionParser::evaluate(const QString& expr, const QStringList& vars, const QVector<const double*>& varData, double* result, int count,
 		const QStringList& paramNames, const QVector<double>& paramValues) {
-	DEBUG(Q_FUNC_INFO << ", v1: range = " << STDSTRING(min) << " .. " << STDSTRING(max))
-	gsl_set_error_handler_off();
+	Q_ASSERT(vars.size() == varData.size());
 
-	const Range<double> range{min, max};
-	const double step = range.stepSize(count);
-	DEBUG(Q_FUNC_INFO << ", range = " << range.toStdString() << ", step = " << step)
+	static QMutex randomMutex;
+	const bool random = usesRandomFunctions(expr);
+	QMutexLocker randomLocker(random ? &randomMutex : nullptr);
 
+	parser_context* context = acquireContext();
+	if (!context)
+		return false;
 	for (int i = 0; i < paramNames.size(); ++i)
-		assign_symbol(qPrintable(paramNames.at(i)), paramValues.at(i));
+		context_assign_symbol(context, qPrintable(paramNames.at(i)), paramValues.at(i));
+
+	// variable names as C strings (valid until the end of the evaluation)
+	QVector<QByteArray> names;
+	QVector<const char*> namePointers;
+	for (const auto& var : vars)
+		names << var.toLatin1();
+	for (const auto& name : names)
+		namePointers << name.constData();
+
+	// rows evaluated to NAN are reported like in the interpreter
+	auto warnNan = [&](int first, int last) {
+		for (int i = first; i < last; i++) {
+			if (!std::isnan(result[i]))
+				continue;
+			if (vars.isEmpty())
+				WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated to NAN")
+			else
+				WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << varData.at(0)[i] << " is NAN")
+		}
+	};
 
 	SET_NUMBER_LOCALE
+	parser_prog* prog = context_compile_with_vars(context, qPrintable(expr), namePointers.constData(), vars.size(), qPrintable(numberLocale.name()));
+	if (!prog)	// try default locale if failing
+		prog = context_compile_with_vars(context, qPrintable(expr), namePointers.constData(), vars.size(), "en_US");
+	if (prog) {
+		QThreadPool* pool = QThreadPool::globalInstance();
+		const int chunks = random ? 1 : qMin(pool->maxThreadCount(), count / parallelChunkSize);
+		bool rc;
+		if (chunks > 1) {
+			// chunk sizes are a multiple of the block size of the byte code evaluation
+			const int chunkSize = (count / chunks / PARSER_BLOCK_SIZE + 1) * PARSER_BLOCK_SIZE;
+			DEBUG(Q_FUNC_INFO << ", evaluating " << count << " rows in " << chunks << " chunks of size " << chunkSize)
+			QAtomicInt errors;
+			runChunked(count, chunkSize, [&](int start, int chunkCount) {
+				QVector<const double*> data;
+				for (const auto* d : varData)
+					data << d + start;
+				if (eval_prog(prog, data.constData(), result + start, (size_t)chunkCount) != 0)
+					errors.ref();
+			});
+			rc = (errors.loadAcquire() == 0);
+		} else
+			rc = (eval_prog(prog, varData.constData(), result, (size_t)count) == 0);
+
+		if (rc)
+			warnNan(0, count);
+		free_prog(prog);
+		releaseContext(context);
+		return rc;
+	}
+
+	DEBUG(Q_FUNC_INFO << ", expression " << STDSTRING(expr) << " not compiled. Parsing every row.")
 	for (int i = 0; i < count; i++) {
-		const double x{ range.start() + step * i };
-		assign_symbol("x", x);
+		for (int n = 0; n < vars.size(); ++n)
+			context_assign_symbol(context, namePointers.at(n), varData.at(n)[i]);
 
-		double y = parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	// try default locale if failing
-			y = parse(qPrintable(expr), "en_US");
-		if (parse_errors() > 0)
+		double y = context_parse(context, qPrintable(expr), qPrintable(numberLocale.name()));
+		if (context_parse_errors(context) > 0)	// try default locale if failing
+			y = context_parse(context, qPrintable(expr), "en_US");
+		if (context_parse_errors(context) > 0) {
+			releaseContext(context);
 			return false;
+		}
 
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << x << " is NAN")
-
-		(*xVector)[i] = x;
-		(*yVector)[i] = y;
+		result[i] = y;
+		warnNan(i, i + 1);
 	}
 
+	releaseContext(context);
 	return true;
 }
 
+/*
+ * Evaluate cartesian expression returning true on success and false if parsing fails
+ */
 bool ExpressionParser::evaluateCartesian(const QString& expr, const QString& min, const QString& max,
-		int count, QVector<double>* xVector, QVector<double>* yVector) {
-	DEBUG(Q_FUNC_INFO << ", v2")
+		int count, QVector<double>* xVector, QVector<double>* yVector,
+		const QStringList& paramNames, const QVector<double>& paramValues) {
+	DEBUG(Q_FUNC_INFO << ", v1: range = " << STDSTRING(min) << " .. " << STDSTRING(max))
 	gsl_set_error_handler_off();
 
 	const Range<double> range{min, max};
 	const double step = range.stepSize(count);
+	DEBUG(Q_FUNC_INFO << ", range = " << range.toStdString() << ", step = " << step)
 
-	SET_NUMBER_LOCALE
-	for (int i = 0; i < count; i++) {
-		const double x{ range.start() + step * i };
-		assign_symbol("x", x);
+	for (int i = 0; i < count; i++)
+		(*xVector)[i] = range.start() + step * i;
 
-		double y = parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	{ // try default locale if failing
-			y = parse(qPrintable(expr), "en_US");
-			//DEBUG(Q_FUNC_INFO << ", WARNING: PARSER failed, trying default locale: y = " << y)
-		}
-		if (parse_errors() > 0)
-			return false;
+	return evaluate(expr, QStringList{QStringLiteral("x")}, {xVector->constData()}, yVector->data(), count, paramNames, paramValues);
+}
+
+bool ExpressionParser::evaluateCartesian(const QString& expr, const QString& min, const QString& max,
+		int count, QVector<double>* xVector, QVector<double>* yVector) {
+	DEBUG(Q_FUNC_INFO << ", v2")
+	gsl_set_error_handler_off();
 
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << x << " is NAN")
+	const Range<double> range{min, max};
+	const double step = range.stepSize(count);
 
-		(*xVector)[i] = x;
-		(*yVector)[i] = y;
-	}
+	for (int i = 0; i < count; i++)
+		(*xVector)[i] = range.start() + step * i;
 
-	return true;
+	return evaluate(expr, QStringList{QStringLiteral("x")}, {xVector->constData()}, yVector->data(), count);
 }
 
 bool ExpressionParser::evaluateCartesian(const QString& expr, QVector<double>* xVector, QVector<double>* yVector) {
 	DEBUG(Q_FUNC_INFO << ", v3")
 	gsl_set_error_handler_off();
 
-	SET_NUMBER_LOCALE
-	for (int i = 0; i < xVector->count(); i++) {
-		assign_symbol("x", xVector->at(i));
-		double y = parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	// try default locale if failing
-			y = parse(qPrintable(expr), "en_US");
-		if (parse_errors() > 0)
-			return false;
-
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << xVector->at(i) << " is NAN")
- 
- 		(*yVector)[i] = y;
-	}
-
-	return true;
+	return evaluate(expr, QStringList{QStringLiteral("x")}, {xVector->constData()}, yVector->data(), xVector->count());
 }
 
 bool ExpressionParser::evaluateCartesian(const QString& expr, QVector<double>* xVector, QVector<double>* yVector,
@@ -1553,26 +1647,7 @@ bool ExpressionParser::evaluateCartesian(const QString& expr, QVector<double>* x
 	DEBUG(Q_FUNC_INFO << ", v4")
 	gsl_set_error_handler_off();
 
-	for (int i = 0; i < paramNames.size(); ++i)
-		assign_symbol(qPrintable(paramNames.at(i)), paramValues.at(i));
-
-	SET_NUMBER_LOCALE
-	for (int i = 0; i < xVector->count(); i++) {
-		assign_symbol("x", xVector->at(i));
-
-		double y = parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	// try default locale if failing
-			y = parse(qPrintable(expr), "en_US");
-		if (parse_errors() > 0)
-			return false;
-
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << xVector->at(i) << " is NAN")
-
-		(*yVector)[i] = y;
-	}
-
-	return true;
+	return evaluate(expr, QStringList{QStringLiteral("x")}, {xVector->constData()}, yVector->data(), xVector->count(), paramNames, paramValues);
 }
 
 /*!
@@ -1580,7 +1655,7 @@ bool ExpressionParser::evaluateCartesian(const QString& expr, QVector<double>* x
 	Variable names (x_1, x_2, ...) are stored in \c vars.
 	Data is stored in \c dataVectors.
  */
-bool ExpressionParser::evaluateCartesian(const QString& expr, const QStringList& vars, const QVector<QVector<double>*>& xVectors, QVector<double>* yVector) {
+bool ExpressionParser::evaluateCartesian(const QString& expr, const QStringList& vars, const QVector<const QVector<double>*>& xVectors, QVector<double>* yVector) {
 	DEBUG(Q_FUNC_INFO << ", v5")
 	Q_ASSERT(vars.size() == xVectors.size());
 	gsl_set_error_handler_off();
@@ -1595,22 +1670,11 @@ bool ExpressionParser::evaluateCartesian(const QString& expr, const QStringList&
 		minSize = yVector->size();
 
 	// calculate values
-	SET_NUMBER_LOCALE
-	for (int i = 0; i < minSize; i++) {
-		for (int n = 0; n < vars.size(); ++n)
-			assign_symbol(qPrintable(vars.at(n)), xVectors.at(n)->at(i));
-
-		double y = parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	// try default locale if failing
-			y = parse(qPrintable(expr), "en_US");
-		if (parse_errors() > 0)
-			return false;
-
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated to NAN")
-
-		(*yVector)[i] = y;
-	}
+	QVector<const double*> varData;
+	for (auto* xVector : xVectors)
+		varData << xVector->constData();
+	if (!evaluate(expr, vars, varData, yVector->data(), minSize))
+		return false;
 
 	//if the y-vector is longer than the x-vector(s), set all exceeding elements to NaN
 	for (int i = minSize; i < yVector->size(); ++i)
@@ -1626,22 +1690,16 @@ bool ExpressionParser::evaluatePolar(const QString& expr, const QString& min, co
 	const Range<double> range{min, max};
 	const double step = range.stepSize(count);
 
-	SET_NUMBER_LOCALE
-	for (int i = 0; i < count; i++) {
-		const double phi = range.start() + step * i;
-		assign_symbol("phi", phi);
-
-		double r = parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	// try default locale if failing
-			r = parse(qPrintable(expr), "en_US");
-		if (parse_errors() > 0)
-			return false;
+	QVector<double> phi(count), r(count);
+	for (int i = 0; i < count; i++)
+		phi[i] = range.start() + step * i;
 
-		if (std::isnan(r))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << phi << " is NAN")
+	if (!evaluate(expr, QStringList{QStringLiteral("phi")}, {phi.constData()}, r.data(), count))
+		return false;
 
-		(*xVector)[i] = r*cos(phi);
-		(*yVector)[i] = r*sin(phi);
+	for (int i = 0; i < count; i++) {
+		(*xVector)[i] = r.at(i)*cos(phi.at(i));
+		(*yVector)[i] = r.at(i)*sin(phi.at(i));
 	}
 
 	return true;
@@ -1654,30 +1712,13 @@ bool ExpressionParser::evaluateParametric(const QString& xexpr, const QString& y
 	const Range<double> range{min, max};
 	const double step = range.stepSize(count);
 
-	SET_NUMBER_LOCALE
-	for (int i = 0; i < count; i++) {
-		assign_symbol("t", range.start() + step * i);
-
-		double x = parse(qPrintable(xexpr), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	// try default locale if failing
-			x = parse(qPrintable(xexpr), "en_US");
-		if (parse_errors() > 0)
-			return false;
-
-		double y = parse(qPrintable(yexpr), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	// try default locale if failing
-			y = parse(qPrintable(yexpr), "en_US");
-		if (parse_errors() > 0)
-			return false;
-
-		if (std::isnan(x))
-			WARN(Q_FUNC_INFO << ", WARNING: X expression " << STDSTRING(xexpr) << " evaluated @ " << range.start() + step * i << " is NAN")
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: Y expression " << STDSTRING(yexpr) << " evaluated @ " << range.start() + step * i << " is NAN")
+	QVector<double> t(count);
+	for (int i = 0; i < count; i++)
+		t[i] = range.start() + step * i;
 
-		(*xVector)[i] = x;
-		(*yVector)[i] = y;
-	}
+	const QStringList vars{QStringLiteral("t")};
+	if (!evaluate(xexpr, vars, {t.constData()}, xVector->data(), count))
+		return false;
 
-	return true;
+	return evaluate(yexpr, vars, {t.constData()}, yVector->data(), count);
 }
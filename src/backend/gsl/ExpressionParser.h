@@ -14,9 +14,11 @@
 
 #include "backend/lib/Range.h"
 #include "backend/worksheet/plots/cartesian/XYEquationCurve.h"
+#include <QMutex>
+#include <QStringList>
 #include <QVector>
 
-class QStringList;
+struct parser_context;
 
 class ExpressionParser {
 
@@ -35,7 +37,7 @@ public:
 	bool evaluateCartesian(const QString& expr, QVector<double>* xVector, QVector<double>* yVector);
 	bool evaluateCartesian(const QString& expr, QVector<double>* xVector, QVector<double>* yVector,
 					const QStringList& paramNames, const QVector<double>& paramValues);
-	bool evaluateCartesian(const QString& expr, const QStringList& vars, const QVector<QVector<double>*>& xVectors, QVector<double>* yVector);
+	bool evaluateCartesian(const QString& expr, const QStringList& vars, const QVector<const QVector<double>*>& xVectors, QVector<double>* yVector);
 	bool evaluatePolar(const QString& expr, const QString& min, const QString& max,
 					int count, QVector<double>* xVector, QVector<double>* yVector);
 	bool evaluateParametric(const QString& expr1, const QString& expr2, const QString& min, const QString& max,
@@ -59,6 +61,11 @@ private:
 
 	void initFunctions();
 	void initConstants();
+	bool evaluate(const QString& expr, const QStringList& vars, const QVector<const double*>& varData, double* result, int count,
+					const QStringList& paramNames = QStringList(), const QVector<double>& paramValues = QVector<double>());
+	parser_context* acquireContext();
+	void releaseContext(parser_context*);
+	static bool usesRandomFunctions(const QString& expr);
 
 	static ExpressionParser* m_instance;
 
@@ -73,5 +80,8 @@ private:
 	QStringList m_constantsValues;
 	QStringList m_constantsUnits;
 	QVector<int> m_constantsGroupIndex;
+
+	QMutex m_contextMutex;
+	QVector<parser_context*> m_contexts;	// parser contexts for reuse in evaluate()
 };
 #endif
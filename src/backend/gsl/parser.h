@@ -12,6 +12,8 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <stddef.h>
+
 /* uncomment to enable parser specific debugging */
 /* #define PDEBUG 1 */
 
@@ -48,6 +50,36 @@ typedef double (*func_t2) (double, double);
 typedef double (*func_t3) (double, double, double);
 typedef double (*func_t4) (double, double, double, double);
 
+/* byte code of a compiled expression (postfix notation) */
+enum parser_op {
+	OP_CONST,	/* push constant value */
+	OP_VAR,		/* push variable from slot */
+	OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_POW,
+	OP_NEG, OP_ABS, OP_FACT,
+	OP_FNCT0, OP_FNCT1, OP_FNCT2, OP_FNCT3, OP_FNCT4	/* call function with 0-4 arguments */
+};
+
+typedef struct parser_instr {
+	int op;		/* operation (parser_op) */
+	int slot;	/* variable slot of OP_VAR */
+	double value;	/* value of OP_CONST */
+	func_t fnct;	/* function of OP_FNCT* */
+} parser_instr;
+
+typedef struct parser_prog {
+	parser_instr *code;	/* instructions */
+	int size;		/* number of instructions */
+	int capacity;		/* allocated number of instructions */
+	const char *const *vars;	/* names of the variables bound to slots (while compiling) */
+	int nvars;		/* number of variable slots */
+	int depth;		/* current stack depth (while compiling) */
+	int max_depth;		/* needed stack depth for evaluation */
+	int compilable;		/* 0 if the expression can't be evaluated as byte code (e.g. assignment) */
+} parser_prog;
+
+/* number of rows evaluated per instruction */
+#define PARSER_BLOCK_SIZE 256
+
 /* structure for list of symbols */
 typedef struct symbol {
 	char *name;	/* name of symbol */
@@ -59,6 +91,28 @@ typedef struct symbol {
 	struct symbol *next;	/* next symbol */
 } symbol;
 
+/* parser context: symbol table and error state.
+   Different contexts can be used in parallel (one per thread) */
+typedef struct parser_context {
+	symbol *symbol_table;	/* symbol table (as linked list) */
+	int errors;		/* number of errors of the last parse */
+	symbol *initial_table;	/* start of the table with the functions and constants only */
+} parser_context;
+
+parser_context* create_context(void);	/* create context with all functions and constants */
+void free_context(parser_context *ctx);
+void reset_context(parser_context *ctx);	/* remove the assigned symbols to reuse the context */
+int context_parse_errors(const parser_context *ctx);
+symbol* context_assign_symbol(parser_context *ctx, const char* symbol_name, double value);
+int context_remove_symbol(parser_context *ctx, const char* symbol_name);
+double context_parse(parser_context *ctx, const char *string, const char *locale);
+parser_prog* context_compile_with_vars(parser_context *ctx, const char *str, const char *const vars[], int nvars, const char *locale);
+/* evaluate compiled expression for n rows with data of variable i in vars[i]. Returns 0 on success.
+   A compiled expression can be evaluated in parallel on different row ranges */
+int eval_prog(const parser_prog *prog, const double *const vars[], double *result, size_t n);
+void free_prog(parser_prog *prog);
+
+/* functions using the global context (not thread-safe) */
 void init_table(void);		/* initialize symbol table */
 void delete_table(void);	/* delete symbol table */
 int parse_errors(void);
@@ -66,6 +120,8 @@ symbol* assign_symbol(const char* symbol_name, double value);
 int remove_symbol(const char* symbol_name);
 double parse(const char *string, const char *locale);
 double parse_with_vars(const char[], const parser_var[], int nvars, const char* locale);
+/* compile expression with variables vars[0..nvars-1]. Returns NULL on parse errors or if the expression can't be compiled */
+parser_prog* compile_with_vars(const char *str, const char *const vars[], int nvars, const char *locale);
 
 extern struct cons _constants[];
 extern struct funs _functions[];
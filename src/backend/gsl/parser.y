@@ -13,6 +13,7 @@
 #include <ctype.h>
 #include <stdlib.h>
 #include <locale.h>
+#include <limits.h>
 #ifdef HAVE_XLOCALE
 #include <xlocale.h>
 #endif
@@ -39,14 +40,23 @@ typedef struct param {
 	size_t pos;		/* current position in string */
 	char* string;		/* the string to parse */
 	const char* locale;	/* name of locale to convert numbers */
+	parser_context* ctx;	/* symbol table and error state */
+	parser_prog* prog;	/* byte code to emit when compiling (or NULL) */
+	double result;		/* result of the last expression */
+	char* symbol_name;	/* buffer for reading symbol names */
+	int length;		/* size of symbol_name */
 } param;
 
-int yyerror(param *p, const char *err);
-int yylex(param *p);
+static void emit(param *p, int op, double value, func_t fnct);
+static void emit_symbol(param *p, const symbol *s);
+static double mod(double a, double b);
 
-double res;
+/* value of an expression, only calculated when interpreting.
+ * When compiling, all variables are 0 and the functions must not be called (division by zero, random numbers). */
+#define VALUE(x) (p->prog ? 0. : (x))
 %}
 
+%define api.pure full
 %lex-param {param *p}
 %parse-param {param *p}
 
@@ -65,51 +75,61 @@ symbol *tptr;   /* For returning symbol-table pointers */
 %left NEG     /* Negation--unary minus */
 %right '^' '!'
 
+%code {
+int yyerror(param *p, const char *err);
+int yylex(YYSTYPE *lvalp, param *p);
+}
+
 %%
 input:   /* empty */
 	| input line
 ;
 
 line:	'\n'
-	| expr '\n'   { res=$1; }
+	| expr '\n'   { p->result = $1; }
 	| error '\n' { yyerrok; }
 ;
 
-expr:      NUM       { $$ = $1;                            }
-| VAR                { $$ = $1->value.var;                 }
-| VAR '=' expr       { $$ = $3; $1->value.var = $3;        }
-| FNCT '(' ')'       { $$ = (*($1->value.fnctptr))();      }
-| FNCT '(' expr ')'  { $$ = (*((func_t1)($1->value.fnctptr)))($3); }
-| FNCT '(' expr ',' expr ')'  { $$ = (*((func_t2)($1->value.fnctptr)))($3,$5); }
-| FNCT '(' expr ',' expr ','expr ')'  { $$ = (*((func_t3)($1->value.fnctptr)))($3,$5,$7); }
-| FNCT '(' expr ',' expr ',' expr ','expr ')'  { $$ = (*((func_t4)($1->value.fnctptr)))($3,$5,$7,$9); }
-| FNCT '(' expr ';' expr ')'  { $$ = (*((func_t2)($1->value.fnctptr)))($3,$5); }
-| FNCT '(' expr ';' expr ';'expr ')'  { $$ = (*((func_t3)($1->value.fnctptr)))($3,$5,$7); }
-| FNCT '(' expr ';' expr ';' expr ';'expr ')'  { $$ = (*((func_t4)($1->value.fnctptr)))($3,$5,$7,$9); }
-| expr '+' expr      { $$ = $1 + $3;                       }
-| expr '-' expr      { $$ = $1 - $3;                       }
-| expr '*' expr      { $$ = $1 * $3;                       }
-| expr '/' expr      { $$ = $1 / $3;                       }
-| expr '%' expr      { $$ = (int)($1) % (int)($3);         }
-| '-' expr  %prec NEG{ $$ = -$2;                           }
-| expr '^' expr      { $$ = pow($1, $3);                   }
-| expr '*' '*' expr  { $$ = pow($1, $4);                   }
+expr:      NUM       { $$ = $1; emit(p, OP_CONST, $1, 0);  }
+| VAR                { $$ = $1->value.var; emit_symbol(p, $1); }
+| VAR '=' expr       { $$ = $3; $1->value.var = $3; if (p->prog) p->prog->compilable = 0; }
+| FNCT '(' ')'       { $$ = VALUE((*($1->value.fnctptr))()); emit(p, OP_FNCT0, 0, $1->value.fnctptr); }
+| FNCT '(' expr ')'  { $$ = VALUE((*((func_t1)($1->value.fnctptr)))($3)); emit(p, OP_FNCT1, 0, $1->value.fnctptr); }
+| FNCT '(' expr ',' expr ')'  { $$ = VALUE((*((func_t2)($1->value.fnctptr)))($3,$5)); emit(p, OP_FNCT2, 0, $1->value.fnctptr); }
+| FNCT '(' expr ',' expr ','expr ')'  { $$ = VALUE((*((func_t3)($1->value.fnctptr)))($3,$5,$7)); emit(p, OP_FNCT3, 0, $1->value.fnctptr); }
+| FNCT '(' expr ',' expr ',' expr ','expr ')'  { $$ = VALUE((*((func_t4)($1->value.fnctptr)))($3,$5,$7,$9)); emit(p, OP_FNCT4, 0, $1->value.fnctptr); }
+| FNCT '(' expr ';' expr ')'  { $$ = VALUE((*((func_t2)($1->value.fnctptr)))($3,$5)); emit(p, OP_FNCT2, 0, $1->value.fnctptr); }
+| FNCT '(' expr ';' expr ';'expr ')'  { $$ = VALUE((*((func_t3)($1->value.fnctptr)))($3,$5,$7)); emit(p, OP_FNCT3, 0, $1->value.fnctptr); }
+| FNCT '(' expr ';' expr ';' expr ';'expr ')'  { $$ = VALUE((*((func_t4)($1->value.fnctptr)))($3,$5,$7,$9)); emit(p, OP_FNCT4, 0, $1->value.fnctptr); }
+| expr '+' expr      { $$ = $1 + $3; emit(p, OP_ADD, 0, 0);  }
+| expr '-' expr      { $$ = $1 - $3; emit(p, OP_SUB, 0, 0);  }
+| expr '*' expr      { $$ = $1 * $3; emit(p, OP_MUL, 0, 0);  }
+| expr '/' expr      { $$ = VALUE($1 / $3); emit(p, OP_DIV, 0, 0);  }
+| expr '%' expr      { $$ = VALUE(mod($1, $3)); emit(p, OP_MOD, 0, 0); }
+| '-' expr  %prec NEG{ $$ = -$2; emit(p, OP_NEG, 0, 0);      }
+| expr '^' expr      { $$ = VALUE(pow($1, $3)); emit(p, OP_POW, 0, 0); }
+| expr '*' '*' expr  { $$ = VALUE(pow($1, $4)); emit(p, OP_POW, 0, 0); }
 | '(' expr ')'       { $$ = $2;                            }
-| '|' expr '|'       { $$ = fabs($2);                      }
-| expr '!'           { $$ = gsl_sf_fact((unsigned int)$1); }
+| '|' expr '|'       { $$ = fabs($2); emit(p, OP_ABS, 0, 0); }
+| expr '!'           { $$ = VALUE(gsl_sf_fact((unsigned int)$1)); emit(p, OP_FACT, 0, 0); }
 /* logical operators (!,&&,||) are not supported */
 ;
 
 %%
 
-/* global symbol table (as linked list) */
-symbol *symbol_table = 0;
+/* global context used by the functions without context argument */
+static parser_context global_context = { 0, 0, 0 };
+
+int context_parse_errors(const parser_context *ctx) {
+	return ctx->errors;
+}
 
 int parse_errors(void) {
-	return yynerrs;
+	return context_parse_errors(&global_context);
 }
 
 int yyerror(param *p, const char *s) {
+	p->ctx->errors++;
 	/* remove trailing newline */
 	p->string[strcspn(p->string, "\n")] = 0;
 	printf("PARSER ERROR: %s @ position %d of string '%s'\n", s, (int)(p->pos), p->string);
@@ -118,7 +138,7 @@ int yyerror(param *p, const char *s) {
 }
 
 /* save symbol in symbol table (at start of linked list) */
-symbol* put_symbol(const char *symbol_name, int symbol_type) {
+static symbol* put_symbol(parser_context *ctx, const char *symbol_name, int symbol_type) {
 /*	pdebug("PARSER: put_symbol(): symbol_name = '%s'\n", symbol_name); */
 
 	symbol *ptr = (symbol *)malloc(sizeof(symbol));
@@ -126,8 +146,8 @@ symbol* put_symbol(const char *symbol_name, int symbol_type) {
 	strcpy(ptr->name, symbol_name);
 	ptr->type = symbol_type;
 	ptr->value.var = 0;	/* set value to 0 even if fctn */
-	ptr->next = (symbol *)symbol_table;
-	symbol_table = ptr;
+	ptr->next = (symbol *)ctx->symbol_table;
+	ctx->symbol_table = ptr;
 	
 /*	pdebug("PARSER: put_symbol() DONE\n"); */
 	return ptr;
@@ -136,14 +156,14 @@ symbol* put_symbol(const char *symbol_name, int symbol_type) {
 /* remove symbol of name symbol_name from symbol table
    removes only variables of value 0
    returns 0 on success */
-int remove_symbol(const char *symbol_name) {
-	symbol* ptr = symbol_table;
+int context_remove_symbol(parser_context *ctx, const char *symbol_name) {
+	symbol* ptr = ctx->symbol_table;
 
 	/* check if head contains symbol */
 	if (ptr && (strcmp(ptr->name, symbol_name) == 0)) {
 		if (ptr->type == VAR && ptr->value.var == 0) {
 			pdebug("PARSER: REMOVING symbol '%s'\n", symbol_name);
-			symbol_table = ptr->next;
+			ctx->symbol_table = ptr->next;
 			free(ptr->name);
 			free(ptr);
 		}
@@ -170,13 +190,17 @@ int remove_symbol(const char *symbol_name) {
 	return 0;
 }
 
+int remove_symbol(const char *symbol_name) {
+	return context_remove_symbol(&global_context, symbol_name);
+}
+
 /* get symbol from symbol table
    returns 0 if symbol not found */
-symbol* get_symbol(const char *symbol_name) {
+static symbol* get_symbol(const parser_context *ctx, const char *symbol_name) {
 	pdebug("PARSER: get_symbol(): symbol_name = '%s'\n", symbol_name);
 	
 	symbol *ptr;
-	for (ptr = symbol_table; ptr != 0; ptr = (symbol *)ptr->next) {
+	for (ptr = ctx->symbol_table; ptr != 0; ptr = (symbol *)ptr->next) {
 		/* pdebug("%s ", ptr->name); */
 		if (strcmp(ptr->name, symbol_name) == 0) {
 			pdebug("PARSER:		SYMBOL FOUND\n");
@@ -189,47 +213,102 @@ symbol* get_symbol(const char *symbol_name) {
 }
 
 /* initialize symbol table with all known functions and constants */
-void init_table(void) {
+static void init_context_table(parser_context *ctx) {
 	pdebug("PARSER: init_table()\n");
 
 	symbol *ptr = 0;
 	int i;
 	/* add functions */
 	for (i = 0; _functions[i].name != 0; i++) {
-		ptr = put_symbol(_functions[i].name, FNCT);
+		ptr = put_symbol(ctx, _functions[i].name, FNCT);
 		ptr->value.fnctptr = _functions[i].fnct;
 	}
 	/* add constants */
 	for (i = 0; _constants[i].name != 0; i++) {
-		ptr = put_symbol(_constants[i].name, VAR);
+		ptr = put_symbol(ctx, _constants[i].name, VAR);
 		ptr->value.var = _constants[i].value;
 	}
+	ctx->initial_table = ctx->symbol_table;
 
 	pdebug("PARSER: init_table() DONE. sym_table = %p\n", ptr);
 }
 
-void delete_table(void) {
+static void delete_context_table(parser_context *ctx) {
 	pdebug("PARSER: delete_table()\n");
-	while(symbol_table) {
-		symbol *tmp = symbol_table;
-		symbol_table = symbol_table->next;
+	while(ctx->symbol_table) {
+		symbol *tmp = ctx->symbol_table;
+		ctx->symbol_table = ctx->symbol_table->next;
+		free(tmp->name);
+		free(tmp);
+	}
+	ctx->initial_table = 0;
+}
+
+void init_table(void) {
+	init_context_table(&global_context);
+}
+
+void delete_table(void) {
+	delete_context_table(&global_context);
+}
+
+parser_context* create_context(void) {
+	parser_context *ctx = (parser_context *)malloc(sizeof(parser_context));
+	if (ctx == NULL)
+		return NULL;
+	ctx->symbol_table = 0;
+	ctx->errors = 0;
+	ctx->initial_table = 0;
+	init_context_table(ctx);
+
+	return ctx;
+}
+
+void free_context(parser_context *ctx) {
+	if (!ctx)
+		return;
+	delete_context_table(ctx);
+	free(ctx);
+}
+
+/* restore the symbol table created by init_context_table(): remove the symbols added
+   since (parameters, variables) and reset the constants that were assigned to */
+void reset_context(parser_context *ctx) {
+	symbol *ptr;
+	int i, n = 0;
+
+	while (ctx->symbol_table && ctx->symbol_table != ctx->initial_table) {
+		symbol *tmp = ctx->symbol_table;
+		ctx->symbol_table = ctx->symbol_table->next;
 		free(tmp->name);
 		free(tmp);
 	}
+	ctx->errors = 0;
+	if (!ctx->symbol_table) {	/* the initial table was removed */
+		init_context_table(ctx);
+		return;
+	}
+
+	/* the constants were added last and are at the start of the table in reverse order */
+	while (_constants[n].name != 0)
+		n++;
+	ptr = ctx->symbol_table;
+	for (i = n - 1; i >= 0 && ptr; i--, ptr = ptr->next)
+		ptr->value.var = _constants[i].value;
 }
 
 /* add new symbol with value or just set value if symbol is a variable */
-symbol* assign_symbol(const char* symbol_name, double value) {
+symbol* context_assign_symbol(parser_context *ctx, const char* symbol_name, double value) {
 	pdebug("PARSER: assign_symbol() : symbol_name = '%s', value = %g\n", symbol_name, value);
 
 	/* be sure that the symbol table has been initialized */
-	if (!symbol_table)
-		init_table();
+	if (!ctx->symbol_table)
+		init_context_table(ctx);
 
-	symbol* ptr = get_symbol(symbol_name);
+	symbol* ptr = get_symbol(ctx, symbol_name);
 	if (!ptr) {
 		pdebug("PARSER: calling putsymbol(): symbol_name = '%s'\n", symbol_name);
-		ptr = put_symbol(symbol_name, VAR);
+		ptr = put_symbol(ctx, symbol_name, VAR);
 	} else {
 		pdebug("PARSER: Symbol already assigned\n");
 	}
@@ -241,6 +320,10 @@ symbol* assign_symbol(const char* symbol_name, double value) {
 	return ptr;
 }
 
+symbol* assign_symbol(const char* symbol_name, double value) {
+	return context_assign_symbol(&global_context, symbol_name, value);
+}
+
 static int getcharstr(param *p) {
 	pdebug(" getcharstr() pos = %d\n", (int)(p->pos));
 
@@ -256,16 +339,20 @@ static void ungetcstr(size_t *pos) {
 		(*pos)--;
 }
 
-double parse(const char* string, const char* locale) {
-	pdebug("\nPARSER: parse('%s') len = %d\n********************************\n", string, (int)strlen(string));
-
+/* run the parser on string. Byte code is emitted into prog if not NULL */
+static double parse_string(parser_context* ctx, const char* string, const char* locale, parser_prog* prog) {
 	/* be sure that the symbol table has been initialized */
-	if (!symbol_table)
-		init_table();
+	if (!ctx->symbol_table)
+		init_context_table(ctx);
 
 	param p;
 	p.pos = 0;
 	p.locale = locale;
+	p.ctx = ctx;
+	p.prog = prog;
+	p.result = NAN;	/* default value */
+	p.symbol_name = 0;
+	p.length = 0;
 
 	/* leave space to terminate string by "\n\0" */
 	const size_t slen = strlen(string) + 2;
@@ -280,16 +367,27 @@ double parse(const char* string, const char* locale) {
 	p.string[strlen(string)+1] = '\0';	// end of string
 	/* pdebug("PARSER: Call yyparse() for \"%s\" (len = %d)\n", p.string, (int)strlen(p.string)); */
 
-	/* parameter for yylex */
-	res = NAN;	/* default value */
-	yynerrs = 0;	/* reset error count */
+	ctx->errors = 0;	/* reset error count */
 	yyparse(&p);
 
-	pdebug("PARSER: parse() DONE (result = %g, errors = %d)\n*******************************\n", res, parse_errors());
 	free(p.string);
 	p.string = 0;
+	free(p.symbol_name);
 
-	return res;
+	return p.result;
+}
+
+double context_parse(parser_context *ctx, const char* string, const char* locale) {
+	pdebug("\nPARSER: parse('%s') len = %d\n********************************\n", string, (int)strlen(string));
+
+	const double result = parse_string(ctx, string, locale, NULL);
+
+	pdebug("PARSER: parse() DONE (result = %g, errors = %d)\n*******************************\n", result, ctx->errors);
+	return result;
+}
+
+double parse(const char* string, const char* locale) {
+	return context_parse(&global_context, string, locale);
 }
 
 double parse_with_vars(const char *str, const parser_var *vars, int nvars, const char* locale) {
@@ -304,7 +402,248 @@ double parse_with_vars(const char *str, const parser_var *vars, int nvars, const
 	return parse(str, locale);
 }
 
-int yylex(param *p) {
+/******************** compiled expressions ********************/
+
+/* integer remainder of a and b, NAN if b is 0 or a value is not in the range of int */
+static double mod(double a, double b) {
+	if (!(fabs(a) <= INT_MAX && fabs(b) <= INT_MAX))
+		return NAN;
+	const int divisor = (int)b;
+	if (divisor == 0)
+		return NAN;
+	return (int)a % divisor;
+}
+
+/* append instruction to the byte code of p->prog (if compiling) */
+static void emit(param *p, int op, double value, func_t fnct) {
+	parser_prog* prog = p->prog;
+	if (!prog)
+		return;
+
+	if (prog->size == prog->capacity) {
+		const int capacity = prog->capacity > 0 ? 2 * prog->capacity : 16;
+		parser_instr* code = (parser_instr *)realloc(prog->code, capacity * sizeof(parser_instr));
+		if (code == NULL) {
+			printf("PARSER ERROR: Out of memory for byte code\n");
+			prog->compilable = 0;
+			return;
+		}
+		prog->code = code;
+		prog->capacity = capacity;
+	}
+
+	parser_instr* instr = &prog->code[prog->size++];
+	instr->op = op;
+	instr->slot = 0;
+	instr->value = value;
+	instr->fnct = fnct;
+
+	/* track the stack depth needed for evaluation */
+	switch (op) {
+	case OP_CONST:
+	case OP_VAR:
+	case OP_FNCT0:
+		prog->depth++;
+		break;
+	case OP_ADD:
+	case OP_SUB:
+	case OP_MUL:
+	case OP_DIV:
+	case OP_MOD:
+	case OP_POW:
+	case OP_FNCT2:
+		prog->depth--;
+		break;
+	case OP_FNCT3:
+		prog->depth -= 2;
+		break;
+	case OP_FNCT4:
+		prog->depth -= 3;
+		break;
+	}
+	if (prog->depth > prog->max_depth)
+		prog->max_depth = prog->depth;
+}
+
+/* variables of the program are loaded from their slot, all other symbols (constants, parameter) are constant */
+static void emit_symbol(param *p, const symbol *s) {
+	parser_prog* prog = p->prog;
+	if (!prog)
+		return;
+
+	int i;
+	for (i = 0; i < prog->nvars; i++) {
+		if (strcmp(prog->vars[i], s->name) == 0) {
+			emit(p, OP_VAR, 0, 0);
+			if (prog->compilable)
+				prog->code[prog->size - 1].slot = i;
+			return;
+		}
+	}
+
+	emit(p, OP_CONST, s->value.var, 0);
+}
+
+parser_prog* context_compile_with_vars(parser_context *ctx, const char *str, const char *const vars[], int nvars, const char *locale) {
+	pdebug("\nPARSER: compile_with_vars(\"%s\") len = %d\n", str, (int)strlen(str));
+
+	parser_prog* prog = (parser_prog *)calloc(1, sizeof(parser_prog));
+	if (prog == NULL)
+		return NULL;
+	prog->compilable = 1;
+	prog->nvars = nvars;
+
+	int i;
+	for (i = 0; i < nvars; i++)	/* make sure variables are known to the lexer */
+		context_assign_symbol(ctx, vars[i], 0.);
+	prog->vars = vars;
+
+	parse_string(ctx, str, locale, prog);
+	prog->vars = NULL;	/* only needed while compiling */
+
+	if (ctx->errors > 0 || !prog->compilable) {
+		pdebug("PARSER: compile_with_vars() FAILED (errors = %d)\n", ctx->errors);
+		free_prog(prog);
+		return NULL;
+	}
+
+	pdebug("PARSER: compile_with_vars() DONE (%d instructions, stack depth %d)\n", prog->size, prog->max_depth);
+	return prog;
+}
+
+parser_prog* compile_with_vars(const char *str, const char *const vars[], int nvars, const char *locale) {
+	return context_compile_with_vars(&global_context, str, vars, nvars, locale);
+}
+
+void free_prog(parser_prog *prog) {
+	if (!prog)
+		return;
+	free(prog->code);
+	free(prog);
+}
+
+/* evaluate the byte code instruction by instruction on blocks of PARSER_BLOCK_SIZE rows */
+int eval_prog(const parser_prog *prog, const double *const vars[], double *result, size_t n) {
+	if (prog->size == 0) {	/* empty expression */
+		size_t i;
+		for (i = 0; i < n; i++)
+			result[i] = NAN;
+		return 0;
+	}
+
+	double* stack = (double *)malloc(prog->max_depth * PARSER_BLOCK_SIZE * sizeof(double));
+	if (stack == NULL) {
+		printf("PARSER ERROR: Out of memory for evaluation stack\n");
+		return 1;
+	}
+
+	size_t start;
+	for (start = 0; start < n; start += PARSER_BLOCK_SIZE) {
+		const size_t m = (n - start < PARSER_BLOCK_SIZE) ? n - start : PARSER_BLOCK_SIZE;
+		double* top = stack - PARSER_BLOCK_SIZE;	/* top of stack (block of m values) */
+		double* a;	/* second value (for binary operations) */
+		size_t k;
+		int i;
+
+		for (i = 0; i < prog->size; i++) {
+			const parser_instr* instr = &prog->code[i];
+			switch (instr->op) {
+			case OP_CONST:
+				top += PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					top[k] = instr->value;
+				break;
+			case OP_VAR:
+				top += PARSER_BLOCK_SIZE;
+				memcpy(top, vars[instr->slot] + start, m * sizeof(double));
+				break;
+			case OP_ADD:
+				a = top - PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] += top[k];
+				top = a;
+				break;
+			case OP_SUB:
+				a = top - PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] -= top[k];
+				top = a;
+				break;
+			case OP_MUL:
+				a = top - PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] *= top[k];
+				top = a;
+				break;
+			case OP_DIV:
+				a = top - PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] /= top[k];
+				top = a;
+				break;
+			case OP_MOD:
+				a = top - PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] = mod(a[k], top[k]);
+				top = a;
+				break;
+			case OP_POW:
+				a = top - PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] = pow(a[k], top[k]);
+				top = a;
+				break;
+			case OP_NEG:
+				for (k = 0; k < m; k++)
+					top[k] = -top[k];
+				break;
+			case OP_ABS:
+				for (k = 0; k < m; k++)
+					top[k] = fabs(top[k]);
+				break;
+			case OP_FACT:
+				for (k = 0; k < m; k++)
+					top[k] = gsl_sf_fact((unsigned int)top[k]);
+				break;
+			case OP_FNCT0:
+				top += PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					top[k] = (*instr->fnct)();
+				break;
+			case OP_FNCT1:
+				for (k = 0; k < m; k++)
+					top[k] = (*((func_t1)instr->fnct))(top[k]);
+				break;
+			case OP_FNCT2:
+				a = top - PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] = (*((func_t2)instr->fnct))(a[k], top[k]);
+				top = a;
+				break;
+			case OP_FNCT3:
+				a = top - 2 * PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] = (*((func_t3)instr->fnct))(a[k], a[k + PARSER_BLOCK_SIZE], top[k]);
+				top = a;
+				break;
+			case OP_FNCT4:
+				a = top - 3 * PARSER_BLOCK_SIZE;
+				for (k = 0; k < m; k++)
+					a[k] = (*((func_t4)instr->fnct))(a[k], a[k + PARSER_BLOCK_SIZE], a[k + 2 * PARSER_BLOCK_SIZE], top[k]);
+				top = a;
+				break;
+			}
+		}
+
+		/* value of the last expression is on top of the stack */
+		memcpy(result + start, top, m * sizeof(double));
+	}
+
+	free(stack);
+	return 0;
+}
+
+int yylex(YYSTYPE *lvalp, param *p) {
 	pdebug("PARSER: YYLEX()");
 
 	/* get char and skip white space */
@@ -319,7 +658,7 @@ int yylex(param *p) {
 	/* check for non-ASCII chars */
 	if (!isascii(c)) {
 		pdebug(" non-ASCII character found. Giving up\n");
-		yynerrs++;
+		p->ctx->errors++;
 		return 0;
 	}
 	if (c == '\n') {
@@ -367,7 +706,7 @@ int yylex(param *p) {
 			return 0;
 
 		pdebug("PARSER:		Result = %g\n", result);
-		yylval.dval = result;
+		lvalp->dval = result;
 
                 p->pos += strlen(s) - strlen(remain);
 
@@ -377,24 +716,22 @@ int yylex(param *p) {
 	/* process symbol */
 	if (isalpha (c) || c == '.') {
 		pdebug("PARSER: Found SYMBOL (starts with alpha)\n");
-		static char *symbol_name = 0;
-		static int length = 0;
 		int i = 0;
 
 		/* Initially make the buffer long enough for a 10-character symbol name */
-		if (length == 0) {
-			length = 10;
-			symbol_name = (char *) malloc(length + 1);
+		if (p->length == 0) {
+			p->length = 10;
+			p->symbol_name = (char *) malloc(p->length + 1);
 		}
 
 		do {
 			pdebug("PARSER: Reading symbol .. ");
 			/* If buffer is full, make it bigger */
-			if (i == length) {
-				length *= 2;
-				symbol_name = (char *) realloc(symbol_name, length + 1);
+			if (i == p->length) {
+				p->length *= 2;
+				p->symbol_name = (char *) realloc(p->symbol_name, p->length + 1);
 			}
-			symbol_name[i++] = c;
+			p->symbol_name[i++] = c;
 			c = getcharstr(p);
 			pdebug("PARSER:		got '%c'\n", c);
 		}
@@ -403,18 +740,18 @@ int yylex(param *p) {
 
 		if (c != EOF)
 			ungetcstr(&(p->pos));
-		symbol_name[i] = '\0';
+		p->symbol_name[i] = '\0';
 
-		symbol *s = get_symbol(symbol_name);
+		symbol *s = get_symbol(p->ctx, p->symbol_name);
 		if(s == 0) {	/* symbol unknown */
-			pdebug("PARSER ERROR: Symbol '%s' UNKNOWN\n", symbol_name);
-			yynerrs++;
+			pdebug("PARSER ERROR: Symbol '%s' UNKNOWN\n", p->symbol_name);
+			p->ctx->errors++;
 			return 0;
 			/* old behavior: add symbol */
-			/* s = put_symbol(symbol_name, VAR); */
+			/* s = put_symbol(p->ctx, p->symbol_name, VAR); */
 		}
 
-		yylval.tptr = s;
+		lvalp->tptr = s;
 		return s->type;
 	}
 
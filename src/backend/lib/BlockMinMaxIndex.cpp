@@ -0,0 +1,151 @@
+/*
+    File                 : BlockMinMaxIndex.cpp
+    Project              : LabPlot
+    Description          : block-wise min/max index for range extrema of column values
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/lib/BlockMinMaxIndex.h"
+
+#include <QtMath>
+
+void BlockMinMaxIndex::clear() {
+	QMutexLocker locker(&m_mutex);
+	m_blocks = 0;
+	m_leaves = 0;
+	m_min.clear();
+	m_max.clear();
+	m_outdated.clear();
+	m_outdatedBlocks.clear();
+}
+
+/*!
+ * marks the blocks containing the rows \c first .. \c last as outdated.
+ */
+void BlockMinMaxIndex::invalidate(int first, int last) {
+	QMutexLocker locker(&m_mutex);
+	if (m_blocks == 0 || last < first)
+		return;
+
+	const int firstBlock = qMax(first, 0) / blockSize;
+	const int lastBlock = qMin(last / blockSize, m_blocks - 1);
+	for (int block = firstBlock; block <= lastBlock; ++block) {
+		if (!m_outdated[block]) {
+			m_outdated[block] = true;
+			m_outdatedBlocks << block;
+		}
+	}
+}
+
+/*!
+ * merges the extrema of the rows \c first .. \c last - 1 of the \c rowCount rows into \c min and \c max.
+ * \c scan determines the extrema of rows not covered by complete blocks and of outdated blocks.
+ */
+void BlockMinMaxIndex::minMax(int first, int last, int rowCount, const Scan& scan, double& min, double& max) {
+	first = qMax(first, 0);
+	last = qMin(last, rowCount);
+	if (first >= last)
+		return;
+
+	QMutexLocker locker(&m_mutex);
+	const int blocks = rowCount / blockSize;
+	if (blocks != m_blocks)
+		resize(blocks);
+
+	for (int block : m_outdatedBlocks)
+		updateBlock(block, scan);
+	m_outdatedBlocks.clear();
+
+	// complete blocks inside of the range
+	const int firstBlock = (first + blockSize - 1) / blockSize;
+	const int lastBlock = qMin(last / blockSize, m_blocks);	// excluded
+	if (firstBlock >= lastBlock) {
+		scan(first, last, min, max);
+		return;
+	}
+
+	// partial blocks at the borders
+	if (first < firstBlock * blockSize)
+		scan(first, firstBlock * blockSize, min, max);
+	if (lastBlock * blockSize < last)
+		scan(lastBlock * blockSize, last, min, max);
+
+	for (int l = firstBlock + m_leaves, r = lastBlock + m_leaves; l < r; l >>= 1, r >>= 1) {
+		if (l & 1) {
+			min = qMin(min, m_min.at(l));
+			max = qMax(max, m_max.at(l));
+			++l;
+		}
+		if (r & 1) {
+			--r;
+			min = qMin(min, m_min.at(r));
+			max = qMax(max, m_max.at(r));
+		}
+	}
+}
+
+/*!
+ * adjusts the index to \c blocks complete blocks. The extrema of the kept blocks remain valid,
+ * the added blocks are outdated.
+ */
+void BlockMinMaxIndex::resize(int blocks) {
+	int leaves = 1;
+	while (leaves < blocks)
+		leaves *= 2;
+
+	const int kept = qMin(m_blocks, blocks);
+	if (leaves != m_leaves) {
+		QVector<double> min(2 * leaves, qInf()), max(2 * leaves, -qInf());
+		for (int block = 0; block < kept; ++block) {
+			min[leaves + block] = m_min.at(m_leaves + block);
+			max[leaves + block] = m_max.at(m_leaves + block);
+		}
+		for (int i = leaves - 1; i > 0; --i) {
+			min[i] = qMin(min.at(2 * i), min.at(2 * i + 1));
+			max[i] = qMax(max.at(2 * i), max.at(2 * i + 1));
+		}
+		m_min.swap(min);
+		m_max.swap(max);
+		m_leaves = leaves;
+	} else {
+		// reset the removed blocks
+		for (int block = kept; block < m_blocks; ++block) {
+			int i = m_leaves + block;
+			m_min[i] = qInf();
+			m_max[i] = -qInf();
+			for (i >>= 1; i > 0; i >>= 1) {
+				m_min[i] = qMin(m_min.at(2 * i), m_min.at(2 * i + 1));
+				m_max[i] = qMax(m_max.at(2 * i), m_max.at(2 * i + 1));
+			}
+		}
+	}
+
+	// forget the removed outdated blocks, the added blocks are outdated
+	m_outdated.resize(blocks, true);
+	QVector<int> outdatedBlocks;
+	for (int block : m_outdatedBlocks) {
+		if (block < kept)
+			outdatedBlocks << block;
+	}
+	for (int block = kept; block < blocks; ++block)
+		outdatedBlocks << block;
+	m_outdatedBlocks.swap(outdatedBlocks);
+
+	m_blocks = blocks;
+}
+
+void BlockMinMaxIndex::updateBlock(int block, const Scan& scan) {
+	double min = qInf(), max = -qInf();
+	scan(block * blockSize, (block + 1) * blockSize, min, max);
+
+	int i = m_leaves + block;
+	m_min[i] = min;
+	m_max[i] = max;
+	for (i >>= 1; i > 0; i >>= 1) {
+		m_min[i] = qMin(m_min.at(2 * i), m_min.at(2 * i + 1));
+		m_max[i] = qMax(m_max.at(2 * i), m_max.at(2 * i + 1));
+	}
+	m_outdated[block] = false;
+}
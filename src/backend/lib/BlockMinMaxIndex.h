@@ -0,0 +1,57 @@
+/*
+    File                 : BlockMinMaxIndex.h
+    Project              : LabPlot
+    Description          : block-wise min/max index for range extrema of column values
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef BLOCKMINMAXINDEX_H
+#define BLOCKMINMAXINDEX_H
+
+#include <QMutex>
+#include <QVector>
+
+#include <functional>
+#include <vector>
+
+//! Block-wise min/max index (zone map) for the extrema of arbitrary row ranges
+/**
+ *	The rows are divided into blocks of \c blockSize rows. The extrema of all complete blocks
+ *	are kept in a segment tree, so the extrema of a row range are determined from O(log n) nodes
+ *	and at most two partial blocks at the borders of the range.
+ *
+ *	The index doesn't know the data, the extrema of rows are determined with the function
+ *	passed to \c minMax(). Changed rows mark their blocks as outdated in \c invalidate(),
+ *	the outdated blocks are updated with the next call of \c minMax().
+ *
+ *	The index is updated lazily in \c minMax(), which is also called for const queries and from
+ *	worker threads, so all functions are serialized with a mutex. \c minMax() calls the scan function
+ *	with the mutex locked, the scan function must not access the index.
+ */
+class BlockMinMaxIndex {
+public:
+	static const int blockSize = 4096;
+
+	//! determines the extrema of the rows first .. last - 1 and merges them into min and max
+	typedef std::function<void(int first, int last, double& min, double& max)> Scan;
+
+	void clear();
+	void invalidate(int first, int last);
+	void minMax(int first, int last, int rowCount, const Scan&, double& min, double& max);
+
+private:
+	void resize(int blocks);
+	void updateBlock(int block, const Scan&);
+
+	int m_blocks{0};	// number of complete blocks in the index
+	int m_leaves{0};	// number of leaves of the tree (power of two >= m_blocks)
+	QVector<double> m_min;	// segment tree of the minima, the leaves start at index m_leaves
+	QVector<double> m_max;	// segment tree of the maxima
+	std::vector<bool> m_outdated;	// blocks whose extrema need to be updated
+	QVector<int> m_outdatedBlocks;
+	QMutex m_mutex;
+};
+
+#endif
@@ -0,0 +1,358 @@
+/*
+    File                 : DateTimeParser.cpp
+    Project              : LabPlot
+    Description          : parser for date and time strings with a precompiled format
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "DateTimeParser.h"
+
+#include <QDateTime>
+#include <QString>
+
+#include <cstring>
+#include <limits>
+
+namespace {
+const qint64 msecsPerHour = 3600 * 1000;
+const qint64 msecsPerDay = 24 * msecsPerHour;
+
+bool isLeapYear(int year) {
+	return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(int year, int month) {
+	static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	return (month == 2 && isLeapYear(year)) ? 29 : days[month - 1];
+}
+
+// days since 1970-01-01 of the Gregorian date (H. Hinnant's days_from_civil()), year > 0
+qint64 daysFromCivil(int year, int month, int day) {
+	qint64 y = year;
+	if (month <= 2)
+		--y;
+	const qint64 era = y / 400;
+	const qint64 yoe = y - era * 400;
+	const qint64 doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+	const qint64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + doe - 719468;
+}
+
+/*!
+ * converts the local time \c msecs (milliseconds since epoch as if the local time was UTC) to UTC.
+ * The offset of the local time zone is determined once per hour and cached for the following values.
+ */
+bool localToUtc(qint64& msecs) {
+	static thread_local qint64 cachedHour = std::numeric_limits<qint64>::min();
+	static thread_local qint64 cachedOffset = 0;
+
+	qint64 hour = msecs / msecsPerHour;
+	if (msecs < 0 && msecs % msecsPerHour != 0)
+		--hour;
+	if (hour != cachedHour) {
+		const QDateTime utc = QDateTime::fromMSecsSinceEpoch(hour * msecsPerHour, Qt::UTC);
+		const QDateTime local(utc.date(), utc.time(), Qt::LocalTime);
+		if (!local.isValid())
+			return false;
+		cachedOffset = local.toMSecsSinceEpoch() - hour * msecsPerHour;
+		cachedHour = hour;
+	}
+
+	msecs += cachedOffset;
+	return true;
+}
+
+inline bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+}
+
+DateTimeParser::DateTimeParser(const QString& format) {
+	setFormat(format);
+}
+
+/*!
+ * compiles the Qt date and time \c format. Returns \c false if the format is not supported.
+ */
+bool DateTimeParser::setFormat(const QString& format) {
+	m_tokens.clear();
+	m_valid = false;
+	bool hasAmPm = false;
+
+	auto addLiteral = [this](const QString& literal) {
+		if (m_tokens.isEmpty() || m_tokens.last().field != Field::Literal)
+			m_tokens << Token{Field::Literal, 0, 0, QByteArray()};
+		m_tokens.last().literal += literal.toUtf8();
+	};
+
+	const int size = format.size();
+	int i = 0;
+	while (i < size) {
+		const QChar c = format.at(i);
+
+		// quoted text, two single quotes are a single quote
+		if (c == QLatin1Char('\'')) {
+			int end = i + 1;
+			if (end < size && format.at(end) == QLatin1Char('\'')) {
+				addLiteral(QStringLiteral("'"));
+				i = end + 1;
+				continue;
+			}
+			QString literal;
+			while (end < size) {
+				if (format.at(end) == QLatin1Char('\'')) {
+					if (end + 1 < size && format.at(end + 1) == QLatin1Char('\'')) {
+						literal += QLatin1Char('\'');
+						end += 2;
+						continue;
+					}
+					break;
+				}
+				literal += format.at(end++);
+			}
+			addLiteral(literal);
+			i = end + 1;
+			continue;
+		}
+
+		// AM/PM: "AP", "A", "ap" or "a"
+		if (c == QLatin1Char('a') || c == QLatin1Char('A')) {
+			++i;
+			if (i < size && (format.at(i) == QLatin1Char('p') || format.at(i) == QLatin1Char('P')))
+				++i;
+			m_tokens << Token{Field::AmPm, 0, 0, QByteArray()};
+			hasAmPm = true;
+			continue;
+		}
+
+		int count = 1;
+		while (i + count < size && format.at(i + count) == c)
+			++count;
+
+		const char letter = c.toLatin1();
+		switch (letter) {
+		case 'd':
+		case 'M':
+		case 'h':
+		case 'H':
+		case 'm':
+		case 's': {
+			if (count > 2)	// names of days and months
+				return false;
+			Field field;
+			switch (letter) {
+			case 'd':
+				field = Field::Day;
+				break;
+			case 'M':
+				field = Field::Month;
+				break;
+			case 'h':
+				field = Field::Hour12;
+				break;
+			case 'H':
+				field = Field::Hour;
+				break;
+			case 'm':
+				field = Field::Minute;
+				break;
+			default:
+				field = Field::Second;
+			}
+			m_tokens << Token{field, count, 2, QByteArray()};
+			break;
+		}
+		case 'y':
+			if (count == 2)
+				m_tokens << Token{Field::ShortYear, 2, 2, QByteArray()};
+			else if (count == 4)
+				m_tokens << Token{Field::Year, 4, 4, QByteArray()};
+			else
+				return false;
+			break;
+		case 'z':
+			if (count != 3)
+				return false;
+			m_tokens << Token{Field::Millisecond, 3, 3, QByteArray()};
+			break;
+		case 't':
+			if (count != 1)
+				return false;
+			m_tokens << Token{Field::TimeZone, 0, 0, QByteArray()};
+			break;
+		default:
+			addLiteral(format.mid(i, count));
+		}
+		i += count;
+	}
+
+	// "h" is the hour of the 24-hour clock if no AM/PM is given
+	if (!hasAmPm) {
+		for (auto& token : m_tokens)
+			if (token.field == Field::Hour12)
+				token.field = Field::Hour;
+	}
+
+	m_valid = !m_tokens.isEmpty();
+	return m_valid;
+}
+
+bool DateTimeParser::isValid() const {
+	return m_valid;
+}
+
+/*!
+ * parses the UTF-8 string between \c begin and \c end into the milliseconds since epoch \c msecs.
+ * Returns \c false if the string doesn't match the format or doesn't describe a valid date and time.
+ */
+bool DateTimeParser::parse(const char* begin, const char* end, qint64& msecs) const {
+	if (!m_valid)
+		return false;
+
+	int year = 2000;	// leap year to parse "Feb 29" if no year is given
+	int month = 1, day = 1, hour = 0, minute = 0, second = 0, millisecond = 0;
+	int pm = -1;
+	bool hasOffset = false;
+	int offset = 0;	// offset to UTC in seconds
+	const char* p = begin;
+
+	for (const auto& token : m_tokens) {
+		switch (token.field) {
+		case Field::Literal: {
+			const int length = token.literal.size();
+			if (end - p < length || memcmp(p, token.literal.constData(), length) != 0)
+				return false;
+			p += length;
+			break;
+		}
+		case Field::AmPm: {
+			if (end - p < 2 || (p[1] != 'm' && p[1] != 'M'))
+				return false;
+			if (p[0] == 'a' || p[0] == 'A')
+				pm = 0;
+			else if (p[0] == 'p' || p[0] == 'P')
+				pm = 1;
+			else
+				return false;
+			p += 2;
+			break;
+		}
+		case Field::TimeZone: {
+			hasOffset = true;
+			if (p < end && *p == 'Z') {
+				++p;
+				break;
+			}
+			bool utc = false;
+			if (end - p >= 3 && memcmp(p, "UTC", 3) == 0) {
+				p += 3;
+				utc = true;
+			}
+			if (p < end && (*p == '+' || *p == '-')) {
+				const int sign = (*p == '-') ? -1 : 1;
+				++p;
+				if (end - p < 2 || !isDigit(p[0]) || !isDigit(p[1]))
+					return false;
+				const int hours = (p[0] - '0') * 10 + (p[1] - '0');
+				p += 2;
+				int minutes = 0;
+				if (p < end && *p == ':')
+					++p;
+				if (end - p >= 2 && isDigit(p[0]) && isDigit(p[1])) {
+					minutes = (p[0] - '0') * 10 + (p[1] - '0');
+					p += 2;
+				}
+				if (hours > 14 || minutes > 59)
+					return false;
+				offset = sign * (hours * 3600 + minutes * 60);
+			} else if (!utc)
+				return false;
+			break;
+		}
+		default: {
+			int value = 0;
+			int digits = 0;
+			while (digits < token.maxDigits && p < end && isDigit(*p)) {
+				value = value * 10 + (*p - '0');
+				++digits;
+				++p;
+			}
+			if (digits < token.minDigits || digits == 0)
+				return false;
+
+			switch (token.field) {
+			case Field::Year:
+				year = value;
+				break;
+			case Field::ShortYear:
+				// interpret 2-digit years smaller than 50 as 20XX
+				year = (value < 50 ? 2000 : 1900) + value;
+				break;
+			case Field::Month:
+				month = value;
+				break;
+			case Field::Day:
+				day = value;
+				break;
+			case Field::Hour:
+			case Field::Hour12:
+				hour = value;
+				break;
+			case Field::Minute:
+				minute = value;
+				break;
+			case Field::Second:
+				second = value;
+				break;
+			case Field::Millisecond:
+				millisecond = value;
+				break;
+			case Field::Literal:
+			case Field::AmPm:
+			case Field::TimeZone:
+				break;
+			}
+		}
+		}
+	}
+
+	if (p != end)
+		return false;
+
+	if (pm != -1) {
+		for (const auto& token : m_tokens) {
+			if (token.field != Field::Hour12)
+				continue;
+			if (hour < 1 || hour > 12)
+				return false;
+			if (pm == 1 && hour < 12)
+				hour += 12;
+			else if (pm == 0 && hour == 12)
+				hour = 0;
+			break;
+		}
+	}
+
+	if (year == 0 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)
+			|| hour > 23 || minute > 59 || second > 59)
+		return false;
+
+	msecs = daysFromCivil(year, month, day) * msecsPerDay
+		+ ((hour * 60 + minute) * 60 + second) * 1000LL + millisecond;
+
+	if (hasOffset) {
+		msecs -= offset * 1000LL;
+		return true;
+	}
+	return localToUtc(msecs);
+}
+
+/*!
+ * parses \c string into the milliseconds since epoch \c msecs.
+ */
+bool DateTimeParser::parse(const QString& string, qint64& msecs) const {
+	const QByteArray utf8 = string.toUtf8();
+	return parse(utf8.constData(), utf8.constData() + utf8.size(), msecs);
+}
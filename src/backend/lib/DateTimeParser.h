@@ -0,0 +1,54 @@
+/*
+    File                 : DateTimeParser.h
+    Project              : LabPlot
+    Description          : parser for date and time strings with a precompiled format
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef DATETIMEPARSER_H
+#define DATETIMEPARSER_H
+
+#include <QByteArray>
+#include <QVector>
+
+class QString;
+
+//! Parses date and time strings into milliseconds since epoch with a precompiled format
+/**
+ * The Qt format string (e.g. "yyyy-MM-dd hh:mm:ss.zzz") is split into tokens once in setFormat(),
+ * the strings are then parsed directly from their UTF-8 bytes without creating QDateTime objects.
+ * The result is the same as for QDateTime::fromString() with the corrections of the ASCII import:
+ * a missing year is set to 2000 and two digit years smaller than 50 are interpreted as 20XX.
+ *
+ * Formats with locale dependent names of months and days (MMM, ddd, ...) are not supported,
+ * isValid() returns \c false for them and the strings have to be parsed with QDateTime::fromString().
+ * parse() returns \c false for strings not matching the format, the caller can fall back to
+ * QDateTime::fromString() in this case too.
+ */
+class DateTimeParser {
+public:
+	DateTimeParser() = default;
+	explicit DateTimeParser(const QString& format);
+
+	bool setFormat(const QString& format);
+	bool isValid() const;
+
+	bool parse(const char* begin, const char* end, qint64& msecs) const;
+	bool parse(const QString&, qint64& msecs) const;
+
+private:
+	enum class Field {Literal, Year, ShortYear, Month, Day, Hour, Hour12, Minute, Second, Millisecond, AmPm, TimeZone};
+	struct Token {
+		Field field;
+		int minDigits;
+		int maxDigits;
+		QByteArray literal;
+	};
+
+	QVector<Token> m_tokens;
+	bool m_valid{false};
+};
+
+#endif
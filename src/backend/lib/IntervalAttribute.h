@@ -15,6 +15,9 @@
 #include "Interval.h"
 #include <QVector>
 
+#include <algorithm>
+#include <limits>
+
 //! A class representing an interval-based attribute
 template<class T> class IntervalAttribute {
 public:
@@ -156,23 +159,49 @@ private:
 };
 
 //! A class representing an interval-based attribute (bool version)
+/**
+ * The set intervals are kept sorted, disjoint and not touching each other.
+ * This allows to look up rows with a binary search and to iterate over the runs
+ * of set and unset rows with nextSet() and nextUnset().
+ */
 template<> class IntervalAttribute<bool>
 {
 	public:
 		IntervalAttribute<bool>() {}
-		IntervalAttribute<bool>(const QVector< Interval<int> >& intervals) : m_intervals(intervals) {}
+		IntervalAttribute<bool>(const QVector< Interval<int> >& intervals)
+		{
+			for (const auto& iv : intervals)
+				setValue(iv, true);
+		}
 
 		void setValue(const Interval<int>& i, bool value=true)
 		{
 			if(value)
 			{
-				foreach(const Interval<int>& iv, m_intervals)
-					if(iv.contains(i))
-						return;
-
-				Interval<int>::mergeIntervalIntoList(&m_intervals, i);
+				// merge all intervals intersecting or touching i
+				int start = i.start();
+				int end = i.end();
+				int c = indexOf(start == std::numeric_limits<int>::min() ? start : start - 1);
+				int last = c;
+				while(last < m_intervals.size() && (end == std::numeric_limits<int>::max() || m_intervals.at(last).start() <= end + 1))
+				{
+					start = qMin(start, m_intervals.at(last).start());
+					end = qMax(end, m_intervals.at(last).end());
+					last++;
+				}
+				m_intervals.remove(c, last - c);
+				m_intervals.insert(c, Interval<int>(start, end));
 			} else { // unset
-				Interval<int>::subtractIntervalFromList(&m_intervals, i);
+				int c = indexOf(i.start());
+				while(c < m_intervals.size() && m_intervals.at(c).start() <= i.end())
+				{
+					const Interval<int> iv = m_intervals.at(c);
+					m_intervals.remove(c);
+					if(iv.start() < i.start())
+						m_intervals.insert(c++, Interval<int>(iv.start(), i.start() - 1));
+					if(iv.end() > i.end())
+						m_intervals.insert(c++, Interval<int>(i.end() + 1, iv.end()));
+				}
 			}
 		}
 
@@ -183,64 +212,69 @@ template<> class IntervalAttribute<bool>
 
 		bool isSet(int row) const
 		{
-			foreach(Interval<int> iv, m_intervals)
-				if(iv.contains(row))
-					return true;
-			return false;
+			if(m_intervals.isEmpty())
+				return false;
+			const int c = indexOf(row);
+			return (c < m_intervals.size() && m_intervals.at(c).start() <= row);
 		}
 
 		bool isSet(const Interval<int>& i) const
 		{
-			foreach(Interval<int> iv, m_intervals)
-				if(iv.contains(i))
-					return true;
-			return false;
+			if(m_intervals.isEmpty())
+				return false;
+			const int c = indexOf(i.start());
+			return (c < m_intervals.size() && m_intervals.at(c).contains(i));
 		}
 
-		void insertRows(int before, int count)
+		//! Returns the first set row not before \c row or std::numeric_limits<int>::max() if there is none
+		int nextSet(int row) const
 		{
-			QVector< Interval<int> > temp_list;
-			int c;
-			// first: split all intervals that contain 'before'
-			for(c=0; c<m_intervals.size(); c++)
-			{
-				if(m_intervals.at(c).contains(before))
-				{
-					temp_list = Interval<int>::split(m_intervals.at(c), before);
-					m_intervals.replace(c, temp_list.at(0));
-					if(temp_list.size()>1)
-						m_intervals.insert(c++, temp_list.at(1));
+			const int c = indexOf(row);
+			if(c == m_intervals.size())
+				return std::numeric_limits<int>::max();
+			return qMax(row, m_intervals.at(c).start());
+		}
 
-				}
-			}
-			// second: translate all intervals that start at 'before' or later
-			for(c=0; c<m_intervals.size(); c++)
+		//! Returns the first row not before \c row that is not set or std::numeric_limits<int>::max() if there is none
+		int nextUnset(int row) const
+		{
+			const int c = indexOf(row);
+			if(c < m_intervals.size() && m_intervals.at(c).start() <= row)
 			{
-				if(m_intervals.at(c).start() >= before)
-					m_intervals[c].translate(count);
+				const int end = m_intervals.at(c).end();
+				return end == std::numeric_limits<int>::max() ? end : end + 1;
 			}
+			return row;
+		}
 
+		void insertRows(int before, int count)
+		{
+			// first: split the interval that contains 'before'
+			int c = indexOf(before);
+			if(c < m_intervals.size() && m_intervals.at(c).start() < before)
+			{
+				const Interval<int> iv = m_intervals.at(c);
+				m_intervals[c].setEnd(before - 1);
+				m_intervals.insert(++c, Interval<int>(before, iv.end()));
+			}
+			// second: translate all intervals that start at 'before' or later
+			for(; c<m_intervals.size(); c++)
+				m_intervals[c].translate(count);
 		}
 
 		void removeRows(int first, int count)
 		{
-			int c;
 			// first: remove the relevant rows from all intervals
-			Interval<int>::subtractIntervalFromList(&m_intervals, Interval<int>(first, first+count-1));
+			setValue(Interval<int>(first, first+count-1), false);
 			// second: translate all intervals that start at 'first+count' or later
-			for(c=0; c<m_intervals.size(); c++)
-			{
-				if(m_intervals.at(c).start() >= first+count)
-					m_intervals[c].translate(-count);
-			}
-			// third: merge as many intervals as possible
-			for(c=m_intervals.size()-1; c>=0; c--)
+			int c = indexOf(first);
+			for(int cc=c; cc<m_intervals.size(); cc++)
+				m_intervals[cc].translate(-count);
+			// third: merge the intervals touching each other now
+			if(c > 0 && c < m_intervals.size() && m_intervals.at(c - 1).touches(m_intervals.at(c)))
 			{
-				Interval<int> iv = m_intervals.takeAt(c);
-				int size_before = m_intervals.size();
-				Interval<int>::mergeIntervalIntoList(&m_intervals, iv);
-				if(size_before == m_intervals.size()) // merge successful
-					c--;
+				m_intervals[c - 1].setEnd(m_intervals.at(c).end());
+				m_intervals.remove(c);
 			}
 		}
 
@@ -249,6 +283,14 @@ template<> class IntervalAttribute<bool>
 		void clear() { m_intervals.clear(); }
 
 	private:
+		//! Returns the index of the first interval not ending before \c row
+		int indexOf(int row) const
+		{
+			const auto it = std::lower_bound(m_intervals.cbegin(), m_intervals.cend(), row,
+							[](const Interval<int>& iv, int r) { return iv.end() < r; });
+			return static_cast<int>(it - m_intervals.cbegin());
+		}
+
 		QVector< Interval<int> > m_intervals;
 };
 
@@ -0,0 +1,144 @@
+/*
+    File                 : MinMaxPyramid.cpp
+    Project              : LabPlot
+    Description          : multi-resolution min/max index of a sequence of points
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/lib/MinMaxPyramid.h"
+
+#include <algorithm>
+
+void MinMaxPyramid::clear() {
+	m_size = 0;
+	m_levels.clear();
+}
+
+/*!
+ * updates the index for \c points where only the points starting at \c firstChanged were changed or appended
+ * since the last update. Only the groups containing these points are recalculated.
+ */
+void MinMaxPyramid::update(const QVector<QPointF>& points, int firstChanged) {
+	m_size = points.size();
+	firstChanged = qBound(0, firstChanged, m_size);
+
+	for (int level = 0; hasGroups(level); ++level) {
+		if (level == m_levels.size())
+			m_levels.resize(level + 1);
+
+		const int groups = m_size / groupSize(level);	// only complete groups
+		auto& minMax = m_levels[level];
+		const int firstGroup = qMin(firstChanged / groupSize(level), minMax.size() / 2);
+		minMax.resize(2 * groups);
+
+		for (int group = firstGroup; group < groups; ++group) {
+			int minIndex, maxIndex;
+			if (level == 0) {
+				const int start = group * baseGroupSize;
+				minIndex = maxIndex = start;
+				for (int i = start + 1; i < start + baseGroupSize; ++i) {
+					const double y = points.at(i).y();
+					if (y < points.at(minIndex).y())
+						minIndex = i;
+					if (y > points.at(maxIndex).y())
+						maxIndex = i;
+				}
+			} else {
+				// merge the two groups of the level below
+				const auto& lower = m_levels.at(level - 1);
+				minIndex = lower.at(4 * group);
+				maxIndex = lower.at(4 * group + 1);
+				if (points.at(lower.at(4 * group + 2)).y() < points.at(minIndex).y())
+					minIndex = lower.at(4 * group + 2);
+				if (points.at(lower.at(4 * group + 3)).y() > points.at(maxIndex).y())
+					maxIndex = lower.at(4 * group + 3);
+			}
+			minMax[2 * group] = minIndex;
+			minMax[2 * group + 1] = maxIndex;
+		}
+	}
+
+	// remove levels without complete groups
+	int levels = 0;
+	while (levels < m_levels.size() && hasGroups(levels))
+		++levels;
+	m_levels.resize(levels);
+}
+
+/*!
+ * returns the sorted indices of the points needed to draw the line through the points \c first .. \c last
+ * with groups of at most \c pointsPerGroup points. Returns an empty vector if no decimation is possible
+ * (less than \c baseGroupSize points per group), all points have to be drawn in this case.
+ *
+ * If \c singlePixel is given, only groups with all points on one pixel are reduced. The other groups are split
+ * into the groups of the level below, all points of a group of the first level are used if they are not on one pixel.
+ * This is needed for irregularly spaced points and nonlinear scales where the number of points per pixel varies.
+ */
+QVector<int> MinMaxPyramid::indices(int first, int last, int pointsPerGroup, const SinglePixel& singlePixel) const {
+	QVector<int> result;
+	first = qMax(first, 0);
+	last = qMin(last, m_size - 1);
+	if (pointsPerGroup < baseGroupSize || m_levels.isEmpty() || last - first < pointsPerGroup)
+		return result;
+
+	int level = 0;
+	while (level + 1 < m_levels.size() && groupSize(level + 1) <= pointsPerGroup)
+		++level;
+	const int size = groupSize(level);
+	const auto& minMax = m_levels.at(level);
+
+	// the groups completely inside of the range, the points outside of them are used as they are
+	const int firstGroup = (first + size - 1) / size;
+	const int lastGroup = qMin((last + 1) / size, minMax.size() / 2);	// exclusive
+	result.reserve(4 * (lastGroup - firstGroup) + 2 * size);
+
+	const int groupsStart = qMin(firstGroup * size, last + 1);
+	for (int i = first; i < groupsStart; ++i)
+		result << i;
+
+	for (int group = firstGroup; group < lastGroup; ++group)
+		appendGroup(level, group, singlePixel, result);
+
+	for (int i = qMax(lastGroup * size, groupsStart); i <= last; ++i)
+		result << i;
+
+	// remove duplicates (the extrema may coincide with the first or last point of the group)
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+
+	return result;
+}
+
+/*!
+ * appends the first, the minimal, the maximal and the last point of the group \c group of the level \c level to \c result
+ * if the group is on one pixel, otherwise the points of the two groups of the level below.
+ */
+void MinMaxPyramid::appendGroup(int level, int group, const SinglePixel& singlePixel, QVector<int>& result) const {
+	const int start = group * groupSize(level);
+	const int end = start + groupSize(level) - 1;
+	if (singlePixel && !singlePixel(start, end)) {
+		if (level == 0) {
+			for (int i = start; i <= end; ++i)
+				result << i;
+		} else {
+			appendGroup(level - 1, 2 * group, singlePixel, result);
+			appendGroup(level - 1, 2 * group + 1, singlePixel, result);
+		}
+		return;
+	}
+
+	const auto& minMax = m_levels.at(level);
+	const int minIndex = minMax.at(2 * group);
+	const int maxIndex = minMax.at(2 * group + 1);
+
+	result << start;
+	if (minIndex < maxIndex) {
+		result << minIndex;
+		result << maxIndex;
+	} else {
+		result << maxIndex;
+		result << minIndex;
+	}
+	result << end;
+}
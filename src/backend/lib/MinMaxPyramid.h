@@ -0,0 +1,51 @@
+/*
+    File                 : MinMaxPyramid.h
+    Project              : LabPlot
+    Description          : multi-resolution min/max index of a sequence of points
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef MINMAXPYRAMID_H
+#define MINMAXPYRAMID_H
+
+#include <QPointF>
+#include <QVector>
+
+#include <functional>
+
+//! Multi-resolution min/max index of a sequence of points for the level of detail when drawing lines (M4)
+/**
+ *	The points are divided into groups of \c baseGroupSize consecutive points on the first level,
+ *	every further level merges two groups of the level below. For every group the indices of the points
+ *	with the minimal and the maximal y value are stored.
+ *
+ *	\c indices() returns for a range of points the first, the last, the minimal and the maximal point
+ *	of the groups of the coarsest level with at most the given number of points per group.
+ *	Groups wider than a pixel (checked with the given function) are split into the groups of the levels below.
+ *	For points ordered in x, the line through these points covers the same pixels as the line through all points.
+ */
+class MinMaxPyramid {
+public:
+	static const int baseGroupSize = 8;
+
+	void clear();
+	void update(const QVector<QPointF>& points, int firstChanged = 0);
+	// returns true if the points first .. last are on one pixel
+	using SinglePixel = std::function<bool(int first, int last)>;
+
+	QVector<int> indices(int first, int last, int pointsPerGroup, const SinglePixel& = nullptr) const;
+
+	int size() const { return m_size; }
+
+private:
+	int groupSize(int level) const { return baseGroupSize << level; }
+	bool hasGroups(int level) const { return ((qint64)baseGroupSize << level) <= m_size; }	// at least one complete group
+	void appendGroup(int level, int group, const SinglePixel&, QVector<int>& result) const;
+
+	int m_size{0};	// number of points
+	QVector<QVector<int>> m_levels;	// indices of the minimal and maximal point of every group
+};
+
+#endif
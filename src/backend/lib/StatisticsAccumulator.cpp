@@ -0,0 +1,292 @@
+/*
+    File                 : StatisticsAccumulator.cpp
+    Project              : LabPlot
+    Description          : mergeable single pass accumulator for descriptive statistics
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/lib/StatisticsAccumulator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// number of values whose moments are calculated with two passes before merging them into the accumulated moments
+const int blockSize = 256;
+
+/*!
+ * quantile of the weighted values \c items (sorted) with the total weight \c count.
+ * Uses the same interpolation as gsl_stats_quantile_from_sorted_data().
+ */
+double weightedQuantile(const QVector<QPair<double, qint64>>& items, qint64 count, double p) {
+	if (count == 0)
+		return NAN;
+
+	const double index = p * (count - 1);
+	const qint64 lhs = (qint64)index;
+	const double delta = index - lhs;
+
+	// find the items with the ranks lhs and lhs + 1
+	qint64 rank = 0;
+	int i = 0;
+	while (rank + items.at(i).second <= lhs) {
+		rank += items.at(i).second;
+		++i;
+	}
+	const double lower = items.at(i).first;
+	if (lhs == count - 1 || delta == 0.)
+		return lower;
+
+	const double upper = (rank + items.at(i).second > lhs + 1) ? lower : items.at(i + 1).first;
+	return (1 - delta) * lower + delta * upper;
+}
+}
+
+void StatisticsAccumulator::Sum::add(double value) {
+	const double t = sum + value;
+	if (std::abs(sum) >= std::abs(value))
+		compensation += (sum - t) + value;
+	else
+		compensation += (value - t) + sum;
+	sum = t;
+}
+
+void StatisticsAccumulator::Sum::add(const Sum& other) {
+	add(other.sum);
+	compensation += other.compensation;
+}
+
+/**
+ * \class StatisticsAccumulator
+ * \brief Mergeable single pass accumulator for descriptive statistics
+ *
+ * \c sketchSize is the number of values kept per level of the quantile sketch.
+ * The memory used is of order sketchSize * log2(count/sketchSize),
+ * the rank error of the estimated quantiles is of order log2(count/sketchSize)/sketchSize.
+ */
+StatisticsAccumulator::StatisticsAccumulator(int sketchSize) : m_sketchSize(qMax(sketchSize, 2)) {
+	clear();
+}
+
+void StatisticsAccumulator::clear() {
+	m_count = 0;
+	m_min = qInf();
+	m_max = -qInf();
+	m_mean = 0.;
+	m_M2 = m_M3 = m_M4 = 0.;
+	m_sum = m_sumLog = m_sumInverse = m_sumSquare = Sum();
+	m_levels.clear();
+	m_levels.resize(1);
+	m_compactOdd = false;
+}
+
+void StatisticsAccumulator::add(double value) {
+	add(&value, 1);
+}
+
+/*!
+ * adds the \c size values in \c data. The values are expected to be valid (not NAN).
+ */
+void StatisticsAccumulator::add(const double* data, int size) {
+	for (int start = 0; start < size; start += blockSize) {
+		const int n = qMin(blockSize, size - start);
+		const double* x = data + start;
+
+		double sum = 0.;
+		for (int i = 0; i < n; ++i) {
+			const double value = x[i];
+			if (value < m_min)
+				m_min = value;
+			if (value > m_max)
+				m_max = value;
+			sum += value;
+			m_sum.add(value);
+			m_sumLog.add(std::log(value));
+			m_sumInverse.add(1. / value);
+			m_sumSquare.add(value * value);
+
+			m_levels[0] << value;
+			if (m_levels.at(0).size() >= m_sketchSize)
+				compact(0);
+		}
+
+		// central moments of the block and merge with the accumulated moments (Pébay, 2008)
+		const double blockMean = sum / n;
+		double M2 = 0., M3 = 0., M4 = 0.;
+		for (int i = 0; i < n; ++i) {
+			const double d = x[i] - blockMean;
+			const double d2 = d * d;
+			M2 += d2;
+			M3 += d2 * d;
+			M4 += d2 * d2;
+		}
+
+		const double na = m_count, nb = n;
+		const double count = na + nb;
+		const double delta = blockMean - m_mean;
+		const double delta2 = delta * delta;
+		m_M4 += M4 + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (count * count * count)
+			+ 6. * delta2 * (na * na * M2 + nb * nb * m_M2) / (count * count)
+			+ 4. * delta * (na * M3 - nb * m_M3) / count;
+		m_M3 += M3 + delta2 * delta * na * nb * (na - nb) / (count * count)
+			+ 3. * delta * (na * M2 - nb * m_M2) / count;
+		m_M2 += M2 + delta2 * na * nb / count;
+		m_mean += delta * nb / count;
+		m_count += n;
+	}
+}
+
+/*!
+ * merges the statistics of \c other (accumulated on different data) into this accumulator.
+ */
+void StatisticsAccumulator::merge(const StatisticsAccumulator& other) {
+	if (other.m_count == 0)
+		return;
+	if (m_count == 0) {
+		const int sketchSize = m_sketchSize;
+		*this = other;
+		m_sketchSize = sketchSize;
+	} else {
+		const double na = m_count, nb = other.m_count;
+		const double count = na + nb;
+		const double delta = other.m_mean - m_mean;
+		const double delta2 = delta * delta;
+		m_M4 += other.m_M4 + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (count * count * count)
+			+ 6. * delta2 * (na * na * other.m_M2 + nb * nb * m_M2) / (count * count)
+			+ 4. * delta * (na * other.m_M3 - nb * m_M3) / count;
+		m_M3 += other.m_M3 + delta2 * delta * na * nb * (na - nb) / (count * count)
+			+ 3. * delta * (na * other.m_M2 - nb * m_M2) / count;
+		m_M2 += other.m_M2 + delta2 * na * nb / count;
+		m_mean += delta * nb / count;
+		m_count += other.m_count;
+
+		m_min = qMin(m_min, other.m_min);
+		m_max = qMax(m_max, other.m_max);
+		m_sum.add(other.m_sum);
+		m_sumLog.add(other.m_sumLog);
+		m_sumInverse.add(other.m_sumInverse);
+		m_sumSquare.add(other.m_sumSquare);
+
+		if (m_levels.size() < other.m_levels.size())
+			m_levels.resize(other.m_levels.size());
+		for (int level = 0; level < other.m_levels.size(); ++level)
+			m_levels[level] << other.m_levels.at(level);
+	}
+
+	for (int level = 0; level < m_levels.size(); ++level) {
+		if (m_levels.at(level).size() >= m_sketchSize)
+			compact(level);
+	}
+}
+
+/*!
+ * sorts the values of \c level and moves every second of them with doubled weight to the next level.
+ * The total weight is preserved, an odd value remains in \c level.
+ */
+void StatisticsAccumulator::compact(int level) {
+	if (level + 1 >= m_levels.size())
+		m_levels.resize(level + 2);
+
+	auto& values = m_levels[level];
+	auto& next = m_levels[level + 1];
+	std::sort(values.begin(), values.end());
+
+	const int pairs = values.size() / 2;
+	const int offset = m_compactOdd ? 1 : 0;
+	m_compactOdd = !m_compactOdd;
+	for (int i = 0; i < pairs; ++i)
+		next << values.at(2 * i + offset);
+
+	if (values.size() % 2)
+		values = QVector<double>{values.constLast()};
+	else
+		values.clear();
+
+	if (next.size() >= m_sketchSize)
+		compact(level + 1);
+}
+
+double StatisticsAccumulator::mean() const {
+	return m_count > 0 ? m_mean : NAN;
+}
+
+double StatisticsAccumulator::variance() const {
+	return m_count > 1 ? m_M2 / (m_count - 1) : NAN;
+}
+
+double StatisticsAccumulator::centralMoment(int order) const {
+	if (m_count == 0)
+		return NAN;
+
+	switch (order) {
+	case 2:
+		return m_M2 / m_count;
+	case 3:
+		return m_M3 / m_count;
+	case 4:
+		return m_M4 / m_count;
+	default:
+		return NAN;
+	}
+}
+
+double StatisticsAccumulator::geometricMean() const {
+	return m_count > 0 ? std::exp(m_sumLog.value() / m_count) : NAN;
+}
+
+double StatisticsAccumulator::harmonicMean() const {
+	return m_count > 0 ? m_count / m_sumInverse.value() : NAN;
+}
+
+double StatisticsAccumulator::contraharmonicMean() const {
+	return m_count > 0 ? m_sumSquare.value() / m_sum.value() : NAN;
+}
+
+QVector<QPair<double, qint64>> StatisticsAccumulator::weightedItems() const {
+	QVector<QPair<double, qint64>> items;
+	for (int level = 0; level < m_levels.size(); ++level) {
+		for (double value : m_levels.at(level))
+			items << qMakePair(value, (qint64)1 << level);
+	}
+	std::sort(items.begin(), items.end());
+
+	return items;
+}
+
+/*!
+ * returns the \c p quantile (0 <= p <= 1) of the values.
+ */
+double StatisticsAccumulator::quantile(double p) const {
+	return weightedQuantile(weightedItems(), m_count, p);
+}
+
+/*!
+ * returns the mean absolute deviation of the values around \c center.
+ */
+double StatisticsAccumulator::meanDeviation(double center) const {
+	if (m_count == 0)
+		return NAN;
+
+	Sum sum;
+	for (int level = 0; level < m_levels.size(); ++level) {
+		const double weight = (qint64)1 << level;
+		for (double value : m_levels.at(level))
+			sum.add(weight * std::abs(value - center));
+	}
+
+	return sum.value() / m_count;
+}
+
+/*!
+ * returns the median absolute deviation of the values around \c center.
+ */
+double StatisticsAccumulator::medianDeviation(double center) const {
+	auto items = weightedItems();
+	for (auto& item : items)
+		item.first = std::abs(item.first - center);
+	std::sort(items.begin(), items.end());
+
+	return weightedQuantile(items, m_count, 0.5);
+}
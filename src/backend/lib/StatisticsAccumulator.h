@@ -0,0 +1,73 @@
+/*
+    File                 : StatisticsAccumulator.h
+    Project              : LabPlot
+    Description          : mergeable single pass accumulator for descriptive statistics
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef STATISTICSACCUMULATOR_H
+#define STATISTICSACCUMULATOR_H
+
+#include <QVector>
+
+//! Single pass accumulator for descriptive statistics
+/**
+ *	Accumulates the count, the extrema, the central moments up to fourth order
+ *	(Welford/Pébay updates) and compensated sums for the geometric, harmonic and contraharmonic means.
+ *	Quantiles are estimated from a compacting sketch of bounded size (KLL/MRL like),
+ *	they are exact as long as not more than \c sketchSize values were added.
+ *
+ *	Accumulators of disjoint parts of the data (e.g. chunks processed in different threads
+ *	or rows appended to a live data source) can be combined with \c merge().
+ */
+class StatisticsAccumulator {
+public:
+	explicit StatisticsAccumulator(int sketchSize = 1024);
+
+	void clear();
+	void add(double);
+	void add(const double* data, int size);
+	void merge(const StatisticsAccumulator&);
+
+	qint64 count() const { return m_count; }
+	double minimum() const { return m_min; }
+	double maximum() const { return m_max; }
+	double mean() const;
+	double variance() const;	// sample variance
+	double centralMoment(int order) const;	// r-th central moment (1/n) sum (x - mean)^r, r = 2, 3, 4
+	double geometricMean() const;
+	double harmonicMean() const;
+	double contraharmonicMean() const;
+
+	// estimations from the sketch
+	double quantile(double p) const;
+	double meanDeviation(double center) const;
+	double medianDeviation(double center) const;
+
+private:
+	// Neumaier compensated summation
+	struct Sum {
+		void add(double);
+		void add(const Sum&);
+		double value() const { return sum + compensation; }
+		double sum{0.};
+		double compensation{0.};
+	};
+
+	void compact(int level);
+	QVector<QPair<double, qint64>> weightedItems() const;
+
+	int m_sketchSize;
+	qint64 m_count{0};
+	double m_min;
+	double m_max;
+	double m_mean{0.};
+	double m_M2{0.}, m_M3{0.}, m_M4{0.};
+	Sum m_sum, m_sumLog, m_sumInverse, m_sumSquare;
+	QVector<QVector<double>> m_levels;	// values in level h have the weight 2^h
+	bool m_compactOdd{false};	// alternates the elements kept when compacting
+};
+
+#endif
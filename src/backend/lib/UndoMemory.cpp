@@ -0,0 +1,40 @@
+/*
+    File                 : UndoMemory.cpp
+    Project              : LabPlot
+    Description          : memory accounting of undo commands
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/lib/UndoMemory.h"
+
+#include <QUndoCommand>
+
+/*!
+ * returns the size of the data held by the command and its child commands (macros) in bytes
+ */
+qint64 UndoMemory::memorySize(const QUndoCommand* command) {
+	qint64 size = 0;
+	const auto* memory = dynamic_cast<const UndoMemory*>(command);
+	if (memory)
+		size = memory->memorySize();
+
+	for (int i = 0; i < command->childCount(); ++i)
+		size += memorySize(command->child(i));
+
+	return size;
+}
+
+/*!
+ * releases the data of the command and its child commands.
+ * QUndoStack only provides const access to the commands on the stack, the command must not be undone or redone anymore.
+ */
+void UndoMemory::releaseMemory(const QUndoCommand* command) {
+	auto* memory = dynamic_cast<UndoMemory*>(const_cast<QUndoCommand*>(command));
+	if (memory)
+		memory->releaseMemory();
+
+	for (int i = 0; i < command->childCount(); ++i)
+		releaseMemory(command->child(i));
+}
@@ -0,0 +1,50 @@
+/*
+    File                 : UndoMemory.h
+    Project              : LabPlot
+    Description          : memory accounting of undo commands
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef UNDOMEMORY_H
+#define UNDOMEMORY_H
+
+#include <QString>
+#include <QVector>
+
+class QUndoCommand;
+
+//! Interface of undo commands holding copies of data to be able to undo and redo the changes
+/**
+ *	The commands report the size of the data they hold in \c memorySize().
+ *	When the undo history of the project exceeds the undo memory budget, the data of the oldest commands
+ *	is released with \c releaseMemory(). Released commands refuse to undo or redo the changes,
+ *	the project reverts undoing them in the undo history.
+ */
+class UndoMemory {
+public:
+	virtual ~UndoMemory() = default;
+
+	virtual qint64 memorySize() const = 0;
+	virtual void releaseMemory() = 0;
+
+	static qint64 memorySize(const QUndoCommand*);
+	static void releaseMemory(const QUndoCommand*);
+};
+
+//! approximate size of the values in bytes
+template<typename T>
+inline qint64 valuesMemorySize(const QVector<T>& values) {
+	return values.capacity() * static_cast<qint64>(sizeof(T));
+}
+
+template<>
+inline qint64 valuesMemorySize(const QVector<QString>& values) {
+	qint64 size = values.capacity() * static_cast<qint64>(sizeof(QString));
+	for (const auto& value : values)
+		size += value.capacity() * static_cast<qint64>(sizeof(QChar));
+	return size;
+}
+
+#endif
@@ -159,3 +159,18 @@ int XmlStreamReader::readAttributeInt(const QString& name, bool* ok) {
 
 	return str.toInt(ok);
 }
+
+/*!
+ * sets the reader of the binary project file containing the data blobs referenced in the XML.
+ * The reader is shared with the lazily loaded columns.
+ */
+void XmlStreamReader::setBinaryReader(const std::shared_ptr<BinaryProjectReader>& reader) {
+	m_binaryReader = reader;
+}
+
+/*!
+ * returns the reader of the binary project file or \c nullptr if the XML was not read from a binary project file.
+ */
+const std::shared_ptr<BinaryProjectReader>& XmlStreamReader::binaryReader() const {
+	return m_binaryReader;
+}
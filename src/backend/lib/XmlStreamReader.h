@@ -14,6 +14,9 @@
 
 #include <QXmlStreamReader>
 
+#include <memory>
+
+class BinaryProjectReader;
 class QString;
 class QStringList;
 
@@ -42,7 +45,11 @@ public:
 	bool skipToEndElement();
 	int readAttributeInt(const QString& name, bool* ok);
 
+	void setBinaryReader(const std::shared_ptr<BinaryProjectReader>&);
+	const std::shared_ptr<BinaryProjectReader>& binaryReader() const;
+
 private:
+	std::shared_ptr<BinaryProjectReader> m_binaryReader;
 	QStringList m_warnings;
 	QStringList m_missingCASPlugins;
 	bool m_failedCASMissing{false};
@@ -0,0 +1,62 @@
+/*
+    File                 : parallel.cpp
+    Project              : LabPlot
+    Description          : processing of data in parallel chunks
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/lib/parallel.h"
+
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+namespace {
+/* task processing one chunk */
+class ChunkTask : public QRunnable {
+public:
+	ChunkTask(const std::function<void(int, int)>& function, int start, int count, QSemaphore& done)
+		: m_function(function), m_start(start), m_count(count), m_done(done) {
+	}
+
+	void run() override {
+		m_function(m_start, m_count);
+		m_done.release();
+	}
+
+private:
+	const std::function<void(int, int)>& m_function;
+	int m_start;
+	int m_count;
+	QSemaphore& m_done;
+};
+}
+
+/*!
+ * calls \c function(start, count) for the chunks of \c chunkSize elements (the last one can be smaller)
+ * of the elements 0 .. \c count - 1 in the global thread pool and waits until all chunks are processed.
+ * The last chunk and the chunks not fitting into the pool (e.g. if called from a pool thread)
+ * are processed in the calling thread. The chunk starting at \c start has the index start / chunkSize.
+ * Returns the number of chunks.
+ */
+int runChunked(int count, int chunkSize, const std::function<void(int start, int count)>& function) {
+	if (count <= 0 || chunkSize <= 0)
+		return 0;
+
+	QThreadPool* pool = QThreadPool::globalInstance();
+	QSemaphore done;
+	int chunks = 0;
+	for (int start = 0; start < count; start += chunkSize) {
+		auto* task = new ChunkTask(function, start, qMin(chunkSize, count - start), done);
+		chunks++;
+		if (count - start <= chunkSize || !pool->tryStart(task)) {
+			task->run();
+			delete task;
+		}
+	}
+	done.acquire(chunks);
+
+	return chunks;
+}
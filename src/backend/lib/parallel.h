@@ -0,0 +1,17 @@
+/*
+    File                 : parallel.h
+    Project              : LabPlot
+    Description          : processing of data in parallel chunks
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+int runChunked(int count, int chunkSize, const std::function<void(int start, int count)>& function);
+
+#endif
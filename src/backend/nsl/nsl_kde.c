@@ -8,6 +8,10 @@
 */
 
 
+#include "nsl_kde.h"
+#include "nsl_common.h"
+#include "nsl_conv.h"
+#include "nsl_sf_kernel.h"
 #include <gsl/gsl_statistics.h>
 #include <gsl/gsl_sort.h>
 #include <gsl/gsl_randist.h>
@@ -17,7 +21,10 @@ double nsl_kde_gauss_kernel(double x) {
 	return exp(-(gsl_pow_2(x)/2)) / (M_SQRT2*sqrt(M_PI));
 }
 
-double nsl_kde(double* data, double x, double h, size_t n) {
+const char* nsl_kde_kernel_type_name[] = { i18n("Gauss"), i18n("uniform (rectangular)"), i18n("triangular"), i18n("parabolic (Epanechnikov)"),
+		i18n("quartic (biweight)"), i18n("triweight"), i18n("tricube"), i18n("cosine") };
+
+double nsl_kde(const double* data, double x, double h, size_t n) {
 	double density = 0;
 	for (size_t i = 0; i < n; i++)
 		density += gsl_ran_gaussian_pdf((data[i] - x)/h, 1.) / (n * h);
@@ -25,6 +32,89 @@ double nsl_kde(double* data, double x, double h, size_t n) {
 	return density;
 }
 
+int nsl_kde_binned(const double* data, size_t n, double h, nsl_kde_kernel_type kernel, double xmin, double xmax, size_t m, double* density) {
+	if (n == 0 || m < 2 || h <= 0 || !(xmax > xmin))
+		return -1;
+
+	double (*k)(double) = NULL;
+	double support = 1.;	/* kernel support in units of h */
+	switch (kernel) {
+	case nsl_kde_kernel_gauss:
+		k = nsl_sf_kernel_gaussian;
+		support = 4.;	/* remaining weight < 1e-4 */
+		break;
+	case nsl_kde_kernel_uniform:
+		k = nsl_sf_kernel_uniform;
+		break;
+	case nsl_kde_kernel_triangular:
+		k = nsl_sf_kernel_triangular;
+		break;
+	case nsl_kde_kernel_parabolic:
+		k = nsl_sf_kernel_parabolic;
+		break;
+	case nsl_kde_kernel_quartic:
+		k = nsl_sf_kernel_quartic;
+		break;
+	case nsl_kde_kernel_triweight:
+		k = nsl_sf_kernel_triweight;
+		break;
+	case nsl_kde_kernel_tricube:
+		k = nsl_sf_kernel_tricube;
+		break;
+	case nsl_kde_kernel_cosine:
+		k = nsl_sf_kernel_cosine;
+		break;
+	}
+	if (k == NULL)
+		return -1;
+
+	const double delta = (xmax - xmin)/(double)(m - 1);
+	/* kernel weights on the grid offsets -l..l, wider kernels don't contribute to the grid points */
+	size_t l = (size_t)GSL_MIN(floor(support * h/delta), (double)(m - 1));
+	const size_t nk = 2 * l + 1, size = m + nk - 1;
+
+	double* counts = (double*)calloc(m, sizeof(double));
+	double* weights = (double*)malloc(nk * sizeof(double));
+	double* out = (double*)malloc(size * sizeof(double));
+	if (counts == NULL || weights == NULL || out == NULL) {
+		free(counts);
+		free(weights);
+		free(out);
+		return -1;
+	}
+
+	/* linear binning: each value is split between the two neighbouring grid points */
+	for (size_t i = 0; i < n; i++) {
+		const double pos = (data[i] - xmin)/delta;
+		if (!(pos >= 0 && pos <= (double)(m - 1)))	/* also skips NaN */
+			continue;
+		size_t j = (size_t)pos;
+		if (j == m - 1) {
+			counts[j] += 1.;
+			continue;
+		}
+		const double frac = pos - (double)j;
+		counts[j] += 1. - frac;
+		counts[j + 1] += frac;
+	}
+
+	for (size_t j = 0; j < nk; j++)
+		weights[j] = k(((double)j - (double)l) * delta/h) / h;
+
+	/* centered linear convolution: out[i] = sum_j counts[j] K((x_i - x_j)/h)/h */
+	int status = nsl_conv_convolution(counts, m, weights, nk, nsl_conv_type_linear, nsl_conv_method_auto, nsl_conv_norm_none, nsl_conv_wrap_center, out);
+	if (status == 0) {
+		for (size_t i = 0; i < m; i++)
+			density[i] = GSL_MAX(out[i], 0.) / (double)n;	/* FFT round-off can give tiny negative values */
+	}
+
+	free(counts);
+	free(weights);
+	free(out);
+
+	return status;
+}
+
 double nsl_kde_normal_dist_bandwith(double* data, int n) {
 	gsl_sort(data, 1, n);
 	const double sigma = gsl_stats_sd(data, 1, n);
@@ -11,9 +11,23 @@
 #ifndef NSL_KDE_H
 #define NSL_KDE_H
 
+#include <stdlib.h>
+
+/* kernels used for the binned estimation, see nsl_sf_kernel */
+#define NSL_KDE_KERNEL_TYPE_COUNT 8
+typedef enum {nsl_kde_kernel_gauss, nsl_kde_kernel_uniform, nsl_kde_kernel_triangular, nsl_kde_kernel_parabolic,
+	nsl_kde_kernel_quartic, nsl_kde_kernel_triweight, nsl_kde_kernel_tricube, nsl_kde_kernel_cosine} nsl_kde_kernel_type;
+extern const char* nsl_kde_kernel_type_name[];
+
 /* calculates the density at point x for the sample data with the bandwith h */
 double nsl_kde(const double* data, double x, double h, size_t n);
 
+/* calculates the density on the m equidistant points from xmin to xmax for the sample data with the bandwidth h.
+ * The data is linearly binned onto the grid and the bin counts are convolved with the kernel (FFT for large grids),
+ * the costs are O(n + m log m) instead of O(n m) for the direct sum. Data outside [xmin, xmax] is ignored.
+ * returns 0 on success, -1 on invalid arguments or if allocation failed */
+int nsl_kde_binned(const double* data, size_t n, double h, nsl_kde_kernel_type kernel, double xmin, double xmax, size_t m, double* density);
+
 /* calculates the "normal distribution approximation" bandwidth */
 double nsl_kde_normal_dist_bandwith(double* data, int n);
 
@@ -400,6 +400,46 @@ int Spreadsheet::colY(int col) {
 	return -1;
 }
 
+/*!
+ * sorts the rows with non-empty texts of the dictionary encoded column \c column with a counting sort of the dictionary codes.
+ * The dictionary is sorted, the order is the same as for std::stable_sort() of the pairs of texts and rows.
+ * The rows with empty texts are added to \c emptyIndex if given.
+ */
+static QVector<QPair<QString, int>> sortDictionaryRows(const Column* column, int rows, bool ascending, QVector<int>* emptyIndex = nullptr) {
+	const Column::DataPin pin(column);
+	const auto& dictionary = column->dictionary();
+	const auto& codes = column->dictionaryCodes();
+	auto code = [&](int row) {
+		const int c = codes.value(row, -1);
+		return (c >= 0 && !dictionary.at(c).isEmpty()) ? c : -1;
+	};
+
+	// start position of every code in the sorted rows
+	QVector<int> start(dictionary.size() + 1, 0);
+	for (int i = 0; i < rows; i++) {
+		const int c = code(i);
+		if (c >= 0)
+			++start[c + 1];
+		else if (emptyIndex)
+			*emptyIndex << i;
+	}
+	for (int c = 0; c < dictionary.size(); c++)
+		start[c + 1] += start[c];
+	const int filledRows = start.last();
+
+	// descending order is the reversed ascending order (QPair compares the rows of equal texts too)
+	QVector<QPair<QString, int>> map(filledRows);
+	for (int i = 0; i < rows; i++) {
+		const int c = code(i);
+		if (c < 0)
+			continue;
+		const int pos = start[c]++;
+		map[ascending ? pos : filledRows - 1 - pos] = QPair<QString, int>(dictionary.at(c), i);
+	}
+
+	return map;
+}
+
 /*! Sorts the given list of column.
   If 'leading' is a null pointer, each column is sorted separately.
 */
@@ -520,16 +560,20 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 			case AbstractColumn::ColumnMode::Text: {
 					QVector<QPair<QString, int>> map;
 
-					for (int i = 0; i < rows; i++)
-						if (!col->textAt(i).isEmpty())
-							map.append(QPair<QString, int>(col->textAt(i), i));
+					if (col->isDictionaryEncoded())
+						map = sortDictionaryRows(col, rows, ascending);
+					else {
+						for (int i = 0; i < rows; i++)
+							if (!col->textAt(i).isEmpty())
+								map.append(QPair<QString, int>(col->textAt(i), i));
+
+						if (ascending)
+							std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
+						else
+							std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
+					}
 					const int filledRows = map.size();
 
-					if (ascending)
-						std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-					else
-						std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-
 					// put the values in the right order into tempCol
 					for (int i = 0; i < filledRows; i++) {
 						int idx = map.at(i).second;
@@ -565,12 +609,21 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 				}
 			}
 			// copy the sorted column
+			const bool encoded = col->isDictionaryEncoded();
 			col->copy(tempCol.get(), 0, 0, rows);
+			if (encoded)
+				col->encodeDictionary();
 		}
 	} else { // sort with leading column
 		DEBUG("	sort with leading column")
 		int rows = leading->rowCount();
 
+		// the dictionary encoded texts are expanded when copying the sorted rows and encoded again afterwards
+		QVector<Column*> encodedCols;
+		for (auto* col : cols)
+			if (col->isDictionaryEncoded())
+				encodedCols << col;
+
 		switch (leading->columnMode()) {
 		case AbstractColumn::ColumnMode::Double: {
 				QVector<QPair<double, int>> map;
@@ -672,20 +725,24 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 				QVector<QPair<QString, int>> map;
 				QVector<int> emptyIndex;
 
-				for (int i = 0; i < rows; i++)
-					if (!leading->textAt(i).isEmpty())
-						map.append(QPair<QString, int>(leading->textAt(i), i));
+				if (leading->isDictionaryEncoded())
+					map = sortDictionaryRows(leading, rows, ascending, &emptyIndex);
+				else {
+					for (int i = 0; i < rows; i++)
+						if (!leading->textAt(i).isEmpty())
+							map.append(QPair<QString, int>(leading->textAt(i), i));
+						else
+							emptyIndex << i;
+
+					if (ascending)
+						std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
 					else
-						emptyIndex << i;
+						std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
+				}
 				//QDEBUG("	empty indices: " << emptyIndex)
 				const int filledRows = map.size();
 				const int emptyRows = emptyIndex.size();
 
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-
 				for (auto* col : cols) {
 					std::unique_ptr<Column> tempCol(new Column("temp", col->columnMode()));
 					// put the values in the right order into tempCol
@@ -759,6 +816,9 @@ void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, boo
 				break;
 			}
 		}
+
+		for (auto* col : encodedCols)
+			col->encodeDictionary();
 	}
 
 	endMacro();
@@ -973,8 +1033,10 @@ int Spreadsheet::prepareImport(std::vector<void*>& dataContainer, AbstractFileFi
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime: {
-			auto* vector = static_cast<QVector<QDateTime>* >(column->data());
+			// milliseconds since epoch of the local time, see Column::dateTimeToMSecs()
+			auto* vector = static_cast<QVector<qint64>*>(column->data());
 			vector->resize(actualRows);
+			column->setTimeSpec(Qt::LocalTime);
 			dataContainer[n] = static_cast<void*>(vector);
 			break;
 		}
@@ -1088,6 +1150,8 @@ void Spreadsheet::finalizeImport(size_t columnOffset, size_t startColumn, size_t
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			comment = i18np("text data, %1 element", "text data, %1 elements", rows);
+			// texts with few distinct values (categories, status strings, etc.) are stored dictionary encoded
+			column->encodeDictionary(true);
 			break;
 		case AbstractColumn::ColumnMode::Month:
 			comment = i18np("month data, %1 element", "month data, %1 elements", rows);
@@ -1106,7 +1170,8 @@ void Spreadsheet::finalizeImport(size_t columnOffset, size_t startColumn, size_t
 		if (importMode == AbstractFileFilter::ImportMode::Replace) {
 			column->setSuppressDataChangedSignal(false);
 			column->setChanged();
-		}
+		} else
+			column->invalidateProperties();	// the data was written directly, the cached extrema are outdated
 	}
 
 	if (importMode == AbstractFileFilter::ImportMode::Replace) {
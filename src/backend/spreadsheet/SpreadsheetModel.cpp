@@ -88,7 +88,26 @@ QModelIndex SpreadsheetModel::index(const QString& text) const {
 	const int colCount = m_spreadsheet->columnCount();
 	const int rowCount = m_spreadsheet->rowCount();
 	for (int col = 0; col < colCount; ++col) {
-		auto* column = m_spreadsheet->column(col)->asStringColumn();
+		const auto* c = m_spreadsheet->column(col);
+		const Column::DataPin pin(c);
+		if (c->isDictionaryEncoded()) {
+			// search the distinct values only once and compare the dictionary codes of the rows
+			const auto& dictionary = c->dictionary();
+			const auto& codes = c->dictionaryCodes();
+			QVector<bool> found(dictionary.size());
+			for (int i = 0; i < dictionary.size(); ++i)
+				found[i] = (dictionary.at(i).indexOf(text) != -1);
+			const bool nullFound = (QString().indexOf(text) != -1);
+			const int rows = qMin(rowCount, codes.size());
+			for (int row = 0; row < rows; ++row) {
+				const int code = codes.at(row);
+				if (code >= 0 ? found.at(code) : nullFound)
+					return createIndex(row, col);
+			}
+			continue;
+		}
+
+		auto* column = c->asStringColumn();
 		for (int row = 0; row < rowCount; ++row) {
 			if (column->textAt(row).indexOf(text) != -1)
 				return createIndex(row, col);
@@ -835,25 +835,19 @@ void BoxPlotPrivate::recalc(int index) {
 	const double outerFenceMax = statistics.thirdQuartile + 3.0*statistics.iqr;
 	const double outerFenceMin = statistics.firstQuartile - 3.0*statistics.iqr;
 
-	for (int row = 0; row < column->rowCount(); ++row) {
-		if (!column->isValid(row) || column->isMasked(row) )
+	// the values are read in blocks
+	const int rowCount = column->rowCount();
+	const int blockSize = 1024;
+	double values[blockSize];
+	bool valid[blockSize];
+	for (int row = 0; row < rowCount; ++row) {
+		const int i = row % blockSize;
+		if (i == 0)
+			column->valuesAt(row, qMin(blockSize, rowCount - row), values, valid);
+		if (!valid[i])
 			continue;
 
-		double value = 0.0;
-		switch (column->columnMode()) {
-		case AbstractColumn::ColumnMode::Double:
-		case AbstractColumn::ColumnMode::Integer:
-		case AbstractColumn::ColumnMode::BigInt:
-			value = column->valueAt(row);
-			break;
-		case AbstractColumn::ColumnMode::DateTime:
-			value = column->dateTimeAt(row).toMSecsSinceEpoch();
-			break;
-		case AbstractColumn::ColumnMode::Text:
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::Day:
-			break;
-		}
+		const double value = values[i];
 
 		double rand = 0.5;
 		if (jitteringEnabled)
@@ -1368,11 +1362,7 @@ void BoxPlotPrivate::drawSymbols(QPainter* painter, int index) {
 
 		path = trafo.map(path);
 
-		for (const auto& point : qAsConst(m_outlierPoints.at(index))) {
-			trafo.reset();
-			trafo.translate(point.x(), point.y());
-			painter->drawPath(trafo.map(path));
-		}
+		Symbol::draw(painter, path, m_outlierPoints.at(index));
 	}
 
 	//mean value
@@ -1388,9 +1378,7 @@ void BoxPlotPrivate::drawSymbols(QPainter* painter, int index) {
 
 		path = trafo.map(path);
 
-		trafo.reset();
-		trafo.translate(m_meanSymbolPoint.at(index).x(), m_meanSymbolPoint.at(index).y());
-		painter->drawPath(trafo.map(path));
+		Symbol::draw(painter, path, m_meanSymbolPoint.at(index));
 	}
 
 	//median value
@@ -1406,9 +1394,7 @@ void BoxPlotPrivate::drawSymbols(QPainter* painter, int index) {
 
 		path = trafo.map(path);
 
-		trafo.reset();
-		trafo.translate(m_medianSymbolPoint.at(index).x(), m_medianSymbolPoint.at(index).y());
-		painter->drawPath(trafo.map(path));
+		Symbol::draw(painter, path, m_medianSymbolPoint.at(index));
 	}
 
 	//jitter values
@@ -1424,11 +1410,7 @@ void BoxPlotPrivate::drawSymbols(QPainter* painter, int index) {
 
 		path = trafo.map(path);
 
-		for (const auto& point : qAsConst(m_dataPoints.at(index))) {
-			trafo.reset();
-			trafo.translate(point.x(), point.y());
-			painter->drawPath(trafo.map(path));
-		}
+		Symbol::draw(painter, path, m_dataPoints.at(index));
 	}
 
 	//far out values
@@ -1444,11 +1426,7 @@ void BoxPlotPrivate::drawSymbols(QPainter* painter, int index) {
 
 		path = trafo.map(path);
 
-		for (const auto& point : qAsConst(m_farOutPoints.at(index))) {
-			trafo.reset();
-			trafo.translate(point.x(), point.y());
-			painter->drawPath(trafo.map(path));
-		}
+		Symbol::draw(painter, path, m_farOutPoints.at(index));
 	}
 }
 
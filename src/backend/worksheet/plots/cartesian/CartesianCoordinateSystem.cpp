@@ -17,6 +17,8 @@ extern "C" {
 #include "backend/nsl/nsl_math.h"
 }
 
+#include <vector>
+
 /* ============================================================================ */
 /* ========================= coordinate system ================================ */
 /* ============================================================================ */
@@ -46,6 +48,9 @@ QString CartesianCoordinateSystem::info() const {
 //##############################################################################
 //######################### logical to scene mappers ###########################
 //##############################################################################
+// number of points mapped at once when mapping the points of a curve
+static const int mapBlockSize = 1024;
+
 Points CartesianCoordinateSystem::mapLogicalToScene(const Points& points, MappingFlags flags) const {
 	//DEBUG(Q_FUNC_INFO << ", (points with flags)")
 	const QRectF pageRect = d->plot->dataRect();
@@ -169,53 +174,71 @@ void CartesianCoordinateSystem::mapLogicalToScene(int startIndex, int endIndex,
 	if (numberOfPixelX <= 0 || numberOfPixelY <= 0)
 		return;
 
-	// eliminate multiple scene points (size (numberOfPixelX + 1) * (numberOfPixelY + 1))
-	QVector<QVector<bool>> scenePointsUsed(numberOfPixelX + 1);
-	for (auto& col: scenePointsUsed)
-		col.resize(numberOfPixelY + 1);
+	// eliminate multiple scene points with a bitmap of the pixels (size (numberOfPixelX + 1) * (numberOfPixelY + 1)).
+	// The curves are mapped concurrently, each thread reuses its own bitmap instead of allocating it for every call
+	const int bitmapHeight = numberOfPixelY + 1;
+	thread_local std::vector<bool> scenePointsUsed;
+	scenePointsUsed.assign((size_t)(numberOfPixelX + 1) * bitmapHeight, false);
 
 	const double minLogicalDiffX = pageRect.width()/numberOfPixelX;
 	const double minLogicalDiffY = pageRect.height()/numberOfPixelY;
 
 	//DEBUG(Q_FUNC_INFO << ", xScales/YScales size: " << d->xScales.size() << '/' << d->yScales.size())
 
+	// the points are mapped in blocks with one call of the scales for all x and all y values of the block
+	double xValues[mapBlockSize], yValues[mapBlockSize];
 	for (const auto* xScale : d->xScales) {
 		if (!xScale) continue;
 
 		for (const auto* yScale : d->yScales) {
 			if (!yScale) continue;
 
-			for (int i = startIndex; i <= endIndex; i++) {
-				const QPointF& point = logicalPoints.at(i);
-
-				double x = point.x(), y = point.y();
-				if (!xScale->contains(x) || !yScale->contains(y))
-					continue;
-				if (!xScale->map(&x) || !yScale->map(&y))
-					continue;
-
-				if (limit) {
-					// set to max/min if passed over
-					x = qBound(xPage, x, xPage + w);
-					y = qBound(yPage, y, yPage + h);
+			for (int start = startIndex; start <= endIndex; start += mapBlockSize) {
+				const int count = qMin(mapBlockSize, endIndex - start + 1);
+				const QPointF* points = logicalPoints.constData() + start;
+				for (int j = 0; j < count; j++) {
+					xValues[j] = points[j].x();
+					yValues[j] = points[j].y();
 				}
+				xScale->map(xValues, count);
+				yScale->map(yValues, count);
 
-				if (noPageClippingY)
-					y = yPage + h/2.;
-
-				const QPointF mappedPoint(x, y);
-				//DEBUG(mappedPoint.x() << ' ' << mappedPoint.y())
-				if (noPageClipping || limit || rectContainsPoint(pageRect, mappedPoint)) {
-					//TODO: check
-					const int indexX = qRound((x - xPage) / minLogicalDiffX);
-					const int indexY = qRound((y - yPage) / minLogicalDiffY);
-					if (scenePointsUsed.at(indexX).at(indexY))
+				for (int j = 0; j < count; j++) {
+					double x = xValues[j], y = yValues[j];
+					if (std::isnan(x) || std::isnan(y))	// outside of the range or not mappable
 						continue;
 
-					scenePointsUsed[indexX][indexY] = true;
-					scenePoints.append(mappedPoint);
+					if (limit) {
+						// set to max/min if passed over
+						x = qBound(xPage, x, xPage + w);
+						y = qBound(yPage, y, yPage + h);
+					}
+
+					if (noPageClippingY)
+						y = yPage + h/2.;
+
+					const QPointF mappedPoint(x, y);
 					//DEBUG(mappedPoint.x() << ' ' << mappedPoint.y())
-					visiblePoints[i] = !visiblePoints.at(i);
+					if (noPageClipping || limit || rectContainsPoint(pageRect, mappedPoint)) {
+						//TODO: check
+						const int indexX = qRound((x - xPage) / minLogicalDiffX);
+						const int indexY = qRound((y - yPage) / minLogicalDiffY);
+						if (indexX < 0 || indexX > numberOfPixelX || indexY < 0 || indexY >= bitmapHeight) {
+							// outside of the data rect (no page clipping), not deduplicated
+							scenePoints.append(mappedPoint);
+							visiblePoints[start + j] = !visiblePoints.at(start + j);
+							continue;
+						}
+
+						const size_t pixel = (size_t)indexX * bitmapHeight + indexY;
+						if (scenePointsUsed[pixel])
+							continue;
+
+						scenePointsUsed[pixel] = true;
+						scenePoints.append(mappedPoint);
+						//DEBUG(mappedPoint.x() << ' ' << mappedPoint.y())
+						visiblePoints[start + j] = !visiblePoints.at(start + j);
+					}
 				}
 			}
 		}
@@ -30,6 +30,7 @@
 #include "backend/core/Project.h"
 #include "backend/core/datatypes/DateTime2StringFilter.h"
 #include "backend/worksheet/plots/cartesian/BoxPlot.h"
+#include "backend/worksheet/plots/cartesian/DensityPlot.h"
 #include "backend/worksheet/plots/cartesian/CartesianPlotLegend.h"
 #include "backend/worksheet/plots/cartesian/CustomPoint.h"
 #include "backend/worksheet/plots/cartesian/ReferenceLine.h"
@@ -354,6 +355,7 @@ void CartesianPlot::initActions() {
 	addCurveAction = new QAction(QIcon::fromTheme("labplot-xy-curve"), i18n("xy-curve"), this);
 	addHistogramAction = new QAction(QIcon::fromTheme("view-object-histogram-linear"), i18n("Histogram"), this);
 	addBoxPlotAction = new QAction(QIcon::fromTheme("view-object-histogram-linear"), i18n("Box Plot"), this);
+	addDensityPlotAction = new QAction(QIcon::fromTheme("color-management"), i18n("Density Plot"), this);
 	addEquationCurveAction = new QAction(QIcon::fromTheme("labplot-xy-equation-curve"), i18n("xy-curve from a Formula"), this);
 // no icons yet
 	addDataReductionCurveAction = new QAction(QIcon::fromTheme("labplot-xy-curve"), i18n("Data Reduction"), this);
@@ -383,6 +385,7 @@ void CartesianPlot::initActions() {
 	connect(addCurveAction, &QAction::triggered, this, &CartesianPlot::addCurve);
 	connect(addHistogramAction, &QAction::triggered, this, &CartesianPlot::addHistogram);
 	connect(addBoxPlotAction, &QAction::triggered, this, &CartesianPlot::addBoxPlot);
+	connect(addDensityPlotAction, &QAction::triggered, this, &CartesianPlot::addDensityPlot);
 	connect(addEquationCurveAction, &QAction::triggered, this, &CartesianPlot::addEquationCurve);
 	connect(addDataReductionCurveAction, &QAction::triggered, this, &CartesianPlot::addDataReductionCurve);
 	connect(addDifferentiationCurveAction, &QAction::triggered, this, &CartesianPlot::addDifferentiationCurve);
@@ -519,6 +522,7 @@ void CartesianPlot::initMenus() {
 	addNewMenu->addAction(addCurveAction);
 	addNewMenu->addAction(addHistogramAction);
 	addNewMenu->addAction(addBoxPlotAction);
+	addNewMenu->addAction(addDensityPlotAction);
 	addNewMenu->addAction(addEquationCurveAction);
 	addNewMenu->addSeparator();
 
@@ -702,7 +706,7 @@ QVector<AbstractAspect*> CartesianPlot::dependsOn() const {
 
 QVector<AspectType> CartesianPlot::pasteTypes() const {
 	QVector<AspectType> types{
-		AspectType::XYCurve, AspectType::Histogram, AspectType::BoxPlot,
+		AspectType::XYCurve, AspectType::Histogram, AspectType::BoxPlot, AspectType::DensityPlot,
 		AspectType::Axis, AspectType::XYEquationCurve,
 		AspectType::XYConvolutionCurve, AspectType::XYCorrelationCurve,
 		AspectType::XYDataReductionCurve, AspectType::XYDifferentiationCurve,
@@ -1812,6 +1816,10 @@ void CartesianPlot::addBoxPlot() {
 	addChild(new BoxPlot("Box Plot"));
 }
 
+void CartesianPlot::addDensityPlot() {
+	addChild(new DensityPlot("Density Plot"));
+}
+
 /*!
  * returns the first selected XYCurve in the plot
  */
@@ -2257,6 +2265,14 @@ void CartesianPlot::childAdded(const AbstractAspect* child) {
 			}
 		}
 
+		const auto* densityPlot = qobject_cast<const DensityPlot*>(child);
+		if (densityPlot) {
+			DEBUG(Q_FUNC_INFO << ", DENSITY PLOT")
+			connect(densityPlot, &DensityPlot::dataChanged, [this, densityPlot] {this->dataChanged(-1, -1, const_cast<DensityPlot*>(densityPlot));});
+			connect(densityPlot, &DensityPlot::visibleChanged, this, &CartesianPlot::curveVisibilityChanged);
+			cSystemIndex = densityPlot->coordinateSystemIndex();
+		}
+
 		const auto* infoElement = qobject_cast<const InfoElement*>(child);
 		if (infoElement)
 			connect(this, &CartesianPlot::curveRemoved, infoElement, &InfoElement::removeCurve);
@@ -2931,6 +2947,22 @@ void CartesianPlot::calculateDataXRange(const int index, bool completeRange) {
 			d->dataXRange(index).end() = max;
 	}
 
+	//loop over all density plots and determine the maximum and minimum x-values
+	for (const auto* curve : this->children<const DensityPlot>()) {
+		if (!curve->isVisible())
+			continue;
+		if (!curve->xColumn())
+			continue;
+
+		const double min = curve->xMinimum();
+		if (d->dataXRange(index).start() > min)
+			d->dataXRange(index).start() = min;
+
+		const double max = curve->xMaximum();
+		if (max > d->dataXRange(index).end())
+			d->dataXRange(index).end() = max;
+	}
+
 	// check ranges for nonlinear scales
 	if (d->dataXRange(index).scale() != RangeT::Scale::Linear)
 		d->dataXRange(index) = d->checkRange(d->dataXRange(index));
@@ -3027,6 +3059,22 @@ void CartesianPlot::calculateDataYRange(const int index, bool completeRange) {
 			d->dataYRange(index).end() = max;
 	}
 
+	//loop over all density plots and determine the maximum and minimum y-values
+	for (const auto* curve : this->children<const DensityPlot>()) {
+		if (!curve->isVisible())
+			continue;
+		if (!curve->yColumn())
+			continue;
+
+		const double min = curve->yMinimum();
+		if (d->dataYRange(index).start() > min)
+			d->dataYRange(index).start() = min;
+
+		const double max = curve->yMaximum();
+		if (max > d->dataYRange(index).end())
+			d->dataYRange(index).end() = max;
+	}
+
 	// check ranges for nonlinear scales
 	if (d->dataYRange(index).scale() != RangeT::Scale::Linear)
 		d->dataYRange(index) = d->checkRange(d->dataYRange(index));
@@ -5631,6 +5679,15 @@ bool CartesianPlot::load(XmlStreamReader* reader, bool preview) {
 				delete line;
 				return false;
 			}
+		} else if (reader->name() == "densityPlot") {
+			auto* densityPlot = new DensityPlot("DensityPlot");
+			densityPlot->setIsLoading(true);
+			if (densityPlot->load(reader, preview))
+				addChildFast(densityPlot);
+			else {
+				removeChild(densityPlot);
+				return false;
+			}
 		} else if (reader->name() == "boxPlot") {
 			auto* boxPlot = new BoxPlot("BoxPlot");
 			boxPlot->setIsLoading(true);
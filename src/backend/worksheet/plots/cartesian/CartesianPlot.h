@@ -213,6 +213,7 @@ private:
 	QAction* addEquationCurveAction;
 	QAction* addHistogramAction;
 	QAction* addBoxPlotAction;
+	QAction* addDensityPlotAction;
 	QAction* addDataReductionCurveAction;
 	QAction* addDifferentiationCurveAction;
 	QAction* addIntegrationCurveAction;
@@ -283,6 +284,7 @@ public Q_SLOTS:
 	void addHistogram();
 	void addHistogramFit(Histogram*, nsl_sf_stats_distribution);
 	void addBoxPlot();
+	void addDensityPlot();
 	void addEquationCurve();
 	void addDataReductionCurve();
 	void addDifferentiationCurve();
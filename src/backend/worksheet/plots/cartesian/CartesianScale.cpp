@@ -37,6 +37,21 @@ void CartesianScale::getProperties(Range<double> *range,
 		*c = m_c;
 }
 
+/*!
+ * maps the \c count values in \c values with \c f if they are inside of \c range and \c valid,
+ * sets them to NAN otherwise. The loop has no branches and is vectorized by the compiler
+ * for functions \c f consisting of arithmetic operations and square roots.
+ */
+template<typename Function, typename Condition>
+static inline void mapValues(double* values, int count, const Range<double>& range, Function f, Condition valid) {
+	const double min = qMin(range.start(), range.end());
+	const double max = qMax(range.start(), range.end());
+	for (int i = 0; i < count; ++i) {
+		const double value = values[i];
+		values[i] = (value >= min && value <= max && valid(value)) ? f(value) : NAN;
+	}
+}
+
 /**
  * \class CartesianCoordinateSystem::LinearScale
  * \brief implementation of a linear scale for cartesian coordinate systems
@@ -56,6 +71,11 @@ public:
 		return true;
 	}
 
+	void map(double* values, int count) const override {
+		const double a = m_a, b = m_b;
+		mapValues(values, count, m_range, [a, b](double x) { return x * b + a; }, [](double) { return true; });
+	}
+
 	bool inverseMap(double *value) const override {
 		*value = (*value - m_a) / m_b;
 		return true;
@@ -89,6 +109,21 @@ public:
 		return true;
 	}
 
+	void map(double* values, int count) const override {
+		const double a = m_a, b = m_b;
+		const auto positive = [](double x) { return x > 0; };
+		if (m_c == 10.)
+			mapValues(values, count, m_range, [a, b](double x) { return log10(x) * b + a; }, positive);
+		else if (m_c == 2.)
+			mapValues(values, count, m_range, [a, b](double x) { return log2(x) * b + a; }, positive);
+		else if (m_c == M_E)
+			mapValues(values, count, m_range, [a, b](double x) { return log(x) * b + a; }, positive);
+		else {
+			const double factor = b / log(m_c);
+			mapValues(values, count, m_range, [a, factor](double x) { return log(x) * factor + a; }, positive);
+		}
+	}
+
 	bool inverseMap(double *value) const override {
 		*value = pow(m_c, (*value - m_a) / m_b);
 		return true;
@@ -118,6 +153,11 @@ public:
 		return true;
 	}
 
+	void map(double* values, int count) const override {
+		const double a = m_a, b = m_b;
+		mapValues(values, count, m_range, [a, b](double x) { return sqrt(x) * b + a; }, [](double x) { return x >= 0; });
+	}
+
 	bool inverseMap(double *value) const override {
 		*value = gsl_pow_2((*value - m_a) / m_b);
 		return true;
@@ -146,6 +186,11 @@ public:
 		return true;
 	}
 
+	void map(double* values, int count) const override {
+		const double a = m_a, b = m_b;
+		mapValues(values, count, m_range, [a, b](double x) { return x * x * b + a; }, [](double) { return true; });
+	}
+
 	bool inverseMap(double *value) const override {
 		*value = sqrt(qAbs((*value - m_a) / m_b));
 		return true;
@@ -176,6 +221,11 @@ public:
 		return true;
 	}
 
+	void map(double* values, int count) const override {
+		const double a = m_a, b = m_b;
+		mapValues(values, count, m_range, [a, b](double x) { return b / x + a; }, [](double x) { return x != 0; });
+	}
+
 	bool inverseMap(double *value) const override {
 		CHECK(*value != m_a)
 
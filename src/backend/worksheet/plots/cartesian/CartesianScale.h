@@ -33,6 +33,7 @@ public:
 	inline bool contains(double value) const { return m_range.contains(value); }
 
 	virtual bool map(double*) const = 0;
+	virtual void map(double* values, int count) const = 0;	// map count values at once, NAN for values that can't be mapped
 	virtual bool inverseMap(double*) const = 0;
 	virtual int direction() const = 0;
 
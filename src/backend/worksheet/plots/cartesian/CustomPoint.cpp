@@ -195,6 +195,7 @@ void CustomPointPrivate::recalcShapeAndBoundingRect() {
 	prepareGeometryChange();
 
 	pointShape = QPainterPath();
+	symbolPath = QPainterPath();
 	if (m_visible && symbol->style() != Symbol::Style::NoSymbols) {
 		QPainterPath path = Symbol::stylePath(symbol->style());
 
@@ -208,7 +209,8 @@ void CustomPointPrivate::recalcShapeAndBoundingRect() {
 			path = trafo.map(path);
 		}
 
-		pointShape.addPath(WorksheetElement::shapeFromPath(trafo.map(path), symbol->pen()));
+		symbolPath = trafo.map(path);
+		pointShape.addPath(WorksheetElement::shapeFromPath(symbolPath, symbol->pen()));
 		transformedBoundingRectangle = pointShape.boundingRect();
 	}
 }
@@ -221,7 +223,7 @@ void CustomPointPrivate::paint(QPainter* painter, const QStyleOptionGraphicsItem
 		painter->setOpacity(symbol->opacity());
 		painter->setPen(symbol->pen());
 		painter->setBrush(symbol->brush());
-		painter->drawPath(pointShape);
+		Symbol::draw(painter, symbolPath, QPointF(0, 0));
 	}
 
 	if (m_hovered && !isSelected() && !q->isPrinting()) {
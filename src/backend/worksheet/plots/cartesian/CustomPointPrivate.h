@@ -34,6 +34,7 @@ public:
 	QRectF boundingRectangle;
 	QRectF transformedBoundingRectangle;
 	QPainterPath pointShape;
+	QPainterPath symbolPath;	// scaled and rotated path of the symbol
 
 	QPointF positionScene; //position in scene coordinates
 	Symbol* symbol{nullptr};
@@ -0,0 +1,847 @@
+/*
+    File                 : DensityPlot.cpp
+    Project              : LabPlot
+    Description          : 2D density plot aggregating large xy-data on the device pixels of the plot
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "DensityPlot.h"
+#include "DensityPlotPrivate.h"
+#include "backend/core/AbstractColumn.h"
+#include "backend/worksheet/plots/cartesian/CartesianCoordinateSystem.h"
+#include "backend/worksheet/plots/cartesian/CartesianPlot.h"
+#include "backend/lib/commandtemplates.h"
+#include "backend/lib/parallel.h"
+#include "backend/lib/XmlStreamReader.h"
+#include "backend/lib/trace.h"
+#include "tools/ColorMapsManager.h"
+
+#include <QApplication>
+#include <QGraphicsSceneMouseEvent>
+#include <QMenu>
+#include <QPaintDevice>
+#include <QPainter>
+#include <QThreadPool>
+
+#include <KConfig>
+#include <KConfigGroup>
+#include <KLocalizedString>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/**
+ * \class DensityPlot
+ * \brief 2D density plot for large xy-data.
+ *
+ * The points given by the x- and y-columns are aggregated on a grid with one cell per pixel of the device
+ * the data rect of the plot is drawn on, for the current plot ranges. The cells contain the number of points,
+ * the sum or the mean of the values column and are drawn as an image with the colors of a color map.
+ * The aggregation is repeated on zooming and panning and if the plot is drawn on a device with another
+ * resolution, the costs of drawing depend on the size of the plot only and not on the number of points.
+ */
+
+DensityPlot::DensityPlot(const QString& name) : WorksheetElement(name, new DensityPlotPrivate(this), AspectType::DensityPlot) {
+	init();
+}
+
+DensityPlot::DensityPlot(const QString& name, DensityPlotPrivate* dd)
+	: WorksheetElement(name, dd, AspectType::DensityPlot) {
+	init();
+}
+
+//no need to delete the d-pointer here - it inherits from QGraphicsItem
+//and is deleted during the cleanup in QGraphicsScene
+DensityPlot::~DensityPlot() = default;
+
+void DensityPlot::init() {
+	Q_D(DensityPlot);
+
+	KConfig config;
+	KConfigGroup group = config.group("DensityPlot");
+
+	//general
+	d->aggregation = (DensityPlot::Aggregation) group.readEntry("Aggregation", (int)DensityPlot::Aggregation::Count);
+
+	//colors
+	d->scaling = (DensityPlot::Scaling) group.readEntry("Scaling", (int)DensityPlot::Scaling::Log);
+	d->colorMap = group.readEntry("ColorMap", QStringLiteral("viridis100"));
+	d->opacity = group.readEntry("Opacity", 1.0);
+}
+
+/*!
+    Returns an icon to be used in the project explorer.
+*/
+QIcon DensityPlot::icon() const {
+	return QIcon::fromTheme(QLatin1String("color-management"));
+}
+
+void DensityPlot::initActions() {
+	visibilityAction = new QAction(i18n("Visible"), this);
+	visibilityAction->setCheckable(true);
+	connect(visibilityAction, &QAction::triggered, this, &DensityPlot::visibilityChangedSlot);
+}
+
+QMenu* DensityPlot::createContextMenu() {
+	if (!visibilityAction)
+		initActions();
+
+	QMenu* menu = WorksheetElement::createContextMenu();
+	QAction* firstAction = menu->actions().at(1); //skip the first action because of the "title-action"
+
+	//Visibility
+	visibilityAction->setChecked(isVisible());
+	menu->insertAction(firstAction, visibilityAction);
+
+	return menu;
+}
+
+QGraphicsItem* DensityPlot::graphicsItem() const {
+	return d_ptr;
+}
+
+void DensityPlot::retransform() {
+	Q_D(DensityPlot);
+	d->retransform();
+}
+
+void DensityPlot::recalc() {
+	Q_D(DensityPlot);
+	d->recalc();
+}
+
+void DensityPlot::handleResize(double /*horizontalRatio*/, double /*verticalRatio*/, bool /*pageResize*/) {
+}
+
+bool DensityPlot::activateCurve(QPointF mouseScenePos, double maxDist) {
+	Q_D(DensityPlot);
+	return d->activateCurve(mouseScenePos, maxDist);
+}
+
+void DensityPlot::setHover(bool on) {
+	Q_D(DensityPlot);
+	d->setHover(on);
+}
+
+/* ============================ getter methods ================= */
+//general
+BASIC_SHARED_D_READER_IMPL(DensityPlot, const AbstractColumn*, xColumn, xColumn)
+BASIC_SHARED_D_READER_IMPL(DensityPlot, const AbstractColumn*, yColumn, yColumn)
+BASIC_SHARED_D_READER_IMPL(DensityPlot, const AbstractColumn*, valuesColumn, valuesColumn)
+BASIC_SHARED_D_READER_IMPL(DensityPlot, DensityPlot::Aggregation, aggregation, aggregation)
+
+QString& DensityPlot::xColumnPath() const {
+	D(DensityPlot);
+	return d->xColumnPath;
+}
+
+QString& DensityPlot::yColumnPath() const {
+	D(DensityPlot);
+	return d->yColumnPath;
+}
+
+QString& DensityPlot::valuesColumnPath() const {
+	D(DensityPlot);
+	return d->valuesColumnPath;
+}
+
+//colors
+BASIC_SHARED_D_READER_IMPL(DensityPlot, DensityPlot::Scaling, scaling, scaling)
+BASIC_SHARED_D_READER_IMPL(DensityPlot, QString, colorMap, colorMap)
+BASIC_SHARED_D_READER_IMPL(DensityPlot, qreal, opacity, opacity)
+
+double DensityPlot::xMinimum() const {
+	D(DensityPlot);
+	return d->xMin;
+}
+
+double DensityPlot::xMaximum() const {
+	D(DensityPlot);
+	return d->xMax;
+}
+
+double DensityPlot::yMinimum() const {
+	D(DensityPlot);
+	return d->yMin;
+}
+
+double DensityPlot::yMaximum() const {
+	D(DensityPlot);
+	return d->yMax;
+}
+
+/* ============================ setter methods and undo commands ================= */
+
+//General
+STD_SETTER_CMD_IMPL_F_S(DensityPlot, SetXColumn, const AbstractColumn*, xColumn, recalc)
+void DensityPlot::setXColumn(const AbstractColumn* column) {
+	Q_D(DensityPlot);
+	if (column != d->xColumn) {
+		exec(new DensityPlotSetXColumnCmd(d, column, ki18n("%1: set x column")));
+
+		if (column) {
+			//update the plot itself on changes
+			connect(column, &AbstractColumn::dataChanged, this, &DensityPlot::recalc);
+			connect(column->parentAspect(), &AbstractAspect::aspectAboutToBeRemoved,
+					this, &DensityPlot::xColumnAboutToBeRemoved);
+			//TODO: add disconnect in the undo-function
+		}
+	}
+}
+
+STD_SETTER_CMD_IMPL_F_S(DensityPlot, SetYColumn, const AbstractColumn*, yColumn, recalc)
+void DensityPlot::setYColumn(const AbstractColumn* column) {
+	Q_D(DensityPlot);
+	if (column != d->yColumn) {
+		exec(new DensityPlotSetYColumnCmd(d, column, ki18n("%1: set y column")));
+
+		if (column) {
+			connect(column, &AbstractColumn::dataChanged, this, &DensityPlot::recalc);
+			connect(column->parentAspect(), &AbstractAspect::aspectAboutToBeRemoved,
+					this, &DensityPlot::yColumnAboutToBeRemoved);
+			//TODO: add disconnect in the undo-function
+		}
+	}
+}
+
+STD_SETTER_CMD_IMPL_F_S(DensityPlot, SetValuesColumn, const AbstractColumn*, valuesColumn, retransform)
+void DensityPlot::setValuesColumn(const AbstractColumn* column) {
+	Q_D(DensityPlot);
+	if (column != d->valuesColumn) {
+		exec(new DensityPlotSetValuesColumnCmd(d, column, ki18n("%1: set values column")));
+
+		if (column) {
+			//the values don't change the plot ranges, aggregate again only
+			connect(column, &AbstractColumn::dataChanged, this, &DensityPlot::retransform);
+			connect(column->parentAspect(), &AbstractAspect::aspectAboutToBeRemoved,
+					this, &DensityPlot::valuesColumnAboutToBeRemoved);
+			//TODO: add disconnect in the undo-function
+		}
+	}
+}
+
+STD_SETTER_CMD_IMPL_F_S(DensityPlot, SetAggregation, DensityPlot::Aggregation, aggregation, retransform)
+void DensityPlot::setAggregation(DensityPlot::Aggregation aggregation) {
+	Q_D(DensityPlot);
+	if (aggregation != d->aggregation)
+		exec(new DensityPlotSetAggregationCmd(d, aggregation, ki18n("%1: set aggregation")));
+}
+
+//Colors
+STD_SETTER_CMD_IMPL_F_S(DensityPlot, SetScaling, DensityPlot::Scaling, scaling, updateImage)
+void DensityPlot::setScaling(DensityPlot::Scaling scaling) {
+	Q_D(DensityPlot);
+	if (scaling != d->scaling)
+		exec(new DensityPlotSetScalingCmd(d, scaling, ki18n("%1: set scaling")));
+}
+
+STD_SETTER_CMD_IMPL_F_S(DensityPlot, SetColorMap, QString, colorMap, updateImage)
+void DensityPlot::setColorMap(const QString& colorMap) {
+	Q_D(DensityPlot);
+	if (colorMap != d->colorMap)
+		exec(new DensityPlotSetColorMapCmd(d, colorMap, ki18n("%1: set color map")));
+}
+
+STD_SETTER_CMD_IMPL_F_S(DensityPlot, SetOpacity, qreal, opacity, update)
+void DensityPlot::setOpacity(qreal opacity) {
+	Q_D(DensityPlot);
+	if (opacity != d->opacity)
+		exec(new DensityPlotSetOpacityCmd(d, opacity, ki18n("%1: set opacity")));
+}
+
+//##############################################################################
+//#################################  SLOTS  ####################################
+//##############################################################################
+void DensityPlot::xColumnAboutToBeRemoved(const AbstractAspect* aspect) {
+	Q_D(DensityPlot);
+	if (aspect == d->xColumn) {
+		d->xColumn = nullptr;
+		d->retransform();
+	}
+}
+
+void DensityPlot::yColumnAboutToBeRemoved(const AbstractAspect* aspect) {
+	Q_D(DensityPlot);
+	if (aspect == d->yColumn) {
+		d->yColumn = nullptr;
+		d->retransform();
+	}
+}
+
+void DensityPlot::valuesColumnAboutToBeRemoved(const AbstractAspect* aspect) {
+	Q_D(DensityPlot);
+	if (aspect == d->valuesColumn) {
+		d->valuesColumn = nullptr;
+		d->retransform();
+	}
+}
+
+//##############################################################################
+//######  SLOTs for changes triggered via QActions in the context menu  ########
+//##############################################################################
+void DensityPlot::visibilityChangedSlot() {
+	Q_D(const DensityPlot);
+	this->setVisible(!d->isVisible());
+}
+
+//##############################################################################
+//####################### Private implementation ###############################
+//##############################################################################
+namespace {
+// minimal number of rows aggregated in one task when aggregating in parallel
+const int parallelChunkSize = 64 * 1024;
+// maximal number of grid cells allocated by all tasks together, limits the memory used for the partial grids
+const int maxParallelGridSize = 16 * 1024 * 1024;
+// number of rows read from the columns at once
+const int blockSize = 4096;
+// number of entries in the color lookup table
+const int colorTableSize = 256;
+
+double scaleValue(double value, RangeT::Scale scale) {
+	switch (scale) {
+	case RangeT::Scale::Linear:
+		return value;
+	case RangeT::Scale::Log10:
+		return log10(value);
+	case RangeT::Scale::Log2:
+		return log2(value);
+	case RangeT::Scale::Ln:
+		return log(value);
+	case RangeT::Scale::Sqrt:
+		return sqrt(value);
+	case RangeT::Scale::Square:
+		return value * value;
+	case RangeT::Scale::Inverse:
+		return 1. / value;
+	}
+	return value;
+}
+
+/* maps the values of a range to the pixels 0 .. size - 1, the pixels are counted from the end of the range if reverse is set */
+class PixelMapping {
+public:
+	PixelMapping(const Range<double>& range, int size, bool reverse) : m_scale(range.scale()), m_size(size), m_reverse(reverse) {
+		m_start = scaleValue(range.start(), m_scale);
+		m_factor = size / (scaleValue(range.end(), m_scale) - m_start);
+	}
+
+	// returns -1 for values outside of the range and invalid values
+	int pixel(double value) const {
+		const double position = (scaleValue(value, m_scale) - m_start) * m_factor;
+		if (!(position >= 0. && position <= m_size))
+			return -1;
+		const int pixel = qMin((int)position, m_size - 1);
+		return m_reverse ? m_size - 1 - pixel : pixel;
+	}
+
+private:
+	RangeT::Scale m_scale;
+	int m_size;
+	bool m_reverse;
+	double m_start;
+	double m_factor;
+};
+
+/* aggregates the rows start .. start + count - 1 on the grid given by counts and sums */
+void aggregateRows(const DensityPlotPrivate::AggregationData& data, const QVector<Interval<int>>& maskedIntervals,
+		int start, int count, QVector<double>& counts, QVector<double>& sums) {
+	const bool hasValues = (data.aggregation != DensityPlot::Aggregation::Count);
+	counts.fill(0., data.width * data.height);
+	if (hasValues)
+		sums.fill(0., data.width * data.height);
+
+	// row 0 of the grid is at the top, i.e. at the end of the y range
+	const PixelMapping xMapping(data.xRange, data.width, false);
+	const PixelMapping yMapping(data.yRange, data.height, true);
+
+	QVector<double> x(blockSize), y(blockSize), values(hasValues ? blockSize : 0);
+	for (int first = start; first < start + count; first += blockSize) {
+		const int size = qMin(blockSize, start + count - first);
+		data.xColumn->valuesAt(first, size, x.data());
+		data.yColumn->valuesAt(first, size, y.data());
+		if (hasValues)
+			data.valuesColumn->valuesAt(first, size, values.data());
+
+		// masked rows are ignored
+		for (const auto& interval : maskedIntervals) {
+			const int end = qMin(interval.end(), first + size - 1);
+			for (int row = qMax(interval.start(), first); row <= end; ++row)
+				x[row - first] = NAN;
+		}
+
+		for (int i = 0; i < size; ++i) {
+			const int column = xMapping.pixel(x.at(i));
+			if (column < 0)
+				continue;
+			const int row = yMapping.pixel(y.at(i));
+			if (row < 0)
+				continue;
+
+			const int index = row * data.width + column;
+			if (hasValues) {
+				if (std::isnan(values.at(i)))
+					continue;
+				sums[index] += values.at(i);
+			}
+			counts[index] += 1.;
+		}
+	}
+}
+}
+
+DensityPlotPrivate::DensityPlotPrivate(DensityPlot* owner) : WorksheetElementPrivate(owner), q(owner) {
+	setFlag(QGraphicsItem::ItemIsSelectable);
+	setAcceptHoverEvents(false);
+}
+
+bool DensityPlotPrivate::activateCurve(QPointF mouseScenePos, double /*maxDist*/) {
+	if (!isVisible() || m_grid.isEmpty() || !m_gridRect.contains(mouseScenePos))
+		return false;
+
+	// only the pixels with data points activate the plot
+	const int column = qMin((int)((mouseScenePos.x() - m_gridRect.x()) / m_gridRect.width() * m_gridWidth), m_gridWidth - 1);
+	const int row = qMin((int)((mouseScenePos.y() - m_gridRect.y()) / m_gridRect.height() * m_gridHeight), m_gridHeight - 1);
+	return !std::isnan(m_grid.at(row * m_gridWidth + column));
+}
+
+void DensityPlotPrivate::setHover(bool on) {
+	if (on == m_hovered)
+		return; // don't update if state not changed
+
+	m_hovered = on;
+	on ? Q_EMIT q->hovered() : emit q->unhovered();
+	update();
+}
+
+/*!
+  called when the size of the plot or its data ranges (manual changes, zooming, etc.) were changed.
+  The data is aggregated again for the current plot ranges when the plot is drawn the next time.
+*/
+void DensityPlotPrivate::retransform() {
+	if (suppressRetransform || !isVisible() || q->isLoading())
+		return;
+
+	PERFTRACE(name() + Q_FUNC_INFO);
+
+	m_grid.clear();
+	m_gridWidth = 0;
+	m_gridHeight = 0;
+
+	const auto* plot = q->plot();
+	m_hasData = (plot && q->cSystem && xColumn && yColumn && (aggregation == DensityPlot::Aggregation::Count || valuesColumn));
+	if (m_hasData)
+		m_gridRect = plot->dataRect();
+
+	recalcShapeAndBoundingRect();
+}
+
+/*!
+  aggregates the data for the current plot ranges on a grid of \c width x \c height pixels covering the data rect
+  and renders the image of the grid, called when the plot is drawn.
+*/
+void DensityPlotPrivate::updateGrid(int width, int height) {
+	PERFTRACE(name() + Q_FUNC_INFO);
+	const auto* plot = q->plot();
+	AggregationData data;
+	data.xColumn = xColumn;
+	data.yColumn = yColumn;
+	data.valuesColumn = valuesColumn;
+	data.aggregation = aggregation;
+	data.xRange = plot->xRange(q->cSystem->xIndex());
+	data.yRange = plot->yRange(q->cSystem->yIndex());
+	data.width = width;
+	data.height = height;
+
+	m_grid = aggregate(data);
+	m_gridWidth = width;
+	m_gridHeight = height;
+	if (m_grid.isEmpty())
+		m_image = QImage();
+	else
+		m_image = render(m_grid, m_gridWidth, m_gridHeight, scaling, ColorMapsManager::instance()->colorMap(colorMap));
+}
+
+/*!
+  called when the data was changed. Determines the new minimal and maximal values
+  and notifies the plot to adjust its ranges, the plot calls retransform() afterwards.
+*/
+void DensityPlotPrivate::recalc() {
+	PERFTRACE(name() + Q_FUNC_INFO);
+
+	if (xColumn) {
+		xMin = xColumn->minimum();
+		xMax = xColumn->maximum();
+	}
+	if (yColumn) {
+		yMin = yColumn->minimum();
+		yMax = yColumn->maximum();
+	}
+
+	Q_EMIT q->dataChanged();
+}
+
+/*!
+ * aggregates the points of \c data on a grid of data.width x data.height pixels, row 0 is at the top.
+ * The rows are split into chunks aggregated in parallel in the global thread pool on separate grids
+ * which are summed up at the end.
+ * Returns the number of points, the sum or the mean of the values per pixel, NAN for pixels without points.
+ * An empty grid is returned if the data is incomplete.
+ */
+QVector<double> DensityPlotPrivate::aggregate(const AggregationData& data) {
+	const bool hasValues = (data.aggregation != DensityPlot::Aggregation::Count);
+	const int size = data.width * data.height;
+	if (!data.xColumn || !data.yColumn || (hasValues && !data.valuesColumn) || size <= 0)
+		return QVector<double>();
+
+	int count = qMin(data.xColumn->rowCount(), data.yColumn->rowCount());
+	if (hasValues)
+		count = qMin(count, data.valuesColumn->rowCount());
+
+	QVector<Interval<int>> maskedIntervals = data.xColumn->maskedIntervals();
+	maskedIntervals << data.yColumn->maskedIntervals();
+	if (hasValues)
+		maskedIntervals << data.valuesColumn->maskedIntervals();
+
+	QVector<double> counts, sums;
+	QThreadPool* pool = QThreadPool::globalInstance();
+	const int chunks = qMin(qMin(pool->maxThreadCount(), count / parallelChunkSize), maxParallelGridSize / size);
+	if (chunks > 1) {
+		const int chunkSize = count / chunks + 1;
+		DEBUG(Q_FUNC_INFO << ", aggregating " << count << " rows in " << chunks << " chunks of size " << chunkSize)
+		QVector<QVector<double>> chunkCounts(chunks), chunkSums(chunks);
+		const int tasks = runChunked(count, chunkSize, [&](int start, int chunkCount) {
+			const int chunk = start / chunkSize;
+			aggregateRows(data, maskedIntervals, start, chunkCount, chunkCounts[chunk], chunkSums[chunk]);
+		});
+
+		counts = chunkCounts.at(0);
+		sums = chunkSums.at(0);
+		for (int i = 1; i < tasks; ++i) {
+			const double* chunkCount = chunkCounts.at(i).constData();
+			std::transform(counts.cbegin(), counts.cend(), chunkCount, counts.begin(), std::plus<double>());
+			if (hasValues) {
+				const double* chunkSum = chunkSums.at(i).constData();
+				std::transform(sums.cbegin(), sums.cend(), chunkSum, sums.begin(), std::plus<double>());
+			}
+		}
+	} else
+		aggregateRows(data, maskedIntervals, 0, count, counts, sums);
+
+	QVector<double> grid(size);
+	for (int i = 0; i < size; ++i) {
+		if (counts.at(i) == 0.) {
+			grid[i] = NAN;
+			continue;
+		}
+
+		switch (data.aggregation) {
+		case DensityPlot::Aggregation::Count:
+			grid[i] = counts.at(i);
+			break;
+		case DensityPlot::Aggregation::Sum:
+			grid[i] = sums.at(i);
+			break;
+		case DensityPlot::Aggregation::Mean:
+			grid[i] = sums.at(i) / counts.at(i);
+			break;
+		}
+	}
+
+	return grid;
+}
+
+/*!
+ * maps the aggregated values of \c grid to [0, 1] with the given \c scaling, NAN values are kept.
+ * With histogram equalization every value is replaced by its position in the sorted values, so all
+ * colors of the color map are used for the same number of pixels.
+ */
+QVector<double> DensityPlotPrivate::scale(const QVector<double>& grid, DensityPlot::Scaling scaling) {
+	QVector<double> result(grid.size(), NAN);
+
+	double min = INFINITY, max = -INFINITY;
+	for (double value : grid) {
+		if (std::isfinite(value)) {
+			min = qMin(min, value);
+			max = qMax(max, value);
+		}
+	}
+	if (min > max)	// no data
+		return result;
+
+	switch (scaling) {
+	case DensityPlot::Scaling::Linear: {
+		const double range = max - min;
+		for (int i = 0; i < grid.size(); ++i) {
+			if (std::isfinite(grid.at(i)))
+				result[i] = (range > 0.) ? (grid.at(i) - min) / range : 1.;
+		}
+		break;
+	}
+	case DensityPlot::Scaling::Log: {
+		// values are shifted to start at 1 if non-positive values are present (sums and means)
+		const bool positive = (min > 0.);
+		const double range = positive ? log(max) - log(min) : log1p(max - min);
+		for (int i = 0; i < grid.size(); ++i) {
+			const double value = grid.at(i);
+			if (!std::isfinite(value))
+				continue;
+			if (range > 0.)
+				result[i] = (positive ? log(value) - log(min) : log1p(value - min)) / range;
+			else
+				result[i] = 1.;
+		}
+		break;
+	}
+	case DensityPlot::Scaling::HistogramEqualization: {
+		std::vector<double> sorted;
+		sorted.reserve(grid.size());
+		for (double value : grid) {
+			if (std::isfinite(value))
+				sorted.push_back(value);
+		}
+		std::sort(sorted.begin(), sorted.end());
+
+		// the minimal values are mapped to 0, the maximal values to 1
+		const auto n = (double)sorted.size();
+		const auto minCount = (double)(std::upper_bound(sorted.cbegin(), sorted.cend(), min) - sorted.cbegin());
+		for (int i = 0; i < grid.size(); ++i) {
+			const double value = grid.at(i);
+			if (!std::isfinite(value))
+				continue;
+			const auto rank = (double)(std::upper_bound(sorted.cbegin(), sorted.cend(), value) - sorted.cbegin());
+			result[i] = (n > minCount) ? (rank - minCount) / (n - minCount) : 1.;
+		}
+		break;
+	}
+	}
+
+	return result;
+}
+
+/*!
+ * renders the \c width x \c height values of \c grid with the colors of \c colorMap interpolated
+ * between its colors, pixels without points are transparent.
+ */
+QImage DensityPlotPrivate::render(const QVector<double>& grid, int width, int height, DensityPlot::Scaling scaling, const QVector<QColor>& colorMap) {
+	QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+	if (grid.size() != width * height)
+		return image;
+
+	QVector<QColor> colors = colorMap;
+	if (colors.isEmpty())	// color maps not available, use gray scales
+		colors << QColor(Qt::lightGray) << QColor(Qt::black);
+	if (colors.size() == 1)
+		colors << colors.constFirst();
+
+	QVector<QRgb> table(colorTableSize);
+	for (int i = 0; i < colorTableSize; ++i) {
+		const double position = (double)i / (colorTableSize - 1) * (colors.size() - 1);
+		const int index = qMin((int)position, colors.size() - 2);
+		const double t = position - index;
+		const QColor& c0 = colors.at(index);
+		const QColor& c1 = colors.at(index + 1);
+		table[i] = qRgb(qRound(c0.red() + t * (c1.red() - c0.red())),
+				qRound(c0.green() + t * (c1.green() - c0.green())),
+				qRound(c0.blue() + t * (c1.blue() - c0.blue())));
+	}
+
+	const auto& scaled = scale(grid, scaling);
+	for (int row = 0; row < height; ++row) {
+		auto* line = reinterpret_cast<QRgb*>(image.scanLine(row));
+		const double* values = scaled.constData() + row * width;
+		for (int column = 0; column < width; ++column) {
+			if (!std::isnan(values[column]))
+				line[column] = table.at(qRound(values[column] * (colorTableSize - 1)));
+		}
+	}
+
+	return image;
+}
+
+/*!
+    Returns the outer bounds of the item as a rectangle.
+ */
+QRectF DensityPlotPrivate::boundingRect() const {
+	return m_boundingRectangle;
+}
+
+/*!
+    Returns the shape of this item as a QPainterPath in local coordinates.
+*/
+QPainterPath DensityPlotPrivate::shape() const {
+	return m_shape;
+}
+
+/*!
+  recalculates the outer bounds and the shape of the item.
+*/
+void DensityPlotPrivate::recalcShapeAndBoundingRect() {
+	prepareGeometryChange();
+	m_shape = QPainterPath();
+	if (!m_hasData)
+		m_boundingRectangle = QRectF();
+	else {
+		m_boundingRectangle = m_gridRect;
+		m_shape.addRect(m_gridRect);
+	}
+
+	updateImage();
+}
+
+void DensityPlotPrivate::updateImage() {
+	PERFTRACE(name() + Q_FUNC_INFO);
+	if (m_grid.isEmpty())
+		m_image = QImage();
+	else
+		m_image = render(m_grid, m_gridWidth, m_gridHeight, scaling, ColorMapsManager::instance()->colorMap(colorMap));
+
+	update();
+}
+
+void DensityPlotPrivate::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*option*/, QWidget*) {
+	if (!isVisible() || !m_hasData)
+		return;
+
+	// one cell of the grid per device pixel the data rect is drawn on,
+	// the data is aggregated again if the size on the device changed (zooming of the view, printing and exporting)
+	const QRectF deviceRect = painter->worldTransform().mapRect(m_boundingRectangle);
+	const qreal ratio = painter->device() ? painter->device()->devicePixelRatioF() : 1.;
+	const int width = qMax(1, (int)std::ceil(deviceRect.width() * ratio));
+	const int height = qMax(1, (int)std::ceil(deviceRect.height() * ratio));
+	if (width != m_gridWidth || height != m_gridHeight)
+		updateGrid(width, height);
+
+	if (!m_image.isNull()) {
+		painter->setOpacity(opacity);
+		painter->drawImage(m_boundingRectangle, m_image);
+		painter->setOpacity(1.0);
+	}
+
+	painter->setBrush(Qt::NoBrush);
+	if (m_hovered && !isSelected() && !q->isPrinting()) {
+		painter->setPen(QPen(QApplication::palette().color(QPalette::Shadow), 2, Qt::SolidLine));
+		painter->drawPath(m_shape);
+	}
+
+	if (isSelected() && !q->isPrinting()) {
+		painter->setPen(QPen(QApplication::palette().color(QPalette::Highlight), 2, Qt::SolidLine));
+		painter->drawPath(m_shape);
+	}
+}
+
+void DensityPlotPrivate::contextMenuEvent(QGraphicsSceneContextMenuEvent* event) {
+	q->createContextMenu()->exec(event->screenPos());
+}
+
+/*!
+ * selects the graphics item if the mousePress event was done on a pixel with data points
+ */
+void DensityPlotPrivate::mousePressEvent(QGraphicsSceneMouseEvent* event) {
+	if (q->plot()->mouseMode() != CartesianPlot::MouseMode::Selection) {
+		event->ignore();
+		return QGraphicsItem::mousePressEvent(event);
+	}
+
+	if (q->activateCurve(event->pos())) {
+		setSelected(true);
+		return;
+	}
+
+	event->ignore();
+	setSelected(false);
+	QGraphicsItem::mousePressEvent(event);
+}
+
+//##############################################################################
+//##################  Serialization/Deserialization  ###########################
+//##############################################################################
+//! Save as XML
+void DensityPlot::save(QXmlStreamWriter* writer) const {
+	Q_D(const DensityPlot);
+
+	writer->writeStartElement("densityPlot");
+	writeBasicAttributes(writer);
+	writeCommentElement(writer);
+
+	//general
+	writer->writeStartElement("general");
+	WRITE_COLUMN(d->xColumn, xColumn);
+	WRITE_COLUMN(d->yColumn, yColumn);
+	WRITE_COLUMN(d->valuesColumn, valuesColumn);
+	writer->writeAttribute("aggregation", QString::number(static_cast<int>(d->aggregation)));
+	writer->writeAttribute("plotRangeIndex", QString::number(m_cSystemIndex));
+	writer->writeAttribute("xMin", QString::number(d->xMin));
+	writer->writeAttribute("xMax", QString::number(d->xMax));
+	writer->writeAttribute("yMin", QString::number(d->yMin));
+	writer->writeAttribute("yMax", QString::number(d->yMax));
+	writer->writeAttribute("visible", QString::number(d->isVisible()));
+	writer->writeEndElement();
+
+	//colors
+	writer->writeStartElement("colors");
+	writer->writeAttribute("scaling", QString::number(static_cast<int>(d->scaling)));
+	writer->writeAttribute("colorMap", d->colorMap);
+	writer->writeAttribute("opacity", QString::number(d->opacity));
+	writer->writeEndElement();
+
+	writer->writeEndElement(); // close "densityPlot" section
+}
+
+//! Load from XML
+bool DensityPlot::load(XmlStreamReader* reader, bool preview) {
+	Q_D(DensityPlot);
+
+	if (!readBasicAttributes(reader))
+		return false;
+
+	KLocalizedString attributeWarning = ki18n("Attribute '%1' missing or empty, default value is used");
+	QXmlStreamAttributes attribs;
+	QString str;
+
+	while (!reader->atEnd()) {
+		reader->readNext();
+		if (reader->isEndElement() && reader->name() == "densityPlot")
+			break;
+
+		if (!reader->isStartElement())
+			continue;
+
+		if (!preview && reader->name() == "comment") {
+			if (!readCommentElement(reader)) return false;
+		} else if (!preview && reader->name() == "general") {
+			attribs = reader->attributes();
+
+			READ_COLUMN(xColumn);
+			READ_COLUMN(yColumn);
+			READ_COLUMN(valuesColumn);
+			READ_INT_VALUE("aggregation", aggregation, DensityPlot::Aggregation);
+			READ_INT_VALUE_DIRECT("plotRangeIndex", m_cSystemIndex, int);
+
+			READ_DOUBLE_VALUE("xMin", xMin);
+			READ_DOUBLE_VALUE("xMax", xMax);
+			READ_DOUBLE_VALUE("yMin", yMin);
+			READ_DOUBLE_VALUE("yMax", yMax);
+
+			str = attribs.value("visible").toString();
+			if (str.isEmpty())
+				reader->raiseWarning(attributeWarning.subs("visible").toString());
+			else
+				d->setVisible(str.toInt());
+		} else if (!preview && reader->name() == "colors") {
+			attribs = reader->attributes();
+
+			READ_INT_VALUE("scaling", scaling, DensityPlot::Scaling);
+			d->colorMap = attribs.value("colorMap").toString();
+			READ_DOUBLE_VALUE("opacity", opacity);
+		} else { // unknown element
+			reader->raiseWarning(i18n("unknown element '%1'", reader->name().toString()));
+			if (!reader->skipToEndElement()) return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,107 @@
+/*
+    File                 : DensityPlot.h
+    Project              : LabPlot
+    Description          : 2D density plot aggregating large xy-data on the device pixels of the plot
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef DENSITYPLOT_H
+#define DENSITYPLOT_H
+
+#include "backend/worksheet/plots/cartesian/Curve.h"
+#include "backend/worksheet/WorksheetElement.h"
+#include "backend/lib/macros.h"
+
+class DensityPlotPrivate;
+class AbstractColumn;
+
+#ifdef SDK
+#include "labplot_export.h"
+class LABPLOT_EXPORT DensityPlot : public WorksheetElement, public Curve {
+#else
+class DensityPlot : public WorksheetElement, public Curve {
+#endif
+	Q_OBJECT
+
+public:
+	// value of the pixels: number of points, sum or mean of the values column of the points
+	enum class Aggregation {Count, Sum, Mean};
+	// mapping of the aggregated values to the color map
+	enum class Scaling {Linear, Log, HistogramEqualization};
+
+	explicit DensityPlot(const QString&);
+	~DensityPlot() override;
+
+	QIcon icon() const override;
+	QMenu* createContextMenu() override;
+	QGraphicsItem* graphicsItem() const override;
+
+	void save(QXmlStreamWriter*) const override;
+	bool load(XmlStreamReader*, bool preview) override;
+
+	//reimplemented from Curve
+	bool activateCurve(QPointF mouseScenePos, double maxDist = -1) override;
+	void setHover(bool on) override;
+
+	//general
+	POINTER_D_ACCESSOR_DECL(const AbstractColumn, xColumn, XColumn)
+	QString& xColumnPath() const;
+	POINTER_D_ACCESSOR_DECL(const AbstractColumn, yColumn, YColumn)
+	QString& yColumnPath() const;
+	POINTER_D_ACCESSOR_DECL(const AbstractColumn, valuesColumn, ValuesColumn)
+	QString& valuesColumnPath() const;
+	BASIC_D_ACCESSOR_DECL(DensityPlot::Aggregation, aggregation, Aggregation)
+
+	//colors
+	BASIC_D_ACCESSOR_DECL(DensityPlot::Scaling, scaling, Scaling)
+	CLASS_D_ACCESSOR_DECL(QString, colorMap, ColorMap)
+	BASIC_D_ACCESSOR_DECL(qreal, opacity, Opacity)
+
+	void retransform() override;
+	void handleResize(double horizontalRatio, double verticalRatio, bool pageResize) override;
+
+	double xMinimum() const;
+	double xMaximum() const;
+	double yMinimum() const;
+	double yMaximum() const;
+
+	typedef DensityPlotPrivate Private;
+
+protected:
+	DensityPlot(const QString& name, DensityPlotPrivate* dd);
+
+private:
+	Q_DECLARE_PRIVATE(DensityPlot)
+	void init();
+	void initActions();
+
+	QAction* visibilityAction{nullptr};
+
+public Q_SLOTS:
+	void recalc();
+
+private Q_SLOTS:
+	//SLOTs for changes triggered via QActions in the context menu
+	void visibilityChangedSlot();
+
+	void xColumnAboutToBeRemoved(const AbstractAspect*);
+	void yColumnAboutToBeRemoved(const AbstractAspect*);
+	void valuesColumnAboutToBeRemoved(const AbstractAspect*);
+
+Q_SIGNALS:
+	//General-Tab
+	void dataChanged();
+	void xColumnChanged(const AbstractColumn*);
+	void yColumnChanged(const AbstractColumn*);
+	void valuesColumnChanged(const AbstractColumn*);
+	void aggregationChanged(DensityPlot::Aggregation);
+
+	//colors
+	void scalingChanged(DensityPlot::Scaling);
+	void colorMapChanged(const QString&);
+	void opacityChanged(qreal);
+};
+
+#endif
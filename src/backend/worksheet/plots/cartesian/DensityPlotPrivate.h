@@ -0,0 +1,89 @@
+/*
+    File                 : DensityPlotPrivate.h
+    Project              : LabPlot
+    Description          : 2D density plot - private implementation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef DENSITYPLOTPRIVATE_H
+#define DENSITYPLOTPRIVATE_H
+
+#include "backend/worksheet/plots/cartesian/DensityPlot.h"
+#include "backend/worksheet/WorksheetElementPrivate.h"
+#include "backend/lib/Range.h"
+
+#include <QImage>
+
+class DensityPlotPrivate: public WorksheetElementPrivate {
+public:
+	explicit DensityPlotPrivate(DensityPlot*);
+
+	void retransform() override;
+	void recalc();
+	void recalcShapeAndBoundingRect() override;
+	void updateGrid(int width, int height);
+	void updateImage();
+
+	//reimplemented from QGraphicsItem
+	QRectF boundingRect() const override;
+	QPainterPath shape() const override;
+
+	bool activateCurve(QPointF mouseScenePos, double maxDist);
+	void setHover(bool on);
+
+	// everything needed to aggregate the data on a grid of width x height pixels covering xRange x yRange
+	struct AggregationData {
+		const AbstractColumn* xColumn{nullptr};
+		const AbstractColumn* yColumn{nullptr};
+		const AbstractColumn* valuesColumn{nullptr};	// used for Sum and Mean only
+		DensityPlot::Aggregation aggregation{DensityPlot::Aggregation::Count};
+		Range<double> xRange;
+		Range<double> yRange;
+		int width{0};
+		int height{0};
+	};
+	static QVector<double> aggregate(const AggregationData&);
+	static QVector<double> scale(const QVector<double>& grid, DensityPlot::Scaling);
+	static QImage render(const QVector<double>& grid, int width, int height, DensityPlot::Scaling, const QVector<QColor>& colorMap);
+
+	DensityPlot* const q;
+
+	//General
+	const AbstractColumn* xColumn{nullptr};
+	QString xColumnPath;
+	const AbstractColumn* yColumn{nullptr};
+	QString yColumnPath;
+	const AbstractColumn* valuesColumn{nullptr};
+	QString valuesColumnPath;
+	DensityPlot::Aggregation aggregation{DensityPlot::Aggregation::Count};
+
+	double xMin{0.};
+	double xMax{1.};
+	double yMin{0.};
+	double yMax{1.};
+
+	//colors
+	DensityPlot::Scaling scaling{DensityPlot::Scaling::Log};
+	QString colorMap;
+	qreal opacity{1.0};
+
+private:
+	void contextMenuEvent(QGraphicsSceneContextMenuEvent*) override;
+	void mousePressEvent(QGraphicsSceneMouseEvent*) override;
+	void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* widget = nullptr) override;
+
+	bool m_hovered{false};
+
+	QRectF m_boundingRectangle;
+	bool m_hasData{false};	// the columns needed for the aggregation are available
+	QRectF m_gridRect;	// data rect of the plot covered by the grid
+	QPainterPath m_shape;
+	QVector<double> m_grid;	// aggregated values of the cells (row 0 at the top), NAN for cells without points
+	int m_gridWidth{0};	// size of the grid, the size of the data rect in device pixels when it was drawn last
+	int m_gridHeight{0};
+	QImage m_image;
+};
+
+#endif
@@ -43,6 +43,8 @@ extern "C" {
 #include <gsl/gsl_errno.h>
 }
 
+#include <functional>
+
 Histogram::Histogram(const QString &name)
 	: WorksheetElement(name, new HistogramPrivate(this),
 	  AspectType::Histogram), Curve() {
@@ -886,12 +888,25 @@ void HistogramPrivate::recalcHistogram() {
 	if (!dataColumn)
 		return;
 
+	// the data is read in blocks, calls \c function for all valid values
+	const int rowCount = dataColumn->rowCount();
+	auto forEachValidValue = [=](const std::function<void(double)>& function) {
+		const int blockSize = 1024;
+		double values[blockSize];
+		bool valid[blockSize];
+		for (int start = 0; start < rowCount; start += blockSize) {
+			const int count = qMin(blockSize, rowCount - start);
+			dataColumn->valuesAt(start, count, values, valid);
+			for (int i = 0; i < count; ++i) {
+				if (valid[i])
+					function(values[i]);
+			}
+		}
+	};
+
 	//calculate the number of valid data points
 	int count = 0;
-	for (int row = 0; row < dataColumn->rowCount(); ++row) {
-		if (dataColumn->isValid(row) && !dataColumn->isMasked(row))
-			++count;
-	}
+	forEachValidValue([&count](double) { ++count; });
 
 	//calculate the number of bins
 	if (count > 0) {
@@ -955,16 +970,8 @@ void HistogramPrivate::recalcHistogram() {
 			case AbstractColumn::ColumnMode::Double:
 			case AbstractColumn::ColumnMode::Integer:
 			case AbstractColumn::ColumnMode::BigInt:
-				for (int row = 0; row < dataColumn->rowCount(); ++row) {
-					if ( dataColumn->isValid(row) && !dataColumn->isMasked(row) )
-						gsl_histogram_increment(m_histogram, dataColumn->valueAt(row));
-				}
-				break;
 			case AbstractColumn::ColumnMode::DateTime:
-				for (int row = 0; row < dataColumn->rowCount(); ++row) {
-					if ( dataColumn->isValid(row) && !dataColumn->isMasked(row) )
-						gsl_histogram_increment(m_histogram, dataColumn->dateTimeAt(row).toMSecsSinceEpoch());
-			}
+				forEachValidValue([this](double value) { gsl_histogram_increment(m_histogram, value); });
 				break;
 			case AbstractColumn::ColumnMode::Text:
 			case AbstractColumn::ColumnMode::Month:
@@ -1575,11 +1582,7 @@ void HistogramPrivate::drawSymbols(QPainter* painter) {
 
 	path = trafo.map(path);
 
-	for (const auto& point : pointsScene) {
-		trafo.reset();
-		trafo.translate(point.x(), point.y());
-		painter->drawPath(trafo.map(path));
-	}
+	Symbol::draw(painter, path, pointsScene);
 }
 
 void HistogramPrivate::drawValues(QPainter* painter) {
@@ -25,6 +25,12 @@
 #include <KLocalizedString>
 
 #include <QFont>
+#include <QImage>
+#include <QPaintEngine>
+#include <QPainter>
+#include <QtMath>
+
+#include <vector>
 
 extern "C" {
 #include <gsl/gsl_math.h>
@@ -849,3 +855,173 @@ QPainterPath Symbol::stylePath(Symbol::Style style) {
 
 	return path;
 }
+
+//##############################################################################
+//#############################  symbol sprites  ###############################
+//##############################################################################
+namespace {
+const int maxSpriteSize = 256;	// symbols larger than this (in device pixels) are drawn as paths
+const int maxSprites = 16;	// number of cached sprites per thread
+const qint64 maxCulledPixels = 64 * 1024 * 1024;	// maximal area of the points (in device pixels) for the occlusion culling
+
+// symbol rasterized once in device pixels and stamped at every point
+struct SymbolSprite {
+	QPainterPath path;
+	QPen pen;
+	QBrush brush;
+	qreal scaleX;
+	qreal scaleY;
+	qreal devicePixelRatio;
+	bool antialiasing;
+	QImage image;
+	QPoint origin;	// position of the symbol origin in the image
+	bool opaque;	// all pixels of the symbol covered by another symbol at the same position are hidden
+
+	bool matches(const QPainterPath& p, const QPen& pn, const QBrush& b, qreal sx, qreal sy, qreal dpr, bool aa) const {
+		return sx == scaleX && sy == scaleY && dpr == devicePixelRatio && aa == antialiasing
+			&& pn == pen && b == brush && p == path;
+	}
+};
+
+bool isOpaque(const QColor& color) {
+	return color.alpha() == 255;
+}
+
+/*!
+ * returns the sprite of the symbol \c path drawn with the current pen and brush of \c painter.
+ * The recently used sprites are cached, the least recently used one is replaced.
+ * Returns \c nullptr if the symbol is too large to be drawn as a sprite.
+ */
+const SymbolSprite* symbolSprite(QPainter* painter, const QPainterPath& path, qreal scaleX, qreal scaleY, qreal dpr) {
+	static thread_local QVector<SymbolSprite> sprites;	// most recently used first
+
+	const QPen& pen = painter->pen();
+	const QBrush& brush = painter->brush();
+	const bool antialiasing = painter->testRenderHint(QPainter::Antialiasing);
+	for (int i = 0; i < sprites.size(); ++i) {
+		if (sprites.at(i).matches(path, pen, brush, scaleX, scaleY, dpr, antialiasing)) {
+			if (i > 0)
+				sprites.move(i, 0);
+			return &sprites.first();
+		}
+	}
+
+	// bounding box of the symbol in device pixels including the outline (miter joins extend beyond the pen width)
+	const qreal sx = scaleX * dpr;
+	const qreal sy = scaleY * dpr;
+	const QRectF bounds = path.boundingRect();
+	qreal margin = 2.;
+	if (pen.style() != Qt::NoPen) {
+		const qreal width = pen.isCosmetic() ? qMax(pen.widthF(), 1.) * dpr : pen.widthF() * qMax(sx, sy);
+		margin += width / 2. * qMax(pen.miterLimit(), 1.);
+	}
+	const QRectF deviceBounds(bounds.left() * sx - margin, bounds.top() * sy - margin,
+				bounds.width() * sx + 2 * margin, bounds.height() * sy + 2 * margin);
+	if (deviceBounds.width() > maxSpriteSize || deviceBounds.height() > maxSpriteSize)
+		return nullptr;
+
+	SymbolSprite sprite;
+	sprite.path = path;
+	sprite.pen = pen;
+	sprite.brush = brush;
+	sprite.scaleX = scaleX;
+	sprite.scaleY = scaleY;
+	sprite.devicePixelRatio = dpr;
+	sprite.antialiasing = antialiasing;
+	sprite.origin = QPoint(qCeil(-deviceBounds.left()), qCeil(-deviceBounds.top()));
+	sprite.image = QImage(sprite.origin.x() + qCeil(deviceBounds.right()) + 1,
+				sprite.origin.y() + qCeil(deviceBounds.bottom()) + 1, QImage::Format_ARGB32_Premultiplied);
+	sprite.image.fill(Qt::transparent);
+	sprite.opaque = (pen.style() == Qt::NoPen || (pen.style() == Qt::SolidLine && isOpaque(pen.color())))
+			&& (brush.style() == Qt::NoBrush || (brush.style() == Qt::SolidPattern && isOpaque(brush.color())));
+
+	QPainter p(&sprite.image);
+	p.setRenderHint(QPainter::Antialiasing, antialiasing);
+	p.translate(sprite.origin);
+	p.scale(sx, sy);
+	p.setPen(pen);
+	p.setBrush(brush);
+	p.drawPath(path);
+	p.end();
+	sprite.image.setDevicePixelRatio(dpr);
+
+	if (sprites.size() == maxSprites)
+		sprites.removeLast();
+	sprites.prepend(sprite);
+	return &sprites.first();
+}
+}
+
+/*!
+ * draws the symbol \c path (centered at the origin, in scene units) at all \c points with the
+ * current pen, brush and opacity of \c painter.
+ *
+ * On raster paint devices the symbol is rasterized once and the cached image is stamped at every point,
+ * which is much faster than drawing the path for every point. Opaque symbols at the same pixel position
+ * as an already drawn symbol are skipped. Other paint devices (printing, SVG and PDF export, etc.) get the paths.
+ */
+void Symbol::draw(QPainter* painter, const QPainterPath& path, const QVector<QPointF>& points) {
+	if (points.isEmpty())
+		return;
+
+	const QTransform& world = painter->worldTransform();
+	const auto* engine = painter->paintEngine();
+	const SymbolSprite* sprite = nullptr;
+	qreal dpr = 1.;
+	if (engine && engine->type() == QPaintEngine::Raster && world.type() <= QTransform::TxScale
+			&& world.m11() > 0 && world.m22() > 0) {
+		dpr = painter->device()->devicePixelRatioF();
+		sprite = symbolSprite(painter, path, world.m11(), world.m22(), dpr);
+	}
+
+	if (!sprite) {
+		QTransform trafo;
+		for (const auto& point : points) {
+			trafo.reset();
+			trafo.translate(point.x(), point.y());
+			painter->drawPath(trafo.map(path));
+		}
+		return;
+	}
+
+	// device pixel positions of the points
+	QVector<QPoint> pixels(points.size());
+	QRect bounds;
+	for (int i = 0; i < points.size(); ++i) {
+		const QPointF devicePoint = world.map(points.at(i)) * dpr;
+		pixels[i] = QPoint(qRound(devicePoint.x()), qRound(devicePoint.y()));
+		bounds |= QRect(pixels.at(i), QSize(1, 1));
+	}
+
+	// skip the symbols hidden behind the same opaque symbol at the same position
+	const bool cull = sprite->opaque && painter->opacity() == 1.
+			&& painter->compositionMode() == QPainter::CompositionMode_SourceOver
+			&& (qint64)bounds.width() * bounds.height() <= maxCulledPixels;
+	std::vector<bool> covered;
+	if (cull)
+		covered.resize((size_t)bounds.width() * bounds.height(), false);
+
+	// stamp the sprite with its origin at the positions
+	painter->save();
+	painter->resetTransform();
+	painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+	const QPoint origin = sprite->origin;
+	for (const auto& pixel : pixels) {
+		if (cull) {
+			const size_t index = (size_t)(pixel.y() - bounds.top()) * bounds.width() + (pixel.x() - bounds.left());
+			if (covered[index])
+				continue;
+			covered[index] = true;
+		}
+
+		painter->drawImage(QPointF(pixel - origin) / dpr, sprite->image);
+	}
+	painter->restore();
+}
+
+/*!
+ * draws the symbol \c path (centered at the origin, in scene units) at \c point, \sa draw().
+ */
+void Symbol::draw(QPainter* painter, const QPainterPath& path, QPointF point) {
+	draw(painter, path, QVector<QPointF>{point});
+}
@@ -18,6 +18,7 @@
 
 class SymbolPrivate;
 class KConfigGroup;
+class QPainter;
 
 class Symbol : public AbstractAspect {
 	Q_OBJECT
@@ -37,6 +38,8 @@ public:
 	static QString styleName(Symbol::Style);
 	static Symbol::Style indexToStyle(int);
 	static QPainterPath stylePath(Symbol::Style);
+	static void draw(QPainter*, const QPainterPath&, const QVector<QPointF>&);
+	static void draw(QPainter*, const QPainterPath&, QPointF);
 
 	explicit Symbol(const QString &name);
 	~Symbol() override;
@@ -27,6 +27,12 @@
 
 #include <KLocalizedString>
 #include <QDateTime>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+// minimal number of input points for which the calculation is done in the background
+const int backgroundJobSize = 100000;
+}
 
 XYAnalysisCurve::XYAnalysisCurve(const QString& name, AspectType type)
 	: XYCurve(name, new XYAnalysisCurvePrivate(this), type) {
@@ -48,59 +54,42 @@ void XYAnalysisCurve::init() {
 	Q_D(XYAnalysisCurve);
 	d->lineType = XYCurve::LineType::Line;
 	d->symbol->setStyle(Symbol::Style::NoSymbols);
+
+	connect(&d->jobWatcher, &QFutureWatcher<void>::finished, this, &XYAnalysisCurve::handleJobFinished);
+}
+
+/*!
+ * returns \c true if the result of a calculation running in the background is pending.
+ */
+bool XYAnalysisCurve::isCalculating() const {
+	Q_D(const XYAnalysisCurve);
+	return d->jobRunning();
 }
 
 void XYAnalysisCurve::copyData(QVector<double>& xData, QVector<double>& yData,
 		const AbstractColumn* xDataColumn, const AbstractColumn* yDataColumn, double xMin, double xMax) {
 
 	const int rowCount = qMin(xDataColumn->rowCount(), yDataColumn->rowCount());
-	for (int row = 0; row < rowCount; ++row) {
-		if (!xDataColumn->isValid(row) || xDataColumn->isMasked(row) ||
-				!yDataColumn->isValid(row) || yDataColumn->isMasked(row))
-			continue;
 
-		double x = qQNaN();
-		switch (xDataColumn->columnMode()) {
-		case AbstractColumn::ColumnMode::Double:
-			x = xDataColumn->valueAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Integer:
-			x = xDataColumn->integerAt(row);
-			break;
-		case AbstractColumn::ColumnMode::BigInt:
-			x = xDataColumn->bigIntAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Text:	// invalid
-			break;
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::Month:
-			x = xDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
-		}
-
-		double y = qQNaN();
-		switch (yDataColumn->columnMode()) {
-		case AbstractColumn::ColumnMode::Double:
-			y = yDataColumn->valueAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Integer:
-			y = yDataColumn->integerAt(row);
-			break;
-		case AbstractColumn::ColumnMode::BigInt:
-			y = yDataColumn->bigIntAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Text:	// invalid
-			break;
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::Month:
-			y = yDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
-		}
-
-		// only when inside given range
-		if (x >= xMin && x <= xMax) {
-			xData.append(x);
-			yData.append(y);
+	// the values are read in blocks
+	const int blockSize = 1024;
+	double xValues[blockSize], yValues[blockSize];
+	bool xValid[blockSize], yValid[blockSize];
+	for (int start = 0; start < rowCount; start += blockSize) {
+		const int count = qMin(blockSize, rowCount - start);
+		xDataColumn->valuesAt(start, count, xValues, xValid);
+		yDataColumn->valuesAt(start, count, yValues, yValid);
+
+		for (int i = 0; i < count; ++i) {
+			if (!xValid[i] || !yValid[i])
+				continue;
+
+			// only when inside given range
+			const double x = xValues[i];
+			if (x >= xMin && x <= xMax) {
+				xData.append(x);
+				yData.append(yValues[i]);
+			}
 		}
 	}
 }
@@ -235,9 +224,27 @@ void XYAnalysisCurve::setY2DataColumnPath(const QString& path) {
 void XYAnalysisCurve::handleSourceDataChanged() {
 	Q_D(XYAnalysisCurve);
 	d->sourceDataChangedSinceLastRecalc = true;
+
+	//the running calculation uses outdated data, restart it with the current data
+	if (d->jobRunning()) {
+		d->cancelJob();
+		recalculate();
+	}
+
 	Q_EMIT sourceDataChanged();
 }
 
+void XYAnalysisCurve::handleJobFinished() {
+	Q_D(XYAnalysisCurve);
+	//ignore the notifications of cancelled calculations
+	if (!d->jobFinish || !d->jobWatcher.isFinished())
+		return;
+
+	const auto finish = d->jobFinish;
+	d->jobFinish = nullptr;
+	finish();
+}
+
 void XYAnalysisCurve::xDataColumnAboutToBeRemoved(const AbstractAspect* aspect) {
 	Q_D(XYAnalysisCurve);
 	if (aspect == d->xDataColumn) {
@@ -285,7 +292,62 @@ XYAnalysisCurvePrivate::XYAnalysisCurvePrivate(XYAnalysisCurve* owner) : XYCurve
 
 //no need to delete xColumn and yColumn, they are deleted
 //when the parent aspect is removed
-XYAnalysisCurvePrivate::~XYAnalysisCurvePrivate() = default;
+XYAnalysisCurvePrivate::~XYAnalysisCurvePrivate() {
+	cancelJob();
+}
+
+/*!
+ * the results of the analysis are written directly into the data of the result columns,
+ * invalidates the cached properties and extrema of the result columns. To be called once after the result was written.
+ */
+void XYAnalysisCurvePrivate::invalidateResultColumns() {
+	if (xColumn)
+		xColumn->invalidateProperties();
+	if (yColumn)
+		yColumn->invalidateProperties();
+}
+
+/*!
+ * calls \c calculate and then \c finish to write the result of an analysis.
+ * For large data (\c size input points) \c calculate is executed in a worker thread
+ * and \c finish is called in the GUI thread when the calculation is done, so all results are written at once.
+ * \c calculate must only work on copies of the input data and must not access the curve.
+ * Running calculations of this curve are cancelled, their results are discarded.
+ * Long calculations check the flag \c cancelled passed to \c calculate and stop early if it's set.
+ */
+void XYAnalysisCurvePrivate::runJob(int size, const std::function<void(const std::atomic<bool>&)>& calculate, const std::function<void()>& finish) {
+	cancelJob();
+
+	if (size < backgroundJobSize || q->isLoading()) {
+		const std::atomic<bool> notCancelled{false};
+		calculate(notCancelled);
+		finish();
+		return;
+	}
+
+	DEBUG(Q_FUNC_INFO << ", calculate " << size << " points in the background")
+	jobFinish = finish;
+	jobCancelled = std::make_shared<std::atomic<bool>>(false);
+	const auto cancelled = jobCancelled;
+	jobWatcher.setFuture(QtConcurrent::run([calculate, cancelled] {
+		if (!cancelled->load())	// cancelled before it was started
+			calculate(*cancelled);
+	}));
+}
+
+void XYAnalysisCurvePrivate::cancelJob() {
+	if (!jobFinish)
+		return;
+
+	//QFuture can't cancel QtConcurrent::run(), the calculation is stopped via the flag and its result is ignored
+	jobFinish = nullptr;
+	jobCancelled->store(true);
+	jobCancelled.reset();
+}
+
+bool XYAnalysisCurvePrivate::jobRunning() const {
+	return jobFinish != nullptr;
+}
 
 //##############################################################################
 //##################  Serialization/Deserialization  ###########################
@@ -32,6 +32,7 @@ public:
 	static void copyData(QVector<double>& xData, QVector<double>& yData, const AbstractColumn* xDataColumn, const AbstractColumn* yDataColumn, double xMin, double xMax);
 
 	virtual void recalculate() = 0;
+	bool isCalculating() const;
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*, bool preview) override;
 
@@ -60,6 +61,7 @@ private:
 public Q_SLOTS:
 	void handleSourceDataChanged();
 private Q_SLOTS:
+	void handleJobFinished();
 	void xDataColumnAboutToBeRemoved(const AbstractAspect*);
 	void yDataColumnAboutToBeRemoved(const AbstractAspect*);
 	void y2DataColumnAboutToBeRemoved(const AbstractAspect*);
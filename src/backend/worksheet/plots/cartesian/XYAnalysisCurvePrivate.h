@@ -13,6 +13,11 @@
 
 #include "backend/worksheet/plots/cartesian/XYCurvePrivate.h"
 
+#include <QFutureWatcher>
+#include <atomic>
+#include <functional>
+#include <memory>
+
 class XYAnalysisCurve;
 class Column;
 class AbstractColumn;
@@ -37,6 +42,15 @@ public:
 	QVector<double>* xVector{nullptr};
 	QVector<double>* yVector{nullptr};
 
+	void invalidateResultColumns();
+	void runJob(int size, const std::function<void(const std::atomic<bool>& cancelled)>& calculate, const std::function<void()>& finish);
+	void cancelJob();
+	bool jobRunning() const;
+
+	QFutureWatcher<void> jobWatcher; //<! watches the calculation running in the background
+	std::function<void()> jobFinish; //<! writes the result of the running calculation, called in the GUI thread
+	std::shared_ptr<std::atomic<bool>> jobCancelled; //<! set to stop the running calculation
+
 	XYAnalysisCurve* const q;
 };
 
@@ -86,10 +86,7 @@ XYConvolutionCurvePrivate::XYConvolutionCurvePrivate(XYConvolutionCurve* owner)
 XYConvolutionCurvePrivate::~XYConvolutionCurvePrivate() = default;
 
 void XYConvolutionCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
-
-	//create convolution result columns if not available yet, clear them otherwise
+	//create convolution result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -105,13 +102,16 @@ void XYConvolutionCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	//clear the previous result
-	convolutionResult = XYConvolutionCurve::ConvolutionResult();
+	//the results are written at once when the convolution is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		convolutionResult = XYConvolutionCurve::ConvolutionResult();
+	};
 
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
@@ -130,6 +130,7 @@ void XYConvolutionCurvePrivate::recalculate() {
 	}
 
 	if (tmpYDataColumn == nullptr) {
+		clearResult();
 		recalcLogicalPoints();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -137,9 +138,9 @@ void XYConvolutionCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the convolution to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
-	QVector<double> y2dataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
+	auto y2dataVector = std::make_shared<QVector<double>>();
 
 	double xmin, xmax;
 	if (tmpXDataColumn && convolutionData.autoRange) {
@@ -156,15 +157,15 @@ void XYConvolutionCurvePrivate::recalculate() {
 			if (tmpXDataColumn->isValid(row) && !tmpXDataColumn->isMasked(row)
 				&& tmpYDataColumn->isValid(row) && !tmpYDataColumn->isMasked(row)) {
 				if (tmpXDataColumn->valueAt(row) >= xmin && tmpXDataColumn->valueAt(row) <= xmax) {
-					xdataVector.append(tmpXDataColumn->valueAt(row));
-					ydataVector.append(tmpYDataColumn->valueAt(row));
+					xdataVector->append(tmpXDataColumn->valueAt(row));
+					ydataVector->append(tmpYDataColumn->valueAt(row));
 				}
 			}
 		}
 	} else {	// no x-axis: take all valid values
 		for (int row = 0; row < tmpYDataColumn->rowCount(); ++row)
 			if (tmpYDataColumn->isValid(row) && !tmpYDataColumn->isMasked(row))
-				ydataVector.append(tmpYDataColumn->valueAt(row));
+				ydataVector->append(tmpYDataColumn->valueAt(row));
 	}
 
 	const nsl_conv_kernel_type kernel = convolutionData.kernel;
@@ -172,20 +173,21 @@ void XYConvolutionCurvePrivate::recalculate() {
 	if (tmpY2DataColumn != nullptr) {
 		for (int row = 0; row < tmpY2DataColumn->rowCount(); ++row)
 			if (tmpY2DataColumn->isValid(row) && !tmpY2DataColumn->isMasked(row))
-				y2dataVector.append(tmpY2DataColumn->valueAt(row));
+				y2dataVector->append(tmpY2DataColumn->valueAt(row));
 		DEBUG("kernel = given response");
 	} else {
 		DEBUG("kernel = " << nsl_conv_kernel_name[kernel] << ", size = " << kernelSize);
 		double* k = new double[kernelSize];
 		nsl_conv_standard_kernel(k, kernelSize, kernel);
 		for (size_t i = 0; i < kernelSize; i++)
-			y2dataVector.append(k[i]);
+			y2dataVector->append(k[i]);
 		delete[] k;
 	}
 
-	const size_t n = (size_t)ydataVector.size();	// number of points for signal
-	const size_t m = (size_t)y2dataVector.size();	// number of points for response
+	const size_t n = (size_t)ydataVector->size();	// number of points for signal
+	const size_t m = (size_t)y2dataVector->size();	// number of points for response
 	if (n < 1 || m < 1) {
+		clearResult();
 		convolutionResult.available = true;
 		convolutionResult.valid = false;
 		convolutionResult.status = i18n("Not enough data points available.");
@@ -195,11 +197,8 @@ void XYConvolutionCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-	double* y2data = y2dataVector.data();
-
 	// convolution settings
+	const bool hasXData = (tmpXDataColumn != nullptr);
 	const double samplingInterval = convolutionData.samplingInterval;
 	const nsl_conv_direction_type direction = convolutionData.direction;
 	const nsl_conv_type_type type = convolutionData.type;
@@ -215,49 +214,68 @@ void XYConvolutionCurvePrivate::recalculate() {
 	DEBUG("norm = " << nsl_conv_norm_name[norm]);
 	DEBUG("wrap = " << nsl_conv_wrap_name[wrap]);
 
-///////////////////////////////////////////////////////////
-	size_t np;
-	if (type == nsl_conv_type_linear)
-		np = n + m - 1;
-	else
-		np = GSL_MAX(n, m);
+	auto xResultVector = std::make_shared<QVector<double>>();
+	auto yResultVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYConvolutionCurve::ConvolutionResult>();
 
-	double* out = (double*)malloc(np * sizeof(double));
-	int status = nsl_conv_convolution_direction(ydata, n, y2data, m, direction, type, method, norm, wrap, out);
+///////////////////////////////////////////////////////////
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
 
-	if (direction == nsl_conv_direction_backward)
+		size_t np;
 		if (type == nsl_conv_type_linear)
-			np = abs((int)(n - m)) + 1;
-
-	xVector->resize((int)np);
-	yVector->resize((int)np);
-	// take given x-axis values or use index
-	if (tmpXDataColumn != nullptr) {
-		int size = GSL_MIN(xdataVector.size(), (int)np);
-		memcpy(xVector->data(), xdata, size * sizeof(double));
-		double sampleInterval = (xVector->data()[size-1] - xVector->data()[0])/(xdataVector.size()-1);
-		DEBUG("xdata size = " << xdataVector.size() << ", np = " << np << ", sample interval = " << sampleInterval);
-		for (int i = size; i < (int)np; i++)	// fill missing values
-			xVector->data()[i] = xVector->data()[size-1] + (i-size+1) * sampleInterval;
-	} else {	// fill with index (starting with 0)
-		for (size_t i = 0; i < np; i++)
-			xVector->data()[i] = i * samplingInterval;
-	}
+			np = n + m - 1;
+		else
+			np = GSL_MAX(n, m);
+
+		double* out = (double*)malloc(np * sizeof(double));
+		int status = nsl_conv_convolution_direction(ydataVector->data(), n, y2dataVector->data(), m, direction, type, method, norm, wrap, out);
+
+		if (direction == nsl_conv_direction_backward)
+			if (type == nsl_conv_type_linear)
+				np = abs((int)(n - m)) + 1;
+
+		xResultVector->resize((int)np);
+		yResultVector->resize((int)np);
+		double* xdata = xResultVector->data();
+		// take given x-axis values or use index
+		if (hasXData) {
+			int size = GSL_MIN(xdataVector->size(), (int)np);
+			memcpy(xdata, xdataVector->constData(), size * sizeof(double));
+			double sampleInterval = (xdata[size-1] - xdata[0])/(xdataVector->size()-1);
+			DEBUG("xdata size = " << xdataVector->size() << ", np = " << np << ", sample interval = " << sampleInterval);
+			for (int i = size; i < (int)np; i++)	// fill missing values
+				xdata[i] = xdata[size-1] + (i-size+1) * sampleInterval;
+		} else {	// fill with index (starting with 0)
+			for (size_t i = 0; i < np; i++)
+				xdata[i] = i * samplingInterval;
+		}
+
+		memcpy(yResultVector->data(), out, np * sizeof(double));
+		free(out);
 
-	memcpy(yVector->data(), out, np * sizeof(double));
-	free(out);
+		result->available = true;
+		result->valid = true;
+		result->status = QString::number(status);
+		result->elapsedTime = timer.elapsed();
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	convolutionResult.available = true;
-	convolutionResult.valid = true;
-	convolutionResult.status = QString::number(status);
-	convolutionResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xResultVector;
+		*yVector = *yResultVector;
+		invalidateResultColumns();
+		convolutionResult = *result;
+
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runJob((int)n, calculate, finish);
 }
 
 //##############################################################################
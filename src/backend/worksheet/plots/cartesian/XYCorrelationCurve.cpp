@@ -87,10 +87,8 @@ XYCorrelationCurvePrivate::~XYCorrelationCurvePrivate() = default;
 
 void XYCorrelationCurvePrivate::recalculate() {
 	DEBUG("XYCorrelationCurvePrivate::recalculate()");
-	QElapsedTimer timer;
-	timer.start();
 
-	//create correlation result columns if not available yet, clear them otherwise
+	//create correlation result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -106,13 +104,16 @@ void XYCorrelationCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	//clear the previous result
-	correlationResult = XYCorrelationCurve::CorrelationResult();
+	//the results are written at once when the correlation is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		correlationResult = XYCorrelationCurve::CorrelationResult();
+	};
 
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
@@ -131,6 +132,7 @@ void XYCorrelationCurvePrivate::recalculate() {
 	}
 
 	if (tmpYDataColumn == nullptr || tmpY2DataColumn == nullptr) {
+		clearResult();
 		recalcLogicalPoints();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -138,9 +140,9 @@ void XYCorrelationCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the correlation to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
-	QVector<double> y2dataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
+	auto y2dataVector = std::make_shared<QVector<double>>();
 
 	double xmin, xmax;
 	if (tmpXDataColumn != nullptr && correlationData.autoRange) {
@@ -157,26 +159,27 @@ void XYCorrelationCurvePrivate::recalculate() {
 			if (tmpXDataColumn->isValid(row) && !tmpXDataColumn->isMasked(row)
 				&& tmpYDataColumn->isValid(row) && !tmpYDataColumn->isMasked(row)) {
 				if (tmpXDataColumn->valueAt(row) >= xmin && tmpXDataColumn->valueAt(row) <= xmax) {
-					xdataVector.append(tmpXDataColumn->valueAt(row));
-					ydataVector.append(tmpYDataColumn->valueAt(row));
+					xdataVector->append(tmpXDataColumn->valueAt(row));
+					ydataVector->append(tmpYDataColumn->valueAt(row));
 				}
 			}
 		}
 	} else {	// no x-axis: take all valid values
 		for (int row = 0; row < tmpYDataColumn->rowCount(); ++row)
 			if (tmpYDataColumn->isValid(row) && !tmpYDataColumn->isMasked(row))
-				ydataVector.append(tmpYDataColumn->valueAt(row));
+				ydataVector->append(tmpYDataColumn->valueAt(row));
 	}
 
 	if (tmpY2DataColumn != nullptr) {
 		for (int row = 0; row < tmpY2DataColumn->rowCount(); ++row)
 			if (tmpY2DataColumn->isValid(row) && !tmpY2DataColumn->isMasked(row))
-				y2dataVector.append(tmpY2DataColumn->valueAt(row));
+				y2dataVector->append(tmpY2DataColumn->valueAt(row));
 	}
 
-	const size_t n = (size_t)ydataVector.size();	// number of points for signal
-	const size_t m = (size_t)y2dataVector.size();	// number of points for response
+	const size_t n = (size_t)ydataVector->size();	// number of points for signal
+	const size_t m = (size_t)y2dataVector->size();	// number of points for response
 	if (n < 1 || m < 1) {
+		clearResult();
 		correlationResult.available = true;
 		correlationResult.valid = false;
 		correlationResult.status = i18n("Not enough data points available.");
@@ -186,11 +189,8 @@ void XYCorrelationCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-	double* y2data = y2dataVector.data();
-
 	// correlation settings
+	const bool hasXData = (tmpXDataColumn != nullptr);
 	const double samplingInterval = correlationData.samplingInterval;
 	const nsl_corr_type_type type = correlationData.type;
 	const nsl_corr_norm_type norm = correlationData.normalize;
@@ -200,47 +200,66 @@ void XYCorrelationCurvePrivate::recalculate() {
 	DEBUG("type = " << nsl_corr_type_name[type]);
 	DEBUG("norm = " << nsl_corr_norm_name[norm]);
 
+	auto xResultVector = std::make_shared<QVector<double>>();
+	auto yResultVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYCorrelationCurve::CorrelationResult>();
+
 ///////////////////////////////////////////////////////////
-	size_t np = GSL_MAX(n, m);
-	if (type == nsl_corr_type_linear)
-		np = 2 * np - 1;
-
-	double* out = (double*)malloc(np * sizeof(double));
-	int status = nsl_corr_correlation(ydata, n, y2data, m, type, norm, out);
-
-	xVector->resize((int)np);
-	yVector->resize((int)np);
-	// take given x-axis values or use index
-	if (tmpXDataColumn != nullptr) {
-		int size = GSL_MIN(xdataVector.size(), (int)np);
-		memcpy(xVector->data(), xdata, size * sizeof(double));
-		double sampleInterval = (xVector->data()[size-1] - xVector->data()[0])/(xdataVector.size()-1);
-		DEBUG("xdata size = " << xdataVector.size() << ", np = " << np << ", sample interval = " << sampleInterval);
-		for (int i = size; i < (int)np; i++)	// fill missing values
-			xVector->data()[i] = xVector->data()[size-1] + (i-size+1) * sampleInterval;
-	} else {	// fill with index (starting with 0)
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
+
+		size_t np = GSL_MAX(n, m);
 		if (type == nsl_corr_type_linear)
-			for (size_t i = 0; i < np; i++)
-				xVector->data()[i] = (int)(i-np/2) * samplingInterval;
-		else
-			for (size_t i = 0; i < np; i++)
-				xVector->data()[i] = (int)i * samplingInterval;
-	}
+			np = 2 * np - 1;
+
+		double* out = (double*)malloc(np * sizeof(double));
+		int status = nsl_corr_correlation(ydataVector->data(), n, y2dataVector->data(), m, type, norm, out);
+
+		xResultVector->resize((int)np);
+		yResultVector->resize((int)np);
+		double* xdata = xResultVector->data();
+		// take given x-axis values or use index
+		if (hasXData) {
+			int size = GSL_MIN(xdataVector->size(), (int)np);
+			memcpy(xdata, xdataVector->constData(), size * sizeof(double));
+			double sampleInterval = (xdata[size-1] - xdata[0])/(xdataVector->size()-1);
+			DEBUG("xdata size = " << xdataVector->size() << ", np = " << np << ", sample interval = " << sampleInterval);
+			for (int i = size; i < (int)np; i++)	// fill missing values
+				xdata[i] = xdata[size-1] + (i-size+1) * sampleInterval;
+		} else {	// fill with index (starting with 0)
+			if (type == nsl_corr_type_linear)
+				for (size_t i = 0; i < np; i++)
+					xdata[i] = (int)(i-np/2) * samplingInterval;
+			else
+				for (size_t i = 0; i < np; i++)
+					xdata[i] = (int)i * samplingInterval;
+		}
 
-	memcpy(yVector->data(), out, np * sizeof(double));
-	free(out);
+		memcpy(yResultVector->data(), out, np * sizeof(double));
+		free(out);
+
+		result->available = true;
+		result->valid = true;
+		result->status = QString::number(status);
+		result->elapsedTime = timer.elapsed();
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	correlationResult.available = true;
-	correlationResult.valid = true;
-	correlationResult.status = QString::number(status);
-	correlationResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xResultVector;
+		*yVector = *yResultVector;
+		invalidateResultColumns();
+		correlationResult = *result;
+
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runJob((int)n, calculate, finish);
 }
 
 //##############################################################################
@@ -29,6 +29,7 @@
 #include "backend/worksheet/plots/cartesian/Symbol.h"
 #include "backend/worksheet/Worksheet.h"
 #include "backend/lib/XmlStreamReader.h"
+#include "backend/lib/parallel.h"
 #include "backend/lib/trace.h"
 #include "backend/gsl/errors.h"
 #include "tools/ImageTools.h"
@@ -37,10 +38,15 @@
 #include <QGraphicsSceneContextMenuEvent>
 #include <QMenu>
 #include <QDesktopWidget>
+#include <QFontDatabase>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <KConfig>
 #include <KLocalizedString>
 
+#include <functional>
+
 extern "C" {
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_spline.h>
@@ -101,6 +107,7 @@ void XYCurve::init() {
 	d->symbol->init(group);
 	connect(d->symbol, &Symbol::updateRequested, [=]{d->updateSymbols();});
 	connect(d->symbol, &Symbol::updatePixmapRequested, [=]{d->updatePixmap();});
+	connect(&d->m_renderWatcher, &QFutureWatcher<QImage>::finished, this, [=]{d->handleRenderFinished();});
 
 	d->valuesType = (ValuesType) group.readEntry("ValuesType", static_cast<int>(ValuesType::NoValues));
 	d->valuesPosition = (ValuesPosition) group.readEntry("ValuesPosition", static_cast<int>(ValuesPosition::Above));
@@ -960,6 +967,10 @@ XYCurvePrivate::XYCurvePrivate(XYCurve *owner) : WorksheetElementPrivate(owner),
 	setAcceptHoverEvents(false);
 }
 
+XYCurvePrivate::~XYCurvePrivate() {
+	cancelRender();
+}
+
 QRectF XYCurvePrivate::boundingRect() const {
 	return boundingRectangle;
 }
@@ -1050,11 +1061,6 @@ void XYCurvePrivate::retransform() {
 		}
 		DEBUG("	numberOfPixelX/numberOfPixelY = " << numberOfPixelX << '/' << numberOfPixelY)
 
-		// eliminate multiple scene points (size (numberOfPixelX + 1) * (numberOfPixelY + 1)) TODO: why "+1"
-		QVector<QVector<bool>> scenePointsUsed(numberOfPixelX + 1);
-		for (auto& col: scenePointsUsed)
-			col.resize(numberOfPixelY + 1);
-
 		const auto columnProperties = xColumn->properties();
 		int startIndex, endIndex;
 		if (columnProperties == AbstractColumn::Properties::MonotonicDecreasing ||
@@ -1110,66 +1116,59 @@ void XYCurvePrivate::retransform() {
 void XYCurvePrivate::recalcLogicalPoints() {
 	PERFTRACE(Q_FUNC_INFO + QLatin1String(", curve ") + name());
 
+	const QVector<QPointF> oldPoints = m_logicalPoints;	// to update the level of detail only for the changed points
 	m_pointVisible.clear();
 	m_logicalPoints.clear();
 	connectedPointsLogical.clear();
 	validPointsIndicesLogical.clear();
+	m_logicalPointsConnected = true;
 
-	if (!xColumn || !yColumn)
+	if (!xColumn || !yColumn) {
+		m_linePyramid.clear();
 		return;
+	}
 
-	auto xColMode = xColumn->columnMode();
-	auto yColMode = yColumn->columnMode();
 	const int rows = xColumn->rowCount();
 	m_logicalPoints.reserve(rows);
 
+	// the values are read in blocks
+	const int blockSize = 1024;
+	double xValues[blockSize], yValues[blockSize];
+	bool xValid[blockSize], yValid[blockSize];
+
 	//take only valid and non masked points
 	for (int row = 0; row < rows; row++) {
-		if ( xColumn->isValid(row) && yColumn->isValid(row)
-				&& (!xColumn->isMasked(row)) && (!yColumn->isMasked(row)) ) {
-			QPointF tempPoint;
-
-			switch (xColMode) {
-			case AbstractColumn::ColumnMode::Double:
-			case AbstractColumn::ColumnMode::Integer:
-			case AbstractColumn::ColumnMode::BigInt:
-				tempPoint.setX(xColumn->valueAt(row));
-				break;
-			case AbstractColumn::ColumnMode::DateTime:
-				tempPoint.setX(xColumn->dateTimeAt(row).toMSecsSinceEpoch());
-				break;
-			case AbstractColumn::ColumnMode::Text:
-			case AbstractColumn::ColumnMode::Month:
-			case AbstractColumn::ColumnMode::Day:
-				break;
-			}
-
-			switch (yColMode) {
-			case AbstractColumn::ColumnMode::Double:
-			case AbstractColumn::ColumnMode::Integer:
-			case AbstractColumn::ColumnMode::BigInt:
-				tempPoint.setY(yColumn->valueAt(row));
-				break;
-			case AbstractColumn::ColumnMode::DateTime:
-				tempPoint.setY(yColumn->dateTimeAt(row).toMSecsSinceEpoch());
-				break;
-			case AbstractColumn::ColumnMode::Text:
-			case AbstractColumn::ColumnMode::Month:
-			case AbstractColumn::ColumnMode::Day:
-				break;
-			}
-
-			m_logicalPoints.append(tempPoint);
+		const int index = row % blockSize;
+		if (index == 0) {
+			const int count = qMin(blockSize, rows - row);
+			xColumn->valuesAt(row, count, xValues, xValid);
+			yColumn->valuesAt(row, count, yValues, yValid);
+		}
+		if (xValid[index] && yValid[index]) {
+			m_logicalPoints.append(QPointF(xValues[index], yValues[index]));
 			//TODO: append, resize-reserve
 			connectedPointsLogical.push_back(true);
 			validPointsIndicesLogical.push_back(row);
 		} else {
+			// invalid and masked points interrupt the connection of the points
 			if (!connectedPointsLogical.empty())
 				connectedPointsLogical[connectedPointsLogical.size() - 1] = false;
 		}
 	}
 
-	m_pointVisible.resize(m_logicalPoints.size());
+	const int numberOfPoints = m_logicalPoints.size();
+	for (int i = 0; i < numberOfPoints - 1 && m_logicalPointsConnected; ++i)
+		m_logicalPointsConnected = connectedPointsLogical.at(i);
+
+	// points are only appended for live data, don't recalculate the groups of the unchanged points
+	const int common = qMin(oldPoints.size(), numberOfPoints);
+	int firstChanged = 0;
+	while (firstChanged < common && oldPoints.at(firstChanged).x() == m_logicalPoints.at(firstChanged).x()
+			&& oldPoints.at(firstChanged).y() == m_logicalPoints.at(firstChanged).y())
+		++firstChanged;
+	m_linePyramid.update(m_logicalPoints, firstChanged);
+
+	m_pointVisible.resize(numberOfPoints);
 }
 
 /*!
@@ -1296,6 +1295,11 @@ void XYCurvePrivate::updateLines() {
 	//float heightDatarectInch = Worksheet::convertFromSceneUnits(plot()->dataRect().height(), Worksheet::Unit::Inch);
 	//const int numberOfPixelX = ceil(widthDatarectInch * QApplication::desktop()->physicalDpiX());
 	const int numberOfPixelX = pageRect.width();
+	if (numberOfPixelX <= 0) {
+		DEBUG(Q_FUNC_INFO << ", number of pixel X <= 0!")
+		recalcShapeAndBoundingRect();
+		return;
+	}
 
 	//calculate the lines connecting the data points
 	{
@@ -1306,8 +1310,9 @@ void XYCurvePrivate::updateLines() {
 	// find index for xMin and xMax to not loop through all values
 	int startIndex, endIndex;
 	auto columnProperties = q->xColumn()->properties();
-	if (columnProperties == AbstractColumn::Properties::MonotonicDecreasing ||
-		columnProperties == AbstractColumn::Properties::MonotonicIncreasing) {
+	const bool monotonic = (columnProperties == AbstractColumn::Properties::MonotonicDecreasing ||
+		columnProperties == AbstractColumn::Properties::MonotonicIncreasing);
+	if (monotonic) {
 		DEBUG(Q_FUNC_INFO << ", monotonic")
 		const double xMin = q->cSystem->mapSceneToLogical(pageRect.topLeft()).x();
 		const double xMax = q->cSystem->mapSceneToLogical(pageRect.bottomRight()).x();
@@ -1368,14 +1373,45 @@ void XYCurvePrivate::updateLines() {
 #ifdef PERFTRACE_CURVES
 		PERFTRACE(name() + Q_FUNC_INFO + ", find relevant lines");
 #endif
-			for (int i{startIndex}; i < endIndex; i++) {
-				if (!lineSkipGaps && !connectedPointsLogical.at(i))
-					continue;
-				p0 = m_logicalPoints.at(i);
-				p1 = m_logicalPoints.at(i+1);
-				if (lineIncreasingXOnly && (p1.x() < p0.x())) // skip points
-					continue;
-				addLine(p0, xPos, minY, maxY, lastPoint, pixelDiff, numberOfPixelX, minDiffX, scale);
+			// for many more points than pixels only the first, last, minimal and maximal point of groups of
+			// consecutive points on one pixel are relevant, take them from the level of detail.
+			// The pixels are determined like in addLine(), groups on more than one pixel are split
+			QVector<int> indices;
+			if (monotonic && !lineIncreasingXOnly && (lineSkipGaps || m_logicalPointsConnected)) {
+				const QRectF dataRect = plot()->dataRect();
+				auto xPixel = [&](int index, int& pixel) {
+					const QPointF& p = m_logicalPoints.at(index);
+					if (scale == RangeT::Scale::Linear) {
+						pixel = qRound(p.x() / minDiffX);
+						return true;
+					}
+					bool visible;
+					const QPointF pScene = q->cSystem->mapLogicalToScene(p, visible, CartesianCoordinateSystem::MappingFlag::SuppressPageClipping);
+					pixel = qRound((pScene.x() - dataRect.x()) / dataRect.width() * numberOfPixelX);
+					return visible;
+				};
+				auto singlePixel = [&](int first, int last) {
+					int firstPixel, lastPixel;
+					return xPixel(first, firstPixel) && xPixel(last, lastPixel) && firstPixel == lastPixel;
+				};
+				indices = m_linePyramid.indices(startIndex, endIndex, numberOfPoints / numberOfPixelX, singlePixel);
+			}
+
+			if (!indices.isEmpty()) {
+				for (int i : qAsConst(indices)) {
+					if (i < endIndex)
+						addLine(m_logicalPoints.at(i), xPos, minY, maxY, lastPoint, pixelDiff, numberOfPixelX, minDiffX, scale);
+				}
+			} else {
+				for (int i{startIndex}; i < endIndex; i++) {
+					if (!lineSkipGaps && !connectedPointsLogical.at(i))
+						continue;
+					p0 = m_logicalPoints.at(i);
+					p1 = m_logicalPoints.at(i+1);
+					if (lineIncreasingXOnly && (p1.x() < p0.x())) // skip points
+						continue;
+					addLine(p0, xPos, minY, maxY, lastPoint, pixelDiff, numberOfPixelX, minDiffX, scale);
+				}
 			}
 			// last line
 			m_lines.append(QLineF(m_logicalPoints.at(endIndex - 1), m_logicalPoints.at(endIndex)));
@@ -2364,25 +2400,32 @@ bool XYCurve::minMax(const AbstractColumn* column1, const AbstractColumn* column
 	range.setRange(qInf(), -qInf());
 	//DEBUG(Q_FUNC_INFO << ", calculate range for index range " << indexRange.start() << " .. " << indexRange.end())
 
+	if (column1->columnMode() == AbstractColumn::ColumnMode::Text)
+		return false;
+
+	// read the values of the index range and the rows valid in both columns in blocks
+	const int blockSize = 1024;
+	double values[blockSize], values2[blockSize];
+	bool valid[blockSize], valid2[blockSize];
 	for (int i = indexRange.start(); i <= indexRange.end(); ++i) {
-		if (!column1->isValid(i) || column1->isMasked(i) || (column2 && (!column2->isValid(i) || column2->isMasked(i))))
+		const int index = (i - indexRange.start()) % blockSize;
+		if (index == 0) {
+			const int count = qMin(blockSize, indexRange.end() - i + 1);
+			column1->valuesAt(i, count, values, valid);
+			if (column2) {
+				column2->valuesAt(i, count, values2, valid2);
+				for (int j = 0; j < count; ++j)
+					valid[j] = valid[j] && valid2[j];
+			}
+		}
+		if (!valid[index])
 			continue;
 
 		if ( (errorPlusColumn && i >= errorPlusColumn->rowCount())
 				|| (errorMinusColumn && i >= errorMinusColumn->rowCount()) )
 			continue;
 
-		double value;
-		if (column1->columnMode() == AbstractColumn::ColumnMode::Double || column1->columnMode() == AbstractColumn::ColumnMode::Integer ||
-				column1->columnMode() == AbstractColumn::ColumnMode::BigInt)
-			value = column1->valueAt(i);
-		else if (column1->columnMode() == AbstractColumn::ColumnMode::DateTime ||
-				 column1->columnMode() == AbstractColumn::ColumnMode::Month ||
-				 column1->columnMode() == AbstractColumn::ColumnMode::Day)
-			value = column1->dateTimeAt(i).toMSecsSinceEpoch();
-		else
-			return false;
-
+		const double value = values[index];
 		if (errorType == ErrorType::NoError) {
 			if (value < range.start())
 				range.start() = value;
@@ -2800,91 +2843,345 @@ void XYCurvePrivate::draw(QPainter* painter) {
 	PERFTRACE(Q_FUNC_INFO + QLatin1String(", curve ") + name());
 #endif
 
+	draw(painter, renderData());
+}
+
+/*!
+ * copies everything drawn by draw(). The paths and point vectors are implicitly shared, so the copy is cheap
+ * and can be drawn in a worker thread while the curve is changed in the GUI thread.
+ */
+XYCurvePrivate::RenderData XYCurvePrivate::renderData() const {
+	RenderData data;
+
+	data.fillingPosition = fillingPosition;
+	data.fillingType = fillingType;
+	data.fillingColorStyle = fillingColorStyle;
+	data.fillingImageStyle = fillingImageStyle;
+	data.fillingBrushStyle = fillingBrushStyle;
+	data.fillingFirstColor = fillingFirstColor;
+	data.fillingSecondColor = fillingSecondColor;
+	data.fillingFileName = fillingFileName;
+	data.fillingOpacity = fillingOpacity;
+	data.fillPolygons = m_fillPolygons;
+
+	data.lineType = lineType;
+	data.linePen = linePen;
+	data.lineOpacity = lineOpacity;
+	data.linePath = linePath;
+
+	data.dropLineType = dropLineType;
+	data.dropLinePen = dropLinePen;
+	data.dropLineOpacity = dropLineOpacity;
+	data.dropLinePath = dropLinePath;
+
+	data.errorBars = (xErrorType != XYCurve::ErrorType::NoError) || (yErrorType != XYCurve::ErrorType::NoError);
+	data.errorBarsPen = errorBarsPen;
+	data.errorBarsOpacity = errorBarsOpacity;
+	data.errorBarsPath = errorBarsPath;
+
+	data.symbolStyle = symbol->style();
+	data.symbolSize = symbol->size();
+	data.symbolRotationAngle = symbol->rotationAngle();
+	data.symbolOpacity = symbol->opacity();
+	data.symbolPen = symbol->pen();
+	data.symbolBrush = symbol->brush();
+	data.scenePoints = m_scenePoints;
+
+	data.valuesType = valuesType;
+	data.valuesOpacity = valuesOpacity;
+	data.valuesColor = valuesColor;
+	data.valuesFont = valuesFont;
+	data.valuesRotationAngle = valuesRotationAngle;
+	data.valuePoints = m_valuePoints;
+	data.valueStrings = m_valueStrings;
+
+	data.rugEnabled = rugEnabled;
+	data.rugWidth = rugWidth;
+	data.rugPath = rugPath;
+
+	return data;
+}
+
+/*!
+ * draws the curve described by \c data. Only \c data is accessed, so this can be called in worker threads.
+ */
+void XYCurvePrivate::draw(QPainter* painter, const RenderData& data) {
 	//draw filling
-	if (fillingPosition != XYCurve::FillingPosition::NoFilling) {
-		painter->setOpacity(fillingOpacity);
+	if (data.fillingPosition != XYCurve::FillingPosition::NoFilling) {
+		painter->setOpacity(data.fillingOpacity);
 		painter->setPen(Qt::SolidLine);
-		drawFilling(painter);
+		drawFilling(painter, data);
 	}
 
 	//draw lines
-	if (lineType != XYCurve::LineType::NoLine) {
-		painter->setOpacity(lineOpacity);
-		painter->setPen(linePen);
+	if (data.lineType != XYCurve::LineType::NoLine) {
+		painter->setOpacity(data.lineOpacity);
+		painter->setPen(data.linePen);
 		painter->setBrush(Qt::NoBrush);
-		painter->drawPath(linePath);
+		painter->drawPath(data.linePath);
 	}
 
 	//draw drop lines
-	if (dropLineType != XYCurve::DropLineType::NoDropLine) {
-		painter->setOpacity(dropLineOpacity);
-		painter->setPen(dropLinePen);
+	if (data.dropLineType != XYCurve::DropLineType::NoDropLine) {
+		painter->setOpacity(data.dropLineOpacity);
+		painter->setPen(data.dropLinePen);
 		painter->setBrush(Qt::NoBrush);
-		painter->drawPath(dropLinePath);
+		painter->drawPath(data.dropLinePath);
 	}
 
 	//draw error bars
-	if ( (xErrorType != XYCurve::ErrorType::NoError) || (yErrorType != XYCurve::ErrorType::NoError) ) {
-		painter->setOpacity(errorBarsOpacity);
-		painter->setPen(errorBarsPen);
+	if (data.errorBars) {
+		painter->setOpacity(data.errorBarsOpacity);
+		painter->setPen(data.errorBarsPen);
 		painter->setBrush(Qt::NoBrush);
-		painter->drawPath(errorBarsPath);
+		painter->drawPath(data.errorBarsPath);
 	}
 
 	//draw symbols
-	if (symbol->style() != Symbol::Style::NoSymbols) {
-		painter->setOpacity(symbol->opacity());
-		painter->setPen(symbol->pen());
-		painter->setBrush(symbol->brush());
-		drawSymbols(painter);
+	if (data.symbolStyle != Symbol::Style::NoSymbols) {
+		painter->setOpacity(data.symbolOpacity);
+		painter->setPen(data.symbolPen);
+		painter->setBrush(data.symbolBrush);
+		drawSymbols(painter, data);
 	}
 
 	//draw values
-	if (valuesType != XYCurve::ValuesType::NoValues) {
-		painter->setOpacity(valuesOpacity);
-		painter->setPen(QPen(valuesColor));
-		painter->setFont(valuesFont);
-		drawValues(painter);
+	if (data.valuesType != XYCurve::ValuesType::NoValues) {
+		painter->setOpacity(data.valuesOpacity);
+		painter->setPen(QPen(data.valuesColor));
+		painter->setFont(data.valuesFont);
+		drawValues(painter, data);
 	}
 
 	//draw rug
-	if (rugEnabled) {
+	if (data.rugEnabled) {
 		QPen pen;
-		pen.setColor(symbol->brush().color());
-		pen.setWidthF(rugWidth);
+		pen.setColor(data.symbolBrush.color());
+		pen.setWidthF(data.rugWidth);
 		painter->setPen(pen);
-		painter->setOpacity(symbol->opacity());
-		painter->drawPath(rugPath);
+		painter->setOpacity(data.symbolOpacity);
+		painter->drawPath(data.rugPath);
+	}
+}
+
+namespace {
+// minimal size (number of points and line elements) of curves rendered in the background
+const int backgroundRenderSize = 10000;
+// minimal size of curves split into tiles rendered in parallel
+const int tiledRenderSize = 200000;
+// minimal height of a tile in pixels
+const int minTileHeight = 64;
+
+/*!
+ * distributes the lines of \c path (consisting of moveTo and lineTo elements only) to the paths \c tilePaths of
+ * the horizontal tiles of height \c tileHeight starting at \c top. Each tile gets the lines reaching into it
+ * when drawn with a pen of width \c width. Dashed lines are not split, the dash pattern would start anew in each tile.
+ */
+void splitPath(const QPainterPath& path, const QPen& pen, double width, double top, int tileHeight, QVector<QPainterPath*>& tilePaths) {
+	for (auto* tilePath : tilePaths)
+		*tilePath = (pen.style() == Qt::SolidLine) ? QPainterPath() : path;
+	if (pen.style() != Qt::SolidLine)
+		return;
+
+	// the miter of a join reaches beyond the line
+	const double margin = qMax(1., width) * qMax(1., pen.miterLimit()) + 1.;
+	const int tiles = tilePaths.size();
+	QPointF start;
+	for (int i = 0; i < path.elementCount(); ++i) {
+		const auto element = path.elementAt(i);
+		const QPointF end(element.x, element.y);
+		if (element.isLineTo()) {
+			const int first = (int)qBound(0., floor((qMin(start.y(), end.y()) - margin - top) / tileHeight), tiles - 1.);
+			const int last = (int)qBound(0., floor((qMax(start.y(), end.y()) + margin - top) / tileHeight), tiles - 1.);
+			for (int tile = first; tile <= last; ++tile) {
+				auto* tilePath = tilePaths.at(tile);
+				if (tilePath->elementCount() == 0 || tilePath->currentPosition() != start)
+					tilePath->moveTo(start);
+				tilePath->lineTo(end);
+			}
+		}
+		start = end;
+	}
+}
+}
+
+/*!
+ * splits the lines, symbols and values of \c data into the horizontal tiles of height \c tileHeight
+ * covering \c rect (in scene coordinates), so that each tile only draws the elements reaching into it.
+ * The filling is drawn in every tile.
+ */
+QVector<XYCurvePrivate::RenderData> XYCurvePrivate::tileRenderData(const RenderData& data, const QRectF& rect, int tileHeight) {
+	const int tiles = (int)ceil(rect.height() / tileHeight);
+	QVector<RenderData> tileData(tiles, data);
+	const double top = rect.top();
+	auto tileRange = [&](double y, double margin, int& first, int& last) {
+		first = (int)qBound(0., floor((y - margin - top) / tileHeight), tiles - 1.);
+		last = (int)qBound(0., floor((y + margin - top) / tileHeight), tiles - 1.);
+	};
+
+	QVector<QPainterPath*> tilePaths(tiles);
+	if (data.lineType != XYCurve::LineType::NoLine) {
+		for (int tile = 0; tile < tiles; ++tile)
+			tilePaths[tile] = &tileData[tile].linePath;
+		splitPath(data.linePath, data.linePen, data.linePen.widthF(), top, tileHeight, tilePaths);
+	}
+	if (data.dropLineType != XYCurve::DropLineType::NoDropLine) {
+		for (int tile = 0; tile < tiles; ++tile)
+			tilePaths[tile] = &tileData[tile].dropLinePath;
+		splitPath(data.dropLinePath, data.dropLinePen, data.dropLinePen.widthF(), top, tileHeight, tilePaths);
+	}
+	if (data.errorBars) {
+		for (int tile = 0; tile < tiles; ++tile)
+			tilePaths[tile] = &tileData[tile].errorBarsPath;
+		splitPath(data.errorBarsPath, data.errorBarsPen, data.errorBarsPen.widthF(), top, tileHeight, tilePaths);
+	}
+	if (data.rugEnabled) {
+		for (int tile = 0; tile < tiles; ++tile)
+			tilePaths[tile] = &tileData[tile].rugPath;
+		splitPath(data.rugPath, QPen(), data.rugWidth, top, tileHeight, tilePaths);
+	}
+
+	int first, last;
+	if (data.symbolStyle != Symbol::Style::NoSymbols) {
+		for (auto& tile : tileData)
+			tile.scenePoints.clear();
+		const double margin = data.symbolSize + data.symbolPen.widthF() + 1.;
+		for (const auto& point : data.scenePoints) {
+			tileRange(point.y(), margin, first, last);
+			for (int tile = first; tile <= last; ++tile)
+				tileData[tile].scenePoints << point;
+		}
+	}
+
+	if (data.valuesType != XYCurve::ValuesType::NoValues) {
+		for (auto& tile : tileData) {
+			tile.valuePoints.clear();
+			tile.valueStrings.clear();
+		}
+		// the texts are drawn above the value points, possibly rotated
+		const QFontMetricsF fm(data.valuesFont);
+		int length = 0;
+		for (const auto& string : data.valueStrings)
+			length = qMax(length, string.length());
+		const double margin = fm.height() + length * fm.maxWidth();
+		for (int i = 0; i < data.valuePoints.size(); ++i) {
+			tileRange(data.valuePoints.at(i).y(), margin, first, last);
+			for (int tile = first; tile <= last; ++tile) {
+				tileData[tile].valuePoints << data.valuePoints.at(i);
+				tileData[tile].valueStrings << data.valueStrings.at(i);
+			}
+		}
 	}
+
+	return tileData;
 }
 
+/*!
+ * renders the curve described by \c data into an image covering \c rect (in scene coordinates).
+ * Large curves are split into horizontal tiles drawn in parallel in the global thread pool,
+ * each tile only draws the elements reaching into it, see \c tileRenderData().
+ * Stops early and returns a null image when \c cancelled is set.
+ */
+QImage XYCurvePrivate::render(const RenderData& data, const QRectF& rect, const std::atomic<bool>* cancelled) {
+	QImage image(ceil(rect.width()), ceil(rect.height()), QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+
+	// the tiles are images sharing the rows of the image
+	uchar* bits = image.bits();
+	auto drawTile = [&](int top, int height, const RenderData& tileData) {
+		if (cancelled && cancelled->load())
+			return;
+		QImage tile(bits + top * image.bytesPerLine(), image.width(), height, image.bytesPerLine(), image.format());
+		QPainter painter(&tile);
+		painter.setRenderHint(QPainter::Antialiasing, true);
+		painter.translate(-rect.topLeft() - QPointF(0, top));
+		draw(&painter, tileData);
+	};
+
+	QThreadPool* pool = QThreadPool::globalInstance();
+	const int tiles = (data.size() < tiledRenderSize) ? 1 : qMin(pool->maxThreadCount(), image.height() / minTileHeight);
+	if (tiles > 1) {
+		const int tileHeight = (image.height() + tiles - 1) / tiles;
+		const auto tileData = tileRenderData(data, QRectF(rect.topLeft(), QSizeF(image.width(), image.height())), tileHeight);
+		runChunked(image.height(), tileHeight, [&](int top, int height) {
+			drawTile(top, height, tileData.at(top / tileHeight));
+		});
+	} else
+		drawTile(0, image.height(), data);
+
+	if (cancelled && cancelled->load())
+		return QImage();
+	return image;
+}
+
+/*!
+ * renders the curve into the cached image shown in paint(). Large curves are rendered in the background,
+ * the last image is shown scaled to the new bounding rectangle until the new image is available.
+ * A running rendering is cancelled.
+ */
 void XYCurvePrivate::updatePixmap() {
 	DEBUG(Q_FUNC_INFO << ", m_suppressRecalc = " << m_suppressRecalc);
 	if (m_suppressRecalc)
 		return;
 
-	WAIT_CURSOR;
-
+	cancelRender();
 	m_hoverEffectImageIsDirty = true;
 	m_selectionEffectImageIsDirty = true;
 	if (boundingRectangle.width() == 0 || boundingRectangle.height() == 0) {
 		DEBUG(Q_FUNC_INFO << ", boundingRectangle.width() or boundingRectangle.height() == 0");
-		m_pixmap = QPixmap();
+		m_image = QImage();
+		m_imageRect = boundingRectangle;
+		return;
+	}
+
+	const auto data = renderData();
+	// text is drawn in worker threads only if supported by the platform
+	const bool threadedValues = (data.valuesType == XYCurve::ValuesType::NoValues || QFontDatabase::supportsThreadedFontRendering());
+	if (data.size() < backgroundRenderSize || !threadedValues || q->isLoading()) {
+		WAIT_CURSOR;
+		m_image = render(data, boundingRectangle);
+		m_imageRect = boundingRectangle;
+		update();
 		RESET_CURSOR;
 		return;
 	}
-	QPixmap pixmap(ceil(boundingRectangle.width()), ceil(boundingRectangle.height()));
-	pixmap.fill(Qt::transparent);
-	QPainter painter(&pixmap);
-	painter.setRenderHint(QPainter::Antialiasing, true);
-	painter.translate(-boundingRectangle.topLeft());
 
-	draw(&painter);
-	painter.end();
-	m_pixmap = pixmap;
+	DEBUG(Q_FUNC_INFO << ", render " << data.size() << " points in the background")
+	m_renderCancelled = std::make_shared<std::atomic<bool>>(false);
+	m_renderRect = boundingRectangle;
+	m_rendering = true;
+	const auto cancelled = m_renderCancelled;
+	const QRectF rect = boundingRectangle;
+	m_renderWatcher.setFuture(QtConcurrent::run([data, rect, cancelled] { return render(data, rect, cancelled.get()); }));
+	update();
+}
 
+/*!
+ * stops the rendering running in the background, its result is discarded.
+ */
+void XYCurvePrivate::cancelRender() {
+	if (!m_rendering)
+		return;
+
+	m_rendering = false;
+	m_renderCancelled->store(true);
+	m_renderWatcher.cancel();
+}
+
+/*!
+ * shows the image rendered in the background
+ */
+void XYCurvePrivate::handleRenderFinished() {
+	//ignore the notifications of cancelled renderings
+	if (!m_rendering || m_renderWatcher.isCanceled() || !m_renderWatcher.isFinished())
+		return;
+
+	m_rendering = false;
+	m_image = m_renderWatcher.result();
+	m_imageRect = m_renderRect;
+	m_hoverEffectImageIsDirty = true;
+	m_selectionEffectImageIsDirty = true;
 	update();
-	RESET_CURSOR;
 }
 
 QVariant XYCurvePrivate::itemChange(GraphicsItemChange change, const QVariant & value) {
@@ -2908,129 +3205,128 @@ void XYCurvePrivate::paint(QPainter* painter, const QStyleOptionGraphicsItem* /*
 	painter->setBrush(Qt::NoBrush);
 	painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
 
+	// while a new image is rendered in the background, the last one is scaled to the current bounding rectangle
+	const QRectF imageRect = (m_imageRect == boundingRectangle) ? QRectF(boundingRectangle.topLeft(), QSizeF(m_image.size())) : boundingRectangle;
 	if ( !q->isPrinting() && KSharedConfig::openConfig()->group("Settings_Worksheet").readEntry<bool>("DoubleBuffering", true) )
-		painter->drawPixmap(boundingRectangle.topLeft(), m_pixmap); //draw the cached pixmap (fast)
+		painter->drawImage(imageRect, m_image, m_image.rect()); //draw the cached image (fast)
 	else
 		draw(painter); //draw directly again (slow)
 
 
 	if (m_hovered && !isSelected() && !q->isPrinting()) {
 		if (m_hoverEffectImageIsDirty) {
-			QPixmap pix = m_pixmap;
-			QPainter p(&pix);
-			p.setCompositionMode(QPainter::CompositionMode_SourceIn);	// source (shadow) pixels merged with the alpha channel of the destination (m_pixmap)
-			p.fillRect(pix.rect(), QApplication::palette().color(QPalette::Shadow));
+			QImage image = m_image;
+			QPainter p(&image);
+			p.setCompositionMode(QPainter::CompositionMode_SourceIn);	// source (shadow) pixels merged with the alpha channel of the destination (m_image)
+			p.fillRect(image.rect(), QApplication::palette().color(QPalette::Shadow));
 			p.end();
 
-			m_hoverEffectImage = ImageTools::blurred(pix.toImage(), m_pixmap.rect(), 5);
+			m_hoverEffectImage = ImageTools::blurred(image, m_image.rect(), 5);
 			m_hoverEffectImageIsDirty = false;
 		}
 
-		painter->drawImage(boundingRectangle.topLeft(), m_hoverEffectImage, m_pixmap.rect());
+		painter->drawImage(imageRect, m_hoverEffectImage, m_image.rect());
 		return;
 	}
 
 	if (isSelected() && !q->isPrinting()) {
 		if (m_selectionEffectImageIsDirty) {
-			QPixmap pix = m_pixmap;
-			QPainter p(&pix);
+			QImage image = m_image;
+			QPainter p(&image);
 			p.setCompositionMode(QPainter::CompositionMode_SourceIn);
-			p.fillRect(pix.rect(), QApplication::palette().color(QPalette::Highlight));
+			p.fillRect(image.rect(), QApplication::palette().color(QPalette::Highlight));
 			p.end();
 
-			m_selectionEffectImage = ImageTools::blurred(pix.toImage(), m_pixmap.rect(), 5);
+			m_selectionEffectImage = ImageTools::blurred(image, m_image.rect(), 5);
 			m_selectionEffectImageIsDirty = false;
 		}
 
-		painter->drawImage(boundingRectangle.topLeft(), m_selectionEffectImage, m_pixmap.rect());
+		painter->drawImage(imageRect, m_selectionEffectImage, m_image.rect());
 	}
 }
 
 /*!
-	Drawing of symbolsPath is very slow, so we draw every symbol in the loop which is much faster (factor 10)
+	Drawing of symbolsPath is very slow, so we draw every symbol separately which is much faster (factor 10).
+	On raster devices the symbol is rasterized only once and stamped at the points, \sa Symbol::draw().
 */
-void XYCurvePrivate::drawSymbols(QPainter* painter) {
-	QPainterPath path = Symbol::stylePath(symbol->style());
+void XYCurvePrivate::drawSymbols(QPainter* painter, const RenderData& data) {
+	QPainterPath path = Symbol::stylePath(data.symbolStyle);
 
 	QTransform trafo;
-	trafo.scale(symbol->size(), symbol->size());
+	trafo.scale(data.symbolSize, data.symbolSize);
 
-	if (symbol->rotationAngle() != 0.)
-		trafo.rotate(symbol->rotationAngle());
+	if (data.symbolRotationAngle != 0.)
+		trafo.rotate(data.symbolRotationAngle);
 
 	path = trafo.map(path);
 
-	for (const auto& point : qAsConst(m_scenePoints)) {
-		trafo.reset();
-		trafo.translate(point.x(), point.y());
-		painter->drawPath(trafo.map(path));
-	}
+	Symbol::draw(painter, path, data.scenePoints);
 }
 
-void XYCurvePrivate::drawValues(QPainter* painter) {
+void XYCurvePrivate::drawValues(QPainter* painter, const RenderData& data) {
 	int i = 0;
-	for (const auto& point : qAsConst(m_valuePoints)) {
+	for (const auto& point : qAsConst(data.valuePoints)) {
 		painter->translate(point);
-		if (valuesRotationAngle != 0.)
-			painter->rotate(-valuesRotationAngle);
+		if (data.valuesRotationAngle != 0.)
+			painter->rotate(-data.valuesRotationAngle);
 
-		painter->drawText(QPoint(0, 0), m_valueStrings.at(i++));
+		painter->drawText(QPoint(0, 0), data.valueStrings.at(i++));
 
-		if (valuesRotationAngle != 0.)
-			painter->rotate(valuesRotationAngle);
+		if (data.valuesRotationAngle != 0.)
+			painter->rotate(data.valuesRotationAngle);
 		painter->translate(-point);
 	}
 }
 
-void XYCurvePrivate::drawFilling(QPainter* painter) {
-	for (const auto& pol : qAsConst(m_fillPolygons)) {
+void XYCurvePrivate::drawFilling(QPainter* painter, const RenderData& data) {
+	for (const auto& pol : qAsConst(data.fillPolygons)) {
 		QRectF rect = pol.boundingRect();
-		if (fillingType == WorksheetElement::BackgroundType::Color) {
-			switch (fillingColorStyle) {
+		if (data.fillingType == WorksheetElement::BackgroundType::Color) {
+			switch (data.fillingColorStyle) {
 			case WorksheetElement::BackgroundColorStyle::SingleColor: {
-					painter->setBrush(QBrush(fillingFirstColor));
+					painter->setBrush(QBrush(data.fillingFirstColor));
 					break;
 				}
 			case WorksheetElement::BackgroundColorStyle::HorizontalLinearGradient: {
 					QLinearGradient linearGrad(rect.topLeft(), rect.topRight());
-					linearGrad.setColorAt(0, fillingFirstColor);
-					linearGrad.setColorAt(1, fillingSecondColor);
+					linearGrad.setColorAt(0, data.fillingFirstColor);
+					linearGrad.setColorAt(1, data.fillingSecondColor);
 					painter->setBrush(QBrush(linearGrad));
 					break;
 				}
 			case WorksheetElement::BackgroundColorStyle::VerticalLinearGradient: {
 					QLinearGradient linearGrad(rect.topLeft(), rect.bottomLeft());
-					linearGrad.setColorAt(0, fillingFirstColor);
-					linearGrad.setColorAt(1, fillingSecondColor);
+					linearGrad.setColorAt(0, data.fillingFirstColor);
+					linearGrad.setColorAt(1, data.fillingSecondColor);
 					painter->setBrush(QBrush(linearGrad));
 					break;
 				}
 			case WorksheetElement::BackgroundColorStyle::TopLeftDiagonalLinearGradient: {
 					QLinearGradient linearGrad(rect.topLeft(), rect.bottomRight());
-					linearGrad.setColorAt(0, fillingFirstColor);
-					linearGrad.setColorAt(1, fillingSecondColor);
+					linearGrad.setColorAt(0, data.fillingFirstColor);
+					linearGrad.setColorAt(1, data.fillingSecondColor);
 					painter->setBrush(QBrush(linearGrad));
 					break;
 				}
 			case WorksheetElement::BackgroundColorStyle::BottomLeftDiagonalLinearGradient: {
 					QLinearGradient linearGrad(rect.bottomLeft(), rect.topRight());
-					linearGrad.setColorAt(0, fillingFirstColor);
-					linearGrad.setColorAt(1, fillingSecondColor);
+					linearGrad.setColorAt(0, data.fillingFirstColor);
+					linearGrad.setColorAt(1, data.fillingSecondColor);
 					painter->setBrush(QBrush(linearGrad));
 					break;
 				}
 			case WorksheetElement::BackgroundColorStyle::RadialGradient: {
 					QRadialGradient radialGrad(rect.center(), rect.width()/2);
-					radialGrad.setColorAt(0, fillingFirstColor);
-					radialGrad.setColorAt(1, fillingSecondColor);
+					radialGrad.setColorAt(0, data.fillingFirstColor);
+					radialGrad.setColorAt(1, data.fillingSecondColor);
 					painter->setBrush(QBrush(radialGrad));
 					break;
 				}
 			}
-		} else if (fillingType == WorksheetElement::BackgroundType::Image) {
-			if ( !fillingFileName.trimmed().isEmpty() ) {
-				QPixmap pix(fillingFileName);
-				switch (fillingImageStyle) {
+		} else if (data.fillingType == WorksheetElement::BackgroundType::Image) {
+			if ( !data.fillingFileName.trimmed().isEmpty() ) {
+				QImage pix(data.fillingFileName);
+				switch (data.fillingImageStyle) {
 				case WorksheetElement::BackgroundImageStyle::ScaledCropped:
 					pix = pix.scaled(rect.size().toSize(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
 					painter->setBrush(QBrush(pix));
@@ -3047,10 +3343,10 @@ void XYCurvePrivate::drawFilling(QPainter* painter) {
 					painter->setBrushOrigin(pix.size().width()/2, pix.size().height()/2);
 					break;
 				case WorksheetElement::BackgroundImageStyle::Centered: {
-						QPixmap backpix(rect.size().toSize());
-						backpix.fill();
+						QImage backpix(rect.size().toSize(), QImage::Format_ARGB32_Premultiplied);
+						backpix.fill(Qt::white);
 						QPainter p(&backpix);
-						p.drawPixmap(QPointF(0, 0), pix);
+						p.drawImage(QPointF(0, 0), pix);
 						p.end();
 						painter->setBrush(QBrush(backpix));
 						painter->setBrushOrigin(-pix.size().width()/2, -pix.size().height()/2);
@@ -3064,8 +3360,8 @@ void XYCurvePrivate::drawFilling(QPainter* painter) {
 					painter->setBrushOrigin(pix.size().width()/2, pix.size().height()/2);
 				}
 			}
-		} else if (fillingType == WorksheetElement::BackgroundType::Pattern)
-			painter->setBrush(QBrush(fillingFirstColor, fillingBrushStyle));
+		} else if (data.fillingType == WorksheetElement::BackgroundType::Pattern)
+			painter->setBrush(QBrush(data.fillingFirstColor, data.fillingBrushStyle));
 
 		painter->drawPolygon(pol);
 	}
@@ -13,6 +13,14 @@
 #define XYCURVEPRIVATE_H
 
 #include "backend/worksheet/WorksheetElementPrivate.h"
+#include "backend/lib/MinMaxPyramid.h"
+#include "backend/worksheet/plots/cartesian/Symbol.h"
+
+#include <QFutureWatcher>
+#include <QImage>
+
+#include <atomic>
+#include <memory>
 #include <vector>
 
 class CartesianPlot;
@@ -23,6 +31,7 @@ class XYCurve;
 class XYCurvePrivate : public WorksheetElementPrivate {
 public:
 	explicit XYCurvePrivate(XYCurve*);
+	~XYCurvePrivate() override;
 
 	QRectF boundingRect() const override;
 	QPainterPath shape() const override;
@@ -40,8 +49,65 @@ public:
 	void updateErrorBars();
 	void recalcShapeAndBoundingRect() override;
 	void updatePixmap();
+	void cancelRender();
+	void handleRenderFinished();
 	void suppressRetransform(bool);
 
+	// copy of everything drawn by draw(), used to render the curve in worker threads
+	struct RenderData {
+		int size() const { return scenePoints.size() + linePath.elementCount(); }
+
+		XYCurve::FillingPosition fillingPosition{XYCurve::FillingPosition::NoFilling};
+		WorksheetElement::BackgroundType fillingType{WorksheetElement::BackgroundType::Color};
+		WorksheetElement::BackgroundColorStyle fillingColorStyle{WorksheetElement::BackgroundColorStyle::SingleColor};
+		WorksheetElement::BackgroundImageStyle fillingImageStyle{WorksheetElement::BackgroundImageStyle::Scaled};
+		Qt::BrushStyle fillingBrushStyle{Qt::SolidPattern};
+		QColor fillingFirstColor;
+		QColor fillingSecondColor;
+		QString fillingFileName;
+		qreal fillingOpacity{1.};
+		QVector<QPolygonF> fillPolygons;
+
+		XYCurve::LineType lineType{XYCurve::LineType::NoLine};
+		QPen linePen;
+		qreal lineOpacity{1.};
+		QPainterPath linePath;
+
+		XYCurve::DropLineType dropLineType{XYCurve::DropLineType::NoDropLine};
+		QPen dropLinePen;
+		qreal dropLineOpacity{1.};
+		QPainterPath dropLinePath;
+
+		bool errorBars{false};
+		QPen errorBarsPen;
+		qreal errorBarsOpacity{1.};
+		QPainterPath errorBarsPath;
+
+		Symbol::Style symbolStyle{Symbol::Style::NoSymbols};
+		qreal symbolSize{0.};
+		qreal symbolRotationAngle{0.};
+		qreal symbolOpacity{1.};
+		QPen symbolPen;
+		QBrush symbolBrush;
+		QVector<QPointF> scenePoints;
+
+		XYCurve::ValuesType valuesType{XYCurve::ValuesType::NoValues};
+		qreal valuesOpacity{1.};
+		QColor valuesColor;
+		QFont valuesFont;
+		qreal valuesRotationAngle{0.};
+		QVector<QPointF> valuePoints;
+		QVector<QString> valueStrings;
+
+		bool rugEnabled{false};
+		double rugWidth{0.};
+		QPainterPath rugPath;
+	};
+
+	RenderData renderData() const;
+	static QImage render(const RenderData&, const QRectF&, const std::atomic<bool>* cancelled = nullptr);
+	static QVector<RenderData> tileRenderData(const RenderData&, const QRectF&, int tileHeight);
+
 	void setHover(bool on);
 	bool activateCurve(QPointF mouseScenePos, double maxDist);
 	bool pointLiesNearLine(const QPointF p1, const QPointF p2, const QPointF pos, const double maxDist) const;
@@ -139,9 +205,10 @@ private:
 	QVariant itemChange(GraphicsItemChange change, const QVariant & value) override;
 	void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* widget = nullptr) override;
 
-	void drawSymbols(QPainter*);
-	void drawValues(QPainter*);
-	void drawFilling(QPainter*);
+	static void drawSymbols(QPainter*, const RenderData&);
+	static void drawValues(QPainter*, const RenderData&);
+	static void drawFilling(QPainter*, const RenderData&);
+	static void draw(QPainter*, const RenderData&);
 	void draw(QPainter*);
 
 	//TODO: add m_
@@ -161,8 +228,15 @@ private:
 	//TODO: QVector, rename, usage
 	std::vector<int> validPointsIndicesLogical;	//original indices in the source columns for valid and non-masked values (size of m_logicalPoints)
 	std::vector<bool> connectedPointsLogical;  	//true for points connected with the consecutive point (size of m_logicalPoints)
-
-	QPixmap m_pixmap;
+	bool m_logicalPointsConnected{true};		//true if all points are connected (no gaps)
+	MinMaxPyramid m_linePyramid;			//level of detail of the line for many more points than pixels
+
+	QImage m_image;	// rendered curve
+	QRectF m_imageRect;	// bounding rectangle the image was rendered for, the image is scaled to the current one while rendering
+	QFutureWatcher<QImage> m_renderWatcher;	// watches the rendering in the background
+	std::shared_ptr<std::atomic<bool>> m_renderCancelled;	// set to stop the running rendering
+	QRectF m_renderRect;	// bounding rectangle of the running rendering
+	bool m_rendering{false};
 	QImage m_hoverEffectImage;
 	QImage m_selectionEffectImage;
 	bool m_hoverEffectImageIsDirty{false};
@@ -83,10 +83,7 @@ XYDataReductionCurvePrivate::XYDataReductionCurvePrivate(XYDataReductionCurve* o
 XYDataReductionCurvePrivate::~XYDataReductionCurvePrivate() = default;
 
 void XYDataReductionCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
-
-	//create dataReduction result columns if not available yet, clear them otherwise
+	//create dataReduction result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -102,13 +99,16 @@ void XYDataReductionCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	dataReductionResult = XYDataReductionCurve::DataReductionResult();
+	//the results are written at once when the data reduction is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		dataReductionResult = XYDataReductionCurve::DataReductionResult();
+	};
 
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
@@ -124,6 +124,7 @@ void XYDataReductionCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		clearResult();
 		recalcLogicalPoints();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -131,8 +132,8 @@ void XYDataReductionCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the data reduction to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
 
 	double xmin;
 	double xmax;
@@ -144,11 +145,12 @@ void XYDataReductionCurvePrivate::recalculate() {
 		xmax = dataReductionData.xRange.last();
 	}
 
-	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
+	XYAnalysisCurve::copyData(*xdataVector, *ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
 
 	//number of data points to use
-	const size_t n = (size_t)xdataVector.size();
+	const size_t n = (size_t)xdataVector->size();
 	if (n < 2) {
+		clearResult();
 		dataReductionResult.available = true;
 		dataReductionResult.valid = false;
 		dataReductionResult.status = i18n("Not enough data points available.");
@@ -158,9 +160,6 @@ void XYDataReductionCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// dataReduction settings
 	const nsl_geom_linesim_type type = dataReductionData.type;
 	const double tol = dataReductionData.tolerance;
@@ -171,88 +170,108 @@ void XYDataReductionCurvePrivate::recalculate() {
 	DEBUG("tolerance/step:" << tol);
 	DEBUG("tolerance2/repeat/maxtol/region:" << tol2);
 
+	auto xResultVector = std::make_shared<QVector<double>>();
+	auto yResultVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYDataReductionCurve::DataReductionResult>();
+
 ///////////////////////////////////////////////////////////
-	Q_EMIT q->completed(10);
-
-	size_t npoints = 0;
-	double calcTolerance = 0;	// calculated tolerance from Douglas-Peucker variant
-	size_t *index = (size_t *) malloc(n*sizeof(size_t));
-	switch (type) {
-	case nsl_geom_linesim_type_douglas_peucker_variant:	// tol used as number of points
-		npoints = tol;
-		calcTolerance = nsl_geom_linesim_douglas_peucker_variant(xdata, ydata, n, npoints, index);
-		break;
-	case nsl_geom_linesim_type_douglas_peucker:
-		npoints = nsl_geom_linesim_douglas_peucker(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_nthpoint:	// tol used as step
-		npoints = nsl_geom_linesim_nthpoint(n, (int)tol, index);
-		break;
-	case nsl_geom_linesim_type_raddist:
-		npoints = nsl_geom_linesim_raddist(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_perpdist:	// tol2 used as repeat
-		npoints = nsl_geom_linesim_perpdist_repeat(xdata, ydata, n, tol, tol2, index);
-		break;
-	case nsl_geom_linesim_type_interp:
-		npoints = nsl_geom_linesim_interp(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_visvalingam_whyatt:
-		npoints = nsl_geom_linesim_visvalingam_whyatt(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_reumann_witkam:
-		npoints = nsl_geom_linesim_reumann_witkam(xdata, ydata, n, tol, index);
-		break;
-	case nsl_geom_linesim_type_opheim:
-		npoints = nsl_geom_linesim_opheim(xdata, ydata, n, tol, tol2, index);
-		break;
-	case nsl_geom_linesim_type_lang:	// tol2 used as region
-		npoints = nsl_geom_linesim_opheim(xdata, ydata, n, tol, tol2, index);
-		break;
-	}
+	//the progress is reported via the signal completed(), it's delivered to the GUI thread if the calculation runs in the background
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
+
+		Q_EMIT q->completed(10);
+
+		double* xdata = xdataVector->data();
+		double* ydata = ydataVector->data();
+		size_t npoints = 0;
+		double calcTolerance = 0;	// calculated tolerance from Douglas-Peucker variant
+		size_t *index = (size_t *) malloc(n*sizeof(size_t));
+		switch (type) {
+		case nsl_geom_linesim_type_douglas_peucker_variant:	// tol used as number of points
+			npoints = tol;
+			calcTolerance = nsl_geom_linesim_douglas_peucker_variant(xdata, ydata, n, npoints, index);
+			break;
+		case nsl_geom_linesim_type_douglas_peucker:
+			npoints = nsl_geom_linesim_douglas_peucker(xdata, ydata, n, tol, index);
+			break;
+		case nsl_geom_linesim_type_nthpoint:	// tol used as step
+			npoints = nsl_geom_linesim_nthpoint(n, (int)tol, index);
+			break;
+		case nsl_geom_linesim_type_raddist:
+			npoints = nsl_geom_linesim_raddist(xdata, ydata, n, tol, index);
+			break;
+		case nsl_geom_linesim_type_perpdist:	// tol2 used as repeat
+			npoints = nsl_geom_linesim_perpdist_repeat(xdata, ydata, n, tol, tol2, index);
+			break;
+		case nsl_geom_linesim_type_interp:
+			npoints = nsl_geom_linesim_interp(xdata, ydata, n, tol, index);
+			break;
+		case nsl_geom_linesim_type_visvalingam_whyatt:
+			npoints = nsl_geom_linesim_visvalingam_whyatt(xdata, ydata, n, tol, index);
+			break;
+		case nsl_geom_linesim_type_reumann_witkam:
+			npoints = nsl_geom_linesim_reumann_witkam(xdata, ydata, n, tol, index);
+			break;
+		case nsl_geom_linesim_type_opheim:
+			npoints = nsl_geom_linesim_opheim(xdata, ydata, n, tol, tol2, index);
+			break;
+		case nsl_geom_linesim_type_lang:	// tol2 used as region
+			npoints = nsl_geom_linesim_opheim(xdata, ydata, n, tol, tol2, index);
+			break;
+		}
 
-	DEBUG("npoints =" << npoints);
-	if (type == nsl_geom_linesim_type_douglas_peucker_variant)
-		DEBUG("calculated tolerance =" << calcTolerance)
-	else
-		Q_UNUSED(calcTolerance);
+		DEBUG("npoints =" << npoints);
+		if (type == nsl_geom_linesim_type_douglas_peucker_variant)
+			DEBUG("calculated tolerance =" << calcTolerance)
+		else
+			Q_UNUSED(calcTolerance);
 
-	Q_EMIT q->completed(80);
+		Q_EMIT q->completed(80);
 
-	xVector->resize((int)npoints);
-	yVector->resize((int)npoints);
-	for (int i = 0; i < (int)npoints; i++) {
-		(*xVector)[i] = xdata[index[i]];
-		(*yVector)[i] = ydata[index[i]];
-	}
+		xResultVector->resize((int)npoints);
+		yResultVector->resize((int)npoints);
+		for (int i = 0; i < (int)npoints; i++) {
+			(*xResultVector)[i] = xdata[index[i]];
+			(*yResultVector)[i] = ydata[index[i]];
+		}
 
-	Q_EMIT q->completed(90);
+		Q_EMIT q->completed(90);
 
-	const double posError = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index);
-	const double areaError = nsl_geom_linesim_area_error(xdata, ydata, n, index);
+		const double posError = nsl_geom_linesim_positional_squared_error(xdata, ydata, n, index);
+		const double areaError = nsl_geom_linesim_area_error(xdata, ydata, n, index);
 
-	free(index);
+		free(index);
 
+		result->available = true;
+		result->valid = true;
+		if (npoints > 0)
+			result->status = QString("OK");
+		else
+			result->status = QString("FAILURE");
+		result->elapsedTime = timer.elapsed();
+		result->npoints = npoints;
+		result->posError = posError;
+		result->areaError = areaError;
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	dataReductionResult.available = true;
-	dataReductionResult.valid = true;
-	if (npoints > 0)
-		dataReductionResult.status = QString("OK");
-	else
-		dataReductionResult.status = QString("FAILURE");
-	dataReductionResult.elapsedTime = timer.elapsed();
-	dataReductionResult.npoints = npoints;
-	dataReductionResult.posError = posError;
-	dataReductionResult.areaError = areaError;
-
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
-
-	Q_EMIT q->completed(100);
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xResultVector;
+		*yVector = *yResultVector;
+		invalidateResultColumns();
+		dataReductionResult = *result;
+
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+
+		Q_EMIT q->completed(100);
+	};
+
+	runJob((int)n, calculate, finish);
 }
 
 //##############################################################################
@@ -88,10 +88,7 @@ XYDifferentiationCurvePrivate::~XYDifferentiationCurvePrivate() = default;
 // ...
 // see XYFitCurvePrivate
 void XYDifferentiationCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
-
-	//create differentiation result columns if not available yet, clear them otherwise
+	//create differentiation result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -107,13 +104,16 @@ void XYDifferentiationCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	differentiationResult = XYDifferentiationCurve::DifferentiationResult();
+	//the results are written at once when the differentiation is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		differentiationResult = XYDifferentiationCurve::DifferentiationResult();
+	};
 
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
@@ -129,14 +129,15 @@ void XYDifferentiationCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		clearResult();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
 	//copy all valid data point for the differentiation to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
 
 	double xmin;
 	double xmax;
@@ -148,11 +149,12 @@ void XYDifferentiationCurvePrivate::recalculate() {
 		xmax = differentiationData.xRange.last();
 	}
 
-	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
+	XYAnalysisCurve::copyData(*xdataVector, *ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
 
 	//number of data points to differentiate
-	const size_t n = (size_t)xdataVector.size();
+	const size_t n = (size_t)xdataVector->size();
 	if (n < 3) {
+		clearResult();
 		differentiationResult.available = true;
 		differentiationResult.valid = false;
 		differentiationResult.status = i18n("Not enough data points available.");
@@ -162,9 +164,6 @@ void XYDifferentiationCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// differentiation settings
 	const nsl_diff_deriv_order_type derivOrder = differentiationData.derivOrder;
 	const int accOrder = differentiationData.accOrder;
@@ -172,48 +171,67 @@ void XYDifferentiationCurvePrivate::recalculate() {
 	DEBUG(nsl_diff_deriv_order_name[derivOrder] << "derivative");
 	DEBUG("accuracy order:" << accOrder);
 
+	auto xResultVector = std::make_shared<QVector<double>>();
+	auto yResultVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYDifferentiationCurve::DifferentiationResult>();
+
 ///////////////////////////////////////////////////////////
-	int status = 0;
-
-	switch (derivOrder) {
-	case nsl_diff_deriv_order_first:
-		status = nsl_diff_first_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_second:
-		status = nsl_diff_second_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_third:
-		status = nsl_diff_third_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_fourth:
-		status = nsl_diff_fourth_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_fifth:
-		status = nsl_diff_fifth_deriv(xdata, ydata, n, accOrder);
-		break;
-	case nsl_diff_deriv_order_sixth:
-		status = nsl_diff_sixth_deriv(xdata, ydata, n, accOrder);
-		break;
-	}
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
+
+		*xResultVector = *xdataVector;
+		*yResultVector = *ydataVector;
+		double* xdata = xResultVector->data();
+		double* ydata = yResultVector->data();
+
+		int status = 0;
+
+		switch (derivOrder) {
+		case nsl_diff_deriv_order_first:
+			status = nsl_diff_first_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_second:
+			status = nsl_diff_second_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_third:
+			status = nsl_diff_third_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_fourth:
+			status = nsl_diff_fourth_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_fifth:
+			status = nsl_diff_fifth_deriv(xdata, ydata, n, accOrder);
+			break;
+		case nsl_diff_deriv_order_sixth:
+			status = nsl_diff_sixth_deriv(xdata, ydata, n, accOrder);
+			break;
+		}
 
-	xVector->resize((int)n);
-	yVector->resize((int)n);
-	memcpy(xVector->data(), xdata, n * sizeof(double));
-	memcpy(yVector->data(), ydata, n * sizeof(double));
+		result->available = true;
+		result->valid = true;
+		result->status = QString::number(status);
+		result->elapsedTime = timer.elapsed();
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	differentiationResult.available = true;
-	differentiationResult.valid = true;
-	differentiationResult.status = QString::number(status);
-	differentiationResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xResultVector;
+		*yVector = *yResultVector;
+		invalidateResultColumns();
+		differentiationResult = *result;
+
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runJob((int)n, calculate, finish);
 }
 
+
 //##############################################################################
 //##################  Serialization/Deserialization  ###########################
 //##############################################################################
@@ -121,12 +121,12 @@ void XYEquationCurvePrivate::recalculate() {
 			//invalid number of points provided
 			xVector->clear();
 			yVector->clear();
+			xColumn->invalidateProperties();
+			yColumn->invalidateProperties();
 			recalcLogicalPoints();
 			Q_EMIT q->dataChanged();
 			return;
 		}
-		xColumn->invalidateProperties();
-		yColumn->invalidateProperties();
 	} else {
 		if (equationData.count < 1)
 			return;
@@ -148,11 +148,12 @@ void XYEquationCurvePrivate::recalculate() {
 
 	if (!rc) {
 		xVector->clear();
-		xColumn->invalidateProperties();
 		yVector->clear();
-		yColumn->invalidateProperties();
 	}
 
+	// the values were written directly into the data of the columns, the cached properties and extrema are outdated
+	xColumn->invalidateProperties();
+	yColumn->invalidateProperties();
 	recalcLogicalPoints();
 	Q_EMIT q->dataChanged();
 }
@@ -742,6 +742,8 @@ struct data {
 	double* paramMin;	// lower parameter limits
 	double* paramMax;	// upper parameter limits
 	bool* paramFixed;	// parameter fixed?
+	parser_context* context;	// parser context used to evaluate custom models
+	const char* locale;	// number locale used to parse custom models
 };
 
 /*!
@@ -760,17 +762,18 @@ int func_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
 	QStringList* paramNames = ((struct data*)params)->paramNames;
 	double *min = ((struct data*)params)->paramMin;
 	double *max = ((struct data*)params)->paramMax;
+	parser_context* context = ((struct data*)params)->context;
+	const char* locale = ((struct data*)params)->locale;
 
 	// set current values of the parameters
 	for (int i = 0; i < paramNames->size(); i++) {
 		double v = gsl_vector_get(paramValues, (size_t)i);
 		// bound values if limits are set
-		assign_symbol(qPrintable(paramNames->at(i)), nsl_fit_map_bound(v, min[i], max[i]));
+		context_assign_symbol(context, qPrintable(paramNames->at(i)), nsl_fit_map_bound(v, min[i], max[i]));
 		QDEBUG("Parameter"<<i<<" (' "<<paramNames->at(i)<<"')"<<'['<<min[i]<<','<<max[i]
 			<<"] free/bound:"<<QString::number(v, 'g', 15)<<' '<<QString::number(nsl_fit_map_bound(v, min[i], max[i]), 'g', 15));
 	}
 
-	SET_NUMBER_LOCALE
 	QString func{*(((struct data*)params)->func)};
 	for (size_t i = 0; i < n; i++) {
 		if (std::isnan(x[i]) || std::isnan(y[i]))
@@ -783,14 +786,14 @@ int func_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
 				x[i] = 0;
 		}
 
-		assign_symbol("x", x[i]);
+		context_assign_symbol(context, "x", x[i]);
 		//DEBUG("evaluate function \"" << STDSTRING(func) << "\" @ x = " << x[i] << ":");
-		double Yi = parse(qPrintable(func), qPrintable(numberLocale.name()));
-		if (parse_errors() > 0)	// fallback to default locale
-			Yi = parse(qPrintable(func), "en_US");
+		double Yi = context_parse(context, qPrintable(func), locale);
+		if (context_parse_errors(context) > 0)	// fallback to default locale
+			Yi = context_parse(context, qPrintable(func), "en_US");
 		//DEBUG("	f(x["<< i <<"]) = " << Yi);
 
-		if (parse_errors() > 0)
+		if (context_parse_errors(context) > 0)
 			return GSL_EINVAL;
 
 		//DEBUG("	weight["<< i <<"]) = " << weight[i]);
@@ -1470,34 +1473,35 @@ int func_df(const gsl_vector* paramValues, void* params, gsl_matrix* J) {
 		double value;
 		const unsigned int np = paramNames->size();
 		QString func{*(((struct data*)params)->func)};
+		parser_context* context = ((struct data*)params)->context;
+		const char* locale = ((struct data*)params)->locale;
 
-		SET_NUMBER_LOCALE
 		for (size_t i = 0; i < n; i++) {
 			x = xVector[i];
-			assign_symbol("x", x);
+			context_assign_symbol(context, "x", x);
 
 			for (unsigned int j = 0; j < np; j++) {
 				for (unsigned int k = 0; k < np; k++) {
 					if (k != j) {
 						value = nsl_fit_map_bound(gsl_vector_get(paramValues, k), min[k], max[k]);
-						assign_symbol(qPrintable(paramNames->at(k)), value);
+						context_assign_symbol(context, qPrintable(paramNames->at(k)), value);
 					}
 				}
 
 				value = nsl_fit_map_bound(gsl_vector_get(paramValues, j), min[j], max[j]);
-				assign_symbol(qPrintable(paramNames->at(j)), value);
-				double f_p = parse(qPrintable(func), qPrintable(numberLocale.name()));
-				if (parse_errors() > 0)	// fallback to default locale
-					f_p = parse(qPrintable(func), "en_US");
+				context_assign_symbol(context, qPrintable(paramNames->at(j)), value);
+				double f_p = context_parse(context, qPrintable(func), locale);
+				if (context_parse_errors(context) > 0)	// fallback to default locale
+					f_p = context_parse(context, qPrintable(func), "en_US");
 
 				double eps = 1.e-9;
 				if (std::abs(f_p) > 0)
 					eps *= std::abs(f_p);	// scale step size with function value
 				value += eps;
-				assign_symbol(qPrintable(paramNames->at(j)), value);
-				double f_pdp = parse(qPrintable(func), qPrintable(numberLocale.name()));
-				if (parse_errors() > 0)	// fallback to default locale
-					f_pdp = parse(qPrintable(func), "en_US");
+				context_assign_symbol(context, qPrintable(paramNames->at(j)), value);
+				double f_pdp = context_parse(context, qPrintable(func), locale);
+				if (context_parse_errors(context) > 0)	// fallback to default locale
+					f_pdp = context_parse(context, qPrintable(func), "en_US");
 
 //				DEBUG("evaluate deriv"<<func<<": f(x["<<i<<"]) ="<<QString::number(f_p, 'g', 15));
 //				DEBUG("evaluate deriv"<<func<<": f(x["<<i<<"]+dx) ="<<QString::number(f_pdp, 'g', 15));
@@ -1552,14 +1556,12 @@ void XYFitCurvePrivate::prepareResultColumns() {
 		DEBUG(Q_FUNC_INFO << ", Clear columns")
 		xVector->clear();
 		yVector->clear();
+		invalidateResultColumns();
 		//TODO: residualsVector->clear();
 	}
 }
 
 void XYFitCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
-
 	// prepare source data columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
 	const AbstractColumn* tmpYDataColumn = nullptr;
@@ -1577,17 +1579,27 @@ void XYFitCurvePrivate::recalculate() {
 		tmpYDataColumn = dataSourceHistogram->binValues();
 	}
 
-	// clear the previous result
-	fitResult = XYFitCurve::FitResult();
+	//the results are written at once when the fit is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		if (xVector) {
+			xVector->clear();
+			yVector->clear();
+			invalidateResultColumns();
+		}
+		fitResult = XYFitCurve::FitResult();
+	};
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
 		DEBUG(Q_FUNC_INFO << ", ERROR: Preparing source data columns failed!");
+		clearResult();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
 	}
 
-	prepareResultColumns();
+	if (!xColumn)
+		prepareResultColumns();
 
 	//fit settings
 	const unsigned int maxIters = fitData.maxIterations;	//maximal number of iterations
@@ -1595,6 +1607,7 @@ void XYFitCurvePrivate::recalculate() {
 	const unsigned int np = fitData.paramNames.size(); //number of fit parameters
 	if (np == 0) {
 		DEBUG(Q_FUNC_INFO << ", WARNING: no parameter found.")
+		clearResult();
 		fitResult.available = true;
 		fitResult.valid = false;
 		fitResult.status = i18n("Model has no parameters.");
@@ -1605,6 +1618,7 @@ void XYFitCurvePrivate::recalculate() {
 
 	if (yErrorColumn) {
 		if (yErrorColumn->rowCount() < tmpXDataColumn->rowCount()) {
+			clearResult();
 			fitResult.available = true;
 			fitResult.valid = false;
 			fitResult.status = i18n("Not sufficient weight data points provided.");
@@ -1615,10 +1629,10 @@ void XYFitCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the fit to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
-	QVector<double> xerrorVector;
-	QVector<double> yerrorVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
+	auto xerrorVector = std::make_shared<QVector<double>>();
+	auto yerrorVector = std::make_shared<QVector<double>>();
 	Range<double> xRange{tmpXDataColumn->minimum(), tmpXDataColumn->maximum()};
 	if (fitData.autoRange) {	// auto x range of data to fit
 		fitData.fitRange = xRange;
@@ -1630,14 +1644,11 @@ void XYFitCurvePrivate::recalculate() {
 	DEBUG(Q_FUNC_INFO << ", fitData range = " << fitData.fitRange.start() << " .. " << fitData.fitRange.end());
 
 	//logic from XYAnalysisCurve::copyData(), extended by the handling of error columns.
+	//all x and y values are also copied to calculate the residuals of all rows.
 	//TODO: decide how to deal with non-numerical error columns
-	int rowCount = qMin(tmpXDataColumn->rowCount(), tmpYDataColumn->rowCount());
-	for (int row = 0; row < rowCount; ++row) {
-		// omit invalid data
-		if (!tmpXDataColumn->isValid(row) || tmpXDataColumn->isMasked(row) ||
-				!tmpYDataColumn->isValid(row) || tmpYDataColumn->isMasked(row))
-			continue;
-
+	auto xResidualsVector = std::make_shared<QVector<double>>(tmpXDataColumn->rowCount());
+	auto yResidualsVector = std::make_shared<QVector<double>>(tmpXDataColumn->rowCount());
+	for (int row = 0; row < tmpXDataColumn->rowCount(); ++row) {
 		double x = qQNaN();
 		switch (tmpXDataColumn->columnMode()) {
 		case AbstractColumn::ColumnMode::Double:
@@ -1656,6 +1667,13 @@ void XYFitCurvePrivate::recalculate() {
 		case AbstractColumn::ColumnMode::Month:
 			x = tmpXDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
 		}
+		(*xResidualsVector)[row] = x;
+		(*yResidualsVector)[row] = tmpYDataColumn->valueAt(row);
+
+		// omit invalid data
+		if (row >= tmpYDataColumn->rowCount() || !tmpXDataColumn->isValid(row) || tmpXDataColumn->isMasked(row) ||
+				!tmpYDataColumn->isValid(row) || tmpYDataColumn->isMasked(row))
+			continue;
 
 		double y = qQNaN();
 		switch (tmpYDataColumn->columnMode()) {
@@ -1678,31 +1696,32 @@ void XYFitCurvePrivate::recalculate() {
 
 		if (x >= xRange.start() && x <= xRange.end()) {	// only when inside given range
 			if ((!xErrorColumn && !yErrorColumn) || !fitData.useDataErrors) {	// x-y
-				xdataVector.append(x);
-				ydataVector.append(y);
+				xdataVector->append(x);
+				ydataVector->append(y);
 			} else if (!xErrorColumn && yErrorColumn) {	// x-y-dy
 				if (!std::isnan(yErrorColumn->valueAt(row))) {
-					xdataVector.append(x);
-					ydataVector.append(y);
-					yerrorVector.append(yErrorColumn->valueAt(row));
+					xdataVector->append(x);
+					ydataVector->append(y);
+					yerrorVector->append(yErrorColumn->valueAt(row));
 				}
 			} else if (xErrorColumn && yErrorColumn) {	// x-y-dx-dy
 				if (!std::isnan(xErrorColumn->valueAt(row)) && !std::isnan(yErrorColumn->valueAt(row))) {
-					xdataVector.append(x);
-					ydataVector.append(y);
-					xerrorVector.append(xErrorColumn->valueAt(row));
-					yerrorVector.append(yErrorColumn->valueAt(row));
+					xdataVector->append(x);
+					ydataVector->append(y);
+					xerrorVector->append(xErrorColumn->valueAt(row));
+					yerrorVector->append(yErrorColumn->valueAt(row));
 				}
 			}
 		}
 	}
 
-	//QDEBUG(Q_FUNC_INFO << ", data: " << ydataVector)
+	//QDEBUG(Q_FUNC_INFO << ", data: " << *ydataVector)
 
 	//number of data points to fit
-	const size_t n = xdataVector.size();
+	const size_t n = xdataVector->size();
 	DEBUG(Q_FUNC_INFO << ", number of data points: " << n);
 	if (n == 0) {
+		clearResult();
 		fitResult.available = true;
 		fitResult.valid = false;
 		fitResult.status = i18n("No data points available.");
@@ -1712,6 +1731,7 @@ void XYFitCurvePrivate::recalculate() {
 	}
 
 	if (n < np) {
+		clearResult();
 		fitResult.available = true;
 		fitResult.valid = false;
 		fitResult.status = i18n("The number of data points (%1) must be greater than or equal to the number of parameters (%2).", n, np);
@@ -1721,6 +1741,7 @@ void XYFitCurvePrivate::recalculate() {
 	}
 
 	if (fitData.model.simplified().isEmpty()) {
+		clearResult();
 		fitResult.available = true;
 		fitResult.valid = false;
 		fitResult.status = i18n("Fit model not specified.");
@@ -1729,367 +1750,388 @@ void XYFitCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-	double* xerror = xerrorVector.data();	// size may be 0
-	double* yerror = yerrorVector.data();	// size may be 0
-	DEBUG(Q_FUNC_INFO << ", x error vector size: " << xerrorVector.size());
-	DEBUG(Q_FUNC_INFO << ", y error vector size: " << yerrorVector.size());
-	double* weight = new double[n];
-
-	for (size_t i = 0; i < n; i++)
-		weight[i] = 1.;
-
-	const double minError = 1.e-199;	// minimum error for weighting
-
-	switch (fitData.yWeightsType) {
-	case nsl_fit_weight_no:
-	case nsl_fit_weight_statistical_fit:
-	case nsl_fit_weight_relative_fit:
-		break;
-	case nsl_fit_weight_instrumental:	// yerror are sigmas
-		for (int i = 0; i < (int)n; i++)
-			if (i < yerrorVector.size())
-				weight[i] = 1./gsl_pow_2(qMax(yerror[i], qMax(sqrt(minError), fabs(ydata[i]) * 1.e-15)));
-		break;
-	case nsl_fit_weight_direct:		// yerror are weights
-		for (int i = 0; i < (int)n; i++)
-			if (i < yerrorVector.size())
-				weight[i] = yerror[i];
-		break;
-	case nsl_fit_weight_inverse:		// yerror are inverse weights
-		for (int i = 0; i < (int)n; i++)
-			if (i < yerrorVector.size())
-				weight[i] = 1./qMax(yerror[i], qMax(minError, fabs(ydata[i]) * 1.e-15));
-		break;
-	case nsl_fit_weight_statistical:
-		for (int i = 0; i < (int)n; i++)
-			weight[i] = 1./qMax(ydata[i], minError);
-		break;
-	case nsl_fit_weight_relative:
-		for (int i = 0; i < (int)n; i++)
-			weight[i] = 1./qMax(gsl_pow_2(ydata[i]), minError);
-		break;
-	}
-
-	/////////////////////// GSL >= 2 has a complete new interface! But the old one is still supported. ///////////////////////////
-	// GSL >= 2 : "the 'fdf' field of gsl_multifit_function_fdf is now deprecated and does not need to be specified for nonlinear least squares problems"
-	unsigned int nf = 0;	// number of fixed parameter
-	for (unsigned int i = 0; i < np; i++) {
-		const bool fixed = fitData.paramFixed.data()[i];
-		if (fixed)
-			nf++;
-		DEBUG("	parameter " << i << " fixed: " << fixed);
-	}
-
-	//function to fit
-	gsl_multifit_function_fdf f;
-	DEBUG(Q_FUNC_INFO << ", model = " << STDSTRING(fitData.model));
-	struct data params = {n, xdata, ydata, weight, fitData.modelCategory, fitData.modelType, fitData.degree, &fitData.model, &fitData.paramNames, fitData.paramLowerLimits.data(), fitData.paramUpperLimits.data(), fitData.paramFixed.data()};
-	f.f = &func_f;
-	f.df = &func_df;
-	f.fdf = &func_fdf;
-	f.n = n;
-	f.p = np;
-	f.params = &params;
-
-	DEBUG(Q_FUNC_INFO << ", initialize the derivative solver (using Levenberg-Marquardt robust solver)");
-	const gsl_multifit_fdfsolver_type* T = gsl_multifit_fdfsolver_lmsder;
-	gsl_multifit_fdfsolver* s = gsl_multifit_fdfsolver_alloc(T, n, np);
-
-	DEBUG(Q_FUNC_INFO << ", set start values");
-	double* x_init = fitData.paramStartValues.data();
-	double* x_min = fitData.paramLowerLimits.data();
-	double* x_max = fitData.paramUpperLimits.data();
-	DEBUG(Q_FUNC_INFO << ", scale start values if limits are set");
-	for (unsigned int i = 0; i < np; i++)
-		x_init[i] = nsl_fit_map_unbound(x_init[i], x_min[i], x_max[i]);
-	DEBUG(Q_FUNC_INFO << ",	DONE");
-	gsl_vector_view x = gsl_vector_view_array(x_init, np);
-	DEBUG(Q_FUNC_INFO << ", Turning off GSL error handler to avoid overflow/underflow");
-	gsl_set_error_handler_off();
-	DEBUG(Q_FUNC_INFO << ", Initialize solver with function f and initial guess x");
-	gsl_multifit_fdfsolver_set(s, &f, &x.vector);
-
-	DEBUG(Q_FUNC_INFO << ", Iterate ...");
-	int status = GSL_SUCCESS;
-	unsigned int iter = 0;
-	fitResult.solverOutput.clear();
-	writeSolverState(s);
-	do {
-		iter++;
-		DEBUG(Q_FUNC_INFO << ",	iter " << iter);
-
-		// update weights for Y-depending weights (using function values from residuals)
-		if (fitData.yWeightsType == nsl_fit_weight_statistical_fit) {
-			for (size_t i = 0; i < n; i++)
-				weight[i] = 1./(gsl_vector_get(s->f, i)/sqrt(weight[i]) + ydata[i]);	// 1/Y_i
-		} else if (fitData.yWeightsType == nsl_fit_weight_relative_fit) {
-			for (size_t i = 0; i < n; i++)
-				weight[i] = 1./gsl_pow_2(gsl_vector_get(s->f, i)/sqrt(weight[i]) + ydata[i]);	// 1/Y_i^2
-		}
-
-		if (nf == np) {	// all fixed parameter
-			DEBUG(Q_FUNC_INFO << ", all parameter fixed. Stop iteration.")
-			break;
-		}
-		DEBUG(Q_FUNC_INFO << ", run fdfsolver_iterate");
-		status = gsl_multifit_fdfsolver_iterate(s);
-		DEBUG(Q_FUNC_INFO << ", fdfsolver_iterate DONE");
-		double chi = gsl_blas_dnrm2(s->f);
-		writeSolverState(s, chi);
-		if (status) {
-			DEBUG(Q_FUNC_INFO << ",	iter " << iter << ", status = " << gsl_strerror(status));
-			if (status == GSL_ETOLX) 	// change in the position vector falls below machine precision: no progress
-				status = GSL_SUCCESS;
+	//the fit works on a copy of the fit settings and of the start values, the locale is determined here since the settings are read in the GUI thread
+	auto settings = std::make_shared<XYFitCurve::FitData>(fitData);
+	SET_NUMBER_LOCALE
+	const QByteArray locale = numberLocale.name().toLatin1();
+	ExpressionParser* parser = ExpressionParser::getInstance();
+	auto result = std::make_shared<XYFitCurve::FitResult>();
+	auto residuals = std::make_shared<QVector<double>>();
+
+///////////////////////////////////////////////////////////
+	auto calculate = [=](const std::atomic<bool>& cancelled) {
+		QElapsedTimer timer;
+		timer.start();
+
+		double* xdata = xdataVector->data();
+		double* ydata = ydataVector->data();
+		double* xerror = xerrorVector->data();	// size may be 0
+		double* yerror = yerrorVector->data();	// size may be 0
+		DEBUG(Q_FUNC_INFO << ", x error vector size: " << xerrorVector->size());
+		DEBUG(Q_FUNC_INFO << ", y error vector size: " << yerrorVector->size());
+		double* weight = new double[n];
+
+		for (size_t i = 0; i < n; i++)
+			weight[i] = 1.;
+
+		const double minError = 1.e-199;	// minimum error for weighting
+
+		switch (settings->yWeightsType) {
+		case nsl_fit_weight_no:
+		case nsl_fit_weight_statistical_fit:
+		case nsl_fit_weight_relative_fit:
+			break;
+		case nsl_fit_weight_instrumental:	// yerror are sigmas
+			for (int i = 0; i < (int)n; i++)
+				if (i < yerrorVector->size())
+					weight[i] = 1./gsl_pow_2(qMax(yerror[i], qMax(sqrt(minError), fabs(ydata[i]) * 1.e-15)));
+			break;
+		case nsl_fit_weight_direct:		// yerror are weights
+			for (int i = 0; i < (int)n; i++)
+				if (i < yerrorVector->size())
+					weight[i] = yerror[i];
+			break;
+		case nsl_fit_weight_inverse:		// yerror are inverse weights
+			for (int i = 0; i < (int)n; i++)
+				if (i < yerrorVector->size())
+					weight[i] = 1./qMax(yerror[i], qMax(minError, fabs(ydata[i]) * 1.e-15));
+			break;
+		case nsl_fit_weight_statistical:
+			for (int i = 0; i < (int)n; i++)
+				weight[i] = 1./qMax(ydata[i], minError);
+			break;
+		case nsl_fit_weight_relative:
+			for (int i = 0; i < (int)n; i++)
+				weight[i] = 1./qMax(gsl_pow_2(ydata[i]), minError);
 			break;
 		}
-		if (qFuzzyIsNull(chi)) {
-			DEBUG(Q_FUNC_INFO << ", chi is zero! Finishing.")
-			status = GSL_SUCCESS;
-		} else {
-			status = gsl_multifit_test_delta(s->dx, s->x, delta, delta);
-		}
-		DEBUG(Q_FUNC_INFO << ",	iter " << iter << ", test status = " << gsl_strerror(status));
-	} while (status == GSL_CONTINUE && iter < maxIters);
 
-	// second run for x-error fitting
-	if (xerrorVector.size() > 0) {
-		DEBUG(Q_FUNC_INFO << ", Rerun fit with x errors");
+		/////////////////////// GSL >= 2 has a complete new interface! But the old one is still supported. ///////////////////////////
+		// GSL >= 2 : "the 'fdf' field of gsl_multifit_function_fdf is now deprecated and does not need to be specified for nonlinear least squares problems"
+		unsigned int nf = 0;	// number of fixed parameter
+		for (unsigned int i = 0; i < np; i++) {
+			const bool fixed = settings->paramFixed.data()[i];
+			if (fixed)
+				nf++;
+			DEBUG("	parameter " << i << " fixed: " << fixed);
+		}
 
-		unsigned int iter2 = 0;
-		double chi = 0, chiOld = 0;
-		double *fun = new double[n];
+		//function to fit, custom models are evaluated in a separate parser context since the fit may run in a worker thread
+		parser_context* context = create_context();
+		gsl_multifit_function_fdf f;
+		DEBUG(Q_FUNC_INFO << ", model = " << STDSTRING(settings->model));
+		struct data params = {n, xdata, ydata, weight, settings->modelCategory, settings->modelType, settings->degree, &settings->model, &settings->paramNames,
+			settings->paramLowerLimits.data(), settings->paramUpperLimits.data(), settings->paramFixed.data(), context, locale.constData()};
+		f.f = &func_f;
+		f.df = &func_df;
+		f.fdf = &func_fdf;
+		f.n = n;
+		f.p = np;
+		f.params = &params;
+
+		DEBUG(Q_FUNC_INFO << ", initialize the derivative solver (using Levenberg-Marquardt robust solver)");
+		const gsl_multifit_fdfsolver_type* T = gsl_multifit_fdfsolver_lmsder;
+		gsl_multifit_fdfsolver* s = gsl_multifit_fdfsolver_alloc(T, n, np);
+
+		DEBUG(Q_FUNC_INFO << ", set start values");
+		double* x_init = settings->paramStartValues.data();
+		double* x_min = settings->paramLowerLimits.data();
+		double* x_max = settings->paramUpperLimits.data();
+		DEBUG(Q_FUNC_INFO << ", scale start values if limits are set");
+		for (unsigned int i = 0; i < np; i++)
+			x_init[i] = nsl_fit_map_unbound(x_init[i], x_min[i], x_max[i]);
+		DEBUG(Q_FUNC_INFO << ",	DONE");
+		gsl_vector_view x = gsl_vector_view_array(x_init, np);
+		DEBUG(Q_FUNC_INFO << ", Turning off GSL error handler to avoid overflow/underflow");
+		gsl_set_error_handler_off();
+		DEBUG(Q_FUNC_INFO << ", Initialize solver with function f and initial guess x");
+		gsl_multifit_fdfsolver_set(s, &f, &x.vector);
+
+		DEBUG(Q_FUNC_INFO << ", Iterate ...");
+		int status = GSL_SUCCESS;
+		unsigned int iter = 0;
+		writeSolverState(s, *settings, *result);
 		do {
-			iter2++;
-			chiOld = chi;
-			//printf("iter2 = %d\n", iter2);
-
-			// calculate function from residuals
-			for (size_t i = 0; i < n; i++)
-				fun[i] = gsl_vector_get(s->f, i) * 1./sqrt(weight[i]) + ydata[i];
-
-			// calculate weight[i]
-			for (size_t i = 0; i < n; i++) {
-				// calculate df[i]
-				size_t index = i-1;
-				if (i == 0)
-					index = i;
-				if (i == n-1)
-					index = i-2;
-				double df = (fun[index+1] - fun[index])/(xdata[index+1] - xdata[index]);
-				//printf("df = %g\n", df);
-
-				double sigmasq = 1.;
-				switch (fitData.xWeightsType) {	// x-error type: f'(x)^2*s_x^2 = f'(x)/w_x
-				case nsl_fit_weight_no:
-					break;
-				case nsl_fit_weight_direct:	// xerror = w_x
-					sigmasq = df*df/qMax(xerror[i], minError);
-					break;
-				case nsl_fit_weight_instrumental:	// xerror = s_x
-					sigmasq = df*df*xerror[i]*xerror[i];
-					break;
-				case nsl_fit_weight_inverse:	// xerror = 1/w_x = s_x^2
-					sigmasq = df*df*xerror[i];
-					break;
-				case nsl_fit_weight_statistical:	// s_x^2 = 1/w_x = x
-					sigmasq = xdata[i];
-					break;
-				case nsl_fit_weight_relative:		// s_x^2 = 1/w_x = x^2
-					sigmasq = xdata[i]*xdata[i];
-					break;
-				case nsl_fit_weight_statistical_fit:	// unused
-				case nsl_fit_weight_relative_fit:
-					break;
-				}
+			iter++;
+			DEBUG(Q_FUNC_INFO << ",	iter " << iter);
+
+			// update weights for Y-depending weights (using function values from residuals)
+			if (settings->yWeightsType == nsl_fit_weight_statistical_fit) {
+				for (size_t i = 0; i < n; i++)
+					weight[i] = 1./(gsl_vector_get(s->f, i)/sqrt(weight[i]) + ydata[i]);	// 1/Y_i
+			} else if (settings->yWeightsType == nsl_fit_weight_relative_fit) {
+				for (size_t i = 0; i < n; i++)
+					weight[i] = 1./gsl_pow_2(gsl_vector_get(s->f, i)/sqrt(weight[i]) + ydata[i]);	// 1/Y_i^2
+			}
 
-				if (yerrorVector.size() > 0) {
-					switch (fitData.yWeightsType) {	// y-error types: s_y^2 = 1/w_y
+			if (nf == np) {	// all fixed parameter
+				DEBUG(Q_FUNC_INFO << ", all parameter fixed. Stop iteration.")
+				break;
+			}
+			DEBUG(Q_FUNC_INFO << ", run fdfsolver_iterate");
+			status = gsl_multifit_fdfsolver_iterate(s);
+			DEBUG(Q_FUNC_INFO << ", fdfsolver_iterate DONE");
+			double chi = gsl_blas_dnrm2(s->f);
+			writeSolverState(s, *settings, *result, chi);
+			if (status) {
+				DEBUG(Q_FUNC_INFO << ",	iter " << iter << ", status = " << gsl_strerror(status));
+				if (status == GSL_ETOLX) 	// change in the position vector falls below machine precision: no progress
+					status = GSL_SUCCESS;
+				break;
+			}
+			if (qFuzzyIsNull(chi)) {
+				DEBUG(Q_FUNC_INFO << ", chi is zero! Finishing.")
+				status = GSL_SUCCESS;
+			} else {
+				status = gsl_multifit_test_delta(s->dx, s->x, delta, delta);
+			}
+			DEBUG(Q_FUNC_INFO << ",	iter " << iter << ", test status = " << gsl_strerror(status));
+		} while (status == GSL_CONTINUE && iter < maxIters && !cancelled);
+
+		// second run for x-error fitting
+		if (xerrorVector->size() > 0 && !cancelled) {
+			DEBUG(Q_FUNC_INFO << ", Rerun fit with x errors");
+
+			unsigned int iter2 = 0;
+			double chi = 0, chiOld = 0;
+			double *fun = new double[n];
+			do {
+				iter2++;
+				chiOld = chi;
+				//printf("iter2 = %d\n", iter2);
+
+				// calculate function from residuals
+				for (size_t i = 0; i < n; i++)
+					fun[i] = gsl_vector_get(s->f, i) * 1./sqrt(weight[i]) + ydata[i];
+
+				// calculate weight[i]
+				for (size_t i = 0; i < n; i++) {
+					// calculate df[i]
+					size_t index = i-1;
+					if (i == 0)
+						index = i;
+					if (i == n-1)
+						index = i-2;
+					double df = (fun[index+1] - fun[index])/(xdata[index+1] - xdata[index]);
+					//printf("df = %g\n", df);
+
+					double sigmasq = 1.;
+					switch (settings->xWeightsType) {	// x-error type: f'(x)^2*s_x^2 = f'(x)/w_x
 					case nsl_fit_weight_no:
 						break;
-					case nsl_fit_weight_direct:	// yerror = w_y
-						sigmasq += 1./qMax(yerror[i], minError);
+					case nsl_fit_weight_direct:	// xerror = w_x
+						sigmasq = df*df/qMax(xerror[i], minError);
 						break;
-					case nsl_fit_weight_instrumental:	// yerror = s_y
-						sigmasq += yerror[i]*yerror[i];
+					case nsl_fit_weight_instrumental:	// xerror = s_x
+						sigmasq = df*df*xerror[i]*xerror[i];
 						break;
-					case nsl_fit_weight_inverse:	// yerror = 1/w_y
-						sigmasq += yerror[i];
+					case nsl_fit_weight_inverse:	// xerror = 1/w_x = s_x^2
+						sigmasq = df*df*xerror[i];
 						break;
-					case nsl_fit_weight_statistical:	// unused
-					case nsl_fit_weight_relative:
+					case nsl_fit_weight_statistical:	// s_x^2 = 1/w_x = x
+						sigmasq = xdata[i];
 						break;
-					case nsl_fit_weight_statistical_fit:	// s_y^2 = 1/w_y = Y_i
-						sigmasq += fun[i];
+					case nsl_fit_weight_relative:		// s_x^2 = 1/w_x = x^2
+						sigmasq = xdata[i]*xdata[i];
 						break;
-					case nsl_fit_weight_relative_fit:	// s_y^2 = 1/w_y = Y_i^2
-						sigmasq += fun[i]*fun[i];
+					case nsl_fit_weight_statistical_fit:	// unused
+					case nsl_fit_weight_relative_fit:
 						break;
 					}
-				}
 
-				//printf ("sigma[%d] = %g\n", i, sqrt(sigmasq));
-				weight[i] = 1./qMax(sigmasq, minError);
-			}
+					if (yerrorVector->size() > 0) {
+						switch (settings->yWeightsType) {	// y-error types: s_y^2 = 1/w_y
+						case nsl_fit_weight_no:
+							break;
+						case nsl_fit_weight_direct:	// yerror = w_y
+							sigmasq += 1./qMax(yerror[i], minError);
+							break;
+						case nsl_fit_weight_instrumental:	// yerror = s_y
+							sigmasq += yerror[i]*yerror[i];
+							break;
+						case nsl_fit_weight_inverse:	// yerror = 1/w_y
+							sigmasq += yerror[i];
+							break;
+						case nsl_fit_weight_statistical:	// unused
+						case nsl_fit_weight_relative:
+							break;
+						case nsl_fit_weight_statistical_fit:	// s_y^2 = 1/w_y = Y_i
+							sigmasq += fun[i];
+							break;
+						case nsl_fit_weight_relative_fit:	// s_y^2 = 1/w_y = Y_i^2
+							sigmasq += fun[i]*fun[i];
+							break;
+						}
+					}
 
-			// update weights
-			gsl_multifit_fdfsolver_set(s, &f, &x.vector);
-
-			do {	// fit
-				iter++;
-				writeSolverState(s);
-				status = gsl_multifit_fdfsolver_iterate(s);
-				//printf ("status = %s\n", gsl_strerror (status));
-				if (nf == np) 	// stop if all parameters fix
-					break;
-
-				if (status) {
-					DEBUG("		iter " << iter << ", status = " << gsl_strerror(status));
-					if (status == GSL_ETOLX) 	// change in the position vector falls below machine precision: no progress
-						status = GSL_SUCCESS;
-					break;
+					//printf ("sigma[%d] = %g\n", i, sqrt(sigmasq));
+					weight[i] = 1./qMax(sigmasq, minError);
 				}
-				status = gsl_multifit_test_delta(s->dx, s->x, delta, delta);
-			} while (status == GSL_CONTINUE && iter < maxIters);
 
-			chi = gsl_blas_dnrm2(s->f);
-		} while (iter2 < maxIters && fabs(chi - chiOld) > fitData.eps);
+				// update weights
+				gsl_multifit_fdfsolver_set(s, &f, &x.vector);
 
-		delete[] fun;
-	}
+				do {	// fit
+					iter++;
+					writeSolverState(s, *settings, *result);
+					status = gsl_multifit_fdfsolver_iterate(s);
+					//printf ("status = %s\n", gsl_strerror (status));
+					if (nf == np) 	// stop if all parameters fix
+						break;
+
+					if (status) {
+						DEBUG("		iter " << iter << ", status = " << gsl_strerror(status));
+						if (status == GSL_ETOLX) 	// change in the position vector falls below machine precision: no progress
+							status = GSL_SUCCESS;
+						break;
+					}
+					status = gsl_multifit_test_delta(s->dx, s->x, delta, delta);
+				} while (status == GSL_CONTINUE && iter < maxIters && !cancelled);
+
+				chi = gsl_blas_dnrm2(s->f);
+			} while (iter2 < maxIters && fabs(chi - chiOld) > settings->eps && !cancelled);
+
+			delete[] fun;
+		}
+
+		delete[] weight;
+		free_context(context);
 
-	delete[] weight;
+		if (cancelled) {	// the result is discarded
+			gsl_multifit_fdfsolver_free(s);
+			return;
+		}
 
-	// unscale start parameter
-	for (unsigned int i = 0; i < np; i++)
-		x_init[i] = nsl_fit_map_bound(x_init[i], x_min[i], x_max[i]);
+		// unscale start parameter
+		for (unsigned int i = 0; i < np; i++)
+			x_init[i] = nsl_fit_map_bound(x_init[i], x_min[i], x_max[i]);
 
-	//get the covariance matrix
-	//TODO: scale the Jacobian when limits are used before constructing the covar matrix?
-	gsl_matrix* covar = gsl_matrix_alloc(np, np);
+		//get the covariance matrix
+		//TODO: scale the Jacobian when limits are used before constructing the covar matrix?
+		gsl_matrix* covar = gsl_matrix_alloc(np, np);
 #if GSL_MAJOR_VERSION >= 2
-	// the Jacobian is not part of the solver anymore
-	gsl_matrix *J = gsl_matrix_alloc(s->fdf->n, s->fdf->p);
-	gsl_multifit_fdfsolver_jac(s, J);
-	gsl_multifit_covar(J, 0.0, covar);
+		// the Jacobian is not part of the solver anymore
+		gsl_matrix *J = gsl_matrix_alloc(s->fdf->n, s->fdf->p);
+		gsl_multifit_fdfsolver_jac(s, J);
+		gsl_multifit_covar(J, 0.0, covar);
 #else
-	gsl_multifit_covar(s->J, 0.0, covar);
+		gsl_multifit_covar(s->J, 0.0, covar);
 #endif
 
-	//write the result
-	fitResult.available = true;
-	fitResult.valid = true;
-	fitResult.status = gslErrorToString(status);
-	fitResult.iterations = iter;
-	fitResult.dof = n - (np - nf);	// samples - (parameter - fixed parameter)
+		//write the result
+		result->available = true;
+		result->valid = true;
+		result->status = gslErrorToString(status);
+		result->iterations = iter;
+		result->dof = n - (np - nf);	// samples - (parameter - fixed parameter)
 
-	//gsl_blas_dnrm2() - computes the Euclidian norm (||r||_2 = \sqrt {\sum r_i^2}) of the vector with the elements weight[i]*(Yi - y[i])
-	//gsl_blas_dasum() - computes the absolute sum \sum |r_i| of the elements of the vector with the elements weight[i]*(Yi - y[i])
-	fitResult.sse = gsl_pow_2(gsl_blas_dnrm2(s->f));
+		//gsl_blas_dnrm2() - computes the Euclidian norm (||r||_2 = \sqrt {\sum r_i^2}) of the vector with the elements weight[i]*(Yi - y[i])
+		//gsl_blas_dasum() - computes the absolute sum \sum |r_i| of the elements of the vector with the elements weight[i]*(Yi - y[i])
+		result->sse = gsl_pow_2(gsl_blas_dnrm2(s->f));
 
-	if (fitResult.dof != 0) {
-		fitResult.rms = fitResult.sse/fitResult.dof;
-		fitResult.rsd = sqrt(fitResult.rms);
-	}
-	fitResult.mse = fitResult.sse/n;
-	fitResult.rmse = sqrt(fitResult.mse);
-	fitResult.mae = gsl_blas_dasum(s->f)/n;
-	// SST needed for coefficient of determination, R-squared and F test
-	fitResult.sst = gsl_stats_tss(ydata, 1, n);
-	// for a linear model without intercept R-squared is calculated differently
-	// see https://cran.r-project.org/doc/FAQ/R-FAQ.html#Why-does-summary_0028_0029-report-strange-results-for-the-R_005e2-estimate-when-I-fit-a-linear-model-with-no-intercept_003f
-	if (fitData.modelCategory == nsl_fit_model_basic && fitData.modelType == nsl_fit_model_polynomial && fitData.degree == 1 && x_init[0] == 0) {
-		DEBUG("	Using alternative R^2 for linear model without intercept");
-		fitResult.sst = gsl_stats_tss_m(ydata, 1, n, 0);
-	}
-	if (fitResult.sst < fitResult.sse) {
-		DEBUG("	Using alternative R^2 since R^2 would be negative (probably custom model without intercept)");
-		fitResult.sst = gsl_stats_tss_m(ydata, 1, n, 0);
-	}
+		if (result->dof != 0) {
+			result->rms = result->sse/result->dof;
+			result->rsd = sqrt(result->rms);
+		}
+		result->mse = result->sse/n;
+		result->rmse = sqrt(result->mse);
+		result->mae = gsl_blas_dasum(s->f)/n;
+		// SST needed for coefficient of determination, R-squared and F test
+		result->sst = gsl_stats_tss(ydata, 1, n);
+		// for a linear model without intercept R-squared is calculated differently
+		// see https://cran.r-project.org/doc/FAQ/R-FAQ.html#Why-does-summary_0028_0029-report-strange-results-for-the-R_005e2-estimate-when-I-fit-a-linear-model-with-no-intercept_003f
+		if (settings->modelCategory == nsl_fit_model_basic && settings->modelType == nsl_fit_model_polynomial && settings->degree == 1 && x_init[0] == 0) {
+			DEBUG("	Using alternative R^2 for linear model without intercept");
+			result->sst = gsl_stats_tss_m(ydata, 1, n, 0);
+		}
+		if (result->sst < result->sse) {
+			DEBUG("	Using alternative R^2 since R^2 would be negative (probably custom model without intercept)");
+			result->sst = gsl_stats_tss_m(ydata, 1, n, 0);
+		}
 
-	fitResult.rsquare = nsl_stats_rsquare(fitResult.sse, fitResult.sst);
-	fitResult.rsquareAdj = nsl_stats_rsquareAdj(fitResult.rsquare, np, fitResult.dof, 1);
-	fitResult.chisq_p = nsl_stats_chisq_p(fitResult.sse, fitResult.dof);
-	fitResult.fdist_F = nsl_stats_fdist_F(fitResult.rsquare, np, fitResult.dof);
-	fitResult.fdist_p = nsl_stats_fdist_p(fitResult.fdist_F, np, fitResult.dof);
-	fitResult.logLik = nsl_stats_logLik(fitResult.sse, n);
-	fitResult.aic = nsl_stats_aic(fitResult.sse, n, np, 1);
-	fitResult.bic = nsl_stats_bic(fitResult.sse, n, np, 1);
-
-	//parameter values
-	fitResult.paramValues.resize(np);
-	fitResult.errorValues.resize(np);
-	fitResult.tdist_tValues.resize(np);
-	fitResult.tdist_pValues.resize(np);
-	fitResult.tdist_marginValues.resize(np);
-	// GSL: cerr = GSL_MAX_DBL(1., sqrt(fitResult.rms)); // increase error for poor fit
-	// NIST: cerr = sqrt(fitResult.rms); // increase error for poor fit, decrease for good fit
-	const double cerr = sqrt(fitResult.rms);
-	// CI = 100* (1 - alpha)
-	const double alpha = 1.0 - fitData.confidenceInterval/100.;
-	for (unsigned int i = 0; i < np; i++) {
-		// scale resulting values if they are bounded
-		fitResult.paramValues[i] = nsl_fit_map_bound(gsl_vector_get(s->x, i), x_min[i], x_max[i]);
-		// use results as start values if desired
-		if (fitData.useResults) {
-			fitData.paramStartValues.data()[i] = fitResult.paramValues[i];
-			DEBUG("	saving parameter " << i << ": " << fitResult.paramValues[i] << ' ' << fitData.paramStartValues.data()[i]);
+		result->rsquare = nsl_stats_rsquare(result->sse, result->sst);
+		result->rsquareAdj = nsl_stats_rsquareAdj(result->rsquare, np, result->dof, 1);
+		result->chisq_p = nsl_stats_chisq_p(result->sse, result->dof);
+		result->fdist_F = nsl_stats_fdist_F(result->rsquare, np, result->dof);
+		result->fdist_p = nsl_stats_fdist_p(result->fdist_F, np, result->dof);
+		result->logLik = nsl_stats_logLik(result->sse, n);
+		result->aic = nsl_stats_aic(result->sse, n, np, 1);
+		result->bic = nsl_stats_bic(result->sse, n, np, 1);
+
+		//parameter values
+		result->paramValues.resize(np);
+		result->errorValues.resize(np);
+		result->tdist_tValues.resize(np);
+		result->tdist_pValues.resize(np);
+		result->tdist_marginValues.resize(np);
+		// GSL: cerr = GSL_MAX_DBL(1., sqrt(result->rms)); // increase error for poor fit
+		// NIST: cerr = sqrt(result->rms); // increase error for poor fit, decrease for good fit
+		const double cerr = sqrt(result->rms);
+		// CI = 100* (1 - alpha)
+		const double alpha = 1.0 - settings->confidenceInterval/100.;
+		for (unsigned int i = 0; i < np; i++) {
+			// scale resulting values if they are bounded
+			result->paramValues[i] = nsl_fit_map_bound(gsl_vector_get(s->x, i), x_min[i], x_max[i]);
+			result->errorValues[i] = cerr * sqrt(gsl_matrix_get(covar, i, i));
+			result->tdist_tValues[i] = nsl_stats_tdist_t(result->paramValues.at(i), result->errorValues.at(i));
+			result->tdist_pValues[i] = nsl_stats_tdist_p(result->tdist_tValues.at(i), result->dof);
+			result->tdist_marginValues[i] = nsl_stats_tdist_margin(alpha, result->dof, result->errorValues.at(i));
+			for (unsigned int j = 0; j <= i; j++)
+				result->correlationMatrix << gsl_matrix_get(covar, i, j)/sqrt(gsl_matrix_get(covar, i, i))/sqrt(gsl_matrix_get(covar, j, j));
 		}
-		fitResult.errorValues[i] = cerr * sqrt(gsl_matrix_get(covar, i, i));
-		fitResult.tdist_tValues[i] = nsl_stats_tdist_t(fitResult.paramValues.at(i), fitResult.errorValues.at(i));
-		fitResult.tdist_pValues[i] = nsl_stats_tdist_p(fitResult.tdist_tValues.at(i), fitResult.dof);
-		fitResult.tdist_marginValues[i] = nsl_stats_tdist_margin(alpha, fitResult.dof, fitResult.errorValues.at(i));
-		for (unsigned int j = 0; j <= i; j++)
-			fitResult.correlationMatrix << gsl_matrix_get(covar, i, j)/sqrt(gsl_matrix_get(covar, i, i))/sqrt(gsl_matrix_get(covar, j, j));
-	}
 
-	// fill residuals vector. To get residuals on the correct x values, fill the rest with zeros.
-	residualsVector->resize(tmpXDataColumn->rowCount());
-	DEBUG("	Residual vector size: " << residualsVector->size())
-	if (fitData.autoRange) {	// evaluate full range of residuals
-		xVector->resize(tmpXDataColumn->rowCount());
-		auto mode = tmpXDataColumn->columnMode();
-		for (int i = 0; i < tmpXDataColumn->rowCount(); i++)
-			if (mode == AbstractColumn::ColumnMode::Double)
-				(*xVector)[i] = tmpXDataColumn->valueAt(i);
-			else if (mode == AbstractColumn::ColumnMode::Integer)
-				(*xVector)[i] = tmpXDataColumn->integerAt(i);
-			else if (mode == AbstractColumn::ColumnMode::BigInt)
-				(*xVector)[i] = tmpXDataColumn->bigIntAt(i);
-			else if (mode == AbstractColumn::ColumnMode::DateTime)
-				(*xVector)[i] = tmpXDataColumn->dateTimeAt(i).toMSecsSinceEpoch();
-
-		ExpressionParser* parser = ExpressionParser::getInstance();
-		bool rc = parser->evaluateCartesian(fitData.model, xVector, residualsVector,
-							fitData.paramNames, fitResult.paramValues);
-		if (rc) {
-			for (int i = 0; i < tmpXDataColumn->rowCount(); i++)
-				(*residualsVector)[i] = tmpYDataColumn->valueAt(i) - (*residualsVector)[i];
-		} else {
-			DEBUG("	ERROR: Failed parsing residuals")
-			residualsVector->clear();
+		// fill residuals vector. To get residuals on the correct x values, fill the rest with zeros.
+		const int rowCount = xResidualsVector->size();
+		residuals->resize(rowCount);
+		DEBUG("	Residual vector size: " << residuals->size())
+		if (settings->autoRange) {	// evaluate full range of residuals
+			bool rc = parser->evaluateCartesian(settings->model, xResidualsVector.get(), residuals.get(), settings->paramNames, result->paramValues);
+			if (rc) {
+				for (int i = 0; i < rowCount; i++)
+					(*residuals)[i] = yResidualsVector->at(i) - (*residuals)[i];
+			} else {
+				DEBUG("	ERROR: Failed parsing residuals")
+				residuals->clear();
+			}
+		} else {	// only selected range
+			size_t j = 0;
+			for (int i = 0; i < rowCount; i++) {
+				if (xResidualsVector->at(i) >= xRange.start() && xResidualsVector->at(i) <= xRange.end())
+					residuals->data()[i] = - gsl_vector_get(s->f, j++);
+				else	// outside range
+					residuals->data()[i] = 0;
+			}
 		}
-	} else {	// only selected range
-		size_t j = 0;
-		for (int i = 0; i < tmpXDataColumn->rowCount(); i++) {
-			if (tmpXDataColumn->valueAt(i) >= xRange.start() && tmpXDataColumn->valueAt(i) <= xRange.end())
-				residualsVector->data()[i] = - gsl_vector_get(s->f, j++);
-			else	// outside range
-				residualsVector->data()[i] = 0;
+
+		//free resources
+		gsl_multifit_fdfsolver_free(s);
+		gsl_matrix_free(covar);
+
+		result->elapsedTime = timer.elapsed();
+	};
+///////////////////////////////////////////////////////////
+
+	auto finish = [=]() {
+		//write the result
+		fitResult = *result;
+		*residualsVector = *residuals;
+		residualsColumn->setChanged();
+
+		// use results as start values if desired
+		if (fitData.useResults) {
+			for (unsigned int i = 0; i < np; i++) {
+				fitData.paramStartValues.data()[i] = fitResult.paramValues.at(i);
+				DEBUG("	saving parameter " << i << ": " << fitResult.paramValues[i] << ' ' << fitData.paramStartValues.data()[i]);
+			}
 		}
-	}
-	residualsColumn->setChanged();
 
-	//free resources
-	gsl_multifit_fdfsolver_free(s);
-	gsl_matrix_free(covar);
+		//calculate the fit function (vectors)
+		evaluate();
 
-	//calculate the fit function (vectors)
-	evaluate();
-	fitResult.elapsedTime = timer.elapsed();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	sourceDataChangedSinceLastRecalc = false;
+	runJob((int)n, calculate, finish);
 }
 
 /* evaluate fit function (preview == true: use start values, default: false) */
@@ -2161,20 +2203,21 @@ void XYFitCurvePrivate::evaluate(bool preview) {
 		yVector->clear();
 		residualsVector->clear();
 	}
+	invalidateResultColumns();
 
 	recalcLogicalPoints();
 	Q_EMIT q->dataChanged();
 }
 
 /*!
- * writes out the current state of the solver \c s
+ * writes out the current state of the solver \c s to the solver output of \c fitResult
  */
-void XYFitCurvePrivate::writeSolverState(gsl_multifit_fdfsolver* s, double chi) {
+void XYFitCurvePrivate::writeSolverState(gsl_multifit_fdfsolver* s, const XYFitCurve::FitData& fitData, XYFitCurve::FitResult& fitResult, double chi) {
 	QString state;
 
 	//current parameter values, semicolon separated
-	double* min = fitData.paramLowerLimits.data();
-	double* max = fitData.paramUpperLimits.data();
+	const double* min = fitData.paramLowerLimits.constData();
+	const double* max = fitData.paramUpperLimits.constData();
 	for (int i = 0; i < fitData.paramNames.size(); ++i) {
 		const double x = gsl_vector_get(s->x, i);
 		// map parameter if bounded
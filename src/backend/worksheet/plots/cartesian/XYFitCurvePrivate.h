@@ -48,7 +48,7 @@ public:
 
 private:
 	void prepareResultColumns();
-	void writeSolverState(gsl_multifit_fdfsolver*, double chi = qQNaN());
+	static void writeSolverState(gsl_multifit_fdfsolver*, const XYFitCurve::FitData&, XYFitCurve::FitResult&, double chi = qQNaN());
 };
 
 #endif
@@ -93,10 +93,7 @@ XYFourierFilterCurvePrivate::XYFourierFilterCurvePrivate(XYFourierFilterCurve* o
 XYFourierFilterCurvePrivate::~XYFourierFilterCurvePrivate() = default;
 
 void XYFourierFilterCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
-
-	//create filter result columns if not available yet, clear them otherwise
+	//create filter result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -112,13 +109,16 @@ void XYFourierFilterCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	filterResult = XYFourierFilterCurve::FilterResult();
+	//the results are written at once when the filter is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		filterResult = XYFourierFilterCurve::FilterResult();
+	};
 
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
@@ -134,6 +134,7 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		clearResult();
 		recalcLogicalPoints();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -141,8 +142,8 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the differentiation to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
 
 	double xmin;
 	double xmax;
@@ -164,15 +165,16 @@ void XYFourierFilterCurvePrivate::recalculate() {
 
 		// only when inside given range
 		if (tmpXDataColumn->valueAt(row) >= xmin && tmpXDataColumn->valueAt(row) <= xmax) {
-			xdataVector.append(tmpXDataColumn->valueAt(row));
-			ydataVector.append(tmpYDataColumn->valueAt(row));
+			xdataVector->append(tmpXDataColumn->valueAt(row));
+			ydataVector->append(tmpYDataColumn->valueAt(row));
 		}
 
 	}
 
 	//number of data points to filter
-	const size_t n = (size_t)xdataVector.size();
+	const size_t n = (size_t)xdataVector->size();
 	if (n == 0) {
+		clearResult();
 		filterResult.available = true;
 		filterResult.valid = false;
 		filterResult.status = i18n("No data points available.");
@@ -182,9 +184,6 @@ void XYFourierFilterCurvePrivate::recalculate() {
 		return;
 	}
 
-	//double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 
 	// filter settings
 	const nsl_filter_type type = filterData.type;
@@ -199,7 +198,6 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	DEBUG("cutoffs ="<<cutoff<<cutoff2);
 	DEBUG("unit :"<<nsl_filter_cutoff_unit_name[unit]<<nsl_filter_cutoff_unit_name[unit2]);
 
-///////////////////////////////////////////////////////////
 	// calculate index
 	double cutindex = 0, cutindex2 = 0;
 	switch (unit) {
@@ -224,34 +222,52 @@ void XYFourierFilterCurvePrivate::recalculate() {
 	}
 	const double bandwidth = (cutindex2 - cutindex);
 	if ((type == nsl_filter_type_band_pass || type == nsl_filter_type_band_reject) && bandwidth <= 0) {
+		clearResult();
 		qWarning()<<"band width must be > 0. Giving up.";
 		return;
 	}
 
-	DEBUG("cut off @" << cutindex << cutindex2);
-	DEBUG("bandwidth =" << bandwidth);
+	auto xResultVector = std::make_shared<QVector<double>>();
+	auto yResultVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYFourierFilterCurve::FilterResult>();
 
-	// run filter
-	int status = nsl_filter_fourier(ydata, n, type, form, order, cutindex, bandwidth);
-
-	xVector->resize((int)n);
-	yVector->resize((int)n);
-	memcpy(xVector->data(), xdataVector.data(), n*sizeof(double));
-	memcpy(yVector->data(), ydata, n*sizeof(double));
+///////////////////////////////////////////////////////////
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
+
+		DEBUG("cut off @" << cutindex << cutindex2);
+		DEBUG("bandwidth =" << bandwidth);
+
+		// run filter
+		*xResultVector = *xdataVector;
+		*yResultVector = *ydataVector;
+		int status = nsl_filter_fourier(yResultVector->data(), n, type, form, order, cutindex, bandwidth);
+
+		result->available = true;
+		result->valid = true;
+		result->status = gslErrorToString(status);
+		result->elapsedTime = timer.elapsed();
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	filterResult.available = true;
-	filterResult.valid = true;
-	filterResult.status = gslErrorToString(status);
-	filterResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xResultVector;
+		*yVector = *yResultVector;
+		invalidateResultColumns();
+		filterResult = *result;
 
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
+
+	runJob((int)n, calculate, finish);
 }
 
+
 //##############################################################################
 //##################  Serialization/Deserialization  ###########################
 //##############################################################################
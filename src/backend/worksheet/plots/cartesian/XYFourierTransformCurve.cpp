@@ -89,10 +89,7 @@ XYFourierTransformCurvePrivate::XYFourierTransformCurvePrivate(XYFourierTransfor
 XYFourierTransformCurvePrivate::~XYFourierTransformCurvePrivate() = default;
 
 void XYFourierTransformCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
-
-	//create transform result columns if not available yet, clear them otherwise
+	//create transform result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -108,15 +105,19 @@ void XYFourierTransformCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	transformResult = XYFourierTransformCurve::TransformResult();
+	//the results are written at once when the transform is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		transformResult = XYFourierTransformCurve::TransformResult();
+	};
 
 	if (!xDataColumn || !yDataColumn) {
+		clearResult();
 		recalcLogicalPoints();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -124,8 +125,8 @@ void XYFourierTransformCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the transform to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
 	const double xmin = transformData.xRange.first();
 	const double xmax = transformData.xRange.last();
 
@@ -138,14 +139,15 @@ void XYFourierTransformCurvePrivate::recalculate() {
 
 		// only when inside given range
 		if (xDataColumn->valueAt(row) >= xmin && xDataColumn->valueAt(row) <= xmax) {
-			xdataVector.append(xDataColumn->valueAt(row));
-			ydataVector.append(yDataColumn->valueAt(row));
+			xdataVector->append(xDataColumn->valueAt(row));
+			ydataVector->append(yDataColumn->valueAt(row));
 		}
 	}
 
 	//number of data points to transform
-	unsigned int n = (unsigned int)ydataVector.size();
+	unsigned int n = (unsigned int)ydataVector->size();
 	if (n == 0) {
+		clearResult();
 		transformResult.available = true;
 		transformResult.valid = false;
 		transformResult.status = i18n("No data points available.");
@@ -155,9 +157,6 @@ void XYFourierTransformCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// transform settings
 	const nsl_sf_window_type windowType = transformData.windowType;
 	const nsl_dft_result_type type = transformData.type;
@@ -171,75 +170,86 @@ void XYFourierTransformCurvePrivate::recalculate() {
 	DEBUG("scale:" << nsl_dft_xscale_name[xScale]);
 	DEBUG("two sided:" << twoSided);
 	DEBUG("shifted:" << shifted);
-#ifndef NDEBUG
-	QDebug out = qDebug();
-	for (unsigned int i = 0; i < n; i++)
-		out<<ydata[i];
-#endif
+
+	auto xResultVector = std::make_shared<QVector<double>>();
+	auto yResultVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYFourierTransformCurve::TransformResult>();
 
 ///////////////////////////////////////////////////////////
-	// transform with window
-	int status = nsl_dft_transform_window(ydata, 1, n, twoSided, type, windowType);
-
-	unsigned int N = n;
-	if (twoSided == false)
-		N = n/2;
-
-	switch (xScale) {
-	case nsl_dft_xscale_frequency:
-		for (unsigned int i = 0; i < N; i++) {
-			if (i >= n/2 && shifted)
-				xdata[i] = (n-1)/(xmax-xmin)*(i/(double)n-1.);
-			else
-				xdata[i] = (n-1)*i/(xmax-xmin)/n;
-		}
-		break;
-	case nsl_dft_xscale_index:
-		for (unsigned int i = 0; i < N; i++) {
-			if (i >= n/2 && shifted)
-				xdata[i] = (int)i-(int) N;
-			else
-				xdata[i] = i;
-		}
-		break;
-	case nsl_dft_xscale_period: {
-			double f0 = (n-1)/(xmax-xmin)/n;
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
+
+		double* xdata = xdataVector->data();
+		double* ydata = ydataVector->data();
+
+		// transform with window
+		int status = nsl_dft_transform_window(ydata, 1, n, twoSided, type, windowType);
+
+		unsigned int N = n;
+		if (twoSided == false)
+			N = n/2;
+
+		switch (xScale) {
+		case nsl_dft_xscale_frequency:
 			for (unsigned int i = 0; i < N; i++) {
-				double f = (n-1)*i/(xmax-xmin)/n;
-				xdata[i] = 1/(f+f0);
+				if (i >= n/2 && shifted)
+					xdata[i] = (n-1)/(xmax-xmin)*(i/(double)n-1.);
+				else
+					xdata[i] = (n-1)*i/(xmax-xmin)/n;
 			}
 			break;
+		case nsl_dft_xscale_index:
+			for (unsigned int i = 0; i < N; i++) {
+				if (i >= n/2 && shifted)
+					xdata[i] = (int)i-(int) N;
+				else
+					xdata[i] = i;
+			}
+			break;
+		case nsl_dft_xscale_period: {
+				double f0 = (n-1)/(xmax-xmin)/n;
+				for (unsigned int i = 0; i < N; i++) {
+					double f = (n-1)*i/(xmax-xmin)/n;
+					xdata[i] = 1/(f+f0);
+				}
+				break;
+			}
 		}
-	}
-#ifndef NDEBUG
-	out = qDebug();
-	for (unsigned int i = 0; i < N; i++)
-		out << ydata[i] << '(' << xdata[i] << ')';
-#endif
-
-	xVector->resize((int)N);
-	yVector->resize((int)N);
-	if (shifted) {
-		memcpy(xVector->data(), &xdata[n/2], n/2*sizeof(double));
-		memcpy(&xVector->data()[n/2], xdata, n/2*sizeof(double));
-		memcpy(yVector->data(), &ydata[n/2], n/2*sizeof(double));
-		memcpy(&yVector->data()[n/2], ydata, n/2*sizeof(double));
-	} else {
-		memcpy(xVector->data(), xdata, N*sizeof(double));
-		memcpy(yVector->data(), ydata, N*sizeof(double));
-	}
+
+		xResultVector->resize((int)N);
+		yResultVector->resize((int)N);
+		if (shifted) {
+			memcpy(xResultVector->data(), &xdata[n/2], n/2*sizeof(double));
+			memcpy(&xResultVector->data()[n/2], xdata, n/2*sizeof(double));
+			memcpy(yResultVector->data(), &ydata[n/2], n/2*sizeof(double));
+			memcpy(&yResultVector->data()[n/2], ydata, n/2*sizeof(double));
+		} else {
+			memcpy(xResultVector->data(), xdata, N*sizeof(double));
+			memcpy(yResultVector->data(), ydata, N*sizeof(double));
+		}
+
+		result->available = true;
+		result->valid = true;
+		result->status = gslErrorToString(status);
+		result->elapsedTime = timer.elapsed();
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	transformResult.available = true;
-	transformResult.valid = true;
-	transformResult.status = gslErrorToString(status);
-	transformResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xResultVector;
+		*yVector = *yResultVector;
+		invalidateResultColumns();
+		transformResult = *result;
+
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runJob((int)n, calculate, finish);
 }
 
 //##############################################################################
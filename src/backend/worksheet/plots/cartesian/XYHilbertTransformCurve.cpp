@@ -89,10 +89,8 @@ XYHilbertTransformCurvePrivate::~XYHilbertTransformCurvePrivate() = default;
 
 void XYHilbertTransformCurvePrivate::recalculate() {
 	DEBUG(Q_FUNC_INFO)
-	QElapsedTimer timer;
-	timer.start();
 
-	//create transform result columns if not available yet, clear them otherwise
+	//create transform result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -108,15 +106,19 @@ void XYHilbertTransformCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	transformResult = XYHilbertTransformCurve::TransformResult();
+	//the results are written at once when the transform is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		transformResult = XYHilbertTransformCurve::TransformResult();
+	};
 
 	if (!xDataColumn || !yDataColumn) {
+		clearResult();
 		recalcLogicalPoints();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -125,8 +127,8 @@ void XYHilbertTransformCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the transform to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
 	double xmin, xmax;
 	if (xDataColumn && transformData.autoRange) {
 		xmin = xDataColumn->minimum();
@@ -147,14 +149,15 @@ void XYHilbertTransformCurvePrivate::recalculate() {
 
 		// only when inside given range
 		if (xDataColumn->valueAt(row) >= xmin && xDataColumn->valueAt(row) <= xmax) {
-			xdataVector.append(xDataColumn->valueAt(row));
-			ydataVector.append(yDataColumn->valueAt(row));
+			xdataVector->append(xDataColumn->valueAt(row));
+			ydataVector->append(yDataColumn->valueAt(row));
 		}
 	}
 
 	//number of data points to transform
-	unsigned int n = (unsigned int)ydataVector.size();
+	unsigned int n = (unsigned int)ydataVector->size();
 	if (n == 0) {
+		clearResult();
 		transformResult.available = true;
 		transformResult.valid = false;
 		transformResult.status = i18n("No data points available.");
@@ -165,48 +168,44 @@ void XYHilbertTransformCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// transform settings
 	const nsl_hilbert_result_type type = transformData.type;
 
 	DEBUG("n = " << n);
 	DEBUG("type:" << nsl_hilbert_result_type_name[type]);
-#ifndef NDEBUG
-//	QDebug out = qDebug();
-//	for (unsigned int i = 0; i < n; i++)
-//		out<<ydata[i];
-#endif
+
+	auto result = std::make_shared<XYHilbertTransformCurve::TransformResult>();
 
 ///////////////////////////////////////////////////////////
-	// transform with window
-//	TODO: type 
-	int status = nsl_hilbert_transform(ydata, 1, n, type);
-
-	unsigned int N = n;
-#ifndef NDEBUG
-//	out = qDebug();
-//	for (unsigned int i = 0; i < N; i++)
-//		out << ydata[i] << '(' << xdata[i] << ')';
-#endif
-
-	xVector->resize((int)N);
-	yVector->resize((int)N);
-	memcpy(xVector->data(), xdata, N*sizeof(double));
-	memcpy(yVector->data(), ydata, N*sizeof(double));
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
+
+		// transform with window
+//		TODO: type
+		int status = nsl_hilbert_transform(ydataVector->data(), 1, n, type);
+
+		result->available = true;
+		result->valid = true;
+		result->status = gslErrorToString(status);
+		result->elapsedTime = timer.elapsed();
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	transformResult.available = true;
-	transformResult.valid = true;
-	transformResult.status = gslErrorToString(status);
-	transformResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		//write the result, the transform doesn't change the x values
+		*xVector = *xdataVector;
+		*yVector = *ydataVector;
+		invalidateResultColumns();
+		transformResult = *result;
+
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runJob((int)n, calculate, finish);
 }
 
 //##############################################################################
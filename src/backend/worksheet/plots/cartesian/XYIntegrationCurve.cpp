@@ -87,10 +87,7 @@ XYIntegrationCurvePrivate::XYIntegrationCurvePrivate(XYIntegrationCurve* owner)
 XYIntegrationCurvePrivate::~XYIntegrationCurvePrivate() = default;
 
 void XYIntegrationCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
-
-	//create integration result columns if not available yet, clear them otherwise
+	//create integration result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -106,13 +103,16 @@ void XYIntegrationCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	integrationResult = XYIntegrationCurve::IntegrationResult();
+	//the results are written at once when the integration is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		integrationResult = XYIntegrationCurve::IntegrationResult();
+	};
 
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
@@ -128,6 +128,7 @@ void XYIntegrationCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		clearResult();
 		recalcLogicalPoints();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -135,8 +136,8 @@ void XYIntegrationCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the integration to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
 
 	double xmin;
 	double xmax;
@@ -148,10 +149,11 @@ void XYIntegrationCurvePrivate::recalculate() {
 		xmax = integrationData.xRange.last();
 	}
 
-	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
+	XYAnalysisCurve::copyData(*xdataVector, *ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
 
-	const size_t n = (size_t)xdataVector.size();	// number of data points to integrate
+	const size_t n = (size_t)xdataVector->size();	// number of data points to integrate
 	if (n < 2) {
+		clearResult();
 		integrationResult.available = true;
 		integrationResult.valid = false;
 		integrationResult.status = i18n("Not enough data points available.");
@@ -161,9 +163,6 @@ void XYIntegrationCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
 	// integration settings
 	const nsl_int_method_type method = integrationData.method;
 	const bool absolute = integrationData.absolute;
@@ -171,44 +170,66 @@ void XYIntegrationCurvePrivate::recalculate() {
 	DEBUG("method:"<<nsl_int_method_name[method]);
 	DEBUG("absolute area:"<<absolute);
 
+	auto xResultVector = std::make_shared<QVector<double>>();
+	auto yResultVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYIntegrationCurve::IntegrationResult>();
+
 ///////////////////////////////////////////////////////////
-	int status = 0;
-	size_t np = n;
-
-	switch (method) {
-	case nsl_int_method_rectangle:
-		status = nsl_int_rectangle(xdata, ydata, n, absolute);
-		break;
-	case nsl_int_method_trapezoid:
-		status = nsl_int_trapezoid(xdata, ydata, n, absolute);
-		break;
-	case nsl_int_method_simpson:
-		np = nsl_int_simpson(xdata, ydata, n, absolute);
-		break;
-	case nsl_int_method_simpson_3_8:
-		np = nsl_int_simpson_3_8(xdata, ydata, n, absolute);
-		break;
-	}
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
+
+		*xResultVector = *xdataVector;
+		*yResultVector = *ydataVector;
+		double* xdata = xResultVector->data();
+		double* ydata = yResultVector->data();
+
+		int status = 0;
+		size_t np = n;
+
+		switch (method) {
+		case nsl_int_method_rectangle:
+			status = nsl_int_rectangle(xdata, ydata, n, absolute);
+			break;
+		case nsl_int_method_trapezoid:
+			status = nsl_int_trapezoid(xdata, ydata, n, absolute);
+			break;
+		case nsl_int_method_simpson:
+			np = nsl_int_simpson(xdata, ydata, n, absolute);
+			break;
+		case nsl_int_method_simpson_3_8:
+			np = nsl_int_simpson_3_8(xdata, ydata, n, absolute);
+			break;
+		}
+
+		xResultVector->resize((int)np);
+		yResultVector->resize((int)np);
 
-	xVector->resize((int)np);
-	yVector->resize((int)np);
-	memcpy(xVector->data(), xdata, np * sizeof(double));
-	memcpy(yVector->data(), ydata, np * sizeof(double));
+		result->available = true;
+		result->valid = true;
+		result->status = QString::number(status);
+		result->elapsedTime = timer.elapsed();
+		result->value = yResultVector->at((int)np - 1);
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	integrationResult.available = true;
-	integrationResult.valid = true;
-	integrationResult.status = QString::number(status);
-	integrationResult.elapsedTime = timer.elapsed();
-	integrationResult.value = ydata[np-1];
-
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xResultVector;
+		*yVector = *yResultVector;
+		invalidateResultColumns();
+		integrationResult = *result;
+
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
+
+	runJob((int)n, calculate, finish);
 }
 
+
 //##############################################################################
 //##################  Serialization/Deserialization  ###########################
 //##############################################################################
@@ -90,10 +90,7 @@ XYInterpolationCurvePrivate::XYInterpolationCurvePrivate(XYInterpolationCurve* o
 XYInterpolationCurvePrivate::~XYInterpolationCurvePrivate() = default;
 
 void XYInterpolationCurvePrivate::recalculate() {
-	QElapsedTimer timer;
-	timer.start();
-
-	//create interpolation result columns if not available yet, clear them otherwise
+	//create interpolation result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -109,13 +106,16 @@ void XYInterpolationCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
 	}
 
-	// clear the previous result
-	interpolationResult = XYInterpolationCurve::InterpolationResult();
+	//the results are written at once when the interpolation is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		invalidateResultColumns();
+		interpolationResult = XYInterpolationCurve::InterpolationResult();
+	};
 
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
@@ -129,6 +129,7 @@ void XYInterpolationCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		clearResult();
 		recalcLogicalPoints();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
@@ -137,6 +138,7 @@ void XYInterpolationCurvePrivate::recalculate() {
 
 	//check column sizes
 	if (tmpXDataColumn->rowCount() != tmpYDataColumn->rowCount()) {
+		clearResult();
 		interpolationResult.available = true;
 		interpolationResult.valid = false;
 		interpolationResult.status = i18n("Number of x and y data points must be equal.");
@@ -147,8 +149,8 @@ void XYInterpolationCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the interpolation to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
 
 	double xmin, xmax;
 	if (interpolationData.autoRange) {	// all points
@@ -159,11 +161,11 @@ void XYInterpolationCurvePrivate::recalculate() {
 		xmax = interpolationData.xRange.last();
 	}
 
-	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
+	XYAnalysisCurve::copyData(*xdataVector, *ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
 
 	// only use range of valid data points
-	const double validXMin = *std::min_element(xdataVector.constBegin(), xdataVector.constEnd());
-	const double validXMax = *std::max_element(xdataVector.constBegin(), xdataVector.constEnd());
+	const double validXMin = *std::min_element(xdataVector->constBegin(), xdataVector->constEnd());
+	const double validXMax = *std::max_element(xdataVector->constBegin(), xdataVector->constEnd());
 	if (interpolationData.autoRange) {
 		xmin = validXMin;
 		xmax = validXMax;
@@ -174,8 +176,9 @@ void XYInterpolationCurvePrivate::recalculate() {
 	DEBUG(Q_FUNC_INFO << ", x range = " << xmin << " .. " << xmax)
 
 	//number of data points to interpolate
-	const size_t n = (size_t)xdataVector.size();
+	const size_t n = (size_t)xdataVector->size();
 	if (n < 2) {
+		clearResult();
 		interpolationResult.available = true;
 		interpolationResult.valid = false;
 		interpolationResult.status = i18n("Not enough data points available.");
@@ -185,12 +188,11 @@ void XYInterpolationCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
+	const double* xvalues = xdataVector->constData();
 	for(unsigned int i = 1; i < n; i++) {
-		if (xdata[i-1] >= xdata[i]) {
-			DEBUG("ERROR: x data not strictly increasing: x_{i-1} >= x_i @ i = " << i << ": " << xdata[i-1] << " >= " << xdata[i])
+		if (xvalues[i-1] >= xvalues[i]) {
+			DEBUG("ERROR: x data not strictly increasing: x_{i-1} >= x_i @ i = " << i << ": " << xvalues[i-1] << " >= " << xvalues[i])
+			clearResult();
 			interpolationResult.status = i18n("interpolation failed since x data is not strictly monotonic increasing!");
 			interpolationResult.available = true;
 			return;
@@ -212,216 +214,246 @@ void XYInterpolationCurvePrivate::recalculate() {
 	DEBUG(Q_FUNC_INFO << ", npoints = " << npoints);
 	DEBUG(Q_FUNC_INFO << ", data points = " << n);
 
+	auto xResultVector = std::make_shared<QVector<double>>();
+	auto yResultVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYInterpolationCurve::InterpolationResult>();
+
 ///////////////////////////////////////////////////////////
-	int status = 0;
-
-	gsl_interp_accel *acc = gsl_interp_accel_alloc();
-	gsl_spline *spline = nullptr;
-	switch (type) {
-	case nsl_interp_type_linear:
-		spline = gsl_spline_alloc(gsl_interp_linear, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_polynomial:
-		spline = gsl_spline_alloc(gsl_interp_polynomial, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_cspline:
-		spline = gsl_spline_alloc(gsl_interp_cspline, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_cspline_periodic:
-		spline = gsl_spline_alloc(gsl_interp_cspline_periodic, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_akima:
-		spline = gsl_spline_alloc(gsl_interp_akima, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_akima_periodic:
-		spline = gsl_spline_alloc(gsl_interp_akima_periodic, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-		break;
-	case nsl_interp_type_steffen:
-#if GSL_MAJOR_VERSION >= 2
-		spline = gsl_spline_alloc(gsl_interp_steffen, n);
-		status = gsl_spline_init(spline, xdata, ydata, n);
-#endif
-		break;
-	case nsl_interp_type_cosine:
-	case nsl_interp_type_pch:
-	case nsl_interp_type_rational:
-	case nsl_interp_type_exponential:
-		break;
-	}
+	auto calculate = [=](const std::atomic<bool>& cancelled) {
+		QElapsedTimer timer;
+		timer.start();
 
-	xVector->resize((int)npoints);
-	yVector->resize((int)npoints);
-	for (unsigned int i = 0; i < npoints; i++) {
-		size_t a = 0, b = n - 1;
-
-		double x = xmin + i * (xmax - xmin) / (npoints - 1);
-		(*xVector)[(int)i] = x;
-
-		// find index a,b for interval [x[a],x[b]] around x[i] using bisection
-		if (type == nsl_interp_type_cosine || type == nsl_interp_type_exponential || type == nsl_interp_type_pch) {
-			while (b-a > 1) {
-				unsigned int j = floor((a+b)/2.);
-				if (xdata[j] > x)
-					b = j;
-				else
-					a = j;
-			}
-		}
+		double* xdata = xdataVector->data();
+		double* ydata = ydataVector->data();
 
-		// evaluate interpolation
-		double t;
+		int status = 0;
+
+		gsl_interp_accel *acc = gsl_interp_accel_alloc();
+		gsl_spline *spline = nullptr;
 		switch (type) {
 		case nsl_interp_type_linear:
+			spline = gsl_spline_alloc(gsl_interp_linear, n);
+			status = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_polynomial:
+			spline = gsl_spline_alloc(gsl_interp_polynomial, n);
+			status = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_cspline:
+			spline = gsl_spline_alloc(gsl_interp_cspline, n);
+			status = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_cspline_periodic:
+			spline = gsl_spline_alloc(gsl_interp_cspline_periodic, n);
+			status = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_akima:
+			spline = gsl_spline_alloc(gsl_interp_akima, n);
+			status = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_akima_periodic:
+			spline = gsl_spline_alloc(gsl_interp_akima_periodic, n);
+			status = gsl_spline_init(spline, xdata, ydata, n);
+			break;
 		case nsl_interp_type_steffen:
-			switch (evaluate) {
-			case nsl_interp_evaluate_function:
-				(*yVector)[(int)i] = gsl_spline_eval(spline, x, acc);
-				break;
-			case nsl_interp_evaluate_derivative:
-				(*yVector)[(int)i] = gsl_spline_eval_deriv(spline, x, acc);
-				break;
-			case nsl_interp_evaluate_second_derivative:
-				(*yVector)[(int)i] = gsl_spline_eval_deriv2(spline, x, acc);
-				break;
-			case nsl_interp_evaluate_integral:
-				(*yVector)[(int)i] = gsl_spline_eval_integ(spline, xmin, x, acc);
-				break;
-			}
+	#if GSL_MAJOR_VERSION >= 2
+			spline = gsl_spline_alloc(gsl_interp_steffen, n);
+			status = gsl_spline_init(spline, xdata, ydata, n);
+	#endif
 			break;
 		case nsl_interp_type_cosine:
-			t = (x-xdata[a])/(xdata[b]-xdata[a]);
-			t = (1.-cos(M_PI*t))/2.;
-			(*yVector)[(int)i] =  ydata[a] + t*(ydata[b]-ydata[a]);
-			break;
+		case nsl_interp_type_pch:
+		case nsl_interp_type_rational:
 		case nsl_interp_type_exponential:
-			t = (x-xdata[a])/(xdata[b]-xdata[a]);
-			(*yVector)[(int)i] = ydata[a]*pow(ydata[b]/ydata[a],t);
 			break;
-		case nsl_interp_type_pch: {
-				t = (x-xdata[a])/(xdata[b]-xdata[a]);
-				double t2 = t*t, t3 = t2*t;
-				double h1 = 2.*t3-3.*t2+1, h2 = -2.*t3+3.*t2, h3 = t3-2*t2+t, h4 = t3-t2;
-				double m1 = 0.,m2 = 0.;
-				switch (variant) {
-				case nsl_interp_pch_variant_finite_difference:
-					if (a == 0)
-						m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m1 = ( (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) + (ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1]) )/2.;
-					if (b == n-1)
-						m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m2 = ( (ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) + (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
+		}
 
-					break;
-				case nsl_interp_pch_variant_catmull_rom:
-					if (a == 0)
-						m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m1 = (ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
-					if (b == n-1)
-						m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m2 = (ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
+		xResultVector->resize((int)npoints);
+		yResultVector->resize((int)npoints);
+		for (unsigned int i = 0; i < npoints; i++) {
+			if (cancelled.load(std::memory_order_relaxed))
+				break;
 
-					break;
-				case nsl_interp_pch_variant_cardinal:
-					if (a == 0)
-						m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m1 = (ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
-					m1 *= (1.-tension);
-					if (b == n-1)
-						m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m2 = (ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
-					m2 *= (1.-tension);
+			size_t a = 0, b = n - 1;
 
-					break;
-				case nsl_interp_pch_variant_kochanek_bartels:
-					if (a == 0)
-						m1 = (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
-					else
-						m1 = ( (1.-continuity)*(1.+bias)*(ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1])
-						     + (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
-					m1 *= (1.-tension);
-					if (b == n-1)
-						m2 = (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+			double x = xmin + i * (xmax - xmin) / (npoints - 1);
+			(*xResultVector)[(int)i] = x;
+
+			// find index a,b for interval [x[a],x[b]] around x[i] using bisection
+			if (type == nsl_interp_type_cosine || type == nsl_interp_type_exponential || type == nsl_interp_type_pch) {
+				while (b-a > 1) {
+					unsigned int j = floor((a+b)/2.);
+					if (xdata[j] > x)
+						b = j;
 					else
-						m2 = ( (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a])
-						     + (1.-continuity)*(1.-bias)*(ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) )/2.;
-					m2 *= (1.-tension);
+						a = j;
+				}
+			}
 
+			// evaluate interpolation
+			double t;
+			switch (type) {
+			case nsl_interp_type_linear:
+			case nsl_interp_type_polynomial:
+			case nsl_interp_type_cspline:
+			case nsl_interp_type_cspline_periodic:
+			case nsl_interp_type_akima:
+			case nsl_interp_type_akima_periodic:
+			case nsl_interp_type_steffen:
+				switch (evaluate) {
+				case nsl_interp_evaluate_function:
+					(*yResultVector)[(int)i] = gsl_spline_eval(spline, x, acc);
+					break;
+				case nsl_interp_evaluate_derivative:
+					(*yResultVector)[(int)i] = gsl_spline_eval_deriv(spline, x, acc);
+					break;
+				case nsl_interp_evaluate_second_derivative:
+					(*yResultVector)[(int)i] = gsl_spline_eval_deriv2(spline, x, acc);
+					break;
+				case nsl_interp_evaluate_integral:
+					(*yResultVector)[(int)i] = gsl_spline_eval_integ(spline, xmin, x, acc);
 					break;
 				}
-
-				// Hermite polynomial
-				(*yVector)[(int)i] = ydata[a]*h1+ydata[b]*h2+(xdata[b]-xdata[a])*(m1*h3+m2*h4);
-			}
-			break;
-		case nsl_interp_type_rational: {
-				double v,dv;
-				nsl_interp_ratint(xdata, ydata, (int)n, x, &v, &dv);
-				(*yVector)[(int)i] = v;
-				//TODO: use error dv
 				break;
+			case nsl_interp_type_cosine:
+				t = (x-xdata[a])/(xdata[b]-xdata[a]);
+				t = (1.-cos(M_PI*t))/2.;
+				(*yResultVector)[(int)i] =  ydata[a] + t*(ydata[b]-ydata[a]);
+				break;
+			case nsl_interp_type_exponential:
+				t = (x-xdata[a])/(xdata[b]-xdata[a]);
+				(*yResultVector)[(int)i] = ydata[a]*pow(ydata[b]/ydata[a],t);
+				break;
+			case nsl_interp_type_pch: {
+					t = (x-xdata[a])/(xdata[b]-xdata[a]);
+					double t2 = t*t, t3 = t2*t;
+					double h1 = 2.*t3-3.*t2+1, h2 = -2.*t3+3.*t2, h3 = t3-2*t2+t, h4 = t3-t2;
+					double m1 = 0.,m2 = 0.;
+					switch (variant) {
+					case nsl_interp_pch_variant_finite_difference:
+						if (a == 0)
+							m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m1 = ( (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) + (ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1]) )/2.;
+						if (b == n-1)
+							m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m2 = ( (ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) + (ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
+
+						break;
+					case nsl_interp_pch_variant_catmull_rom:
+						if (a == 0)
+							m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m1 = (ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
+						if (b == n-1)
+							m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m2 = (ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
+
+						break;
+					case nsl_interp_pch_variant_cardinal:
+						if (a == 0)
+							m1 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m1 = (ydata[b]-ydata[a-1])/(xdata[b]-xdata[a-1]);
+						m1 *= (1.-tension);
+						if (b == n-1)
+							m2 = (ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m2 = (ydata[b+1]-ydata[a])/(xdata[b+1]-xdata[a]);
+						m2 *= (1.-tension);
+
+						break;
+					case nsl_interp_pch_variant_kochanek_bartels:
+						if (a == 0)
+							m1 = (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m1 = ( (1.-continuity)*(1.+bias)*(ydata[a]-ydata[a-1])/(xdata[a]-xdata[a-1])
+							     + (1.+continuity)*(1.-bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]) )/2.;
+						m1 *= (1.-tension);
+						if (b == n-1)
+							m2 = (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a]);
+						else
+							m2 = ( (1.+continuity)*(1.+bias)*(ydata[b]-ydata[a])/(xdata[b]-xdata[a])
+							     + (1.-continuity)*(1.-bias)*(ydata[b+1]-ydata[b])/(xdata[b+1]-xdata[b]) )/2.;
+						m2 *= (1.-tension);
+
+						break;
+					}
+
+					// Hermite polynomial
+					(*yResultVector)[(int)i] = ydata[a]*h1+ydata[b]*h2+(xdata[b]-xdata[a])*(m1*h3+m2*h4);
+				}
+				break;
+			case nsl_interp_type_rational: {
+					double v,dv;
+					nsl_interp_ratint(xdata, ydata, (int)n, x, &v, &dv);
+					(*yResultVector)[(int)i] = v;
+					//TODO: use error dv
+					break;
+				}
 			}
 		}
-	}
 
-	// calculate "evaluate" option for own types
-	if (type == nsl_interp_type_cosine || type == nsl_interp_type_exponential || type == nsl_interp_type_pch || type == nsl_interp_type_rational) {
-		switch (evaluate) {
-		case nsl_interp_evaluate_function:
-			break;
-		case nsl_interp_evaluate_derivative:
-			nsl_diff_first_deriv_second_order(xVector->data(), yVector->data(), npoints);
-			break;
-		case nsl_interp_evaluate_second_derivative:
-			nsl_diff_second_deriv_second_order(xVector->data(), yVector->data(), npoints);
-			break;
-		case nsl_interp_evaluate_integral:
-			nsl_int_trapezoid(xVector->data(), yVector->data(), npoints, 0);
-			break;
+		if (cancelled.load(std::memory_order_relaxed)) {
+			gsl_spline_free(spline);
+			gsl_interp_accel_free(acc);
+			return;
 		}
-	}
 
-	// check values
-	for (int i = 0; i < (int)npoints; i++) {
-		if ((*yVector)[i] > std::numeric_limits<double>::max())
-			(*yVector)[i] = std::numeric_limits<double>::max();
-		else if ((*yVector)[i] < std::numeric_limits<double>::lowest())
-			(*yVector)[i] = std::numeric_limits<double>::lowest();
-	}
+		// calculate "evaluate" option for own types
+		if (type == nsl_interp_type_cosine || type == nsl_interp_type_exponential || type == nsl_interp_type_pch || type == nsl_interp_type_rational) {
+			switch (evaluate) {
+			case nsl_interp_evaluate_function:
+				break;
+			case nsl_interp_evaluate_derivative:
+				nsl_diff_first_deriv_second_order(xResultVector->data(), yResultVector->data(), npoints);
+				break;
+			case nsl_interp_evaluate_second_derivative:
+				nsl_diff_second_deriv_second_order(xResultVector->data(), yResultVector->data(), npoints);
+				break;
+			case nsl_interp_evaluate_integral:
+				nsl_int_trapezoid(xResultVector->data(), yResultVector->data(), npoints, 0);
+				break;
+			}
+		}
+
+		// check values
+		for (int i = 0; i < (int)npoints; i++) {
+			if ((*yResultVector)[i] > std::numeric_limits<double>::max())
+				(*yResultVector)[i] = std::numeric_limits<double>::max();
+			else if ((*yResultVector)[i] < std::numeric_limits<double>::lowest())
+				(*yResultVector)[i] = std::numeric_limits<double>::lowest();
+		}
 
-	gsl_spline_free(spline);
-	gsl_interp_accel_free(acc);
+		gsl_spline_free(spline);
+		gsl_interp_accel_free(acc);
 
+		result->available = true;
+		result->valid = true;
+		result->status = gslErrorToString(status);
+		result->elapsedTime = timer.elapsed();
+	};
 ///////////////////////////////////////////////////////////
 
-	//write the result
-	interpolationResult.available = true;
-	interpolationResult.valid = true;
-	interpolationResult.status = gslErrorToString(status);
-	interpolationResult.elapsedTime = timer.elapsed();
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xResultVector;
+		*yVector = *yResultVector;
+		invalidateResultColumns();
+		interpolationResult = *result;
 
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
+
+	runJob((int)qMax(n, npoints), calculate, finish);
 }
 
+
 //##############################################################################
 //##################  Serialization/Deserialization  ###########################
 //##############################################################################
@@ -27,6 +27,7 @@
 
 #include <QIcon>
 #include <QElapsedTimer>
+#include <QMutex>
 #include <QThreadPool>
 
 extern "C" {
@@ -35,6 +36,9 @@ extern "C" {
 #include "backend/nsl/nsl_sf_kernel.h"
 }
 
+// the constant values for the padding are global in nsl, guards them while smoothing in different threads
+static QMutex padConstantMutex;
+
 XYSmoothCurve::XYSmoothCurve(const QString& name)
 	: XYAnalysisCurve(name, new XYSmoothCurvePrivate(this), AspectType::XYSmoothCurve) {
 }
@@ -90,10 +94,8 @@ XYSmoothCurvePrivate::~XYSmoothCurvePrivate() = default;
 
 void XYSmoothCurvePrivate::recalculate() {
 	DEBUG(Q_FUNC_INFO)
-	QElapsedTimer timer;
-	timer.start();
 
-	//create smooth result columns if not available yet, clear them otherwise
+	//create smooth result columns if not available yet
 	if (!xColumn) {
 		xColumn = new Column("x", AbstractColumn::ColumnMode::Double);
 		yColumn = new Column("y", AbstractColumn::ColumnMode::Double);
@@ -111,11 +113,6 @@ void XYSmoothCurvePrivate::recalculate() {
 		q->setXColumn(xColumn);
 		q->setYColumn(yColumn);
 		q->setUndoAware(true);
-	} else {
-		xVector->clear();
-		yVector->clear();
-		if (roughVector)
-			roughVector->clear();
 	}
 
 	if (!roughColumn) {
@@ -125,8 +122,15 @@ void XYSmoothCurvePrivate::recalculate() {
 		q->addChild(roughColumn);
 	}
 
-	// clear the previous result
-	smoothResult = XYSmoothCurve::SmoothResult();
+	//the results are written at once when the smooth is done, clear the previous result in case of errors
+	cancelJob();
+	auto clearResult = [this]() {
+		xVector->clear();
+		yVector->clear();
+		roughVector->clear();
+		invalidateResultColumns();
+		smoothResult = XYSmoothCurve::SmoothResult();
+	};
 
 	//determine the data source columns
 	const AbstractColumn* tmpXDataColumn = nullptr;
@@ -142,6 +146,7 @@ void XYSmoothCurvePrivate::recalculate() {
 	}
 
 	if (!tmpXDataColumn || !tmpYDataColumn) {
+		clearResult();
 		Q_EMIT q->dataChanged();
 		sourceDataChangedSinceLastRecalc = false;
 		return;
@@ -149,6 +154,7 @@ void XYSmoothCurvePrivate::recalculate() {
 
 	//check column sizes
 	if (tmpXDataColumn->rowCount() != tmpYDataColumn->rowCount()) {
+		clearResult();
 		smoothResult.available = true;
 		smoothResult.valid = false;
 		smoothResult.status = i18n("Number of x and y data points must be equal.");
@@ -159,8 +165,8 @@ void XYSmoothCurvePrivate::recalculate() {
 	}
 
 	//copy all valid data point for the smooth to temporary vectors
-	QVector<double> xdataVector;
-	QVector<double> ydataVector;
+	auto xdataVector = std::make_shared<QVector<double>>();
+	auto ydataVector = std::make_shared<QVector<double>>();
 
 	double xmin;
 	double xmax;
@@ -172,11 +178,12 @@ void XYSmoothCurvePrivate::recalculate() {
 		xmax = smoothData.xRange.last();
 	}
 
-	XYAnalysisCurve::copyData(xdataVector, ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
+	XYAnalysisCurve::copyData(*xdataVector, *ydataVector, tmpXDataColumn, tmpYDataColumn, xmin, xmax);
 
 	//number of data points to smooth
-	const size_t n = (size_t)xdataVector.size();
+	const size_t n = (size_t)xdataVector->size();
 	if (n < 2) {
+		clearResult();
 		smoothResult.available = true;
 		smoothResult.valid = false;
 		smoothResult.status = i18n("Not enough data points available.");
@@ -186,12 +193,6 @@ void XYSmoothCurvePrivate::recalculate() {
 		return;
 	}
 
-	double* xdata = xdataVector.data();
-	double* ydata = ydataVector.data();
-
-	double* ydataOriginal = new double[n];
-	memcpy(ydataOriginal, ydata, n*sizeof(double));
-
 	// smooth settings
 	const nsl_smooth_type type = smoothData.type;
 	const size_t points = smoothData.points;
@@ -210,52 +211,68 @@ void XYSmoothCurvePrivate::recalculate() {
 	DEBUG("	pad mode =	" << nsl_smooth_pad_mode_name[padMode]);
 	DEBUG("	const. values = " << lvalue << ' ' << rvalue);
 
+	auto roughDataVector = std::make_shared<QVector<double>>();
+	auto result = std::make_shared<XYSmoothCurve::SmoothResult>();
+
 ///////////////////////////////////////////////////////////
-	int status = 0;
-
-	switch (type) {
-	case nsl_smooth_type_moving_average:
-		status = nsl_smooth_moving_average(ydata, n, points, weight, padMode);
-		break;
-	case nsl_smooth_type_moving_average_lagged:
-		status = nsl_smooth_moving_average_lagged(ydata, n, points, weight, padMode);
-		break;
-	case nsl_smooth_type_percentile:
-		status = nsl_smooth_percentile(ydata, n, points, percentile, padMode);
-		break;
-	case nsl_smooth_type_savitzky_golay:
+	auto calculate = [=](const std::atomic<bool>&) {
+		QElapsedTimer timer;
+		timer.start();
+
+		const QVector<double> ydataOriginal(*ydataVector);
+		double* ydata = ydataVector->data();	// detaches from the original values
+
+		QMutexLocker locker(&padConstantMutex);
 		if (padMode == nsl_smooth_pad_constant)
 			nsl_smooth_pad_constant_set(lvalue, rvalue);
-		status = nsl_smooth_savgol(ydata, n, points, order, padMode);
-		break;
-	}
-
-	xVector->resize((int)n);
-	yVector->resize((int)n);
-	memcpy(xVector->data(), xdata, n*sizeof(double));
-	memcpy(yVector->data(), ydata, n*sizeof(double));
-///////////////////////////////////////////////////////////
+		else
+			locker.unlock();
 
-	//write the result
-	smoothResult.available = true;
-	smoothResult.valid = true;
-	smoothResult.status = QString::number(status);
-	smoothResult.elapsedTime = timer.elapsed();
+		int status = 0;
+		switch (type) {
+		case nsl_smooth_type_moving_average:
+			status = nsl_smooth_moving_average(ydata, n, points, weight, padMode);
+			break;
+		case nsl_smooth_type_moving_average_lagged:
+			status = nsl_smooth_moving_average_lagged(ydata, n, points, weight, padMode);
+			break;
+		case nsl_smooth_type_percentile:
+			status = nsl_smooth_percentile(ydata, n, points, percentile, padMode);
+			break;
+		case nsl_smooth_type_savitzky_golay:
+			status = nsl_smooth_savgol(ydata, n, points, order, padMode);
+			break;
+		}
+		locker.unlock();
 
-	//fill rough vector
-	if (roughVector) {
-		roughVector->resize((int)n);
+		//rough values
+		roughDataVector->resize((int)n);
 		for (int i = 0; i < (int)n; ++i)
-			roughVector->data()[i] = ydataOriginal[i] - ydata[i];
+			(*roughDataVector)[i] = ydataOriginal.at(i) - ydata[i];
+
+		result->available = true;
+		result->valid = true;
+		result->status = QString::number(status);
+		result->elapsedTime = timer.elapsed();
+	};
+///////////////////////////////////////////////////////////
+
+	auto finish = [=]() {
+		//write the result
+		*xVector = *xdataVector;
+		*yVector = *ydataVector;
+		invalidateResultColumns();
+		*roughVector = *roughDataVector;
 		roughColumn->setChanged();
-	}
+		smoothResult = *result;
 
-	delete [] ydataOriginal;
+		//redraw the curve
+		recalcLogicalPoints();
+		Q_EMIT q->dataChanged();
+		sourceDataChangedSinceLastRecalc = false;
+	};
 
-	//redraw the curve
-	recalcLogicalPoints();
-	Q_EMIT q->dataChanged();
-	sourceDataChangedSinceLastRecalc = false;
+	runJob((int)n, calculate, finish);
 }
 
 //##############################################################################
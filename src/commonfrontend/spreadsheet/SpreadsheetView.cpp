@@ -2628,6 +2628,7 @@ void SpreadsheetView::normalizeSelectedColumns(QAction* action) {
 		auto* data = static_cast<QVector<double>* >(col->data());
 		QVector<double> new_data(col->rowCount());
 
+		// the quantiles and deviations of large columns are estimated and the mode is not calculated, the exact statistics are used for them
 		switch (method) {
 		case DivideBySum: {
 			double sum = std::accumulate(data->begin(), data->end(), 0);
@@ -2685,7 +2686,7 @@ void SpreadsheetView::normalizeSelectedColumns(QAction* action) {
 			break;
 		}
 		case DivideByMedian: {
-			double median = col->statistics().median;
+			double median = col->statistics(true).median;
 			if (median != 0.0) {
 				for (int i = 0; i < col->rowCount(); ++i)
 					new_data[i] = data->operator[](i) / median;
@@ -2696,7 +2697,7 @@ void SpreadsheetView::normalizeSelectedColumns(QAction* action) {
 			break;
 		}
 		case DivideByMode: {
-			double mode = col->statistics().mode;
+			double mode = col->statistics(true).mode;
 			if (mode != 0.0 && !std::isnan(mode)) {
 				for (int i = 0; i < col->rowCount(); ++i)
 					new_data[i] = data->operator[](i) / mode;
@@ -2732,7 +2733,7 @@ void SpreadsheetView::normalizeSelectedColumns(QAction* action) {
 			break;
 		}
 		case DivideByMAD: {
-			double mad = col->statistics().medianDeviation;
+			double mad = col->statistics(true).medianDeviation;
 			if (mad != 0.0) {
 				for (int i = 0; i < col->rowCount(); ++i)
 					new_data[i] = data->operator[](i) / mad;
@@ -2743,7 +2744,7 @@ void SpreadsheetView::normalizeSelectedColumns(QAction* action) {
 			break;
 		}
 		case DivideByIQR: {
-			double iqr = col->statistics().iqr;
+			double iqr = col->statistics(true).iqr;
 			if (iqr != 0.0) {
 				for (int i = 0; i < col->rowCount(); ++i)
 					new_data[i] = data->operator[](i) / iqr;
@@ -2766,8 +2767,9 @@ void SpreadsheetView::normalizeSelectedColumns(QAction* action) {
 			break;
 		}
 		case ZScoreMAD: {
-			double median = col->statistics().median;
-			double mad = col->statistics().medianDeviation;
+			const auto& statistics = col->statistics(true);
+			double median = statistics.median;
+			double mad = statistics.medianDeviation;
 			if (mad != 0.0) {
 				for (int i = 0; i < col->rowCount(); ++i)
 					new_data[i] = (data->operator[](i) - median) / mad;
@@ -2778,8 +2780,9 @@ void SpreadsheetView::normalizeSelectedColumns(QAction* action) {
 			break;
 		}
 		case ZScoreIQR: {
-			double median = col->statistics().median;
-			double iqr = col->statistics().thirdQuartile - col->statistics().firstQuartile;
+			const auto& statistics = col->statistics(true);
+			double median = statistics.median;
+			double iqr = statistics.thirdQuartile - statistics.firstQuartile;
 			if (iqr != 0.0) {
 				for (int i = 0; i < col->rowCount(); ++i)
 					new_data[i] = (data->operator[](i) - median) / iqr;
@@ -313,6 +313,7 @@ void WorksheetView::initActions() {
 	addCurveAction = new QAction(QIcon::fromTheme("labplot-xy-curve"), i18n("xy-Curve"), cartesianPlotAddNewActionGroup);
 	addHistogramAction = new QAction(QIcon::fromTheme("view-object-histogram-linear"), i18n("Histogram"), cartesianPlotAddNewActionGroup);
 	addBoxPlotAction = new QAction(QIcon::fromTheme("view-object-histogram-linear"), i18n("Box Plot"), cartesianPlotAddNewActionGroup);
+	addDensityPlotAction = new QAction(QIcon::fromTheme("color-management"), i18n("Density Plot"), cartesianPlotAddNewActionGroup);
 	addEquationCurveAction = new QAction(QIcon::fromTheme("labplot-xy-equation-curve"), i18n("xy-Curve from a Formula"), cartesianPlotAddNewActionGroup);
 	// TODO: no own icons yet
 	addDataOperationCurveAction = new QAction(QIcon::fromTheme("labplot-xy-curve"), i18n("Data Operation"), cartesianPlotAddNewActionGroup);
@@ -503,6 +504,7 @@ void WorksheetView::initMenus() {
 	m_cartesianPlotAddNewMenu->addAction(addCurveAction);
 	m_cartesianPlotAddNewMenu->addAction(addHistogramAction);
 	m_cartesianPlotAddNewMenu->addAction(addBoxPlotAction);
+	m_cartesianPlotAddNewMenu->addAction(addDensityPlotAction);
 	m_cartesianPlotAddNewMenu->addAction(addEquationCurveAction);
 	m_cartesianPlotAddNewMenu->addSeparator();
 
@@ -2548,6 +2550,8 @@ void WorksheetView::cartesianPlotAdd(CartesianPlot* plot, QAction* action) {
 		plot->addHistogram();
 	else if (action == addBoxPlotAction)
 		plot->addBoxPlot();
+	else if (action == addDensityPlotAction)
+		plot->addDensityPlot();
 	else if (action == addEquationCurveAction)
 		plot->addEquationCurve();
 	else if (action == addDataReductionCurveAction)
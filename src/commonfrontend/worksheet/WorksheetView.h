@@ -211,6 +211,7 @@ private:
 	QAction* addCurveAction{nullptr};
 	QAction* addHistogramAction{nullptr};
 	QAction* addBoxPlotAction{nullptr};
+	QAction* addDensityPlotAction{nullptr};
 	QAction* addEquationCurveAction{nullptr};
 	QAction* addDataOperationCurveAction{nullptr};
 	QAction* addDataReductionCurveAction{nullptr};
@@ -25,6 +25,7 @@
 #include "backend/worksheet/plots/cartesian/ReferenceLine.h"
 #include "backend/worksheet/plots/cartesian/Histogram.h"
 #include "backend/worksheet/plots/cartesian/BoxPlot.h"
+#include "backend/worksheet/plots/cartesian/DensityPlot.h"
 #include "backend/worksheet/Image.h"
 #include "backend/worksheet/InfoElement.h"
 #include "backend/worksheet/TextLabel.h"
@@ -58,6 +59,7 @@
 #include "kdefrontend/dockwidgets/XYCurveDock.h"
 #include "kdefrontend/dockwidgets/HistogramDock.h"
 #include "kdefrontend/dockwidgets/BoxPlotDock.h"
+#include "kdefrontend/dockwidgets/DensityPlotDock.h"
 #include "kdefrontend/dockwidgets/XYEquationCurveDock.h"
 #include "kdefrontend/dockwidgets/XYDataReductionCurveDock.h"
 #include "kdefrontend/dockwidgets/XYDifferentiationCurveDock.h"
@@ -338,6 +340,11 @@ void GuiObserver::selectedAspectsChanged(QList<AbstractAspect*>& selectedAspects
 		raiseDock(m_mainWindow->boxPlotDock, m_mainWindow->stackedWidget);
 		m_mainWindow->boxPlotDock->setBoxPlots(castList<BoxPlot>(selectedAspects));
 		break;
+	case AspectType::DensityPlot:
+		m_mainWindow->m_propertiesDock->setWindowTitle(i18nc("@title:window", "Density Plot"));
+		raiseDock(m_mainWindow->densityPlotDock, m_mainWindow->stackedWidget);
+		m_mainWindow->densityPlotDock->setDensityPlots(castList<DensityPlot>(selectedAspects));
+		break;
 	case AspectType::TextLabel:
 		m_mainWindow->m_propertiesDock->setWindowTitle(i18nc("@title:window", "Text Label"));
 		raiseDock(m_mainWindow->textLabelDock, m_mainWindow->stackedWidget);
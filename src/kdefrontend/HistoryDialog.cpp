@@ -10,6 +10,8 @@
 #include "HistoryDialog.h"
 
 #include <QDialogButtonBox>
+#include <QIdentityProxyModel>
+#include <QItemSelectionModel>
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QWindow>
@@ -21,15 +23,53 @@
 #include <KSharedConfig>
 #include <KWindowConfig>
 
+namespace {
+// disables the steps of the undo history that can't be reached anymore,
+// the commands below the undo limit were released because of the undo memory budget
+class UndoLimitModel : public QIdentityProxyModel {
+public:
+	UndoLimitModel(int undoLimitIndex, QObject* parent) : QIdentityProxyModel(parent), m_undoLimitIndex(undoLimitIndex) {}
+
+	Qt::ItemFlags flags(const QModelIndex& index) const override {
+		// row i shows the state after the first i commands
+		if (index.row() < m_undoLimitIndex)
+			return Qt::NoItemFlags;
+		return QIdentityProxyModel::flags(index);
+	}
+
+private:
+	int m_undoLimitIndex;
+};
+}
+
 /*!
 	\class HistoryDialog
 	\brief Display the content of project's undo stack.
 
+	The steps before \c undoLimitIndex can't be selected, their commands can't be undone anymore.
+
 	\ingroup kdefrontend
  */
-HistoryDialog::HistoryDialog(QWidget* parent, QUndoStack* stack, const QString& emptyLabel) : QDialog(parent),
+HistoryDialog::HistoryDialog(QWidget* parent, QUndoStack* stack, const QString& emptyLabel, int undoLimitIndex) : QDialog(parent),
 	m_undoStack(stack) {
 	auto* undoView = new QUndoView(stack, this);
+	if (undoLimitIndex > 0) {
+		// the undo stack follows the current item of the selection model of QUndoView's model,
+		// the view shows the steps via a proxy model and the current items are synchronized
+		auto* undoModel = undoView->model();
+		auto* undoSelection = undoView->selectionModel();
+		auto* model = new UndoLimitModel(undoLimitIndex, this);
+		model->setSourceModel(undoModel);
+		undoView->setModel(model);
+		auto* selection = undoView->selectionModel();
+		selection->setCurrentIndex(model->mapFromSource(undoSelection->currentIndex()), QItemSelectionModel::ClearAndSelect);
+		connect(selection, &QItemSelectionModel::currentChanged, this, [=](const QModelIndex& current) {
+			undoSelection->setCurrentIndex(model->mapToSource(current), QItemSelectionModel::ClearAndSelect);
+		});
+		connect(undoSelection, &QItemSelectionModel::currentChanged, this, [=](const QModelIndex& current) {
+			selection->setCurrentIndex(model->mapFromSource(current), QItemSelectionModel::ClearAndSelect);
+		});
+	}
 	undoView->setCleanIcon( QIcon::fromTheme(QLatin1String("edit-clear-history")) );
 	undoView->setEmptyLabel(emptyLabel);
 	undoView->setMinimumWidth(350);
@@ -20,7 +20,7 @@ class HistoryDialog: public QDialog {
 	Q_OBJECT
 
 public:
-	HistoryDialog(QWidget*, QUndoStack*, const QString&);
+	HistoryDialog(QWidget*, QUndoStack*, const QString&, int undoLimitIndex = 0);
 	~HistoryDialog() override;
 
 private:
@@ -12,6 +12,7 @@
 #include "MainWin.h"
 
 #include "backend/core/Project.h"
+#include "backend/core/column/Column.h"
 #include "backend/core/Folder.h"
 #include "backend/core/AspectTreeModel.h"
 #include "backend/core/Workbook.h"
@@ -1623,13 +1624,14 @@ bool MainWin::saveProjectAs() {
 	KConfigGroup conf(KSharedConfig::openConfig(), "MainWin");
 	const QString& dir = conf.readEntry("LastOpenDir", "");
 	QString path = QFileDialog::getSaveFileName(this, i18nc("@title:window", "Save Project As"), dir + m_project->fileName(),
-		i18n("LabPlot Projects (*.lml *.lml.gz *.lml.bz2 *.lml.xz *.LML *.LML.GZ *.LML.BZ2 *.LML.XZ)"));
+		i18n("LabPlot Projects (*.lml *.lml.gz *.lml.bz2 *.lml.xz *.LML *.LML.GZ *.LML.BZ2 *.LML.XZ)") + QLatin1String(";;")
+		+ i18n("LabPlot Binary Projects (*.lmlb *.LMLB)"));
 	// The "Automatically select filename extension (.lml)" option does not change anything
 
 	if (path.isEmpty())// "Cancel" was clicked
 		return false;
 
-	if (!path.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive))
+	if (!path.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive) && !Project::isBinaryProject(path))
 		path.append(QLatin1String(".lml"));
 
 	//save new "last open directory"
@@ -1659,9 +1661,13 @@ bool MainWin::save(const QString& fileName) {
 	tempFile.close();
 
 	QIODevice* file;
+	// binary project files are not compressed as a whole, the column data is compressed per column.
 	// if file ending is .lml, do xz compression or gzip compression in compatibility mode
+	const bool binary = Project::isBinaryProject(fileName);
 	const KConfigGroup group = KSharedConfig::openConfig()->group("Settings_General");
-	if (fileName.endsWith(QLatin1String(".lml"))) {
+	if (binary)
+		file = new QFile(tempFileName);
+	else if (fileName.endsWith(QLatin1String(".lml"))) {
 		if (group.readEntry("CompatibleSave", false))
 			file = new KCompressionDevice(tempFileName, KCompressionDevice::GZip);
 		else
@@ -1686,19 +1692,41 @@ bool MainWin::save(const QString& fileName) {
 			thumbnail = centralWidget()->grab(rect);
 		}
 
-		QXmlStreamWriter writer(file);
 		m_project->setFileName(fileName);
-		m_project->save(thumbnail, &writer);
+		bool saved = true;
+		bool incremental = false;
+		if (binary) {
+			// only the changed data is appended to the binary project file the project was loaded from or saved to before,
+			// the project is saved completely if this is not possible or the file needs to be compacted
+			incremental = m_project->saveBinaryIncremental(thumbnail);
+			if (!incremental)
+				saved = m_project->saveBinary(thumbnail, file);
+		} else {
+			QXmlStreamWriter writer(file);
+			m_project->save(thumbnail, &writer);
+		}
 		m_project->undoStack()->clear();
 		m_project->setChanged(false);
 		file->close();
 
-		// target file must not exist
-		if (QFile::exists(fileName))
-			QFile::remove(fileName);
+		bool rc = saved;
+		if (saved && !incremental) {
+#ifdef Q_OS_WIN
+			// the project file is kept open for lazy loading and incremental saves, it can't be replaced otherwise
+			m_project->detachBinaryFile();
+#endif
 
-		// do not rename temp file. Qt still holds a handle (which fails renaming on Windows) and deletes it
-		bool rc = QFile::copy(tempFileName, fileName);
+			// target file must not exist
+			if (QFile::exists(fileName))
+				QFile::remove(fileName);
+
+			// do not rename temp file. Qt still holds a handle (which fails renaming on Windows) and deletes it
+			rc = QFile::copy(tempFileName, fileName);
+
+			// the columns refer to their data in the new file, the next save can be incremental
+			if (rc && binary)
+				m_project->attachBinaryFile(fileName);
+		}
 		if (rc) {
 			updateTitleBar();
 			statusBar()->showMessage(i18n("Project saved"));
@@ -2135,6 +2163,12 @@ void MainWin::createFolderContextMenu(const Folder*, QMenu* menu) const {
 }
 
 void MainWin::undo() {
+	//the oldest commands can't be undone anymore if their data was released because of the undo memory budget
+	if (!m_project->canUndo()) {
+		m_undoAction->setEnabled(false);
+		return;
+	}
+
 	WAIT_CURSOR;
 	m_project->undoStack()->undo();
 	if (m_project->undoStack()->index() == 0) {
@@ -2142,7 +2176,8 @@ void MainWin::undo() {
 		m_undoAction->setEnabled(false);
 		m_project->setChanged(false);
 		updateTitleBar();
-	}
+	} else if (!m_project->canUndo())
+		m_undoAction->setEnabled(false);
 	m_redoAction->setEnabled(true);
 	RESET_CURSOR;
 }
@@ -2435,6 +2470,10 @@ void MainWin::handleSettingsChanges() {
 	if (interval != m_autoSaveTimer.interval())
 		m_autoSaveTimer.setInterval(interval);
 
+	//memory of the undo history, new projects read it from the settings
+	if (m_project)
+		m_project->setUndoMemoryBudget(group.readEntry("UndoMemoryBudget", 1024) * 1024 * 1024LL);
+
 	//update the locale and the units in the dock widgets
 	if (stackedWidget) {
 		for (int i = 0; i < stackedWidget->count(); ++i) {
@@ -2480,7 +2519,7 @@ void MainWin::historyDialog() {
 	if (!m_project->undoStack())
 		return;
 
-	auto* dialog = new HistoryDialog(this, m_project->undoStack(), m_undoViewEmptyLabel);
+	auto* dialog = new HistoryDialog(this, m_project->undoStack(), m_undoViewEmptyLabel, m_project->undoLimitIndex());
 	int index = m_project->undoStack()->index();
 	if (dialog->exec() != QDialog::Accepted) {
 		if (m_project->undoStack()->count() != 0)
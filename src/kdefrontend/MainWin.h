@@ -36,6 +36,7 @@ class NoteDock;
 class CartesianPlotDock;
 class HistogramDock;
 class BoxPlotDock;
+class DensityPlotDock;
 class CartesianPlotLegendDock;
 class CustomPointDock;
 class ReferenceLineDock;
@@ -242,6 +243,7 @@ private:
 	XYCorrelationCurveDock* xyCorrelationCurveDock{nullptr};
 	HistogramDock* histogramDock{nullptr};
 	BoxPlotDock* boxPlotDock{nullptr};
+	DensityPlotDock* densityPlotDock{nullptr};
 	WorksheetDock* worksheetDock{nullptr};
 	LabelWidget* textLabelDock{nullptr};
 	ImageDock* imageDock{nullptr};
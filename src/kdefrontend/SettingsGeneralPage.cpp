@@ -10,6 +10,7 @@
 
 
 #include "SettingsGeneralPage.h"
+#include "backend/core/column/Column.h"
 #include "backend/lib/macros.h"
 #include "kdefrontend/MainWin.h"	// LoadOnStart
 
@@ -23,6 +24,10 @@
 SettingsGeneralPage::SettingsGeneralPage(QWidget* parent) : SettingsPage(parent) {
 	ui.setupUi(this);
 	ui.sbAutoSaveInterval->setSuffix(i18n("min."));
+	ui.sbLazyLoadingMemoryBudget->setSuffix(i18n(" MB"));
+	ui.sbLazyLoadingMemoryBudget->setSpecialValueText(i18n("unlimited"));
+	ui.sbUndoMemoryBudget->setSuffix(i18n(" MB"));
+	ui.sbUndoMemoryBudget->setSpecialValueText(i18n("unlimited"));
 	retranslateUi();
 
 	connect(ui.cbLoadOnStart, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SettingsGeneralPage::changed);
@@ -37,10 +42,14 @@ SettingsGeneralPage::SettingsGeneralPage(QWidget* parent) : SettingsPage(parent)
 	connect(ui.chkIncludeTrailingZeroesAfterDot, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkAutoSave, &QCheckBox::toggled, this, &SettingsGeneralPage::autoSaveChanged);
 	connect(ui.chkCompatible, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
+	connect(ui.chkLazyLoading, &QCheckBox::toggled, this, &SettingsGeneralPage::lazyLoadingChanged);
+	connect(ui.sbLazyLoadingMemoryBudget, QOverload<int>::of(&QSpinBox::valueChanged), this, &SettingsGeneralPage::changed);
+	connect(ui.sbUndoMemoryBudget, QOverload<int>::of(&QSpinBox::valueChanged), this, &SettingsGeneralPage::changed);
 
 	loadSettings();
 	interfaceChanged(ui.cbInterface->currentIndex());
 	autoSaveChanged(ui.chkAutoSave->isChecked());
+	lazyLoadingChanged(ui.chkLazyLoading->isChecked());
 }
 
 /* returns decimal separator (as SettingsGeneralPage::DecimalSeparator) of given locale (default: system setting) */
@@ -111,6 +120,10 @@ void SettingsGeneralPage::applySettings() {
 	group.writeEntry(QLatin1String("AutoSave"), ui.chkAutoSave->isChecked());
 	group.writeEntry(QLatin1String("AutoSaveInterval"), ui.sbAutoSaveInterval->value());
 	group.writeEntry(QLatin1String("CompatibleSave"), ui.chkCompatible->isChecked());
+	group.writeEntry(QLatin1String("LazyLoading"), ui.chkLazyLoading->isChecked());
+	group.writeEntry(QLatin1String("LazyLoadingMemoryBudget"), ui.sbLazyLoadingMemoryBudget->value());
+	Column::setLoadedDataBudget(ui.sbLazyLoadingMemoryBudget->value() * 1024 * 1024LL);
+	group.writeEntry(QLatin1String("UndoMemoryBudget"), ui.sbUndoMemoryBudget->value());
 }
 
 void SettingsGeneralPage::restoreDefaults() {
@@ -127,6 +140,9 @@ void SettingsGeneralPage::restoreDefaults() {
 	ui.chkAutoSave->setChecked(false);
 	ui.sbAutoSaveInterval->setValue(5);
 	ui.chkCompatible->setChecked(false);
+	ui.chkLazyLoading->setChecked(true);
+	ui.sbLazyLoadingMemoryBudget->setValue(0);
+	ui.sbUndoMemoryBudget->setValue(1024);
 }
 
 void SettingsGeneralPage::loadSettings() {
@@ -153,6 +169,9 @@ void SettingsGeneralPage::loadSettings() {
 	ui.chkAutoSave->setChecked(group.readEntry<bool>(QLatin1String("AutoSave"), false));
 	ui.sbAutoSaveInterval->setValue(group.readEntry(QLatin1String("AutoSaveInterval"), 0));
 	ui.chkCompatible->setChecked(group.readEntry<bool>(QLatin1String("CompatibleSave"), false));
+	ui.chkLazyLoading->setChecked(group.readEntry<bool>(QLatin1String("LazyLoading"), true));
+	ui.sbLazyLoadingMemoryBudget->setValue(group.readEntry(QLatin1String("LazyLoadingMemoryBudget"), 0));
+	ui.sbUndoMemoryBudget->setValue(group.readEntry(QLatin1String("UndoMemoryBudget"), 1024));
 }
 
 void SettingsGeneralPage::retranslateUi() {
@@ -212,3 +231,9 @@ void SettingsGeneralPage::autoSaveChanged(bool state) {
 	ui.sbAutoSaveInterval->setVisible(state);
 	changed();
 }
+
+void SettingsGeneralPage::lazyLoadingChanged(bool state) {
+	ui.lLazyLoadingMemoryBudget->setVisible(state);
+	ui.sbLazyLoadingMemoryBudget->setVisible(state);
+	changed();
+}
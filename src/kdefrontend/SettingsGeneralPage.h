@@ -38,6 +38,7 @@ private:
 private Q_SLOTS:
 	void interfaceChanged(int);
 	void autoSaveChanged(bool);
+	void lazyLoadingChanged(bool);
 	void changed();
 
 Q_SIGNALS:
@@ -24,6 +24,7 @@ public:
 	void updateContent(HDF5Filter*, const QString &fileName);
 	const QStringList selectedNames() const;
 	int lines() const { return ui.sbPreviewLines->value(); }
+	size_t chunkCacheSize() const { return ui.sbChunkCacheSize->value() * 1024 * 1024ULL; }
 	QTableWidget* previewWidget() const { return ui.twPreview; }
 
 private:
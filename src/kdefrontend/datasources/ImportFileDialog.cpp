@@ -280,18 +280,24 @@ void ImportFileDialog::importTo(QStatusBar* statusBar) const {
 
 			// import every set to a different sheet
 			sheets = workbook->children<AbstractAspect>();
-			for (int i = 0; i < nrNames; ++i) {
-				if (fileType == AbstractFileFilter::FileType::HDF5)
-					static_cast<HDF5Filter*>(filter)->setCurrentDataSetName(names.at(i));
-				else if (fileType == AbstractFileFilter::FileType::NETCDF)
-					static_cast<NetCDFFilter*>(filter)->setCurrentVarName(names.at(i));
-				else if (fileType == AbstractFileFilter::FileType::MATIO)
-					static_cast<MatioFilter*>(filter)->setCurrentVarName(names.at(i));
-				else if (fileType == AbstractFileFilter::FileType::ROOT)
-					static_cast<ROOTFilter*>(filter)->setCurrentObject(names.at(i));
-
-				int index = i + offset;
-				filter->readDataFromFile(fileName, qobject_cast<Spreadsheet*>(sheets.at(index)));
+			if (fileType == AbstractFileFilter::FileType::HDF5) {
+				// the data sets are read in parallel
+				QVector<AbstractDataSource*> dataSources;
+				for (int i = 0; i < nrNames; ++i)
+					dataSources << qobject_cast<Spreadsheet*>(sheets.at(i + offset));
+				static_cast<HDF5Filter*>(filter)->readDataSets(fileName, names, dataSources);
+			} else {
+				for (int i = 0; i < nrNames; ++i) {
+					if (fileType == AbstractFileFilter::FileType::NETCDF)
+						static_cast<NetCDFFilter*>(filter)->setCurrentVarName(names.at(i));
+					else if (fileType == AbstractFileFilter::FileType::MATIO)
+						static_cast<MatioFilter*>(filter)->setCurrentVarName(names.at(i));
+					else if (fileType == AbstractFileFilter::FileType::ROOT)
+						static_cast<ROOTFilter*>(filter)->setCurrentObject(names.at(i));
+
+					int index = i + offset;
+					filter->readDataFromFile(fileName, qobject_cast<Spreadsheet*>(sheets.at(index)));
+				}
 			}
 
 			workbook->setUndoAware(true);
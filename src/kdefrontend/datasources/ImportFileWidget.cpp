@@ -662,6 +662,7 @@ AbstractFileFilter* ImportFileWidget::currentFileFilter() const {
 		filter->setEndRow(ui.sbEndRow->value());
 		filter->setStartColumn(ui.sbStartColumn->value());
 		filter->setEndColumn(ui.sbEndColumn->value());
+		filter->setChunkCacheSize(m_hdf5OptionsWidget->chunkCacheSize());
 		DEBUG(Q_FUNC_INFO << ", OK");
 
 		break;
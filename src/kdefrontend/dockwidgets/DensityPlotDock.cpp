@@ -0,0 +1,304 @@
+/*
+    File                 : DensityPlotDock.cpp
+    Project              : LabPlot
+    Description          : Dock widget for the density plot
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "DensityPlotDock.h"
+#include "backend/core/AbstractColumn.h"
+#include "backend/core/AspectTreeModel.h"
+#include "backend/core/Project.h"
+#include "commonfrontend/widgets/TreeViewComboBox.h"
+#include "kdefrontend/colormaps/ColorMapsDialog.h"
+#include "tools/ColorMapsManager.h"
+
+#include <KLocalizedString>
+
+/*!
+  \class DensityPlotDock
+  \brief  Provides a widget for editing the properties of the density plots currently selected in the project explorer.
+
+  If more than one density plot is set, the properties of the first one are shown.
+  The changes of the properties are applied to all plots.
+  The exclusions are the name, the comment and the data columns - these properties can only be changed if there is only one single plot.
+
+  \ingroup kdefrontend
+*/
+DensityPlotDock::DensityPlotDock(QWidget* parent) : BaseDock(parent),
+	cbXColumn(new TreeViewComboBox),
+	cbYColumn(new TreeViewComboBox),
+	cbValuesColumn(new TreeViewComboBox) {
+	ui.setupUi(this);
+	m_leName = ui.leName;
+	m_teComment = ui.teComment;
+	m_teComment->setFixedHeight(1.2 * m_leName->height());
+
+	auto* gridLayout = qobject_cast<QGridLayout*>(ui.tabGeneral->layout());
+	gridLayout->addWidget(cbXColumn, 4, 2, 1, 1);
+	gridLayout->addWidget(cbYColumn, 5, 2, 1, 1);
+	gridLayout->addWidget(cbValuesColumn, 7, 2, 1, 1);
+
+	ui.cbAggregation->addItem(i18n("Count"));
+	ui.cbAggregation->addItem(i18n("Sum"));
+	ui.cbAggregation->addItem(i18n("Mean"));
+
+	ui.cbScaling->addItem(i18n("Linear"));
+	ui.cbScaling->addItem(i18n("Logarithmic"));
+	ui.cbScaling->addItem(i18n("Histogram Equalization"));
+
+	ui.bColorMap->setIcon(QIcon::fromTheme(QLatin1String("color-management")));
+	ui.lColorMapPreview->setMaximumHeight(ui.bColorMap->height());
+
+	//SLOTS
+	connect(ui.leName, &QLineEdit::textChanged, this, &DensityPlotDock::nameChanged);
+	connect(ui.teComment, &QTextEdit::textChanged, this, &DensityPlotDock::commentChanged);
+
+	connect(cbXColumn, &TreeViewComboBox::currentModelIndexChanged, this, &DensityPlotDock::xColumnChanged);
+	connect(cbYColumn, &TreeViewComboBox::currentModelIndexChanged, this, &DensityPlotDock::yColumnChanged);
+	connect(cbValuesColumn, &TreeViewComboBox::currentModelIndexChanged, this, &DensityPlotDock::valuesColumnChanged);
+	connect(ui.cbAggregation, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &DensityPlotDock::aggregationChanged);
+
+	connect(ui.cbScaling, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &DensityPlotDock::scalingChanged);
+	connect(ui.bColorMap, &QPushButton::clicked, this, &DensityPlotDock::selectColorMap);
+	connect(ui.sbOpacity, QOverload<int>::of(&QSpinBox::valueChanged), this, &DensityPlotDock::opacityChanged);
+
+	connect(ui.cbPlotRanges, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &DensityPlotDock::plotRangeChanged);
+	connect(ui.chkVisible, &QCheckBox::clicked, this, &DensityPlotDock::visibilityChanged);
+}
+
+void DensityPlotDock::setModel() {
+	m_aspectTreeModel->enablePlottableColumnsOnly(true);
+	m_aspectTreeModel->enableShowPlotDesignation(true);
+
+	QList<AspectType> list{AspectType::Folder, AspectType::Workbook, AspectType::Datapicker,
+	                       AspectType::DatapickerCurve, AspectType::Spreadsheet, AspectType::LiveDataSource,
+	                       AspectType::Column, AspectType::Worksheet, AspectType::CartesianPlot,
+	                       AspectType::XYFitCurve, AspectType::XYSmoothCurve, AspectType::CantorWorksheet};
+
+	cbXColumn->setTopLevelClasses(list);
+	cbYColumn->setTopLevelClasses(list);
+	cbValuesColumn->setTopLevelClasses(list);
+
+	list = {AspectType::Column};
+	m_aspectTreeModel->setSelectableAspects(list);
+
+	cbXColumn->setModel(m_aspectTreeModel);
+	cbYColumn->setModel(m_aspectTreeModel);
+	cbValuesColumn->setModel(m_aspectTreeModel);
+}
+
+void DensityPlotDock::setDensityPlots(QList<DensityPlot*> list) {
+	const Lock lock(m_initializing);
+	m_plots = list;
+	m_plot = list.first();
+	m_aspect = list.first();
+	Q_ASSERT(m_plot);
+	m_aspectTreeModel = new AspectTreeModel(m_plot->project());
+	setModel();
+
+	//if there is more than one plot in the list, disable the name, the comment and the data columns
+	const bool single = (list.size() == 1);
+	ui.lName->setEnabled(single);
+	ui.leName->setEnabled(single);
+	ui.lComment->setEnabled(single);
+	ui.teComment->setEnabled(single);
+	ui.lXColumn->setEnabled(single);
+	cbXColumn->setEnabled(single);
+	ui.lYColumn->setEnabled(single);
+	cbYColumn->setEnabled(single);
+	ui.lValuesColumn->setEnabled(single);
+	cbValuesColumn->setEnabled(single);
+
+	if (single) {
+		cbXColumn->setColumn(m_plot->xColumn(), m_plot->xColumnPath());
+		cbYColumn->setColumn(m_plot->yColumn(), m_plot->yColumnPath());
+		cbValuesColumn->setColumn(m_plot->valuesColumn(), m_plot->valuesColumnPath());
+		ui.leName->setText(m_plot->name());
+		ui.teComment->setText(m_plot->comment());
+	} else {
+		cbXColumn->setCurrentModelIndex(QModelIndex());
+		cbYColumn->setCurrentModelIndex(QModelIndex());
+		cbValuesColumn->setCurrentModelIndex(QModelIndex());
+		ui.leName->setText(QString());
+		ui.teComment->setText(QString());
+	}
+	ui.leName->setStyleSheet(QString());
+	ui.leName->setToolTip(QString());
+
+	//show the properties of the first plot
+	load();
+
+	updatePlotRanges();
+
+	//SIGNALs/SLOTs
+	connect(m_plot, &AbstractAspect::aspectDescriptionChanged, this, &DensityPlotDock::aspectDescriptionChanged);
+	connect(m_plot, &WorksheetElement::plotRangeListChanged, this, &DensityPlotDock::updatePlotRanges);
+	connect(m_plot, &WorksheetElement::visibleChanged, this, &DensityPlotDock::plotVisibilityChanged);
+	connect(m_plot, &DensityPlot::xColumnChanged, this, &DensityPlotDock::plotXColumnChanged);
+	connect(m_plot, &DensityPlot::yColumnChanged, this, &DensityPlotDock::plotYColumnChanged);
+	connect(m_plot, &DensityPlot::valuesColumnChanged, this, &DensityPlotDock::plotValuesColumnChanged);
+	connect(m_plot, &DensityPlot::aggregationChanged, this, &DensityPlotDock::plotAggregationChanged);
+	connect(m_plot, &DensityPlot::scalingChanged, this, &DensityPlotDock::plotScalingChanged);
+	connect(m_plot, &DensityPlot::colorMapChanged, this, &DensityPlotDock::plotColorMapChanged);
+	connect(m_plot, &DensityPlot::opacityChanged, this, &DensityPlotDock::plotOpacityChanged);
+}
+
+void DensityPlotDock::updatePlotRanges() {
+	updatePlotRangeList(ui.cbPlotRanges);
+}
+
+/*!
+ * the values column is only used for the aggregations "Sum" and "Mean"
+ */
+void DensityPlotDock::updateValuesWidgets() {
+	const bool visible = (ui.cbAggregation->currentIndex() != static_cast<int>(DensityPlot::Aggregation::Count));
+	ui.lValuesColumn->setVisible(visible);
+	cbValuesColumn->setVisible(visible);
+}
+
+const AbstractColumn* DensityPlotDock::column(const QModelIndex& index) {
+	auto* aspect = static_cast<AbstractAspect*>(index.internalPointer());
+	if (!aspect)
+		return nullptr;
+
+	auto* column = dynamic_cast<AbstractColumn*>(aspect);
+	Q_ASSERT(column);
+	return column;
+}
+
+//*************************************************************
+//**** SLOTs for changes triggered in DensityPlotDock *********
+//*************************************************************
+void DensityPlotDock::xColumnChanged(const QModelIndex& index) {
+	if (m_initializing)
+		return;
+
+	const auto* column = this->column(index);
+	for (auto* plot : m_plots)
+		plot->setXColumn(column);
+}
+
+void DensityPlotDock::yColumnChanged(const QModelIndex& index) {
+	if (m_initializing)
+		return;
+
+	const auto* column = this->column(index);
+	for (auto* plot : m_plots)
+		plot->setYColumn(column);
+}
+
+void DensityPlotDock::valuesColumnChanged(const QModelIndex& index) {
+	if (m_initializing)
+		return;
+
+	const auto* column = this->column(index);
+	for (auto* plot : m_plots)
+		plot->setValuesColumn(column);
+}
+
+void DensityPlotDock::aggregationChanged(int index) {
+	updateValuesWidgets();
+
+	if (m_initializing)
+		return;
+
+	const auto aggregation = static_cast<DensityPlot::Aggregation>(index);
+	for (auto* plot : m_plots)
+		plot->setAggregation(aggregation);
+}
+
+void DensityPlotDock::scalingChanged(int index) {
+	if (m_initializing)
+		return;
+
+	const auto scaling = static_cast<DensityPlot::Scaling>(index);
+	for (auto* plot : m_plots)
+		plot->setScaling(scaling);
+}
+
+void DensityPlotDock::selectColorMap() {
+	auto* dlg = new ColorMapsDialog(this);
+	if (dlg->exec() == QDialog::Accepted) {
+		const QString& name = dlg->name();
+		ui.lColorMapPreview->setPixmap(dlg->previewPixmap());
+		for (auto* plot : m_plots)
+			plot->setColorMap(name);
+	}
+	delete dlg;
+}
+
+void DensityPlotDock::opacityChanged(int value) {
+	if (m_initializing)
+		return;
+
+	const qreal opacity = (double)value/100.;
+	for (auto* plot : m_plots)
+		plot->setOpacity(opacity);
+}
+
+void DensityPlotDock::visibilityChanged(bool state) {
+	if (m_initializing)
+		return;
+
+	for (auto* plot : m_plots)
+		plot->setVisible(state);
+}
+
+//*************************************************************
+//******* SLOTs for changes triggered in DensityPlot **********
+//*************************************************************
+void DensityPlotDock::plotXColumnChanged(const AbstractColumn* column) {
+	const Lock lock(m_initializing);
+	cbXColumn->setColumn(column, m_plot->xColumnPath());
+}
+
+void DensityPlotDock::plotYColumnChanged(const AbstractColumn* column) {
+	const Lock lock(m_initializing);
+	cbYColumn->setColumn(column, m_plot->yColumnPath());
+}
+
+void DensityPlotDock::plotValuesColumnChanged(const AbstractColumn* column) {
+	const Lock lock(m_initializing);
+	cbValuesColumn->setColumn(column, m_plot->valuesColumnPath());
+}
+
+void DensityPlotDock::plotAggregationChanged(DensityPlot::Aggregation aggregation) {
+	const Lock lock(m_initializing);
+	ui.cbAggregation->setCurrentIndex(static_cast<int>(aggregation));
+}
+
+void DensityPlotDock::plotScalingChanged(DensityPlot::Scaling scaling) {
+	const Lock lock(m_initializing);
+	ui.cbScaling->setCurrentIndex(static_cast<int>(scaling));
+}
+
+void DensityPlotDock::plotColorMapChanged(const QString& name) {
+	QPixmap pixmap;
+	ColorMapsManager::instance()->render(pixmap, name);
+	ui.lColorMapPreview->setPixmap(pixmap);
+}
+
+void DensityPlotDock::plotOpacityChanged(qreal opacity) {
+	const Lock lock(m_initializing);
+	ui.sbOpacity->setValue(qRound(opacity * 100.0));
+}
+
+void DensityPlotDock::plotVisibilityChanged(bool on) {
+	const Lock lock(m_initializing);
+	ui.chkVisible->setChecked(on);
+}
+
+//**********************************************************
+//******************** SETTINGS ****************************
+//**********************************************************
+void DensityPlotDock::load() {
+	ui.cbAggregation->setCurrentIndex(static_cast<int>(m_plot->aggregation()));
+	updateValuesWidgets();
+	ui.cbScaling->setCurrentIndex(static_cast<int>(m_plot->scaling()));
+	plotColorMapChanged(m_plot->colorMap());
+	ui.sbOpacity->setValue(qRound(m_plot->opacity() * 100.0));
+	ui.chkVisible->setChecked(m_plot->isVisible());
+}
@@ -0,0 +1,66 @@
+/*
+    File                 : DensityPlotDock.h
+    Project              : LabPlot
+    Description          : Dock widget for the density plot
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef DENSITYPLOTDOCK_H
+#define DENSITYPLOTDOCK_H
+
+#include "kdefrontend/dockwidgets/BaseDock.h"
+#include "backend/worksheet/plots/cartesian/DensityPlot.h"
+#include "ui_densityplotdock.h"
+
+class AbstractAspect;
+class AbstractColumn;
+class AspectTreeModel;
+class TreeViewComboBox;
+
+class DensityPlotDock : public BaseDock {
+	Q_OBJECT
+
+public:
+	explicit DensityPlotDock(QWidget*);
+	void setDensityPlots(QList<DensityPlot*>);
+
+private:
+	Ui::DensityPlotDock ui;
+	QList<DensityPlot*> m_plots;
+	DensityPlot* m_plot{nullptr};
+	AspectTreeModel* m_aspectTreeModel{nullptr};
+	TreeViewComboBox* cbXColumn;
+	TreeViewComboBox* cbYColumn;
+	TreeViewComboBox* cbValuesColumn;
+
+	void setModel();
+	void load();
+	void updateValuesWidgets();
+	static const AbstractColumn* column(const QModelIndex&);
+
+private Q_SLOTS:
+	//SLOTs for changes triggered in DensityPlotDock
+	void xColumnChanged(const QModelIndex&);
+	void yColumnChanged(const QModelIndex&);
+	void valuesColumnChanged(const QModelIndex&);
+	void aggregationChanged(int);
+	void scalingChanged(int);
+	void selectColorMap();
+	void opacityChanged(int);
+	void visibilityChanged(bool);
+
+	//SLOTs for changes triggered in DensityPlot
+	void updatePlotRanges() override;
+	void plotXColumnChanged(const AbstractColumn*);
+	void plotYColumnChanged(const AbstractColumn*);
+	void plotValuesColumnChanged(const AbstractColumn*);
+	void plotAggregationChanged(DensityPlot::Aggregation);
+	void plotScalingChanged(DensityPlot::Scaling);
+	void plotColorMapChanged(const QString&);
+	void plotOpacityChanged(qreal);
+	void plotVisibilityChanged(bool);
+};
+
+#endif
@@ -22,15 +22,12 @@
 #include <QWidgetAction>
 #include <QDialogButtonBox>
 #include <QPushButton>
-#include <QThreadPool>
 #include <QWindow>
 #ifndef NDEBUG
 #include <QElapsedTimer>
 #endif
 
-extern "C" {
-#include "backend/gsl/parser.h"
-}
+#include <algorithm>
 #include <cmath>
 
 /*!
@@ -140,48 +137,6 @@ void MatrixFunctionDialog::insertConstant(const QString& constantsName) const {
 	ui.teEquation->insertPlainText(constantsName);
 }
 
-/* task class for parallel fill (not used) */
-class GenerateValueTask : public QRunnable {
-public:
-	GenerateValueTask(int startCol, int endCol, QVector<QVector<double>>& matrixData, double xStart, double yStart,
-		double xStep, double yStep, char* func): m_startCol(startCol), m_endCol(endCol), m_matrixData(matrixData),
-		m_xStart(xStart), m_yStart(yStart), m_xStep(xStep), m_yStep(yStep), m_func(func) {
-	};
-
-	void run() override {
-		const int rows = m_matrixData[m_startCol].size();
-		double x = m_xStart;
-		double y = m_yStart;
-		DEBUG("FILL col"<<m_startCol<<"-"<<m_endCol<<" x/y ="<<x<<'/'<<y<<" steps ="<<m_xStep<<'/'<<m_yStep<<" rows ="<<rows);
-
-		parser_var vars[] = { {"x", x}, {"y", y}};
-		SET_NUMBER_LOCALE
-		for (int col = m_startCol; col < m_endCol; ++col) {
-			vars[0].value = x;
-			for (int row = 0; row < rows; ++row) {
-				vars[1].value = y;
-				double z = parse_with_vars(m_func, vars, 2, qPrintable(numberLocale.name()));
-				//qDebug()<<" z ="<<z;
-				m_matrixData[col][row] = z;
-				y += m_yStep;
-			}
-
-			y = m_yStart;
-			x += m_xStep;
-		}
-	}
-
-private:
-	int m_startCol;
-	int m_endCol;
-	QVector<QVector<double>>& m_matrixData;
-	double m_xStart;
-	double m_yStart;
-	double m_xStep;
-	double m_yStep;
-	char* m_func;
-};
-
 void MatrixFunctionDialog::generate() {
 	WAIT_CURSOR;
 
@@ -206,40 +161,41 @@ void MatrixFunctionDialog::generate() {
 	timer.start();
 #endif
 
-	//TODO: too slow because every parser thread needs an own symbol_table
-	// idea: use pool->maxThreadCount() symbol tables and reuse them?
-/*	double yStart = m_matrix->yStart();
+	// The data is stored column by column, the function is evaluated for blocks of columns with at most
+	// maxChunkSize elements (at least one column) to limit the memory used for the variables.
+	// The first column and row take the values xStart() and yStart() of the matrix.
+	const int rows = m_matrix->rowCount();
 	const int cols = m_matrix->columnCount();
-	QThreadPool* pool = QThreadPool::globalInstance();
-	int range = ceil(double(cols)/pool->maxThreadCount());
-	DEBUG("Starting" << pool->maxThreadCount() << "threads. cols =" << cols << ": range =" << range);
-
-	for (int i = 0; i < pool->maxThreadCount(); ++i) {
-		const int start = i*range;
-		int end = (i+1)*range;
-		if (end > cols) end = cols;
-		qDebug() << "start/end: " << start << end;
-		const double xStart = m_matrix->xStart() + xStep*start;
-		GenerateValueTask* task = new GenerateValueTask(start, end, new_data, xStart, yStart, xStep, yStep,
-									qPrintable(ui.teEquation->toPlainText()));
-		task->setAutoDelete(false);
-		pool->start(task);
-	}
-	pool->waitForDone();
-*/
-	double x = 0, y = 0;
-	parser_var vars[] = {{"x", x}, {"y", y}};
-	SET_NUMBER_LOCALE
-	for (int col = 0; col < m_matrix->columnCount(); ++col) {
-		vars[0].value = x;
-		for (int row = 0; row < m_matrix->rowCount(); ++row) {
-			vars[1].value = y;
-			(new_data->operator[](col))[row] = parse_with_vars(qPrintable(ui.teEquation->toPlainText()),
-										vars, 2, qPrintable(numberLocale.name()));
-			y += yStep;
+	const qint64 maxChunkSize = 1 << 20;
+	const int chunkCols = (int)qBound<qint64>(1, maxChunkSize / qMax(rows, 1), cols);
+	const int chunkSize = chunkCols * rows;	// not larger than max(rows, maxChunkSize)
+
+	const QString expr = ui.teEquation->toPlainText();
+	const QStringList vars{QStringLiteral("x"), QStringLiteral("y")};
+	QVector<double> xVector(chunkSize), yVector(chunkSize), zVector(chunkSize);
+	for (int i = 0; i < chunkCols; ++i)
+		for (int row = 0; row < rows; ++row)
+			yVector[i * rows + row] = m_matrix->yStart() + yStep * row;
+
+	for (int startCol = 0; startCol < cols; startCol += chunkCols) {
+		const int count = qMin(chunkCols, cols - startCol);
+		if (count < chunkCols) {	// last block
+			xVector.resize(count * rows);
+			yVector.resize(count * rows);
+			zVector.resize(count * rows);
+		}
+		for (int i = 0; i < count; ++i) {
+			const double x = m_matrix->xStart() + xStep * (startCol + i);
+			std::fill(xVector.begin() + i * rows, xVector.begin() + (i + 1) * rows, x);
 		}
-		y = m_matrix->yStart();
-		x += xStep;
+
+		const bool rc = ExpressionParser::getInstance()->evaluateCartesian(expr, vars,
+									QVector<const QVector<double>*>{&xVector, &yVector}, &zVector);
+		if (!rc)	// parsing failed
+			zVector.fill(NAN);
+
+		for (int i = 0; i < count; ++i)
+			std::copy(zVector.constBegin() + i * rows, zVector.constBegin() + (i + 1) * rows, (*new_data)[startCol + i].begin());
 	}
 
 	// Timing
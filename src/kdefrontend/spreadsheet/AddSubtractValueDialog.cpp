@@ -388,13 +388,12 @@ void AddSubtractValueDialog::generateForColumns() {
 			//fall through
 		case Add:
 			for (auto* col : m_columns) {
-				auto* data = static_cast<QVector<QDateTime>* >(col->data());
-				//QDEBUG(Q_FUNC_INFO << ", DT OLD:" << data->operator[](0))
-				//QDEBUG(Q_FUNC_INFO << ", OLD VALUE:" << data->operator[](0).toMSecsSinceEpoch())
-				//QDEBUG(Q_FUNC_INFO << ", NEW VALUE:" << data->operator[](0).toMSecsSinceEpoch() + value)
-				//QDEBUG(Q_FUNC_INFO << ", DT NEW:" << QDateTime::fromMSecsSinceEpoch(data->operator[](0).toMSecsSinceEpoch() + value, timeSpec))
-				for (int i = 0; i < rows; ++i)
-					new_data[i] = QDateTime::fromMSecsSinceEpoch(data->operator[](i).toMSecsSinceEpoch() + value, data->operator[](i).timeSpec());
+				//QDEBUG(Q_FUNC_INFO << ", DT OLD:" << col->dateTimeAt(0))
+				//QDEBUG(Q_FUNC_INFO << ", DT NEW:" << col->dateTimeAt(0).addMSecs(value))
+				for (int i = 0; i < rows; ++i) {
+					const QDateTime& dateTime = col->dateTimeAt(i);
+					new_data[i] = dateTime.isValid() ? dateTime.addMSecs(value) : dateTime;
+				}
 
 				col->replaceDateTimes(0, new_data);
 			}
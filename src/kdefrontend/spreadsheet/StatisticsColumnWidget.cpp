@@ -249,7 +249,7 @@ void StatisticsColumnWidget::currentTabChanged(int index) {
 
 void StatisticsColumnWidget::showOverview() {
 	WAIT_CURSOR;
-	const Column::ColumnStatistics& statistics = m_column->statistics();
+	const Column::ColumnStatistics& statistics = m_column->statistics(true);
 
 	m_teOverview->setHtml(m_htmlText.arg(QString::number(statistics.size),
 									isNanValue(statistics.minimum == INFINITY ? NAN : statistics.minimum),
@@ -333,21 +333,28 @@ void StatisticsColumnWidget::showKDEPlot() {
 	QVector<double> data;
 	copyValidData(data);
 
-	//calculate 200 points to plot
-	int count = 200;
+	//calculate the density on 512 points, binned estimation with the costs O(n + count*log(count))
+	int count = 512;
 	QVector<double> xData;
 	QVector<double> yData;
 	xData.resize(count);
 	yData.resize(count);
 	double min = *std::min_element(data.constBegin(), data.constEnd());
 	double max = *std::max_element(data.constBegin(), data.constEnd());
-	double step = (max - min)/count;
 	int n = data.count();
 	double h = qMax(nsl_kde_normal_dist_bandwith(data.data(), n), 1e-6);
-	for (int i = 0; i < count; ++i) {
-		double x = min + i*step;
-		xData[i] = x;
-		yData[i] = nsl_kde(data.data(), x, h, n);
+	if (max > min) {
+		double step = (max - min)/(count - 1);
+		for (int i = 0; i < count; ++i)
+			xData[i] = min + i*step;
+		nsl_kde_binned(data.constData(), n, h, nsl_kde_kernel_gauss, min, max, count, yData.data());
+	} else {
+		//all values are equal, the density of a single point
+		count = 1;
+		xData.resize(count);
+		yData.resize(count);
+		xData[0] = min;
+		yData[0] = nsl_kde(data.constData(), min, h, n);
 	}
 
 	auto* xColumn = new Column("x");
@@ -574,11 +581,12 @@ QString StatisticsColumnWidget::modeValue(const Column* column, double value) co
  * into the vector \c data.
  */
 void StatisticsColumnWidget::copyValidData(QVector<double>& data) const {
+	const Column::DataPin pin(m_column);
 	const int rowCount = m_column->rowCount();
 	data.reserve(rowCount);
 	double val;
 	if (m_column->columnMode() == AbstractColumn::ColumnMode::Double) {
-		auto* rowValues = reinterpret_cast<QVector<double>*>(m_column->data());
+		const auto* rowValues = static_cast<const QVector<double>*>(m_column->constData());
 		for (int row = 0; row < rowCount; ++row) {
 			val = rowValues->value(row);
 			if (std::isnan(val) || m_column->isMasked(row))
@@ -587,7 +595,7 @@ void StatisticsColumnWidget::copyValidData(QVector<double>& data) const {
 			data.push_back(val);
 		}
 	} else if (m_column->columnMode() == AbstractColumn::ColumnMode::Integer) {
-		auto* rowValues = reinterpret_cast<QVector<int>*>(m_column->data());
+		const auto* rowValues = static_cast<const QVector<int>*>(m_column->constData());
 		for (int row = 0; row < rowCount; ++row) {
 			val = rowValues->value(row);
 			if (std::isnan(val) || m_column->isMasked(row))
@@ -596,7 +604,7 @@ void StatisticsColumnWidget::copyValidData(QVector<double>& data) const {
 			data.push_back(val);
 		}
 	} else if (m_column->columnMode() == AbstractColumn::ColumnMode::BigInt) {
-		auto* rowValues = reinterpret_cast<QVector<qint64>*>(m_column->data());
+		const auto* rowValues = static_cast<const QVector<qint64>*>(m_column->constData());
 		for (int row = 0; row < rowCount; ++row) {
 			val = rowValues->value(row);
 			if (std::isnan(val) || m_column->isMasked(row))
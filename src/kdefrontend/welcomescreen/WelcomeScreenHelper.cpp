@@ -10,6 +10,7 @@
 #include "WelcomeScreenHelper.h"
 #include "kdefrontend/DatasetModel.h"
 #include "kdefrontend/datasources/ImportDatasetWidget.h"
+#include "backend/core/BinaryProjectFile.h"
 #include "backend/datasources/DatasetHandler.h"
 
 #include <QBuffer>
@@ -181,8 +182,17 @@ QVariant WelcomeScreenHelper::getProjectThumbnail(const QUrl& url) {
 		filename = url.path();
 
 	QIODevice* file;
+	QByteArray xml;
+	// binary project files contain the XML with the thumbnail as a blob
+	if (BinaryProjectReader::isBinaryProject(filename)) {
+		BinaryProjectReader binaryReader;
+		if (!binaryReader.open(filename))
+			return QVariant();
+		xml = binaryReader.xml();
+		file = new QBuffer(&xml);
+	}
 	// first try gzip compression, because projects can be gzipped and end with .lml
-	if (filename.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive))
+	else if (filename.endsWith(QLatin1String(".lml"), Qt::CaseInsensitive))
 		file = new KCompressionDevice(filename,KFilterDev::compressionTypeForMimeType("application/x-gzip"));
 	else	// opens filename using file ending
 		file = new KFilterDev(filename);
@@ -93,9 +93,13 @@ QVector<QColor> ColorMapsManager::colors() const {
 	return m_colormap;
 }
 
-void ColorMapsManager::render(QPixmap& pixmap, const QString& name) {
+/*!
+ * \brief returns the colors of the color map \c name, the collections are loaded if not done yet
+ */
+QVector<QColor> ColorMapsManager::colorMap(const QString& name) {
+	QVector<QColor> colors;
 	if (name.isEmpty())
-		return;
+		return colors;
 
 	if (!m_colors.contains(name)) {
 		for (const auto& name : collectionNames())
@@ -103,15 +107,23 @@ void ColorMapsManager::render(QPixmap& pixmap, const QString& name) {
 	}
 
 	//convert from the string RGB represetation to QColor
-	m_colormap.clear();
 	for (auto& rgb : m_colors[name]) {
 		QStringList rgbValues = rgb.split(QLatin1Char(','));
 		if (rgbValues.count() == 3)
-			m_colormap << QColor(rgbValues.at(0).toInt(), rgbValues.at(1).toInt(), rgbValues.at(2).toInt());
+			colors << QColor(rgbValues.at(0).toInt(), rgbValues.at(1).toInt(), rgbValues.at(2).toInt());
 		else if (rgbValues.count() == 4)
-			m_colormap << QColor(rgbValues.at(1).toInt(), rgbValues.at(2).toInt(), rgbValues.at(3).toInt());
+			colors << QColor(rgbValues.at(1).toInt(), rgbValues.at(2).toInt(), rgbValues.at(3).toInt());
 	}
 
+	return colors;
+}
+
+void ColorMapsManager::render(QPixmap& pixmap, const QString& name) {
+	if (name.isEmpty())
+		return;
+
+	m_colormap = colorMap(name);
+
 	//render the preview pixmap
 	int height = 80;
 	int width = 200;
@@ -26,6 +26,7 @@ public:
 	QString collectionInfo(const QString& collectionName) const;
 	QStringList colorMapNames(const QString& collectionName);
 	QVector<QColor> colors() const;
+	QVector<QColor> colorMap(const QString& name);
 	void render(QPixmap&, const QString& name);
 
 private:
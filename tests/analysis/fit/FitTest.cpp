@@ -2888,5 +2888,58 @@ void FitTest::testHistogramFit() {
 	QCOMPARE(fitResult.rsquareAdj, 0.957504157605876);
 }
 
+//##############################################################################
+//#########################  fit in the background  ############################
+//##############################################################################
+// large data is fitted in a worker thread, a new fit cancels the running one
+void FitTest::testBackground() {
+	const int n = 200000;
+	QVector<double> xData(n), yData(n);
+	for (int i = 0; i < n; i++) {
+		xData[i] = i;
+		yData[i] = 2. * i + 1.;
+	}
+
+	//data source columns
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Double);
+	xDataColumn.replaceValues(0, xData);
+
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Double);
+	yDataColumn.replaceValues(0, yData);
+
+	XYFitCurve fitCurve("fit");
+	fitCurve.setXDataColumn(&xDataColumn);
+	fitCurve.setYDataColumn(&yDataColumn);
+
+	//prepare the fit
+	XYFitCurve::FitData fitData = fitCurve.fitData();
+	fitData.modelCategory = nsl_fit_model_custom;
+	XYFitCurve::initFitData(fitData);
+	fitData.model = "a*x + b";
+	fitData.paramNames << "a" << "b";
+	fitData.paramStartValues << 1. << 0.;
+	fitData.paramLowerLimits << -std::numeric_limits<double>::max() << -std::numeric_limits<double>::max();
+	fitData.paramUpperLimits << std::numeric_limits<double>::max() << std::numeric_limits<double>::max();
+	fitCurve.setFitData(fitData);
+
+	//perform the fit, the first fit is cancelled by the second one
+	fitCurve.recalculate();
+	QVERIFY(fitCurve.isCalculating());
+	fitCurve.recalculate();
+	QVERIFY(fitCurve.isCalculating());
+
+	QTRY_VERIFY_WITH_TIMEOUT(!fitCurve.isCalculating(), 60000);
+	const XYFitCurve::FitResult& fitResult = fitCurve.fitResult();
+
+	//check the results
+	QCOMPARE(fitResult.available, true);
+	QCOMPARE(fitResult.valid, true);
+	QCOMPARE(fitResult.paramValues.size(), 2);
+	FuzzyCompare(fitResult.paramValues.at(0), 2., 1.e-9);
+	FuzzyCompare(fitResult.paramValues.at(1), 1., 1.e-6);
+
+	//the fit function is evaluated when the fit is done
+	QCOMPARE(fitCurve.yColumn()->rowCount(), (int)fitData.evaluatedPoints);
+}
 
 QTEST_MAIN(FitTest)
@@ -74,5 +74,8 @@ private Q_SLOTS:
 
 	// histogram fit
 	void testHistogramFit();
+
+	// fit of large data in the background
+	void testBackground();
 };
 #endif
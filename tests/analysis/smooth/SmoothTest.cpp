@@ -64,4 +64,84 @@ void SmoothTest::testPercentile() {
 	}
 }
 
+// large data is smoothed in the background, the result is written when the calculation is done
+void SmoothTest::testBackground() {
+	const int n = 200000;
+	QVector<double> xData(n), yData(n);
+	for (int i = 0; i < n; i++) {
+		xData[i] = i;
+		yData[i] = 2. * i;
+	}
+
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Double);
+	xDataColumn.replaceValues(0, xData);
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Double);
+	yDataColumn.replaceValues(0, yData);
+
+	XYSmoothCurve smoothCurve("smooth");
+	smoothCurve.setXDataColumn(&xDataColumn);
+	smoothCurve.setYDataColumn(&yDataColumn);
+
+	XYSmoothCurve::SmoothData smoothData = smoothCurve.smoothData();
+	smoothData.type = nsl_smooth_type_moving_average;
+	smoothData.points = 5;
+	smoothData.weight = nsl_smooth_weight_uniform;
+	smoothCurve.setSmoothData(smoothData);
+
+	QTRY_VERIFY_WITH_TIMEOUT(!smoothCurve.isCalculating(), 10000);
+	const XYSmoothCurve::SmoothResult& smoothResult = smoothCurve.smoothResult();
+	QCOMPARE(smoothResult.available, true);
+	QCOMPARE(smoothResult.valid, true);
+
+	const auto* resultXDataColumn{smoothCurve.xColumn()};
+	const auto* resultYDataColumn{smoothCurve.yColumn()};
+	QCOMPARE(resultXDataColumn->rowCount(), n);
+	QCOMPARE(resultYDataColumn->rowCount(), n);
+
+	// the moving average of linear data doesn't change the interior points
+	for (int i = 2; i < n - 2; i += 1000) {
+		QCOMPARE(resultXDataColumn->valueAt(i), (double)i);
+		QCOMPARE(resultYDataColumn->valueAt(i), 2. * i);
+	}
+}
+
+// changing the source data restarts the running calculation with the new data
+void SmoothTest::testBackgroundSourceDataChanged() {
+	const int n = 200000;
+	QVector<double> xData(n), yData(n);
+	for (int i = 0; i < n; i++) {
+		xData[i] = i;
+		yData[i] = 2. * i;
+	}
+
+	Column xDataColumn("x", AbstractColumn::ColumnMode::Double);
+	xDataColumn.replaceValues(0, xData);
+	Column yDataColumn("y", AbstractColumn::ColumnMode::Double);
+	yDataColumn.replaceValues(0, yData);
+
+	XYSmoothCurve smoothCurve("smooth");
+	smoothCurve.setXDataColumn(&xDataColumn);
+	smoothCurve.setYDataColumn(&yDataColumn);
+
+	XYSmoothCurve::SmoothData smoothData = smoothCurve.smoothData();
+	smoothData.type = nsl_smooth_type_moving_average;
+	smoothData.points = 5;
+	smoothData.weight = nsl_smooth_weight_uniform;
+	smoothCurve.setSmoothData(smoothData);
+	QVERIFY(smoothCurve.isCalculating());
+
+	// change the data while the first calculation is running
+	for (int i = 0; i < n; i++)
+		yData[i] = 3. * i;
+	yDataColumn.replaceValues(0, yData);
+
+	QTRY_VERIFY_WITH_TIMEOUT(!smoothCurve.isCalculating(), 10000);
+	QCOMPARE(smoothCurve.smoothResult().valid, true);
+
+	const auto* resultYDataColumn{smoothCurve.yColumn()};
+	QCOMPARE(resultYDataColumn->rowCount(), n);
+	for (int i = 2; i < n - 2; i += 1000)
+		QCOMPARE(resultYDataColumn->valueAt(i), 3. * i);
+}
+
 QTEST_MAIN(SmoothTest)
@@ -17,6 +17,8 @@ class SmoothTest : public AnalysisTest {
 
 private Q_SLOTS:
 	void testPercentile();
+	void testBackground();
+	void testBackgroundSourceDataChanged();
 
 //	void testPerformance();
 };
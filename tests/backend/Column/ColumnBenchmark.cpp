@@ -0,0 +1,81 @@
+/*
+    File                 : ColumnBenchmark.cpp
+    Project              : LabPlot
+    Description          : Benchmarks for reading large columns and their extrema
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ColumnBenchmark.h"
+#include "backend/core/column/Column.h"
+
+#include <cmath>
+
+// reading 10M doubles row by row
+void ColumnBenchmark::testPerformanceValueAt() {
+	const int N = 1e7;
+	QVector<double> data(N);
+	for (int i = 0; i < N; i++)
+		data[i] = i/100.;
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues(data);
+	const AbstractColumn* column = &c;
+
+	double sum = 0.;
+	QBENCHMARK {
+		sum = 0.;
+		for (int row = 0; row < N; ++row) {
+			if (column->isValid(row) && !column->isMasked(row))
+				sum += column->valueAt(row);
+		}
+	}
+	QVERIFY(sum > 0.);
+}
+
+// reading 10M doubles with the batch accessor
+void ColumnBenchmark::testPerformanceValuesAt() {
+	const int N = 1e7;
+	QVector<double> data(N);
+	for (int i = 0; i < N; i++)
+		data[i] = i/100.;
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues(data);
+	const AbstractColumn* column = &c;
+
+	QVector<double> values(N);
+	QVector<bool> valid(N);
+	double sum = 0.;
+	QBENCHMARK {
+		column->valuesAt(0, N, values.data(), valid.data());
+		sum = 0.;
+		for (int row = 0; row < N; ++row) {
+			if (valid.at(row))
+				sum += values.at(row);
+		}
+	}
+	QVERIFY(sum > 0.);
+}
+
+// extrema of 1000 row ranges of 10M doubles
+void ColumnBenchmark::testPerformanceRangeExtrema() {
+	const int N = 1e7;
+	QVector<double> data(N);
+	for (int i = 0; i < N; i++)
+		data[i] = std::sin(i/100.);
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues(data);
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+
+	double min = 0., max = 0.;
+	QBENCHMARK {
+		for (int i = 0; i < 1000; ++i) {
+			min = c.minimum(i * 1000, N - i * 1000);
+			max = c.maximum(i * 1000, N - i * 1000);
+		}
+	}
+	QVERIFY(min < max);
+}
+
+QTEST_MAIN(ColumnBenchmark)
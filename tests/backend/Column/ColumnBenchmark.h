@@ -0,0 +1,24 @@
+/*
+    File                 : ColumnBenchmark.h
+    Project              : LabPlot
+    Description          : Benchmarks for reading large columns and their extrema
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef COLUMNBENCHMARK_H
+#define COLUMNBENCHMARK_H
+
+#include <QtTest>
+
+class ColumnBenchmark : public QObject {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testPerformanceValueAt();
+	void testPerformanceValuesAt();
+	void testPerformanceRangeExtrema();
+};
+
+#endif
@@ -9,12 +9,24 @@
 */
 
 #include "ColumnTest.h"
+#include "backend/core/BinaryProjectFile.h"
 #include "backend/core/Project.h"
 #include "backend/core/column/Column.h"
 #include "backend/core/column/ColumnPrivate.h"
+#include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/lib/trace.h"
+#include "backend/lib/UndoMemory.h"
 #include "backend/lib/XmlStreamReader.h"
 
+#include <QDir>
+#include <QFileInfo>
+#include <QPixmap>
+#include <QTemporaryFile>
+#include <QUndoStack>
+
+#include <atomic>
+#include <thread>
+
 void ColumnTest::doubleMinimum() {
 	Column c("Double column", Column::ColumnMode::Double);
 	c.setValues({-1.0, 2.0, 5.0});
@@ -114,6 +126,303 @@ void ColumnTest::bigIntMaximum() {
 	QCOMPARE(c.maximum(0, 2), 2);
 }
 
+void ColumnTest::doubleStatistics() {
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues({1.0, 2.0, 2.0, NAN, 3.0, 4.0, 7.0, 9.0});
+
+	const auto& statistics = c.statistics(true);
+	QCOMPARE(statistics.size, 7);
+	QCOMPARE(statistics.minimum, 1.0);
+	QCOMPARE(statistics.maximum, 9.0);
+	QCOMPARE(statistics.arithmeticMean, 4.0);
+	QCOMPARE(statistics.median, 3.0);
+	QCOMPARE(statistics.firstQuartile, 2.0);
+	QCOMPARE(statistics.thirdQuartile, 5.5);
+	QCOMPARE(statistics.iqr, 3.5);
+	QCOMPARE(statistics.mode, 2.0);
+	FuzzyCompare(statistics.variance, 52./6., 1.e-15);
+	FuzzyCompare(statistics.meanDeviation, 16./7., 1.e-15);
+	FuzzyCompare(statistics.meanDeviationAroundMedian, 15./7., 1.e-15);
+	QCOMPARE(statistics.medianDeviation, 1.0);
+	FuzzyCompare(statistics.entropy, -5./7. * log2(1./7.) - 2./7. * log2(2./7.), 1.e-15);
+
+	// multi-modal distribution
+	c.setValues({1.0, 1.0, 2.0, 2.0});
+	QVERIFY(std::isnan(c.statistics(true).mode));
+}
+
+void ColumnTest::integerStatistics() {
+	Column c("Integer column", Column::ColumnMode::Integer);
+	c.setIntegers({4, 1, 3, 2});
+
+	const auto& statistics = c.statistics();
+	QCOMPARE(statistics.size, 4);
+	QCOMPARE(statistics.minimum, 1.0);
+	QCOMPARE(statistics.maximum, 4.0);
+	QCOMPARE(statistics.arithmeticMean, 2.5);
+	QCOMPARE(statistics.median, 2.5);
+	QCOMPARE(statistics.percentile_1, 1.03);
+	QCOMPARE(statistics.skewness, 0.0);
+	QVERIFY(std::isnan(statistics.mode));	// only calculated for exact statistics
+	QVERIFY(std::isnan(statistics.entropy));
+
+	// multi-modal distribution
+	QVERIFY(std::isnan(c.statistics(true).mode));
+	QCOMPARE(c.statistics(true).entropy, 2.0);
+}
+
+/*!
+ * statistics of rows appended after the first calculation are updated incrementally
+ */
+void ColumnTest::statisticsAppendedRows() {
+	const int count = 100000;
+	QVector<double> data;
+	for (int i = 0; i < count; ++i)
+		data << (i * 7919) % count;	// 0 .. count - 1 shuffled
+
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues(data.mid(0, count / 2));
+	QCOMPARE(c.statistics().size, count / 2);
+
+	// append the second half of the data
+	c.insertRows(count / 2, count / 2);
+	auto* values = static_cast<QVector<double>*>(c.data());
+	for (int i = count / 2; i < count; ++i)
+		(*values)[i] = data.at(i);
+	c.setChanged(count / 2);
+
+	const auto statistics = c.statistics();
+	QCOMPARE(statistics.size, count);
+	QCOMPARE(statistics.minimum, 0.);
+	QCOMPARE(statistics.maximum, count - 1.);
+	FuzzyCompare(statistics.arithmeticMean, (count - 1) / 2., 1.e-12);
+	FuzzyCompare(statistics.variance, count * (count + 1.) / 12., 1.e-12);
+	// estimated quantiles
+	QVERIFY(std::abs(statistics.median - (count - 1) / 2.) < 0.01 * count);
+	QVERIFY(std::abs(statistics.percentile_90 - 0.9 * (count - 1)) < 0.01 * count);
+	QVERIFY(std::isnan(statistics.mode));	// only calculated for exact statistics
+
+	// exact statistics
+	const auto& exactStatistics = c.statistics(true);
+	QCOMPARE(exactStatistics.size, count);
+	QCOMPARE(exactStatistics.median, (count - 1) / 2.);
+	QVERIFY(std::isnan(exactStatistics.mode));
+	FuzzyCompare(exactStatistics.entropy, log2(count), 1.e-12);
+	FuzzyCompare(exactStatistics.variance, statistics.variance, 1.e-12);
+}
+
+void ColumnTest::maskedRows() {
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues({0., 1., 2., 3., 4., 5., 6., 7., 8., 9.});
+	c.setMasked(Interval<int>(6, 7));
+	c.setMasked(Interval<int>(1, 2));
+	c.setMasked(3);	// merged with [1, 2]
+
+	QCOMPARE(c.maskedIntervals().size(), 2);
+	QCOMPARE(c.isMasked(0), false);
+	QCOMPARE(c.isMasked(3), true);
+	QCOMPARE(c.isMasked(Interval<int>(1, 3)), true);
+	QCOMPARE(c.isMasked(Interval<int>(3, 4)), false);
+
+	QCOMPARE(c.nextMaskedRow(0), 1);
+	QCOMPARE(c.nextUnmaskedRow(1), 4);
+	QCOMPARE(c.nextMaskedRow(4), 6);
+	QCOMPARE(c.nextUnmaskedRow(5), 5);
+	QCOMPARE(c.nextMaskedRow(8), std::numeric_limits<int>::max());
+
+	// runs of rows unmasked in both columns
+	Column c2("Double column 2", Column::ColumnMode::Double);
+	c2.setValues({0., 1., 2., 3., 4., 5., 6., 7., 8., 9.});
+	c2.setMasked(Interval<int>(4, 5));
+	QCOMPARE(c.nextUnmaskedRow(1, &c2), 8);
+	QCOMPARE(c.nextMaskedRow(0, &c2), 1);
+
+	QCOMPARE(c.statistics().size, 5);
+	QCOMPARE(c.statistics().arithmeticMean, 26. / 5.);
+
+	// unmask a part of an interval
+	c.setMasked(2, false);
+	QCOMPARE(c.maskedIntervals().size(), 3);
+	QCOMPARE(c.isMasked(2), false);
+	QCOMPARE(c.nextUnmaskedRow(1), 2);
+	QCOMPARE(c.nextMaskedRow(2), 3);
+
+	// remove rows: the intervals are shifted and merged
+	c.removeRows(4, 2);
+	QCOMPARE(c.isMasked(Interval<int>(3, 5)), true);
+	QCOMPARE(c.maskedIntervals().size(), 2);
+
+	// masked till the end of the int range, no unmasked row is left
+	c.setMasked(Interval<int>(7, std::numeric_limits<int>::max()));
+	QCOMPARE(c.nextUnmaskedRow(8), std::numeric_limits<int>::max());
+	QCOMPARE(c.nextUnmaskedRow(std::numeric_limits<int>::max()), std::numeric_limits<int>::max());
+	QCOMPARE(c.nextUnmaskedRow(6), 6);
+}
+
+void ColumnTest::valuesAt() {
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues({1., NAN, 3., 4., 5.});
+	c.setMasked(3);
+
+	QVector<double> values(6);
+	QVector<bool> valid(6);
+	c.valuesAt(0, 6, values.data(), valid.data());
+	QCOMPARE(values.at(0), 1.);
+	QVERIFY(std::isnan(values.at(1)));
+	QCOMPARE(values.at(3), 4.);	// masked rows are read
+	QVERIFY(std::isnan(values.at(5)));	// not existing row
+	QCOMPARE(valid, QVector<bool>({true, false, true, false, true, false}));
+
+	// row range
+	c.valuesAt(2, 2, values.data(), valid.data());
+	QCOMPARE(values.at(0), 3.);
+	QCOMPARE(values.at(1), 4.);
+	QCOMPARE(valid.at(0), true);
+	QCOMPARE(valid.at(1), false);
+
+	Column ci("Integer column", Column::ColumnMode::Integer);
+	ci.setIntegers({1, 2});
+	ci.valuesAt(0, 2, values.data(), valid.data());
+	QCOMPARE(values.at(1), 2.);
+	QCOMPARE(valid.at(1), true);
+
+	Column cd("Datetime column", Column::ColumnMode::DateTime);
+	const auto dateTime = QDateTime::fromString("2017-03-26T02:14:34.000Z", Qt::DateFormat::ISODateWithMs);
+	cd.setDateTimes({dateTime, QDateTime()});
+	cd.valuesAt(0, 2, values.data(), valid.data());
+	QCOMPARE(values.at(0), (double)dateTime.toMSecsSinceEpoch());
+	QCOMPARE(valid.at(0), true);
+	QCOMPARE(valid.at(1), false);
+}
+
+// extrema of row ranges spanning several blocks of the min/max index
+void ColumnTest::rangeExtrema() {
+	const int N = 10000;
+	QVector<double> data(N);
+	for (int i = 0; i < N; ++i)
+		data[i] = std::sin(i * 0.01) * i;
+	data[5000] = NAN;
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues(data);
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+
+	// brute force extrema of the rows [first, last)
+	auto check = [&c](int first, int last) {
+		double min = qInf(), max = -qInf();
+		for (int row = first; row < qMin(last, c.rowCount()); ++row) {
+			if (!c.isValid(row) || c.isMasked(row))
+				continue;
+			min = qMin(min, c.valueAt(row));
+			max = qMax(max, c.valueAt(row));
+		}
+		QCOMPARE(c.minimum(first, last), min);
+		QCOMPARE(c.maximum(first, last), max);
+	};
+	auto checkRanges = [&check, &c]() {
+		check(0, c.rowCount());
+		check(1, c.rowCount() - 1);
+		check(100, 4096);
+		check(4000, 8300);
+		check(4096, 8192);
+		check(8191, 8193);
+	};
+	checkRanges();
+
+	// changes inside of blocks
+	c.setValueAt(6000, 1e6);
+	c.setValueAt(100, -1e6);
+	checkRanges();
+	c.replaceValues(4090, {-2e6, 2e6, 0., 0.});
+	checkRanges();
+	c.setValueAt(6000, 0.);
+	checkRanges();
+
+	// masked rows
+	c.setMasked(Interval<int>(4090, 4091));
+	checkRanges();
+	c.setMasked(4091, false);
+	checkRanges();
+
+	// appended, inserted and removed rows
+	c.setValueAt(N + 5000, 3e6);
+	checkRanges();
+	c.insertRows(10, 3000);
+	checkRanges();
+	c.removeRows(0, 5000);
+	checkRanges();
+
+	// direct changes reported with setChanged()
+	auto* vec = static_cast<QVector<double>*>(c.data());
+	(*vec)[9000] = -3e6;
+	c.setChanged(9000);
+	checkRanges();
+}
+
+// the min/max index is updated lazily, queries from several threads update it only once
+void ColumnTest::rangeExtremaConcurrent() {
+	const int N = 100000;
+	QVector<double> data(N);
+	for (int i = 0; i < N; ++i)
+		data[i] = i % 1000;
+	data[54321] = 5000.;
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues(data);
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+
+	std::atomic<int> errors{0};
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t) {
+		threads.emplace_back([&c, &errors, t]() {
+			for (int i = 0; i < 100; ++i) {
+				const int first = (t * 100 + i) * 10;
+				if (c.maximum(first, N - first) != 5000. || c.minimum(first, N - first) != 0.)
+					errors++;
+			}
+		});
+	}
+	for (auto& thread : threads)
+		thread.join();
+	QCOMPARE(errors.load(), 0);
+}
+
+// the extrema are already updated when dataChanged() is emitted after direct changes
+void ColumnTest::rangeExtremaSetChanged() {
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues({1., 2., 3.});
+	QCOMPARE(c.maximum(0, c.rowCount()), 3.);
+
+	double max = 0.;
+	connect(&c, &AbstractColumn::dataChanged, [&c, &max]() {
+		max = c.maximum(0, c.rowCount());
+	});
+
+	auto* vec = static_cast<QVector<double>*>(c.data());
+	(*vec)[1] = 10.;
+	c.setChanged();
+	QCOMPARE(max, 10.);
+}
+
+void ColumnTest::shiftRows() {
+	Column c("Double column", Column::ColumnMode::Double);
+	c.setValues({1., 2., 3., 4., 5.});
+	QCOMPARE(c.statistics().maximum, 5.);
+
+	c.shiftRows(2);
+	QCOMPARE(c.rowCount(), 5);
+	QCOMPARE(c.valueAt(0), 3.);
+	QCOMPARE(c.valueAt(2), 5.);
+	QCOMPARE(c.valueAt(4), 0.);
+	QCOMPARE(c.statistics().maximum, 5.);
+	QCOMPARE(c.statistics().minimum, 0.);
+
+	Column ct("Text column", Column::ColumnMode::Text);
+	ct.setTextAt(0, QLatin1String("a"));
+	ct.setTextAt(1, QLatin1String("b"));
+	ct.shiftRows(3);	// more rows than available
+	QCOMPARE(ct.rowCount(), 2);
+	QCOMPARE(ct.textAt(0), QString());
+}
+
 void ColumnTest::saveLoadDateTime() {
 	Column c("Datetime column", Column::ColumnMode::DateTime);
 	c.setDateTimes({QDateTime::fromString("2017-03-26T02:14:34.000Z", Qt::DateFormat::ISODateWithMs), // without the timezone declaration it would be invalid (in some regions), because of the daylight time
@@ -152,6 +461,454 @@ void ColumnTest::saveLoadDateTime() {
 	QCOMPARE(c2.dateTimeAt(3), QDateTime::fromString("2019-03-26T02:14:34.000Z", Qt::DateFormat::ISODateWithMs));
 }
 
+// save and load the columns of all modes in a binary project file
+void ColumnTest::saveLoadBinary() {
+	Project project;
+	auto* sheet = new Spreadsheet("test", false);
+	project.addChild(sheet);
+	sheet->setColumnCount(5);
+	sheet->setRowCount(10000);
+
+	auto* doubleColumn = sheet->column(0);
+	auto* intColumn = sheet->column(1);
+	intColumn->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	auto* bigIntColumn = sheet->column(2);
+	bigIntColumn->setColumnMode(AbstractColumn::ColumnMode::BigInt);
+	auto* textColumn = sheet->column(3);
+	textColumn->setColumnMode(AbstractColumn::ColumnMode::Text);
+	auto* dateTimeColumn = sheet->column(4);
+	dateTimeColumn->setColumnMode(AbstractColumn::ColumnMode::DateTime);
+
+	const auto dateTime = QDateTime::fromString("2017-03-26T02:14:34.000Z", Qt::DateFormat::ISODateWithMs);
+	QVector<double> doubles(10000);
+	QVector<int> integers(10000);
+	QVector<qint64> bigInts(10000);
+	QVector<QString> texts(10000);
+	QVector<QDateTime> dateTimes(10000);
+	for (int i = 0; i < 10000; ++i) {
+		doubles[i] = i % 10 ? i * 0.1 : NAN;
+		integers[i] = i % 7;	// compressible
+		bigInts[i] = (qint64)i << 33;
+		texts[i] = QStringLiteral("value ") + QString::number(i % 3);
+		if (i % 5)
+			dateTimes[i] = dateTime.addSecs(i);
+	}
+	texts[42] = QString::fromUtf8("ünicode");
+	doubleColumn->setValues(doubles);
+	intColumn->setIntegers(integers);
+	bigIntColumn->setBigInts(bigInts);
+	textColumn->setText(texts);
+	dateTimeColumn->setDateTimes(dateTimes);
+	doubleColumn->setMasked(5);
+
+	QTemporaryFile file(QDir::tempPath() + QLatin1String("/labplot_XXXXXX.lmlb"));
+	QVERIFY(file.open());
+	QVERIFY(project.saveBinary(QPixmap(), &file));
+	file.close();
+	QVERIFY(Project::isLabPlotProject(file.fileName()));
+
+	Project project2;
+	QVERIFY(project2.load(file.fileName()));
+	auto* sheet2 = project2.child<Spreadsheet>(0);
+	QVERIFY(sheet2 != nullptr);
+	QCOMPARE(sheet2->columnCount(), 5);
+	QCOMPARE(sheet2->rowCount(), 10000);
+
+	auto* doubleColumn2 = sheet2->column(0);
+	QCOMPARE(doubleColumn2->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(doubleColumn2->isMasked(5), true);
+	QVERIFY(std::isnan(doubleColumn2->valueAt(0)));
+	QCOMPARE(doubleColumn2->valueAt(9999), 999.9);
+	QCOMPARE(*static_cast<QVector<int>*>(sheet2->column(1)->data()), integers);
+	QCOMPARE(*static_cast<QVector<qint64>*>(sheet2->column(2)->data()), bigInts);
+	QCOMPARE(*static_cast<QVector<QString>*>(sheet2->column(3)->data()), texts);
+
+	auto* dateTimeColumn2 = sheet2->column(4);
+	QCOMPARE(dateTimeColumn2->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(dateTimeColumn2->dateTimeAt(0).isValid(), false);
+	QCOMPARE(dateTimeColumn2->dateTimeAt(1), dateTime.addSecs(1));
+	QCOMPARE(dateTimeColumn2->dateTimeAt(9999), dateTime.addSecs(9999));
+}
+
+// the data of the columns in binary project files is read on the first access
+void ColumnTest::loadBinaryLazy() {
+	Project project;
+	auto* sheet = new Spreadsheet("test", false);
+	project.addChild(sheet);
+	sheet->setColumnCount(2);
+	sheet->setRowCount(1000);
+	sheet->column(1)->setColumnMode(AbstractColumn::ColumnMode::Text);
+	for (int i = 0; i < 1000; ++i) {
+		sheet->column(0)->setValueAt(i, i * 0.5);
+		sheet->column(1)->setTextAt(i, QString::number(i % 10));
+	}
+
+	QTemporaryFile file(QDir::tempPath() + QLatin1String("/labplot_XXXXXX.lmlb"));
+	QVERIFY(file.open());
+	QVERIFY(project.saveBinary(QPixmap(), &file));
+	file.close();
+
+	Project project2;
+	QVERIFY(project2.load(file.fileName()));
+	auto* sheet2 = project2.child<Spreadsheet>(0);
+	auto* doubleColumn = sheet2->column(0);
+	auto* textColumn = sheet2->column(1);
+	QCOMPARE(doubleColumn->isDataLoaded(), false);
+	QCOMPARE(doubleColumn->rowCount(), 1000);
+	QCOMPARE(textColumn->isDataLoaded(), false);
+	QCOMPARE(textColumn->rowCount(), 1000);
+
+	QCOMPARE(doubleColumn->valueAt(999), 499.5);
+	QCOMPARE(doubleColumn->isDataLoaded(), true);
+	QCOMPARE(textColumn->isDataLoaded(), false);
+
+	// masking rows doesn't change the data, the column is not read
+	textColumn->setMasked(0);
+	QCOMPARE(textColumn->isDataLoaded(), false);
+
+	// modified columns are saved with the new data, unchanged columns are copied from the file without reading them
+	doubleColumn->setValueAt(0, -1.);
+	QTemporaryFile file2(QDir::tempPath() + QLatin1String("/labplot_XXXXXX.lmlb"));
+	QVERIFY(file2.open());
+	QVERIFY(project2.saveBinary(QPixmap(), &file2));
+	file2.close();
+	QCOMPARE(textColumn->isDataLoaded(), false);
+
+	Project project3;
+	QVERIFY(project3.load(file2.fileName()));
+	auto* sheet3 = project3.child<Spreadsheet>(0);
+	QCOMPARE(sheet3->column(0)->valueAt(0), -1.);
+	QCOMPARE(sheet3->column(0)->valueAt(1), 0.5);
+	QCOMPARE(sheet3->column(1)->textAt(42), QLatin1String("2"));
+
+	// the variable columns of a formula are read without detaching them from the file
+	sheet3->setColumnCount(3);
+	auto* formulaColumn = sheet3->column(2);
+	formulaColumn->setFormula(QStringLiteral("2*x"), {QStringLiteral("x")}, {sheet3->column(0)}, false);
+	formulaColumn->updateFormula();
+	QCOMPARE(formulaColumn->valueAt(1), 1.);
+
+	// the data of the columns loaded first is unloaded if the memory budget is exceeded and read again on the next access
+	Column::setLoadedDataBudget(1);
+	QCOMPARE(textColumn->textAt(13), QLatin1String("3"));
+	QTRY_VERIFY(!sheet3->column(0)->isDataLoaded());
+	QCOMPARE(textColumn->isDataLoaded(), true);
+	QCOMPARE(doubleColumn->isDataLoaded(), true);	// modified
+	QCOMPARE(sheet3->column(0)->valueAt(1), 0.5);
+
+	// a pinned column is not unloaded
+	{
+		const Column::DataPin pin(sheet3->column(1));
+		const auto* texts = static_cast<const QVector<QString>*>(sheet3->column(1)->constData());
+		QTRY_VERIFY(!sheet3->column(0)->isDataLoaded());
+		QCOMPARE(sheet3->column(0)->valueAt(1), 0.5);
+		QTest::qWait(100);
+		QCOMPARE(sheet3->column(1)->isDataLoaded(), true);
+		QCOMPARE(texts->at(42), QLatin1String("2"));
+	}
+	QTRY_VERIFY(!sheet3->column(1)->isDataLoaded());
+	Column::setLoadedDataBudget(0);
+}
+
+// only the changed columns are appended to the binary project file, the file is compacted if it contains too much unused data
+void ColumnTest::saveBinaryIncremental() {
+	Project project;
+	auto* sheet = new Spreadsheet("test", false);
+	project.addChild(sheet);
+	sheet->setColumnCount(2);
+	sheet->setRowCount(100000);
+	QVector<double> values(100000);
+	for (int i = 0; i < 100000; ++i)
+		values[i] = sin(i);
+	sheet->column(0)->setValues(values);
+	sheet->column(1)->setValues(values);
+
+	QTemporaryFile file(QDir::tempPath() + QLatin1String("/labplot_XXXXXX.lmlb"));
+	QVERIFY(file.open());
+	QVERIFY(project.saveBinary(QPixmap(), &file));
+	file.close();
+	project.setFileName(file.fileName());
+	QVERIFY(project.attachBinaryFile(file.fileName()));
+
+	// the unchanged second column is not written again
+	sheet->column(0)->setValueAt(0, 42.);
+	const qint64 size = QFileInfo(file.fileName()).size();
+	QVERIFY(project.saveBinaryIncremental(QPixmap()));
+	const qint64 appended = QFileInfo(file.fileName()).size() - size;
+	QVERIFY(appended > 0);
+	QVERIFY(appended < size / 2 + 10000);
+
+	Project project2;
+	QVERIFY(project2.load(file.fileName()));
+	auto* sheet2 = project2.child<Spreadsheet>(0);
+	QCOMPARE(sheet2->column(0)->valueAt(0), 42.);
+	QCOMPARE(sheet2->column(0)->valueAt(99999), sin(99999));
+	QCOMPARE(sheet2->column(1)->valueAt(0), 0.);
+	QCOMPARE(sheet2->column(1)->valueAt(99999), sin(99999));
+
+	// changing both columns again and again increases the unused part of the file until it has to be compacted
+	bool compact = false;
+	for (int i = 1; i < 5 && !compact; ++i) {
+		sheet->column(0)->setValueAt(0, i);
+		sheet->column(1)->setValueAt(0, i);
+		compact = !project.saveBinaryIncremental(QPixmap());
+	}
+	QVERIFY(compact);
+
+	QTemporaryFile file2(QDir::tempPath() + QLatin1String("/labplot_XXXXXX.lmlb"));
+	QVERIFY(file2.open());
+	QVERIFY(project.saveBinary(QPixmap(), &file2));
+	file2.close();
+	project.setFileName(file2.fileName());
+	QVERIFY(project.attachBinaryFile(file2.fileName()));
+	QVERIFY(QFileInfo(file2.fileName()).size() < size + 10000);
+	QVERIFY(project.saveBinaryIncremental(QPixmap()));
+
+	Project project3;
+	QVERIFY(project3.load(file2.fileName()));
+	QCOMPARE(project3.child<Spreadsheet>(0)->column(1)->valueAt(0), sheet->column(1)->valueAt(0));
+}
+
+void ColumnTest::undoChangedBlocks() {
+	Project project;
+	auto* c = new Column("Double column", Column::ColumnMode::Double);
+	project.addChild(c);
+
+	const int N = 10000;
+	QVector<double> values(N);
+	for (int i = 0; i < N; i++)
+		values[i] = i;
+	c->replaceValues(-1, values);
+
+	// replace all rows, only one row is changed
+	values[9000] = -1.;
+	c->replaceValues(0, values);
+	QCOMPARE(c->valueAt(9000), -1.);
+
+	// only the changed block of old values is kept besides the new values
+	auto* stack = project.undoStack();
+	const qint64 size = UndoMemory::memorySize(stack->command(stack->index() - 1));
+	QVERIFY(size > N * (qint64)sizeof(double));
+	QVERIFY(size < 2 * N * (qint64)sizeof(double));
+
+	stack->undo();
+	QCOMPARE(c->valueAt(9000), 9000.);
+	QCOMPARE(c->valueAt(0), 0.);
+	QCOMPARE(c->valueAt(N - 1), N - 1.);
+	stack->redo();
+	QCOMPARE(c->valueAt(9000), -1.);
+}
+
+void ColumnTest::undoMemoryBudget() {
+	Project project;
+	auto* c = new Column("Double column", Column::ColumnMode::Double);
+	project.addChild(c);
+
+	const int N = 10000;
+	const qint64 budget = 3 * N * sizeof(double);
+	project.setUndoMemoryBudget(budget);
+
+	// every replacement keeps the old values
+	QVector<double> values(N);
+	for (int k = 0; k < 5; k++) {
+		values.fill(k);
+		c->replaceValues(-1, values);
+	}
+	QVERIFY(project.undoMemorySize() <= budget);
+
+	// the oldest replacements are released and can't be undone anymore
+	auto* stack = project.undoStack();
+	const int count = stack->count();
+	stack->undo();
+	QCOMPARE(c->valueAt(0), 3.);
+	QVERIFY(project.canUndo());
+	while (project.canUndo())
+		stack->undo();
+	// undoing is blocked at the released commands
+	QCOMPARE(project.undoLimitIndex(), count - 3);
+	QCOMPARE(stack->index(), count - 3);
+	QCOMPARE(c->valueAt(0), 1.);
+	QCOMPARE(project.child<Column>(0), c);
+
+	// the budget applies to this project only
+	Project otherProject;
+	QVERIFY(otherProject.undoMemorySize() == 0);
+	auto* other = new Column("Double column", Column::ColumnMode::Double);
+	otherProject.addChild(other);
+	for (int k = 0; k < 5; k++) {
+		values.fill(k);
+		other->replaceValues(-1, values);
+	}
+	QVERIFY(otherProject.undoMemorySize() > budget);
+	QVERIFY(project.undoMemorySize() <= budget);
+}
+
+// dictionary encoded texts behave like the expanded texts
+void ColumnTest::dictionaryEncoding() {
+	Column c("Text column", Column::ColumnMode::Text);
+	const Column::DataPin pin(&c);
+	QVector<QString> texts(100);
+	for (int i = 0; i < 100; ++i)
+		texts[i] = (i % 4 == 3) ? QString() : QStringLiteral("category ") + QString::number(i % 4);
+	texts[10] = QLatin1String("");
+	c.setText(texts);
+
+	QVERIFY(!c.isDictionaryEncoded());
+	QVERIFY(c.encodeDictionary(true));
+	QVERIFY(c.isDictionaryEncoded());
+	QCOMPARE(c.rowCount(), 100);
+	// the dictionary is sorted and contains the empty string but not the null string
+	QCOMPARE(c.dictionary(), (QVector<QString>{QString(""), QStringLiteral("category 0"), QStringLiteral("category 1"), QStringLiteral("category 2")}));
+	QCOMPARE(c.dictionaryCodes().at(3), -1);
+	for (int i = 0; i < 100; ++i) {
+		QCOMPARE(c.textAt(i), texts.at(i));
+		QCOMPARE(c.textAt(i).isNull(), texts.at(i).isNull());
+	}
+	QCOMPARE(c.isValid(3), false);
+	QCOMPARE(c.isValid(10), true);
+
+	// values of the dictionary keep the encoding
+	c.setTextAt(0, QStringLiteral("category 2"));
+	QVERIFY(c.isDictionaryEncoded());
+	QCOMPARE(c.textAt(0), QStringLiteral("category 2"));
+
+	c.insertRows(1, 2);
+	c.removeRows(50, 10);
+	QVERIFY(c.isDictionaryEncoded());
+	QCOMPARE(c.rowCount(), 92);
+	QCOMPARE(c.textAt(1).isNull(), true);
+	QCOMPARE(c.textAt(3), texts.at(1));
+	QCOMPARE(c.textAt(50), texts.at(58));
+
+	// new values expand the texts
+	c.setTextAt(4, QStringLiteral("new"));
+	QVERIFY(!c.isDictionaryEncoded());
+	QCOMPARE(c.textAt(4), QStringLiteral("new"));
+	QCOMPARE(c.textAt(5), texts.at(3));
+	QCOMPARE(c.textAt(5).isNull(), true);
+	QCOMPARE(c.textAt(91), texts.at(99));
+
+	// too many distinct values for the encoding on import
+	c.setText({QStringLiteral("a"), QStringLiteral("b"), QStringLiteral("c")});
+	QVERIFY(!c.encodeDictionary(true));
+	QVERIFY(c.encodeDictionary());
+	QCOMPARE(c.dictionary().size(), 3);
+}
+
+// save and load the dictionary encoded texts in XML
+void ColumnTest::saveLoadDictionary() {
+	Column c("Text column", Column::ColumnMode::Text);
+	QVector<QString> texts(1000);
+	for (int i = 0; i < 1000; ++i)
+		texts[i] = (i % 7) ? QString::fromUtf8("wert <ü> ") + QString::number(i % 5) : QString();
+	c.setText(texts);
+	QVERIFY(c.encodeDictionary(true));
+
+	QByteArray array;
+	QXmlStreamWriter writer(&array);
+	c.save(&writer);
+
+	Column c2("Text 2 column", Column::ColumnMode::Text);
+	XmlStreamReader reader(array);
+	bool found = false;
+	while (!reader.atEnd()) {
+		reader.readNext();
+		if (reader.isStartElement() && reader.name() == "column") {
+			found = true;
+			break;
+		}
+	}
+	QCOMPARE(found, true);
+	QCOMPARE(c2.load(&reader, false), true);
+
+	const Column::DataPin pin(&c);
+	const Column::DataPin pin2(&c2);
+	QVERIFY(c2.isDictionaryEncoded());
+	QCOMPARE(c2.rowCount(), 1000);
+	QCOMPARE(c2.dictionary(), c.dictionary());
+	for (int i = 0; i < 1000; ++i) {
+		QCOMPARE(c2.textAt(i), texts.at(i));
+		QCOMPARE(c2.textAt(i).isNull(), texts.at(i).isNull());
+	}
+}
+
+// texts with invalid offsets or codes are rejected when decoding
+void ColumnTest::decodeCorruptedTexts() {
+	const QByteArray data = BinaryProjectWriter::encodeTexts({QStringLiteral("a"), QString(), QStringLiteral("bc"), QStringLiteral("a")});
+	QVector<QString> texts;
+	QVERIFY(BinaryProjectReader::decodeTexts(data, texts));
+	QCOMPARE(texts.size(), 4);
+	QCOMPARE(texts.at(2), QStringLiteral("bc"));
+
+	// rows, values, codes and offsets as 32 bit integers followed by the UTF-8 data
+	qint32 rows, values;
+	memcpy(&rows, data.constData(), sizeof(qint32));
+	memcpy(&values, data.constData() + sizeof(qint32), sizeof(qint32));
+	const int offsetsStart = (2 + rows) * (int)sizeof(qint32);
+	const int codesStart = 2 * (int)sizeof(qint32);
+	auto corrupted = [&data](int position, qint32 value) {
+		QByteArray result = data;
+		memcpy(result.data() + position, &value, sizeof(qint32));
+		return result;
+	};
+
+	QVERIFY(!BinaryProjectReader::decodeTexts(corrupted(offsetsStart, -1), texts));	// negative first offset
+	QVERIFY(!BinaryProjectReader::decodeTexts(corrupted(offsetsStart + (int)sizeof(qint32), 100), texts));	// decreasing offsets
+	QVERIFY(!BinaryProjectReader::decodeTexts(corrupted(offsetsStart + values * (int)sizeof(qint32), 100), texts));	// beyond the end
+	QVERIFY(!BinaryProjectReader::decodeTexts(corrupted(codesStart, values), texts));	// invalid code
+	QVERIFY(!BinaryProjectReader::decodeTexts(corrupted(0, std::numeric_limits<qint32>::max()), texts));	// overflowing sizes
+	QVERIFY(!BinaryProjectReader::decodeTexts(data.left(data.size() - 1), texts));	// truncated
+}
+
+// sorting with the dictionary codes gives the same order as sorting the texts
+void ColumnTest::sortDictionary() {
+	Project project;
+	auto* sheet = new Spreadsheet("test", false);
+	project.addChild(sheet);
+	sheet->setColumnCount(3);
+	sheet->setRowCount(200);
+
+	QVector<QString> texts(200);
+	QVector<int> integers(200);
+	for (int i = 0; i < 200; ++i) {
+		texts[i] = (i % 9) ? QStringLiteral("v") + QString::number((i * 7) % 13) : QString();
+		integers[i] = i;
+	}
+	auto* encoded = sheet->column(0);
+	encoded->setColumnMode(AbstractColumn::ColumnMode::Text);
+	encoded->setText(texts);
+	auto* plain = sheet->column(1);
+	plain->setColumnMode(AbstractColumn::ColumnMode::Text);
+	plain->setText(texts);
+	auto* rows = sheet->column(2);
+	rows->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	rows->setIntegers(integers);
+	QVERIFY(encoded->encodeDictionary(true));
+
+	for (bool ascending : {true, false}) {
+		sheet->sortColumns(nullptr, {encoded, plain}, ascending);
+		QVERIFY(encoded->isDictionaryEncoded());
+		for (int i = 0; i < 200; ++i)
+			QCOMPARE(encoded->textAt(i), plain->textAt(i));
+	}
+
+	// the order of the other columns is the order of the leading column
+	sheet->setColumnCount(4);
+	auto* copy = sheet->column(3);
+	copy->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	copy->setIntegers(integers);
+	encoded->setText(texts);
+	QVERIFY(encoded->encodeDictionary(true));
+	plain->setText(texts);
+	sheet->sortColumns(encoded, {encoded, rows}, false);
+	sheet->sortColumns(plain, {plain, copy}, false);
+	QVERIFY(encoded->isDictionaryEncoded());
+	for (int i = 0; i < 200; ++i) {
+		QCOMPARE(encoded->textAt(i), plain->textAt(i));
+		QCOMPARE(rows->integerAt(i), copy->integerAt(i));
+	}
+}
+
 void ColumnTest::loadDoubleFromProject() {
 	Project project;
 	project.load(QFINDTESTDATA(QLatin1String("data/Load.lml")));
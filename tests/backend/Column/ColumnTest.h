@@ -29,8 +29,25 @@ private Q_SLOTS:
 	void integerMaximum();
 	void bigIntMinimum();
 	void bigIntMaximum();
+	void doubleStatistics();
+	void integerStatistics();
+	void statisticsAppendedRows();
+	void maskedRows();
+	void valuesAt();
+	void rangeExtrema();
+	void rangeExtremaConcurrent();
+	void rangeExtremaSetChanged();
+	void shiftRows();
 	void saveLoadDateTime();
-
+	void saveLoadBinary();
+	void loadBinaryLazy();
+	void saveBinaryIncremental();
+	void undoChangedBlocks();
+	void undoMemoryBudget();
+	void dictionaryEncoding();
+	void saveLoadDictionary();
+	void decodeCorruptedTexts();
+	void sortDictionary();
 };
 
 #endif // COLUMNTEST_H
@@ -0,0 +1,117 @@
+/*
+    File                 : DateTimeParserTest.cpp
+    Project              : LabPlot
+    Description          : Tests for DateTimeParser
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "DateTimeParserTest.h"
+#include "backend/lib/DateTimeParser.h"
+
+#include <QDateTime>
+
+//**********************************************************
+//****************** Function tests ************************
+//**********************************************************
+
+void DateTimeParserTest::testFormats() {
+	// the results must be the same as for QDateTime::fromString() in local time
+	const QVector<QPair<QString, QString>> values{
+		{QStringLiteral("yyyy-MM-dd hh:mm:ss.zzz"), QStringLiteral("2022-03-14 15:09:26.535")},
+		{QStringLiteral("yyyy-MM-dd hh:mm:ss.zzz"), QStringLiteral("1969-12-31 23:59:59.999")},
+		{QStringLiteral("yyyy-MM-ddThh:mm:ss"), QStringLiteral("2020-02-29T00:00:00")},
+		{QStringLiteral("dd.MM.yyyy"), QStringLiteral("01.07.1990")},
+		{QStringLiteral("d/M/yyyy h:m"), QStringLiteral("5/11/2010 7:3")},
+		{QStringLiteral("d/M/yyyy h:m"), QStringLiteral("25/12/2010 17:30")},
+		{QStringLiteral("yyyy'year' MM"), QStringLiteral("1999year 12")},
+		{QStringLiteral("yyyy-MM-dd hh:mm AP"), QStringLiteral("2021-06-01 12:15 AM")},
+		{QStringLiteral("yyyy-MM-dd hh:mm AP"), QStringLiteral("2021-06-01 01:15 PM")},
+	};
+
+	for (const auto& value : values) {
+		DateTimeParser parser(value.first);
+		QVERIFY(parser.isValid());
+		qint64 msecs;
+		QVERIFY(parser.parse(value.second, msecs));
+		const QDateTime dateTime = QDateTime::fromString(value.second, value.first);
+		QVERIFY(dateTime.isValid());
+		QCOMPARE(msecs, dateTime.toMSecsSinceEpoch());
+	}
+
+	// missing year is 2000, two digit years smaller than 50 are 20XX
+	DateTimeParser parser(QStringLiteral("dd.MM. hh:mm"));
+	qint64 msecs;
+	QVERIFY(parser.parse(QStringLiteral("29.02. 12:00"), msecs));
+	QCOMPARE(msecs, QDateTime(QDate(2000, 2, 29), QTime(12, 0)).toMSecsSinceEpoch());
+
+	parser.setFormat(QStringLiteral("dd.MM.yy"));
+	QVERIFY(parser.parse(QStringLiteral("01.01.49"), msecs));
+	QCOMPARE(msecs, QDateTime(QDate(2049, 1, 1), QTime(0, 0)).toMSecsSinceEpoch());
+	QVERIFY(parser.parse(QStringLiteral("01.01.50"), msecs));
+	QCOMPARE(msecs, QDateTime(QDate(1950, 1, 1), QTime(0, 0)).toMSecsSinceEpoch());
+}
+
+void DateTimeParserTest::testTimeZone() {
+	DateTimeParser parser(QStringLiteral("yyyy-MM-dd hh:mm:sst"));
+	qint64 msecs;
+
+	QVERIFY(parser.parse(QStringLiteral("2022-01-01 00:00:00Z"), msecs));
+	QCOMPARE(msecs, QDateTime(QDate(2022, 1, 1), QTime(0, 0), Qt::UTC).toMSecsSinceEpoch());
+
+	QVERIFY(parser.parse(QStringLiteral("2022-01-01 00:00:00UTC"), msecs));
+	QCOMPARE(msecs, QDateTime(QDate(2022, 1, 1), QTime(0, 0), Qt::UTC).toMSecsSinceEpoch());
+
+	QVERIFY(parser.parse(QStringLiteral("2022-01-01 00:00:00+01:30"), msecs));
+	QCOMPARE(msecs, QDateTime(QDate(2022, 1, 1), QTime(0, 0), Qt::OffsetFromUTC, 5400).toMSecsSinceEpoch());
+
+	QVERIFY(parser.parse(QStringLiteral("2022-01-01 00:00:00-0200"), msecs));
+	QCOMPARE(msecs, QDateTime(QDate(2022, 1, 1), QTime(0, 0), Qt::OffsetFromUTC, -7200).toMSecsSinceEpoch());
+}
+
+void DateTimeParserTest::testInvalid() {
+	DateTimeParser parser(QStringLiteral("yyyy-MM-dd hh:mm:ss"));
+	qint64 msecs;
+
+	QVERIFY(!parser.parse(QString(), msecs));
+	QVERIFY(!parser.parse(QStringLiteral("2021-02-29 00:00:00"), msecs));
+	QVERIFY(!parser.parse(QStringLiteral("2021-13-01 00:00:00"), msecs));
+	QVERIFY(!parser.parse(QStringLiteral("2021-01-01 24:00:00"), msecs));
+	QVERIFY(!parser.parse(QStringLiteral("2021-01-01 00:00"), msecs));
+	QVERIFY(!parser.parse(QStringLiteral("2021-01-01 00:00:00 "), msecs));
+	QVERIFY(!parser.parse(QStringLiteral("2021/01/01 00:00:00"), msecs));
+}
+
+void DateTimeParserTest::testUnsupportedFormats() {
+	// names of months and days depend on the locale
+	QVERIFY(!DateTimeParser(QStringLiteral("dd MMM yyyy")).isValid());
+	QVERIFY(!DateTimeParser(QStringLiteral("dddd, dd.MM.yyyy")).isValid());
+	QVERIFY(!DateTimeParser(QStringLiteral("hh:mm:ss.z")).isValid());
+	QVERIFY(!DateTimeParser(QString()).isValid());
+	QVERIFY(DateTimeParser(QStringLiteral("hh:mm:ss.zzz")).isValid());
+}
+
+//**********************************************************
+//****************** Performance tests *********************
+//**********************************************************
+
+void DateTimeParserTest::testPerformance() {
+	const QString format = QStringLiteral("yyyy-MM-dd hh:mm:ss.zzz");
+	const QDateTime start(QDate(2022, 1, 1), QTime(0, 0));
+	const int count = 100000;
+	QVector<QByteArray> strings(count);
+	for (int i = 0; i < count; ++i)
+		strings[i] = start.addMSecs(i * 1234567LL).toString(format).toUtf8();
+
+	DateTimeParser parser(format);
+	QBENCHMARK {
+		for (const auto& string : strings) {
+			qint64 msecs;
+			parser.parse(string.constData(), string.constData() + string.size(), msecs);
+		}
+	}
+}
+
+QTEST_MAIN(DateTimeParserTest)
@@ -0,0 +1,28 @@
+/*
+    File                 : DateTimeParserTest.h
+    Project              : LabPlot
+    Description          : Tests for DateTimeParser
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef DATETIMEPARSERTEST_H
+#define DATETIMEPARSERTEST_H
+
+#include "../../CommonTest.h"
+
+class DateTimeParserTest : public CommonTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testFormats();
+	void testTimeZone();
+	void testInvalid();
+	void testUnsupportedFormats();
+
+	void testPerformance();
+};
+
+#endif
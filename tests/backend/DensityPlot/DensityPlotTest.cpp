@@ -0,0 +1,266 @@
+/*
+    File                 : DensityPlotTest.cpp
+    Project              : LabPlot
+    Description          : Tests for DensityPlot
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "DensityPlotTest.h"
+#include "backend/core/column/Column.h"
+#include "backend/worksheet/plots/cartesian/DensityPlot.h"
+#include "backend/worksheet/plots/cartesian/DensityPlotPrivate.h"
+
+#include <random>
+
+// grid of 4 x 2 pixels for [0, 4] x [0, 2]
+static DensityPlotPrivate::AggregationData smallGrid(const Column& x, const Column& y) {
+	DensityPlotPrivate::AggregationData data;
+	data.xColumn = &x;
+	data.yColumn = &y;
+	data.xRange = Range<double>(0., 4.);
+	data.yRange = Range<double>(0., 2.);
+	data.width = 4;
+	data.height = 2;
+	return data;
+}
+
+// compares the aggregated or scaled values, NAN for pixels without points
+void DensityPlotTest::compareGrids(const QVector<double>& grid, const QVector<double>& expected) {
+	QCOMPARE(grid.size(), expected.size());
+	for (int i = 0; i < grid.size(); ++i) {
+		if (std::isnan(expected.at(i)))
+			QVERIFY(std::isnan(grid.at(i)));
+		else
+			FuzzyCompare(grid.at(i), expected.at(i));
+	}
+}
+
+//**********************************************************
+//****************** Function tests ************************
+//**********************************************************
+
+void DensityPlotTest::testAggregateCount() {
+	Column x("x", Column::ColumnMode::Double);
+	Column y("y", Column::ColumnMode::Double);
+	x.replaceValues(0, {0.5, 0.5, 1.5, 3.5, 5., NAN, 4.});
+	y.replaceValues(0, {0.5, 0.5, 1.5, 0.5, 1., 1., 2.});
+
+	// row 0 of the grid is at the top, points outside of the ranges and invalid points are ignored
+	const auto& grid = DensityPlotPrivate::aggregate(smallGrid(x, y));
+	compareGrids(grid, {NAN, 1., NAN, 1., 2., NAN, NAN, 1.});
+
+	// incomplete data
+	auto data = smallGrid(x, y);
+	data.yColumn = nullptr;
+	QVERIFY(DensityPlotPrivate::aggregate(data).isEmpty());
+	data = smallGrid(x, y);
+	data.aggregation = DensityPlot::Aggregation::Mean;
+	QVERIFY(DensityPlotPrivate::aggregate(data).isEmpty());
+}
+
+void DensityPlotTest::testAggregateSumMean() {
+	Column x("x", Column::ColumnMode::Double);
+	Column y("y", Column::ColumnMode::Double);
+	Column values("values", Column::ColumnMode::Double);
+	x.replaceValues(0, {0.5, 0.5, 1.5, 3.5, 4., 2.5});
+	y.replaceValues(0, {0.5, 0.5, 1.5, 0.5, 2., 0.5});
+	values.replaceValues(0, {1., 2., 3., 4., 7., NAN});
+
+	auto data = smallGrid(x, y);
+	data.valuesColumn = &values;
+
+	// points with invalid values are ignored
+	data.aggregation = DensityPlot::Aggregation::Sum;
+	compareGrids(DensityPlotPrivate::aggregate(data), {NAN, 3., NAN, 7., 3., NAN, NAN, 4.});
+
+	data.aggregation = DensityPlot::Aggregation::Mean;
+	compareGrids(DensityPlotPrivate::aggregate(data), {NAN, 3., NAN, 7., 1.5, NAN, NAN, 4.});
+}
+
+void DensityPlotTest::testAggregateMasked() {
+	Column x("x", Column::ColumnMode::Double);
+	Column y("y", Column::ColumnMode::Double);
+	x.replaceValues(0, {0.5, 0.5, 1.5, 3.5});
+	y.replaceValues(0, {0.5, 0.5, 1.5, 0.5});
+	x.setMasked(0);
+	y.setMasked(Interval<int>(2, 3));
+
+	compareGrids(DensityPlotPrivate::aggregate(smallGrid(x, y)), {NAN, NAN, NAN, NAN, 1., NAN, NAN, NAN});
+}
+
+void DensityPlotTest::testAggregateLogScale() {
+	Column x("x", Column::ColumnMode::Double);
+	Column y("y", Column::ColumnMode::Double);
+	x.replaceValues(0, {2., 20., 200., 0., -1.});
+	y.replaceValues(0, {0.5, 0.5, 0.5, 0.5, 0.5});
+
+	DensityPlotPrivate::AggregationData data;
+	data.xColumn = &x;
+	data.yColumn = &y;
+	data.xRange = Range<double>(1., 1000., RangeT::Format::Numeric, RangeT::Scale::Log10);
+	data.yRange = Range<double>(0., 1.);
+	data.width = 3;
+	data.height = 1;
+
+	// the pixels are equidistant on the log scale, values not defined on the scale are ignored
+	compareGrids(DensityPlotPrivate::aggregate(data), {1., 1., 1.});
+}
+
+void DensityPlotTest::testAggregateParallel() {
+	// enough rows to aggregate in chunks
+	const int count = 1000000;
+	std::mt19937 generator(1);
+	std::normal_distribution<double> distribution(50., 20.);
+	QVector<double> xValues(count), yValues(count), values(count);
+	for (int i = 0; i < count; ++i) {
+		xValues[i] = distribution(generator);
+		yValues[i] = distribution(generator);
+		values[i] = distribution(generator);
+	}
+
+	Column x("x", Column::ColumnMode::Double);
+	Column y("y", Column::ColumnMode::Double);
+	Column v("values", Column::ColumnMode::Double);
+	x.replaceValues(0, xValues);
+	y.replaceValues(0, yValues);
+	v.replaceValues(0, values);
+
+	DensityPlotPrivate::AggregationData data;
+	data.xColumn = &x;
+	data.yColumn = &y;
+	data.valuesColumn = &v;
+	data.xRange = Range<double>(0., 100.);
+	data.yRange = Range<double>(0., 100.);
+	data.width = 200;
+	data.height = 100;
+
+	// reference aggregated serially
+	QVector<double> counts(data.width * data.height, 0.), sums(data.width * data.height, 0.);
+	for (int i = 0; i < count; ++i) {
+		const double px = (xValues.at(i) - 0.) * (data.width / 100.);
+		const double py = (yValues.at(i) - 0.) * (data.height / 100.);
+		if (!(px >= 0. && px <= data.width) || !(py >= 0. && py <= data.height))
+			continue;
+		const int column = qMin((int)px, data.width - 1);
+		const int row = data.height - 1 - qMin((int)py, data.height - 1);
+		counts[row * data.width + column] += 1.;
+		sums[row * data.width + column] += values.at(i);
+	}
+
+	QVector<double> expectedCounts(counts.size()), expectedMeans(counts.size());
+	for (int i = 0; i < counts.size(); ++i) {
+		expectedCounts[i] = counts.at(i) > 0. ? counts.at(i) : NAN;
+		expectedMeans[i] = counts.at(i) > 0. ? sums.at(i) / counts.at(i) : NAN;
+	}
+
+	data.aggregation = DensityPlot::Aggregation::Count;
+	compareGrids(DensityPlotPrivate::aggregate(data), expectedCounts);
+
+	// the order of the summation depends on the chunks
+	data.aggregation = DensityPlot::Aggregation::Mean;
+	const auto& means = DensityPlotPrivate::aggregate(data);
+	QCOMPARE(means.size(), expectedMeans.size());
+	for (int i = 0; i < means.size(); ++i) {
+		if (std::isnan(expectedMeans.at(i)))
+			QVERIFY(std::isnan(means.at(i)));
+		else
+			FuzzyCompare(means.at(i), expectedMeans.at(i), 1.e-9);
+	}
+}
+
+void DensityPlotTest::testScaling() {
+	const QVector<double> grid{NAN, 1., 2., 4.};
+
+	compareGrids(DensityPlotPrivate::scale(grid, DensityPlot::Scaling::Linear), {NAN, 0., 1./3., 1.});
+	compareGrids(DensityPlotPrivate::scale(grid, DensityPlot::Scaling::Log), {NAN, 0., 0.5, 1.});
+	compareGrids(DensityPlotPrivate::scale(grid, DensityPlot::Scaling::HistogramEqualization), {NAN, 0., 0.5, 1.});
+
+	// values below 1 on the log scale
+	compareGrids(DensityPlotPrivate::scale({-1., 0., NAN}, DensityPlot::Scaling::Log), {0., 1., NAN});
+
+	// histogram equalization depends on the order of the values only
+	compareGrids(DensityPlotPrivate::scale({1., 1., 100., 1000., 1000.}, DensityPlot::Scaling::HistogramEqualization),
+			{0., 0., 1./3., 1., 1.});
+
+	// constant values
+	compareGrids(DensityPlotPrivate::scale({5., NAN, 5.}, DensityPlot::Scaling::Linear), {1., NAN, 1.});
+
+	// no data
+	compareGrids(DensityPlotPrivate::scale({NAN, NAN}, DensityPlot::Scaling::Log), {NAN, NAN});
+}
+
+void DensityPlotTest::testRender() {
+	const QVector<QColor> colorMap{Qt::red, Qt::blue};
+	const QImage image = DensityPlotPrivate::render({NAN, 1., 3., 2.}, 2, 2, DensityPlot::Scaling::Linear, colorMap);
+
+	QCOMPARE(image.size(), QSize(2, 2));
+	QCOMPARE(qAlpha(image.pixel(0, 0)), 0);	// pixels without points are transparent
+	QCOMPARE(image.pixel(1, 0), qRgb(255, 0, 0));
+	QCOMPARE(image.pixel(0, 1), qRgb(0, 0, 255));
+
+	// interpolated between the colors of the color map
+	const QRgb middle = image.pixel(1, 1);
+	QCOMPARE(qAlpha(middle), 255);
+	QVERIFY(qAbs(qRed(middle) - 128) <= 1);
+	QCOMPARE(qGreen(middle), 0);
+	QVERIFY(qAbs(qBlue(middle) - 128) <= 1);
+}
+
+// the mean of a pixel is the mean of all its points, independent of the size of the grid
+void DensityPlotTest::testAggregateMeanWeighted() {
+	Column x("x", Column::ColumnMode::Double);
+	Column y("y", Column::ColumnMode::Double);
+	Column values("values", Column::ColumnMode::Double);
+	x.replaceValues(0, {0.5, 1.5, 1.5, 1.5});
+	y.replaceValues(0, {0.5, 0.5, 0.5, 0.5});
+	values.replaceValues(0, {0., 4., 4., 4.});
+
+	auto data = smallGrid(x, y);
+	data.valuesColumn = &values;
+	data.aggregation = DensityPlot::Aggregation::Mean;
+	compareGrids(DensityPlotPrivate::aggregate(data), {NAN, NAN, NAN, NAN, 0., 4., NAN, NAN});
+
+	// one pixel for all points
+	data.width = 1;
+	data.height = 1;
+	compareGrids(DensityPlotPrivate::aggregate(data), {3.});
+}
+
+//**********************************************************
+//***************** Performance tests **********************
+//**********************************************************
+
+void DensityPlotTest::testPerformanceAggregate() {
+	// 10M points on 1000 x 1000 pixel
+	const int count = 10000000;
+	std::mt19937 generator(1);
+	std::normal_distribution<double> distribution;
+	QVector<double> xValues(count), yValues(count);
+	for (int i = 0; i < count; ++i) {
+		xValues[i] = distribution(generator);
+		yValues[i] = distribution(generator);
+	}
+
+	Column x("x", Column::ColumnMode::Double);
+	Column y("y", Column::ColumnMode::Double);
+	x.replaceValues(0, xValues);
+	y.replaceValues(0, yValues);
+
+	DensityPlotPrivate::AggregationData data;
+	data.xColumn = &x;
+	data.yColumn = &y;
+	data.xRange = Range<double>(-5., 5.);
+	data.yRange = Range<double>(-5., 5.);
+	data.width = 1000;
+	data.height = 1000;
+
+	QBENCHMARK {
+		const auto& grid = DensityPlotPrivate::aggregate(data);
+		QCOMPARE(grid.size(), 1000 * 1000);
+	}
+}
+
+QTEST_MAIN(DensityPlotTest)
@@ -0,0 +1,36 @@
+/*
+    File                 : DensityPlotTest.h
+    Project              : LabPlot
+    Description          : Tests for DensityPlot
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef DENSITYPLOTTEST_H
+#define DENSITYPLOTTEST_H
+
+#include "../../CommonTest.h"
+
+class DensityPlotTest : public CommonTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testAggregateCount();
+	void testAggregateSumMean();
+	void testAggregateMasked();
+	void testAggregateLogScale();
+	void testAggregateParallel();
+
+	void testScaling();
+	void testRender();
+	void testAggregateMeanWeighted();
+
+	void testPerformanceAggregate();
+
+private:
+	static void compareGrids(const QVector<double>& grid, const QVector<double>& expected);
+};
+
+#endif
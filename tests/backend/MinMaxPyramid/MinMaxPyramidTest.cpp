@@ -0,0 +1,180 @@
+/*
+    File                 : MinMaxPyramidTest.cpp
+    Project              : LabPlot
+    Description          : Tests for MinMaxPyramid
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "MinMaxPyramidTest.h"
+#include "backend/lib/MinMaxPyramid.h"
+
+#include <QHash>
+
+#include <cmath>
+#include <random>
+
+static QVector<QPointF> randomPoints(int count, unsigned int seed = 1) {
+	std::mt19937 generator(seed);
+	std::normal_distribution<double> distribution;
+	QVector<QPointF> points(count);
+	for (int i = 0; i < count; ++i)
+		points[i] = QPointF(i, distribution(generator));
+
+	return points;
+}
+
+//**********************************************************
+//****************** Function tests ************************
+//**********************************************************
+
+void MinMaxPyramidTest::testIndices() {
+	// y = 0, 1, 2, ..., 31 with one peak and one dip in the second group
+	QVector<QPointF> points;
+	for (int i = 0; i < 32; ++i)
+		points << QPointF(i, i);
+	points[10].setY(100.);
+	points[13].setY(-100.);
+
+	MinMaxPyramid pyramid;
+	pyramid.update(points);
+	QCOMPARE(pyramid.size(), 32);
+
+	// too few points per group: no decimation
+	QVERIFY(pyramid.indices(0, 31, 4).isEmpty());
+
+	// groups of 8 points: first, minimum, maximum and last of every group
+	QCOMPARE(pyramid.indices(0, 31, 8), QVector<int>({0, 7, 8, 10, 13, 15, 16, 23, 24, 31}));
+
+	// groups of 16 points
+	QCOMPARE(pyramid.indices(0, 31, 20), QVector<int>({0, 10, 13, 15, 16, 31}));
+
+	// the points outside of the complete groups are used as they are
+	QCOMPARE(pyramid.indices(6, 25, 8), QVector<int>({6, 7, 8, 10, 13, 15, 16, 23, 24, 25}));
+}
+
+/*!
+ * the extrema of any range have to be part of the indices
+ */
+void MinMaxPyramidTest::testExtrema() {
+	const int count = 10000;
+	const auto points = randomPoints(count);
+	MinMaxPyramid pyramid;
+	pyramid.update(points);
+
+	std::mt19937 generator(2);
+	for (int test = 0; test < 1000; ++test) {
+		int first = generator() % count, last = generator() % count;
+		if (first > last)
+			std::swap(first, last);
+		const int pointsPerGroup = generator() % 500;
+		const auto indices = pyramid.indices(first, last, pointsPerGroup);
+		if (indices.isEmpty())
+			continue;
+
+		QCOMPARE(indices.constFirst(), first);
+		QCOMPARE(indices.constLast(), last);
+		QVERIFY(std::is_sorted(indices.constBegin(), indices.constEnd()));
+		QVERIFY(indices.size() <= 8 * (last - first + 1) / pointsPerGroup + 2 * pointsPerGroup + 4);
+
+		int minIndex = first, maxIndex = first;
+		for (int i = first; i <= last; ++i) {
+			if (points.at(i).y() < points.at(minIndex).y())
+				minIndex = i;
+			if (points.at(i).y() > points.at(maxIndex).y())
+				maxIndex = i;
+		}
+		QVERIFY(indices.contains(minIndex));
+		QVERIFY(indices.contains(maxIndex));
+	}
+}
+
+/*!
+ * updating with appended and changed points gives the same result as building the pyramid for all points
+ */
+void MinMaxPyramidTest::testUpdate() {
+	auto points = randomPoints(5000);
+	MinMaxPyramid pyramid;
+	pyramid.update(points.mid(0, 1234));
+
+	const auto other = randomPoints(5000, 2);
+	for (int i = 1000; i < 1234; ++i)
+		points[i] = other.at(i);
+	pyramid.update(points, 1000);
+
+	MinMaxPyramid reference;
+	reference.update(points);
+	QCOMPARE(pyramid.size(), reference.size());
+	for (int pointsPerGroup : {8, 16, 50, 100, 1000, 4096})
+		QCOMPARE(pyramid.indices(0, points.size() - 1, pointsPerGroup), reference.indices(0, points.size() - 1, pointsPerGroup));
+
+	// remove points
+	points.resize(3000);
+	pyramid.update(points, 3000);
+	reference.update(points);
+	QCOMPARE(pyramid.indices(10, 2990, 64), reference.indices(10, 2990, 64));
+}
+
+/*!
+ * for irregularly spaced points, the extrema of the points on every pixel have to be part of the indices
+ */
+void MinMaxPyramidTest::testNonUniformX() {
+	// many points on the first pixels, few points on the last pixels
+	const int count = 100000;
+	auto points = randomPoints(count);
+	for (int i = 0; i < count; ++i)
+		points[i].setX(std::pow((double)i / count, 4) * 1000.);
+
+	MinMaxPyramid pyramid;
+	pyramid.update(points);
+	auto pixel = [&points](int index) { return (int)points.at(index).x(); };
+	auto singlePixel = [&pixel](int first, int last) { return pixel(first) == pixel(last); };
+
+	// the average number of points per pixel is 100
+	const auto indices = pyramid.indices(0, count - 1, count / 1000, singlePixel);
+	QVERIFY(!indices.isEmpty());
+	QVERIFY(indices.size() < count / 4);
+	QVERIFY(std::is_sorted(indices.constBegin(), indices.constEnd()));
+
+	QHash<int, int> minIndex, maxIndex;	// extrema of every pixel
+	for (int i = 0; i < count; ++i) {
+		const int p = pixel(i);
+		if (!minIndex.contains(p) || points.at(i).y() < points.at(minIndex.value(p)).y())
+			minIndex[p] = i;
+		if (!maxIndex.contains(p) || points.at(i).y() > points.at(maxIndex.value(p)).y())
+			maxIndex[p] = i;
+	}
+	for (int index : minIndex)
+		QVERIFY(indices.contains(index));
+	for (int index : maxIndex)
+		QVERIFY(indices.contains(index));
+}
+
+//**********************************************************
+//********************* Performance ************************
+//**********************************************************
+
+void MinMaxPyramidTest::testPerformanceUpdate() {
+	const auto points = randomPoints(10000000);
+	MinMaxPyramid pyramid;
+
+	QBENCHMARK {
+		pyramid.update(points);
+	}
+}
+
+void MinMaxPyramidTest::testPerformanceIndices() {
+	const auto points = randomPoints(10000000);
+	MinMaxPyramid pyramid;
+	pyramid.update(points);
+
+	// 10M points on 1000 pixel
+	QBENCHMARK {
+		const auto indices = pyramid.indices(0, points.size() - 1, points.size() / 1000);
+		QVERIFY(indices.size() <= 8000);
+	}
+}
+
+QTEST_MAIN(MinMaxPyramidTest)
@@ -0,0 +1,29 @@
+/*
+    File                 : MinMaxPyramidTest.h
+    Project              : LabPlot
+    Description          : Tests for MinMaxPyramid
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef MINMAXPYRAMIDTEST_H
+#define MINMAXPYRAMIDTEST_H
+
+#include "../../CommonTest.h"
+
+class MinMaxPyramidTest : public CommonTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testIndices();
+	void testExtrema();
+	void testUpdate();
+	void testNonUniformX();
+
+	void testPerformanceUpdate();
+	void testPerformanceIndices();
+};
+
+#endif
@@ -0,0 +1,30 @@
+/*
+    File                 : ParserBenchmark.cpp
+    Project              : LabPlot
+    Description          : Benchmarks for evaluating expressions on large data
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ParserBenchmark.h"
+#include "backend/gsl/ExpressionParser.h"
+
+#include <algorithm>
+
+// evaluation of 1e7 rows in parallel chunks
+void ParserBenchmark::testPerformanceParallel() {
+	const int N = 1e7;
+	QVector<double> alpha(N), result(N);
+	for (int i = 0; i < N; i++)
+		alpha[i] = i/100.;
+
+	QBENCHMARK {
+		ExpressionParser::getInstance()->evaluateCartesian(QStringLiteral("sin(x)^2 + cos(x)^2"), &alpha, &result);
+	}
+
+	QVERIFY(std::all_of(result.constBegin(), result.constEnd(), [](double value) { return qFuzzyCompare(value, 1.); }));
+}
+
+QTEST_MAIN(ParserBenchmark)
@@ -0,0 +1,22 @@
+/*
+    File                 : ParserBenchmark.h
+    Project              : LabPlot
+    Description          : Benchmarks for evaluating expressions on large data
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef PARSERBENCHMARK_H
+#define PARSERBENCHMARK_H
+
+#include <QtTest>
+
+class ParserBenchmark : public QObject {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testPerformanceParallel();
+};
+
+#endif
@@ -9,6 +9,9 @@
 */
 
 #include "ParserTest.h"
+#include "backend/gsl/ExpressionParser.h"
+
+#include <future>
 
 extern "C" {
 #include "backend/gsl/parser.h"
@@ -49,7 +52,7 @@ void ParserTest::testErrors() {
 
 	const QVector<QString> testsNan{
 		"", "a", "1+", "a+1", "&", "%", "+", "*", "/", "{1}", "{1*2}", "(1+1))", "a/0", "0/0", "1/0 + a",
-		"sqrt(-1)", "log(-1)", "log(0)", "asin(2)"
+		"1%0", "sqrt(-1)", "log(-1)", "log(0)", "asin(2)"
 	};
 
 	for ( auto& expr: testsNan)
@@ -103,6 +106,114 @@ void ParserTest::testLocale() {
 #endif
 }
 
+void ParserTest::testCompile() {
+	gsl_set_error_handler_off();
+
+	const QVector<QString> tests{
+		"x", "x+1", "2*x-3*y", "x/y", "x%3", "-x", "|x-5|", "x^2", "x**2", "3!", "(x+y)*(x-y)", "pi*x",
+		"sin(x)^2 + cos(x)^2", "pow(x, 2)", "pow(x; 2)", "exp(-x/y)", "1/x + 1/0",
+		"2%x", "x%(y-y)"
+	};
+
+	const int N = 1000;	// more than one block
+	QVector<double> x(N), y(N), result(N);
+	for (int i = 0; i < N; i++) {
+		x[i] = i/10.;
+		y[i] = i + 1.;
+	}
+	const char* names[] = {"x", "y"};
+	const double* data[] = {x.constData(), y.constData()};
+
+	for (auto& expr: tests) {
+		parser_prog* prog = compile_with_vars(qPrintable(expr), names, 2, "C");
+		QVERIFY(prog != nullptr);
+		QCOMPARE(eval_prog(prog, data, result.data(), N), 0);
+		free_prog(prog);
+
+		for (int i = 0; i < N; i++) {
+			const parser_var vars[] = { {"x", x.at(i)}, {"y", y.at(i)} };
+			const double value = parse_with_vars(qPrintable(expr), vars, 2, "C");
+			if (std::isnan(value))
+				QVERIFY(std::isnan(result.at(i)));
+			else
+				QCOMPARE(result.at(i), value);
+		}
+	}
+
+	// parse errors
+	QVERIFY(compile_with_vars("1+", names, 2, "C") == nullptr);
+	QVERIFY(compile_with_vars("x+z", names, 2, "C") == nullptr);
+	// assignments are not compiled
+	QVERIFY(compile_with_vars("y=2*x", names, 2, "C") == nullptr);
+}
+
+void ParserTest::testContext() {
+	parser_context* context = create_context();
+	QVERIFY(context != nullptr);
+
+	// symbols of a context are not visible in other contexts
+	context_assign_symbol(context, "ctxvar", 2.);
+	QCOMPARE(context_parse(context, "ctxvar*pi", "C"), 2.*M_PI);
+	QCOMPARE(context_parse_errors(context), 0);
+	QVERIFY(qIsNaN(parse("ctxvar*pi", "C")));
+	QVERIFY(parse_errors() > 0);
+
+	QVERIFY(qIsNaN(context_parse(context, "1+", "C")));
+	QVERIFY(context_parse_errors(context) > 0);
+
+	context_assign_symbol(context, "ctxvar", 0.);
+	QCOMPARE(context_remove_symbol(context, "ctxvar"), 0);
+	QVERIFY(qIsNaN(context_parse(context, "ctxvar", "C")));
+
+	// a reset context only contains the functions and constants
+	context_assign_symbol(context, "ctxvar", 2.);
+	context_assign_symbol(context, "pi", 3.);
+	reset_context(context);
+	QVERIFY(qIsNaN(context_parse(context, "ctxvar", "C")));
+	QCOMPARE(context_parse(context, "cos(pi)", "C"), -1.);
+	QCOMPARE(context_parse_errors(context), 0);
+
+	free_context(context);
+}
+
+void ParserTest::testParallel() {
+	// parse in several threads, each with its own context
+	auto task = []() {
+		parser_context* context = create_context();
+		int errors = 0;
+		for (int i = 0; i < 10000; i++) {
+			context_assign_symbol(context, "x", i);
+			if (context_parse(context, "2*x + 1", "C") != 2.*i + 1.)
+				errors++;
+		}
+		free_context(context);
+		return errors;
+	};
+
+	std::vector<std::future<int>> futures;
+	for (int i = 0; i < 8; i++)
+		futures.push_back(std::async(std::launch::async, task));
+	for (auto& future : futures)
+		QCOMPARE(future.get(), 0);
+
+	// evaluation of large data is split into chunks
+	const int N = 1e6;
+	QVector<double> x(N), y(N);
+	for (int i = 0; i < N; i++)
+		x[i] = i;
+	QVERIFY(ExpressionParser::getInstance()->evaluateCartesian(QStringLiteral("2*x + a"), &x, &y, {QStringLiteral("a")}, {1.}));
+	for (int i = 0; i < N; i++)
+		QCOMPARE(y.at(i), 2.*i + 1.);
+
+	// the parameters of the last evaluation are not kept in the reused contexts
+	QVERIFY(!ExpressionParser::getInstance()->evaluateCartesian(QStringLiteral("2*x + a"), &x, &y));
+
+	// random functions are evaluated in one thread
+	QVERIFY(ExpressionParser::getInstance()->evaluateCartesian(QStringLiteral("x + rand()"), &x, &y));
+	for (int i = 0; i < N; i++)
+		QVERIFY(y.at(i) >= i);
+}
+
 ///////////// Performance ////////////////////////////////
 // see https://github.com/ArashPartow/math-parser-benchmark-project
 
@@ -129,4 +240,42 @@ void ParserTest::testPerformance2() {
 	}
 }
 
+// same as testPerformance1() and testPerformance2() but with compiled expressions
+
+void ParserTest::testPerformanceCompiled1() {
+	const int N = 1e5;
+	QVector<double> x(N), result(N);
+	for (int i = 0; i < N; i++)
+		x[i] = i/100.;
+	const char* names[] = {"x"};
+	const double* data[] = {x.constData()};
+
+	QBENCHMARK {
+		parser_prog* prog = compile_with_vars("x+1.", names, 1, "C");
+		eval_prog(prog, data, result.data(), N);
+		free_prog(prog);
+	}
+
+	for (int i = 0; i < N; i++)
+		QCOMPARE(result.at(i), x.at(i) + 1.);
+}
+
+void ParserTest::testPerformanceCompiled2() {
+	const int N = 1e5;
+	QVector<double> alpha(N), result(N);
+	for (int i = 0; i < N; i++)
+		alpha[i] = i/100.;
+	const char* names[] = {"alpha"};
+	const double* data[] = {alpha.constData()};
+
+	QBENCHMARK {
+		parser_prog* prog = compile_with_vars("sin(alpha)^2 + cos(alpha)^2", names, 1, "C");
+		eval_prog(prog, data, result.data(), N);
+		free_prog(prog);
+	}
+
+	for (int i = 0; i < N; i++)
+		QCOMPARE(result.at(i), 1.);
+}
+
 QTEST_MAIN(ParserTest)
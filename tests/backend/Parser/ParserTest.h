@@ -21,9 +21,14 @@ private Q_SLOTS:
 	void testErrors();
 	void testVariables();
 	void testLocale();
+	void testCompile();
+	void testContext();
+	void testParallel();
 
 	void testPerformance1();
 	void testPerformance2();
+	void testPerformanceCompiled1();
+	void testPerformanceCompiled2();
 
 };
 
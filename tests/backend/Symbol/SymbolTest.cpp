@@ -0,0 +1,167 @@
+/*
+    File                 : SymbolTest.cpp
+    Project              : LabPlot
+    Description          : Tests for drawing symbols
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "SymbolTest.h"
+#include "backend/worksheet/plots/cartesian/Symbol.h"
+
+#include <QPainter>
+#include <QPicture>
+
+#include <random>
+
+static QVector<QPointF> randomPoints(int count, double size, unsigned int seed = 1) {
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> distribution(0, (int)size);
+	QVector<QPointF> points(count);
+	for (int i = 0; i < count; ++i)
+		points[i] = QPointF(distribution(generator), distribution(generator));
+
+	return points;
+}
+
+static QPainterPath symbolPath(Symbol::Style style, double size) {
+	QTransform trafo;
+	trafo.scale(size, size);
+	return trafo.map(Symbol::stylePath(style));
+}
+
+// draws the symbols on a raster image (stamped sprites) or on a picture (paths) rendered to an image
+static QImage drawSymbols(const QPainterPath& path, const QVector<QPointF>& points, const QPen& pen, const QBrush& brush,
+		qreal opacity = 1., bool raster = true, qreal scale = 1.) {
+	QImage image(200, 200, QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+	QPicture picture;
+	QPainter painter;
+	if (raster)
+		painter.begin(&image);
+	else
+		painter.begin(&picture);
+	painter.setRenderHint(QPainter::Antialiasing, true);
+	painter.scale(scale, scale);
+	painter.setPen(pen);
+	painter.setBrush(brush);
+	painter.setOpacity(opacity);
+	Symbol::draw(&painter, path, points);
+	painter.end();
+
+	if (!raster) {
+		QPainter p(&image);
+		p.drawPicture(0, 0, picture);
+	}
+	return image;
+}
+
+// fraction of the pixels differing more than 'tolerance' in any channel
+static double difference(const QImage& image1, const QImage& image2, int tolerance = 16) {
+	int count = 0;
+	for (int y = 0; y < image1.height(); ++y) {
+		for (int x = 0; x < image1.width(); ++x) {
+			const QRgb p1 = image1.pixel(x, y);
+			const QRgb p2 = image2.pixel(x, y);
+			if (qAbs(qRed(p1) - qRed(p2)) > tolerance || qAbs(qGreen(p1) - qGreen(p2)) > tolerance
+					|| qAbs(qBlue(p1) - qBlue(p2)) > tolerance || qAbs(qAlpha(p1) - qAlpha(p2)) > tolerance)
+				++count;
+		}
+	}
+
+	return (double)count / (image1.width() * image1.height());
+}
+
+static bool isEmpty(const QImage& image) {
+	for (int y = 0; y < image.height(); ++y)
+		for (int x = 0; x < image.width(); ++x)
+			if (qAlpha(image.pixel(x, y)))
+				return false;
+	return true;
+}
+
+//**********************************************************
+//****************** Function tests ************************
+//**********************************************************
+
+// the stamped sprites look like the paths drawn at the same (pixel) positions
+void SymbolTest::testSprite() {
+	const auto points = randomPoints(100, 180);
+	const QPen pen(Qt::black, 1.);
+	const QBrush brush(Qt::red);
+
+	for (auto style : {Symbol::Style::Circle, Symbol::Style::Square, Symbol::Style::Star5, Symbol::Style::Cross}) {
+		const auto path = symbolPath(style, 10.);
+		const auto sprites = drawSymbols(path, points, pen, brush, 0.5);
+		const auto paths = drawSymbols(path, points, pen, brush, 0.5, false);
+		QVERIFY(!isEmpty(sprites));
+		QVERIFY(difference(sprites, paths) < 0.01);
+	}
+}
+
+// the sprite is rasterized for the scaling of the painter
+void SymbolTest::testScaledSprite() {
+	const auto points = randomPoints(50, 90);
+	const QPen pen(Qt::blue, 0.5);
+	const QBrush brush(Qt::green);
+	const auto path = symbolPath(Symbol::Style::Circle, 5.);
+
+	const auto sprites = drawSymbols(path, points, pen, brush, 1., true, 2.);
+	const auto paths = drawSymbols(path, points, pen, brush, 1., false, 2.);
+	QVERIFY(difference(sprites, paths) < 0.01);
+}
+
+// opaque symbols drawn several times at the same position give the same image as drawn once
+void SymbolTest::testOcclusionCulling() {
+	auto points = randomPoints(100, 180);
+	const QPen pen(Qt::black, 1.);
+	const QBrush brush(Qt::red);
+	const auto path = symbolPath(Symbol::Style::Circle, 8.);
+
+	const auto once = drawSymbols(path, points, pen, brush);
+	auto repeated = points;
+	repeated << points << QPointF(points.first().x() + 0.1, points.first().y() - 0.1);
+	QCOMPARE(drawSymbols(path, repeated, pen, brush), once);
+
+	// semi-transparent symbols are not culled
+	const auto transparentOnce = drawSymbols(path, points, pen, QBrush(QColor(255, 0, 0, 128)));
+	QVERIFY(drawSymbols(path, repeated, pen, QBrush(QColor(255, 0, 0, 128))) != transparentOnce);
+}
+
+// symbols larger than the sprites are drawn as paths
+void SymbolTest::testLargeSymbol() {
+	const QVector<QPointF> points{QPointF(100, 100)};
+	const QPen pen(Qt::black, 1.);
+	const QBrush brush(Qt::red);
+	const auto path = symbolPath(Symbol::Style::Square, 300.);
+
+	const auto image = drawSymbols(path, points, pen, brush);
+	QCOMPARE(image.pixel(100, 100), QColor(Qt::red).rgba());
+	QVERIFY(difference(image, drawSymbols(path, points, pen, brush, 1., false)) < 0.01);
+}
+
+//**********************************************************
+//****************** Performance tests *********************
+//**********************************************************
+
+void SymbolTest::testPerformanceSprite() {
+	const auto points = randomPoints(1000000, 200);
+	const auto path = symbolPath(Symbol::Style::Circle, 5.);
+
+	QBENCHMARK {
+		drawSymbols(path, points, QPen(Qt::black, 0.5), QBrush(Qt::red), 0.5);
+	}
+}
+
+void SymbolTest::testPerformancePath() {
+	const auto points = randomPoints(1000000, 200);
+	const auto path = symbolPath(Symbol::Style::Circle, 5.);
+
+	QBENCHMARK {
+		drawSymbols(path, points, QPen(Qt::black, 0.5), QBrush(Qt::red), 0.5, false);
+	}
+}
+
+QTEST_MAIN(SymbolTest)
@@ -0,0 +1,29 @@
+/*
+    File                 : SymbolTest.h
+    Project              : LabPlot
+    Description          : Tests for drawing symbols
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef SYMBOLTEST_H
+#define SYMBOLTEST_H
+
+#include "../../CommonTest.h"
+
+class SymbolTest : public CommonTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testSprite();
+	void testScaledSprite();
+	void testOcclusionCulling();
+	void testLargeSymbol();
+
+	void testPerformanceSprite();
+	void testPerformancePath();
+};
+
+#endif
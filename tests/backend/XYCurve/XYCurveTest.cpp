@@ -11,8 +11,13 @@
 #include "XYCurveTest.h"
 #include "backend/worksheet/plots/cartesian/XYCurve.h"
 #include "backend/worksheet/plots/cartesian/XYCurvePrivate.h"
+#include "backend/worksheet/plots/cartesian/Symbol.h"
 #include "backend/lib/trace.h"
 
+#include <QPainter>
+
+#include <random>
+
 void addUniqueLine01(QPointF p, double x, double& minY, double& maxY, QPointF& lastPoint, int& pixelDiff, QVector<QLineF>& lines);
 void addUniqueLine02(QPointF p, double x, double& minY, double& maxY, QPointF& lastPoint, int& pixelDiff, QVector<QLineF>& lines);
 
@@ -75,6 +80,56 @@ void XYCurveTest::addUniqueLineTest01() {
 	}
 }
 
+// rendering large curves in parallel tiles gives the same image as drawing the curve at once
+void XYCurveTest::renderTiles() {
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> distribution(0., 500.);
+	XYCurvePrivate::RenderData data;
+	data.scenePoints.resize(300000);
+	for (auto& point : data.scenePoints)
+		point = QPointF(distribution(generator), distribution(generator));
+	data.symbolStyle = Symbol::Style::Circle;
+	data.symbolSize = 4.;
+	data.symbolPen = QPen(Qt::black, 0.5);
+	data.symbolBrush = QBrush(Qt::red);
+	data.symbolOpacity = 0.5;
+	data.lineType = XYCurve::LineType::Line;
+	data.linePen = QPen(Qt::blue, 1.);
+	data.linePath.moveTo(10, 10);
+	for (int i = 1; i < 100; ++i)
+		data.linePath.lineTo(5 * i, 10 + (i % 2) * 480);
+
+	const QRectF rect(-10, -10, 520, 520);
+	const QImage image = XYCurvePrivate::render(data, rect);
+	QCOMPARE(image.size(), QSize(520, 520));
+
+	QImage reference(520, 520, QImage::Format_ARGB32_Premultiplied);
+	reference.fill(Qt::transparent);
+	QPainter painter(&reference);
+	painter.setRenderHint(QPainter::Antialiasing, true);
+	painter.translate(-rect.topLeft());
+	painter.setPen(data.linePen);
+	painter.drawPath(data.linePath);
+	painter.setOpacity(data.symbolOpacity);
+	painter.setPen(data.symbolPen);
+	painter.setBrush(data.symbolBrush);
+	QTransform trafo;
+	trafo.scale(data.symbolSize, data.symbolSize);
+	Symbol::draw(&painter, trafo.map(Symbol::stylePath(data.symbolStyle)), data.scenePoints);
+	painter.end();
+
+	int differences = 0;
+	for (int y = 0; y < image.height(); ++y)
+		for (int x = 0; x < image.width(); ++x)
+			if (image.pixel(x, y) != reference.pixel(x, y))
+				++differences;
+	QVERIFY(differences < image.width() * image.height() / 1000);
+
+	// a cancelled rendering returns no image
+	std::atomic<bool> cancelled{true};
+	QVERIFY(XYCurvePrivate::render(data, rect, &cancelled).isNull());
+}
+
 void addUniqueLine01(QPointF p, double x, double& minY, double& maxY, QPointF& lastPoint, int& pixelDiff, QVector<QLineF>& lines) {
 	static bool prevPixelDiffZero = false;
 	if (pixelDiff == 0) {
@@ -19,6 +19,7 @@ class XYCurveTest : public CommonTest {
 private Q_SLOTS:
 
 	void addUniqueLineTest01();
+	void renderTiles();
 
 };
 
@@ -0,0 +1,57 @@
+/*
+    File                 : CartesianPlotBenchmark.cpp
+    Project              : LabPlot
+    Description          : Benchmarks for mapping large curves in cartesian plots
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "CartesianPlotBenchmark.h"
+#include "backend/worksheet/Worksheet.h"
+#include "backend/worksheet/plots/cartesian/CartesianPlot.h"
+#include "backend/worksheet/plots/cartesian/CartesianCoordinateSystem.h"
+
+void CartesianPlotBenchmark::initTestCase() {
+	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
+	//TODO: redesign/remove this
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+}
+
+/*!
+ * maps the points of a curve with \c count points in a plot with the size of 10x10 cm
+ */
+void CartesianPlotBenchmark::mapCurvePoints(int count) {
+	Worksheet worksheet(QStringLiteral("test"));
+	auto* plot = new CartesianPlot(QStringLiteral("plot"));
+	plot->setType(CartesianPlot::Type::FourAxes);
+	worksheet.addChild(plot);
+	plot->setXRange(Range<double>(0., 1.));
+	plot->setYRange(Range<double>(-1., 1.));
+	QVERIFY(plot->dataRect().width() > 0);
+
+	QVector<QPointF> points(count);
+	for (int i = 0; i < count; ++i)
+		points[i] = QPointF((double)i / count, sin(i * 1.e-3));
+
+	const auto* cSystem = plot->coordinateSystem(0);
+	Points scenePoints;
+	QVector<bool> visible(count);
+	QBENCHMARK {
+		scenePoints.clear();
+		cSystem->mapLogicalToScene(0, count - 1, points, scenePoints, visible);
+	}
+	QVERIFY(!scenePoints.isEmpty());
+}
+
+void CartesianPlotBenchmark::testPerformanceMapping10M() {
+	mapCurvePoints(10000000);
+}
+
+void CartesianPlotBenchmark::testPerformanceMapping100M() {
+	mapCurvePoints(100000000);
+}
+
+QTEST_MAIN(CartesianPlotBenchmark)
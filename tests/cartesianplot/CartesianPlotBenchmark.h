@@ -0,0 +1,28 @@
+/*
+    File                 : CartesianPlotBenchmark.h
+    Project              : LabPlot
+    Description          : Benchmarks for mapping large curves in cartesian plots
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef CARTESIANPLOTBENCHMARK_H
+#define CARTESIANPLOTBENCHMARK_H
+
+#include <QtTest>
+
+class CartesianPlotBenchmark : public QObject {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+
+	// performance of mapping curve points
+	void testPerformanceMapping10M();
+	void testPerformanceMapping100M();
+
+private:
+	void mapCurvePoints(int count);
+};
+#endif
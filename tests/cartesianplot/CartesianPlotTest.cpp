@@ -17,11 +17,14 @@
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 #include "backend/worksheet/plots/cartesian/Histogram.h"
 #include "backend/worksheet/plots/cartesian/CartesianCoordinateSystem.h"
+#include "backend/worksheet/plots/cartesian/CartesianScale.h"
 #include "backend/worksheet/plots/cartesian/XYCurve.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
 #include <QAction>
 
+#include <random>
+
 void CartesianPlotTest::initTestCase() {
 //	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
 //	//TODO: redesign/remove this
@@ -268,4 +271,75 @@ void CartesianPlotTest::deleteCurve() {
 	CHECK_RANGE(plot, curve1, y, 0, 0.45);
 }
 
+//##############################################################################
+//##################  mapping logical to scene coordinates  ####################
+//##############################################################################
+
+/*!
+ * mapping many values at once gives the same result as mapping them one by one
+ */
+void CartesianPlotTest::scaleMapping() {
+	const Range<double> range(0.5, 100.), sceneRange(10., 500.);
+	QVector<CartesianScale*> scales{CartesianScale::createLinearScale(range, sceneRange, range),
+		CartesianScale::createLogScale(range, sceneRange, range, RangeT::Scale::Log10),
+		CartesianScale::createLogScale(range, sceneRange, range, RangeT::Scale::Log2),
+		CartesianScale::createLogScale(range, sceneRange, range, RangeT::Scale::Ln),
+		CartesianScale::createSqrtScale(range, sceneRange, range),
+		CartesianScale::createSquareScale(range, sceneRange, range),
+		CartesianScale::createInverseScale(range, sceneRange, range)};
+
+	// values inside and outside of the range
+	QVector<double> values{-1., 0., 0.25, 0.5, 1., 2.5, 10., 42., 99.9, 100., 101., NAN};
+	std::mt19937 generator(1);
+	std::uniform_real_distribution<double> distribution(-10., 110.);
+	for (int i = 0; i < 1000; ++i)
+		values << distribution(generator);
+
+	for (const auto* scale : scales) {
+		QVERIFY(scale);
+		QVector<double> mapped = values;
+		scale->map(mapped.data(), mapped.size());
+
+		for (int i = 0; i < values.size(); ++i) {
+			double value = values.at(i);
+			if (!scale->contains(value) || !scale->map(&value))
+				QVERIFY(std::isnan(mapped.at(i)));
+			else
+				QVERIFY(qAbs(mapped.at(i) - value) < 1.e-9);
+		}
+	}
+
+	qDeleteAll(scales);
+}
+
+/*!
+ * maps the points of a curve with \c count points in a plot with the size of 10x10 cm
+ */
+static void mapCurvePoints(int count) {
+	Worksheet worksheet(QStringLiteral("test"));
+	auto* plot = new CartesianPlot(QStringLiteral("plot"));
+	plot->setType(CartesianPlot::Type::FourAxes);
+	worksheet.addChild(plot);
+	plot->setXRange(Range<double>(0., 1.));
+	plot->setYRange(Range<double>(-1., 1.));
+	QVERIFY(plot->dataRect().width() > 0);
+
+	QVector<QPointF> points(count);
+	for (int i = 0; i < count; ++i)
+		points[i] = QPointF((double)i / count, sin(i * 1.e-3));
+
+	const auto* cSystem = plot->coordinateSystem(0);
+	Points scenePoints;
+	QVector<bool> visible(count);
+	QBENCHMARK {
+		scenePoints.clear();
+		cSystem->mapLogicalToScene(0, count - 1, points, scenePoints, visible);
+	}
+	QVERIFY(!scenePoints.isEmpty());
+}
+
+void CartesianPlotTest::testPerformanceMapping1M() {
+	mapCurvePoints(1000000);
+}
+
 QTEST_MAIN(CartesianPlotTest)
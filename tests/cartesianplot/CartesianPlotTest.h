@@ -29,5 +29,10 @@ private Q_SLOTS:
 	// check deleting curve
 	void deleteCurve();
 
+	// mapping of logical to scene coordinates
+	void scaleMapping();
+
+	// performance of mapping curve points
+	void testPerformanceMapping1M();
 };
 #endif
@@ -0,0 +1,82 @@
+/*
+    File                 : AsciiFilterBenchmark.cpp
+    Project              : LabPlot
+    Description          : Benchmarks for reading large files with the ascii filter
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "AsciiFilterBenchmark.h"
+#include "backend/datasources/filters/AsciiFilter.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <random>
+
+void AsciiFilterBenchmark::initTestCase() {
+	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
+	//TODO: redesign/remove this
+	qRegisterMetaType<const AbstractAspect*>("const AbstractAspect*");
+	qRegisterMetaType<const AbstractColumn*>("const AbstractColumn*");
+
+	QVERIFY(m_dir.isValid());
+}
+
+/*!
+ * generates the file \c name with \c rows lines of \c cols comma separated random double values and a header line.
+ */
+QString AsciiFilterBenchmark::generateFile(const QString& name, int rows, int cols) {
+	const QString fileName = m_dir.filePath(name);
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly))
+		return QString();
+
+	std::mt19937 generator(rows);
+	std::normal_distribution<double> distribution(0., 1000.);
+
+	QByteArray line;
+	for (int col = 0; col < cols; ++col)
+		line += (col ? ",c" : "c") + QByteArray::number(col + 1);
+	file.write(line + '\n');
+
+	for (int row = 0; row < rows; ++row) {
+		line.clear();
+		for (int col = 0; col < cols; ++col) {
+			if (col)
+				line += ',';
+			line += QByteArray::number(distribution(generator), 'g', 10);
+		}
+		line += '\n';
+		file.write(line);
+	}
+
+	return fileName;
+}
+
+void AsciiFilterBenchmark::readFile(const QString& fileName, int rows, int cols) {
+	QVERIFY(!fileName.isEmpty());
+
+	QBENCHMARK {
+		Spreadsheet spreadsheet("test", false);
+		AsciiFilter filter;
+		filter.setSeparatingCharacter(",");
+		filter.setHeaderEnabled(true);
+		filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+		QCOMPARE(spreadsheet.rowCount(), rows);
+		QCOMPARE(spreadsheet.columnCount(), cols);
+	}
+}
+
+void AsciiFilterBenchmark::testRead1Mx20() {
+	const int rows = 1000000, cols = 20;
+	readFile(generateFile(QLatin1String("1Mx20.csv"), rows, cols), rows, cols);
+}
+
+void AsciiFilterBenchmark::testRead10Mx5() {
+	const int rows = 10000000, cols = 5;
+	readFile(generateFile(QLatin1String("10Mx5.csv"), rows, cols), rows, cols);
+}
+
+QTEST_MAIN(AsciiFilterBenchmark)
@@ -0,0 +1,31 @@
+/*
+    File                 : AsciiFilterBenchmark.h
+    Project              : LabPlot
+    Description          : Benchmarks for reading large files with the ascii filter
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef ASCIIFILTERBENCHMARK_H
+#define ASCIIFILTERBENCHMARK_H
+
+#include <QtTest>
+#include <QTemporaryDir>
+
+class AsciiFilterBenchmark : public QObject {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void initTestCase();
+
+	void testRead1Mx20();
+	void testRead10Mx5();
+
+private:
+	QString generateFile(const QString& name, int rows, int cols);
+	void readFile(const QString& fileName, int rows, int cols);
+
+	QTemporaryDir m_dir;
+};
+#endif
@@ -12,6 +12,10 @@
 #include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <QBuffer>
+#include <QTemporaryFile>
+#include <QTextStream>
+
 void AsciiFilterTest::initTestCase() {
 	// needed in order to have the signals triggered by SignallingUndoCommand, see LabPlot.cpp
 	//TODO: redesign/remove this
@@ -825,6 +829,49 @@ void AsciiFilterTest::testQuotedStrings03() {
 	QCOMPARE(spreadsheet.column(3)->valueAt(0), 1.1);
 }
 
+/*!
+ * quotes and carriage returns are removed from the whole line when reading the mapped file in parallel
+ * and when reading the device line by line
+ */
+void AsciiFilterTest::testQuotedStrings04() {
+	const QByteArray content("\"a\",\"1\",\"1.5\"\r\n\"\"\r\n\"#comment\"\r\n\"b\r\",\"2\",\"2.5\"\r\n");
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.write(content);
+	file.close();
+
+	Spreadsheet fileSpreadsheet("test", false);
+	Spreadsheet deviceSpreadsheet("test", false);
+	AsciiFilter filter;
+	filter.setSeparatingCharacter(",");
+	filter.setHeaderEnabled(false);
+	filter.setRemoveQuotesEnabled(true);
+	filter.readDataFromFile(file.fileName(), &fileSpreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QByteArray data(content);
+	QBuffer buffer(&data);
+	AsciiFilter deviceFilter;
+	deviceFilter.setSeparatingCharacter(",");
+	deviceFilter.setHeaderEnabled(false);
+	deviceFilter.setRemoveQuotesEnabled(true);
+	deviceFilter.readDataFromDevice(buffer, &deviceSpreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	for (auto* spreadsheet : {&fileSpreadsheet, &deviceSpreadsheet}) {
+		QCOMPARE(spreadsheet->rowCount(), 2);
+		QCOMPARE(spreadsheet->columnCount(), 3);
+		QCOMPARE(spreadsheet->column(0)->columnMode(), AbstractColumn::ColumnMode::Text);
+		QCOMPARE(spreadsheet->column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+		QCOMPARE(spreadsheet->column(2)->columnMode(), AbstractColumn::ColumnMode::Double);
+
+		QCOMPARE(spreadsheet->column(0)->textAt(0), QLatin1String("a"));
+		QCOMPARE(spreadsheet->column(1)->integerAt(0), 1);
+		QCOMPARE(spreadsheet->column(2)->valueAt(0), 1.5);
+		QCOMPARE(spreadsheet->column(0)->textAt(1), QLatin1String("b"));
+		QCOMPARE(spreadsheet->column(1)->integerAt(1), 2);
+		QCOMPARE(spreadsheet->column(2)->valueAt(1), 2.5);
+	}
+}
+
 
 //##############################################################################
 //###############################  skip comments ###############################
@@ -913,6 +960,38 @@ void AsciiFilterTest::testComments02() {
 }
 
 
+//##############################################################################
+//#############################  different locales  ############################
+//##############################################################################
+/*!
+ * read numbers with the decimal comma and the group separator of the German locale
+ */
+void AsciiFilterTest::testLocale00() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	file.write("x;y\n1,5;2\n-0,25;1.000,5\n3e2;\n");
+	file.close();
+
+	Spreadsheet spreadsheet("test", false);
+	AsciiFilter filter;
+	filter.setSeparatingCharacter(";");
+	filter.setHeaderEnabled(true);
+	filter.setNumberFormat(QLocale::German);
+	filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 1.5);
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), -0.25);
+	QCOMPARE(spreadsheet.column(0)->valueAt(2), 300.);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 2.);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 1000.5);
+	QVERIFY(std::isnan(spreadsheet.column(1)->valueAt(2)));
+}
+
 //##############################################################################
 //#########################  handling of datetime data #########################
 //##############################################################################
@@ -954,4 +1033,51 @@ void AsciiFilterTest::testDateTime00() {
 	QCOMPARE(spreadsheet.column(1)->valueAt(1), 14.8026);
 }
 
+//##############################################################################
+//#######################  large files read in parallel  #######################
+//##############################################################################
+/*!
+ * read a file larger than two chunks of the parallel reader with commented and empty lines in between,
+ * the rows of all chunks have to be in the order of the file and the index has to count all lines of the file
+ */
+void AsciiFilterTest::testLargeFile00() {
+	const int lines = 500000;
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	{
+		QTextStream out(&file);
+		out << "# generated data\n";
+		for (int i = 0; i < lines; ++i) {
+			if (i % 1000 == 0)
+				out << "# comment\n\n";
+			out << i << ',' << QString::number(i * 0.25, 'f', 2) << ",text" << i % 10 << '\n';
+		}
+	}
+	file.close();
+	QVERIFY(file.size() > 2 * (1 << 22));
+
+	Spreadsheet spreadsheet("test", false);
+	AsciiFilter filter;
+	filter.setSeparatingCharacter(",");
+	filter.setHeaderEnabled(false);
+	filter.setCreateIndexEnabled(true);
+	filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.rowCount(), lines);
+	QCOMPARE(spreadsheet.columnCount(), 4);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(3)->columnMode(), AbstractColumn::ColumnMode::Text);
+
+	for (int i = 0; i < lines; i += 997) {
+		// the index is the number of the line in the file, including the commented and empty lines
+		QCOMPARE(spreadsheet.column(0)->integerAt(i), i + 2 * (i / 1000 + 1) + 2);
+		QCOMPARE(spreadsheet.column(1)->integerAt(i), i);
+		QCOMPARE(spreadsheet.column(2)->valueAt(i), i * 0.25);
+		QCOMPARE(spreadsheet.column(3)->textAt(i), QStringLiteral("text") + QString::number(i % 10));
+	}
+	QCOMPARE(spreadsheet.column(1)->integerAt(lines - 1), lines - 1);
+}
+
 QTEST_MAIN(AsciiFilterTest)
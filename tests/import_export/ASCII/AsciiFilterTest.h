@@ -61,8 +61,10 @@ private Q_SLOTS:
 	void testQuotedStrings01();
 	void testQuotedStrings02();
 	void testQuotedStrings03();
+	void testQuotedStrings04();
 
 	//different locales
+	void testLocale00();
 
 	//handling of NANs
 
@@ -73,5 +75,8 @@ private Q_SLOTS:
 
 	//datetime data
 	void testDateTime00();
+
+	//large files read in parallel
+	void testLargeFile00();
 };
 #endif
@@ -0,0 +1,227 @@
+/*
+    File                 : BinaryFilterTest.cpp
+    Project              : LabPlot
+    Description          : Tests for the binary I/O-filter.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "BinaryFilterTest.h"
+#include "backend/datasources/filters/BinaryFilter.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <KFilterDev>
+#include <QTemporaryDir>
+
+// number of rows written for the round trip tests, more than copied in one block
+static const int roundTripRows = 40000;
+static const int roundTripVectors = 3;
+
+static double value(int row, int vector) {
+	return (vector % 2 ? -1 : 1) * (row * roundTripVectors + vector);
+}
+
+/*!
+ * writes \c rows rows of \c vectors vectors of the type \c T in the byte order \c byteOrder
+ * after \c skip bytes of garbage into the device \c device
+ */
+template<typename T>
+static void writeValues(QIODevice& device, QDataStream::ByteOrder byteOrder, int rows, int vectors, int skip = 0) {
+	device.write(QByteArray(skip, 'x'));
+	QDataStream out(&device);
+	out.setByteOrder(byteOrder);
+	for (int i = 0; i < rows; ++i) {
+		for (int n = 0; n < vectors; ++n)
+			out << (T)value(i, n);
+	}
+}
+
+template<typename T>
+static bool writeFile(const QString& fileName, QDataStream::ByteOrder byteOrder, int rows, int vectors, int skip = 0) {
+	QFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly))
+		return false;
+	writeValues<T>(file, byteOrder, rows, vectors, skip);
+	return true;
+}
+
+/*!
+ * compares the \c vectors columns of \c spreadsheet starting at the column \c startColumn with the rows
+ * starting at the row \c firstRow of the written values
+ */
+static void compareColumns(Spreadsheet& spreadsheet, int startColumn, int vectors, int rows, int firstRow = 0) {
+	QCOMPARE(spreadsheet.columnCount(), startColumn + vectors);
+	QCOMPARE(spreadsheet.rowCount(), rows);
+	for (int n = 0; n < vectors; ++n) {
+		const auto* column = spreadsheet.column(startColumn + n);
+		QCOMPARE(column->columnMode(), AbstractColumn::ColumnMode::Double);
+		for (int i = 0; i < rows; ++i)
+			QCOMPARE(column->valueAt(i), value(firstRow + i, n));
+	}
+}
+
+//##############################################################################
+//#########################  round trip of written files  ######################
+//##############################################################################
+/*!
+ * reads a file mapped into memory in the byte order of the machine
+ */
+void BinaryFilterTest::testRoundTripInt32() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("int32.bin"));
+	const auto byteOrder = (QSysInfo::ByteOrder == QSysInfo::BigEndian) ? QDataStream::BigEndian : QDataStream::LittleEndian;
+	QVERIFY(writeFile<qint32>(fileName, byteOrder, roundTripRows, roundTripVectors));
+
+	Spreadsheet spreadsheet("test", false);
+	BinaryFilter filter;
+	filter.setVectors(roundTripVectors);
+	filter.setDataType(BinaryFilter::DataType::INT32);
+	filter.setByteOrder(byteOrder);
+	filter.setCreateIndexEnabled(true);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	compareColumns(spreadsheet, 1, roundTripVectors, roundTripRows);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 1);
+	QCOMPARE(spreadsheet.column(0)->integerAt(roundTripRows - 1), roundTripRows);
+}
+
+/*!
+ * reads files mapped into memory in the other byte order than the one of the machine,
+ * the values of all sizes have to be swapped
+ */
+void BinaryFilterTest::testRoundTripByteSwapped() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const auto byteOrder = (QSysInfo::ByteOrder == QSysInfo::BigEndian) ? QDataStream::LittleEndian : QDataStream::BigEndian;
+
+	const QString int16Name = dir.filePath(QLatin1String("int16.bin"));
+	const QString int64Name = dir.filePath(QLatin1String("int64.bin"));
+	const QString real64Name = dir.filePath(QLatin1String("real64.bin"));
+	// 16 bit values are small enough for the first rows only
+	QVERIFY(writeFile<qint16>(int16Name, byteOrder, 1000, roundTripVectors));
+	QVERIFY(writeFile<qint64>(int64Name, byteOrder, roundTripRows, roundTripVectors));
+	QVERIFY(writeFile<double>(real64Name, byteOrder, roundTripRows, roundTripVectors));
+
+	const QVector<QPair<QString, BinaryFilter::DataType>> files{{int16Name, BinaryFilter::DataType::INT16},
+		{int64Name, BinaryFilter::DataType::INT64}, {real64Name, BinaryFilter::DataType::REAL64}};
+	for (const auto& file : files) {
+		Spreadsheet spreadsheet("test", false);
+		BinaryFilter filter;
+		filter.setVectors(roundTripVectors);
+		filter.setDataType(file.second);
+		filter.setByteOrder(byteOrder);
+		filter.readDataFromFile(file.first, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+		compareColumns(spreadsheet, 0, roundTripVectors, file.second == BinaryFilter::DataType::INT16 ? 1000 : roundTripRows);
+	}
+}
+
+/*!
+ * reads a single vector of doubles in the byte order of the machine, copied as a whole into the column
+ */
+void BinaryFilterTest::testRoundTripSingleVector() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("real64.bin"));
+	const auto byteOrder = (QSysInfo::ByteOrder == QSysInfo::BigEndian) ? QDataStream::BigEndian : QDataStream::LittleEndian;
+	QVERIFY(writeFile<double>(fileName, byteOrder, roundTripRows, 1));
+
+	Spreadsheet spreadsheet("test", false);
+	BinaryFilter filter;
+	filter.setVectors(1);
+	filter.setDataType(BinaryFilter::DataType::REAL64);
+	filter.setByteOrder(byteOrder);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	compareColumns(spreadsheet, 0, 1, roundTripRows);
+}
+
+/*!
+ * maps only the selected rows after the skipped bytes at the start of the file,
+ * an end row after the end of the file is limited to the available rows
+ */
+void BinaryFilterTest::testRoundTripRange() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("int32.bin"));
+	QVERIFY(writeFile<qint32>(fileName, QDataStream::BigEndian, roundTripRows, roundTripVectors, 13));
+
+	Spreadsheet spreadsheet("test", false);
+	BinaryFilter filter;
+	filter.setVectors(roundTripVectors);
+	filter.setDataType(BinaryFilter::DataType::INT32);
+	filter.setByteOrder(QDataStream::BigEndian);
+	filter.setSkipStartBytes(13);
+	filter.setStartRow(20001);
+	filter.setEndRow(30000);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	compareColumns(spreadsheet, 0, roundTripVectors, 10000, 20000);
+
+	Spreadsheet spreadsheet2("test", false);
+	filter.setEndRow(roundTripRows + 1000);
+	filter.readDataFromFile(fileName, &spreadsheet2, AbstractFileFilter::ImportMode::Replace);
+	compareColumns(spreadsheet2, 0, roundTripVectors, roundTripRows - 20000, 20000);
+}
+
+/*!
+ * the values of an incomplete last row are read as far as available and set to zero after the end of the file
+ */
+void BinaryFilterTest::testRoundTripIncompleteRow() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("incomplete.bin"));
+	{
+		QFile file(fileName);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		writeValues<qint16>(file, QDataStream::BigEndian, 10, roundTripVectors);
+		QDataStream out(&file);
+		out.setByteOrder(QDataStream::BigEndian);
+		out << (qint16)value(10, 0);
+	}
+
+	Spreadsheet spreadsheet("test", false);
+	BinaryFilter filter;
+	filter.setVectors(roundTripVectors);
+	filter.setDataType(BinaryFilter::DataType::INT16);
+	filter.setByteOrder(QDataStream::BigEndian);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.rowCount(), 11);
+	for (int n = 0; n < roundTripVectors; ++n) {
+		for (int i = 0; i < 10; ++i)
+			QCOMPARE(spreadsheet.column(n)->valueAt(i), value(i, n));
+	}
+	QCOMPARE(spreadsheet.column(0)->valueAt(10), value(10, 0));
+	QCOMPARE(spreadsheet.column(1)->valueAt(10), 0.);
+	QCOMPARE(spreadsheet.column(2)->valueAt(10), 0.);
+}
+
+/*!
+ * compressed files are read with the stream and give the same values as the mapped files
+ */
+void BinaryFilterTest::testRoundTripCompressed() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("int64.bin.gz"));
+	{
+		KFilterDev device(fileName);
+		QVERIFY(device.open(QIODevice::WriteOnly));
+		writeValues<qint64>(device, QDataStream::BigEndian, 1000, roundTripVectors, 7);
+	}
+
+	Spreadsheet spreadsheet("test", false);
+	BinaryFilter filter;
+	filter.setVectors(roundTripVectors);
+	filter.setDataType(BinaryFilter::DataType::INT64);
+	filter.setByteOrder(QDataStream::BigEndian);
+	filter.setSkipStartBytes(7);
+	filter.setStartRow(101);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	compareColumns(spreadsheet, 0, roundTripVectors, 900, 100);
+}
+
+QTEST_MAIN(BinaryFilterTest)
@@ -0,0 +1,29 @@
+/*
+    File                 : BinaryFilterTest.h
+    Project              : LabPlot
+    Description          : Tests for the binary I/O-filter.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef BINARYFILTERTEST_H
+#define BINARYFILTERTEST_H
+
+#include "../../CommonTest.h"
+#include <QtTest>
+
+class BinaryFilterTest : public CommonTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testRoundTripInt32();
+	void testRoundTripByteSwapped();
+	void testRoundTripSingleVector();
+	void testRoundTripRange();
+	void testRoundTripIncompleteRow();
+	void testRoundTripCompressed();
+};
+
+
+#endif
@@ -0,0 +1,157 @@
+/*
+    File                 : FITSFilterTest.cpp
+    Project              : LabPlot
+    Description          : Tests for the FITS I/O-filter.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "FITSFilterTest.h"
+#include "backend/datasources/filters/FITSFilter.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+
+#include <QTemporaryDir>
+
+#include <fitsio.h>
+
+// number of rows of the table written for the round trip tests, more than read in one batch
+static const int roundTripRows = 50000;
+
+static double doubleValue(int row) {
+	return (row == 7) ? NAN : row / 4. - 100.;
+}
+
+static int intValue(int row) {
+	return (row % 2 ? -1 : 1) * row * 1000;
+}
+
+static qint64 bigIntValue(int row) {
+	return row * 10000000000LL + 1;
+}
+
+static double scaledValue(int row) {
+	return 10. + 0.5 * (row % 30000 - 15000);
+}
+
+static QString textValue(int row) {
+	return QLatin1String("row ") + QString::number(row % 1000);
+}
+
+/*!
+ * writes a binary table with a double, an integer, a 64 bit integer, a scaled 16 bit integer and a string column
+ * into the new file \c fileName. The values are stored in the big endian byte order of FITS and are byte-swapped
+ * by cfitsio when reading them on little endian machines.
+ */
+static bool writeRoundTripFile(const QString& fileName) {
+	QVector<double> doubles(roundTripRows), scaled(roundTripRows);
+	QVector<int> ints(roundTripRows);
+	QVector<LONGLONG> bigInts(roundTripRows);
+	QVector<QByteArray> texts(roundTripRows);
+	std::vector<char*> textPointers(roundTripRows);
+	for (int i = 0; i < roundTripRows; ++i) {
+		doubles[i] = doubleValue(i);
+		ints[i] = intValue(i);
+		bigInts[i] = bigIntValue(i);
+		scaled[i] = scaledValue(i);
+		texts[i] = textValue(i).toLatin1();
+		textPointers[i] = texts[i].data();
+	}
+
+	int status = 0;
+	fitsfile* file;
+	if (fits_create_file(&file, qPrintable(fileName), &status))
+		return false;
+
+	char name1[] = "DOUBLES", name2[] = "INTS", name3[] = "BIGINTS", name4[] = "SCALED", name5[] = "TEXTS";
+	char form1[] = "1D", form2[] = "1J", form3[] = "1K", form4[] = "1I", form5[] = "8A";
+	char* names[] = {name1, name2, name3, name4, name5};
+	char* forms[] = {form1, form2, form3, form4, form5};
+	char extension[] = "TABLE";
+	fits_create_tbl(file, BINARY_TBL, roundTripRows, 5, names, forms, nullptr, extension, &status);
+
+	// the values of the scaled column are stored as (value - 10) / 0.5
+	double scale = 0.5, zero = 10.;
+	char scaleKey[] = "TSCAL4", zeroKey[] = "TZERO4";
+	fits_write_key(file, TDOUBLE, scaleKey, &scale, nullptr, &status);
+	fits_write_key(file, TDOUBLE, zeroKey, &zero, nullptr, &status);
+	fits_set_tscale(file, 4, scale, zero, &status);
+
+	fits_write_col(file, TDOUBLE, 1, 1, 1, roundTripRows, doubles.data(), &status);
+	fits_write_col(file, TINT, 2, 1, 1, roundTripRows, ints.data(), &status);
+	fits_write_col(file, TLONGLONG, 3, 1, 1, roundTripRows, bigInts.data(), &status);
+	fits_write_col(file, TDOUBLE, 4, 1, 1, roundTripRows, scaled.data(), &status);
+	fits_write_col(file, TSTRING, 5, 1, 1, roundTripRows, textPointers.data(), &status);
+
+	const bool ok = (status == 0);
+	status = 0;
+	fits_close_file(file, &status);
+	return ok && status == 0;
+}
+
+//##############################################################################
+//#########################  round trip of written files  ######################
+//##############################################################################
+/*!
+ * reads all columns of a table written with cfitsio,
+ * the columns are read in parallel if cfitsio was built reentrant
+ */
+void FITSFilterTest::testRoundTripTable() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("roundtrip.fits"));
+	QVERIFY(writeRoundTripFile(fileName));
+
+	Spreadsheet spreadsheet("test", false);
+	FITSFilter filter;
+	filter.readDataFromFile(fileName + QLatin1String("[TABLE]"), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 5);
+	QCOMPARE(spreadsheet.rowCount(), roundTripRows);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("DOUBLES"));
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(3)->columnMode(), AbstractColumn::ColumnMode::Double);	// scaled integers
+	QCOMPARE(spreadsheet.column(4)->columnMode(), AbstractColumn::ColumnMode::Text);
+
+	for (int i = 0; i < roundTripRows; ++i) {
+		if (std::isnan(doubleValue(i)))
+			QVERIFY(std::isnan(spreadsheet.column(0)->valueAt(i)));
+		else
+			QCOMPARE(spreadsheet.column(0)->valueAt(i), doubleValue(i));
+		QCOMPARE(spreadsheet.column(1)->integerAt(i), intValue(i));
+		QCOMPARE(spreadsheet.column(2)->bigIntAt(i), bigIntValue(i));
+		QCOMPARE(spreadsheet.column(3)->valueAt(i), scaledValue(i));
+		QCOMPARE(spreadsheet.column(4)->textAt(i), textValue(i));
+	}
+}
+
+/*!
+ * reads a block of rows and columns of the table
+ */
+void FITSFilterTest::testRoundTripTablePortion() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("roundtrip.fits"));
+	QVERIFY(writeRoundTripFile(fileName));
+
+	Spreadsheet spreadsheet("test", false);
+	FITSFilter filter;
+	filter.setStartRow(1001);
+	filter.setEndRow(42000);
+	filter.setStartColumn(2);
+	filter.setEndColumn(4);
+	filter.readDataFromFile(fileName + QLatin1String("[TABLE]"), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 41000);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("INTS"));
+	for (int i = 0; i < 41000; ++i) {
+		QCOMPARE(spreadsheet.column(0)->integerAt(i), intValue(i + 1000));
+		QCOMPARE(spreadsheet.column(1)->bigIntAt(i), bigIntValue(i + 1000));
+		QCOMPARE(spreadsheet.column(2)->valueAt(i), scaledValue(i + 1000));
+	}
+}
+
+QTEST_MAIN(FITSFilterTest)
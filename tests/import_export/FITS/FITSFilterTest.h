@@ -0,0 +1,25 @@
+/*
+    File                 : FITSFilterTest.h
+    Project              : LabPlot
+    Description          : Tests for the FITS I/O-filter.
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef FITSFILTERTEST_H
+#define FITSFILTERTEST_H
+
+#include "../../CommonTest.h"
+#include <QtTest>
+
+class FITSFilterTest : public CommonTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testRoundTripTable();
+	void testRoundTripTablePortion();
+};
+
+
+#endif
@@ -13,6 +13,61 @@
 #include "backend/matrix/Matrix.h"
 
 #include <KLocalizedString>
+#include <QTemporaryDir>
+
+#include <hdf5.h>
+
+// number of rows and columns of the data sets written for the round trip tests
+static const int roundTripRows = 20000;
+static const int roundTripColumns = 5;
+
+static double doubleValue(int row, int col) {
+	return row + col / 8.;
+}
+
+static int intValue(int row, int col) {
+	return (col % 2 ? -1 : 1) * (row * roundTripColumns + col);
+}
+
+/*!
+ * writes the data sets "/doubles" (little endian, contiguous), "/ints" (big endian, contiguous)
+ * and "/chunked" (little endian, chunks of 1000 rows) into the new file \c fileName
+ */
+static bool writeRoundTripFile(const QString& fileName) {
+	QVector<double> doubles(roundTripRows * roundTripColumns);
+	QVector<int> ints(roundTripRows * roundTripColumns);
+	for (int i = 0; i < roundTripRows; i++) {
+		for (int j = 0; j < roundTripColumns; j++) {
+			doubles[i * roundTripColumns + j] = doubleValue(i, j);
+			ints[i * roundTripColumns + j] = intValue(i, j);
+		}
+	}
+
+	hid_t file = H5Fcreate(qPrintable(fileName), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+	if (file < 0)
+		return false;
+	const hsize_t dims[2] = {roundTripRows, roundTripColumns};
+	hid_t space = H5Screate_simple(2, dims, nullptr);
+	const hsize_t chunkDims[2] = {1000, roundTripColumns};
+	hid_t chunked = H5Pcreate(H5P_DATASET_CREATE);
+	H5Pset_chunk(chunked, 2, chunkDims);
+
+	bool ok = true;
+	hid_t dataset = H5Dcreate2(file, "/doubles", H5T_IEEE_F64LE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	ok = ok && dataset >= 0 && H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, doubles.constData()) >= 0;
+	H5Dclose(dataset);
+	dataset = H5Dcreate2(file, "/ints", H5T_STD_I32BE, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	ok = ok && dataset >= 0 && H5Dwrite(dataset, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, ints.constData()) >= 0;
+	H5Dclose(dataset);
+	dataset = H5Dcreate2(file, "/chunked", H5T_IEEE_F64LE, space, H5P_DEFAULT, chunked, H5P_DEFAULT);
+	ok = ok && dataset >= 0 && H5Dwrite(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, doubles.constData()) >= 0;
+	H5Dclose(dataset);
+
+	H5Pclose(chunked);
+	H5Sclose(space);
+	H5Fclose(file);
+	return ok;
+}
 
 void HDF5FilterTest::testImportDouble() {
 	Spreadsheet spreadsheet("test", false);
@@ -158,4 +213,75 @@ void HDF5FilterTest::testImportIntPortion() {
 	QCOMPARE(spreadsheet.column(1)->valueAt(1), 1202);
 }
 
+//##############################################################################
+//#########################  round trip of written files  ######################
+//##############################################################################
+/*!
+ * reads a block of rows and columns of data sets written with the HDF5 library,
+ * the big endian integers are converted by HDF5 when reading them into the columns
+ */
+void HDF5FilterTest::testRoundTripPortion() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("roundtrip.h5"));
+	QVERIFY(writeRoundTripFile(fileName));
+
+	for (const auto& name : {QLatin1String("/doubles"), QLatin1String("/ints"), QLatin1String("/chunked")}) {
+		Spreadsheet spreadsheet("test", false);
+		HDF5Filter filter;
+		filter.setCurrentDataSetName(name);
+		filter.setStartRow(1001);
+		filter.setEndRow(15500);
+		filter.setStartColumn(2);
+		filter.setEndColumn(4);
+		filter.setChunkCacheSize(1024 * 1024);
+		filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+		QCOMPARE(spreadsheet.columnCount(), 3);
+		QCOMPARE(spreadsheet.rowCount(), 14500);
+		const bool ints = (name == QLatin1String("/ints"));
+		for (int j = 0; j < 3; j++) {
+			const auto* column = spreadsheet.column(j);
+			QCOMPARE(column->columnMode(), ints ? AbstractColumn::ColumnMode::Integer : AbstractColumn::ColumnMode::Double);
+			for (int i = 0; i < 14500; i++) {
+				if (ints)
+					QCOMPARE(column->integerAt(i), intValue(i + 1000, j + 1));
+				else
+					QCOMPARE(column->valueAt(i), doubleValue(i + 1000, j + 1));
+			}
+		}
+	}
+}
+
+/*!
+ * reads several data sets into several spreadsheets at once,
+ * the data sets are read in parallel if the HDF5 library is thread-safe
+ */
+void HDF5FilterTest::testRoundTripDataSets() {
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString fileName = dir.filePath(QLatin1String("roundtrip.h5"));
+	QVERIFY(writeRoundTripFile(fileName));
+
+	Spreadsheet doubles("doubles", false);
+	Spreadsheet ints("ints", false);
+	Spreadsheet chunked("chunked", false);
+	HDF5Filter filter;
+	filter.readDataSets(fileName, {QLatin1String("/doubles"), QLatin1String("/ints"), QLatin1String("/chunked")},
+			{&doubles, &ints, &chunked}, AbstractFileFilter::ImportMode::Replace);
+
+	for (auto* spreadsheet : {&doubles, &ints, &chunked}) {
+		QCOMPARE(spreadsheet->columnCount(), roundTripColumns);
+		QCOMPARE(spreadsheet->rowCount(), roundTripRows);
+	}
+	for (int j = 0; j < roundTripColumns; j++) {
+		QCOMPARE(ints.column(j)->columnMode(), AbstractColumn::ColumnMode::Integer);
+		for (int i = 0; i < roundTripRows; i++) {
+			QCOMPARE(doubles.column(j)->valueAt(i), doubleValue(i, j));
+			QCOMPARE(ints.column(j)->integerAt(i), intValue(i, j));
+			QCOMPARE(chunked.column(j)->valueAt(i), doubleValue(i, j));
+		}
+	}
+}
+
 QTEST_MAIN(HDF5FilterTest)
@@ -21,6 +21,9 @@ private Q_SLOTS:
 	void testImportDoublePortion();
 	void testImportInt();
 	void testImportIntPortion();
+
+	void testRoundTripPortion();
+	void testRoundTripDataSets();
 };
 
 
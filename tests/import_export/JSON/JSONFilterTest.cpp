@@ -275,4 +275,64 @@ void JSONFilterTest::testObjectImport04() {
 	QCOMPARE(spreadsheet.column(5)->integerAt(1), 127830);
 }
 
+/*!
+ * import a range of rows of an array
+ */
+void JSONFilterTest::testArrayImportRange() {
+	Spreadsheet spreadsheet("test", false);
+	JsonFilter filter;
+
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/array.json"));
+	AbstractFileFilter::ImportMode mode = AbstractFileFilter::ImportMode::Replace;
+	filter.setDataRowType(QJsonValue::Array);
+	filter.setDateTimeFormat(QLatin1String("yyyy-MM-dd"));
+	filter.setStartRow(2);
+	filter.setEndRow(3);
+	filter.readDataFromFile(fileName, &spreadsheet, mode);
+
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+
+	QDateTime value = QDateTime::fromString(QLatin1String("2018-06-02"), QLatin1String("yyyy-MM-dd"));
+	QCOMPARE(spreadsheet.column(0)->dateTimeAt(0), value);
+	value = QDateTime::fromString(QLatin1String("2018-06-03"), QLatin1String("yyyy-MM-dd"));
+	QCOMPARE(spreadsheet.column(0)->dateTimeAt(1), value);
+
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 0.02);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 0.03);
+}
+
+/*!
+ * import a range of JSON lines containing objects
+ */
+void JSONFilterTest::testJsonLinesImport() {
+	Spreadsheet spreadsheet("test", false);
+	JsonFilter filter;
+
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/lines.json"));
+	AbstractFileFilter::ImportMode mode = AbstractFileFilter::ImportMode::Replace;
+	filter.setCreateIndexEnabled(true);
+	filter.setStartRow(2);
+	filter.setEndRow(3);
+	filter.readDataFromFile(fileName, &spreadsheet, mode);
+
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Text);
+
+	QCOMPARE(spreadsheet.column(1)->name(), QLatin1String("a"));
+	QCOMPARE(spreadsheet.column(2)->name(), QLatin1String("b"));
+
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 1);
+	QCOMPARE(spreadsheet.column(0)->integerAt(1), 2);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 2.5);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 3.5);
+	QCOMPARE(spreadsheet.column(2)->textAt(0), QString("second"));
+	QCOMPARE(spreadsheet.column(2)->textAt(1), QString("third ") + QChar(0x00e4));
+}
+
 QTEST_MAIN(JSONFilterTest)
@@ -23,6 +23,9 @@ private Q_SLOTS:
 	void testObjectImport02();
 	void testObjectImport03();
 	void testObjectImport04();
+
+	void testArrayImportRange();
+	void testJsonLinesImport();
 };
 
 
@@ -0,0 +1,114 @@
+/*
+    File                 : NSLKDETest.cpp
+    Project              : LabPlot
+    Description          : NSL Tests for the kernel density estimation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "NSLKDETest.h"
+
+#include <algorithm>
+
+extern "C" {
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+#include "backend/nsl/nsl_kde.h"
+#include "backend/nsl/nsl_sf_kernel.h"
+}
+
+const int N = 10000;
+const int M = 512;
+const double h = 0.2;
+
+// normal distributed sample with a fixed seed
+const QVector<double>& NSLKDETest::data() {
+	if (m_data.isEmpty()) {
+		gsl_rng* r = gsl_rng_alloc(gsl_rng_mt19937);
+		gsl_rng_set(r, 12345);
+		m_data.resize(N);
+		for (int i = 0; i < N; i++)
+			m_data[i] = gsl_ran_gaussian(r, 1.);
+		gsl_rng_free(r);
+	}
+
+	return m_data;
+}
+
+//##############################################################################
+//#################  binned estimation vs. direct sum
+//##############################################################################
+
+void NSLKDETest::testBinnedGauss() {
+	const auto& sample = data();
+	const double min = *std::min_element(sample.constBegin(), sample.constEnd());
+	const double max = *std::max_element(sample.constBegin(), sample.constEnd());
+	QVector<double> density(M);
+
+	int status = nsl_kde_binned(sample.constData(), N, h, nsl_kde_kernel_gauss, min, max, M, density.data());
+	QCOMPARE(status, 0);
+
+	const double step = (max - min)/(M - 1);
+	for (int i = 0; i < M; i++) {
+		const double direct = nsl_kde(sample.constData(), min + i*step, h, N);
+		FuzzyCompare(density.at(i) + 1., direct + 1., 1.e-4);
+	}
+}
+
+void NSLKDETest::testBinnedParabolic() {
+	const auto& sample = data();
+	const double min = *std::min_element(sample.constBegin(), sample.constEnd());
+	const double max = *std::max_element(sample.constBegin(), sample.constEnd());
+	QVector<double> density(M);
+
+	int status = nsl_kde_binned(sample.constData(), N, h, nsl_kde_kernel_parabolic, min, max, M, density.data());
+	QCOMPARE(status, 0);
+
+	const double step = (max - min)/(M - 1);
+	for (int i = 0; i < M; i++) {
+		const double x = min + i*step;
+		double direct = 0;
+		for (int j = 0; j < N; j++)
+			direct += nsl_sf_kernel_parabolic((x - sample.at(j))/h) / (N * h);
+		FuzzyCompare(density.at(i) + 1., direct + 1., 1.e-3);
+	}
+}
+
+void NSLKDETest::testBinnedInvalid() {
+	double data[] = {1., 2., 3.};
+	double density[10];
+
+	QCOMPARE(nsl_kde_binned(data, 0, 1., nsl_kde_kernel_gauss, 0., 4., 10, density), -1);
+	QCOMPARE(nsl_kde_binned(data, 3, 0., nsl_kde_kernel_gauss, 0., 4., 10, density), -1);
+	QCOMPARE(nsl_kde_binned(data, 3, 1., nsl_kde_kernel_gauss, 4., 4., 10, density), -1);
+	QCOMPARE(nsl_kde_binned(data, 3, 1., nsl_kde_kernel_gauss, 0., 4., 1, density), -1);
+}
+
+//##############################################################################
+//#################  performance
+//##############################################################################
+
+void NSLKDETest::testPerformanceDirect() {
+	const auto& sample = data();
+	QVector<double> density(M);
+	const double step = 8./(M - 1);
+
+	QBENCHMARK {
+		for (int i = 0; i < M; i++)
+			density[i] = nsl_kde(sample.constData(), -4. + i*step, h, N);
+	}
+}
+
+void NSLKDETest::testPerformanceBinned() {
+	const auto& sample = data();
+	QVector<double> density(M);
+
+	QBENCHMARK {
+		int status = nsl_kde_binned(sample.constData(), N, h, nsl_kde_kernel_gauss, -4., 4., M, density.data());
+		QCOMPARE(status, 0);
+	}
+}
+
+QTEST_MAIN(NSLKDETest)
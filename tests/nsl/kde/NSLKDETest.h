@@ -0,0 +1,30 @@
+/*
+    File                 : NSLKDETest.h
+    Project              : LabPlot
+    Description          : NSL Tests for the kernel density estimation
+    --------------------------------------------------------------------
+    SPDX-FileCopyrightText: 2026 agent <agent@local>
+
+    SPDX-License-Identifier: GPL-2.0-or-later
+*/
+#ifndef NSLKDETEST_H
+#define NSLKDETEST_H
+
+#include "../NSLTest.h"
+
+class NSLKDETest : public NSLTest {
+	Q_OBJECT
+
+private Q_SLOTS:
+	void testBinnedGauss();
+	void testBinnedParabolic();
+	void testBinnedInvalid();
+
+	// performance
+	void testPerformanceDirect();
+	void testPerformanceBinned();
+private:
+	const QVector<double>& data();
+	QVector<double> m_data;
+};
+#endif